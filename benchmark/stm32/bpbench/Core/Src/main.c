@@ -1,394 +1,565 @@
-/* USER CODE BEGIN Header */
-/**
- ******************************************************************************
- * @file           : main.c
- * @brief          : Main program body
- ******************************************************************************
- * @attention
- *
- * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
- * All rights reserved.</center></h2>
- *
- * This software component is licensed by ST under BSD 3-Clause license,
- * the "License"; You may not use this file except in compliance with the
- * License. You may obtain a copy of the License at:
- *                        opensource.org/licenses/BSD-3-Clause
- *
- ******************************************************************************
- */
-/* USER CODE END Header */
-/* Includes ------------------------------------------------------------------*/
-#include "main.h"
-
-#include <stdarg.h>
-#include <stdbool.h>
-#include <stdio.h>
-
-#include "drone_bp.h"
-
-/* Private includes ----------------------------------------------------------*/
-/* USER CODE BEGIN Includes */
-
-/* USER CODE END Includes */
-
-/* Private typedef -----------------------------------------------------------*/
-/* USER CODE BEGIN PTD */
-
-/* USER CODE END PTD */
-
-/* Private define ------------------------------------------------------------*/
-/* USER CODE BEGIN PD */
-/* USER CODE END PD */
-
-/* Private macro -------------------------------------------------------------*/
-/* USER CODE BEGIN PM */
-
-/* USER CODE END PM */
-
-/* Private variables ---------------------------------------------------------*/
-TIM_HandleTypeDef htim6;
-
-UART_HandleTypeDef huart1;
-
-/* USER CODE BEGIN PV */
-
-/* USER CODE END PV */
-
-/* Private function prototypes -----------------------------------------------*/
-void SystemClock_Config(void);
-static void MX_GPIO_Init(void);
-static void MX_TIM6_Init(void);
-static void MX_USART1_UART_Init(void);
-/* USER CODE BEGIN PFP */
-
-/* USER CODE END PFP */
-
-/* Private user code ---------------------------------------------------------*/
-/* USER CODE BEGIN 0 */
-
-void soft_assert(bool v) {
-    if (!v) simple_printf("assert failed !!!!!!!!!!!!!!!!!!!!\r\n");
-}
-
-// Printf to uart1.
-void simple_printf(const char *fmt, ...) {
-    char buf[512] = {0};
-
-    int n = 0;
-    va_list va;
-    va_start(va, fmt);
-    n += vsprintf(buf, fmt, va);
-    va_end(va);
-
-    HAL_UART_Transmit(&huart1, (uint8_t *)buf, n, 1000);
-}
-
-// Benchmark encode.
-void bench_encode(int n, unsigned char *s) {
-    struct Drone drone = {0};
-
-    int start = HAL_GetTick();  // ms
-    for (int i = 0; i < n; i++) {
-        EncodeDrone(&drone, s);
-    }
-    int end = HAL_GetTick();
-    int cost = end - start;
-#ifdef BITPROTO_OPTIMIZATION_MODE
-    simple_printf(
-        "[optimization mode] called encode %d times, total %dms, per encode "
-        "%dus\r\n",
-        n, cost, 1000 * cost / n);
-#else
-    simple_printf(
-        "[standard mode] called encode %d times, total %dms, per encode "
-        "%dus\r\n",
-        n, cost, 1000 * cost / n);
-#endif
-}
-
-// Benchmark decode.
-void bench_decode(int n, unsigned char *s) {
-    struct Drone drone_new = {0};
-
-    int start = HAL_GetTick();  // ms
-    for (int i = 0; i < n; i++) {
-        DecodeDrone(&drone_new, s);
-    }
-    int end = HAL_GetTick();
-    int cost = end - start;
-#ifdef BITPROTO_OPTIMIZATION_MODE
-    simple_printf(
-        "[optimization mode] called decode %d times, total %dms, per decode "
-        "%dus\r\n",
-        n, cost, 1000 * cost / n);
-#else
-    simple_printf(
-        "[standard mode] called decode %d times, total %dms, per decode "
-        "%dus\r\n",
-        n, cost, 1000 * cost / n);
-#endif
-}
-
-void bench() {
-    int n = 10000;  // Benchmark count.
-    unsigned char s[BYTES_LENGTH_DRONE] = {0};
-
-    bench_encode(n, s);
-    bench_decode(n, s);
-}
-
-void simple_test() {
-    struct Drone drone = {0};
-
-    drone.status = DRONE_STATUS_RISING;
-    drone.position.longitude = 2000;
-    drone.position.latitude = 2000;
-    drone.position.altitude = 1080;
-    drone.flight.acceleration[0] = -1001;
-    drone.power.is_charging = false;
-    drone.propellers[0].direction = ROTATING_DIRECTION_CLOCK_WISE;
-    drone.pressure_sensor.pressures[0] = -11;
-
-    unsigned char s[BYTES_LENGTH_DRONE] = {0};
-
-    EncodeDrone(&drone, s);
-
-    unsigned char s_expected[BYTES_LENGTH_DRONE] = {
-        0x82, 0x3E, 0x00, 0x00, 0x80, 0x3E, 0x00, 0x00, 0xC0, 0x21, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0xB8, 0xE0, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x50, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00};
-
-    for (int i = 0; i < BYTES_LENGTH_DRONE; i++)
-        soft_assert(s_expected[i] == s[i]);
-
-    struct Drone drone_new = {0};
-    DecodeDrone(&drone_new, s);
-
-    soft_assert(drone.status == drone_new.status);
-    soft_assert(drone.position.longitude == drone_new.position.longitude);
-    soft_assert(drone.position.latitude == drone_new.position.latitude);
-    soft_assert(drone.position.altitude == drone_new.position.altitude);
-    soft_assert(drone.flight.acceleration[0] ==
-                drone_new.flight.acceleration[0]);
-    soft_assert(drone.power.is_charging == drone_new.power.is_charging);
-    soft_assert(drone.propellers[0].direction ==
-                drone_new.propellers[0].direction);
-    soft_assert(drone.pressure_sensor.pressures[0] ==
-                drone_new.pressure_sensor.pressures[0]);
-
-    simple_printf("simple test finished\r\n");
-}
-
-/* USER CODE END 0 */
-
-/**
- * @brief  The application entry point.
- * @retval int
- */
-int main(void) {
-    /* USER CODE BEGIN 1 */
-
-    /* USER CODE END 1 */
-
-    /* MCU
-     * Configuration--------------------------------------------------------*/
-
-    /* Reset of all peripherals, Initializes the Flash interface and the
-     * Systick.
-     */
-    HAL_Init();
-
-    /* USER CODE BEGIN Init */
-
-    /* USER CODE END Init */
-
-    /* Configure the system clock */
-    SystemClock_Config();
-
-    /* USER CODE BEGIN SysInit */
-
-    /* USER CODE END SysInit */
-
-    /* Initialize all configured peripherals */
-    MX_GPIO_Init();
-    MX_TIM6_Init();
-    MX_USART1_UART_Init();
-    /* USER CODE BEGIN 2 */
-
-    /* USER CODE END 2 */
-
-    /* Infinite loop */
-    /* USER CODE BEGIN WHILE */
-    simple_test();
-
-    while (1) {
-        /* USER CODE END WHILE */
-        HAL_GPIO_TogglePin(GPIOB, GPIO_PIN_5);
-        HAL_Delay(1000);
-        bench();
-        /* USER CODE BEGIN 3 */
-    }
-    /* USER CODE END 3 */
-}
-
-/**
- * @brief System Clock Configuration
- * @retval None
- */
-void SystemClock_Config(void) {
-    RCC_OscInitTypeDef RCC_OscInitStruct = {0};
-    RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
-
-    /** Initializes the RCC Oscillators according to the specified parameters
-     * in the RCC_OscInitTypeDef structure.
-     */
-    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
-    RCC_OscInitStruct.HSEState = RCC_HSE_ON;
-    RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
-    RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-    RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
-    RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
-    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
-        Error_Handler();
-    }
-    /** Initializes the CPU, AHB and APB buses clocks
-     */
-    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
-                                  RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
-    RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-    RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-    RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-    RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-    if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK) {
-        Error_Handler();
-    }
-}
-
-/**
- * @brief TIM6 Initialization Function
- * @param None
- * @retval None
- */
-static void MX_TIM6_Init(void) {
-    /* USER CODE BEGIN TIM6_Init 0 */
-
-    /* USER CODE END TIM6_Init 0 */
-
-    TIM_MasterConfigTypeDef sMasterConfig = {0};
-
-    /* USER CODE BEGIN TIM6_Init 1 */
-
-    /* USER CODE END TIM6_Init 1 */
-    htim6.Instance = TIM6;
-    htim6.Init.Prescaler = 72 - 1;
-    htim6.Init.CounterMode = TIM_COUNTERMODE_UP;
-    htim6.Init.Period = 65535;
-    htim6.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-    if (HAL_TIM_Base_Init(&htim6) != HAL_OK) {
-        Error_Handler();
-    }
-    sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
-    sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
-    if (HAL_TIMEx_MasterConfigSynchronization(&htim6, &sMasterConfig) !=
-        HAL_OK) {
-        Error_Handler();
-    }
-    /* USER CODE BEGIN TIM6_Init 2 */
-
-    /* USER CODE END TIM6_Init 2 */
-}
-
-/**
- * @brief USART1 Initialization Function
- * @param None
- * @retval None
- */
-static void MX_USART1_UART_Init(void) {
-    /* USER CODE BEGIN USART1_Init 0 */
-
-    /* USER CODE END USART1_Init 0 */
-
-    /* USER CODE BEGIN USART1_Init 1 */
-
-    /* USER CODE END USART1_Init 1 */
-    huart1.Instance = USART1;
-    huart1.Init.BaudRate = 115200;
-    huart1.Init.WordLength = UART_WORDLENGTH_8B;
-    huart1.Init.StopBits = UART_STOPBITS_1;
-    huart1.Init.Parity = UART_PARITY_NONE;
-    huart1.Init.Mode = UART_MODE_TX_RX;
-    huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-    huart1.Init.OverSampling = UART_OVERSAMPLING_16;
-    if (HAL_UART_Init(&huart1) != HAL_OK) {
-        Error_Handler();
-    }
-    /* USER CODE BEGIN USART1_Init 2 */
-
-    /* USER CODE END USART1_Init 2 */
-}
-
-/**
- * @brief GPIO Initialization Function
- * @param None
- * @retval None
- */
-static void MX_GPIO_Init(void) {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-
-    /* GPIO Ports Clock Enable */
-    __HAL_RCC_GPIOA_CLK_ENABLE();
-    __HAL_RCC_GPIOB_CLK_ENABLE();
-
-    /*Configure GPIO pin Output Level */
-    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_5 | GPIO_PIN_8, GPIO_PIN_RESET);
-
-    /*Configure GPIO pins : PB5 PB8 */
-    GPIO_InitStruct.Pin = GPIO_PIN_5 | GPIO_PIN_8;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Pull = GPIO_NOPULL;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-}
-
-/* USER CODE BEGIN 4 */
-
-/* USER CODE END 4 */
-
-/**
- * @brief  This function is executed in case of error occurrence.
- * @retval None
- */
-void Error_Handler(void) {
-    /* USER CODE BEGIN Error_Handler_Debug */
-    /* User can add his own implementation to report the HAL error return state
-     */
-    __disable_irq();
-    while (1) {
-    }
-    /* USER CODE END Error_Handler_Debug */
-}
-
-#ifdef USE_FULL_ASSERT
-/**
- * @brief  Reports the name of the source file and the source line number
- *         where the assert_param error has occurred.
- * @param  file: pointer to the source file name
- * @param  line: assert_param error line source number
- * @retval None
- */
-void assert_failed(uint8_t *file, uint32_t line) {
-    /* USER CODE BEGIN 6 */
-    /* User can add his own implementation to report the file name and line
-       number,
-       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line)
-     */
-    /* USER CODE END 6 */
-}
-#endif /* USE_FULL_ASSERT */
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file           : main.c
+ * @brief          : Main program body
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitproto.h"
+#include "drone_bp.h"
+#include "imu_bp.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+/* Private typedef -----------------------------------------------------------*/
+/* USER CODE BEGIN PTD */
+
+/* USER CODE END PTD */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+/* USER CODE END PD */
+
+/* Private macro -------------------------------------------------------------*/
+/* USER CODE BEGIN PM */
+
+/* USER CODE END PM */
+
+/* Private variables ---------------------------------------------------------*/
+TIM_HandleTypeDef htim6;
+
+UART_HandleTypeDef huart1;
+DMA_HandleTypeDef hdma_usart1_tx;
+
+/* USER CODE BEGIN PV */
+
+/* USER CODE END PV */
+
+/* Private function prototypes -----------------------------------------------*/
+void SystemClock_Config(void);
+static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
+static void MX_TIM6_Init(void);
+static void MX_USART1_UART_Init(void);
+/* USER CODE BEGIN PFP */
+
+/* USER CODE END PFP */
+
+/* Private user code ---------------------------------------------------------*/
+/* USER CODE BEGIN 0 */
+
+void soft_assert(bool v) {
+    if (!v) simple_printf("assert failed !!!!!!!!!!!!!!!!!!!!\r\n");
+}
+
+// Printf to uart1.
+void simple_printf(const char *fmt, ...) {
+    char buf[512] = {0};
+
+    int n = 0;
+    va_list va;
+    va_start(va, fmt);
+    n += vsprintf(buf, fmt, va);
+    va_end(va);
+
+    HAL_UART_Transmit(&huart1, (uint8_t *)buf, n, 1000);
+}
+
+// Number of calls measured for each operation.
+#define BENCH_SAMPLES 101
+
+// Per-call cycle counts of an operation reported: min, median and max.
+struct BenchResult {
+    uint32_t min;
+    uint32_t median;
+    uint32_t max;
+};
+
+// Cycles spent by the measurement itself, subtracted from each sample.
+static uint32_t cycles_overhead = 0;
+
+// Enables the DWT cycle counter, available on Cortex-M3 and above.
+void cycles_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    uint32_t start = DWT->CYCCNT;
+    __DSB();
+    cycles_overhead = DWT->CYCCNT - start;
+}
+
+// Sorts the samples and fills the result.
+void bench_result(uint32_t *samples, struct BenchResult *result) {
+    for (int i = 1; i < BENCH_SAMPLES; i++) {
+        uint32_t v = samples[i];
+        int j = i - 1;
+        for (; j >= 0 && samples[j] > v; j--) samples[j + 1] = samples[j];
+        samples[j + 1] = v;
+    }
+    result->min = samples[0];
+    result->median = samples[BENCH_SAMPLES / 2];
+    result->max = samples[BENCH_SAMPLES - 1];
+}
+
+const char *bench_mode(void) {
+#ifdef BITPROTO_OPTIMIZATION_MODE
+    return "optimization";
+#else
+    return "standard";
+#endif
+}
+
+void bench_report(const char *schema, const char *op,
+                  struct BenchResult *result) {
+    const char *mode = bench_mode();
+    simple_printf(
+        "[%s mode] %s %s: cycles min %lu, median %lu, max %lu, "
+        "median %luns at %luMHz\r\n",
+        mode, schema, op, result->min, result->median, result->max,
+        result->median * 1000 / (SystemCoreClock / 1000000),
+        SystemCoreClock / 1000000);
+}
+
+// Runs a call of given statement with interrupts disabled, and stores the
+// cycles it takes in samples[i].
+#define BENCH_CALL(samples, i, call)                      \
+    do {                                                  \
+        __disable_irq();                                  \
+        uint32_t start = DWT->CYCCNT;                     \
+        call;                                             \
+        __DSB();                                          \
+        uint32_t cycles = DWT->CYCCNT - start;            \
+        __enable_irq();                                   \
+        samples[i] = cycles > cycles_overhead             \
+                         ? cycles - cycles_overhead       \
+                         : 0;                             \
+    } while (0)
+
+// Xorshift32, fixed seed for reproducible inputs.
+static uint32_t rng = 2463534242u;
+
+uint32_t bench_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Fills message m of size n with random field values. Random bytes are encoded
+// and then decoded, which keeps the value of each field in its bits.
+#define BENCH_RANDOM_MESSAGE(X, m, s)                                         \
+    do {                                                                      \
+        struct X tmp;                                                         \
+        unsigned char *p = (unsigned char *)&tmp;                             \
+        for (unsigned int k = 0; k < sizeof(tmp); k++)                        \
+            p[k] = (unsigned char)bench_random();                             \
+        for (unsigned int k = 0; k < sizeof(s); k++) s[k] = 0;                \
+        Encode##X(&tmp, s);                                                   \
+        Decode##X(m, s);                                                      \
+        for (unsigned int k = 0; k < sizeof(s); k++) s[k] = 0;                \
+        Encode##X(m, s);                                                      \
+    } while (0)
+
+// Benchmarks encode, decode and json formatting of message X, on a random
+// message for each call.
+#define BENCH_MESSAGE(X, schema, nbytes, json_nbytes)                         \
+    do {                                                                      \
+        static uint32_t samples[BENCH_SAMPLES];                               \
+        static unsigned char s[nbytes];                                       \
+        static struct X m, m_new;                                             \
+        struct BenchResult result;                                            \
+        for (int i = 0; i < BENCH_SAMPLES; i++) {                             \
+            BENCH_RANDOM_MESSAGE(X, &m, s);                                   \
+            BENCH_CALL(samples, i, Encode##X(&m, s));                         \
+        }                                                                     \
+        bench_result(samples, &result);                                       \
+        bench_report(schema, "encode", &result);                              \
+        for (int i = 0; i < BENCH_SAMPLES; i++) {                             \
+            BENCH_RANDOM_MESSAGE(X, &m, s);                                   \
+            BENCH_CALL(samples, i, Decode##X(&m_new, s));                     \
+            soft_assert(memcmp(&m, &m_new, sizeof(m)) == 0);                  \
+        }                                                                     \
+        bench_result(samples, &result);                                       \
+        bench_report(schema, "decode", &result);                              \
+        BENCH_JSON(X, schema, json_nbytes);                                   \
+    } while (0)
+
+// Json formatting is generated in standard mode only.
+#ifdef BITPROTO_OPTIMIZATION_MODE
+#define BENCH_JSON(X, schema, json_nbytes) \
+    do {                                   \
+    } while (0)
+#else
+#define BENCH_JSON(X, schema, json_nbytes)                                    \
+    do {                                                                      \
+        static char js[json_nbytes];                                          \
+        for (int i = 0; i < BENCH_SAMPLES; i++) {                             \
+            BENCH_RANDOM_MESSAGE(X, &m, s);                                   \
+            BENCH_CALL(samples, i, Json##X(&m, js));                          \
+        }                                                                     \
+        bench_result(samples, &result);                                       \
+        bench_report(schema, "json", &result);                                \
+    } while (0)
+#endif
+
+// Number of frames sent by each loop of the transmission benchmark.
+#define BENCH_TX_FRAMES 100
+
+// Buffers of the frames transmitted over UART1 by DMA.
+static unsigned char tx_a[BYTES_LENGTH_DRONE], tx_b[BYTES_LENGTH_DRONE];
+static struct BpTxBuffers tx;
+static volatile bool tx_done = false;
+
+static void tx_start(const unsigned char *s, int n, void *arg) {
+    HAL_UART_Transmit_DMA((UART_HandleTypeDef *)arg, (uint8_t *)s, n);
+}
+
+// Called by HAL in the interrupt on the completion of a DMA transmission.
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart->Instance != USART1) return;
+    tx_done = true;
+    BpTxComplete(&tx);
+}
+
+uint32_t bench_fps(uint32_t cycles) {
+    return (uint32_t)((uint64_t)BENCH_TX_FRAMES * SystemCoreClock / cycles);
+}
+
+// Benchmarks the sustained frames per second of encoding drones and sending
+// them over UART1 by DMA, the encode-then-send loop waits for each frame sent
+// before encoding the next, the double-buffered loop encodes the next frame
+// while the previous is being sent.
+void bench_tx() {
+    static struct Drone m;
+    static unsigned char s[BYTES_LENGTH_DRONE];
+    BENCH_RANDOM_MESSAGE(Drone, &m, s);
+
+    uint32_t start = DWT->CYCCNT;
+    for (int i = 0; i < BENCH_TX_FRAMES; i++) {
+        EncodeDrone(&m, tx_a);
+        tx_done = false;
+        HAL_UART_Transmit_DMA(&huart1, tx_a, BYTES_LENGTH_DRONE);
+        while (!tx_done) {
+        }
+    }
+    uint32_t serial = DWT->CYCCNT - start;
+
+    BpTxInit(&tx, tx_a, tx_b, tx_start, &huart1);
+    start = DWT->CYCCNT;
+    for (int i = 0; i < BENCH_TX_FRAMES; i++) {
+        unsigned char *t;
+        while ((t = BpTxAcquire(&tx)) == NULL) {
+        }
+        EncodeDrone(&m, t);
+        BpTxCommit(&tx, BYTES_LENGTH_DRONE);
+    }
+    while (!BpTxIdle(&tx)) {
+    }
+    uint32_t pipelined = DWT->CYCCNT - start;
+
+    simple_printf(
+        "[%s mode] drone tx: encode-then-send %lu frames/s, double-buffered "
+        "%lu frames/s at %lu baud\r\n",
+        bench_mode(), bench_fps(serial), bench_fps(pipelined),
+        huart1.Init.BaudRate);
+}
+
+void bench() {
+    BENCH_MESSAGE(Drone, "drone", BYTES_LENGTH_DRONE, JSON_MAX_LENGTH_DRONE);
+    BENCH_MESSAGE(Imu, "imu", BYTES_LENGTH_IMU, JSON_MAX_LENGTH_IMU);
+    bench_tx();
+}
+
+void simple_test() {
+    struct Drone drone = {0};
+
+    drone.status = DRONE_STATUS_RISING;
+    drone.position.longitude = 2000;
+    drone.position.latitude = 2000;
+    drone.position.altitude = 1080;
+    drone.flight.acceleration[0] = -1001;
+    drone.power.is_charging = false;
+    drone.propellers[0].direction = ROTATING_DIRECTION_CLOCK_WISE;
+    drone.pressure_sensor.pressures[0] = -11;
+
+    unsigned char s[BYTES_LENGTH_DRONE] = {0};
+
+    EncodeDrone(&drone, s);
+
+    unsigned char s_expected[BYTES_LENGTH_DRONE] = {
+        0x82, 0x3E, 0x00, 0x00, 0x80, 0x3E, 0x00, 0x00, 0xC0, 0x21, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xB8, 0xE0, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x50, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00};
+
+    for (int i = 0; i < BYTES_LENGTH_DRONE; i++)
+        soft_assert(s_expected[i] == s[i]);
+
+    struct Drone drone_new;
+    DecodeDrone(&drone_new, s);
+
+    soft_assert(drone.status == drone_new.status);
+    soft_assert(drone.position.longitude == drone_new.position.longitude);
+    soft_assert(drone.position.latitude == drone_new.position.latitude);
+    soft_assert(drone.position.altitude == drone_new.position.altitude);
+    soft_assert(drone.flight.acceleration[0] ==
+                drone_new.flight.acceleration[0]);
+    soft_assert(drone.power.is_charging == drone_new.power.is_charging);
+    soft_assert(drone.propellers[0].direction ==
+                drone_new.propellers[0].direction);
+    soft_assert(drone.pressure_sensor.pressures[0] ==
+                drone_new.pressure_sensor.pressures[0]);
+
+    simple_printf("simple test finished\r\n");
+}
+
+/* USER CODE END 0 */
+
+/**
+ * @brief  The application entry point.
+ * @retval int
+ */
+int main(void) {
+    /* USER CODE BEGIN 1 */
+
+    /* USER CODE END 1 */
+
+    /* MCU
+     * Configuration--------------------------------------------------------*/
+
+    /* Reset of all peripherals, Initializes the Flash interface and the
+     * Systick.
+     */
+    HAL_Init();
+
+    /* USER CODE BEGIN Init */
+
+    /* USER CODE END Init */
+
+    /* Configure the system clock */
+    SystemClock_Config();
+
+    /* USER CODE BEGIN SysInit */
+
+    /* USER CODE END SysInit */
+
+    /* Initialize all configured peripherals */
+    MX_GPIO_Init();
+    MX_DMA_Init();
+    MX_TIM6_Init();
+    MX_USART1_UART_Init();
+    /* USER CODE BEGIN 2 */
+    cycles_init();
+    /* USER CODE END 2 */
+
+    /* Infinite loop */
+    /* USER CODE BEGIN WHILE */
+    simple_test();
+
+    while (1) {
+        /* USER CODE END WHILE */
+        HAL_GPIO_TogglePin(GPIOB, GPIO_PIN_5);
+        HAL_Delay(1000);
+        bench();
+        /* USER CODE BEGIN 3 */
+    }
+    /* USER CODE END 3 */
+}
+
+/**
+ * @brief System Clock Configuration
+ * @retval None
+ */
+void SystemClock_Config(void) {
+    RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+    RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+    /** Initializes the RCC Oscillators according to the specified parameters
+     * in the RCC_OscInitTypeDef structure.
+     */
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+    RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+    RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+    RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+    RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+    RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
+    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
+        Error_Handler();
+    }
+    /** Initializes the CPU, AHB and APB buses clocks
+     */
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
+                                  RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
+    RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+
+    if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief TIM6 Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_TIM6_Init(void) {
+    /* USER CODE BEGIN TIM6_Init 0 */
+
+    /* USER CODE END TIM6_Init 0 */
+
+    TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+    /* USER CODE BEGIN TIM6_Init 1 */
+
+    /* USER CODE END TIM6_Init 1 */
+    htim6.Instance = TIM6;
+    htim6.Init.Prescaler = 72 - 1;
+    htim6.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim6.Init.Period = 65535;
+    htim6.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim6) != HAL_OK) {
+        Error_Handler();
+    }
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+    sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(&htim6, &sMasterConfig) !=
+        HAL_OK) {
+        Error_Handler();
+    }
+    /* USER CODE BEGIN TIM6_Init 2 */
+
+    /* USER CODE END TIM6_Init 2 */
+}
+
+/**
+ * @brief USART1 Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_USART1_UART_Init(void) {
+    /* USER CODE BEGIN USART1_Init 0 */
+
+    /* USER CODE END USART1_Init 0 */
+
+    /* USER CODE BEGIN USART1_Init 1 */
+
+    /* USER CODE END USART1_Init 1 */
+    huart1.Instance = USART1;
+    huart1.Init.BaudRate = 115200;
+    huart1.Init.WordLength = UART_WORDLENGTH_8B;
+    huart1.Init.StopBits = UART_STOPBITS_1;
+    huart1.Init.Parity = UART_PARITY_NONE;
+    huart1.Init.Mode = UART_MODE_TX_RX;
+    huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+    if (HAL_UART_Init(&huart1) != HAL_OK) {
+        Error_Handler();
+    }
+    /* USER CODE BEGIN USART1_Init 2 */
+
+    /* USER CODE END USART1_Init 2 */
+}
+
+/**
+ * Enable DMA controller clock
+ */
+static void MX_DMA_Init(void) {
+    /* DMA controller clock enable */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* DMA interrupt init */
+    /* DMA1_Channel4_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+}
+
+/**
+ * @brief GPIO Initialization Function
+ * @param None
+ * @retval None
+ */
+static void MX_GPIO_Init(void) {
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    /* GPIO Ports Clock Enable */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+
+    /*Configure GPIO pin Output Level */
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_5 | GPIO_PIN_8, GPIO_PIN_RESET);
+
+    /*Configure GPIO pins : PB5 PB8 */
+    GPIO_InitStruct.Pin = GPIO_PIN_5 | GPIO_PIN_8;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+}
+
+/* USER CODE BEGIN 4 */
+
+/* USER CODE END 4 */
+
+/**
+ * @brief  This function is executed in case of error occurrence.
+ * @retval None
+ */
+void Error_Handler(void) {
+    /* USER CODE BEGIN Error_Handler_Debug */
+    /* User can add his own implementation to report the HAL error return state
+     */
+    __disable_irq();
+    while (1) {
+    }
+    /* USER CODE END Error_Handler_Debug */
+}
+
+#ifdef USE_FULL_ASSERT
+/**
+ * @brief  Reports the name of the source file and the source line number
+ *         where the assert_param error has occurred.
+ * @param  file: pointer to the source file name
+ * @param  line: assert_param error line source number
+ * @retval None
+ */
+void assert_failed(uint8_t *file, uint32_t line) {
+    /* USER CODE BEGIN 6 */
+    /* User can add his own implementation to report the file name and line
+       number,
+       ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line)
+     */
+    /* USER CODE END 6 */
+}
+#endif /* USE_FULL_ASSERT */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,74 @@
+"""
+Reports the flash and RAM used by given object files, from a GNU ld map file.
+
+Usage: python mapsize.py path/to/x.map a.o b.o ...
+
+Only input sections kept in the output are counted, those removed by
+--gc-sections are listed in the "Discarded input sections" part and skipped.
+"""
+
+import os
+import re
+import sys
+from typing import Dict, List, Tuple
+
+# An input section in the memory map, the name may be on the previous line if long.
+SECTION = re.compile(r"^ (\S+)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+\.o)\)?$")
+
+
+def parse(path: str) -> List[Tuple[str, int, str]]:
+    """Returns (section name, size, object file) of input sections in the map."""
+    sections: List[Tuple[str, int, str]] = []
+    started = False
+    name = ""
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                started = True
+                continue
+            if not started:
+                continue
+            if re.match(r"^ \S+$", line):  # Name of a long section alone.
+                name = line.strip()
+                continue
+            m = SECTION.match(line)
+            if m:
+                section = m.group(1) or name
+                obj = os.path.basename(m.group(4).split("(")[-1])
+                sections.append((section, int(m.group(3), 16), obj))
+            name = ""
+    return sections
+
+
+def classify(section: str) -> Tuple[int, int]:
+    """Returns (flash, ram) factors of given section: initialized data occupies
+    both, since it's copied from flash to RAM at startup."""
+    if section.startswith((".text", ".rodata")):
+        return 1, 0
+    if section.startswith(".data"):
+        return 1, 1
+    if section.startswith((".bss", "COMMON")):
+        return 0, 1
+    return 0, 0
+
+
+def main() -> None:
+    path, objs = sys.argv[1], sys.argv[2:]
+    usage: Dict[str, List[int]] = {obj: [0, 0] for obj in objs}
+    for section, size, obj in parse(path):
+        if obj in usage:
+            flash, ram = classify(section)
+            usage[obj][0] += flash * size
+            usage[obj][1] += ram * size
+
+    print(f"{'object':<16} {'flash':>8} {'ram':>8}")
+    for obj, (flash, ram) in usage.items():
+        print(f"{obj:<16} {flash:>8} {ram:>8}")
+    total_flash = sum(flash for flash, _ in usage.values())
+    total_ram = sum(ram for _, ram in usage.values())
+    print(f"{'total':<16} {total_flash:>8} {total_ram:>8}")
+
+
+if __name__ == "__main__":
+    main()
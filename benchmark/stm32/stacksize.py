@@ -0,0 +1,111 @@
+"""
+Reports the worst-case stack usage of the encoders and decoders, from the call graph
+files GCC writes with -fcallgraph-info=su, one .ci file per object.
+
+Usage: python stacksize.py [--entry REGEX] a.ci b.ci ...
+
+Each entry function matching REGEX, or EncodeXXX, DecodeXXX and DecodeXXXN of the
+messages by default, is reported with the largest sum of stack frames along the calls
+from it, across the given files. The sum is unbounded if the calls recurse, or are
+indirect, e.g. through the processors of descriptors, or if a frame is dynamic and not
+bounded. Functions out of the given files, e.g. memcpy, are listed, not counted.
+"""
+
+import argparse
+import re
+import sys
+from typing import Dict, List, Optional, Set, Tuple
+
+NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+# The stack frame in the label, e.g. "96 bytes (static)".
+FRAME = re.compile(r"(\d+) bytes \(([a-z,]+)\)")
+
+
+class Graph:
+    def __init__(self) -> None:
+        # Title => (name, bytes, bounded).
+        self.nodes: Dict[str, Tuple[str, int, bool]] = {}
+        self.edges: Dict[str, Set[str]] = {}
+
+    def parse(self, path: str) -> None:
+        with open(path) as f:
+            for line in f:
+                m = NODE.match(line)
+                if m:
+                    title, label = m.group(1), m.group(2)
+                    frame = FRAME.search(label)
+                    if frame is None:  # Declared only, e.g. memcpy.
+                        continue
+                    name = label.split("\\n")[0]
+                    bounded = frame.group(2) != "dynamic"
+                    self.nodes[title] = (name, int(frame.group(1)), bounded)
+                    continue
+                m = EDGE.match(line)
+                if m:
+                    self.edges.setdefault(m.group(1), set()).add(m.group(2))
+
+    def depth(
+        self, title: str, path: List[str], unknown: Set[str]
+    ) -> Optional[Tuple[int, List[str]]]:
+        """Returns the largest sum of frames from given function and the chain of
+        names, or None if unbounded."""
+        if title in path or title == "__indirect_call":
+            return None
+        if title not in self.nodes:
+            unknown.add(title)
+            return 0, []
+        name, nbytes, bounded = self.nodes[title]
+        if not bounded:
+            return None
+        deepest: Tuple[int, List[str]] = (0, [])
+        for callee in sorted(self.edges.get(title, ())):
+            sub = self.depth(callee, path + [title], unknown)
+            if sub is None:
+                return None
+            if sub[0] > deepest[0]:
+                deepest = sub
+        return nbytes + deepest[0], [name] + deepest[1]
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--entry", default="")
+    parser.add_argument("files", nargs="+")
+    args = parser.parse_args()
+
+    graph = Graph()
+    for path in args.files:
+        graph.parse(path)
+    names = {name for name, _, _ in graph.nodes.values()}
+    if args.entry:
+        entry = re.compile(args.entry)
+        entries = {name for name in names if entry.match(name)}
+    else:  # Messages are those of the bounded decoders DecodeXXXN.
+        bounded_decoder = re.compile(r"^Decode(\w+)N$")
+        messages = [m.group(1) for m in map(bounded_decoder.match, names) if m]
+        entries = {f"{op}{m}" for m in messages for op in ("Encode", "Decode")}
+        entries.update(f"Decode{m}N" for m in messages)
+    titles = sorted(t for t, (name, _, _) in graph.nodes.items() if name in entries)
+
+    print(f"{'function':<24} {'stack':>8}  chain")
+    largest = 0
+    unknown: Set[str] = set()
+    for title in titles:
+        name = graph.nodes[title][0]
+        result = graph.depth(title, [], unknown)
+        if result is None:
+            print(f"{name:<24} {'unbounded':>8}")
+            largest = -1
+            continue
+        nbytes, chain = result
+        print(f"{name:<24} {nbytes:>8}  {' > '.join(chain)}")
+        if largest >= 0:
+            largest = max(largest, nbytes)
+    print(f"{'max':<24} {largest if largest >= 0 else 'unbounded':>8}")
+    if unknown:
+        print("not counted: " + ", ".join(sorted(unknown)), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -25,7 +25,7 @@ void encode(unsigned char *s) {
 }
 
 void decode(unsigned char *s) {
-  struct Drone drone_new = {0};
+  struct Drone drone_new;
   DecodeDrone(&drone_new, s);
 }
 
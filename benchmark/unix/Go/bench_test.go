@@ -0,0 +1,82 @@
+package bench
+
+import (
+	"runtime"
+	"strconv"
+	"testing"
+
+	"github.com/hit9/bitproto/benchmark/bench-on-os/Go/benchutil"
+	bp "github.com/hit9/bitproto/benchmark/bench-on-os/Go/bp"
+	generics "github.com/hit9/bitproto/benchmark/bench-on-os/Go/generics"
+	payload "github.com/hit9/bitproto/benchmark/bench-on-os/Go/payload"
+	payloadcopy "github.com/hit9/bitproto/benchmark/bench-on-os/Go/payloadcopy"
+	bitproto "github.com/hit9/bitproto/lib/go"
+)
+
+func BenchmarkDrone(b *testing.B) {
+	benchutil.Run(b, "Drone", func() benchutil.Message { return &bp.Drone{} })
+}
+
+// BenchmarkDroneGenerics benchmarks Drone generated with option go.generics.
+func BenchmarkDroneGenerics(b *testing.B) {
+	benchutil.Run(b, "Drone", func() benchutil.Message { return &generics.Drone{} })
+}
+
+// BenchmarkParallelBatch decodes a buffer of drones by bitproto.ParallelBatch,
+// on 1, 2, 4, ... workers up to GOMAXPROCS.
+func BenchmarkParallelBatch(b *testing.B) {
+	n := 100000
+	size := int(bp.BYTES_LENGTH_DRONE)
+	s := make([]byte, n*size)
+	ms := make([]bp.Drone, n)
+	decode := func(lo, hi int) error {
+		for k := lo; k < hi; k++ {
+			ms[k].DecodeFrom(s[k*size:])
+		}
+		return nil
+	}
+	procs := runtime.GOMAXPROCS(0)
+	for workers := 1; ; workers *= 2 {
+		if workers > procs {
+			workers = procs
+		}
+		b.Run("Workers"+strconv.Itoa(workers), func(b *testing.B) {
+			b.ReportAllocs()
+			b.SetBytes(int64(len(s)))
+			for i := 0; i < b.N; i++ {
+				bitproto.ParallelBatch(n, workers, decode)
+			}
+		})
+		if workers == procs {
+			break
+		}
+	}
+}
+
+// BenchmarkPayload decodes messages carrying byte payloads of 64, 1K and 4K
+// bytes, generated with option go.zero_copy_bytes and without, where the cost of
+// zero-copy decoding doesn't grow with the payload size.
+func BenchmarkPayload(b *testing.B) {
+	cases := []struct {
+		name string
+		m    benchutil.Message
+	}{
+		{"Copy64B", &payloadcopy.Packet64{}},
+		{"ZeroCopy64B", &payload.Packet64{}},
+		{"Copy1KB", &payloadcopy.Packet1K{}},
+		{"ZeroCopy1KB", &payload.Packet1K{}},
+		{"Copy4KB", &payloadcopy.Packet4K{}},
+		{"ZeroCopy4KB", &payload.Packet4K{}},
+	}
+	for _, c := range cases {
+		m := c.m
+		b.Run(c.name, func(b *testing.B) {
+			s := make([]byte, m.Size())
+			b.ReportAllocs()
+			b.SetBytes(int64(len(s)))
+			for i := 0; i < b.N; i++ {
+				m.DecodeFrom(s)
+			}
+		})
+	}
+}
@@ -0,0 +1,80 @@
+// Package benchutil runs the testing.B benchmarks of generated messages, shared
+// by the Drone benchmarks and the ones generated for the encoding test cases.
+package benchutil
+
+import (
+	"math/rand"
+	"testing"
+)
+
+// Message is implemented by structs generated in both standard and optimization
+// mode.
+type Message interface {
+	Size() uint32
+	Encode() []byte
+	Decode(s []byte)
+	EncodeTo(s []byte) int
+	DecodeFrom(s []byte) error
+}
+
+// Fill sets random field values to m, by decoding it from random bytes.
+// Messages that don't decode from random bytes, e.g. with extensible types of
+// out of range ahead flags, are left zero.
+func Fill(m Message, seed int64) {
+	s := make([]byte, m.Size())
+	rand.New(rand.NewSource(seed)).Read(s)
+	defer func() {
+		if recover() != nil {
+			m.DecodeFrom(make([]byte, m.Size()))
+		}
+	}()
+	m.DecodeFrom(s)
+	m.DecodeFrom(m.Encode())
+}
+
+// op is a benchmarked operation on a message m and its encoded buffer s.
+type op struct {
+	name string
+	f    func(m Message, s []byte)
+}
+
+var ops = []op{
+	{"Encode", func(m Message, s []byte) { m.Encode() }},
+	{"Decode", func(m Message, s []byte) { m.Decode(s) }},
+	{"EncodeTo", func(m Message, s []byte) { m.EncodeTo(s) }},
+	{"DecodeFrom", func(m Message, s []byte) { m.DecodeFrom(s) }},
+}
+
+// Run benchmarks encoding and decoding the message made by newMessage, reporting
+// allocations and bytes per operation. Each operation also runs in parallel on
+// GOMAXPROCS goroutines, to expose contention and the scaling of GC.
+func Run(b *testing.B, name string, newMessage func() Message) {
+	b.Run(name, func(b *testing.B) {
+		for _, o := range ops {
+			o := o
+			b.Run(o.name, func(b *testing.B) {
+				m := newMessage()
+				Fill(m, 1)
+				s := m.Encode()
+				b.ReportAllocs()
+				b.SetBytes(int64(len(s)))
+				b.ResetTimer()
+				for i := 0; i < b.N; i++ {
+					o.f(m, s)
+				}
+			})
+			b.Run(o.name+"Parallel", func(b *testing.B) {
+				b.ReportAllocs()
+				b.SetBytes(int64(newMessage().Size()))
+				b.RunParallel(func(pb *testing.PB) {
+					m := newMessage()
+					Fill(m, 1)
+					s := m.Encode()
+					for pb.Next() {
+						o.f(m, s)
+					}
+				})
+			})
+		}
+	})
+}
@@ -0,0 +1,47 @@
+"""
+Generates the testing.B benchmarks in Go for the messages defined in a bitproto
+file, into the package generated from it.
+
+Usage: python gen.py path/to/x.bitproto > path/to/package/x_bench_test.go
+"""
+
+import os
+import sys
+
+from bitproto.parser import parse
+from bitproto.renderer.impls.go.formatter import GoFormatter
+
+BENCHUTIL_IMPORT_PATH = "github.com/hit9/bitproto/benchmark/bench-on-os/Go/benchutil"
+
+
+def main() -> None:
+    filepath = sys.argv[1]
+    proto = parse(filepath)
+    formatter = GoFormatter()
+    messages = [
+        formatter.format_message_name(m)
+        for _, m in proto.messages(recursive=True, bound=proto)
+        if m.nbytes() > 0
+    ]
+
+    print(f"// Code generated by gen.py from {os.path.basename(filepath)}.")
+    print()
+    print(f"package {proto.name}")
+    print()
+    print("import (")
+    print('\t"testing"')
+    print()
+    print(f'\t"{BENCHUTIL_IMPORT_PATH}"')
+    print(")")
+    print()
+    print("func BenchmarkMessages(b *testing.B) {")
+    for message in messages:
+        print(
+            f'\tbenchutil.Run(b, "{message}", '
+            f"func() benchutil.Message {{ return &{message}{{}} }})"
+        )
+    print("}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,138 @@
+"""
+Benchmarks the encoders and decoders of every message in a bitproto file in Python, by
+pyperf, on the module generated from it.
+
+Usage: python suite.py path/to/x.bitproto path/to/module/dir --mode standard -o x.json
+
+Messages are filled with random field values by decoding random bytes, the same as the
+C suite and the Go benchmarks. Each benchmark is named schema/mode/message/op, see
+pyperf's options for the number of processes and values, e.g. --fast and --rigorous.
+
+The allocations of an operation are measured by tracemalloc in the main process, with
+--allocations path/to/x.json, over calls keeping their results: the bytes and memory
+blocks still held per call, e.g. the returned bytearrays and the ints set to fields.
+Unlike Go's B/op and allocs/op, the ones freed within a call are not counted.
+"""
+
+import gc
+import importlib
+import json
+import os
+import random
+import sys
+import tracemalloc
+from typing import Any, Callable, Dict, List, Tuple
+
+import pyperf
+from bitproto.parser import parse
+from bitproto.renderer.impls.py.formatter import PyFormatter
+
+# Number of distinct random inputs to cycle through.
+POOL = 64
+# Calls to average the allocations over.
+ALLOCATION_CALLS = 1000
+
+# Operations to benchmark on a message m and its encoded buffer s.
+OPERATIONS: List[Tuple[str, Callable[[Any, bytearray], Any]]] = [
+    ("encode", lambda m, s: m.encode()),
+    ("decode", lambda m, s: m.decode(s)),
+]
+
+
+def fill(cls: Any, seed: int) -> Any:
+    """Returns a message of given class with random field values, by decoding random
+    bytes. Messages that don't decode from random bytes, e.g. with extensible types of
+    out of range ahead flags, are left zero."""
+    rng = random.Random(seed)
+    m = cls()
+    try:
+        m.decode(bytearray(rng.getrandbits(8) for _ in range(cls.BYTES_LENGTH)))
+        m.decode(m.encode())
+    except Exception:
+        m = cls()
+    return m
+
+
+def time_op(
+    loops: int, op: Callable[[Any, bytearray], Any], pool: List[Tuple[Any, bytearray]]
+) -> float:
+    """Runs op over the pool for given loops, returns the seconds taken."""
+    n = len(pool)
+    t0 = pyperf.perf_counter()
+    for i in range(loops):
+        m, s = pool[i % n]
+        op(m, s)
+    return pyperf.perf_counter() - t0
+
+
+def allocations(
+    op: Callable[[Any, bytearray], Any], pool: List[Tuple[Any, bytearray]]
+) -> Dict[str, float]:
+    """Measures the bytes and blocks allocated per call of op by tracemalloc."""
+    n = len(pool)
+    results: List[Any] = [None] * ALLOCATION_CALLS
+    gc.collect()
+    gc.disable()
+    tracemalloc.start()
+    try:
+        before = tracemalloc.take_snapshot()
+        for i in range(ALLOCATION_CALLS):
+            m, s = pool[i % n]
+            results[i] = op(m, s)
+        after = tracemalloc.take_snapshot()
+    finally:
+        tracemalloc.stop()
+        gc.enable()
+    stats = after.compare_to(before, "filename")
+    nbytes = sum(stat.size_diff for stat in stats)
+    blocks = sum(stat.count_diff for stat in stats)
+    return {
+        "bytes_per_op": max(nbytes, 0) / ALLOCATION_CALLS,
+        "allocs_per_op": max(blocks, 0) / ALLOCATION_CALLS,
+    }
+
+
+def main() -> None:
+    runner = pyperf.Runner()
+    runner.argparser.add_argument("bitproto", help="path to the bitproto file")
+    runner.argparser.add_argument("module_dir", help="directory of the module")
+    runner.argparser.add_argument("--mode", default="standard")
+    runner.argparser.add_argument(
+        "--allocations", default="", help="file to write allocations into"
+    )
+    args = runner.parse_args()
+
+    proto = parse(args.bitproto)
+    schema = os.path.splitext(os.path.basename(args.bitproto))[0]
+    sys.path.insert(0, os.path.abspath(args.module_dir))
+    module = importlib.import_module(f"{proto.name}_bp")
+    formatter = PyFormatter()
+    messages = [
+        formatter.format_message_name(m)
+        for _, m in proto.messages(recursive=True, bound=proto)
+        if m.nbytes() > 0
+    ]
+
+    records: List[Dict[str, Any]] = []
+    for message in messages:
+        cls = getattr(module, message)
+        pool = []
+        for seed in range(POOL):
+            m = fill(cls, seed)
+            pool.append((m, m.encode()))
+        for op_name, op in OPERATIONS:
+            name = f"{schema}/{args.mode}/{message}/{op_name}"
+            runner.bench_time_func(name, time_op, op, pool)
+            if args.allocations and not args.worker:
+                record = {"schema": schema, "mode": args.mode, "message": message}
+                record.update(op=op_name, nbytes=cls.BYTES_LENGTH)
+                record.update(allocations(op, pool))
+                records.append(record)
+
+    if args.allocations and not args.worker:
+        with open(args.allocations, "w") as f:
+            json.dump(records, f, indent=1)
+
+
+if __name__ == "__main__":
+    main()
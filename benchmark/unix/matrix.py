@@ -0,0 +1,229 @@
+"""
+Runs the C suite, the Go benchmarks and the Python suite over the same schemas of the
+encoding test cases, and reports one table of the cost, bytes and allocations per
+operation, for each language and mode.
+
+Usage: python matrix.py [--schemas "drone/drone nested/nested"] [--languages c,go,py]
+                        [--fast] [-o matrix.json]
+
+Messages are filled with random field values by decoding random bytes in all three.
+The cost is the median over repetitions. Bytes and allocations per operation are those
+of go test -benchmem in Go, and of tracemalloc in Python, see Python/suite.py. The C
+library doesn't allocate, they are zero. Messages are named as in C.
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+from typing import Any, Dict, List
+
+from bitproto.parser import parse
+from bitproto.renderer.impls.c.formatter import CFormatter
+from bitproto.renderer.impls.go.formatter import GoFormatter
+from bitproto.renderer.impls.py.formatter import PyFormatter
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+CASES_PATH = os.path.join(ROOT, "..", "..", "tests", "test_encoding", "encoding-cases")
+
+# The same to the C suite's default.
+SCHEMAS = (
+    "arrays/arrays signed/signed nested/nested extensible/drone_extended "
+    "scatter/scatter drone/drone"
+)
+
+# Operations of the Go benchmarks. Encode allocates the buffer, like encode in Python,
+# EncodeTo writes to a given one, like encode in C, DecodeFrom checks the length.
+GO_OPS = {
+    "Encode": "encode",
+    "Decode": "decode",
+    "EncodeTo": "encode_to",
+    "DecodeFrom": "decode_from",
+}
+GO_BENCH = re.compile(
+    r"^BenchmarkMessages/(\w+)/(\w+?)(?:-\d+)?\s+\d+\s+([\d.]+) ns/op.*?"
+    r"([\d.]+) B/op\s+([\d.]+) allocs/op"
+)
+
+Row = Dict[str, Any]
+
+
+def message_names(schema: str, formatter: Any) -> Dict[str, str]:
+    """Returns the names of the messages in given schema formatted by formatter, to
+    their names in C."""
+    proto = parse(os.path.join(CASES_PATH, schema + ".bitproto"))
+    c = CFormatter()
+    return {
+        formatter.format_message_name(m): c.format_message_name(m)
+        for _, m in proto.messages(recursive=True, bound=proto)
+    }
+
+
+def row(lang: str, mode: str, schema: str, message: str, op: str, ns: float) -> Row:
+    return {
+        "schema": schema,
+        "message": message,
+        "op": op,
+        "language": lang,
+        "mode": mode,
+        "ns_per_op": ns,
+        "bytes_per_op": 0.0,
+        "allocs_per_op": 0.0,
+    }
+
+
+def run_c(schemas: List[str], fast: bool, tmpdir: str) -> List[Row]:
+    results = os.path.join(tmpdir, "c.json")
+    cmd = ["make", "-C", "suite", "bench", f"SCHEMAS={' '.join(schemas)}"]
+    cmd.append(f"RESULTS={results}")
+    if fast:
+        cmd.append("BENCH_ARGS=21 100")
+    subprocess.run(cmd, cwd=ROOT, check=True, stdout=subprocess.DEVNULL)
+    with open(results) as f:
+        records = json.load(f)
+    return [
+        row("c", r["mode"], r["schema"], r["message"], r["op"], r["median_ns"])
+        for r in records
+    ]
+
+
+def run_go(schemas: List[str], fast: bool) -> List[Row]:
+    goroot = os.path.join(ROOT, "Go")
+    cmd = ["make", "-C", goroot, "build-cases", f"SCHEMAS={' '.join(schemas)}"]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    packages = []
+    for mode in ("standard", "optimization"):
+        packages.extend(f"./cases/{mode}/{os.path.basename(s)}" for s in schemas)
+    ops = "|".join(GO_OPS)
+    cmd = ["go", "test", "-run", "^$", "-bench", f"Messages/./^({ops})$", "-benchmem"]
+    if fast:
+        cmd.extend(["-benchtime", "100ms"])
+    out = subprocess.run(
+        cmd + packages, cwd=goroot, check=True, stdout=subprocess.PIPE, text=True
+    ).stdout
+
+    names = {os.path.basename(s): message_names(s, GoFormatter()) for s in schemas}
+    rows: List[Row] = []
+    mode = schema = ""
+    for line in out.splitlines():
+        if line.startswith("pkg: "):
+            mode, schema = line.split("/")[-2:]
+            continue
+        m = GO_BENCH.match(line)
+        if m:
+            message = names[schema].get(m.group(1), m.group(1))
+            r = row("go", mode, schema, message, GO_OPS[m.group(2)], float(m.group(3)))
+            r.update(bytes_per_op=float(m.group(4)), allocs_per_op=float(m.group(5)))
+            rows.append(r)
+    return rows
+
+
+def run_py(schemas: List[str], fast: bool, tmpdir: str) -> List[Row]:
+    pyroot = os.path.join(ROOT, "Python")
+    rows: List[Row] = []
+    for schema in schemas:
+        name = os.path.basename(schema)
+        names = message_names(schema, PyFormatter())
+        source = os.path.join(CASES_PATH, schema + ".bitproto")
+        for mode in ("standard", "slots"):
+            outdir = os.path.join(pyroot, "cases", mode, name)
+            os.makedirs(outdir, exist_ok=True)
+            filepath = os.path.join(outdir, name + ".bitproto")
+            with open(source) as f:
+                content = f.read()
+            if mode == "slots":
+                content = re.sub(
+                    r"^(proto .*)$", r"\1\noption py.slots = true", content, 1, re.M
+                )
+            with open(filepath, "w") as f:
+                f.write(content)
+            subprocess.run(["bitproto", "py", filepath, outdir], check=True)
+
+            output = os.path.join(tmpdir, f"py-{mode}-{name}.json")
+            allocations = os.path.join(tmpdir, f"py-{mode}-{name}-alloc.json")
+            cmd = [sys.executable, "suite.py", filepath, outdir, "--mode", mode]
+            cmd.extend(["-o", output, "--allocations", allocations, "--quiet"])
+            if fast:
+                cmd.append("--fast")
+            subprocess.run(cmd, cwd=pyroot, check=True)
+
+            with open(allocations) as f:
+                usage = {(r["message"], r["op"]): r for r in json.load(f)}
+            with open(output) as f:
+                suite = json.load(f)
+            for bench in suite["benchmarks"]:
+                values = [v for run in bench["runs"] for v in run.get("values", [])]
+                _, _, message, op = bench["metadata"]["name"].split("/")
+                u = usage[(message, op)]
+                r = row("py", mode, name, names.get(message, message), op, 0.0)
+                r.update(ns_per_op=statistics.median(values) * 1e9)
+                r.update(bytes_per_op=u["bytes_per_op"])
+                r.update(allocs_per_op=u["allocs_per_op"])
+                rows.append(r)
+    return rows
+
+
+def format_table(rows: List[Row]) -> str:
+    header = ["schema", "message", "op", "language", "mode"]
+    header += ["ns/op", "B/op", "allocs/op"]
+    lines = [header]
+    for r in rows:
+        line = [r["schema"], r["message"], r["op"], r["language"], r["mode"]]
+        line.append(f"{r['ns_per_op']:.1f}")
+        line.append(f"{r['bytes_per_op']:.1f}")
+        line.append(f"{r['allocs_per_op']:.2f}")
+        lines.append(line)
+    widths = [max(len(line[k]) for line in lines) for k in range(len(header))]
+    return "\n".join(
+        "  ".join(
+            v.ljust(w) if k < 5 else v.rjust(w)
+            for k, (v, w) in enumerate(zip(line, widths))
+        )
+        for line in lines
+    )
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--schemas", default=SCHEMAS)
+    parser.add_argument("--languages", default="c,go,py")
+    parser.add_argument("--fast", action="store_true")
+    parser.add_argument("-o", "--output", default="matrix.json")
+    args = parser.parse_args()
+
+    schemas = args.schemas.split()
+    languages = args.languages.split(",")
+    rows: List[Row] = []
+    tmpdir = tempfile.mkdtemp()
+    try:
+        if "c" in languages:
+            rows.extend(run_c(schemas, args.fast, tmpdir))
+        if "go" in languages:
+            rows.extend(run_go(schemas, args.fast))
+        if "py" in languages:
+            rows.extend(run_py(schemas, args.fast, tmpdir))
+    finally:
+        shutil.rmtree(tmpdir)
+
+    order = {lang: k for k, lang in enumerate(["c", "go", "py"])}
+    rows.sort(
+        key=lambda r: (
+            r["schema"],
+            r["message"],
+            r["op"],
+            order[r["language"]],
+            r["mode"],
+        )
+    )
+    with open(args.output, "w") as f:
+        json.dump(rows, f, indent=1)
+    print(format_table(rows))
+
+
+if __name__ == "__main__":
+    main()
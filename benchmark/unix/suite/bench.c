@@ -0,0 +1,133 @@
+/* Micro-benchmark harness for bitproto generated C code.
+ *
+ * Each operation is timed by a monotonic clock in repetitions of a batch of
+ * calls, after a warm-up. The batch size is calibrated to last a target
+ * duration, so that the clock's resolution and overhead are negligible. The
+ * inputs are a pool of messages with random field values, cycled through by
+ * the calls. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Number of distinct random inputs to cycle through. */
+#define POOL 64
+
+/* Keeps the results of decodes observable to the compiler. */
+static volatile unsigned char sink;
+
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+/* Xorshift64, fixed seed for reproducible inputs. */
+static uint64_t Random(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Returns a monotonic timestamp in nanoseconds. */
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+struct Pool {
+  struct BenchMessage *m;
+  unsigned char *structs; /* POOL structs. */
+  unsigned char *buffers; /* POOL encoded buffers. */
+};
+
+/* Fills the pool with random messages. Random bytes of the struct are encoded
+ * and then decoded, which keeps the value of each field in its bits. */
+static void PoolInit(struct Pool *p, struct BenchMessage *m) {
+  p->m = m;
+  p->structs = calloc(POOL, m->size);
+  p->buffers = calloc(POOL, m->nbytes);
+  unsigned char *tmp = malloc(m->size);
+  for (int k = 0; k < POOL; k++) {
+    for (size_t j = 0; j < m->size; j++) tmp[j] = (unsigned char)Random();
+    unsigned char *s = p->buffers + k * m->nbytes;
+    m->encode(tmp, s);
+    m->decode(p->structs + k * m->size, s);
+    memset(s, 0, m->nbytes);
+    m->encode(p->structs + k * m->size, s);
+  }
+  free(tmp);
+}
+
+static void PoolFree(struct Pool *p) {
+  free(p->structs);
+  free(p->buffers);
+}
+
+/* Runs calls of the operation, returns the elapsed nanoseconds. */
+static double Run(struct Pool *p, int is_encode, long calls) {
+  struct BenchMessage *m = p->m;
+  unsigned char *out = malloc(m->size > m->nbytes ? m->size : m->nbytes);
+  memset(out, 0, m->size > m->nbytes ? m->size : m->nbytes);
+  double start = Now();
+  for (long i = 0; i < calls; i++) {
+    int k = (int)(i % POOL);
+    if (is_encode)
+      m->encode(p->structs + k * m->size, out);
+    else
+      m->decode(out, p->buffers + k * m->nbytes);
+  }
+  double end = Now();
+  sink = out[0];
+  free(out);
+  return end - start;
+}
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static void Bench(const char *schema, const char *mode, struct Pool *p,
+                  int is_encode, int repetitions, double target_ns) {
+  /* Calibrates the batch size, which warms up the caches as well. */
+  long calls = 1;
+  while (Run(p, is_encode, calls) < target_ns && calls < (1L << 30)) calls *= 2;
+  for (int k = 0; k < 3; k++) Run(p, is_encode, calls);
+
+  double *ns = malloc(sizeof(double) * repetitions);
+  for (int k = 0; k < repetitions; k++)
+    ns[k] = Run(p, is_encode, calls) / calls;
+  qsort(ns, repetitions, sizeof(double), CompareDouble);
+
+  int p99 = (repetitions * 99 + 99) / 100 - 1;
+  printf("{\"schema\": \"%s\", \"mode\": \"%s\", \"message\": \"%s\", "
+         "\"op\": \"%s\", \"nbytes\": %zu, \"calls\": %ld, "
+         "\"repetitions\": %d, \"min_ns\": %.2f, \"median_ns\": %.2f, "
+         "\"p99_ns\": %.2f, \"max_ns\": %.2f}\n",
+         schema, mode, p->m->name, is_encode ? "encode" : "decode",
+         p->m->nbytes, calls, repetitions, ns[0], ns[repetitions / 2],
+         ns[p99], ns[repetitions - 1]);
+  free(ns);
+}
+
+int BenchMain(const char *schema, const char *mode, struct BenchMessage *ms,
+              int n, int argc, char **argv) {
+  /* Usage: bench [repetitions] [target microseconds per repetition] */
+  int repetitions = argc > 1 ? atoi(argv[1]) : 101;
+  double target_ns = (argc > 2 ? atof(argv[2]) : 1000) * 1000;
+  if (repetitions < 1) repetitions = 1;
+
+  for (int k = 0; k < n; k++) {
+    struct Pool p;
+    PoolInit(&p, &ms[k]);
+    Bench(schema, mode, &p, 1, repetitions, target_ns);
+    Bench(schema, mode, &p, 0, repetitions, target_ns);
+    PoolFree(&p);
+  }
+  return 0;
+}
@@ -0,0 +1,38 @@
+/* Micro-benchmark harness for bitproto generated C code. */
+
+#ifndef __BITPROTO_BENCH_H__
+#define __BITPROTO_BENCH_H__ 1
+
+#include <stddef.h>
+
+/* BenchMessage describes a message to benchmark, see BENCH_MESSAGE. */
+struct BenchMessage {
+  /* Name of the message. */
+  const char *name;
+  /* Size of the struct in C. */
+  size_t size;
+  /* Number of bytes of the encoding. */
+  size_t nbytes;
+  int (*encode)(void *m, unsigned char *s);
+  int (*decode)(void *m, unsigned char *s);
+};
+
+/* BENCH_MESSAGE defines the wrappers of encoder and decoder of message X. */
+#define BENCH_MESSAGE(X)                                                       \
+  static int BenchEncode##X(void *m, unsigned char *s) {                       \
+    return Encode##X((struct X *)m, s);                                        \
+  }                                                                            \
+  static int BenchDecode##X(void *m, unsigned char *s) {                       \
+    return Decode##X((struct X *)m, s);                                        \
+  }
+
+/* BENCH_ENTRY is the BenchMessage of message X, with the length macro of it. */
+#define BENCH_ENTRY(X, nbytes)                                                 \
+  { #X, sizeof(struct X), (nbytes), BenchEncode##X, BenchDecode##X }
+
+/* BenchMain benchmarks given messages of schema in given mode, prints a JSON
+ * object per line for each message and operation. */
+int BenchMain(const char *schema, const char *mode, struct BenchMessage *ms,
+              int n, int argc, char **argv);
+
+#endif
@@ -0,0 +1,102 @@
+/* Micro-benchmark of BpCopyBufferBits, the primitive under all encoding and
+ * decoding in standard mode.
+ *
+ * Sweeps all 64 pairs of source and destination bit offsets (si & 7, di & 7)
+ * against bit lengths from 1 to 1024, on random and all-zero source data, and
+ * prints the median cost per call and per bit as a JSON array. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bitproto.h"
+
+/* Bytes of the source and destination buffers, enough for 1024 bits at any
+ * offset. */
+#define SIZE 136
+
+/* Number of distinct buffers to cycle through, to not measure a single hot
+ * cache line. */
+#define POOL 16
+
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+/* Xorshift64, fixed seed for reproducible inputs. */
+static uint64_t Random(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Returns a monotonic timestamp in nanoseconds. */
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static unsigned char src[POOL][SIZE];
+static unsigned char dst[POOL][SIZE];
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* Returns the median nanoseconds per call over repetitions of calls. */
+static double Measure(int n, int si, int di, long calls, int repetitions) {
+  double ns[repetitions];
+  for (int r = 0; r < repetitions; r++) {
+    double start = Now();
+    for (long i = 0; i < calls; i++) {
+      int k = (int)(i % POOL);
+      BpCopyBufferBits(n, dst[k], src[k], di, si);
+    }
+    ns[r] = (Now() - start) / calls;
+  }
+  qsort(ns, repetitions, sizeof(double), CompareDouble);
+  return ns[repetitions / 2];
+}
+
+/* Returns whether to measure bit length n: all lengths up to 64, and then
+ * every 8 bits, or every length if full. */
+static int IsSampled(int n, int full) { return full || n <= 64 || n % 8 == 0; }
+
+int main(int argc, char **argv) {
+  /* Usage: copybits [full] [calls per repetition] [repetitions] */
+  int full = argc > 1 && strcmp(argv[1], "full") == 0;
+  long calls = argc > 2 ? atol(argv[2]) : 1000;
+  int repetitions = argc > 3 ? atoi(argv[3]) : 7;
+  if (calls < 1) calls = 1;
+  if (repetitions < 1) repetitions = 1;
+
+  const char *datas[] = {"random", "zero"};
+  int first = 1;
+  printf("[\n");
+  for (int d = 0; d < 2; d++) {
+    for (int k = 0; k < POOL; k++)
+      for (int j = 0; j < SIZE; j++)
+        src[k][j] = d == 0 ? (unsigned char)Random() : 0;
+    Measure(1024, 0, 0, calls * 10, 1); /* Warm-up. */
+
+    for (int si = 0; si < 8; si++) {
+      for (int di = 0; di < 8; di++) {
+        for (int n = 1; n <= 1024; n++) {
+          if (!IsSampled(n, full)) continue;
+          double ns = Measure(n, si, di, calls, repetitions);
+          printf("%s{\"data\": \"%s\", \"si\": %d, \"di\": %d, \"n\": %d, "
+                 "\"ns\": %.2f, \"ns_per_bit\": %.4f}",
+                 first ? "" : ",\n", datas[d], si, di, n, ns, ns / n);
+          first = 0;
+        }
+      }
+    }
+  }
+  printf("\n]\n");
+  return 0;
+}
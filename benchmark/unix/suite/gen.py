@@ -0,0 +1,55 @@
+"""
+Generates the benchmark driver in C for the messages defined in a bitproto file.
+
+Usage: python gen.py path/to/x.bitproto > x_bench.c
+"""
+
+import os
+import sys
+
+from bitproto.parser import parse
+from bitproto.renderer.impls.c.formatter import CFormatter
+from bitproto.utils import snake_case, upper_case
+
+
+def main() -> None:
+    filepath = sys.argv[1]
+    proto = parse(filepath)
+    formatter = CFormatter()
+    name = os.path.splitext(os.path.basename(filepath))[0]
+    messages = [
+        formatter.format_message_name(m)
+        for _, m in proto.messages(recursive=True, bound=proto)
+        if m.nbytes() > 0
+    ]
+
+    print(f"// Code generated by gen.py from {os.path.basename(filepath)}.")
+    print('#include "bench.h"')
+    print(f'#include "{name}_bp.h"')
+    print()
+    for message in messages:
+        print(f"BENCH_MESSAGE({message})")
+    print()
+    print("static struct BenchMessage messages[] = {")
+    for message in messages:
+        length = "BYTES_LENGTH_" + upper_case(snake_case(message))
+        print(f"    BENCH_ENTRY({message}, {length}),")
+    print("};")
+    print()
+    # BENCH_MODE_SUFFIX tells the variants of a mode apart, e.g. "-norestrict".
+    print("#ifndef BENCH_MODE_SUFFIX")
+    print('#define BENCH_MODE_SUFFIX ""')
+    print("#endif")
+    print()
+    print("int main(int argc, char **argv) {")
+    print("#ifdef BITPROTO_OPTIMIZATION_MODE")
+    print('  const char *mode = "optimization" BENCH_MODE_SUFFIX;')
+    print("#else")
+    print('  const char *mode = "standard" BENCH_MODE_SUFFIX;')
+    print("#endif")
+    print(f'  return BenchMain("{name}", mode, messages, {len(messages)}, argc, argv);')
+    print("}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+/* Benchmark of the datagram batch functions, built with BP_MMSG, on Linux.
+ *
+ * Sends and receives Drone frames over UDP loopback, one datagram per frame,
+ * by send and recv of a frame at a time, and by SendDroneBatch and
+ * RecvDroneBatch of 1, 2, 4, ... frames up to BP_MMSG_MAX a syscall. Prints
+ * the median throughput and the syscalls per frame as a JSON array. */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "drone_bp.h"
+
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+/* Xorshift64, fixed seed for reproducible inputs. */
+static uint64_t Random(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Returns a monotonic timestamp in nanoseconds. */
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static int rfd, wfd;
+static struct Drone ms[BP_MMSG_MAX];
+static unsigned char s[BP_MMSG_MAX * BYTES_LENGTH_DRONE];
+
+/* Sends and receives count frames, batch frames a syscall, or a frame at a
+ * time by send and recv if batch is 0. Returns the number of syscalls. */
+static long Run(size_t count, int batch) {
+  long syscalls = 0;
+  if (batch == 0) {
+    for (size_t k = 0; k < count; k++) {
+      EncodeDrone(&ms[0], s);
+      if (send(wfd, s, BYTES_LENGTH_DRONE, 0) != BYTES_LENGTH_DRONE) exit(1);
+      if (recv(rfd, s, BYTES_LENGTH_DRONE, 0) != BYTES_LENGTH_DRONE) exit(1);
+      DecodeDrone(&ms[0], s);
+      syscalls += 2;
+    }
+    return syscalls;
+  }
+  for (size_t k = 0; k < count; k += batch) {
+    if (SendDroneBatch(wfd, ms, batch, s, 0) != batch) exit(1);
+    syscalls++;
+    /* Frames sent to loopback are queued already, received by one call. */
+    for (int n = 0; n < batch; syscalls++) {
+      int ret = RecvDroneBatch(rfd, ms + n, batch - n, s, MSG_WAITFORONE);
+      if (ret <= 0) exit(1);
+      n += ret;
+    }
+  }
+  return syscalls;
+}
+
+/* Returns the median nanoseconds of count frames over repetitions, and the
+ * syscalls of a pass. */
+static double Measure(size_t count, int batch, int repetitions,
+                      long *syscalls) {
+  double ns[repetitions];
+  for (int r = 0; r < repetitions; r++) {
+    double start = Now();
+    *syscalls = Run(count, batch);
+    ns[r] = Now() - start;
+  }
+  qsort(ns, repetitions, sizeof(double), CompareDouble);
+  return ns[repetitions / 2];
+}
+
+int main(int argc, char **argv) {
+  /* Usage: mmsg [frames] [repetitions] */
+  size_t count = argc > 1 ? (size_t)atol(argv[1]) : 200000;
+  int repetitions = argc > 2 ? atoi(argv[2]) : 7;
+  if (repetitions < 1) repetitions = 1;
+  /* Whole batches of the largest size. */
+  count = (count + BP_MMSG_MAX - 1) / BP_MMSG_MAX * BP_MMSG_MAX;
+
+  rfd = socket(AF_INET, SOCK_DGRAM, 0);
+  wfd = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr = {0};
+  socklen_t addrlen = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (rfd < 0 || wfd < 0 ||
+      bind(rfd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      getsockname(rfd, (struct sockaddr *)&addr, &addrlen) != 0 ||
+      connect(wfd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+    perror("socket");
+    return 1;
+  }
+
+  /* Random frames, normalized by a decoding and encoding round trip. */
+  for (size_t k = 0; k < sizeof(s); k++) s[k] = (unsigned char)Random();
+  DecodeDroneBatch(ms, BP_MMSG_MAX, s);
+
+  long syscalls;
+  Measure(count / 10 + 1, 0, 1, &syscalls); /* Warm-up. */
+  printf("[\n");
+  for (int batch = 0; batch <= BP_MMSG_MAX; batch = batch ? batch * 2 : 1) {
+    double ns = Measure(count, batch, repetitions, &syscalls);
+    printf("%s{\"op\": \"%s\", \"batch\": %d, \"frames\": %zu, "
+           "\"ns_per_frame\": %.1f, \"frames_per_s\": %.0f, "
+           "\"syscalls_per_frame\": %.3f}",
+           batch ? ",\n" : "", batch ? "mmsg" : "send/recv", batch ? batch : 1,
+           count, ns / count, count * 1e9 / ns, (double)syscalls / count);
+  }
+  printf("\n]\n");
+  close(rfd);
+  close(wfd);
+  return 0;
+}
@@ -0,0 +1,101 @@
+/* Scaling benchmark of the parallel batch functions, built with BP_PARALLEL.
+ *
+ * Encodes and decodes a contiguous buffer of Drone records by
+ * EncodeDroneBatchParallel and DecodeDroneBatchParallel on 1, 2, 4, ... threads
+ * up to the number of processors online (or given), and prints the median
+ * throughput and the speedup over a single thread as a JSON array. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "drone_bp.h"
+
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+/* Xorshift64, fixed seed for reproducible inputs. */
+static uint64_t Random(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Returns a monotonic timestamp in nanoseconds. */
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static struct Drone *ms;
+static unsigned char *s;
+
+/* Returns the median nanoseconds of a pass over count records on nthreads
+ * threads, over repetitions. */
+static double Measure(int decode, size_t count, int nthreads,
+                      int repetitions) {
+  double ns[repetitions];
+  for (int r = 0; r < repetitions; r++) {
+    double start = Now();
+    if (decode)
+      DecodeDroneBatchParallel(ms, count, s, nthreads);
+    else
+      EncodeDroneBatchParallel(ms, count, s, nthreads);
+    ns[r] = Now() - start;
+  }
+  qsort(ns, repetitions, sizeof(double), CompareDouble);
+  return ns[repetitions / 2];
+}
+
+int main(int argc, char **argv) {
+  /* Usage: parallel [records] [repetitions] [max threads] */
+  size_t count = argc > 1 ? (size_t)atol(argv[1]) : 1000000;
+  int repetitions = argc > 2 ? atoi(argv[2]) : 11;
+  if (count < 1) count = 1;
+  if (repetitions < 1) repetitions = 1;
+  long nprocs = argc > 3 ? atol(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+  if (nprocs < 1) nprocs = 1;
+
+  ms = calloc(count, sizeof(struct Drone));
+  s = malloc(count * BYTES_LENGTH_DRONE);
+  if (ms == NULL || s == NULL) return 1;
+  /* Random buffer, normalized by a decoding and encoding round trip. */
+  for (size_t k = 0; k < count * BYTES_LENGTH_DRONE; k++)
+    s[k] = (unsigned char)Random();
+  DecodeDroneBatch(ms, count, s);
+  EncodeDroneBatch(ms, count, s);
+
+  const char *ops[] = {"encode", "decode"};
+  int first = 1;
+  printf("[\n");
+  for (int decode = 0; decode < 2; decode++) {
+    Measure(decode, count, 1, 1); /* Warm-up. */
+    double base = 0;
+    for (long n = 1;; n *= 2) {
+      if (n > nprocs) n = nprocs;
+      double ns = Measure(decode, count, (int)n, repetitions);
+      if (n == 1) base = ns;
+      printf("%s{\"op\": \"%s\", \"threads\": %ld, \"records\": %zu, "
+             "\"ns_per_record\": %.2f, \"mb_per_s\": %.1f, \"speedup\": %.2f}",
+             first ? "" : ",\n", ops[decode], n, count, ns / count,
+             count * BYTES_LENGTH_DRONE * 1e3 / ns, base / ns);
+      first = 0;
+      if (n == nprocs) break;
+    }
+  }
+  printf("\n]\n");
+  free(ms);
+  free(s);
+  return 0;
+}
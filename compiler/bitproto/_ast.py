@@ -13,6 +13,9 @@ Abstraction syntax tree.
       |    |    |    |- Byte            :BaseType:SingleType:Type:Node
       |    |    |    |- Int             :BaseType:SingleType:Type:Node
       |    |    |    |- Uint            :BaseType:SingleType:Type:Node
+      |    |    |    |- Range           :BaseType:SingleType:Type:Node
+      |    |    |    |- Float           :BaseType:SingleType:Type:Node
+      |    |    |    |- Fixed           :BaseType:SingleType:Type:Node
       |    |    |- Enum                 :SingleType:Type:Node
       |    |- CompositeType             :Type:Node
       |    |    |- Array                :CompositeType:Type:Node
@@ -35,9 +38,11 @@ Abstraction syntax tree.
       |    |- Field                     :Definition:Node
       |    |    |- EnumField            :Field:Definition:Node
       |    |    |- MessageField         :Field:Definition:Node
+      |    |    |- OneofVariant         :Field:Definition:Node
       |    |- Scope                     :Definition:Node
       |    |    |- Enum                 :Scope:Definition:Node
       |    |    |- Message              :Scope:Definition:Node
+      |    |    |- Oneof                :Scope:Definition:Node
       |    |    |- Proto                :Scope:Definition:Node
 """
 
@@ -48,8 +53,10 @@ from typing import (
     Callable,
     ClassVar,
     Dict,
+    FrozenSet,
     List,
     Optional,
+    Set,
     Tuple,
     Type as T,
     TypeVar,
@@ -61,13 +68,20 @@ from bitproto.errors import (
     DuplicatedDefinition,
     DuplicatedEnumFieldValue,
     DuplicatedMessageFieldNumber,
+    DuplicatedOneofVariantTag,
+    EmptyOneofUnsupported,
     EnumFieldValueOverflow,
     InternalError,
     InvalidAliasedType,
     InvalidArrayCap,
+    InvalidBoundedArray,
     InvalidEnumFieldValue,
+    InvalidFieldRange,
+    InvalidFixedCap,
     InvalidIntCap,
     InvalidMessageFieldNumber,
+    InvalidOneofVariantTag,
+    InvalidOneofVariantType,
     InvalidOptionValue,
     InvalidUintCap,
     MessageSizeOverflows,
@@ -203,6 +217,15 @@ class BoundDefinition(Definition):
             return self._bound
         raise InternalError("BoundDefinition got bound None")
 
+    @property
+    def path(self) -> Tuple[str, ...]:
+        """Path of this definition, the file path (or name) of the proto it's bound to,
+        followed by the names of the scopes down to it. The definitions of a proto
+        imported many times, which is parsed as many, share the same path."""
+        proto = self.bound
+        names = tuple(s.name for s in self.scope_stack if not isinstance(s, Proto))
+        return (proto.filepath or proto.name,) + names + (self.name,)
+
 
 _VALUE_MISSING = "_value_missing"
 
@@ -487,6 +510,11 @@ class Scope(Definition):
     ) -> List[Tuple[str, "MessageField"]]:
         return self.filter(MessageField, recursive=recursive, bound=bound)
 
+    def oneofs(
+        self, recursive: bool = False, bound: Optional["Proto"] = None
+    ) -> List[Tuple[str, "Oneof"]]:
+        return self.filter(Oneof, recursive=recursive, bound=bound)
+
     def protos(self, recursive: bool = False) -> List[Tuple[str, "Proto"]]:
         return self.filter(Proto, recursive=recursive, bound=None)  # proto has no bound
 
@@ -617,6 +645,20 @@ class Type(Node):
         """
         raise NotImplementedError
 
+    @overridable
+    def is_fixed_size(self) -> bool:
+        """Returns True if this type always occupies nbits() bits in encoding,
+        that's to say, no extensible types inside it (recursively).
+        """
+        return True
+
+    @overridable
+    def has_bounded_array(self) -> bool:
+        """Returns True if this type is a bounded array, or contains one inside
+        (recursively), of which the number of bits in encoding varies.
+        """
+        return False
+
     @final
     @cache_if_frozen
     def nbytes(self) -> int:
@@ -650,7 +692,7 @@ class CompositeType(Type):
 @dataclass
 class BaseType(SingleType):
     """BaseType is the type of base values.
-    In bitproto, bool, byte and integer are base types.
+    In bitproto, bool, byte, integer, float32 and fixed-point are base types.
     """
 
 
@@ -734,6 +776,102 @@ class Int(Integer):
         return "<type int{0}>".format(self.cap)
 
 
+@final
+@frozen
+@dataclass
+class Range(Integer):
+    """Range is the type of a message field annotated by option range, e.g.
+    `uint16 altitude = 1 [range = 1000..21000]`. The field holds the declared integer
+    type in languages, and is encoded as value - lo in the minimal number of bits to
+    hold hi - lo.
+    """
+
+    type: Type = dataclass_field(default_factory=Type)
+    lo: int = 0
+    hi: int = 0
+
+    @override(Type)
+    def nbits(self) -> int:
+        return max(1, (self.hi - self.lo).bit_length())
+
+    @override(Node)
+    def validate_post_freeze(self) -> None:
+        t = self.type
+        if isinstance(t, Int):
+            lo, hi = -(1 << (t.cap - 1)), (1 << (t.cap - 1)) - 1
+        elif isinstance(t, Uint):
+            lo, hi = 0, (1 << t.cap) - 1
+        else:
+            raise InvalidFieldRange.from_token(
+                token=self, message="range applies to uint and int fields only"
+            )
+        if not (lo <= self.lo <= self.hi <= hi):
+            raise InvalidFieldRange.from_token(token=self)
+
+    def __repr__(self) -> str:
+        return "<type range {0}..{1}>".format(self.lo, self.hi)
+
+
+@final
+@frozen
+@dataclass
+class Float(BaseType):
+    """Float is the IEEE 754 single precision floating point number, encoded as its
+    32 bits in the same byte order as uint32.
+    """
+
+    @override(Type)
+    def nbits(self) -> int:
+        return 32
+
+    def __repr__(self) -> str:
+        return "<type float32>"
+
+
+@final
+@frozen
+@dataclass
+class Fixed(BaseType):
+    """Fixed is the fixed-point number, e.g. fixed16.8 is a signed number of 16 bits
+    with 8 fractional bits, and ufixed16.8 is an unsigned one. A value v is encoded as
+    the integer v * 2^frac rounded half away from zero, in cap bits. The value is a
+    floating point number in languages.
+    """
+
+    cap: int = 0
+    frac: int = 0
+    signed: bool = True
+
+    @override(Node)
+    def validate_post_freeze(self) -> None:
+        if self._is_missing:
+            return
+        if not (0 < self.cap <= 64 and 0 <= self.frac <= self.cap):
+            raise InvalidFixedCap.from_token(token=self)
+
+    @override(Type)
+    def nbits(self) -> int:
+        return self.cap
+
+    def is_double(self) -> bool:
+        """Returns True if the value of this type doesn't fit the 24 bits significand
+        of a single precision floating point number, and is held in double precision.
+        """
+        return self.cap > 24
+
+    def scale(self) -> float:
+        """Returns the factor a value is multiplied by on encoding, 2^frac."""
+        return float(1 << self.frac)
+
+    def unit(self) -> float:
+        """Returns the value of the least significant bit, 2^-frac."""
+        return 2.0 ** -self.frac
+
+    def __repr__(self) -> str:
+        prefix = "fixed" if self.signed else "ufixed"
+        return "<type {0}{1}.{2}>".format(prefix, self.cap, self.frac)
+
+
 @dataclass
 class ExtensibleType(Type):
     """ExtensibleType is the type able to extend its size for forward-compatiable
@@ -757,12 +895,15 @@ class Array(CompositeType, ExtensibleType):
     """Array, described by element type and capacity.
     :param type: The type of array element.
     :param cap: Max value of number of elements.
+    :param bounded: Whether it's a bounded array, e.g. `uint8[<=256]`, of which only
+       the elements in use are encoded, prefixed by their count in count_nbits().
 
     Constraint: Capacity of array should be smaller than 65536.
     """
 
     element_type: Type = dataclass_field(default_factory=lambda: _TYPE_MISSING)
     cap: int = 0
+    bounded: bool = False
 
     @classmethod
     def element_type_constraints(cls) -> Tuple[T[Type], ...]:
@@ -771,6 +912,8 @@ class Array(CompositeType, ExtensibleType):
             Byte,
             Int,
             Uint,
+            Float,
+            Fixed,
             Enum,
             Message,
             Alias,
@@ -788,23 +931,48 @@ class Array(CompositeType, ExtensibleType):
     def validate_array_element_type(self) -> None:
         if not isinstance(self.element_type, self.element_type_constraints()):
             raise UnsupportedArrayType.from_token(token=self)
+        if self.extensible and self.element_type.has_bounded_array():
+            message = "Bounded array can't be inside an extensible array."
+            raise InvalidBoundedArray.from_token(token=self, message=message)
 
     @override(ExtensibleType)
     def ahead_nbits(self) -> int:
         return 16
 
+    def count_nbits(self) -> int:
+        """Returns the number of bits the count of a bounded array occupies, the
+        minimal width to hold its capacity."""
+        return self.cap.bit_length()
+
     @override(Type)
     @cache_if_frozen
     def nbits(self) -> int:
+        """For a bounded array, it's the max number of bits, with all elements in
+        use."""
         n = self.cap * self.element_type.nbits()
+        if self.bounded:
+            return self.count_nbits() + n
         if not self.extensible:
             return n
         return self.ahead_nbits() + n
 
+    @override(Type)
+    @cache_if_frozen
+    def is_fixed_size(self) -> bool:
+        if self.bounded:
+            return False
+        return not self.extensible and self.element_type.is_fixed_size()
+
+    @override(Type)
+    @cache_if_frozen
+    def has_bounded_array(self) -> bool:
+        return self.bounded or self.element_type.has_bounded_array()
+
     def __repr__(self) -> str:
         extensible_flag = "'" if self.extensible else ""
-        return "<type array ({0}, cap={1}){2}>".format(
-            self.element_type, self.cap, extensible_flag
+        bounded_flag = "<=" if self.bounded else ""
+        return "<type array ({0}, cap={1}{2}){3}>".format(
+            self.element_type, bounded_flag, self.cap, extensible_flag
         )
 
 
@@ -830,6 +998,9 @@ class Alias(Type, BoundDefinition):
                 f"target type '{self.type.name}' already has a name."
             )
             raise InvalidAliasedType.from_token(token=self, message=message)
+        if isinstance(self.type, Array) and self.type.bounded:
+            message = "Bounded array can't be aliased, declare it as a message field."
+            raise InvalidBoundedArray.from_token(token=self, message=message)
 
     @override(Node)
     def validate_post_freeze(self) -> None:
@@ -839,6 +1010,14 @@ class Alias(Type, BoundDefinition):
     def nbits(self) -> int:
         return self.type.nbits()
 
+    @override(Type)
+    def is_fixed_size(self) -> bool:
+        return self.type.is_fixed_size()
+
+    @override(Type)
+    def has_bounded_array(self) -> bool:
+        return self.type.has_bounded_array()
+
     @property
     def extensible(self) -> bool:
         if isinstance(self.type, ExtensibleType):
@@ -991,6 +1170,18 @@ class Message(BoundScope, ScopeWithOptions, CompositeType, ExtensibleType):
             return n
         return self.ahead_nbits() + n
 
+    @override(Type)
+    @cache_if_frozen
+    def is_fixed_size(self) -> bool:
+        if self.extensible:
+            return False
+        return all(field.type.is_fixed_size() for field in self.fields())
+
+    @override(Type)
+    @cache_if_frozen
+    def has_bounded_array(self) -> bool:
+        return any(field.type.has_bounded_array() for field in self.fields())
+
     def __repr__(self) -> str:
         extensible_flag = "'" if self.extensible else ""
         return f"<message {self.name}{extensible_flag}>"
@@ -1007,7 +1198,14 @@ class Message(BoundScope, ScopeWithOptions, CompositeType, ExtensibleType):
 
     @override(Node)
     def validate_post_freeze(self) -> None:
-        if self.nbits() > 65535:
+        if self.get_option_as_bool_or_raise("large"):
+            if self.extensible:
+                message = "Large message can't be extensible, the ahead flag is 16 bits"
+                raise MessageSizeOverflows.from_token(token=self, message=message)
+            if self.nbits() > 0x7FFFFFFF:
+                message = "Large message size overflows constraint, should <= 2147483647 bits"
+                raise MessageSizeOverflows.from_token(token=self, message=message)
+        elif self.nbits() > 65535:
             raise MessageSizeOverflows.from_token(token=self)
 
         max_bytes = self.get_option_as_int_or_raise("max_bytes")
@@ -1015,6 +1213,16 @@ class Message(BoundScope, ScopeWithOptions, CompositeType, ExtensibleType):
             message = f"Message size overflows constraint option, which configured to {max_bytes}bytes"
             raise MessageSizeOverflows.from_token(token=self, message=message)
 
+        if self.has_bounded_array():
+            # The ahead flag holds the number of bits of current version, and the
+            # direct codecs work on bit offsets known at compile time.
+            if self.extensible:
+                message = "Bounded array can't be inside an extensible message."
+                raise InvalidBoundedArray.from_token(token=self, message=message)
+            if self.get_option_as_bool_or_raise("direct_codec"):
+                message = "Message with bounded arrays can't set option direct_codec."
+                raise InvalidBoundedArray.from_token(token=self, message=message)
+
     @override(Scope)
     def validate_member_on_push(
         self, member: Definition, name: Optional[str] = None
@@ -1030,6 +1238,94 @@ class Message(BoundScope, ScopeWithOptions, CompositeType, ExtensibleType):
             raise DuplicatedMessageFieldNumber.from_token(token=field)
 
 
+@final
+@frozen
+@dataclass
+class OneofVariant(Field):
+    type: Type = dataclass_field(default_factory=Type)
+    tag: int = 0
+
+    def __repr__(self) -> str:
+        return f"<oneof-variant {self.name}={self.tag}>"
+
+    @property
+    def oneof(self) -> "Oneof":
+        scope = self.scope_stack[-1]
+        if isinstance(scope, Oneof):
+            return cast(Oneof, self.scope_stack[-1])
+        raise InternalError("oneof_variant's last scope not oneof")
+
+    @property
+    def message(self) -> Message:
+        return cast(Message, self.type)
+
+    @override(Node)
+    def validate_post_freeze(self) -> None:
+        """Constraint oneof variant tag from 1 to 255, and the type to messages in
+        fixed size."""
+        if not (0 < self.tag < 256):
+            raise InvalidOneofVariantTag.from_token(token=self)
+        if not (isinstance(self.type, Message) and self.type.is_fixed_size()):
+            raise InvalidOneofVariantType.from_token(token=self)
+
+
+@final
+@frozen(post_init=False)
+@dataclass
+class Oneof(BoundScope):
+    """Oneof, a tagged union of messages, exactly one variant is active.
+    Encoded as the tag of the active variant, in the least number of bits holding
+    the largest tag, followed by the active variant."""
+
+    def __repr__(self) -> str:
+        return f"<oneof {self.name}>"
+
+    @cache_if_frozen
+    def variants(self) -> List[OneofVariant]:
+        """Returns the OneofVariant list in this oneof scope."""
+        return [v for _, v in self.filter(OneofVariant, recursive=False)]
+
+    @cache_if_frozen
+    def sorted_variants(self) -> List[OneofVariant]:
+        """Sorted version of variants(), by tag."""
+        return sorted(self.variants(), key=lambda v: v.tag)
+
+    @cache_if_frozen
+    def tag_nbits(self) -> int:
+        """Returns the number of bits the tag occupies."""
+        return max(v.tag for v in self.variants()).bit_length()
+
+    @cache_if_frozen
+    def nbits(self) -> int:
+        """Returns the number of bits of the tag and the largest variant."""
+        return self.tag_nbits() + max(v.type.nbits() for v in self.variants())
+
+    def nbytes(self) -> int:
+        return (self.nbits() + 7) // 8
+
+    def variant_nbytes(self, v: OneofVariant) -> int:
+        """Returns the number of bytes of the tag and given variant."""
+        return (self.tag_nbits() + v.type.nbits() + 7) // 8
+
+    @override(Node)
+    def validate_post_freeze(self) -> None:
+        if not self.variants():
+            raise EmptyOneofUnsupported.from_token(token=self)
+        if self.nbits() > 65535:
+            message = "Oneof size overflows constraint, should <= 65535 bits"
+            raise MessageSizeOverflows.from_token(token=self, message=message)
+
+    @override(Scope)
+    def validate_member_on_push(
+        self, member: Definition, name: Optional[str] = None
+    ) -> None:
+        super(Oneof, self).validate_member_on_push(member, name)
+
+        if isinstance(member, OneofVariant):
+            if any(v.tag == member.tag for v in self.variants()):
+                raise DuplicatedOneofVariantTag.from_token(token=member)
+
+
 @final
 @frozen(post_init=False)
 @dataclass
@@ -1048,3 +1344,29 @@ class Proto(ScopeWithOptions):
 
     def __repr__(self) -> str:
         return f"<bitproto {self.name}>"
+
+    @cache_if_frozen
+    def reachable_paths(
+        self, message_names: Tuple[str, ...]
+    ) -> FrozenSet[Tuple[str, ...]]:
+        """Returns the paths of the messages of given names, in this proto and the
+        protos it imports recursively, and of the messages, aliases and enums they
+        reference directly or indirectly. Others are unreachable from the messages.
+        """
+        paths: Set[Tuple[str, ...]] = set()
+
+        def visit(t: Type) -> None:
+            if isinstance(t, Array):
+                visit(t.element_type)
+            elif isinstance(t, (Alias, Enum, Message)) and t.path not in paths:
+                paths.add(t.path)
+                if isinstance(t, Alias):
+                    visit(t.type)
+                elif isinstance(t, Message):
+                    for field in t.fields():
+                        visit(field.type)
+
+        for _, message in self.messages(recursive=True):
+            if message.name in message_names:
+                visit(message)
+        return frozenset(paths)
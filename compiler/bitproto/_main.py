@@ -6,14 +6,20 @@ Entry inteface.
 """
 
 import argparse
-from typing import List, Optional
+import os
+from concurrent.futures import ProcessPoolExecutor
+from functools import partial
+from typing import Any, List, Optional, Tuple
 
 from bitproto import __description__, __version__
+from bitproto._ast import Proto
 from bitproto.errors import NoLanguageArgument, ParserError, RendererError
+from bitproto.layout import report as layout_report
 from bitproto.linter import lint
 from bitproto.parser import parse
 from bitproto.renderer import render, renderer_registry
-from bitproto.utils import fatal
+from bitproto.schema import dump as schema_dump
+from bitproto.utils import fatal, write_binary_file_if_changed, write_stderr
 
 EPILOG = """
 example usage:
@@ -21,12 +27,22 @@ example usage:
   bitproto c example.bitproto                   build c language file
   bitproto go example.bitproto                  build go language file
   bitproto py example.bitproto                  build python language file
+  bitproto cpp example.bitproto                 build c++ header file, on top of the c header
   bitproto -c example.bitproto                  validate bitproto file syntax
+  bitproto -L example.bitproto                  print layout report of messages
+  bitproto -S example.bitproto out              write binary schema example.bpschema to out
   bitproto c example.bitproto out               build c language file to directory out
+  bitproto c a.bitproto b.bitproto out -j 4     build many files with 4 worker processes
+  bitproto c a.proto -o out                     option -o to give output directory explicitly
   bitproto c example.bitproto -q                option -q to disable builtin linter
-  bitproto c example.bitproto -O                enable performance optimization in traditional mode
+  bitproto c example.bitproto -M                also write dependency file example_bp.d
+  bitproto c example.bitproto -A                also write example_bp_amalgamation.c, which
+                                                contains the imported protos and the c lib
+  bitproto c example.bitproto -O                enable performance optimization mode
   bitproto c example.bitproto -O -F Foo,Bar     only generate encoder and decoder functions for
                                                 message Foo and Bar in optimization mode.
+  bitproto c example.bitproto -F Foo,Bar        only generate functions for message Foo, Bar
+                                                and the types they reference.
 """
 
 VERSION = f"%(prog)s v{__version__}"
@@ -43,16 +59,33 @@ def build_arg_parser() -> argparse.ArgumentParser:
         "language",
         metavar="lang",
         type=str,
-        choices=supported_languages,
         nargs="?",
         help="language to generate, one of: {0}".format(", ".join(supported_languages)),
     )
     args_parser.add_argument(
-        "filepath", metavar="file", type=str, help="path of bitproto file to compile"
+        "filepaths",
+        metavar="file",
+        type=str,
+        nargs="+",
+        help="path of bitproto file to compile, multiple files are allowed",
     )
     args_parser.add_argument(
         "-c", "--check", dest="check", action="store_true", help="check proto syntax"
     )
+    args_parser.add_argument(
+        "-L",
+        "--layout",
+        dest="layout",
+        action="store_true",
+        help="print layout report of messages",
+    )
+    args_parser.add_argument(
+        "-S",
+        "--schema",
+        dest="schema",
+        action="store_true",
+        help="write binary schema of messages for the dynamic codecs",
+    )
     args_parser.add_argument(
         "-q",
         "--disable-lint",
@@ -67,12 +100,20 @@ def build_arg_parser() -> argparse.ArgumentParser:
         nargs="?",
         help="output directory for code generating",
     )
+    args_parser.add_argument(
+        "-o",
+        "--outdir",
+        dest="outdir_option",
+        metavar="out",
+        type=str,
+        help="output directory, then all positional arguments are files to compile",
+    )
     args_parser.add_argument(
         "-O",
         "--optimize",
         dest="enable_optimize",
         action="store_true",
-        help="enable performance optimization mode, this works only if bitproto is traditional.",
+        help="enable performance optimization mode.",
     )
     args_parser.add_argument(
         "-F",
@@ -81,9 +122,45 @@ def build_arg_parser() -> argparse.ArgumentParser:
         type=str,
         help=(
             "message list seperated by comma to render encoder and decoder functions, "
-            "this works only if optimization mode enabled."
+            "in non-optimization mode only for language c, where the definitions "
+            "unreachable from them are not rendered."
+        ),
+    )
+    args_parser.add_argument(
+        "-M",
+        "--depfile",
+        dest="depfile",
+        action="store_true",
+        help="write a dependency file in makefile syntax next to generated files",
+    )
+    args_parser.add_argument(
+        "-A",
+        "--amalgamate",
+        dest="amalgamate",
+        action="store_true",
+        help=(
+            "also write a single c file of the proto, the protos it imports and the "
+            "bitproto c library, for whole-program optimization, only for language c."
         ),
     )
+    args_parser.add_argument(
+        "-B",
+        "--bpf",
+        dest="bpf",
+        action="store_true",
+        help=(
+            "write a single header for eBPF programs instead, with inlined decoders "
+            "bounded by data_end, in optimization mode, only for language c."
+        ),
+    )
+    args_parser.add_argument(
+        "-j",
+        "--jobs",
+        dest="jobs",
+        type=int,
+        default=0,
+        help="number of worker processes to compile multiple files, defaults to cpu count",
+    )
     args_parser.add_argument(
         "-v",
         "--version",
@@ -107,34 +184,86 @@ def run_bitproto() -> None:
             map(lambda s: s.strip(), args.filter_messages.split(","))
         )
 
-    main(
-        args.filepath,
+    filepaths: List[str] = args.filepaths
+    if args.language is not None and args.language not in renderer_registry:
+        # Language is optional for -c, -L and -S, where the first argument is a file.
+        if not (args.check or args.layout or args.schema):
+            args_parser.error(f"argument lang: invalid choice: {args.language!r}")
+        filepaths = [args.language] + filepaths
+        args.language = None
+
+    try:
+        filepaths, outdir = split_outdir(filepaths, args.outdir_option)
+    except ValueError as error:
+        args_parser.error(str(error))
+
+    main_batch(
+        filepaths,
+        jobs=args.jobs,
         lang=args.language,
-        outdir=args.outdir,
+        outdir=outdir,
         disable_linter=args.disable_linter,
         check=args.check,
+        layout=args.layout,
+        schema=args.schema,
         enable_optimize=args.enable_optimize,
         filter_messages=filter_messages,
+        depfile=args.depfile,
+        amalgamate=args.amalgamate,
+        bpf=args.bpf,
     )
 
 
-def main(
+def split_outdir(
+    paths: List[str], outdir: Optional[str]
+) -> Tuple[List[str], Optional[str]]:
+    """Splits the output directory from positional arguments, which is the last one
+    not ending with ".bitproto", e.g. `bitproto c a.bitproto b.bitproto out`, unless
+    given by option -o. Raises ValueError if it's an existing file, or if any other
+    of multiple arguments doesn't end with ".bitproto", rather than guessing which
+    one is the output directory."""
+    if outdir is not None or len(paths) <= 1:
+        return paths, outdir
+    if not paths[-1].endswith(".bitproto"):
+        if os.path.isfile(paths[-1]):
+            raise ValueError(
+                f"{paths[-1]!r} is a file, not an output directory, "
+                "give the output directory by option -o"
+            )
+        paths, outdir = paths[:-1], paths[-1]
+    for path in paths:
+        if not path.endswith(".bitproto"):
+            raise ValueError(
+                f"{path!r} doesn't end with '.bitproto', "
+                "give the output directory by option -o"
+            )
+    return paths, outdir
+
+
+def compile_file(
     filepath: str,
     lang: str = "",
     outdir: str = "",
     disable_linter: bool = False,
     check: bool = False,
+    layout: bool = False,
+    schema: bool = False,
     enable_optimize: bool = False,
     filter_messages: Optional[List[str]] = None,
-) -> None:
+    depfile: bool = False,
+    amalgamate: bool = False,
+    bpf: bool = False,
+) -> Optional[str]:
+    """Compiles given bitproto file.
+    Returns None on success, or the error message on failure, which maybe empty.
+    """
     # Parse
     try:
-        traditional_mode = enable_optimize and not check
-        proto = parse(filepath, traditional_mode=traditional_mode)
+        proto = parse(filepath)
     except ParserError as error:
-        fatal(error.colored())
+        return error.colored()
     except IOError as error:
-        fatal(str(error))
+        return str(error)
 
     # Lint
     lint_warnings = 0
@@ -143,16 +272,43 @@ def main(
 
     if check:
         if lint_warnings > 0:
-            fatal()
-        return
+            return ""
+        return None
+
+    # Layout report
+    if layout:
+        print(layout_report(proto))
+        return None
+
+    # Binary schema
+    if schema:
+        try:
+            write_schema(proto, outdir)
+        except RendererError as error:
+            return error.colored()
+        except IOError as error:
+            return str(error)
+        return None
 
     # Render
     if not lang:
-        fatal(str(NoLanguageArgument()))
+        return str(NoLanguageArgument())
 
     if not enable_optimize:
-        if filter_messages:
-            fatal("-F not available in non-optimization mode.")
+        if filter_messages and lang != "c":
+            return "-F only available for language c in non-optimization mode."
+
+    if amalgamate:
+        if lang != "c":
+            return "-A only available for language c."
+        if enable_optimize:
+            return "-A not available in optimization mode."
+
+    if bpf:
+        if lang != "c":
+            return "-B only available for language c."
+        if amalgamate:
+            return "-B not available with -A."
 
     try:
         render(
@@ -161,11 +317,87 @@ def main(
             outdir=outdir,
             optimization_mode=enable_optimize,
             optimization_mode_filter_messages=filter_messages,
+            depfile=depfile,
+            amalgamate=amalgamate,
+            bpf=bpf,
         )
     except RendererError as error:
-        fatal(error.colored())
+        return error.colored()
     except IOError as error:
-        fatal(str(error))
+        return str(error)
+    return None
+
+
+def write_schema(proto: Proto, outdir: str = "") -> str:
+    """Writes the binary schema of given proto to outdir, defaults to the directory
+    of the proto file. Returns the filepath written."""
+    base = os.path.splitext(os.path.basename(proto.filepath))[0] or proto.name
+    outdir = outdir or os.path.dirname(os.path.abspath(proto.filepath))
+    filepath = os.path.join(outdir, base + ".bpschema")
+    write_binary_file_if_changed(filepath, schema_dump(proto))
+    return filepath
+
+
+def main(
+    filepath: str,
+    lang: str = "",
+    outdir: str = "",
+    disable_linter: bool = False,
+    check: bool = False,
+    layout: bool = False,
+    schema: bool = False,
+    enable_optimize: bool = False,
+    filter_messages: Optional[List[str]] = None,
+    depfile: bool = False,
+    amalgamate: bool = False,
+    bpf: bool = False,
+) -> None:
+    """Compiles given bitproto file, exits the program on failure."""
+    error = compile_file(
+        filepath,
+        lang=lang,
+        outdir=outdir,
+        disable_linter=disable_linter,
+        check=check,
+        layout=layout,
+        schema=schema,
+        enable_optimize=enable_optimize,
+        filter_messages=filter_messages,
+        depfile=depfile,
+        amalgamate=amalgamate,
+        bpf=bpf,
+    )
+    if error is not None:
+        fatal(error)
+
+
+def main_batch(filepaths: List[str], jobs: int = 0, **kwargs: Any) -> None:
+    """Compiles given bitproto files in parallel worker processes, each unique file
+    is compiled once. Exits the program if any fails.
+    """
+    unique_filepaths: List[str] = []
+    realpaths = set()
+    for filepath in filepaths:
+        realpath = os.path.realpath(filepath)
+        if realpath not in realpaths:
+            realpaths.add(realpath)
+            unique_filepaths.append(filepath)
+
+    if len(unique_filepaths) == 1 or jobs == 1:
+        for filepath in unique_filepaths:
+            main(filepath, **kwargs)
+        return
+
+    jobs = min(jobs or os.cpu_count() or 1, len(unique_filepaths))
+    with ProcessPoolExecutor(max_workers=jobs) as executor:
+        errors = list(executor.map(partial(compile_file, **kwargs), unique_filepaths))
+
+    failed = [error for error in errors if error is not None]
+    for error in failed:
+        if error:
+            write_stderr(error)
+    if failed:
+        fatal()
 
 
 if __name__ == "__main__":
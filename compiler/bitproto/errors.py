@@ -151,6 +151,11 @@ class InvalidIntCap(LexerError):
     """Invalid bits capacity for a int type, should between [1, 64]."""
 
 
+@dataclass
+class InvalidFixedCap(LexerError):
+    """Invalid bits capacity for a fixed-point type, should between [1, 64], with fractional bits no more than it."""
+
+
 @dataclass
 class UnsupportedArrayType(LexerError):
     """Unsupported type to construct an array type."""
@@ -171,6 +176,11 @@ class InvalidArrayCap(GrammarError):
     """Invalid array capacity, should between (0, 65536)."""
 
 
+@dataclass
+class InvalidBoundedArray(GrammarError):
+    """Invalid bounded array, should be the type of a message field, not inside an extensible type."""
+
+
 @dataclass
 class DuplicatedDefinition(GrammarError):
     """Duplicated definition."""
@@ -236,11 +246,46 @@ class DuplicatedMessageFieldNumber(GrammarError):
     """Duplicated message field number."""
 
 
+@dataclass
+class InvalidOneofVariantTag(GrammarError):
+    """Invalid oneof variant tag, should between [1, 255]."""
+
+
+@dataclass
+class InvalidOneofVariantType(GrammarError):
+    """Invalid oneof variant type, should be a message in fixed size."""
+
+
+@dataclass
+class DuplicatedOneofVariantTag(GrammarError):
+    """Duplicated oneof variant tag."""
+
+
+@dataclass
+class EmptyOneofUnsupported(GrammarError):
+    """Unsupported to declare oneof without variants."""
+
+
 @dataclass
 class UnsupportedLanguageToRender(RendererError):
     """Unsupported language to render."""
 
 
+@dataclass
+class RangeInSchemaUnsupported(RendererError):
+    """Message fields of option range are not supported by binary schemas."""
+
+
+@dataclass
+class FloatInSchemaUnsupported(RendererError):
+    """Float32 and fixed-point types are not supported by binary schemas."""
+
+
+@dataclass
+class BoundedArrayInSchemaUnsupported(RendererError):
+    """Bounded arrays are not supported by binary schemas."""
+
+
 @dataclass
 class UnsupportedOption(GrammarError):
     """Unsupported option."""
@@ -251,9 +296,14 @@ class InvalidOptionValue(GrammarError):
     """Invalid option value."""
 
 
+@dataclass
+class InvalidFieldRange(GrammarError):
+    """Invalid range of message field, should be lo..hi with lo <= hi, in the range of the declared integer type."""
+
+
 @dataclass
 class MessageSizeOverflows(GrammarError):
-    """Message size overflows constraint, should < 65535 bits (about 8kb)."""
+    """Message size overflows constraint, should <= 65535 bits (about 8kb), unless option large is set."""
 
 
 @dataclass
@@ -342,6 +392,39 @@ class LanguageNotSupportOptimizationMode(RendererError):
         return message
 
 
+@dataclass
+class BoundedArrayInOptimizationModeUnsupported(RendererError):
+    """Bounded arrays are not supported in optimization mode."""
+
+    message_name: str = ""
+
+    @override(Base)
+    def format_default_description(self) -> str:
+        message = self.__doc__ or ""
+        if self.message_name:
+            message = f"{message} Found in message {self.message_name}."
+        return message
+
+
+@dataclass
+class BoundedStackUnsupported(RendererError):
+    """Option c.bounded_stack requires messages in fixed size, encoded by copy plans or direct_codec."""
+
+    message_name: str = ""
+
+    @override(Base)
+    def format_default_description(self) -> str:
+        message = self.__doc__ or ""
+        if self.message_name:
+            message = f"{message} Found in message {self.message_name}."
+        return message
+
+
+@dataclass
+class SelfTestVectorsUnavailable(RendererError):
+    """Option self_test requires the bitproto Python library bitprotolib, to compute the test vectors."""
+
+
 @dataclass
 class LintWarning(_TokenBound, Warning):
     """Some warning occurred during bitproto linting."""
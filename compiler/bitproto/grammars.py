@@ -41,6 +41,7 @@ global_scope_definition_unit : import
                              | const
                              | enum
                              | message
+                             | oneof
                              | proto
                              | comment
                              | newline
@@ -127,6 +128,7 @@ constant_reference : dotted_identifier
 r_type = """
 type : single_type
      | array_type
+     | bounded_array_type
 """
 
 r_single_type = """
@@ -139,6 +141,8 @@ base_type : BOOL_TYPE
           | UINT_TYPE
           | INT_TYPE
           | BYTE_TYPE
+          | FLOAT_TYPE
+          | FIXED_TYPE
 """
 
 r_type_reference = """
@@ -154,6 +158,10 @@ r_array_type = """
 array_type : single_type '[' array_capacity ']' optional_extensible_flag
 """
 
+r_bounded_array_type = """
+bounded_array_type : single_type '[' LE array_capacity ']'
+"""
+
 r_array_capacity = """
 array_capacity : INT_LITERAL
                | constant_reference_for_array_capacity
@@ -246,6 +254,57 @@ message_item_unsupported : alias
 
 r_message_field = """
 message_field : type message_field_name '=' INT_LITERAL optional_semicolon
+              | type message_field_name '=' INT_LITERAL '[' message_field_options ']' optional_semicolon
+"""
+
+r_message_field_options = """
+message_field_options : message_field_option ',' message_field_options
+                      | message_field_option
+"""
+
+r_message_field_option = """
+message_field_option : IDENTIFIER '=' range_literal
+"""
+
+r_range_literal = """
+range_literal : signed_integer_literal '.' '.' signed_integer_literal
+"""
+
+r_signed_integer_literal = """
+signed_integer_literal : integer_literal
+                       | MINUS integer_literal
+"""
+
+r_oneof = """
+oneof : open_oneof_scope oneof_scope close_oneof_scope
+"""
+
+r_open_oneof_scope = """
+open_oneof_scope : ONEOF IDENTIFIER '{'
+"""
+
+r_close_oneof_scope = """
+close_oneof_scope : '}'
+"""
+
+r_oneof_scope = """
+oneof_scope : oneof_items
+"""
+
+r_oneof_items = """
+oneof_items : oneof_item oneof_items
+            | oneof_item
+            |
+"""
+
+r_oneof_item = """
+oneof_item : oneof_variant
+           | comment
+           | newline
+"""
+
+r_oneof_variant = """
+oneof_variant : type message_field_name '=' INT_LITERAL optional_semicolon
 """
 
 # https://github.com/hit9/bitproto/issues/39
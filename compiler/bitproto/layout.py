@@ -0,0 +1,503 @@
+"""
+bitproto.layout
+~~~~~~~~~~~~~~~
+
+Compile-time layout report of messages, e.g. bit offsets, byte spans and
+struct sizes in C, to help tuning the order of message fields.
+"""
+
+from dataclasses import dataclass
+from typing import Dict, List, Optional, Tuple
+
+from bitproto._ast import (
+    Alias,
+    Array,
+    Bool,
+    BoundScope,
+    Byte,
+    Enum,
+    Fixed,
+    Float,
+    Int,
+    Integer,
+    Message,
+    MessageField,
+    Proto,
+    Range,
+    SingleType,
+    Type,
+)
+from bitproto.errors import InternalError
+
+
+def format_type_name(t: Type) -> str:
+    """Formats given type as it is written in bitproto."""
+    if isinstance(t, Bool):
+        return "bool"
+    if isinstance(t, Byte):
+        return "byte"
+    if isinstance(t, Range):
+        return f"{format_type_name(t.type)}({t.lo}..{t.hi})"
+    if isinstance(t, Float):
+        return "float32"
+    if isinstance(t, Fixed):
+        return f"{'' if t.signed else 'u'}fixed{t.cap}.{t.frac}"
+    if isinstance(t, Int):
+        return f"int{t.nbits()}"
+    if isinstance(t, Integer):
+        return f"uint{t.nbits()}"
+    if isinstance(t, (Alias, Enum, Message)):
+        return t.name
+    if isinstance(t, Array):
+        extensible = "'" if t.extensible else ""
+        bounded = "<=" if t.bounded else ""
+        return f"{format_type_name(t.element_type)}[{bounded}{t.cap}]{extensible}"
+    raise InternalError("format_type_name got unexpected type")
+
+
+def format_signature(t: Type) -> str:
+    """Formats the layout of given type on the wire, from the types, widths, order
+    and extensibility of the fields inside, recursively. Names and field numbers are
+    left out, aliases are resolved, e.g. {uint3;int16[3]'}' for an extensible
+    message of two fields. Fields of option range are written as range1000..21000.
+    """
+    t = resolve_alias(t)
+    if isinstance(t, Bool):
+        return "bool"
+    if isinstance(t, Byte):
+        return "byte"
+    if isinstance(t, Enum):
+        return f"enum{t.nbits()}"
+    if isinstance(t, Range):
+        return f"range{t.lo}..{t.hi}"
+    if isinstance(t, (Integer, Float, Fixed)):
+        return format_type_name(t)
+    extensible = "'" if isinstance(t, (Array, Message)) and t.extensible else ""
+    if isinstance(t, Array):
+        bounded = "<=" if t.bounded else ""
+        return f"{format_signature(t.element_type)}[{bounded}{t.cap}]{extensible}"
+    if isinstance(t, Message):
+        fields = ";".join(format_signature(f.type) for f in t.sorted_fields())
+        return f"{{{fields}}}{extensible}"
+    raise InternalError("format_signature got unexpected type")
+
+
+def fingerprint(m: Message) -> int:
+    """Returns the 64 bits fingerprint of the layout of given message, the FNV-1a hash
+    of its signature. Messages of the same fingerprint are encoded the same way, a
+    receiver could pick the decoder by comparing it, instead of trial decoding."""
+    h = 0xCBF29CE484222325
+    for b in format_signature(m).encode():
+        h = ((h ^ b) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def format_qualified_name(m: Message) -> str:
+    """Formats the name of given message joined with its parent messages', e.g. A.B"""
+    names = [s.name for s in m.scope_stack if isinstance(s, BoundScope)]
+    return ".".join(names + [m.name])
+
+
+def is_nbits_standard(nbits: int) -> bool:
+    return nbits in (8, 16, 32, 64)
+
+
+def resolve_alias(t: Type) -> Type:
+    while isinstance(t, Alias):
+        t = t.type
+    return t
+
+
+# Bitset types of message fields by id, kept with the fields, see c_field_type.
+_c_bitset_types: Dict[int, Tuple[MessageField, Array]] = {}
+
+
+def c_field_type(field: MessageField) -> Type:
+    """Returns the type of given message field in C. With option c.bool_bitset, a
+    field declared as a non-extensible array of a multiple of 8 bools is a bitset in
+    C, an array of bytes where bit k of byte j is element 8 * j + k. That's exactly
+    the bits on the wire, so the field is encoded and decoded as the array of bytes.
+    """
+    t = field.type
+    if not (isinstance(t, Array) and isinstance(t.element_type, Bool)):
+        return t
+    if t.extensible or t.bounded or t.cap % 8 != 0:
+        return t
+    if not field.bound.get_option_as_bool_or_raise("c.bool_bitset"):
+        return t
+    cached = _c_bitset_types.get(id(field))
+    if cached is None or cached[0] is not field:
+        bitset = Array(
+            element_type=Byte(),
+            cap=t.cap // 8,
+            token=t.token,
+            lineno=t.lineno,
+            filepath=t.filepath,
+        )
+        cached = _c_bitset_types[id(field)] = (field, bitset)
+    return cached[1]
+
+
+def is_validated_enum(t: Type) -> bool:
+    """Returns True if given type is an enum checked on decoding in C, that is, option
+    c.validate_enums is set in the proto declaring it, and not every value of its bits
+    is declared. Such enums are not copied by memcpy, nor by copy plans.
+    """
+    if not isinstance(t, Enum):
+        return False
+    if not t.bound.get_option_as_bool_or_raise("c.validate_enums"):
+        return False
+    return len({field.value for field in t.fields()}) < (1 << t.nbits())
+
+
+def has_validated_enums(t: Type) -> bool:
+    """Returns True if given type is_validated_enum, or contains one inside."""
+    t = resolve_alias(t)
+    if isinstance(t, Array):
+        return has_validated_enums(t.element_type)
+    if isinstance(t, Message):
+        return any(has_validated_enums(field.type) for field in t.fields())
+    return is_validated_enum(t)
+
+
+def has_ranges(t: Type) -> bool:
+    """Returns True if given type is a message with fields of option range inside,
+    recursively. Such messages are not copied by memcpy, nor by copy plans, since the
+    values are offset on the wire.
+    """
+    t = resolve_alias(t)
+    if isinstance(t, Array):
+        return has_ranges(t.element_type)
+    if isinstance(t, Message):
+        return any(
+            isinstance(field.type, Range) or has_ranges(field.type)
+            for field in t.fields()
+        )
+    return False
+
+
+def has_fixed(t: Type) -> bool:
+    """Returns True if given type is a fixed-point type, or an array or a message with
+    them inside, recursively. Like ranges, they are not copied by copy plans, since
+    the values are scaled on the wire.
+    """
+    return _has_types(t, (Fixed,))
+
+
+def has_reals(t: Type) -> bool:
+    """Returns True if given type is a float32 or fixed-point type, or an array or a
+    message with them inside, recursively."""
+    return _has_types(t, (Float, Fixed))
+
+
+def _has_types(t: Type, classes: Tuple[type, ...]) -> bool:
+    t = resolve_alias(t)
+    if isinstance(t, classes):
+        return True
+    if isinstance(t, Array):
+        return _has_types(t.element_type, classes)
+    if isinstance(t, Message):
+        return any(_has_types(field.type, classes) for field in t.fields())
+    return False
+
+
+def c_sizeof_integer(nbits: int) -> int:
+    """Returns the size of the integer type in C to hold given number of bits."""
+    for size in (1, 2, 4, 8):
+        if nbits <= size * 8:
+            return size
+    raise InternalError("c_sizeof_integer got nbits out of range")
+
+
+def c_sizeof(t: Type) -> Tuple[int, int]:
+    """Returns the size and alignment of given type in C."""
+    t = resolve_alias(t)
+    if isinstance(t, (Bool, Byte)):
+        return 1, 1
+    if isinstance(t, Range):
+        return c_sizeof(t.type)
+    if isinstance(t, Float):
+        return 4, 4
+    if isinstance(t, Fixed):
+        size = 8 if t.is_double() else 4
+        return size, size
+    if isinstance(t, (Integer, Enum)):
+        size = c_sizeof_integer(t.nbits())
+        return size, size
+    if isinstance(t, Array) and t.bounded:
+        # struct { uint16_t len; T data[cap]; }
+        size, alignment = c_sizeof(t.element_type)
+        alignment = max(alignment, 2)
+        offset = 2 + (-2) % alignment
+        end = offset + size * t.cap
+        return end + (-end) % alignment, alignment
+    if isinstance(t, Array):
+        size, alignment = c_sizeof(t.element_type)
+        return size * t.cap, alignment
+    if isinstance(t, Message):
+        size, alignment, _ = c_struct_layout(t)
+        return size, alignment
+    raise InternalError("c_sizeof got unexpected type")
+
+
+def c_struct_members(m: Message) -> Tuple[Dict[int, int], int, int, int]:
+    """Returns the offsets of the members (by field number), the size, alignment and
+    the number of padding bytes of the struct generated for given message in C,
+    respecting option c.struct_packing_alignment.
+    """
+    packing = m.bound.get_option_as_int_or_raise("c.struct_packing_alignment")
+    offsets: Dict[int, int] = {}
+    offset, alignment, padding = 0, 1, 0
+    for field in m.fields():  # C struct members are in the declaration order.
+        size, field_alignment = c_sizeof(c_field_type(field))
+        if packing > 0:
+            field_alignment = 1
+        alignment = max(alignment, field_alignment)
+        gap = (-offset) % field_alignment
+        padding += gap
+        offsets[field.number] = offset + gap
+        offset += gap + size
+    if packing > 0:
+        alignment = max(alignment, packing)
+    gap = (-offset) % alignment
+    return offsets, offset + gap, alignment, padding + gap
+
+
+def c_struct_layout(m: Message) -> Tuple[int, int, int]:
+    """Returns the size, alignment and the number of padding bytes of the struct
+    generated for given message in C, respecting option c.struct_packing_alignment.
+    """
+    _, size, alignment, padding = c_struct_members(m)
+    return size, alignment, padding
+
+
+def is_memcpy_type(t: Type) -> bool:
+    """Returns True if the encoding of given type is exactly its memory in C, so that
+    it could be encoded and decoded by a memcpy. That is, it consists of integers,
+    bytes, enums and float32s in standard widths only, laid out in the same order
+    without padding. On big-endian hosts, it's the memory only if is_byte_order_free.
+    """
+    t = resolve_alias(t)
+    if is_validated_enum(t) or isinstance(t, Range):
+        return False
+    if isinstance(t, (Byte, Integer, Enum, Float)):
+        return is_nbits_standard(t.nbits())
+    if isinstance(t, Array):
+        if t.extensible or t.bounded:
+            return False
+        return is_memcpy_type(t.element_type)
+    if isinstance(t, Message):
+        if t.extensible or not t.is_fixed_size():
+            return False
+        offsets, size, _, _ = c_struct_members(t)
+        runs = [run for run in field_runs(t) if run]
+        if len(runs) != 1 or len(runs[0]) != len(t.fields()):
+            return False
+        return offsets[runs[0][0].number] == 0 and size == t.nbytes()
+    return False
+
+
+def is_byte_order_free(t: Type) -> bool:
+    """Returns True if the memory of given type in C is the same on little-endian and
+    big-endian hosts, that is, every integer and enum in it occupies a single byte.
+    Copies of the memory of other types are swapped on big-endian hosts.
+    """
+    t = resolve_alias(t)
+    if isinstance(t, (Bool, Byte)):
+        return True
+    if isinstance(t, Range):
+        return is_byte_order_free(t.type)
+    if isinstance(t, (Integer, Enum)):
+        return c_sizeof_integer(t.nbits()) == 1
+    if isinstance(t, Array):
+        return is_byte_order_free(t.element_type)
+    if isinstance(t, Message):
+        return all(is_byte_order_free(field.type) for field in t.fields())
+    return False
+
+
+def field_runs(m: Message) -> List[List[MessageField]]:
+    """Splits the fields of given message into runs, of which the encoding is exactly
+    the memory of the struct members in C. A field in a run is byte-aligned and an
+    is_memcpy_type, and starts where the previous one ends, both in the buffer and in
+    the struct. Fields not in any run are separated by empty runs.
+    """
+    offsets, _, _, _ = c_struct_members(m)
+    runs: List[List[MessageField]] = [[]]
+    i = m.ahead_nbits() if m.extensible else 0
+    end = 0  # Where the last field of current run ends in the struct.
+    for field in m.sorted_fields():
+        t = c_field_type(field)
+        if i % 8 == 0 and is_memcpy_type(t):
+            if runs[-1] and offsets[field.number] != end:
+                runs.append([])
+            runs[-1].append(field)
+            end = offsets[field.number] + c_sizeof(t)[0]
+        elif runs[-1]:
+            runs.append([])
+        i += t.nbits()
+    return runs
+
+
+def memcpy_runs(m: Message) -> List[List[MessageField]]:
+    """Returns the runs of fields of given message to encode and decode by a single
+    memcpy each, see field_runs. Runs of a single integer, byte or enum are left out,
+    which are plain loads and stores already.
+    """
+    return [
+        run
+        for run in field_runs(m)
+        if len(run) > 1
+        or (run and not isinstance(resolve_alias(run[0].type), SingleType))
+    ]
+
+
+def fast_paths(field: MessageField, offset: int) -> List[str]:
+    """Returns the fast paths of C library that apply to given field."""
+    t = c_field_type(field)
+    nbits = t.nbits()
+    paths: List[str] = []
+    if offset % 8 == 0 and nbits % 8 == 0:
+        paths.append("byte-aligned")
+    array = resolve_alias(t)
+    if isinstance(array, Array) and not array.extensible:
+        element = resolve_alias(array.element_type)
+        is_integer = isinstance(element, (Byte, Integer, Enum, Float))
+        if is_integer and is_nbits_standard(element.nbits()):
+            paths.append("bulk-array")
+    return paths
+
+
+@dataclass
+class FieldLayout:
+    field: MessageField
+    offset: int  # Bit offset in the message.
+
+    @property
+    def nbits(self) -> int:
+        return self.field.type.nbits()
+
+    @property
+    def byte_span(self) -> Tuple[int, int]:
+        """Index of the first and the last byte this field occupies."""
+        return self.offset // 8, (self.offset + max(self.nbits, 1) - 1) // 8
+
+    @property
+    def is_unaligned(self) -> bool:
+        """An unaligned field doesn't start at a byte boundary, or spans more bytes
+        than its size, costs extra shifts to encode and decode."""
+        first, last = self.byte_span
+        return self.offset % 8 != 0 or (last - first + 1) > (self.nbits + 7) // 8
+
+
+def layout_fields(m: Message, fields: List[MessageField]) -> List[FieldLayout]:
+    """Computes bit offsets of given fields, laid out one after another."""
+    offset = m.ahead_nbits() if m.extensible else 0
+    layouts = []
+    for field in fields:
+        layouts.append(FieldLayout(field, offset))
+        offset += field.type.nbits()
+    return layouts
+
+
+def flat_field_layouts(
+    m: Message, offset: int = 0, prefix: str = ""
+) -> List[Tuple[str, int, int]]:
+    """Returns (path, offset, nbits) of all fields in given message, recursively.
+    The path joins the field names by dots, e.g. "pose.yaw". A field of message
+    is followed by its own fields, an array is a single entry as a whole."""
+    entries = []
+    for layout in layout_fields(m, m.sorted_fields()):
+        path = prefix + layout.field.name
+        start = offset + layout.offset
+        entries.append((path, start, layout.nbits))
+        t = resolve_alias(layout.field.type)
+        if isinstance(t, Message):
+            entries.extend(flat_field_layouts(t, start, path + "."))
+    return entries
+
+
+def count_unaligned(layouts: List[FieldLayout]) -> int:
+    return sum(1 for layout in layouts if layout.is_unaligned)
+
+
+def suggest_order(m: Message) -> Optional[List[MessageField]]:
+    """Suggests an order of fields reducing unaligned fields: fields in whole bytes
+    come first, and then the others, larger ones first.
+    Returns None if not better than the current order."""
+    fields = m.sorted_fields()
+    whole = [f for f in fields if f.type.nbits() % 8 == 0]
+    rest = sorted(
+        [f for f in fields if f.type.nbits() % 8 != 0],
+        key=lambda f: -f.type.nbits(),
+    )
+    order = whole + rest
+    current = count_unaligned(layout_fields(m, fields))
+    suggested = count_unaligned(layout_fields(m, order))
+    if suggested < current:
+        return order
+    return None
+
+
+def report_message(m: Message) -> List[str]:
+    lines: List[str] = []
+
+    size_tag = "fixed size" if m.is_fixed_size() else "not fixed size"
+    extensible = ", extensible" if m.extensible else ""
+    lines.append(
+        f"message {format_qualified_name(m)} ({m.filepath}:{m.lineno}): "
+        f"{m.nbits()} bits, {m.nbytes()} bytes, {size_tag}{extensible}"
+    )
+    lines.append(f"  fingerprint: 0x{fingerprint(m):016x}")
+
+    size, _, padding = c_struct_layout(m)
+    memcpy = ", same as the encoding (memcpy)" if is_memcpy_type(m) else ""
+    lines.append(f"  C struct: sizeof = {size}, padding = {padding}{memcpy}")
+
+    memcpy_fields = {field.number for run in memcpy_runs(m) for field in run}
+    layouts = layout_fields(m, m.sorted_fields())
+    header = ("number", "name", "type", "bits", "offset", "bytes", "notes")
+    rows: List[Tuple[str, ...]] = [header]
+    for layout in layouts:
+        first, last = layout.byte_span
+        notes = fast_paths(layout.field, layout.offset)
+        if layout.field.number in memcpy_fields:
+            notes.append("memcpy")
+        if layout.is_unaligned:
+            notes.append("unaligned")
+        rows.append(
+            (
+                str(layout.field.number),
+                layout.field.name,
+                format_type_name(layout.field.type),
+                str(layout.nbits),
+                str(layout.offset),
+                f"{first}" if first == last else f"{first}-{last}",
+                ",".join(notes),
+            )
+        )
+
+    widths = [max(len(row[k]) for row in rows) for k in range(len(header))]
+    for row in rows:
+        cells = [cell.ljust(widths[k]) for k, cell in enumerate(row)]
+        lines.append(("  " + "  ".join(cells)).rstrip())
+
+    lines.append(f"  unaligned fields: {count_unaligned(layouts)}")
+
+    order = suggest_order(m)
+    if order is not None:
+        n = count_unaligned(layout_fields(m, order))
+        names = ", ".join(field.name for field in order)
+        lines.append(
+            f"  suggestion: renumber fields in order {names} to reduce unaligned "
+            f"fields to {n} (changes the encoding)"
+        )
+    return lines
+
+
+def report(proto: Proto) -> str:
+    """Returns the layout report of messages defined in given proto."""
+    blocks: List[str] = []
+    for _, message in proto.messages(recursive=True, bound=proto):
+        blocks.append("\n".join(report_message(message)))
+    return "\n\n".join(blocks)
@@ -11,7 +11,7 @@ from typing import Dict, Iterator, List, Optional, Tuple
 from ply import lex  # type: ignore
 from ply.lex import LexToken  # type: ignore
 
-from bitproto._ast import Bool, Byte, Comment, Int, Uint
+from bitproto._ast import Bool, Byte, Comment, Fixed, Float, Int, Uint
 from bitproto.errors import InvalidEscapingChar, LexerError
 
 
@@ -29,7 +29,7 @@ class Lexer:
     t_ignore: str = " \t\r"
 
     # Literal symbols
-    literals: str = ":;{}[]()/=\\'."
+    literals: str = ":;{}[]()/=\\'.,"
 
     # Keywords
     keywords: Tuple[str, ...] = (
@@ -40,6 +40,7 @@ class Lexer:
         "const",
         "enum",
         "message",
+        "oneof",
         "typedef",  # Reserved for deprecated warning.
     )
     keywords_tokens = tuple(map(lambda k: k.upper(), keywords))
@@ -54,11 +55,14 @@ class Lexer:
         "MINUS",
         "TIMES",
         "DIVIDE",
+        "LE",
         # Types
         "BOOL_TYPE",
         "UINT_TYPE",
         "INT_TYPE",
         "BYTE_TYPE",
+        "FLOAT_TYPE",
+        "FIXED_TYPE",
         # Literals
         "HEX_LITERAL",
         "INT_LITERAL",
@@ -84,6 +88,9 @@ class Lexer:
     t_TIMES: str = r"\*"
     t_DIVIDE: str = r"/"
 
+    # Capacity of bounded arrays, e.g. uint8[<=256]
+    t_LE: str = r"<="
+
     def __init__(self, filepath_stack: Optional[List[str]] = None) -> None:
         self.lexer = lex.lex(object=self)
         self.filepath_stack: List[str] = filepath_stack or []
@@ -163,6 +170,25 @@ class Lexer:
         t.value = Byte(token=t.value, lineno=t.lineno, filepath=self.current_filepath())
         return t
 
+    def t_FLOAT_TYPE(self, t: LexToken) -> LexToken:
+        r"\bfloat32\b"
+        t.value = Float(token=t.value, lineno=t.lineno, filepath=self.current_filepath())
+        return t
+
+    def t_FIXED_TYPE(self, t: LexToken) -> LexToken:
+        r"\bu?fixed[0-9]+\.[0-9]+\b"
+        signed: bool = not t.value.startswith("u")
+        cap, frac = t.value[5 + (not signed) :].split(".")  # fixed{n}.{f}
+        t.value = Fixed(
+            cap=int(cap),
+            frac=int(frac),
+            signed=signed,
+            token=t.value,
+            lineno=t.lineno,
+            filepath=self.current_filepath(),
+        )
+        return t
+
     def t_HEX_LITERAL(self, t: LexToken) -> LexToken:
         r"0x[0-9a-fA-F]+"
         t.value = int(t.value, 16)
@@ -31,6 +31,24 @@ MESSAGE_OPTIONS: OptionDescriptors = (
         lambda v: v >= 0,
         "Setting the maximum limit of number of bytes for target message.",
     ),
+    OptionDescriptor(
+        "json_bytes",
+        "",
+        lambda v: v in ("", "array", "hex", "base64"),
+        "Json format of byte arrays in target message, overrides the proto's option json_bytes, defaults to empty.",
+    ),
+    OptionDescriptor(
+        "large",
+        False,
+        None,
+        "Whether target message can be larger than 65535 bits, up to 2147483647 bits, requires int of 32 bits in C, defaults to false.",
+    ),
+    OptionDescriptor(
+        "direct_codec",
+        False,
+        None,
+        "Generate the encoder and decoders of target message working directly on struct fields in standard mode of C and Go, the same as optimization mode's, defaults to false.",
+    ),
 )
 
 # Proto Options
@@ -47,16 +65,100 @@ PROTO_OPTTIONS: OptionDescriptors = (
         None,
         "Name prefix of generated C defintions, defaults to empty.",
     ),
+    OptionDescriptor(
+        "c.split_processors",
+        False,
+        None,
+        "Generate separate encode and decode processors in C, defaults to false.",
+    ),
+    OptionDescriptor(
+        "c.copy_plans",
+        False,
+        None,
+        "Generate copy plans for messages in fixed size in C, defaults to false.",
+    ),
+    OptionDescriptor(
+        "c.bounded_stack",
+        False,
+        None,
+        "Encode and decode all messages by copy plans in C, without recursion, in stack usage of a fixed bound BP_STACK_USAGE_BOUND, defaults to false.",
+    ),
+    OptionDescriptor(
+        "c.checksum",
+        "",
+        lambda v: v in ("", "crc8", "crc16", "crc32"),
+        "Checksum appended by the checked encoders in C, one of crc8, crc16 and crc32, defaults to empty.",
+    ),
+    OptionDescriptor(
+        "c.framing",
+        "",
+        lambda v: v in ("", "cobs", "slip"),
+        "Framing of the framed encoders in C, one of cobs and slip, defaults to empty.",
+    ),
+    OptionDescriptor(
+        "c.delta",
+        False,
+        None,
+        "Generate delta encoders and decoders against previous messages in C, defaults to false.",
+    ),
+    OptionDescriptor(
+        "c.bool_bitset",
+        False,
+        None,
+        "Generate bool array fields of a multiple of 8 elements as bitsets of bytes in C, defaults to false.",
+    ),
+    OptionDescriptor(
+        "c.validate_enums",
+        False,
+        None,
+        "Check the enums declared in this proto on decoding in C, the decoders return BP_ERR_ENUM for values not declared, defaults to false.",
+    ),
+    OptionDescriptor(
+        "self_test",
+        0,
+        lambda v: 0 <= v <= 16,
+        "Number of test vectors of each message, pseudo-random structs and their encodings computed by the Python implementation, to generate function BpSelfTestXXX checking the encoders and decoders against in C and Go, at most 16, defaults to 0.",
+    ),
+    OptionDescriptor(
+        "json_bytes",
+        "array",
+        lambda v: v in ("array", "hex", "base64"),
+        "Json format of byte arrays, one of array (of numbers), hex and base64 strings, defaults to array.",
+    ),
     OptionDescriptor(
         "go.package_path",
         "",
         None,
         "Package path of current golang package, to be imported, e.g.  github.com/path/to/example",
     ),
+    OptionDescriptor(
+        "go.direct_codec",
+        False,
+        None,
+        "Generate golang encoders and decoders working directly on struct fields, defaults to false.",
+    ),
+    OptionDescriptor(
+        "go.generics",
+        False,
+        None,
+        "Generate golang encoders and decoders by the generic functions of the bitproto library, requires go 1.18, defaults to false.",
+    ),
+    OptionDescriptor(
+        "go.zero_copy_bytes",
+        False,
+        None,
+        "Generate byte array fields as golang slices aliasing the decoding buffer, defaults to false.",
+    ),
     OptionDescriptor(
         "py.module_name",
         "",
         None,
         "Module name of current python module, to be imported, e.g. example_bp",
     ),
+    OptionDescriptor(
+        "py.slots",
+        False,
+        None,
+        "Generate python message classes with __slots__, and arrays of integers as array.array, defaults to false.",
+    ),
 )
@@ -7,12 +7,13 @@ Grammar parser for bitproto.
 
 import os
 from contextlib import contextmanager
-from typing import Iterator, List, Optional, Tuple, Type as T, cast
+from typing import Any, Dict, Iterator, List, Optional, Tuple, Type as T, cast
 
 from ply import yacc  # type: ignore
 from ply.lex import LexToken  # type: ignore
 from ply.yacc import LRParser as PlyParser, YaccProduction as P  # type: ignore
 
+from bitproto import __version__
 from bitproto._ast import (
     Alias,
     Array,
@@ -24,8 +25,11 @@ from bitproto._ast import (
     IntegerConstant,
     Message,
     MessageField,
+    Oneof,
+    OneofVariant,
     Option,
     Proto,
+    Range,
     Scope,
     Type,
 )
@@ -54,12 +58,73 @@ from bitproto.errors import (
     ReferencedNotType,
     ReferencedTypeNotDefined,
     StatementInMessageUnsupported,
+    UnsupportedOption,
     UnsupportedToDeclareProtoNameOutofProtoScope,
 )
 from bitproto.grammars import *
 from bitproto.lexer import Lexer
 from bitproto.utils import cast_or_raise, override_docstring, write_stderr
 
+# LR tables (action, goto, productions) built once and shared by all parsers in
+# this process, e.g. parsers of imported protos.
+_lr_tables: Optional[Tuple[Dict[int, Any], Dict[int, Any], List[Any]]] = None
+
+
+def parse_table_cache_path() -> str:
+    """Returns the path of the file caching LR tables across compiler invocations,
+    versioned by the bitproto version. The directory defaults to ~/.cache/bitproto,
+    and can be changed by environment variable BITPROTO_CACHE_DIR.
+    """
+    cache_dir = os.environ.get("BITPROTO_CACHE_DIR")
+    if not cache_dir:
+        cache_home = os.environ.get("XDG_CACHE_HOME") or os.path.join(
+            os.path.expanduser("~"), ".cache"
+        )
+        cache_dir = os.path.join(cache_home, "bitproto")
+    return os.path.join(cache_dir, f"parsetab-{__version__}.pickle")
+
+
+def yacc_cached(module: "Parser") -> PlyParser:
+    """Builds a ply parser with LR tables read from the cache file if exist, or
+    generated and then written to the cache file. Ply checks the grammar signature
+    on reading, and regenerates the tables if the grammar changes.
+    Falls back to generating without caching if the cache is not accessible.
+    """
+    path = parse_table_cache_path()
+    try:
+        if os.path.exists(path):
+            return yacc.yacc(module=module, start="start", debug=False, picklefile=path)
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        # Writes to a temporary file then renames, to be safe from concurrent
+        # compiler processes reading a partial file.
+        tmp = f"{path}.{os.getpid()}"
+        parser = yacc.yacc(module=module, start="start", debug=False, picklefile=tmp)
+        os.replace(tmp, path)
+        return parser
+    except Exception:  # Grammar errors raise again in the fallback.
+        return yacc.yacc(module=module, start="start", debug=False, write_tables=False)
+
+
+def build_ply_parser(module: "Parser") -> PlyParser:
+    """Builds a ply parser for given Parser instance, reusing the LR tables in this
+    process, only the grammar functions are bound to the instance."""
+    global _lr_tables
+
+    if _lr_tables is None:
+        parser = yacc_cached(module)
+        _lr_tables = (parser.action, parser.goto, parser.productions)
+        return parser
+
+    action, goto, productions = _lr_tables
+    lr = yacc.LRTable()
+    lr.lr_action, lr.lr_goto = action, goto
+    lr.lr_productions = [
+        yacc.MiniProduction(p.str, p.name, p.len, p.func, p.file, p.line)
+        for p in productions
+    ]
+    lr.bind_callables({p.func: getattr(module, p.func) for p in productions if p.func})
+    return PlyParser(lr, module.p_error)
+
 
 class Parser:
     """Parser for bitproto.
@@ -85,9 +150,7 @@ class Parser:
         traditional_mode: bool = False,
     ) -> None:
         self.lexer: Lexer = Lexer(filepath_stack=filepath_stack)
-        self.parser: PlyParser = yacc.yacc(
-            module=self, start="start", debug=False, write_tables=False
-        )
+        self.parser: PlyParser = build_ply_parser(self)
         self.scope_stack: List[Scope] = scope_stack or []
         self.filepath_stack: List[str] = filepath_stack or []
         self.comment_block: List[Comment] = comment_block or []
@@ -522,6 +585,18 @@ class Parser:
         )
         self.copy_p_tracking(p)
 
+    @override_docstring(r_bounded_array_type)
+    def p_bounded_array_type(self, p: P) -> None:
+        p[0] = Array(
+            element_type=p[1],
+            cap=p[4],
+            bounded=True,
+            token="{0}[<={1}]".format(p[1], p[4]),
+            lineno=p.lineno(2),
+            filepath=self.current_filepath(),
+        )
+        self.copy_p_tracking(p)
+
     @override_docstring(r_array_capacity)
     def p_array_capacity(self, p: P) -> None:
         p[0] = p[1]
@@ -668,6 +743,23 @@ class Parser:
         name = p[2]
         type = p[1]
         field_number = p[4]
+        if len(p) == 9:
+            for option_name, value, lineno in p[6]:
+                if option_name != "range":
+                    raise UnsupportedOption(
+                        token=option_name,
+                        lineno=lineno,
+                        filepath=self.current_filepath(),
+                    )
+                lo, hi = value
+                type = Range(
+                    type=type,
+                    lo=lo,
+                    hi=hi,
+                    token=p[2],
+                    lineno=lineno,
+                    filepath=self.current_filepath(),
+                )
         p[0] = message_field = MessageField(
             name=name,
             type=type,
@@ -682,6 +774,80 @@ class Parser:
         )
         self.current_scope().push_member(message_field)
 
+    @override_docstring(r_oneof)
+    def p_oneof(self, p: P) -> None:
+        p[0] = oneof = p[2]
+        self.current_scope().push_member(oneof)
+        self.copy_p_tracking(p)
+
+    @override_docstring(r_open_oneof_scope)
+    def p_open_oneof_scope(self, p: P) -> None:
+        oneof = Oneof(
+            name=p[2],
+            token=p[2],
+            lineno=p.lineno(2),
+            filepath=self.current_filepath(),
+            indent=self.current_indent(p),
+            comment_block=self.collect_comment_block(),
+            scope_stack=self.current_scope_stack(),
+            _bound=self.current_proto(),
+        )
+        self.push_scope(oneof)
+
+    @override_docstring(r_close_oneof_scope)
+    def p_close_oneof_scope(self, p: P) -> None:
+        self.pop_scope().freeze()
+
+    @override_docstring(r_oneof_scope)
+    def p_oneof_scope(self, p: P) -> None:
+        p[0] = scope = self.current_scope()
+
+    @override_docstring(r_oneof_items)
+    def p_oneof_items(self, p: P) -> None:
+        self.util_parse_sequence(p)
+
+    @override_docstring(r_oneof_item)
+    def p_oneof_item(self, p: P) -> None:
+        p[0] = p[1]
+
+    @override_docstring(r_oneof_variant)
+    def p_oneof_variant(self, p: P) -> None:
+        p[0] = variant = OneofVariant(
+            name=p[2],
+            type=p[1],
+            tag=p[4],
+            token=p[2],
+            lineno=p.lineno(2),
+            filepath=self.current_filepath(),
+            comment_block=self.collect_comment_block(),
+            indent=self.current_indent(p),
+            scope_stack=self.current_scope_stack(),
+            _bound=self.current_proto(),
+        )
+        self.current_scope().push_member(variant)
+
+    @override_docstring(r_message_field_options)
+    def p_message_field_options(self, p: P) -> None:
+        if len(p) == 4:
+            p[0] = [p[1]] + p[3]
+        else:
+            p[0] = [p[1]]
+
+    @override_docstring(r_message_field_option)
+    def p_message_field_option(self, p: P) -> None:
+        p[0] = (p[1], p[3], p.lineno(1))
+
+    @override_docstring(r_range_literal)
+    def p_range_literal(self, p: P) -> None:
+        p[0] = (p[1], p[4])
+
+    @override_docstring(r_signed_integer_literal)
+    def p_signed_integer_literal(self, p: P) -> None:
+        if len(p) == 3:
+            p[0] = -p[2]
+        else:
+            p[0] = p[1]
+
     @override_docstring(r_message_field_name)
     def p_message_field_name(self, p: P) -> None:
         p[0] = p[1]
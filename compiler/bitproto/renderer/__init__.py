@@ -5,11 +5,14 @@ bitproto.renderer
 Renderer on target language.
 """
 
+import os
 from typing import List, Optional
 
 from bitproto._ast import Proto
 from bitproto.errors import UnsupportedLanguageToRender
 from bitproto.renderer.impls import renderer_registry
+from bitproto.renderer.impls.c import RendererCAmalgamation, RendererCBpf
+from bitproto.utils import write_file_if_changed
 
 
 def render(
@@ -18,14 +21,29 @@ def render(
     outdir: Optional[str] = None,
     optimization_mode: bool = False,
     optimization_mode_filter_messages: Optional[List[str]] = None,
+    depfile: bool = False,
+    amalgamate: bool = False,
+    bpf: bool = False,
 ) -> List[str]:
     """Render given `proto` to directory `outdir`.
     Returns the filepath list generated.
+
+    :param depfile: Whether to write a dependency file in makefile syntax as well,
+       named after the first generated file with extension ".d".
+    :param amalgamate: Whether to write an amalgamated c file as well, containing the
+       c files of the proto and the protos it imports, and the bitproto C library.
+       Only for language c.
+    :param bpf: Whether to write a header for eBPF programs instead, in optimization
+       mode. Only for language c.
     """
     clss = renderer_registry.get(lang, None)
     if clss is None:
         raise UnsupportedLanguageToRender()
 
+    if bpf:
+        clss = (RendererCBpf,)
+        optimization_mode = True
+
     outs = []
     for renderer_cls in clss:
         renderer = renderer_cls(
@@ -35,4 +53,40 @@ def render(
             optimization_mode_filter_messages=optimization_mode_filter_messages,
         )
         outs.append(renderer.render())
+
+    if amalgamate:
+        renderer = RendererCAmalgamation(
+            proto,
+            outdir=outdir,
+            optimization_mode_filter_messages=optimization_mode_filter_messages,
+        )
+        outs.append(renderer.render())
+
+    if depfile and outs:
+        depfile_path = os.path.splitext(outs[0])[0] + ".d"
+        write_file_if_changed(depfile_path, format_depfile(proto, outs))
     return outs
+
+
+def format_depfile(proto: Proto, outs: List[str]) -> str:
+    """Formats the dependency rule in makefile syntax, like `gcc -MD -MP`:
+    the generated files depend on the proto and all protos it imports recursively,
+    each imported proto has an empty rule in case it's removed later.
+    """
+
+    def escape(path: str) -> str:
+        return path.replace(" ", "\\ ")
+
+    imports: List[str] = []
+    for _, child in proto.protos(recursive=True):
+        if child.filepath and child.filepath not in imports:
+            imports.append(child.filepath)
+
+    targets = " ".join(escape(out) for out in outs)
+    paths = [path for path in [proto.filepath] + imports if path]
+    prerequisites = " ".join(escape(path) for path in paths)
+    lines = [f"{targets}: {prerequisites}"]
+    for path in imports:
+        lines.append("")
+        lines.append(f"{escape(path)}:")
+    return "\n".join(lines) + "\n"
@@ -12,6 +12,7 @@ Block class base.
       |    |- BlockBindEnumField
       |    |- BlockBindMessage
       |    |- BlockBindMessageField
+      |    |- BlockBindOneof
       |    |- BlockBindProto
       |- BlockDeferable
       |- BlockComposition
@@ -34,10 +35,14 @@ from bitproto._ast import (
     EnumField,
     Message,
     MessageField,
+    Oneof,
+    OneofVariant,
     Proto,
+    Range,
 )
 from bitproto.errors import InternalError
-from bitproto.renderer.formatter import F
+from bitproto.layout import fingerprint
+from bitproto.renderer.formatter import MASKED_DECODER_MAX_FIELDS, F
 from bitproto.utils import (
     cached_property,
     final,
@@ -59,6 +64,9 @@ class BlockRenderContext(Generic[F]):
     formatter: F
     bound: Proto
     optimization_mode_filter_messages: Optional[List[str]] = None
+    optimization_mode: bool = False
+    # The proto compiled, if bound is one it imports rendered in the same file.
+    root: Optional[Proto] = None
 
 
 class Block(Generic[F]):
@@ -96,6 +104,16 @@ class Block(Generic[F]):
         """Returns the bound proto of current block."""
         return self._get_ctx_or_raise().bound
 
+    def is_reachable(self, d: BoundDefinition) -> bool:
+        """Returns True if given definition is reachable from the filter messages in
+        standard mode, always True if there's no filter."""
+        ctx = self._get_ctx_or_raise()
+        if not ctx.optimization_mode_filter_messages:
+            return True
+        root = ctx.root or ctx.bound
+        names = tuple(ctx.optimization_mode_filter_messages)
+        return d.path in root.reachable_paths(names)
+
     @final
     def push_string(self, s: str, separator: str = " ") -> None:
         """Append an inline string `s` onto current string.
@@ -284,7 +302,7 @@ class BlockBindDefinition(Block[F], BlockBindDefinitionBase[D]):
         """
         self.push_docstring(*self.d.comment_block, indent=indent)
 
-    @final
+    @overridable
     def push_typing_hint_inline_comment(self) -> None:
         """Push an inline comment to hint the original defined bitproto type."""
         comment = self.formatter.format_comment(f"{self.nbits()}bit")
@@ -402,6 +420,39 @@ class BlockBindMessage(BlockBindDefinition[F, Message]):
         """Return the formatted name of the message size constant."""
         return f"BYTES_LENGTH_" + upper_case(snake_case(self.message_name))
 
+    @cached_property
+    def message_fingerprint(self) -> str:
+        """Returns the layout fingerprint of this message, in hex."""
+        return f"0x{fingerprint(self.d):016x}"
+
+    @overridable
+    @cached_property
+    def message_fingerprint_constant_name(self) -> str:
+        """Return the formatted name of the message fingerprint constant."""
+        return f"FINGERPRINT_" + upper_case(snake_case(self.message_name))
+
+    @cached_property
+    def has_masked_decoder(self) -> bool:
+        """Returns True if the masked decoder is generated for this message, which
+        has fields, at most MASKED_DECODER_MAX_FIELDS, one bit of the mask each."""
+        return 0 < self.d.nfields() <= MASKED_DECODER_MAX_FIELDS
+
+    def format_field_mask_constant_name(self, field: MessageField) -> str:
+        """Returns the formatted name of the constant of the mask bit selecting given
+        field in the masked decoder."""
+        message_name = upper_case(snake_case(self.message_name))
+        return f"FIELD_MASK_{message_name}_{upper_case(snake_case(field.name))}"
+
+    @cached_property
+    def unsized_fields_mask(self) -> int:
+        """Returns the mask of the fields not in fixed size, which the masked decoder
+        decodes always, since where the next field begins is known only then."""
+        mask = 0
+        for k, field in enumerate(self.d.sorted_fields()):
+            if not field.type.is_fixed_size():
+                mask |= 1 << k
+        return mask
+
 
 class BlockBindMessageField(BlockBindDefinition[F, MessageField]):
     """Implements the BlockBindDefinition for MessageField."""
@@ -410,6 +461,15 @@ class BlockBindMessageField(BlockBindDefinition[F, MessageField]):
     def nbits(self) -> int:
         return self.d.type.nbits()
 
+    @override(BlockBindDefinition)
+    def push_typing_hint_inline_comment(self) -> None:
+        """Hints the range of a field of option range as well, e.g. 15bit 1000..21000"""
+        t = self.d.type
+        if not isinstance(t, Range):
+            return super().push_typing_hint_inline_comment()
+        comment = self.formatter.format_comment(f"{self.nbits()}bit {t.lo}..{t.hi}")
+        self.push_string(comment)
+
     @cached_property
     def message_field_name(self) -> str:
         return self.formatter.format_message_field_name(self.d)
@@ -417,7 +477,54 @@ class BlockBindMessageField(BlockBindDefinition[F, MessageField]):
     @cached_property
     def message_field_type(self) -> str:
         """Returns the formatted field type representation of this field."""
-        return self.formatter.format_type(self.d.type, name=self.message_field_name)
+        t = self.formatter.field_type(self.d)
+        return self.formatter.format_type(t, name=self.message_field_name)
+
+
+class BlockBindOneof(BlockBindDefinition[F, Oneof]):
+    """Implements the BlockBindDefinition for Oneof."""
+
+    @override(BlockBindDefinition)
+    def nbits(self) -> int:
+        return self.d.nbits()
+
+    @cached_property
+    def oneof_name(self) -> str:
+        """Returns the formatted name of this oneof."""
+        return self.formatter.format_oneof_name(self.d)
+
+    @cached_property
+    def oneof_nbytes(self) -> str:
+        """Returns the formatted representation of the number of bytes of the tag
+        and the largest variant."""
+        return self.formatter.format_int_value(self.d.nbytes())
+
+    @cached_property
+    def oneof_size_constant_name(self) -> str:
+        """Return the formatted name of the oneof size constant."""
+        return f"BYTES_LENGTH_" + upper_case(snake_case(self.oneof_name))
+
+    @cached_property
+    def oneof_tag_mask(self) -> str:
+        """Returns the formatted mask of the tag bits in the first byte."""
+        return self.formatter.format_int_value((1 << self.d.tag_nbits()) - 1)
+
+    @cached_property
+    def oneof_tag_table_size(self) -> int:
+        """Returns the number of slots of the jump table, indexed by the tag."""
+        return 1 << self.d.tag_nbits()
+
+    def format_variant_name(self, v: OneofVariant) -> str:
+        return self.formatter.format_oneof_variant_name(v)
+
+    def format_variant_tag_constant_name(self, v: OneofVariant) -> str:
+        """Returns the formatted name of the constant of given variant's tag."""
+        oneof_name = upper_case(snake_case(self.oneof_name))
+        return f"TAG_{oneof_name}_{upper_case(snake_case(v.name))}"
+
+    def format_variant_nbytes(self, v: OneofVariant) -> str:
+        """Returns the formatted number of bytes of the tag and given variant."""
+        return self.formatter.format_int_value(self.d.variant_nbytes(v))
 
 
 class BlockBindProto(BlockBindDefinition[F, Proto]):
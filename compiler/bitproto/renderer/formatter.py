@@ -6,6 +6,7 @@ Formatter class base.
 """
 
 import os
+from math import gcd
 from abc import abstractmethod
 from enum import Enum as Enum_, unique
 from typing import (
@@ -32,13 +33,18 @@ from bitproto._ast import (
     Definition,
     Enum,
     EnumField,
+    Fixed,
+    Float,
     Int,
     Integer,
     IntegerConstant,
     Message,
     MessageField,
     Node,
+    Oneof,
+    OneofVariant,
     Proto,
+    Range,
     Scope,
     SingleType,
     StringConstant,
@@ -47,6 +53,7 @@ from bitproto._ast import (
     Value,
 )
 from bitproto.errors import InternalError
+from bitproto.layout import is_byte_order_free, memcpy_runs
 from bitproto.utils import (
     cast_or_raise,
     final,
@@ -59,6 +66,14 @@ from bitproto.utils import (
 
 CaseStyleConverter = Callable[[str], str]
 
+# Arrays of single types with at least this number of elements are encoded and
+# decoded in a loop instead of unrolled, in the optimization mode.
+OP_MODE_ARRAY_LOOP_THRESHOLD = 16
+
+# Masked decoders select the fields by the bits of an uint64 mask, one bit a field,
+# they are generated for messages up to this number of fields.
+MASKED_DECODER_MAX_FIELDS = 64
+
 # Dict[DefinitionType => One or tuple of CaseStyle name OR CaseStyleConverter]
 CaseStyleMapping = Dict[T[Definition], Union[str, Tuple[str, ...], CaseStyleConverter]]
 
@@ -93,6 +108,13 @@ class CaseStyle(Enum_):
 class Formatter:
     """Generic language specific formatter."""
 
+    # The index of the first byte and the number of bytes per iteration of the array
+    # loop being formatted in the optimization mode, see format_op_mode_array_loop.
+    op_mode_loop: Optional[Tuple[int, int]] = None
+    # Whether the statements being formatted in the optimization mode are the ones
+    # for big-endian hosts, see format_op_mode_memcpy.
+    op_mode_big_endian: bool = False
+
     #############
     # Abstracts
     #############
@@ -169,6 +191,16 @@ class Formatter:
         """Signed integer type representation in target language."""
         raise NotImplementedError
 
+    @abstractmethod
+    def format_float_type(self) -> str:
+        """Single precision floating point type representation in target language."""
+        raise NotImplementedError
+
+    @abstractmethod
+    def format_fixed_type(self, t: Fixed) -> str:
+        """Fixed-point type representation in target language, a floating point type."""
+        raise NotImplementedError
+
     @abstractmethod
     def format_array_type(self, t: Array, name: Optional[str] = None) -> str:
         """Array type representation in target language.
@@ -180,6 +212,23 @@ class Formatter:
     # Overridables
     ###############
 
+    @overridable
+    def is_direct_codec(self, t: Message) -> bool:
+        """Returns True if the encoder and decoders of given message work directly on
+        struct fields in standard mode, by the statements of optimization mode, that
+        is, message option direct_codec is set. Others go through the library, so a
+        proto could mix both for speed and size."""
+        return t.get_option_as_bool_or_raise("direct_codec")
+
+    @final
+    def self_test(self, t: Message) -> int:
+        """Returns the number of test vectors function BpSelfTestXXX of given message
+        checks against, zero if it's not generated, see option self_test. Messages
+        encoding to no bytes are not tested."""
+        if t.nbytes() == 0:
+            return 0
+        return t.bound.get_option_as_int_or_raise("self_test")
+
     @overridable
     def format_left_shift(self, n: int) -> str:
         """Returns the representation to shift left for n bits."""
@@ -281,6 +330,35 @@ class Formatter:
         """
         return []
 
+    @overridable
+    def op_mode_batch_post_format_array(self, t: Array, is_encode: bool) -> bool:
+        """
+        Overridable hook function that tells whether the post processing of array elements should be
+        done in a batch after the whole array's encoding or decoding code is generated, in the
+        optimization mode. If returns True, the hook `post_format_op_mode_endecode_single_type` won't
+        be called for each element of this array, and `post_format_op_mode_endecode_array` will be
+        called instead.
+
+        :param t: The array type.
+        :param is_encode: Is generating code for encoding or decoding now.
+        """
+        return False
+
+    @overridable
+    def post_format_op_mode_endecode_array(
+        self, t: Array, chain: str, is_encode: bool
+    ) -> List[str]:
+        """
+        Overridable hook function that would be called after an array's encoding or decoding code is
+        generated in the optimization mode, if `op_mode_batch_post_format_array` returns True.
+        The lines returned by this function would be generated right follow the array's code.
+
+        :param t: The array type.
+        :param chain: The chained name of this array in this message's encode/decode function.
+        :param is_encode: Is generating code for encoding or decoding now.
+        """
+        return []
+
     ###########
     # Finals
     ###########
@@ -300,6 +378,21 @@ class Formatter:
         elif isinstance(value, int):
             return self.format_int_value(value)
 
+    @final
+    def json_bytes(self, t: Array, d: Definition) -> str:
+        """Returns the json format of given array, one of array, hex and base64. Only
+        arrays of bytes are formatted as strings, by option json_bytes of the message
+        the array is declared in, falling back to the proto's. Arrays declared by
+        aliases follow the proto's option.
+        """
+        if not isinstance(t.element_type, Byte):
+            return "array"
+        if isinstance(d, MessageField):
+            option = d.message.get_option_as_string_or_raise("json_bytes")
+            if option:
+                return option
+        return d.bound.get_option_as_string_or_raise("json_bytes")
+
     @overridable
     def get_nbits_of_integer(self, t: Integer) -> int:
         """Get number of bits to occupy for an given integer type in a language.
@@ -475,6 +568,25 @@ class Formatter:
         """Formats the declaration name of given message field."""
         return self.format_case_style(f.name, MessageField)
 
+    @final
+    def format_oneof_name(self, t: Oneof) -> str:
+        """Formats the declaration name of given oneof, in the case style of
+        messages."""
+        return self.format_definition_name(t, Message)
+
+    @final
+    def format_oneof_variant_name(self, v: OneofVariant) -> str:
+        """Formats the declaration name of given oneof variant, in the case style of
+        message fields."""
+        return self.format_case_style(v.name, MessageField)
+
+    @overridable
+    def field_type(self, f: MessageField) -> Type:
+        """Returns the type of given message field in target language. Defaults to
+        the declared type, a language may represent it by another type of the same
+        bits on the wire."""
+        return f.type
+
     @final
     def format_type(self, t: Type, name: Optional[str] = None) -> str:
         """Formats the string representation for given type.
@@ -487,10 +599,16 @@ class Formatter:
             return self.format_bool_type()
         elif isinstance(t, Byte):
             return self.format_byte_type()
+        elif isinstance(t, Range):
+            return self.format_type(t.type)
         elif isinstance(t, Uint):
             return self.format_uint_type(t)
         elif isinstance(t, Int):
             return self.format_int_type(t)
+        elif isinstance(t, Float):
+            return self.format_float_type()
+        elif isinstance(t, Fixed):
+            return self.format_fixed_type(t)
         elif isinstance(t, Array):
             return self.format_array_type(t, name=name)
         elif isinstance(t, Enum):
@@ -564,13 +682,187 @@ class Formatter:
         """
         raise NotImplementedError
 
+    @overridable
+    def format_op_mode_range_offset(self, t: Range, chain: str) -> str:
+        """Formats the expression of the value of variable chain minus the lower bound
+        of given range, which is encoded in place of the value, only its lower
+        t.nbits() bits. The encoder items take it as a value instead of a variable.
+        Decoders add the lower bound back in post_format_op_mode_endecode_single_type.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_real_block(
+        self, t: Type, chain: str, w: Uint, is_encode: bool, body: List[str]
+    ) -> List[str]:
+        """Formats a block processing a float32 or fixed-point value at variable chain,
+        of type t which may be an alias. The block declares a variable named w of the
+        unsigned integer type w, holding the bits on the wire, which the statements
+        body process in place of the value. Encoders convert the value into w before
+        body, decoders zero w before body and convert w back into the value after.
+        The lines of body should be indented by the implementation.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_array_loop(self, n: int, body: List[str]) -> List[str]:
+        """Formats a loop that runs the statements body n times, with the loop
+        variable k counting from 0, for long arrays in the optimization mode.
+        The lines of body should be indented by the implementation.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def op_mode_supports_memcpy(self) -> bool:
+        """Returns True if the runs of fields of which the encoding is exactly their
+        memory are encoded and decoded by a copy each, see bitproto.layout.memcpy_runs.
+        Defaults to False.
+        """
+        return False
+
+    @overridable
+    def format_op_mode_memcpy(
+        self,
+        chain: str,
+        t: Message,
+        field: MessageField,
+        si: int,
+        n: int,
+        is_encode: bool,
+        fallback: List[str],
+    ) -> List[str]:
+        """Formats the statements that copy n bytes between the buffer s at the sith
+        byte and the members of message t starting at given field, where chain is the
+        naming chain of the message. Required if op_mode_supports_memcpy returns True.
+        Unless the run is_byte_order_free, the fallback statements process the fields
+        one by one, to use on big-endian hosts.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_loop_index(self, base: int, stride: int) -> str:
+        """Formats the index expression base + stride * k inside an array loop.
+        Defaults to C style like `3 + 2 * k`.
+        """
+        k = "k" if stride == 1 else f"{stride} * k"
+        return k if base == 0 else f"{base} + {k}"
+
+    @overridable
+    def format_op_mode_encoder_constant_item(self, si: int, value: int, r: int) -> str:
+        """Formats one line item of encoder statement that writes a constant into the
+        destination buffer s, for the ahead flags of extensible types.
+        :param si: The index of byte in the destination buffer s.
+        :param value: The value to write, already shifted and masked.
+        :param r: 0 if target buffer is margined to the left of byte.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_ahead_check(self, p: int, value: int) -> str:
+        """Formats the expression that checks whether the ahead flag at the pth bit of
+        buffer s equals to given value."""
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_normalizer_copy(self, p: int, n: int) -> List[str]:
+        """Formats the normalizer statements to copy n bits from buffer s at the bit
+        cursor i to buffer t at the pth bit, and then move the cursor forward."""
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_normalizer_ahead_begin(
+        self, k: int, p: int, value: int
+    ) -> List[str]:
+        """Formats the normalizer statements at the beginning of the kth extensible type,
+        which keep the bit cursor i and the ahead flag read from buffer s, write the
+        ahead flag value of current version to buffer t at the pth bit, and then move
+        the cursor forward."""
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_normalizer_ahead_end(self, k: int, factor: int) -> List[str]:
+        """Formats the normalizer statements at the end of the kth extensible type, which
+        skip the cursor to the position i + ahead * factor if it is ahead, where i and
+        ahead are kept at the beginning."""
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_patcher_item(
+        self, chain: str, t: Type, si: int, fi: int, shift: int, mask: int
+    ) -> str:
+        """Formats one line item of patching statement, which writes bits into the
+        encoded buffer s in place, keeping other bits in the target byte.
+        :param chain: Naming chain of current field being processed.
+        :param t: The field's type.
+        :param si: The index of byte in the destination buffer s.
+        :param fi: The index of byte in the source field's bytes.
+        :param shift: The number of bits to shift.
+        :param mask: The mask get from op_mode_get_mask.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_word_encoder_items(
+        self, chain: str, t: Type, si: int, o: int, n: int
+    ) -> List[str]:
+        """Formats the encoding statements for a field coalesced into a word, see
+        op_mode_is_word_coalescable. The field's value is widened to 64 bits and shifted
+        left by o bits, and then each byte of it is stored into the buffer s in order.
+        :param chain: Naming chain of current field being processed.
+        :param t: The field's type.
+        :param si: The index of the first byte in the destination buffer s.
+        :param o: The index of the bit to start at in the first byte.
+        :param n: The number of bits of the field.
+        """
+        raise NotImplementedError
+
+    @overridable
+    def format_op_mode_word_decoder_items(
+        self, chain: str, t: Type, si: int, o: int, n: int
+    ) -> List[str]:
+        """Formats the decoding statements for a field coalesced into a word, see
+        op_mode_is_word_coalescable. The bytes in the buffer s are or-ed into a 64 bits
+        word, which is shifted right by o bits and masked, and then assigned to the field.
+        The arguments are the same to format_op_mode_word_encoder_items's.
+        """
+        raise NotImplementedError
+
+    @final
+    def op_mode_word_byte_count(self, o: int, n: int) -> int:
+        """Returns the number of bytes spanned by n bits starting at the oth bit."""
+        return (o + n + 7) // 8
+
+    @final
+    def op_mode_is_word_coalescable(self, t: Type, i: int) -> bool:
+        """Returns True if the single type t starting at the ith bit could be encoded
+        and decoded as a whole in a 64 bits word, instead of byte by byte. That is, the
+        type is an integer, a byte, an enum, or an alias to them, which spans more than
+        one byte and no more than 64 bits after shifting.
+        """
+        t_ = t.type if isinstance(t, Alias) else t
+        if isinstance(t_, Bool):
+            return False
+        o, n = i % 8, t.nbits()
+        return o + n <= 64 and self.op_mode_word_byte_count(o, n) > 1
+
     @overridable
     def format_op_mode_field_name_chain(self, chain: str, field: MessageField) -> str:
         """Append a name to current field name lookup chain."""
         return chain + "." + self.format_message_field_name(field)
 
+    @final
+    def format_op_mode_buffer_index(self, si: int) -> str:
+        """Formats the index of the sith byte in the buffer s. Inside an array loop,
+        si is relative to the bytes of current iteration."""
+        if self.op_mode_loop is None:
+            return str(si)
+        base, stride = self.op_mode_loop
+        return self.format_op_mode_loop_index(base + si, stride)
+
     @overridable
-    def format_op_mode_field_name_chain_array(self, chain: str, index: int) -> str:
+    def format_op_mode_field_name_chain_array(
+        self, chain: str, index: Union[int, str]
+    ) -> str:
         """Format array index lookup as a name to append on current field name
         lookup chain.
         """
@@ -633,7 +925,12 @@ class Formatter:
 
     @final
     def format_op_mode_endecode_single_type(
-        self, t: Type, chain: str, is_encode: bool, i: List[int]
+        self,
+        t: Type,
+        chain: str,
+        is_encode: bool,
+        i: List[int],
+        post_hook: bool = True,
     ) -> List[str]:
         """Formats the statements for encoding or decoding a single type.
 
@@ -643,11 +940,29 @@ class Formatter:
         :param i: List of a single number that counts the number of bits processed in the
            buffer s. Using a list instead of a number to update the number across
            recursion functions.
+        :param post_hook: Whether to call the post hook function for this type.
         """
+        if self.op_mode_is_real(t):
+            return self.format_op_mode_endecode_real(t, chain, is_encode, i)
+
         # l collects the generated lines.
         l: List[str] = []
         # j counts the number of bits processed.
         j, n = 0, t.nbits()
+
+        if is_encode and isinstance(t, Range):
+            chain = self.format_op_mode_range_offset(t, chain)
+
+        if self.op_mode_is_word_coalescable(t, i[0]):
+            # Process the field as a whole word instead of byte by byte.
+            si, o = int(i[0] / 8), i[0] % 8
+            if is_encode:
+                l = self.format_op_mode_word_encoder_items(chain, t, si, o, n)
+            else:
+                l = self.format_op_mode_word_decoder_items(chain, t, si, o, n)
+            j = n
+            i[0] += n
+
         while j < n:
             # Number of bits to copy
             # 8-(j%8) ensures the destination (source) space is enough.
@@ -664,7 +979,61 @@ class Formatter:
             i[0] += c
 
         # hook function
-        l.extend(self.post_format_op_mode_endecode_single_type(t, chain, is_encode))
+        if post_hook:
+            l.extend(self.post_format_op_mode_endecode_single_type(t, chain, is_encode))
+        return l
+
+    @final
+    def op_mode_is_real(self, t: Type) -> bool:
+        """Returns True if given type is a float32 or fixed-point type, or an alias to
+        them, which is processed through its bits on the wire, see
+        format_op_mode_real_block.
+        """
+        t_ = t.type if isinstance(t, Alias) else t
+        return isinstance(t_, (Float, Fixed))
+
+    @final
+    def format_op_mode_endecode_real(
+        self, t: Type, chain: str, is_encode: bool, i: List[int]
+    ) -> List[str]:
+        """Formats the statements for encoding or decoding a float32 or fixed-point
+        value, as an unsigned integer variable w of the same number of bits."""
+        w = Uint(cap=t.nbits())
+        body = self.format_op_mode_endecode_single_type(w, "w", is_encode, i)
+        return self.format_op_mode_real_block(t, chain, w, is_encode, body)
+
+    @final
+    def op_mode_ahead_value(self, t: Union[Message, Array]) -> int:
+        """Returns the value of the ahead flag of given extensible type:
+        the number of bits for a message, and the capacity for an array."""
+        if isinstance(t, Message):
+            return t.nbits()
+        return t.cap
+
+    @final
+    def format_op_mode_endecode_ahead(
+        self, t: Union[Message, Array], is_encode: bool, i: List[int]
+    ) -> List[str]:
+        """Formats the encoding statements for the ahead flag of given type if it's
+        extensible. Decoding statements just skip the ahead flag, the decoder reads them
+        at runtime only if the layout differs, see format_op_mode_normalizer.
+        """
+        if not t.extensible:
+            return []
+        if not is_encode:
+            i[0] += t.ahead_nbits()
+            return []
+
+        l: List[str] = []
+        value = self.op_mode_ahead_value(t)
+        j, n = 0, t.ahead_nbits()
+        while j < n:
+            c = min(8 - (i[0] % 8), n - j)
+            b = ((value >> j) & ((1 << c) - 1)) << (i[0] % 8)
+            si, r = int(i[0] / 8), i[0] % 8
+            l.append(self.format_op_mode_encoder_constant_item(si, b, r))
+            j += c
+            i[0] += c
         return l
 
     @final
@@ -690,27 +1059,129 @@ class Formatter:
     ) -> List[str]:
         """Format the encoding (decoding) statements for an array.
         This function iterates all elements of this array and dispatch the formatting
-        according to the element's type.
+        according to the element's type. Long arrays of single types are processed in
+        a loop instead, see op_mode_is_array_loopable.
         """
         t_ = t.element_type
-        l: List[str] = []
-        for index in range(t.cap):
+        l: List[str] = self.format_op_mode_endecode_ahead(t, is_encode, i)
+        batch = self.op_mode_batch_post_format_array(t, is_encode)
+        start = 0
+        if self.op_mode_is_array_loopable(t):
+            j = i[0]
+            loop = self.format_op_mode_endecode_array_loop(t, chain, is_encode, i)
+            if self.op_mode_is_bool_array(t):
+                loop = self.format_op_mode_bool_array_loop(t, chain, is_encode, j, loop)
+            l.extend(loop)
+            start = t.cap - t.cap % self.op_mode_array_loop_period(t)
+        for index in range(start, t.cap):
             l_: List[str]
             chain_ = self.format_op_mode_field_name_chain_array(chain, index)
             if isinstance(t_, SingleType):
-                l_ = self.format_op_mode_endecode_single_type(t_, chain_, is_encode, i)
+                l_ = self.format_op_mode_endecode_single_type(
+                    t_, chain_, is_encode, i, post_hook=not batch
+                )
             elif isinstance(t_, Message):
                 l_ = self.format_op_mode_endecode_message(t_, chain_, is_encode, i)
             elif isinstance(t_, Alias):
-                l_ = self.format_op_mode_endecode_alias(t_, chain_, is_encode, i)
+                l_ = self.format_op_mode_endecode_alias(
+                    t_, chain_, is_encode, i, post_hook=not batch
+                )
             else:
                 raise InternalError("format_endecode_array got unknown element_type")
             l.extend(l_)
+        if batch:
+            l.extend(self.post_format_op_mode_endecode_array(t, chain, is_encode))
         return l
 
+    @final
+    def op_mode_is_bool_array(self, t: Array) -> bool:
+        """Returns True if the elements of given array are bools, or aliases to bool."""
+        t_ = t.element_type
+        if isinstance(t_, Alias):
+            t_ = t_.type
+        return isinstance(t_, Bool)
+
+    @overridable
+    def format_op_mode_bool_array_loop(
+        self, t: Array, chain: str, is_encode: bool, i: int, loop: List[str]
+    ) -> List[str]:
+        """Formats the loop that encodes (decodes) the leading elements of given array
+        of bools, 8 bools in a byte per iteration, starting at the ith bit of buffer s.
+        Defaults to the given loop, formatted by format_op_mode_endecode_array_loop.
+        """
+        return loop
+
+    @final
+    def op_mode_array_loop_period(self, t: Array) -> int:
+        """Returns the number of elements after which the bit offsets of given array's
+        elements repeat, that is, they end at a byte boundary exactly."""
+        return 8 // gcd(t.element_type.nbits(), 8)
+
+    @final
+    def op_mode_is_array_loopable(self, t: Array) -> bool:
+        """Returns True if given array should be processed in a loop instead of unrolled,
+        that is, it's long enough, and its elements are single types, or messages in
+        fixed size, so that every iteration runs the same statements on shifted indexes.
+        Arrays inside the messages are unrolled in the loop.
+        """
+        if self.op_mode_loop is not None or t.cap < OP_MODE_ARRAY_LOOP_THRESHOLD:
+            return False
+        t_ = t.element_type
+        if isinstance(t_, Alias):
+            t_ = t_.type
+        if isinstance(t_, Message):
+            if not t_.is_fixed_size():
+                return False
+        elif not isinstance(t_, SingleType):
+            return False
+        return t.cap // self.op_mode_array_loop_period(t) > 1
+
+    @final
+    def format_op_mode_endecode_array_loop(
+        self, t: Array, chain: str, is_encode: bool, i: List[int]
+    ) -> List[str]:
+        """Formats the loop that encodes (decodes) the leading elements of given array,
+        a period of elements per iteration, see op_mode_array_loop_period. The rest
+        elements are left to be unrolled by the caller.
+
+        The statements for a period are generated once, with the bit index starting at
+        the same offset inside the first byte, and byte indexes relative to current
+        iteration, which are formatted by format_op_mode_buffer_index.
+        """
+        t_ = t.element_type
+        batch = self.op_mode_batch_post_format_array(t, is_encode)
+        period = self.op_mode_array_loop_period(t)
+        n = t.cap // period
+        stride = period * t_.nbits() // 8
+        self.op_mode_loop = (i[0] // 8, stride)
+        body: List[str] = []
+        j = [i[0] % 8]
+        for e in range(period):
+            index = self.format_op_mode_loop_index(e, period)
+            chain_ = self.format_op_mode_field_name_chain_array(chain, index)
+            if isinstance(t_, Alias):
+                l_ = self.format_op_mode_endecode_alias(
+                    t_, chain_, is_encode, j, post_hook=not batch
+                )
+            elif isinstance(t_, Message):
+                l_ = self.format_op_mode_endecode_message(t_, chain_, is_encode, j)
+            else:
+                l_ = self.format_op_mode_endecode_single_type(
+                    t_, chain_, is_encode, j, post_hook=not batch
+                )
+            body.extend(l_)
+        self.op_mode_loop = None
+        i[0] += n * stride * 8
+        return self.format_op_mode_array_loop(n, body)
+
     @final
     def format_op_mode_endecode_alias(
-        self, t: Alias, chain: str, is_encode: bool, i: List[int]
+        self,
+        t: Alias,
+        chain: str,
+        is_encode: bool,
+        i: List[int],
+        post_hook: bool = True,
     ) -> List[str]:
         """Format the encoding (decoding) statements for an alias type.
         This function dispatches the formatting process according to the type aliased.
@@ -727,6 +1198,7 @@ class Formatter:
                 chain,
                 is_encode,
                 i,
+                post_hook=post_hook,
             )
 
         raise InternalError("format_endecode_alias got unknown aliased type")
@@ -739,10 +1211,47 @@ class Formatter:
         This function iterates the message fields and dispatches the formatting process
         accaccording to the field's type.
         """
-        l: List[str] = []
+        # Runs are byte-aligned inside the message, so is the message required.
+        aligned = i[0] % 8 == 0
+        l: List[str] = self.format_op_mode_endecode_ahead(t, is_encode, i)
+        runs: Dict[int, List[MessageField]] = {}
+        if aligned and self.op_mode_supports_memcpy():
+            runs = {run[0].number: run for run in memcpy_runs(t)}
+        if self.op_mode_big_endian:
+            runs = {
+                number: run
+                for number, run in runs.items()
+                if all(is_byte_order_free(f.type) for f in run)
+            }
+        n = 0  # Number of fields left to skip, copied by a run already.
         for field in t.sorted_fields():
+            if n > 0:
+                n -= 1
+                continue
+            run = runs.get(field.number)
+            if run is not None:
+                nbytes = sum(f.type.nbits() for f in run) // 8
+                fallback: List[str] = []
+                if not all(is_byte_order_free(f.type) for f in run):
+                    self.op_mode_big_endian, j = True, [i[0]]
+                    for f in run:
+                        chain_ = self.format_op_mode_field_name_chain(chain, f)
+                        fallback.extend(
+                            self.format_op_mode_endecode_message_field(
+                                self.field_type(f), chain_, is_encode, j
+                            )
+                        )
+                    self.op_mode_big_endian = False
+                l.extend(
+                    self.format_op_mode_memcpy(
+                        chain, t, field, i[0] // 8, nbytes, is_encode, fallback
+                    )
+                )
+                i[0] += nbytes * 8
+                n = len(run) - 1
+                continue
             chain_ = self.format_op_mode_field_name_chain(chain, field)
-            t_ = field.type
+            t_ = self.field_type(field)
             l_ = self.format_op_mode_endecode_message_field(t_, chain_, is_encode, i)
             l.extend(l_)
         return l
@@ -763,5 +1272,176 @@ class Formatter:
             message, field_name_chain, False, [0]
         )
 
+    @overridable
+    def format_op_mode_oneof_variant_chain(self, v: OneofVariant) -> str:
+        """Returns the lookup chain of given oneof variant in rendered encoder and
+        decoder functions of the oneof."""
+        chain = self.format_op_mode_endecoder_message_var()
+        return chain + "." + self.format_oneof_variant_name(v)
+
+    @final
+    def format_op_mode_endecode_oneof_variant(
+        self, v: OneofVariant, is_encode: bool
+    ) -> List[str]:
+        """Formatter entry for the encoder (decoder) statements of given oneof
+        variant, which follows the tag, not byte-aligned unless the tag occupies 8
+        bits."""
+        chain = self.format_op_mode_oneof_variant_chain(v)
+        i = [v.oneof.tag_nbits()]
+        return self.format_op_mode_endecode_message(v.message, chain, is_encode, i)
+
+    @final
+    def format_op_mode_decode_message_fields(self, message: Message) -> List[List[str]]:
+        """Formatter entry for the decoder statements of each field of given message,
+        in the order of sorted fields, for the masked decoder to select by the mask.
+        Unlike format_op_mode_decode_message, fields are never copied by a run."""
+        chain = self.format_op_mode_endecoder_message_var()
+        i = [message.ahead_nbits() if message.extensible else 0]
+        return [
+            self.format_op_mode_endecode_message_field(
+                self.field_type(field),
+                self.format_op_mode_field_name_chain(chain, field),
+                False,
+                i,
+            )
+            for field in message.sorted_fields()
+        ]
+
+    @final
+    def op_mode_normalizer_ops(
+        self,
+        t: Type,
+        ops: List[Tuple[str, int, int, int]],
+        p: List[int],
+        k: List[int],
+    ) -> None:
+        """Collects the normalizer operations for given type into ops, the same way
+        the bitproto libraries walk the types at runtime.
+        Operations are tuples of:
+
+            ("copy", p, n, 0): copies n bits to the pth bit.
+            ("begin", k, p, value): begins the kth extensible type at the pth bit.
+            ("end", k, factor, 0): ends the kth extensible type.
+
+        :param p: List of a single number, the index of bit in the normalized buffer.
+        :param k: List of a single number, counts the extensible types.
+        """
+        if isinstance(t, Alias):
+            t = t.type
+
+        if t.is_fixed_size():
+            n = t.nbits()
+            if ops and ops[-1][0] == "copy" and ops[-1][1] + ops[-1][2] == p[0]:
+                # Merge continuous bits into a single copy.
+                ops[-1] = ("copy", ops[-1][1], ops[-1][2] + n, 0)
+            else:
+                ops.append(("copy", p[0], n, 0))
+            p[0] += n
+            return
+
+        if not isinstance(t, (Message, Array)):
+            raise InternalError("op_mode_normalizer_ops got unknown type")
+
+        k_ = k[0]
+        if t.extensible:
+            k[0] += 1
+            ops.append(("begin", k_, p[0], self.op_mode_ahead_value(t)))
+            p[0] += t.ahead_nbits()
+
+        if isinstance(t, Message):
+            for field in t.sorted_fields():
+                self.op_mode_normalizer_ops(field.type, ops, p, k)
+        else:
+            for _ in range(t.cap):
+                self.op_mode_normalizer_ops(t.element_type, ops, p, k)
+
+        if t.extensible:
+            # The same skipping as the bitproto libraries: i + ahead for messages,
+            # and i + ahead * capacity for arrays.
+            factor = 1 if isinstance(t, Message) else t.cap
+            ops.append(("end", k_, factor, 0))
+
+    @final
+    def format_op_mode_normalizer(self, message: Message) -> List[str]:
+        """Formats the normalizer statements for given message.
+        A normalizer copies the bits of a message encoded in buffer s into buffer t in the
+        layout of current version, skipping the redundant bits of extensible types the
+        same way the bitproto libraries do, so that the decoder statements could decode
+        from buffer t with the bit offsets known at compile time.
+        """
+        ops: List[Tuple[str, int, int, int]] = []
+        self.op_mode_normalizer_ops(message, ops, [0], [0])
+        l: List[str] = []
+        for op, a, b, c in ops:
+            if op == "copy":
+                l.extend(self.format_op_mode_normalizer_copy(a, b))
+            elif op == "begin":
+                l.extend(self.format_op_mode_normalizer_ahead_begin(a, b, c))
+            else:
+                l.extend(self.format_op_mode_normalizer_ahead_end(a, b))
+        return l
+
+    @final
+    def format_op_mode_ahead_checks(self, message: Message) -> List[str]:
+        """Formats the expressions checking whether all ahead flags in buffer s equal to
+        current version's, in which case the layout is the same as current version's.
+        """
+        ops: List[Tuple[str, int, int, int]] = []
+        self.op_mode_normalizer_ops(message, ops, [0], [0])
+        return [
+            self.format_op_mode_ahead_check(b, c) for op, _, b, c in ops if op == "begin"
+        ]
+
+    @final
+    def op_mode_accessor_fields(
+        self, message: Message, i: int = 0, path: Optional[List[MessageField]] = None
+    ) -> List[Tuple[List[MessageField], Type, int]]:
+        """Returns the fields of given message to generate accessors for, as a list of
+        tuples (path, type, i), where path is the list of fields to reach the field from
+        the message, and i is the index of the bit the field starts at in the buffer.
+        Nested messages are walked recursively, single types and aliases to single types
+        are collected, and arrays are skipped.
+        The given message should be in fixed size, that bit offsets are known.
+        """
+        path = path or []
+        l: List[Tuple[List[MessageField], Type, int]] = []
+        for field in message.sorted_fields():
+            t, path_ = field.type, path + [field]
+            if isinstance(t, Message):
+                l.extend(self.op_mode_accessor_fields(t, i, path_))
+            elif isinstance(t, SingleType):
+                l.append((path_, t, i))
+            elif isinstance(t, Alias) and isinstance(t.type, SingleType):
+                l.append((path_, t, i))
+            i += t.nbits()
+        return l
+
+    @final
+    def format_op_mode_getter(self, t: Type, chain: str, i: int) -> List[str]:
+        """Formats the statements for reading a single field of type t starting at the
+        ith bit of the encoded buffer into variable chain."""
+        return self.format_op_mode_endecode_message_field(t, chain, False, [i])
+
+    @final
+    def format_op_mode_setter(self, t: Type, chain: str, i: int) -> List[str]:
+        """Formats the statements for writing variable chain of type t into the encoded
+        buffer in place, starting at the ith bit, other bits are kept untouched."""
+        if self.op_mode_is_real(t):
+            w = Uint(cap=t.nbits())
+            body = self.format_op_mode_setter(w, "w", i)
+            return self.format_op_mode_real_block(t, chain, w, True, body)
+        l: List[str] = []
+        j, n = 0, t.nbits()
+        if isinstance(t, Range):
+            chain = self.format_op_mode_range_offset(t, chain)
+        while j < n:
+            c = min(8 - (i % 8), 8 - (j % 8), n - j)
+            shift, mask = ((j % 8) - (i % 8)), self.op_mode_get_mask(i % 8, c)
+            si, fi = int(i / 8), int(j / 8)
+            l.append(self.format_op_mode_patcher_item(chain, t, si, fi, shift, mask))
+            j += c
+            i += c
+        return l
+
 
 F = TypeVar("F", bound=Formatter)
@@ -7,11 +7,13 @@ from typing import Dict, Tuple, Type as T
 from bitproto.renderer.renderer import Renderer
 
 from .c import RendererC, RendererCHeader
+from .cpp import RendererCpp
 from .go import RendererGo
 from .py import RendererPy
 
 renderer_registry: Dict[str, Tuple[T[Renderer], ...]] = {
     "c": (RendererC, RendererCHeader),
+    "cpp": (RendererCpp,),
     "go": (RendererGo,),
     "py": (RendererPy,),
 }
@@ -1,4 +1,5 @@
-from .renderer_c import RendererC
+from .renderer_bpf import RendererCBpf
+from .renderer_c import RendererC, RendererCAmalgamation
 from .renderer_h import RendererCHeader
 
-__all__ = ("RendererC", "RendererCHeader")
+__all__ = ("RendererC", "RendererCAmalgamation", "RendererCBpf", "RendererCHeader")
@@ -2,27 +2,48 @@
 C formatter.
 """
 
-from typing import List, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
 from bitproto._ast import (
     Alias,
     Array,
     Bool,
+    BoundDefinition,
     Byte,
     Constant,
     Definition,
     Enum,
     EnumField,
+    Fixed,
+    Float,
     Int,
     Message,
     MessageField,
+    OneofVariant,
     Proto,
+    Range,
+    SingleType,
     Type,
     Uint,
 )
 from bitproto.errors import InternalError
+from bitproto.layout import (
+    c_field_type,
+    c_sizeof,
+    c_struct_members,
+    has_fixed,
+    has_ranges,
+    has_reals,
+    has_validated_enums,
+    is_byte_order_free,
+    is_memcpy_type,
+    is_nbits_standard,
+    is_validated_enum,
+    memcpy_runs,
+    resolve_alias,
+)
 from bitproto.renderer.formatter import CaseStyleMapping, Formatter
-from bitproto.utils import override
+from bitproto.utils import cast_or_raise, override
 
 
 class CFormatter(Formatter):
@@ -69,12 +90,19 @@ class CFormatter(Formatter):
     def definition_name_prefix_option_name(self) -> str:
         return "c.name_prefix"
 
-    def bp_processor_name_prefix(self) -> str:
-        return "BpXXXProcess"
+    def bp_processor_name_prefix(self, is_encode: Optional[bool] = None) -> str:
+        """Returns the prefix of processor names, the direction-specific processors
+        are prefixed by BpXXXEncode or BpXXXDecode, see option c.split_processors."""
+        if is_encode is None:
+            return "BpXXXProcess"
+        return "BpXXXEncode" if is_encode else "BpXXXDecode"
 
     def bp_json_formatter_name_prefix(self) -> str:
         return "BpXXXJsonFormat"
 
+    def bp_json_parser_name_prefix(self) -> str:
+        return "BpXXXJsonParse"
+
     ############################
     # Value literal representing
     #############################
@@ -113,9 +141,21 @@ class CFormatter(Formatter):
     def format_int_type(self, t: Int) -> str:
         return "int{0}_t".format(self.get_nbits_of_integer(t))
 
+    @override(Formatter)
+    def format_float_type(self) -> str:
+        return "float"
+
+    @override(Formatter)
+    def format_fixed_type(self, t: Fixed) -> str:
+        return "double" if t.is_double() else "float"
+
     @override(Formatter)
     def format_array_type(self, t: Array, name: Optional[str] = None) -> str:
         assert name is not None, InternalError("format_array_type got name=None")
+        if t.bounded:
+            # The count of elements in use, ahead of the elements.
+            element_type = self.format_type(t.element_type)
+            return f"struct {{ uint16_t len; {element_type} data[{t.cap}]; }} {name}"
         return "{element_type} {name}[{capacity}]".format(
             element_type=self.format_type(t.element_type), name=name, capacity=t.cap
         )
@@ -124,6 +164,10 @@ class CFormatter(Formatter):
     def format_message_type(self, t: Message) -> str:
         return "struct {0}".format(self.format_message_name(t))
 
+    @override(Formatter)
+    def field_type(self, f: MessageField) -> Type:
+        return c_field_type(f)
+
     ###################
     # Library Supports
     ###################
@@ -140,12 +184,19 @@ class CFormatter(Formatter):
         if isinstance(t, Enum):
             return self.format_bp_enum(t)
         if isinstance(t, Alias):
-            return self.format_bp_alias(t)
+            return self.format_bp_alias(t, d)
         if isinstance(t, Message):
-            return self.format_bp_message(t)
+            return self.format_bp_message(t, d)
         if isinstance(t, Array):
             assert d is not None, InternalError("format_bp_array requires defintion")
             return self.format_bp_array(t, d)
+        if isinstance(t, Range):
+            assert d is not None, InternalError("format_bp_range requires defintion")
+            return self.format_bp_range(t, d)
+        if isinstance(t, Float):
+            return self.format_bp_float()
+        if isinstance(t, Fixed):
+            return self.format_bp_fixed(t, d)
         raise InternalError("format_bp_type got unexpected type")
 
     def format_bp_type_flag(self, t: Type) -> str:
@@ -166,6 +217,12 @@ class CFormatter(Formatter):
             return "BP_TYPE_BP_TYPE_MESSAGE"
         if isinstance(t, Array):
             return "BP_TYPE_ARRAY"
+        if isinstance(t, Range):
+            return "BP_TYPE_RANGE"
+        if isinstance(t, Float):
+            return "BP_TYPE_FLOAT"
+        if isinstance(t, Fixed):
+            return "BP_TYPE_FIXED"
         raise InternalError("format_bp_type_flag got unexpected type")
 
     def format_bp_bool(self) -> str:
@@ -184,11 +241,59 @@ class CFormatter(Formatter):
     def format_bp_byte(self) -> str:
         return f"BpByte()"
 
-    def format_bp_message(self, t: Message) -> str:
+    def format_bp_float(self) -> str:
+        return "BpFloat()"
+
+    def format_bp_fixed(self, t: Fixed, d: Optional[Definition] = None) -> str:
+        assert d is not None, InternalError("format_bp_fixed requires defintion")
+        nbits = self.format_int_value(t.nbits())
+        size = self.format_sizeof(self.format_fixed_type(t))
+        processor = self.format_bp_type_processor(
+            self.format_bp_fixed_processor_name(d), d
+        )
+        return f"BpFixed({nbits}, {size}, {processor})"
+
+    def fixed_type(self, t: Type) -> Optional[Fixed]:
+        """Returns the fixed-point type of given type of a message field or an alias,
+        or of its elements if it's an array, which is processed by the processor of
+        format_bp_fixed_processor_name. Returns None if there's no such type."""
+        if isinstance(t, Array):
+            t = t.element_type
+        return t if isinstance(t, Fixed) else None
+
+    def format_bp_fixed_processor_name(self, d: Definition) -> str:
+        """Formats the name of the processor of the fixed-point type of given message
+        field or alias, see fixed_type."""
+        prefix = self.bp_processor_name_prefix()
+        if isinstance(d, MessageField):
+            message_name = self.format_message_name(d.message)
+            return f"{prefix}Fixed{message_name}{d.number}"
+        if isinstance(d, Alias):
+            alias_name = self.format_alias_name(d)
+            return f"{prefix}Fixed{alias_name}"
+        raise InternalError("format_bp_fixed_processor_name got unexpected definition")
+
+    def format_bp_fixed_arguments(self, t: Fixed) -> str:
+        """Formats the arguments of the library functions processing given fixed-point
+        type: the size, the number of bits, the signedness and the unit, e.g.
+        sizeof(float), 16, true, 0.00390625"""
+        nbits = self.format_int_value(t.nbits())
+        size = self.format_sizeof(self.format_fixed_type(t))
+        signed = self.format_bool_value(t.signed)
+        return f"{size}, {nbits}, {signed}, {self.format_real_value(t.unit())}"
+
+    def format_real_value(self, value: float) -> str:
+        """Formats a double literal, exact for the powers of two of fixed-point types,
+        e.g. 256.0 and 0.00390625"""
+        return repr(value)
+
+    def format_bp_message(self, t: Message, d: Optional[Definition] = None) -> str:
         nbits = self.format_int_value(t.nbits())
         message_type = self.format_message_type(t)
         size = self.format_sizeof(message_type)
-        processor = self.format_bp_message_processor_name(t)
+        processor = self.format_bp_type_processor(
+            self.format_bp_message_processor_name(t), d
+        )
         formatter = self.format_bp_message_json_formatter_name(t)
         return f"BpMessage({nbits}, {size}, {processor}, {formatter})"
 
@@ -196,6 +301,9 @@ class CFormatter(Formatter):
         nbits = self.format_int_value(t.nbits())
         enum_type = self.format_enum_type(t)
         size = self.format_sizeof(enum_type)
+        if is_validated_enum(t):
+            validator = self.format_bp_enum_validator_name(t)
+            return f"BpValidatedEnum({nbits}, {size}, {validator})"
         return f"BpEnum({nbits}, {size})"
 
     def format_bp_array(self, t: Array, d: Definition) -> str:
@@ -204,75 +312,871 @@ class CFormatter(Formatter):
         size_element = self.format_sizeof(element_type)
         capacity = self.format_int_value(t.cap)
         size = f"{capacity} * {size_element}"
-        processor = self.format_bp_array_processor_name(t, d)
+        if t.bounded:
+            size = f"sizeof({self.format_bp_bounded_array_member(t, d)})"
+        processor = self.format_bp_type_processor(
+            self.format_bp_array_processor_name(t, d), d
+        )
         formatter = self.format_bp_array_json_formatter_name(t, d)
         return f"BpArray({nbits}, {size}, {processor}, {formatter})"
 
-    def format_bp_alias(self, t: Alias) -> str:
+    def format_bp_alias(self, t: Alias, d: Optional[Definition] = None) -> str:
         nbits = self.format_int_value(t.nbits())
         alias_type = self.format_alias_type(t)
         size = self.format_sizeof(alias_type)
-        processor = self.format_bp_alias_processor_name(t)
+        processor = self.format_bp_type_processor(
+            self.format_bp_alias_processor_name(t), d
+        )
         formatter = self.format_bp_alias_json_formatter_name(t)
         to_flag = self.format_bp_type_flag(t.type)
         return f"BpAlias({nbits}, {size}, {processor}, {formatter}, {to_flag})"
 
+    def format_bp_range(self, t: Range, d: Definition) -> str:
+        nbits = self.format_int_value(t.nbits())
+        size = self.format_sizeof(self.format_type(t.type))
+        processor = self.format_bp_type_processor(
+            self.format_bp_range_processor_name(d), d
+        )
+        to_flag = self.format_bp_type_flag(t.type)
+        return f"BpRange({nbits}, {size}, {processor}, {to_flag})"
+
+    def format_bp_range_lo(self, t: Range) -> str:
+        """Formats the lower bound of given range as an uint64_t, in two's complement
+        if negative, e.g. 1000ULL and (uint64_t)(-40)."""
+        if t.lo >= 0:
+            return f"{t.lo}ULL"
+        if t.lo == -(1 << 63):
+            return "(uint64_t)(-9223372036854775807 - 1)"
+        return f"(uint64_t)({t.lo})"
+
+    def format_bp_range_processor_name(self, d: Definition) -> str:
+        if isinstance(d, MessageField):
+            message_name = self.format_message_name(d.message)
+            prefix = self.bp_processor_name_prefix()
+            return f"{prefix}Range{message_name}{d.number}"
+        raise InternalError("format_bp_range_processor_name got unexpected definition")
+
+    def json_max_length(self, t: Type, d: Optional[Definition] = None) -> int:
+        """Returns the max number of characters the json formatter in the bitproto C
+        library may produce for given type, excluding the trailing null byte.
+        Integers are bounded by their C storage widths rather than the bitproto
+        widths, since the formatter reads the struct member as is. The definition d
+        is the message field or alias an array belongs to, see option json_bytes.
+        """
+        if isinstance(t, Bool):
+            return len("false")
+        if isinstance(t, Byte):
+            return len("255")
+        if isinstance(t, Uint):
+            return len(str((1 << self.get_nbits_of_integer(t)) - 1))
+        if isinstance(t, Int):
+            return len(str(-(1 << (self.get_nbits_of_integer(t) - 1))))
+        if isinstance(t, (Enum, Range)):
+            return self.json_max_length(t.type)
+        if isinstance(t, Float) or (isinstance(t, Fixed) and not t.is_double()):
+            # Formatted with 9 significant digits, e.g. -1.23456789e-38
+            return len("-1.23456789e-38")
+        if isinstance(t, Fixed):
+            # Formatted with 17 significant digits, e.g. -1.2345678901234567e-308
+            return len("-1.2345678901234567e-308")
+        if isinstance(t, Alias):
+            return self.json_max_length(t.type, t)
+        if isinstance(t, Array):
+            json_bytes = "array" if d is None else self.json_bytes(t, d)
+            if json_bytes == "hex":
+                return 2 + 2 * t.cap
+            if json_bytes == "base64":
+                return 2 + 4 * ((t.cap + 2) // 3)
+            # Brackets, elements and commas between elements.
+            n = t.cap * self.json_max_length(t.element_type)
+            return 2 + n + max(t.cap - 1, 0)
+        if isinstance(t, Message):
+            # Braces, quoted keys with colons, values and commas between fields.
+            fields = t.sorted_fields()
+            n = sum(
+                len(f.name) + 3 + self.json_max_length(self.field_type(f), f)
+                for f in fields
+            )
+            return 2 + n + max(len(fields) - 1, 0)
+        raise InternalError("json_max_length got unexpected type")
+
     def format_bp_enum_descriptor(self, t: Enum) -> str:
         bp_uint = self.format_bp_uint(t.type)
         return f"BpEnumDescriptor({bp_uint})"
 
-    def format_bp_message_descriptor(
-        self, t: Message, field_descriptors: str = "field_descriptors"
-    ) -> str:
+    def format_bp_message_descriptor(self, t: Message) -> str:
         extensible = self.format_bool_value(t.extensible)
         nfields = self.format_int_value(t.nfields())
         nbits = self.format_int_value(t.nbits())
+        field_descriptors = "NULL"  # Empty message has no field descriptors.
+        if t.nfields() > 0:
+            field_descriptors = self.format_bp_message_field_descriptors_name(t)
         return f"BpMessageDescriptor({extensible}, {nfields}, {nbits}, {field_descriptors})"
 
-    def format_bp_message_processor_name(self, t: Message) -> str:
+    def format_bp_message_processor_name(
+        self, t: Message, is_encode: Optional[bool] = None
+    ) -> str:
         message_name = self.format_message_name(t)
-        prefix = self.bp_processor_name_prefix()
+        prefix = self.bp_processor_name_prefix(is_encode)
         return f"{prefix}{message_name}"
 
     def format_bp_alias_descriptor(self, t: Alias) -> str:
         bp_type = self.format_bp_type(t.type, t)
         return f"BpAliasDescriptor({bp_type})"
 
-    def format_bp_alias_processor_name(self, t: Alias) -> str:
+    def format_bp_alias_processor_name(
+        self, t: Alias, is_encode: Optional[bool] = None
+    ) -> str:
         alias_name = self.format_alias_name(t)
-        prefix = self.bp_processor_name_prefix()
+        prefix = self.bp_processor_name_prefix(is_encode)
         return f"{prefix}{alias_name}"
 
-    def format_bp_array_descriptor(self, t: Array) -> str:
-        bp_type = self.format_bp_type(t.element_type)  # element_type won't be array
+    def format_bp_array_descriptor(
+        self, t: Array, d: Optional[Definition] = None
+    ) -> str:
+        bp_type = self.format_bp_type(t.element_type, d)  # element_type won't be array
         extensible = self.format_bool_value(t.extensible)
         cap = self.format_int_value(t.cap)
+        if t.bounded:
+            count_nbits = self.format_int_value(t.count_nbits())
+            offset = self.format_bp_bounded_array_offset(t, d)
+            return f"BpBoundedArrayDescriptor({cap}, {bp_type}, {count_nbits}, {offset})"
         return f"BpArrayDescriptor({extensible}, {cap}, {bp_type})"
 
-    def format_bp_array_processor_name(self, t: Array, d: Definition) -> str:
+    def format_bp_bounded_array_member(self, t: Array, d: Optional[Definition]) -> str:
+        """Formats the struct member of given bounded array, of the message field d,
+        e.g. `((struct Frame *)0)->samples`."""
+        field = cast_or_raise(MessageField, d)
+        message_type = self.format_message_type(field.message)
+        field_name = self.format_message_field_name(field)
+        return f"(({message_type} *)0)->{field_name}"
+
+    def format_bp_bounded_array_offset(
+        self, t: Array, d: Optional[Definition]
+    ) -> str:
+        """Formats the offset of the elements of given bounded array, in the struct
+        holding its count and elements."""
+        field = cast_or_raise(MessageField, d)
+        message_type = self.format_message_type(field.message)
+        field_name = self.format_message_field_name(field)
+        return (
+            f"offsetof({message_type}, {field_name}.data) - "
+            f"offsetof({message_type}, {field_name})"
+        )
+
+    def is_bp_message_array(self, t: Array, d: Definition) -> bool:
+        """Returns True if the processor of given array processes the elements by
+        BpEndecodeMessageArray, with the descriptor of the element message. That's
+        for arrays not extensible, of messages in the same proto, whose descriptors
+        are defined in the same file. The array descriptor is only used by the json
+        formatter then."""
+        t_ = t.element_type
+        if not isinstance(t_, Message) or t.extensible or t.bounded:
+            return False
+        return isinstance(d, BoundDefinition) and t_.bound is d.bound
+
+    def format_bp_array_processor_name(
+        self, t: Array, d: Definition, is_encode: Optional[bool] = None
+    ) -> str:
         if isinstance(d, MessageField):
-            return self.format_bp_array_processor_name_from_message_field(t, d)
+            return self.format_bp_array_processor_name_from_message_field(
+                t, d, is_encode
+            )
         if isinstance(d, Alias):
-            return self.format_bp_array_processor_name_from_alias(t, d)
+            return self.format_bp_array_processor_name_from_alias(t, d, is_encode)
         raise InternalError(
             "format_bp_array_processor_name got unexpected defintion type"
         )
 
     def format_bp_array_processor_name_from_message_field(
-        self, t: Array, d: MessageField
+        self, t: Array, d: MessageField, is_encode: Optional[bool] = None
     ) -> str:
         message_name = self.format_message_name(d.message)
-        prefix = self.bp_processor_name_prefix()
+        prefix = self.bp_processor_name_prefix(is_encode)
         return f"{prefix}Array{message_name}{d.number}"
 
-    def format_bp_array_processor_name_from_alias(self, t: Array, d: Alias) -> str:
+    def format_bp_array_processor_name_from_alias(
+        self, t: Array, d: Alias, is_encode: Optional[bool] = None
+    ) -> str:
         alias_name = self.format_alias_name(d)
-        prefix = self.bp_processor_name_prefix()
+        prefix = self.bp_processor_name_prefix(is_encode)
         return f"{prefix}Array{alias_name}"
 
-    def format_bp_message_field_descriptor_initer(self, t: Message) -> str:
+    def is_split_processors(self, d: BoundDefinition) -> bool:
+        """Returns True if option c.split_processors is set in the proto of given
+        definition, where the encode and decode processors are generated separately."""
+        return d.bound.get_option_as_bool_or_raise("c.split_processors")
+
+    def bp_processor_direction(
+        self, d: BoundDefinition, is_encode: bool
+    ) -> Optional[bool]:
+        """Returns the direction argument for the processor name functions, to call
+        the processor of given definition: is_encode if its processors are split,
+        otherwise None for the processor of both directions."""
+        return is_encode if self.is_split_processors(d) else None
+
+    def checksum(self, proto: Proto) -> str:
+        """Returns the checksum of the checked encoders and decoders generated for
+        messages, one of crc8, crc16 and crc32, empty if not any, see c.checksum."""
+        return proto.get_option_as_string_or_raise("c.checksum")
+
+    def checksum_nbytes(self, proto: Proto) -> int:
+        return {"crc8": 1, "crc16": 2, "crc32": 4}[self.checksum(proto)]
+
+    def framing(self, proto: Proto) -> str:
+        """Returns the framing of the framed encoders and decoders generated for
+        messages, one of cobs and slip, empty if not any, see c.framing."""
+        return proto.get_option_as_string_or_raise("c.framing")
+
+    def is_delta(self, t: Message) -> bool:
+        """Returns True if delta encoders and decoders are generated for given message,
+        that is, option c.delta is set. They are driven by the descriptors, which are
+        used by the json formatters only with option c.split_processors."""
+        if not t.bound.get_option_as_bool_or_raise("c.delta"):
+            return False
+        return not self.is_split_processors(t)
+
+    def is_large_message(self, t: Message) -> bool:
+        """Returns True if given message is declared with option large and its bits
+        can't be indexed by an int of 16 bits, that is, requires int of 32 bits."""
+        return t.get_option_as_bool_or_raise("large") and t.nbits() > 0x7FFF
+
+    def has_large_messages(self, proto: Proto) -> bool:
+        """Returns True if any message in given proto is_large_message."""
+        messages = proto.messages(recursive=True, bound=proto)
+        return any(self.is_large_message(m) for _, m in messages)
+
+    def has_reals(self, proto: Proto) -> bool:
+        """Returns True if any message in given proto has float32 or fixed-point types,
+        the bits of float32s are copied by memcpy in the optimization mode."""
+        messages = proto.messages(recursive=True, bound=proto)
+        return any(has_reals(m) for _, m in messages)
+
+    def validates_enums(self, proto: Proto) -> bool:
+        """Returns True if any message in given proto has enums validated on decoding,
+        see option c.validate_enums."""
+        messages = proto.messages(recursive=True, bound=proto)
+        return any(has_validated_enums(m) for _, m in messages)
+
+    def has_enum_values_table(self, t: Enum) -> bool:
+        """Returns True if the values declared in given validated enum are looked up
+        in a bitmap table on decoding. Values of enums of at most 6 bits are looked up
+        in a 64 bits constant instead, and contiguous values are checked by range."""
+        if not is_validated_enum(t) or self.enum_values_range(t) is not None:
+            return False
+        return 6 < t.nbits() <= 12
+
+    def enum_values_range(self, t: Enum) -> Optional[Tuple[int, int]]:
+        """Returns the min and max values declared in given enum if the values
+        between are all declared, otherwise None."""
+        values = sorted({field.value for field in t.fields()})
+        if not values or values[-1] - values[0] + 1 != len(values):
+            return None
+        return values[0], values[-1]
+
+    def format_bp_enum_values_table_name(self, t: Enum) -> str:
+        enum_name = self.format_enum_name(t)
+        prefix = self.bp_descriptor_name_prefix()
+        return f"{prefix}EnumValues{enum_name}"
+
+    def format_bp_enum_values_table_declaration(self, t: Enum) -> str:
+        name = self.format_bp_enum_values_table_name(t)
+        return f"const unsigned char {name}[{(1 << t.nbits()) // 8}]"
+
+    def format_bp_enum_values_table(self, t: Enum) -> str:
+        """Formats the definition of the bitmap table of values declared in given
+        enum, where bit k of byte j is set if value 8 * j + k is declared."""
+        table = [0] * ((1 << t.nbits()) // 8)
+        for field in t.fields():
+            table[field.value >> 3] |= 1 << (field.value & 7)
+        items = ", ".join(f"0x{b:02x}" for b in table)
+        return f"{self.format_bp_enum_values_table_declaration(t)} = {{{items}}};"
+
+    def format_bp_enum_validator_name(self, t: Enum) -> str:
+        enum_name = self.format_enum_name(t)
+        prefix = self.bp_descriptor_name_prefix()
+        return f"{prefix}ValidateEnum{enum_name}"
+
+    def format_bp_enum_check(self, t: Enum, v: str) -> str:
+        """Formats the expression checking that the value v of given enum is declared,
+        by one load and a test: a range check for contiguous values, a bit of a 64 bits
+        constant for enums of at most 6 bits, a bit in the bitmap table for enums of at
+        most 12 bits, and comparisons otherwise."""
+        range_ = self.enum_values_range(t)
+        if range_ is not None:
+            lo, hi = range_
+            if lo == 0:
+                return f"{v} <= {self.format_int_value(hi)}"
+            lo_, hi_ = self.format_int_value(lo), self.format_int_value(hi)
+            return f"({v} >= {lo_} && {v} <= {hi_})"
+        values = sorted({field.value for field in t.fields()})
+        if t.nbits() <= 6:
+            mask = sum(1 << value for value in values)
+            return f"(0x{mask:x}ULL >> {v}) & 1"
+        if self.has_enum_values_table(t):
+            name = self.format_bp_enum_values_table_name(t)
+            return f"({name}[{v} >> 3] >> ({v} & 7)) & 1"
+        return " || ".join(f"{v} == {self.format_int_value(x)}" for x in values)
+
+    def format_bp_enum_check_statement(self, t: Enum, v: str, err: str) -> str:
+        """Formats the statement setting err to BP_ERR_ENUM if the value v of given
+        enum is not declared."""
+        return f"if (!({self.format_bp_enum_check(t, v)})) {err} = BP_ERR_ENUM;"
+
+    def format_bp_decoder_return(self, t: Message, err: str) -> str:
+        """Formats the return statement of a decoder of given message, returning the
+        error code err if the message has enums to validate or bounded arrays,
+        otherwise 0."""
+        if has_validated_enums(t) or t.has_bounded_array():
+            return f"return {err};"
+        return "return 0;"
+
+    def format_bp_value_word(self, t: Type, chain: str) -> str:
+        """Formats the meaningful bits of the value of single type t at chain as an
+        uint64_t, that's the bits on the wire, masked to the type's nbits. The bits
+        above are ignored by the encoder, so they are ignored here too.
+        Float32s are left to format_bp_hash_memory, by the bits in memory."""
+        t = resolve_alias(t)
+        nbits = t.nbits()
+        mask = f" & {(1 << nbits) - 1}ULL" if nbits < 64 else ""
+        if isinstance(t, (Bool, Byte)):
+            return f"(uint64_t)({chain})"
+        if isinstance(t, Range):
+            return f"({self.format_op_mode_range_offset(t, chain)}{mask})"
+        if isinstance(t, Fixed):
+            scale = self.format_real_value(t.scale())
+            return f"(BP_FIXED_WORD((double)({chain}) * {scale}){mask})"
+        if c_sizeof(t)[0] * 8 == nbits:
+            return f"(uint64_t)({chain})"
+        return f"((uint64_t)({chain}){mask})"
+
+    def bp_hash_items(
+        self, t: Type, chain: str, depth: int = 0
+    ) -> List[Tuple[Any, ...]]:
+        """Returns the items to hash and compare the value of type t at chain in C, in
+        the order of the memory. Placeholder @ in chain is the struct pointer. Items:
+
+            ("memory", pointer, nbytes): bytes without padding, every bit meaningful.
+            ("word", expression): an uint64_t of format_bp_value_word.
+            ("loop", k, cap, items): items of each element of an array, indexed by k,
+                the cap is an expression if the array is bounded.
+        """
+        t = resolve_alias(t)
+        if isinstance(t, Float) or (
+            not isinstance(t, SingleType) and is_memcpy_type(t)
+        ):
+            return [("memory", f"&({chain})", c_sizeof(t)[0])]
+        if isinstance(t, Array) and t.bounded:
+            # The count in use, then the elements in use only.
+            k = f"k{depth}"
+            n = f"({chain}.len < {t.cap} ? {chain}.len : {t.cap})"
+            items = self.bp_hash_items(t.element_type, f"{chain}.data[{k}]", depth + 1)
+            return [("word", f"(uint64_t){n}"), ("loop", k, n, items)]
+        if isinstance(t, Array):
+            k = f"k{depth}"
+            items = self.bp_hash_items(t.element_type, f"{chain}[{k}]", depth + 1)
+            return [("loop", k, t.cap, items)]
+        if isinstance(t, Message):
+            return self.bp_hash_message_items(t, chain, depth)
+        return [("word", self.format_bp_value_word(t, chain))]
+
+    def bp_hash_message_items(
+        self, t: Message, chain: str, depth: int = 0
+    ) -> List[Tuple[Any, ...]]:
+        """Returns the items of the fields of given message, see bp_hash_items. Struct
+        members in memcpy types, adjacent in memory, are merged into a single item, to
+        be hashed word by word and compared by a single memcmp."""
+        offsets, _, _, _ = c_struct_members(t)
+        items: List[Tuple[Any, ...]] = []
+        run: List[MessageField] = []
+        end = 0  # Where the last member of current run ends in the struct.
+
+        def flush() -> None:
+            if len(run) == 1:
+                ft = c_field_type(run[0])
+                items.extend(self.bp_hash_items(ft, f"{chain}.{run[0].name}", depth))
+            elif run:
+                nbytes = end - offsets[run[0].number]
+                items.append(("memory", f"&({chain}.{run[0].name})", nbytes))
+            run.clear()
+
+        for field in t.fields():  # In the order of the struct members.
+            ft = c_field_type(field)
+            if not is_memcpy_type(ft):
+                flush()
+                items.extend(self.bp_hash_items(ft, f"{chain}.{field.name}", depth))
+                continue
+            if run and offsets[field.number] != end:
+                flush()
+            run.append(field)
+            end = offsets[field.number] + c_sizeof(ft)[0]
+        flush()
+        return items
+
+    def format_bp_hash_statements(self, t: Message, m: str) -> List[str]:
+        """Formats the statements mixing the meaningful bits of message t at pointer m
+        into variable h by BP_HASH_MIX, memory word by word.
+        Generated C statements like:
+
+            BP_HASH_MIX(h, ((uint64_t)((*m).status) & 7ULL));
+            {
+                uint64_t w = 0;
+                memcpy(&w, &((*m).position), 12);
+                ...
+            }
+
+        """
+        return self._format_bp_hash_items(self.bp_hash_message_items(t, "@"), m)
+
+    def _format_bp_hash_items(self, items: List[Tuple[Any, ...]], m: str) -> List[str]:
+        l: List[str] = []
+        for item in items:
+            if item[0] == "word":
+                l.append(f"BP_HASH_MIX(h, {item[1].replace('@', f'(*{m})')});")
+            elif item[0] == "memory":
+                p = item[1].replace("@", f"(*{m})")
+                l.extend(self.format_bp_hash_memory(p, item[2]))
+            else:
+                _, k, cap, body = item
+                cap = str(cap).replace("@", f"(*{m})")
+                l.append(f"for (int {k} = 0; {k} < {cap}; {k}++) {{")
+                l.extend("    " + line for line in self._format_bp_hash_items(body, m))
+                l.append("}")
+        return l
+
+    def format_bp_hash_memory(self, p: str, nbytes: int) -> List[str]:
+        """Formats the statements mixing nbytes bytes at pointer p into variable h, a
+        word of 8 bytes at a time. The words are loaded in the host byte order."""
+        l: List[str] = []
+        n = nbytes - nbytes % 8
+        if n > 8:
+            l.append(f"for (int j = 0; j < {n}; j += 8) {{")
+            l.append("    uint64_t w;")
+            l.append(f"    memcpy(&w, (const unsigned char *)({p}) + j, 8);")
+            l.append("    BP_HASH_MIX(h, w);")
+            l.append("}")
+        elif n == 8:
+            l.append("{")
+            l.append("    uint64_t w;")
+            l.append(f"    memcpy(&w, {p}, 8);")
+            l.append("    BP_HASH_MIX(h, w);")
+            l.append("}")
+        if nbytes % 8:
+            q = f"(const unsigned char *)({p}) + {n}" if n else p
+            l.append("{")
+            l.append("    uint64_t w = 0;")
+            l.append(f"    memcpy(&w, {q}, {nbytes % 8});")
+            l.append("    BP_HASH_MIX(h, w);")
+            l.append("}")
+        return l
+
+    def format_bp_equal_statements(self, t: Message, a: str, b: str) -> List[str]:
+        """Formats the statements returning false if the meaningful bits of messages t
+        at pointers a and b differ.
+        Generated C statements like:
+
+            if (((uint64_t)((*a).status) & 7ULL) != ((uint64_t)((*b).status) & 7ULL)) return false;
+            if (memcmp(&((*a).position), &((*b).position), 12) != 0) return false;
+
+        """
+        return self._format_bp_equal_items(self.bp_hash_message_items(t, "@"), a, b)
+
+    def _format_bp_equal_items(
+        self, items: List[Tuple[Any, ...]], a: str, b: str
+    ) -> List[str]:
+        l: List[str] = []
+        for item in items:
+            if item[0] == "word":
+                x, y = (item[1].replace("@", f"(*{v})") for v in (a, b))
+                l.append(f"if ({x} != {y}) return false;")
+            elif item[0] == "memory":
+                x, y = (item[1].replace("@", f"(*{v})") for v in (a, b))
+                l.append(f"if (memcmp({x}, {y}, {item[2]}) != 0) return false;")
+            else:
+                _, k, cap, body = item
+                # The counts of bounded arrays are equal here, compared ahead.
+                cap = str(cap).replace("@", f"(*{a})")
+                l.append(f"for (int {k} = 0; {k} < {cap}; {k}++) {{")
+                body_l = self._format_bp_equal_items(body, a, b)
+                l.extend("    " + line for line in body_l)
+                l.append("}")
+        return l
+
+    def format_literal_int(self, value: int) -> str:
+        """Formats an integer literal of any 64 bits integer type, e.g. 5, 4294967296LL
+        and 18446744073709551615ULL."""
+        if -(1 << 31) <= value < (1 << 31):
+            return self.format_int_value(value)
+        if value == -(1 << 63):
+            return "(-9223372036854775807LL - 1)"
+        if value < (1 << 63):
+            return f"{value}LL"
+        return f"{value}ULL"
+
+    def format_literal(self, t: Type, value: Any) -> str:
+        """Formats the initializer of given value in type t, of a test vector, see
+        bitproto.vectors. Messages are initialized by designated initializers:
+
+            {.id = 3, .position = {.x = 1.5, .y = -0.25}, .ids = {.len = 2, .data = {1, 2}}}
+        """
+        t = resolve_alias(t)
+        if isinstance(t, Bool):
+            return self.format_bool_value(value)
+        if isinstance(t, (Float, Fixed)):
+            return self.format_real_value(value)
+        if isinstance(t, Array):
+            elements = ", ".join(self.format_literal(t.element_type, v) for v in value)
+            if not t.bounded:
+                return f"{{{elements}}}"
+            if not value:
+                return "{.len = 0}"
+            return f"{{.len = {len(value)}, .data = {{{elements}}}}}"
+        if isinstance(t, Message):
+            items = []
+            for field in t.sorted_fields():
+                v = value[field.name]
+                ft = self.field_type(field)
+                if ft is not field.type:
+                    # Bitset of bools, bit k of byte j is element 8 * j + k.
+                    v = [
+                        sum(int(b) << k for k, b in enumerate(v[j : j + 8]))
+                        for j in range(0, len(v), 8)
+                    ]
+                name = self.format_message_field_name(field)
+                items.append(f".{name} = {self.format_literal(ft, v)}")
+            return f"{{{', '.join(items)}}}"
+        return self.format_literal_int(value)
+
+    def has_copy_plan(self, t: Message) -> bool:
+        """Returns True if a copy plan is generated for given message, that is, option
+        c.copy_plans (or c.bounded_stack) is set, and the message is small enough for the
+        16 bits fields of struct BpPlanOp. Messages with enums to validate, fields of
+        option range or fixed-point types are not copied by plans."""
+        if not (
+            t.bound.get_option_as_bool_or_raise("c.copy_plans")
+            or self.is_bounded_stack(t)
+        ):
+            return False
+        if has_validated_enums(t) or has_ranges(t) or has_fixed(t):
+            return False
+        if t.has_bounded_array():
+            return False
+        return t.nbits() <= 0xFFFF and c_sizeof(t)[0] <= 0xFFFF
+
+    def is_copy_plan(self, t: Message) -> bool:
+        """Returns True if given message is encoded and decoded by a copy plan, that
+        is, it has_copy_plan and is in fixed size."""
+        return self.has_copy_plan(t) and t.is_fixed_size()
+
+    def is_bounded_stack(self, t: Message) -> bool:
+        """Returns True if option c.bounded_stack is set for the proto of given message."""
+        return t.bound.get_option_as_bool_or_raise("c.bounded_stack")
+
+    def has_bounded_stack(self, t: Message) -> bool:
+        """Returns True if the encoder and decoders of given message run without
+        recursion, in stack of the fixed bound BP_STACK_USAGE_BOUND, that is, it's in
+        fixed size, and either encoded by a copy plan, or by direct_codec."""
+        if not t.is_fixed_size():
+            return False
+        return self.is_copy_plan(t) or self.is_direct_codec(t)
+
+    def is_ahead_plan(self, t: Message) -> bool:
+        """Returns True if given message is decoded by a copy plan once the ahead flags
+        in the buffer match current version's, that is, it has_copy_plan but is not in
+        fixed size. Other versions are decoded by the processors."""
+        return self.has_copy_plan(t) and not t.is_fixed_size()
+
+    def format_bp_trace(self, t: Message, hook: str, is_encode: bool, size: str) -> str:
+        """Formats a call of instrumentation hook BP_TRACE_BEGIN or BP_TRACE_END in the
+        encoder or decoder of given message, see bitproto.h."""
+        name = self.format_message_name(t)
+        direction = "BP_TRACE_ENCODE" if is_encode else "BP_TRACE_DECODE"
+        return f'BP_TRACE_{hook}("{name}", {direction}, {size});'
+
+    def format_bp_plan_name(self, t: Message) -> str:
         message_name = self.format_message_name(t)
-        return f"BpFieldDescriptorsInit{message_name}"
+        return f"{self.bp_descriptor_name_prefix()}Plan{message_name}"
+
+    def format_bp_plan_ops(self, t: Message, big_endian: bool = False) -> List[str]:
+        """Formats the ops of the copy plan of given message, see struct BpPlanOp.
+        Nested messages and arrays are flattened. Elements of an array of single types
+        share an op, so do the fields of a memcpy run, see bitproto.layout.memcpy_runs.
+        For big-endian hosts, runs are kept only if bitproto.layout.is_byte_order_free,
+        the integers in others are copied by their own ops to be swapped.
+        The ahead flags of extensible types are skipped, see is_ahead_plan.
+        """
+        ops: List[str] = []
+        self.format_bp_plan_ops_of_message(t, t, "", [0], ops, big_endian)
+        return ops
+
+    def format_bp_plan_call(
+        self, t: Message, data: str, s: str, is_encode: bool
+    ) -> str:
+        """Formats the call to run the copy plan of given message, for the message at
+        data and the buffer s."""
+        plan, n = self.format_bp_plan_and_length(t)
+        if is_encode:
+            return f"BpEncodePlan({plan}, {n}, {t.nbits()}, {data}, {s});"
+        return f"BpDecodePlan({plan}, {n}, {data}, {s});"
+
+    def format_bp_plan_batch_call(
+        self, t: Message, ms: str, s: str, nbytes: str, count: str
+    ) -> str:
+        """Formats the call to decode count messages from the buffer s, each in nbytes,
+        to the array of structs ms, by the copy plan of given message."""
+        plan, n = self.format_bp_plan_and_length(t)
+        size = self.format_sizeof(self.format_message_type(t))
+        return (
+            f"BpDecodePlanBatch({plan}, {n}, (void *){ms}, {size}, {s}, {nbytes}, "
+            f"{count});"
+        )
+
+    def format_bp_plan_decoder(self, t: Message, data: str) -> str:
+        """Formats the plan decoder to decode the message at data incrementally."""
+        plan, n = self.format_bp_plan_and_length(t)
+        return f"BpPlanDecoder({plan}, {n}, {t.nbits()}, {data})"
+
+    def format_bp_plan_and_length(self, t: Message) -> Tuple[str, str]:
+        """Returns the copy plan of given message and the number of ops in it.
+        The plan of a message without fields is empty, NULL is used instead.
+        The number differs on big-endian hosts if some runs are not kept."""
+        if t.nfields() == 0:
+            return "NULL", "0"
+        n = len(self.format_bp_plan_ops(t))
+        n_big_endian = len(self.format_bp_plan_ops(t, big_endian=True))
+        plan = self.format_bp_plan_name(t)
+        if n == n_big_endian:
+            return plan, str(n)
+        return plan, f"(BP_BIG_ENDIAN ? {n_big_endian} : {n})"
+
+    def format_bp_ahead_checks_name(self, t: Message) -> str:
+        message_name = self.format_message_name(t)
+        return f"{self.bp_descriptor_name_prefix()}Aheads{message_name}"
+
+    def format_bp_ahead_checks(self, t: Message) -> List[str]:
+        """Formats the ahead flags in the layout of current version of given message,
+        see struct BpAheadCheck. They are the ones the op-mode decoder checks."""
+        ops: List[Tuple[str, int, int, int]] = []
+        self.op_mode_normalizer_ops(t, ops, [0], [0])
+        return [f"BpAheadCheck({p}, {v})" for op, _, p, v in ops if op == "begin"]
+
+    def format_bp_ahead_plan_condition(self, t: Message, s: str) -> str:
+        """Formats the condition to decode given message by its copy plan from the
+        buffer s, see is_ahead_plan."""
+        name = self.format_bp_ahead_checks_name(t)
+        n = len(self.format_bp_ahead_checks(t))
+        return f"BpMatchAheads({name}, {n}, {s})"
+
+    def format_bp_plan_op(
+        self,
+        root: Message,
+        member: str,
+        i: int,
+        nbits: int,
+        count: int = 1,
+        size: str = "0",
+        sign: bool = False,
+    ) -> str:
+        """Formats an op of the copy plan of message root, for the member at given
+        member designator, e.g. `flight.pose.yaw` or `propellers[1].id`."""
+        offset = f"offsetof({self.format_message_type(root)}, {member})"
+        return f"BpPlanOp({offset}, {i}, {nbits}, {count}, {size}, {int(sign)})"
+
+    def format_bp_plan_ops_of_type(
+        self,
+        root: Message,
+        t: Type,
+        member: str,
+        i: List[int],
+        ops: List[str],
+        big_endian: bool,
+    ) -> None:
+        t_ = t.type if isinstance(t, Alias) else t
+        if isinstance(t_, Message):
+            self.format_bp_plan_ops_of_message(root, t_, member, i, ops, big_endian)
+        elif isinstance(t_, Array):
+            self.format_bp_plan_ops_of_array(root, t_, member, i, ops, big_endian)
+        else:
+            nbits = t.nbits()
+            size = self.format_sizeof(self.format_type(t))
+            sign = isinstance(t_, Int) and not is_nbits_standard(nbits)
+            ops.append(self.format_bp_plan_op(root, member, i[0], nbits, 1, size, sign))
+            i[0] += nbits
+
+    def format_bp_plan_ops_of_message(
+        self,
+        root: Message,
+        t: Message,
+        member: str,
+        i: List[int],
+        ops: List[str],
+        big_endian: bool,
+    ) -> None:
+        runs = {run[0].number: run for run in memcpy_runs(t)} if i[0] % 8 == 0 else {}
+        if t.extensible:
+            i[0] += t.ahead_nbits()  # Skips the ahead flag, checked before the plan.
+        if big_endian:
+            runs = {
+                number: run
+                for number, run in runs.items()
+                if all(is_byte_order_free(f.type) for f in run)
+            }
+        n = 0  # Number of fields left to skip, copied by a run already.
+        for field in t.sorted_fields():
+            if n > 0:
+                n -= 1
+                continue
+            field_name = self.format_message_field_name(field)
+            member_ = f"{member}.{field_name}" if member else field_name
+            run = runs.get(field.number)
+            if run is not None:
+                nbits = sum(f.type.nbits() for f in run)
+                ops.append(self.format_bp_plan_op(root, member_, i[0], nbits))
+                i[0] += nbits
+                n = len(run) - 1
+                continue
+            self.format_bp_plan_ops_of_type(
+                root, self.field_type(field), member_, i, ops, big_endian
+            )
+
+    def format_bp_plan_ops_of_array(
+        self,
+        root: Message,
+        t: Array,
+        member: str,
+        i: List[int],
+        ops: List[str],
+        big_endian: bool,
+    ) -> None:
+        element_type = t.element_type
+        t_ = element_type.type if isinstance(element_type, Alias) else element_type
+        memcpy = is_memcpy_type(t) and (not big_endian or is_byte_order_free(t))
+        if t.extensible:
+            i[0] += t.ahead_nbits()
+        if i[0] % 8 == 0 and memcpy:
+            ops.append(self.format_bp_plan_op(root, member, i[0], t.nbits()))
+            i[0] += t.nbits()
+        elif isinstance(t_, (Message, Array)):
+            for k in range(t.cap):
+                member_ = f"{member}[{k}]"
+                self.format_bp_plan_ops_of_type(
+                    root, element_type, member_, i, ops, big_endian
+                )
+        else:
+            nbits = element_type.nbits()
+            size = self.format_sizeof(self.format_type(element_type))
+            sign = isinstance(t_, Int) and not is_nbits_standard(nbits)
+            ops.append(
+                self.format_bp_plan_op(root, member, i[0], nbits, t.cap, size, sign)
+            )
+            i[0] += nbits * t.cap
+
+    def format_bp_type_processor(self, name: str, d: Optional[Definition]) -> str:
+        """Formats the processor of a bp type in descriptors. Descriptors generated
+        with split processors are only used for json formatting, and the processors
+        are called directly instead, the processor is NULL to let linkers drop the
+        unused direction."""
+        if isinstance(d, BoundDefinition) and self.is_split_processors(d):
+            return "NULL"
+        return name
+
+    def format_bp_split_processor_call(
+        self, t: Type, d: Definition, data: str, is_encode: bool
+    ) -> str:
+        """Formats the statement encoding or decoding the value of type t at address
+        data, with the direction-specific library functions or processors, which are
+        the processors of both directions if not split.
+        The definition d is the message field or alias the type belongs to.
+        """
+        nbits = self.format_int_value(t.nbits())
+        if isinstance(t, Range):
+            size = self.format_sizeof(self.format_type(t))
+            function = "BpEncodeRange" if is_encode else "BpDecodeRange"
+            lo = self.format_bp_range_lo(t)
+            return f"{function}({size}, {nbits}, {lo}, ctx, {data});"
+        if isinstance(t, Fixed):
+            function = "BpEncodeFixed" if is_encode else "BpDecodeFixed"
+            arguments = self.format_bp_fixed_arguments(t)
+            return f"{function}({arguments}, ctx, {data});"
+        if isinstance(t, Int) and not is_encode:
+            size = self.format_sizeof(self.format_int_type(t))
+            return f"BpDecodeInt({size}, {nbits}, ctx, {data});"
+        if isinstance(t, (Bool, Uint, Enum, Float)) and not is_encode:
+            if not is_nbits_standard(t.nbits()) or t.nbits() > 8:
+                # Clears the bits above nbits, so no bits in the member are stale,
+                # and swaps the bytes on big-endian hosts.
+                size = self.format_sizeof(self.format_type(t))
+                return f"BpDecodeUint({size}, {nbits}, ctx, {data});"
+        if isinstance(t, (Int, Uint, Enum, Float)) and is_encode and t.nbits() > 8:
+            # Integers of more than one byte are swapped on big-endian hosts.
+            size = self.format_sizeof(self.format_type(t))
+            return f"BpEncodeIntegers({size}, {nbits}, 1, ctx, {data});"
+        if isinstance(t, (Bool, Int, Uint, Byte, Enum)):
+            function = "BpEncodeBaseType" if is_encode else "BpDecodeBaseType"
+            return f"{function}({nbits}, ctx, {data});"
+        if isinstance(t, Array):
+            # Split if the message or alias the array belongs to is split.
+            owner = d.message if isinstance(d, MessageField) else d
+            direction = self.bp_processor_direction(
+                cast_or_raise(BoundDefinition, owner), is_encode
+            )
+            name = self.format_bp_array_processor_name(t, d, direction)
+        elif isinstance(t, Alias):
+            direction = self.bp_processor_direction(t, is_encode)
+            name = self.format_bp_alias_processor_name(t, direction)
+        elif isinstance(t, Message):
+            direction = self.bp_processor_direction(t, is_encode)
+            name = self.format_bp_message_processor_name(t, direction)
+        else:
+            raise InternalError("format_bp_split_processor_call got unexpected type")
+        return f"{name}({data}, ctx);"
+
+    def format_bp_split_dispatch(self, encoder: str, decoder: str) -> List[str]:
+        """Formats the statements of a processor of both directions, which calls
+        the encoder or the decoder generated with option c.split_processors."""
+        return [
+            "if (ctx->is_encode) {",
+            f"    {encoder}(data, ctx);",
+            "} else {",
+            f"    {decoder}(data, ctx);",
+            "}",
+        ]
+
+    def bp_descriptor_name_prefix(self) -> str:
+        return "BpXXX"
+
+    def format_bp_message_field_descriptors_name(self, t: Message) -> str:
+        message_name = self.format_message_name(t)
+        prefix = self.bp_descriptor_name_prefix()
+        return f"{prefix}FieldDescriptors{message_name}"
+
+    def format_bp_message_descriptor_name(self, t: Message) -> str:
+        message_name = self.format_message_name(t)
+        prefix = self.bp_descriptor_name_prefix()
+        return f"{prefix}MessageDescriptor{message_name}"
+
+    def format_bp_alias_descriptor_name(self, t: Alias) -> str:
+        alias_name = self.format_alias_name(t)
+        prefix = self.bp_descriptor_name_prefix()
+        return f"{prefix}AliasDescriptor{alias_name}"
+
+    def format_bp_array_descriptor_name(self, t: Array, d: Definition) -> str:
+        if isinstance(d, MessageField):
+            message_name = self.format_message_name(d.message)
+            prefix = self.bp_descriptor_name_prefix()
+            return f"{prefix}ArrayDescriptor{message_name}{d.number}"
+        if isinstance(d, Alias):
+            alias_name = self.format_alias_name(d)
+            prefix = self.bp_descriptor_name_prefix()
+            return f"{prefix}ArrayDescriptor{alias_name}"
+        raise InternalError(
+            "format_bp_array_descriptor_name got unexpected defintion type"
+        )
+
+    def format_offsetof(self, t: Message, field: MessageField) -> str:
+        message_type = self.format_message_type(t)
+        field_name = self.format_message_field_name(field)
+        return f"offsetof({message_type}, {field_name})"
 
     def format_bp_message_json_formatter_name(self, t: Message) -> str:
         message_name = self.format_message_name(t)
@@ -305,6 +1209,74 @@ class CFormatter(Formatter):
         prefix = self.bp_json_formatter_name_prefix()
         return f"{prefix}Array{alias_name}"
 
+    def format_bp_message_json_parser_name(self, t: Message) -> str:
+        message_name = self.format_message_name(t)
+        prefix = self.bp_json_parser_name_prefix()
+        return f"{prefix}{message_name}"
+
+    def format_bp_alias_json_parser_name(self, t: Alias) -> str:
+        alias_name = self.format_alias_name(t)
+        prefix = self.bp_json_parser_name_prefix()
+        return f"{prefix}{alias_name}"
+
+    def format_bp_array_json_parser_name(self, t: Array, d: Definition) -> str:
+        prefix = self.bp_json_parser_name_prefix()
+        if isinstance(d, MessageField):
+            message_name = self.format_message_name(d.message)
+            return f"{prefix}Array{message_name}{d.number}"
+        if isinstance(d, Alias):
+            alias_name = self.format_alias_name(d)
+            return f"{prefix}Array{alias_name}"
+        raise InternalError(
+            "format_bp_array_json_parser_name got unexpected defintion type"
+        )
+
+    def format_bp_json_parse_call(self, t: Type, d: Definition, data: str) -> str:
+        """Formats the statement parsing json into the value of type t at address
+        data. The definition d is the message field or alias the type belongs to.
+        A range is parsed as the integer declared.
+        """
+        if isinstance(t, Range):
+            t = t.type
+        if isinstance(t, (Bool, Int, Uint, Byte, Enum, Float, Fixed)):
+            flag = self.format_bp_type_flag(t)
+            nbits = self.format_int_value(t.nbits())
+            return f"BpJsonParseBaseType({flag}, {nbits}, ctx, {data});"
+        if isinstance(t, Array):
+            name = self.format_bp_array_json_parser_name(t, d)
+        elif isinstance(t, Alias):
+            name = self.format_bp_alias_json_parser_name(t)
+        elif isinstance(t, Message):
+            name = self.format_bp_message_json_parser_name(t)
+        else:
+            raise InternalError("format_bp_json_parse_call got unexpected type")
+        return f"{name}({data}, ctx);"
+
+    def format_bp_json_key_switch(
+        self, items: List[Tuple[str, str]], key: str, n: str
+    ) -> List[str]:
+        """Formats a switch on the length n of the json key, looking up given pairs
+        of field names and statements to parse their values. A matched field
+        continues the enclosing loop, and an unknown key breaks out of the switch.
+        """
+        by_length: Dict[int, List[Tuple[str, str]]] = {}
+        for name, statement in items:
+            by_length.setdefault(len(name.encode()), []).append((name, statement))
+        if not by_length:
+            return []
+        lines = [f"switch ({n}) {{"]
+        for length in sorted(by_length):
+            lines.append(f"    case {length}:")
+            for name, statement in by_length[length]:
+                literal = self.format_str_value(name)
+                lines.append(f"        if (memcmp({key}, {literal}, {length}) == 0) {{")
+                lines.append(f"            {statement}")
+                lines.append("            continue;")
+                lines.append("        }")
+            lines.append("        break;")
+        lines.append("}")
+        return lines
+
     ###################
     # Optimization Mode.
     ###################
@@ -313,6 +1285,91 @@ class CFormatter(Formatter):
     def format_op_mode_endecoder_message_var(self) -> str:
         return "(*m)"
 
+    @override(Formatter)
+    def format_op_mode_oneof_variant_chain(self, v: OneofVariant) -> str:
+        """Variants of a oneof are members of the union u in C."""
+        return "(*m).u." + self.format_oneof_variant_name(v)
+
+    def format_op_mode_byte_index(self, t: Type, fi: int) -> str:
+        """Formats the index of the fith byte of a value of single type t in memory,
+        counting from the least significant one, which is reversed on big-endian
+        hosts for integers of more than one byte."""
+        size = c_sizeof(t)[0]
+        if size == 1:
+            return str(fi)
+        return f"BP_BIG_ENDIAN ? {size - 1 - fi} : {fi}"
+
+    def format_op_mode_value_byte(self, chain: str, t: Type, fi: int) -> str:
+        """Formats the fith byte of the value of single type t at chain, counting from
+        the least significant one. For a range, chain is the expression of the offset
+        value, see format_op_mode_range_offset, which is shifted instead."""
+        if isinstance(t, Range):
+            shift = f" >> {fi * 8}" if fi else ""
+            return f"(unsigned char)({chain}{shift})"
+        fi_s = self.format_op_mode_byte_index(t, fi)
+        return f"((unsigned char *)&({chain}))[{fi_s}]"
+
+    @override(Formatter)
+    def format_op_mode_range_offset(self, t: Range, chain: str) -> str:
+        """Implements format_op_mode_range_offset for C.
+        Generated C expression like:
+
+            ((uint64_t)((*m).altitude) - 1000ULL)
+
+        """
+        if t.lo == 0:
+            return f"(uint64_t)({chain})"
+        return f"((uint64_t)({chain}) - {self.format_bp_range_lo(t)})"
+
+    @override(Formatter)
+    def format_op_mode_real_block(
+        self, t: Type, chain: str, w: Uint, is_encode: bool, body: List[str]
+    ) -> List[str]:
+        """Implements format_op_mode_real_block for C.
+        The bits of a float32 are copied from and to w by memcpy, a fixed-point value
+        is scaled and rounded half away from zero inline, the same as BpEncodeFixed.
+        Generated C statements like:
+
+            {
+                double r = (double)((*m).temperature) * 256.0;
+                uint16_t w = (uint16_t)(r >= 0 ? (uint64_t)(r + 0.5) : r < 0 ? (uint64_t)(int64_t)(r - 0.5) : 0);
+                ...
+            }
+            {
+                uint16_t w = 0;
+                ...
+                (*m).temperature = (float)((double)(int64_t)(((uint64_t)w ^ 32768ULL) - 32768ULL) * 0.00390625);
+            }
+
+        """
+        t_ = t.type if isinstance(t, Alias) else t
+        type_w = self.format_uint_type(w)
+        l = ["{"]
+        if isinstance(t_, Float):
+            l.append(f"    {type_w} w{'' if is_encode else ' = 0'};")
+            if is_encode:
+                l.append(f"    memcpy(&w, &({chain}), 4);")
+        elif is_encode:
+            scale = self.format_real_value(cast_or_raise(Fixed, t_).scale())
+            l.append(f"    double r = (double)({chain}) * {scale};")
+            w_ = "r >= 0 ? (uint64_t)(r + 0.5) : r < 0 ? (uint64_t)(int64_t)(r - 0.5) : 0"
+            l.append(f"    {type_w} w = ({type_w})({w_});")
+        else:
+            l.append(f"    {type_w} w = 0;")
+        l.extend("    " + line for line in body)
+        if isinstance(t_, Float) and not is_encode:
+            l.append(f"    memcpy(&({chain}), &w, 4);")
+        elif isinstance(t_, Fixed) and not is_encode:
+            unit = self.format_real_value(t_.unit())
+            v = "(double)w"
+            if t_.signed:
+                m = 1 << (t_.nbits() - 1)
+                v = f"(double)(int64_t)(((uint64_t)w ^ {m}ULL) - {m}ULL)"
+            type_s = self.format_fixed_type(t_)
+            l.append(f"    {chain} = ({type_s})({v} * {unit});")
+        l.append("}")
+        return l
+
     @override(Formatter)
     def format_op_mode_encoder_item(
         self, chain: str, t: Type, si: int, fi: int, shift: int, mask: int, r: int
@@ -325,7 +1382,8 @@ class CFormatter(Formatter):
         """
         assign = "=" if r == 0 else "|="
         shift_s = self.format_op_mode_smart_shift(shift)
-        return f"s[{si}] {assign} (((unsigned char *)&({chain}))[{fi}] {shift_s}) & {mask};"
+        byte = self.format_op_mode_value_byte(chain, t, fi)
+        return f"s[{self.format_op_mode_buffer_index(si)}] {assign} ({byte} {shift_s}) & {mask};"
 
     @override(Formatter)
     def format_op_mode_decoder_item(
@@ -339,7 +1397,198 @@ class CFormatter(Formatter):
         """
         assign = "=" if r == 0 else "|="
         shift_s = self.format_op_mode_smart_shift(shift)
-        return f"((unsigned char *)&({chain}))[{fi}] {assign} (s[{si}] {shift_s}) & {mask};"
+        fi_s = self.format_op_mode_byte_index(t, fi)
+        return f"((unsigned char *)&({chain}))[{fi_s}] {assign} (s[{self.format_op_mode_buffer_index(si)}] {shift_s}) & {mask};"
+
+    @override(Formatter)
+    def format_op_mode_word_encoder_items(
+        self, chain: str, t: Type, si: int, o: int, n: int
+    ) -> List[str]:
+        """Implements format_op_mode_word_encoder_items for C.
+        Generated C statements like:
+
+            s[1] |= (unsigned char)((uint64_t)((*m).id) << 3);
+            s[2] = (unsigned char)((uint64_t)((*m).id) << 3 >> 8);
+            s[3] = (unsigned char)((uint64_t)((*m).id) << 3 >> 16) & 7;
+
+        Compilers merge the stores into a single one.
+        """
+        k = self.op_mode_word_byte_count(o, n)
+        word = f"(uint64_t)({chain})" + (f" << {o}" if o else "")
+        l: List[str] = []
+        for b in range(k):
+            assign = "|=" if b == 0 and o else "="
+            rshift = f" >> {b * 8}" if b else ""
+            item = f"s[{self.format_op_mode_buffer_index(si + b)}] {assign} (unsigned char)({word}{rshift})"
+            nbits_last = o + n - (k - 1) * 8
+            if b == k - 1 and nbits_last < 8:
+                item += f" & {(1 << nbits_last) - 1}"
+            l.append(item + ";")
+        return l
+
+    @override(Formatter)
+    def format_op_mode_word_decoder_items(
+        self, chain: str, t: Type, si: int, o: int, n: int
+    ) -> List[str]:
+        """Implements format_op_mode_word_decoder_items for C.
+        Generated C statement like:
+
+            (*m).id = (uint16_t)((((uint64_t)s[1] | (uint64_t)s[2] << 8 | (uint64_t)s[3] << 16) >> 3) & 1023);
+
+        Compilers merge the loads into a single one.
+        """
+        k = self.op_mode_word_byte_count(o, n)
+        items = [f"(uint64_t)s[{self.format_op_mode_buffer_index(si)}]"]
+        items.extend(f"(uint64_t)s[{self.format_op_mode_buffer_index(si + b)}] << {b * 8}" for b in range(1, k))
+        word = "(" + " | ".join(items) + ")"
+        if o:
+            word = f"({word} >> {o})"
+        if n < 64:
+            word = f"({word} & {(1 << n) - 1})"
+        type_s = self.format_type(t)
+        return [f"{chain} = ({type_s}){word};"]
+
+    @override(Formatter)
+    def format_op_mode_array_loop(self, n: int, body: List[str]) -> List[str]:
+        """Implements format_op_mode_array_loop for C.
+        Generated C statements like:
+
+            for (int k = 0; k < 33; k++) {
+                s[3 + k] = (((unsigned char *)&((*m).bytes[k]))[0] ) & 255;
+            }
+
+        Compilers vectorize the loop on byte aligned copies.
+        """
+        l = [f"for (int k = 0; k < {n}; k++) {{"]
+        l.extend(self.indent_character() * 4 + line for line in body)
+        l.append("}")
+        return l
+
+    @override(Formatter)
+    def format_op_mode_bool_array_loop(
+        self, t: Array, chain: str, is_encode: bool, i: int, loop: List[str]
+    ) -> List[str]:
+        """Implements format_op_mode_bool_array_loop for C.
+        Generated C statements like:
+
+            for (int k = 0; k < 16; k++) {
+                unsigned char b = BpOpPackBools(&(*m).faults[8 * k]);
+                s[k] |= (unsigned char)(b << 3);
+                s[1 + k] = (unsigned char)(b >> 5);
+            }
+
+        The 8 bools of an iteration are packed into (unpacked from) a byte by the
+        multiply-and-mask helpers, see BlockBoolArrayHelperFunctionsOpMode.
+        """
+        n, base, r = t.cap // 8, i // 8, i % 8
+        s0 = f"s[{self.format_op_mode_loop_index(base, 1)}]"
+        s1 = f"s[{self.format_op_mode_loop_index(base + 1, 1)}]"
+        e = "&" + self.format_op_mode_field_name_chain_array(chain, "8 * k")
+        body: List[str]
+        if is_encode and r == 0:
+            body = [f"{s0} = BpOpPackBools({e});"]
+        elif is_encode:
+            body = [
+                f"unsigned char b = BpOpPackBools({e});",
+                f"{s0} |= (unsigned char)(b << {r});",
+                f"{s1} = (unsigned char)(b >> {8 - r});",
+            ]
+        elif r == 0:
+            body = [f"BpOpUnpackBools({e}, {s0});"]
+        else:
+            b = f"(unsigned char)(({s0} >> {r}) | ({s1} << {8 - r}))"
+            body = [f"BpOpUnpackBools({e}, {b});"]
+        return self.format_op_mode_array_loop(n, body)
+
+    @override(Formatter)
+    def op_mode_supports_memcpy(self) -> bool:
+        return True
+
+    @override(Formatter)
+    def format_op_mode_memcpy(
+        self,
+        chain: str,
+        t: Message,
+        field: MessageField,
+        si: int,
+        n: int,
+        is_encode: bool,
+        fallback: List[str],
+    ) -> List[str]:
+        """Implements format_op_mode_memcpy for C.
+        Generated C statement like:
+
+            memcpy(&s[1], (const unsigned char *)&((*m)) + offsetof(struct A, b), 12);
+
+        The address is taken from the message instead of the field, since the copy
+        spans the following members. The fallback statements are used instead on
+        big-endian hosts.
+        """
+        buffer = f"&s[{self.format_op_mode_buffer_index(si)}]"
+        member = f"offsetof({self.format_message_type(t)}, {self.format_message_field_name(field)})"
+        if is_encode:
+            statement = f"memcpy({buffer}, (const unsigned char *)&({chain}) + {member}, {n});"
+        else:
+            statement = f"memcpy((unsigned char *)&({chain}) + {member}, {buffer}, {n});"
+        if not fallback:
+            return [statement]
+        return ["#if BP_BIG_ENDIAN", *fallback, "#else", statement, "#endif"]
+
+    def format_op_mode_normalizer_name(self, t: Message) -> str:
+        return f"BpOpNormalize{self.format_message_name(t)}"
+
+    def format_op_mode_current_decoder_name(self, t: Message) -> str:
+        return f"BpOpDecodeCurrent{self.format_message_name(t)}"
+
+    @override(Formatter)
+    def format_op_mode_encoder_constant_item(self, si: int, value: int, r: int) -> str:
+        """Implements format_op_mode_encoder_constant_item for C.
+        Generated C statement like:
+
+            s[0] = 250;
+
+        """
+        assign = "=" if r == 0 else "|="
+        return f"s[{si}] {assign} {value};"
+
+    @override(Formatter)
+    def format_op_mode_ahead_check(self, p: int, value: int) -> str:
+        return f"BpOpReadAhead(s, {p}, -1) == {value}"
+
+    @override(Formatter)
+    def format_op_mode_normalizer_copy(self, p: int, n: int) -> List[str]:
+        return [f"BpOpCopyBits(t, {p}, s, i, {n}, n);", f"i += {n};"]
+
+    @override(Formatter)
+    def format_op_mode_normalizer_ahead_begin(
+        self, k: int, p: int, value: int
+    ) -> List[str]:
+        return [
+            f"int i{k} = i;",
+            f"int a{k} = BpOpReadAhead(s, i, n);",
+            f"BpOpWriteAhead(t, {p}, {value});",
+            "i += 16;",
+        ]
+
+    @override(Formatter)
+    def format_op_mode_normalizer_ahead_end(self, k: int, factor: int) -> List[str]:
+        ahead = f"a{k}" if factor == 1 else f"a{k} * {factor}"
+        return [f"if (i{k} + {ahead} >= i) i = i{k} + {ahead};"]
+
+    @override(Formatter)
+    def format_op_mode_patcher_item(
+        self, chain: str, t: Type, si: int, fi: int, shift: int, mask: int
+    ) -> str:
+        """Implements format_op_mode_patcher_item for C.
+        Generated C statement like:
+
+            s[0] = (s[0] & 199) | ((((unsigned char *)&(v))[0] << 3) & 56);
+
+        """
+        shift_s = self.format_op_mode_smart_shift(shift)
+        keep = 255 ^ mask
+        byte = self.format_op_mode_value_byte(chain, t, fi)
+        return f"s[{si}] = (s[{si}] & {keep}) | (({byte} {shift_s}) & {mask});"
 
     @override(Formatter)
     def post_format_op_mode_endecode_single_type(
@@ -352,8 +1601,76 @@ class CFormatter(Formatter):
             t = t.type
         if isinstance(t, Int):
             return self.post_format_op_mode_endecode_int(t, chain, is_encode)
+        if isinstance(t, Range) and not is_encode:
+            return self.post_format_op_mode_decode_range(t, chain)
+        if isinstance(t, Enum) and is_validated_enum(t) and not is_encode:
+            # Checked right after decoded, see option c.validate_enums.
+            return [self.format_bp_enum_check_statement(t, chain, "err")]
         return []
 
+    def op_mode_array_int_element_type(self, t: Array) -> Optional[Int]:
+        """Returns the signed integer element type of given array, which may be aliased.
+        Returns None if the array's element isn't a signed integer.
+        """
+        t_ = t.element_type
+        if isinstance(t_, Alias):
+            t_ = t_.type
+        if isinstance(t_, Int):
+            return t_
+        return None
+
+    @override(Formatter)
+    def op_mode_batch_post_format_array(self, t: Array, is_encode: bool) -> bool:
+        """Arrays of signed integers in non-standard widths handle signs in a batch on decoding."""
+        if is_encode:
+            return False
+        t_ = self.op_mode_array_int_element_type(t)
+        return t_ is not None and t_.nbits() not in {8, 16, 32, 64}
+
+    @override(Formatter)
+    def post_format_op_mode_endecode_array(
+        self, t: Array, chain: str, is_encode: bool
+    ) -> List[str]:
+        """
+        Process signed integer arrays during decoding code generation in optimization mode.
+        The same branchless approach as BpHandleIntArraySignAfterEndecode in the bitproto C lib,
+        the loop is vectorizable by compilers.
+
+        Generated C statement example:
+
+            for (int k = 0; k < 2; k++) (*m).pressures[k] = (int32_t)((int64_t)(((uint64_t)((*m).pressures[k]) & 16777215ULL) ^ 8388608ULL) - 8388608LL);
+        """
+        t_ = self.op_mode_array_int_element_type(t)
+        assert t_ is not None, InternalError("post_format_op_mode_endecode_array")
+        e = f"{chain}[k]"
+        return [f"for (int k = 0; k < {t.cap}; k++) {self.format_op_mode_sign_extension(t_, e)}"]
+
+    def format_op_mode_sign_extension(self, t: Int, chain: str) -> str:
+        """Formats the statement extending the sign bit of a signed integer of a
+        non-standard width just decoded, branchless as ((V & mask) ^ m) - m. The masks
+        are unsigned, e.g. 9223372036854775807ULL for int63, and the bits xored fit
+        into an int64_t, for n < 64, so no literal or conversion is out of range.
+        """
+        n = t.nbits()
+        mask, m = (1 << n) - 1, 1 << (n - 1)
+        v = f"(int64_t)(((uint64_t)({chain}) & {mask}ULL) ^ {m}ULL) - {m}LL"
+        return f"{chain} = ({self.format_type(t)})({v});"
+
+    def post_format_op_mode_decode_range(self, t: Range, chain: str) -> List[str]:
+        """
+        Adds the lower bound of a range to the offset just decoded, the bytes above
+        the bits decoded are cleared by the mask.
+
+        Generated C statement example:
+
+            (*m).altitude = (uint16_t)(((uint64_t)((*m).altitude) & 32767) + 1000ULL);
+        """
+        type_s = self.format_type(t)
+        v = f"((uint64_t)({chain}) & {(1 << t.nbits()) - 1})"
+        if t.lo != 0:
+            v = f"({v} + {self.format_bp_range_lo(t)})"
+        return [f"{chain} = ({type_s}){v};"]
+
     def post_format_op_mode_endecode_int(
         self, t: Int, chain: str, is_encode: bool
     ) -> List[str]:
@@ -362,33 +1679,20 @@ class CFormatter(Formatter):
 
         Generated C statement example:
 
-            if (((*m).pressure_sensor.pressure >> 23) & 1) (*m).pressure_sensor.pressure |= -16777216;
+            (*m).pressure_sensor.pressure = (int32_t)((int64_t)(((uint64_t)((*m).pressure_sensor.pressure) & 16777215ULL) ^ 8388608ULL) - 8388608LL);
         """
         if is_encode:
             return []
 
         # Signed integers processing is only about decoding
-        n = t.nbits()
-
-        if n in {8, 16, 32, 64}:
+        if t.nbits() in {8, 16, 32, 64}:
             # No need to do additional actions
             # int8/16/32/64 signed integers' sign bit is already on the highest bit position.
             return []
 
-        m = ~((1 << n) - 1)
-        mask = f"{m}"
-
-        if n == 63:
-            # Avoid this compiler error for mask == -9223372036854775808;
-            # warning: integer literal is too large to be represented in a signed integer type,
-            # interpreting as unsigned [-Wimplicitly-unsigned-literal]
-            mask = f"(-9223372036854775807 - 1)"
-
         # For a signed integer e.g. 16777205, the most concise approach should be: 16777205 << 24 >> 24,
-        # this shifts the 24th bit to the highest bit position, and then shift right again.
-        # By doing an arithmetic right shifting, the leftmost sign bit got propagated, the result is -11.
-        # This way is concise, but may not be portable.
-        # Right shift behavior on negative signed integers is implementation-defined.
-        # Another safe approach is: test the 24th bit at first ((16777205 >> 23) & 1), if it’s 1,
-        # then do a OR operation with a mask,  16777205 |= ~(1<<24 -1) , the result is also -11.
-        return [f"if (({chain} >> {n-1}) & 1) {chain} |= {mask};"]
+        # but right shift behavior on negative signed integers is implementation-defined, and so
+        # is OR-ing a mask like ~(1<<24 - 1) into it, for the mask of int63 is out of the signed
+        # 64-bit literals. Flipping the sign bit unsigned and subtracting it back is safe instead:
+        # ((16777205 ^ 8388608) - 8388608) is also -11.
+        return [self.format_op_mode_sign_extension(t, chain)]
@@ -0,0 +1,288 @@
+"""
+Renderer for C header file for eBPF programs, e.g. XDP filters.
+
+The header is self-contained, built on the optimization mode's statements: the
+decoders and getters are expanded inline, read the frame after a single bounds
+check against data_end, and go through no function pointers, no recursion and no
+loops but over the constant capacity of arrays, for the BPF verifier to accept.
+"""
+
+import re
+from typing import List, Optional
+
+from bitproto._ast import Alias, BoundDefinition, Constant, Enum, Message
+from bitproto.layout import has_validated_enums, is_validated_enum, resolve_alias
+from bitproto.renderer.block import (
+    Block,
+    BlockAheadNotice,
+    BlockBindEnum,
+    BlockBindMessage,
+    BlockBindProto,
+    BlockBoundDefinitionDispatcher,
+    BlockComposition,
+    BlockDeferable,
+)
+from bitproto.renderer.impls.c.formatter import CFormatter as F
+from bitproto.renderer.impls.c.renderer_c import BlockBoolArrayHelperFunctionsOpMode
+from bitproto.renderer.impls.c.renderer_h import (
+    BlockAliasDef,
+    BlockConstant,
+    BlockDefineMacroOpMode,
+    BlockEnumDef,
+    BlockEnumFieldList,
+    BlockMessageDef,
+    BlockMessageFieldAccessorBase,
+    BlockProtoDocstring,
+)
+from bitproto.renderer.renderer import Renderer
+from bitproto.utils import override, snake_case
+
+
+def format_bpf_line(line: str) -> str:
+    """Rewrites a line of the optimization mode for BPF programs, where there's no
+    libc: functions are always inlined, and the copies are compiler builtins."""
+    line = line.replace("static inline ", "static __always_inline ")
+    line = re.sub(r"\bmemcpy\(", "__builtin_memcpy(", line)
+    return re.sub(r"\boffsetof\(", "__builtin_offsetof(", line)
+
+
+def push_bpf_statements(block: Block[F], l: List[str], indent: int) -> None:
+    """Pushes given statements of the optimization mode at given indent, rewritten
+    by format_bpf_line, except the preprocessor directives, which are unindented."""
+    for line in l:
+        if line.lstrip().startswith("#"):
+            block.push(line.lstrip(), indent=0)
+        else:
+            block.push(format_bpf_line(line), indent=indent)
+
+
+def is_bpf_message(block: Block[F], d: Message) -> bool:
+    """Returns True if the bpf functions are rendered for given message: messages in
+    fixed size, filtered by -F. Messages not in fixed size are normalized by loops
+    over the bits, which the verifier may reject."""
+    if not d.is_fixed_size() or d.nfields() == 0:
+        return False
+    filter_messages = block._get_ctx_or_raise().optimization_mode_filter_messages
+    return not filter_messages or d.name in filter_messages
+
+
+class BlockIncludeGuardBpf(BlockDeferable[F]):
+    def format_proto_macro_name(self) -> str:
+        proto_name = snake_case(self.bound.name).upper()
+        return f"__BITPROTO__{proto_name}_BPF_H__"
+
+    @override(Block)
+    def render(self) -> None:
+        macro_name = self.format_proto_macro_name()
+        self.push(f"#ifndef {macro_name}")
+        self.push(f"#define {macro_name} 1")
+
+    @override(BlockDeferable)
+    def defer(self) -> None:
+        self.push(f"#endif")
+
+
+class BlockIncludeGeneralHeadersBpf(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        # Programs built on vmlinux.h define BP_BPF_NO_LIBC_HEADERS, and the integer
+        # types themselves.
+        self.push("#ifndef BP_BPF_NO_LIBC_HEADERS")
+        if self.formatter.has_large_messages(self.bound):
+            self.push("#include <limits.h>")
+        self.push("#include <stdbool.h>")
+        self.push("#include <stdint.h>")
+        self.push("#endif")
+        self.push_empty_line()
+        # The same to libbpf's bpf_helpers.h.
+        self.push("#ifndef __always_inline")
+        self.push("#define __always_inline inline __attribute__((always_inline))")
+        self.push("#endif")
+
+
+class BlockIncludeChildProtoHeaderBpf(BlockBindProto[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f'#include "{self.d.name}_bp_bpf.h"')
+
+
+class BlockImportListBpf(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockIncludeChildProtoHeaderBpf(proto, name=name)
+            for name, proto in self.bound.protos(recursive=False)
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockEnumValuesTableBpf(BlockBindEnum[F]):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.has_enum_values_table(self.d):
+            return
+        self.push_comment(f"Bitmap of values declared in enum {self.enum_name}")
+        self.push(f"static {self.formatter.format_bp_enum_values_table(self.d)}")
+
+
+class BlockEnumDefsBpf(BlockBindEnum[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockEnumDef(self.d),
+            BlockEnumFieldList(self.d),
+            BlockEnumValuesTableBpf(self.d),
+        ]
+
+
+class BlockDataStructuresListBpf(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if isinstance(d, Alias):
+            return BlockAliasDef(d)
+        if isinstance(d, Constant):
+            return BlockConstant(d)
+        if isinstance(d, Enum):
+            return BlockEnumDefsBpf(d)
+        if isinstance(d, Message):
+            return BlockMessageDef(d)
+        return None
+
+
+class BlockHelperFunctionsBpf(Block[F]):
+    """The bool array helpers of the optimization mode, always inlined."""
+
+    @override(Block)
+    def render(self) -> None:
+        block = BlockBoolArrayHelperFunctionsOpMode()
+        block._render_with_ctx(self._get_ctx_or_raise())
+        push_bpf_statements(self, block._collect().splitlines(), 0)
+
+
+class BlockMessageFieldGetterBpf(BlockMessageFieldAccessorBase):
+    @override(Block)
+    def render(self) -> None:
+        # Index of the byte after the last one the field occupies.
+        end = (self.i + max(self.t.nbits(), 1) + 7) // 8
+        self.push_comment(
+            f"Get field {self.field_path} of struct {self.message_name} from the frame "
+            "at data, bounded by data_end."
+        )
+        self.push_comment(
+            "Returns BP_ERR_SHORT_INPUT if the frame ends before the field."
+        )
+        self.push(
+            f"static __always_inline int BpBpfGet{self.accessor_name_suffix}"
+            f"(const void *data, const void *data_end, {self.field_type} *p) {{"
+        )
+        self.push("const unsigned char *s = (const unsigned char *)data;", indent=4)
+        self.push(
+            f"if (s + {end} > (const unsigned char *)data_end) "
+            "return BP_ERR_SHORT_INPUT;",
+            indent=4,
+        )
+        self.push(f"{self.field_type} v = 0;", indent=4)
+        # Getters return the value as it is, enums are not validated here.
+        check = ""
+        t = resolve_alias(self.t)
+        if is_validated_enum(t):
+            check = self.formatter.format_bp_enum_check_statement(t, "v", "err")
+        lines = self.formatter.format_op_mode_getter(self.t, "v", self.i)
+        push_bpf_statements(self, [line for line in lines if line != check], 4)
+        self.push("*p = v;", indent=4)
+        self.push("return 0;", indent=4)
+        self.push("}")
+
+
+class BlockMessageDecoderBpf(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        size = self.message_size_constant_name
+        message_type = self.formatter.format_message_type(self.d)
+        self.push_comment(
+            f"Decode struct {self.message_name} from the frame at data, bounded by "
+            "data_end, e.g. of struct xdp_md."
+        )
+        self.push_comment(f"Returns BP_ERR_SHORT_INPUT if the frame is shorter than {size}.")
+        self.push(
+            f"static __always_inline int Decode{self.message_name}Bpf({message_type} *m, "
+            "const void *data, const void *data_end) {"
+        )
+        self.push("const unsigned char *s = (const unsigned char *)data;", indent=4)
+        self.push(
+            f"if (s + {size} > (const unsigned char *)data_end) "
+            "return BP_ERR_SHORT_INPUT;",
+            indent=4,
+        )
+        if has_validated_enums(self.d):
+            # Sets to BP_ERR_ENUM by the statements checking enums decoded.
+            self.push("int err = 0;", indent=4)
+        l = self.formatter.format_op_mode_decode_message(self.d)
+        push_bpf_statements(self, l, 4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageFunctionsBpf(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = [BlockMessageDecoderBpf(self.d)]
+        for path, t, i in self.formatter.op_mode_accessor_fields(self.d):
+            b.append(BlockMessageFieldGetterBpf(self.d, path=path, t=t, i=i))
+        return b
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
+class BlockFunctionsListBpf(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if isinstance(d, Message) and is_bpf_message(self, d):
+            return BlockMessageFunctionsBpf(d)
+        return None
+
+
+class BlockListBpf(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockAheadNotice(),
+            BlockProtoDocstring(self.bound),
+            BlockIncludeGuardBpf(),
+            BlockIncludeGeneralHeadersBpf(),
+            BlockImportListBpf(),
+            BlockDefineMacroOpMode(),
+            BlockDataStructuresListBpf(),
+            BlockHelperFunctionsBpf(),
+            BlockFunctionsListBpf(),
+        ]
+
+
+class RendererCBpf(Renderer[F]):
+    """Renderer for C language (header for eBPF programs).
+    It's rendered in place of the c and header files, always in optimization mode."""
+
+    @override(Renderer)
+    def language_name(self) -> str:
+        return "c"
+
+    @override(Renderer)
+    def file_extension(self) -> str:
+        return "_bpf.h"
+
+    @override(Renderer)
+    def support_optimization(self) -> bool:
+        return True
+
+    @override(Renderer)
+    def formatter(self) -> F:
+        return F()
+
+    @override(Renderer)
+    def block(self) -> Block[F]:
+        return BlockListBpf()
@@ -2,22 +2,45 @@
 Renderer for C file.
 """
 
-from typing import List, Optional
+import re
+from dataclasses import replace
+from typing import Any, Callable, List, Optional, Union
 
 from bitproto._ast import (
     Alias,
     Array,
+    Bool,
     BoundDefinition,
+    Byte,
     Definition,
+    Enum,
+    Fixed,
+    Float,
+    Int,
     Message,
     MessageField,
+    Oneof,
+    OneofVariant,
+    Proto,
+    Range,
+    Type,
+    Uint,
+)
+from bitproto.layout import (
+    has_validated_enums,
+    is_byte_order_free,
+    is_memcpy_type,
+    is_nbits_standard,
+    is_validated_enum,
 )
 from bitproto.renderer.block import (
     Block,
     BlockAheadNotice,
     BlockBindAlias,
+    BlockBindEnum,
     BlockBindMessage,
     BlockBindMessageField,
+    BlockBindOneof,
     BlockBoundDefinitionDispatcher,
     BlockComposition,
     BlockConditional,
@@ -26,24 +49,88 @@ from bitproto.renderer.block import (
 from bitproto.renderer.impls.c.formatter import CFormatter as F
 from bitproto.renderer.impls.c.renderer_h import (
     BlockAliasJsonFormatterBase,
+    BlockAliasJsonParserBase,
     BlockAliasProcessorBase,
+    BlockAliasSplitProcessorBase,
+    BlockEnumValidatorBase,
+    BlockJsonGuard,
+    BlockMessageBatchDecoderBase,
+    BlockMessageBatchEncoderBase,
+    BlockMessageBoundedDecoderBase,
+    BlockMessageBoundedJsonFormatterBase,
     BlockMessageBpJsonFormatterBase,
+    BlockMessageBpJsonParserBase,
+    BlockMessageCheckedDecoderBase,
+    BlockMessageCheckedEncoderBase,
     BlockMessageDecoderBase,
+    BlockMessageDeltaDecoderBase,
+    BlockMessageDeltaEncoderBase,
     BlockMessageEncoderBase,
-    BlockMessageFieldDescriptorsIniterBase,
+    BlockMessageFramedDecoderBase,
+    BlockMessageFramedEncoderBase,
     BlockMessageJsonFormatterBase,
+    BlockMessageJsonParserBase,
+    BlockMessageMaskedDecoderBase,
+    BlockMessageMmsgBase,
+    BlockMessageHashBase,
+    BlockMessageEqualBase,
+    BlockMessageParallelBatchBase,
     BlockMessageProcessorBase,
+    BlockMessageRingBase,
+    BlockMessageSelfTestBase,
+    BlockMessageSinkEncoderBase,
+    BlockMessageSinkJsonFormatterBase,
+    BlockMessageSplitProcessorBase,
+    BlockMessageStreamDecoderBase,
+    BlockOneofDecoderBase,
+    BlockOneofEncoderBase,
+    BlockFunctionDeclarationsForInternalList,
+    BlockMmsgGuard,
+    BlockParallelGuard,
+    BlockRingGuard,
 )
 from bitproto.renderer.renderer import Renderer
-from bitproto.utils import cached_property, cast_or_raise, override
+from bitproto.utils import cached_property, cast_or_raise, override, pascal_case
+from bitproto.vectors import Vector, message_vectors
+
+
+def is_op_mode_message(block: Block[F], d: Message) -> bool:
+    """Returns True if the encoder and decoders of given message are rendered by the
+    statements of optimization mode: the messages filtered by -F in optimization mode,
+    and the messages with option direct_codec in standard mode."""
+    ctx = block._get_ctx_or_raise()
+    if not ctx.optimization_mode:
+        return block.formatter.is_direct_codec(d)
+    filter_messages = ctx.optimization_mode_filter_messages
+    return not filter_messages or d.name in filter_messages
+
+
+def push_op_mode_statements(block: Block[F], l: List[str], indent: int) -> None:
+    """Pushes given statements of the optimization mode at given indent, except the
+    preprocessor directives, which are unindented."""
+    for line in l:
+        if line.lstrip().startswith("#"):
+            block.push(line.lstrip(), indent=0)
+        else:
+            block.push(line, indent=indent)
+
+
+def op_mode_statements_use_message(l: List[str]) -> bool:
+    """Returns True if any of given statements of the optimization mode references
+    the message m, e.g. not the ones writing only the constant ahead flags of an
+    extensible message without fields."""
+    return any(re.search(r"\bm\b", line) for line in l)
 
 
 class BlockInclude(Block[F]):
     @override(Block)
     def render(self) -> None:
         header_filename = self.formatter.format_out_filename(self.bound, extension=".h")
+        # The system headers go last, see BlockIncludeHeaders.
         self.push(f'#include "bitproto.h"')
         self.push(f'#include "{header_filename}"')
+        self.push("")
+        self.push("#include <string.h>")
 
 
 class BlockArrayBpFunctionBase(Block[F]):
@@ -54,14 +141,33 @@ class BlockArrayBpFunctionBase(Block[F]):
 
     @cached_property
     def array_descriptor(self) -> str:
-        return self.formatter.format_bp_array_descriptor(self.t)
+        return self.formatter.format_bp_array_descriptor(self.t, self.d)
+
+    @cached_property
+    def array_descriptor_name(self) -> str:
+        return self.formatter.format_bp_array_descriptor_name(self.t, self.d)
+
+
+class BlockArrayDescriptor(BlockArrayBpFunctionBase):
+    @override(Block)
+    def render(self) -> None:
+        name = self.array_descriptor_name
+        self.push(f"static const struct BpArrayDescriptor {name} = {self.array_descriptor};")
 
 
 class BlockArrayProcessorBody(BlockArrayBpFunctionBase):
     @override(Block)
     def render(self) -> None:
-        self.push(f"struct BpArrayDescriptor descriptor = {self.array_descriptor};")
-        self.push("BpEndecodeArray(&descriptor, ctx, data);")
+        if self.formatter.is_bp_message_array(self.t, self.d):
+            # Fields of the elements are processed one after another by the element
+            # message's descriptor, without calling its processor per element.
+            message = cast_or_raise(Message, self.t.element_type)
+            name = self.formatter.format_bp_message_descriptor_name(message)
+            size = self.formatter.format_sizeof(self.formatter.format_type(message))
+            cap = self.formatter.format_int_value(self.t.cap)
+            self.push(f"BpEndecodeMessageArray(&{name}, {cap}, {size}, ctx, data);")
+            return
+        self.push(f"BpEndecodeArray(&{self.array_descriptor_name}, ctx, data);")
 
 
 class BlockArrayProcessor(BlockArrayBpFunctionBase, BlockWrapper[F]):
@@ -72,7 +178,10 @@ class BlockArrayProcessor(BlockArrayBpFunctionBase, BlockWrapper[F]):
     @override(BlockWrapper)
     def before(self) -> None:
         processor_name = self.formatter.format_bp_array_processor_name(self.t, self.d)
-        signature = f"void {processor_name}(void *data, struct BpProcessorContext *ctx)"
+        # Array processors are only referenced in this file.
+        signature = (
+            f"static void {processor_name}(void *data, struct BpProcessorContext *ctx)"
+        )
         self.push(f"{signature} {{")
 
     @override(BlockWrapper)
@@ -80,11 +189,152 @@ class BlockArrayProcessor(BlockArrayBpFunctionBase, BlockWrapper[F]):
         self.push("}")
 
 
+class BlockArraySplitProcessor(BlockArrayBpFunctionBase):
+    """The encode (or decode) processor of an array, with option c.split_processors.
+    The element type is known here, integers in standard widths are copied in a
+    batch, bools and integers in other widths are packed (or unpacked) in a batch,
+    others are processed one by one. Bounded arrays process the elements in use
+    only, after their count."""
+
+    def __init__(
+        self, t: Array, d: Definition, is_encode: bool, indent: int = 0
+    ) -> None:
+        super().__init__(t, d, indent=indent)
+        self.is_encode = is_encode
+
+    @cached_property
+    def cap(self) -> Union[int, str]:
+        """The number of elements to process, variable n for bounded arrays."""
+        return "n" if self.t.bounded else self.t.cap
+
+    def render_validation(self) -> None:
+        """Validates the enums just decoded, see BpValidateEnums."""
+        t_ = self.t.element_type
+        if self.is_encode or not is_validated_enum(t_):
+            return
+        validator = self.formatter.format_bp_enum_validator_name(t_)
+        element_c_type = self.formatter.format_type(t_)
+        element_data = f"(void *)(({element_c_type} *)data + k)"
+        self.push(
+            f"for (int k = 0; k < {self.cap}; k++) {validator}({element_data}, ctx);",
+            indent=4,
+        )
+
+    def render_elements(self) -> None:
+        t, cap = self.t, self.cap
+        element_type = t.element_type
+        t_ = element_type.type if isinstance(element_type, Alias) else element_type
+        nbits = t_.nbits()
+        function = "BpEncodeBaseType" if self.is_encode else "BpDecodeBaseType"
+
+        element_c_type = self.formatter.format_type(element_type)
+        size = self.formatter.format_sizeof(element_c_type)
+
+        # Number of bits of the elements to process.
+        total = nbits * cap if isinstance(cap, int) else f"{nbits} * {cap}"
+
+        if isinstance(t_, (Byte, Uint, Int, Enum, Float)) and nbits in {8, 16, 32, 64}:
+            # Contiguous in memory, and no sign handling is required. Elements of
+            # more than one byte are swapped on big-endian hosts. Float32s are
+            # copied the same as uint32s.
+            if nbits == 8:
+                self.push(f"{function}({total}, ctx, data);", indent=4)
+            elif self.is_encode:
+                self.push(
+                    f"BpEncodeIntegers({size}, {nbits}, {cap}, ctx, data);", indent=4
+                )
+            else:
+                self.push(f"{function}({total}, ctx, data);", indent=4)
+                self.push(
+                    f"BpClearArrayHighBitsAfterDecode({size}, {nbits}, {cap}, data);",
+                    indent=4,
+                )
+            return
+
+        if isinstance(t_, (Bool, Uint, Int, Enum)):
+            # Packed and unpacked by the kernels, the signs are handled in a batch
+            # after the elements decoded.
+            if self.is_encode:
+                function = "BpEncodeIntegers"
+            elif isinstance(t_, Int):
+                function = "BpDecodeIntArray"
+            else:
+                function = "BpDecodeUintArray"
+            self.push(f"{function}({size}, {nbits}, {cap}, ctx, data);", indent=4)
+            return
+
+        element_data = f"(void *)(({element_c_type} *)data + k)"
+
+        call = self.formatter.format_bp_split_processor_call(
+            element_type, self.d, element_data, self.is_encode
+        )
+        self.push(f"for (int k = 0; k < {cap}; k++) {{", indent=4)
+        self.push(call, indent=8)
+        self.push("}", indent=4)
+
+    @override(Block)
+    def render(self) -> None:
+        name = self.formatter.format_bp_array_processor_name(
+            self.t, self.d, self.is_encode
+        )
+        self.push(
+            f"static void {name}(void *data, struct BpProcessorContext *ctx) {{"
+        )
+        if self.t.extensible:
+            if self.is_encode:
+                self.push(f"BpEncodeAhead({self.t.cap}, ctx);", indent=4)
+            else:
+                self.push("int i = ctx->i;", indent=4)
+                self.push("int ahead = (int)BpDecodeAhead(ctx);", indent=4)
+        if self.t.bounded:
+            function = "BpEncodeArrayCount"
+            if not self.is_encode:
+                function = "BpDecodeArrayCount"
+            cap = self.formatter.format_int_value(self.t.cap)
+            count_nbits = self.formatter.format_int_value(self.t.count_nbits())
+            offset = self.formatter.format_bp_bounded_array_offset(self.t, self.d)
+            self.push(f"int n = {function}({cap}, {count_nbits}, ctx, data);", indent=4)
+            self.push(f"data = (unsigned char *)data + ({offset});", indent=4)
+        self.render_elements()
+        self.render_validation()
+        if self.t.extensible and not self.is_encode:
+            # Skip redundant bits, the same as BpEndecodeArray.
+            ito = f"i + ahead * {self.t.cap}"
+            self.push(f"if ({ito} >= ctx->i) ctx->i = {ito};", indent=4)
+        self.push("}")
+
+
+class BlockArraySplitProcessors(BlockArrayBpFunctionBase, BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockArraySplitProcessor(self.t, self.d, is_encode=True),
+            BlockArraySplitProcessor(self.t, self.d, is_encode=False),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
 class BlockArrayJsonFormatterBody(BlockArrayBpFunctionBase):
     @override(Block)
     def render(self) -> None:
-        self.push(f"struct BpArrayDescriptor descriptor = {self.array_descriptor};")
-        self.push("BpJsonFormatArray(&descriptor, ctx, data);")
+        json_bytes = self.formatter.json_bytes(self.t, self.d)
+        if json_bytes != "array":
+            # Byte arrays as strings, see option json_bytes.
+            suffix = "Hex" if json_bytes == "hex" else "Base64"
+            cap = self.formatter.format_int_value(self.t.cap)
+            data = "(const unsigned char *)data"
+            if self.t.bounded:
+                # The bytes in use only.
+                offset = self.formatter.format_bp_bounded_array_offset(self.t, self.d)
+                self.push("int n = *(const uint16_t *)data;")
+                self.push(f"if (n > {cap}) n = {cap};")
+                data, cap = f"{data} + ({offset})", "n"
+            self.push(f"BpJsonFormat{suffix}(ctx, {data}, {cap});")
+        else:
+            self.push(f"BpJsonFormatArray(&{self.array_descriptor_name}, ctx, data);")
 
 
 class BlockArrayJsonFormatter(BlockArrayBpFunctionBase, BlockWrapper[F]):
@@ -98,7 +348,8 @@ class BlockArrayJsonFormatter(BlockArrayBpFunctionBase, BlockWrapper[F]):
             self.t, self.d
         )
         signature = (
-            f"void {json_formatter_name}(void *data, struct BpJsonFormatContext *ctx)"
+            f"static void {json_formatter_name}"
+            "(void *data, struct BpJsonFormatContext *ctx)"
         )
         self.push(f"{signature} {{")
 
@@ -107,6 +358,64 @@ class BlockArrayJsonFormatter(BlockArrayBpFunctionBase, BlockWrapper[F]):
         self.push("}")
 
 
+class BlockArrayJsonParser(BlockArrayBpFunctionBase):
+    @override(Block)
+    def render(self) -> None:
+        name = self.formatter.format_bp_array_json_parser_name(self.t, self.d)
+        element_type = self.formatter.format_type(self.t.element_type)
+        cap = self.formatter.format_int_value(self.t.cap)
+        call = self.formatter.format_bp_json_parse_call(
+            self.t.element_type, self.d, "(void *)&(a[k])"
+        )
+        self.push(f"static void {name}(void *data, struct BpJsonParseContext *ctx) {{")
+        json_bytes = self.formatter.json_bytes(self.t, self.d)
+        if self.t.bounded:
+            # The count is the number of elements parsed.
+            offset = self.formatter.format_bp_bounded_array_offset(self.t, self.d)
+            self.push("uint16_t *len = (uint16_t *)data;", indent=4)
+            self.push(f"data = (unsigned char *)data + ({offset});", indent=4)
+        if json_bytes != "array":
+            suffix = "Hex" if json_bytes == "hex" else "Base64"
+            call = f"BpJsonParse{suffix}(ctx, (unsigned char *)data, {cap});"
+            if self.t.bounded:
+                call = f"*len = (uint16_t){call}"
+            self.push(call, indent=4)
+            self.push("}")
+            return
+        self.push(f"{element_type} *a = ({element_type} *)data;", indent=4)
+        if self.t.bounded:
+            self.push("int k = 0;", indent=4)
+            self.push(
+                f"for (; BpJsonParseNextElement(ctx, k, {cap}); k++) {{", indent=4
+            )
+        else:
+            self.push(
+                f"for (int k = 0; BpJsonParseNextElement(ctx, k, {cap}); k++) {{",
+                indent=4,
+            )
+        self.push(call, indent=8)
+        self.push("}", indent=4)
+        if self.t.bounded:
+            self.push("*len = (uint16_t)k;", indent=4)
+        self.push("}")
+
+
+class BlockArrayDescriptorForAlias(BlockBindAlias[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        return isinstance(self.d.type, Array)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        array_type = cast_or_raise(Array, self.d.type)
+        block = BlockArrayDescriptor(array_type, self.d)
+        if self.formatter.is_split_processors(self.d):
+            return block  # Guarded along with the json formatters already.
+        if self.formatter.is_bp_message_array(array_type, self.d):
+            return BlockJsonGuard(block)  # Only used by the json formatter.
+        return block
+
+
 class BlockArrayProcessorForAlias(BlockBindAlias[F], BlockConditional[F]):
     @override(BlockConditional)
     def condition(self) -> bool:
@@ -115,6 +424,8 @@ class BlockArrayProcessorForAlias(BlockBindAlias[F], BlockConditional[F]):
     @override(BlockConditional)
     def block(self) -> Block[F]:
         array_type = cast_or_raise(Array, self.d.type)
+        if self.formatter.is_split_processors(self.d):
+            return BlockArraySplitProcessors(array_type, self.d)
         return BlockArrayProcessor(array_type, self.d)
 
 
@@ -129,12 +440,66 @@ class BlockArrayJsonFormatterForAlias(BlockBindAlias[F], BlockConditional[F]):
         return BlockArrayJsonFormatter(array_type, self.d)
 
 
-class BlockAliasProcessorBody(BlockBindAlias[F]):
+class BlockArrayJsonParserForAlias(BlockBindAlias[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        return isinstance(self.d.type, Array)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        array_type = cast_or_raise(Array, self.d.type)
+        return BlockArrayJsonParser(array_type, self.d)
+
+
+class BlockAliasDescriptor(BlockBindAlias[F]):
     @override(Block)
     def render(self) -> None:
+        name = self.formatter.format_bp_alias_descriptor_name(self.d)
         descriptor = self.formatter.format_bp_alias_descriptor(self.d)
-        self.push(f"struct BpAliasDescriptor descriptor = {descriptor};")
-        self.push("BpEndecodeAlias(&descriptor, ctx, data);")
+        self.push(f"static const struct BpAliasDescriptor {name} = {descriptor};")
+
+
+def is_alias_processor_direct(t: Type) -> bool:
+    """Returns True if the processor of an alias of given type calls the processor of
+    the type directly, see BlockAliasProcessorBody, the alias descriptor is then
+    only used by the json formatters."""
+    return isinstance(t, (Array, Int, Fixed, Bool, Uint, Float, Byte))
+
+
+class BlockAliasProcessorBody(BlockBindAlias[F]):
+    @override(Block)
+    def render(self) -> None:
+        # The aliased type is known here, calls its processor directly instead of
+        # the dispatching in BpEndecodeAlias.
+        t = self.d.type
+        if self.formatter.is_split_processors(self.d):
+            encoder = self.formatter.format_bp_alias_processor_name(self.d, True)
+            decoder = self.formatter.format_bp_alias_processor_name(self.d, False)
+            for line in self.formatter.format_bp_split_dispatch(encoder, decoder):
+                self.push(line)
+        elif isinstance(t, Array):
+            name = self.formatter.format_bp_array_processor_name(t, self.d)
+            self.push(f"{name}(data, ctx);")
+        elif isinstance(t, Int):
+            nbits = self.formatter.format_int_value(t.nbits())
+            size = self.formatter.format_sizeof(self.formatter.format_int_type(t))
+            self.push(f"BpEndecodeInt({size}, {nbits}, ctx, data);")
+        elif isinstance(t, Fixed):
+            arguments = self.formatter.format_bp_fixed_arguments(t)
+            self.push(f"BpEndecodeFixed({arguments}, ctx, data);")
+        elif isinstance(t, (Bool, Uint, Float)) and (
+            not is_nbits_standard(t.nbits()) or t.nbits() > 8
+        ):
+            # Uints of more than one byte are swapped on big-endian hosts.
+            nbits = self.formatter.format_int_value(t.nbits())
+            size = self.formatter.format_sizeof(self.formatter.format_type(t))
+            self.push(f"BpEndecodeUint({size}, {nbits}, ctx, data);")
+        elif isinstance(t, (Bool, Uint, Byte)):
+            nbits = self.formatter.format_int_value(t.nbits())
+            self.push(f"BpEndecodeBaseType({nbits}, ctx, data);")
+        else:
+            name = self.formatter.format_bp_alias_descriptor_name(self.d)
+            self.push(f"BpEndecodeAlias(&{name}, ctx, data);")
 
 
 class BlockAliasProcessor(BlockAliasProcessorBase, BlockWrapper[F]):
@@ -151,14 +516,56 @@ class BlockAliasProcessor(BlockAliasProcessorBase, BlockWrapper[F]):
         self.push("}")
 
 
+class BlockAliasSplitProcessor(BlockAliasSplitProcessorBase):
+    @override(Block)
+    def render(self) -> None:
+        call = self.formatter.format_bp_split_processor_call(
+            self.d.type, self.d, "data", self.is_encode
+        )
+        self.push(f"{self.function_signature} {{")
+        self.push(call, indent=4)
+        self.push("}")
+
+
 class BlockAliasFunctions(BlockBindAlias[F], BlockComposition[F]):
     @override(BlockComposition)
     def blocks(self) -> List[Block[F]]:
+        if self.formatter.is_split_processors(self.d):
+            # Descriptors are only used by the json formatters then.
+            return [
+                BlockArrayProcessorForAlias(self.d),
+                BlockAliasProcessor(self.d),
+                BlockAliasSplitProcessor(self.d, is_encode=True),
+                BlockAliasSplitProcessor(self.d, is_encode=False),
+                BlockJsonGuard(
+                    BlockArrayDescriptorForAlias(self.d),
+                    BlockArrayJsonFormatterForAlias(self.d),
+                    BlockAliasDescriptor(self.d),
+                    BlockAliasJsonFormatter(self.d),
+                    BlockArrayJsonParserForAlias(self.d),
+                    BlockAliasJsonParser(self.d),
+                    separator="\n\n",
+                ),
+            ]
+        # The descriptor, and the fixed processor referenced only by it.
+        descriptor: List[Block[F]] = [
+            BlockFixedProcessorForAlias(self.d),
+            BlockAliasDescriptor(self.d),
+        ]
+        if is_alias_processor_direct(self.d.type):
+            descriptor = [BlockJsonGuard(*descriptor, separator="\n\n")]
         return [
+            BlockArrayDescriptorForAlias(self.d),
             BlockArrayProcessorForAlias(self.d),
-            BlockArrayJsonFormatterForAlias(self.d),
+            BlockJsonGuard(BlockArrayJsonFormatterForAlias(self.d)),
+            *descriptor,
             BlockAliasProcessor(self.d),
-            BlockAliasJsonFormatter(self.d),
+            BlockJsonGuard(
+                BlockAliasJsonFormatter(self.d),
+                BlockArrayJsonParserForAlias(self.d),
+                BlockAliasJsonParser(self.d),
+                separator="\n\n",
+            ),
         ]
 
     @override(BlockComposition)
@@ -169,9 +576,8 @@ class BlockAliasFunctions(BlockBindAlias[F], BlockComposition[F]):
 class BlockAliasJsonFormatterBody(BlockBindAlias[F]):
     @override(Block)
     def render(self) -> None:
-        descriptor = self.formatter.format_bp_alias_descriptor(self.d)
-        self.push(f"struct BpAliasDescriptor descriptor = {descriptor};")
-        self.push("BpJsonFormatAlias(&descriptor, ctx, data);")
+        name = self.formatter.format_bp_alias_descriptor_name(self.d)
+        self.push(f"BpJsonFormatAlias(&{name}, ctx, data);")
 
 
 class BlockAliasJsonFormatter(BlockAliasJsonFormatterBase, BlockWrapper[F]):
@@ -188,14 +594,51 @@ class BlockAliasJsonFormatter(BlockAliasJsonFormatterBase, BlockWrapper[F]):
         self.push("}")
 
 
+class BlockAliasJsonParser(BlockAliasJsonParserBase):
+    @override(Block)
+    def render(self) -> None:
+        call = self.formatter.format_bp_json_parse_call(self.d.type, self.d, "data")
+        self.push(f"{self.function_signature} {{")
+        self.push(call, indent=4)
+        self.push("}")
+
+
+class BlockArrayDescriptorForMessageField(BlockBindMessageField[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        return isinstance(self.formatter.field_type(self.d), Array)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        array_type = cast_or_raise(Array, self.formatter.field_type(self.d))
+        block = BlockArrayDescriptor(array_type, self.d)
+        if self.formatter.is_split_processors(self.d):
+            return block  # Guarded along with the json formatters already.
+        if self.formatter.is_bp_message_array(array_type, self.d):
+            return BlockJsonGuard(block)  # Only used by the json formatter.
+        return block
+
+
+class BlockArrayDescriptorForMessageFieldList(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [BlockArrayDescriptorForMessageField(d) for d in self.d.sorted_fields()]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
 class BlockArrayProcessorForMessageField(BlockBindMessageField[F], BlockConditional[F]):
     @override(BlockConditional)
     def condition(self) -> bool:
-        return isinstance(self.d.type, Array)
+        return isinstance(self.formatter.field_type(self.d), Array)
 
     @override(BlockConditional)
     def block(self) -> Block[F]:
-        array_type = cast_or_raise(Array, self.d.type)
+        array_type = cast_or_raise(Array, self.formatter.field_type(self.d))
+        if self.formatter.is_split_processors(self.d):
+            return BlockArraySplitProcessors(array_type, self.d)
         return BlockArrayProcessor(array_type, self.d)
 
 
@@ -209,16 +652,113 @@ class BlockArrayProcessorForMessageFieldList(BlockBindMessage[F], BlockCompositi
         return "\n\n"
 
 
+class BlockRangeProcessorForMessageField(BlockBindMessageField[F], BlockConditional[F]):
+    """The processor of a message field of option range, which encodes the value minus
+    the lower bound, see BpEndecodeRange. The split processors call the library
+    functions directly instead."""
+
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        t = self.formatter.field_type(self.d)
+        return isinstance(t, Range) and not self.formatter.is_split_processors(self.d)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        return BlockRangeProcessor(self.d)
+
+
+class BlockRangeProcessor(BlockBindMessageField[F]):
+    @override(Block)
+    def render(self) -> None:
+        t = cast_or_raise(Range, self.formatter.field_type(self.d))
+        processor_name = self.formatter.format_bp_range_processor_name(self.d)
+        size = self.formatter.format_sizeof(self.formatter.format_type(t))
+        nbits = self.formatter.format_int_value(t.nbits())
+        lo = self.formatter.format_bp_range_lo(t)
+        # Range processors are only referenced in this file.
+        self.push(
+            f"static void {processor_name}(void *data, struct BpProcessorContext *ctx) {{"
+        )
+        self.push(f"BpEndecodeRange({size}, {nbits}, {lo}, ctx, data);", indent=4)
+        self.push("}")
+
+
+class BlockFixedProcessor(Block[F]):
+    """The processor of the fixed-point type of a message field or an alias, or of its
+    elements if it's an array, see BpEndecodeFixed. The split processors call the
+    library functions directly instead."""
+
+    def __init__(self, t: Fixed, d: Definition, indent: int = 0) -> None:
+        super().__init__(indent=indent)
+        self.t = t
+        self.d = d
+
+    @override(Block)
+    def render(self) -> None:
+        processor_name = self.formatter.format_bp_fixed_processor_name(self.d)
+        arguments = self.formatter.format_bp_fixed_arguments(self.t)
+        # Fixed-point processors are only referenced in this file.
+        self.push(
+            f"static void {processor_name}(void *data, struct BpProcessorContext *ctx) {{"
+        )
+        self.push(f"BpEndecodeFixed({arguments}, ctx, data);", indent=4)
+        self.push("}")
+
+
+class BlockFixedProcessorForMessageField(BlockBindMessageField[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        t = self.formatter.fixed_type(self.formatter.field_type(self.d))
+        return t is not None and not self.formatter.is_split_processors(self.d)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        t = self.formatter.fixed_type(self.formatter.field_type(self.d))
+        return BlockFixedProcessor(cast_or_raise(Fixed, t), self.d)
+
+
+class BlockFixedProcessorForMessageFieldList(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [BlockFixedProcessorForMessageField(d) for d in self.d.sorted_fields()]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
+class BlockFixedProcessorForAlias(BlockBindAlias[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        t = self.formatter.fixed_type(self.d.type)
+        return t is not None and not self.formatter.is_split_processors(self.d)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        t = self.formatter.fixed_type(self.d.type)
+        return BlockFixedProcessor(cast_or_raise(Fixed, t), self.d)
+
+
+class BlockRangeProcessorForMessageFieldList(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [BlockRangeProcessorForMessageField(d) for d in self.d.sorted_fields()]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
 class BlockArrayJsonFormatterForMessageField(
     BlockBindMessageField[F], BlockConditional[F]
 ):
     @override(BlockConditional)
     def condition(self) -> bool:
-        return isinstance(self.d.type, Array)
+        return isinstance(self.formatter.field_type(self.d), Array)
 
     @override(BlockConditional)
     def block(self) -> Block[F]:
-        array_type = cast_or_raise(Array, self.d.type)
+        array_type = cast_or_raise(Array, self.formatter.field_type(self.d))
         return BlockArrayJsonFormatter(array_type, self.d)
 
 
@@ -236,32 +776,49 @@ class BlockArrayJsonFormatterForMessageFieldList(
         return "\n\n"
 
 
-class BlockMessageProcessorFieldItem(BlockBindMessageField[F]):
-    def __init__(
-        self, d: MessageField, name: Optional[str] = None, indent: int = 0, i: int = 0
-    ) -> None:
-        super().__init__(d, name, indent)
-        self.i: int = i
+class BlockArrayJsonParserForMessageField(
+    BlockBindMessageField[F], BlockConditional[F]
+):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        return isinstance(self.formatter.field_type(self.d), Array)
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        array_type = cast_or_raise(Array, self.formatter.field_type(self.d))
+        return BlockArrayJsonParser(array_type, self.d)
+
+
+class BlockArrayJsonParserForMessageFieldList(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [BlockArrayJsonParserForMessageField(d) for d in self.d.sorted_fields()]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
 
+
+class BlockMessageFieldDescriptorItem(BlockBindMessageField[F]):
     @override(Block)
     def render(self) -> None:
-        bp_type = self.formatter.format_bp_type(self.d.type, self.d)
-        index = self.formatter.format_int_value(self.i)
+        offset = self.formatter.format_offsetof(self.d.message, self.d)
+        t = self.formatter.field_type(self.d)
+        bp_type = self.formatter.format_bp_type(t, self.d)
         name = self.formatter.format_str_value(self.d.name)
-        self.push(f"fds[{index}] =")
-        self.push_string("BpMessageFieldDescriptor(")
-        self.push_string(f"(void *)&(m->{self.message_field_name})", separator="")
+        self.push("BpMessageFieldDescriptor(")
+        self.push_string(offset, separator="")
         self.push_string(f"{bp_type}", separator=", ")
         self.push_string(f"{name}", separator=", ")
-        self.push_string(");", separator="")
+        self.push_string("),", separator="")
 
 
-class BlockMessageProcessorFieldList(BlockBindMessage[F], BlockComposition[F]):
+class BlockMessageFieldDescriptorList(BlockBindMessage[F], BlockComposition[F]):
     @override(BlockComposition)
     def blocks(self) -> List[Block[F]]:
         return [
-            BlockMessageProcessorFieldItem(d, indent=self.indent, i=i)
-            for i, d in enumerate(self.d.sorted_fields())
+            BlockMessageFieldDescriptorItem(d, indent=self.indent)
+            for d in self.d.sorted_fields()
         ]
 
     @override(BlockComposition)
@@ -269,126 +826,1174 @@ class BlockMessageProcessorFieldList(BlockBindMessage[F], BlockComposition[F]):
         return "\n"
 
 
-class BlockMessageFieldDescriptorsIniter(
-    BlockMessageFieldDescriptorsIniterBase, BlockWrapper[F]
-):
+class BlockMessageFieldDescriptors(BlockBindMessage[F], BlockWrapper[F]):
     @override(BlockWrapper)
     def wraps(self) -> Optional[Block[F]]:
-        return BlockMessageProcessorFieldList(self.d, indent=self.indent + 4)
+        return BlockMessageFieldDescriptorList(self.d, indent=self.indent + 4)
 
     @override(BlockWrapper)
     def before(self) -> None:
-        self.push(f"{self.function_signature} {{")
+        name = self.formatter.format_bp_message_field_descriptors_name(self.d)
+        nfields = self.formatter.format_int_value(self.d.nfields())
+        self.push(
+            f"static const struct BpMessageFieldDescriptor {name}[{nfields}] = {{"
+        )
 
     @override(BlockWrapper)
     def after(self) -> None:
-        self.push("}")
+        self.push("};")
+
+
+class BlockMessageFieldDescriptorsForNonEmpty(BlockBindMessage[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        # Zero-length arrays are not allowed in C.
+        return self.d.nfields() > 0
+
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        return BlockMessageFieldDescriptors(self.d)
 
 
-class BlockMessageDescriptorBuild(BlockMessageFieldDescriptorsIniterBase):
+class BlockMessageDescriptor(BlockBindMessage[F]):
     @override(Block)
     def render(self) -> None:
-        nfields = self.formatter.format_int_value(self.d.nfields())
-        bp_type = self.formatter.format_bp_message_descriptor(self.d)
-        initer = self.formatter.format_bp_message_field_descriptor_initer(self.d)
+        name = self.formatter.format_bp_message_descriptor_name(self.d)
+        descriptor = self.formatter.format_bp_message_descriptor(self.d)
+        self.push(f"static const struct BpMessageDescriptor {name} = {descriptor};")
 
-        self.push(f"{self.message_type} *m = ({self.message_type} *)(data);")
-        self.push(f"struct BpMessageFieldDescriptor field_descriptors[{nfields}];")
-        self.push(f"{initer}(m, field_descriptors);")
-        self.push(f"struct BpMessageDescriptor descriptor = {bp_type};")
 
+class BlockMessagePlan(BlockBindMessage[F]):
+    """The copy plan of a message, with option c.copy_plans, see struct BpPlanOp."""
 
-class BlockMessageProcessor(BlockMessageProcessorBase, BlockWrapper[F]):
-    @override(BlockWrapper)
-    def wraps(self) -> Optional[Block[F]]:
-        return BlockMessageDescriptorBuild(self.d, indent=4)
+    def render_ops(self, ops: List[str]) -> None:
+        name = self.formatter.format_bp_plan_name(self.d)
+        self.push(f"static const struct BpPlanOp {name}[{len(ops)}] = {{")
+        for op in ops:
+            self.push(f"{op},", indent=4)
+        self.push("};")
 
-    @override(BlockWrapper)
-    def before(self) -> None:
-        self.push(f"{self.function_signature} {{")
+    @override(Block)
+    def render(self) -> None:
+        ops = self.formatter.format_bp_plan_ops(self.d)
+        ops_big_endian = self.formatter.format_bp_plan_ops(self.d, big_endian=True)
+        if ops == ops_big_endian:
+            self.render_ops(ops)
+            return
+        # Runs of integers of more than one byte are split on big-endian hosts.
+        self.push("#if BP_BIG_ENDIAN")
+        self.render_ops(ops_big_endian)
+        self.push("#else")
+        self.render_ops(ops)
+        self.push("#endif")
+
+
+class BlockMessagePlanForCopyPlan(BlockBindMessage[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        # Zero-length arrays are not allowed in C.
+        return self.formatter.has_copy_plan(self.d) and self.d.nfields() > 0
 
-    @override(BlockWrapper)
-    def after(self) -> None:
-        self.push("BpEndecodeMessage(&descriptor, ctx, data);", indent=4)
-        self.push("}")
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        return BlockMessagePlan(self.d)
 
 
-class BlockMessageBpJsonFormatter(BlockMessageBpJsonFormatterBase, BlockWrapper[F]):
-    @override(BlockWrapper)
-    def wraps(self) -> Optional[Block[F]]:
-        return BlockMessageDescriptorBuild(self.d, indent=4)
+class BlockMessageAheadChecks(BlockBindMessage[F]):
+    """The ahead flags of current version of a message not in fixed size, checked
+    before decoding by the copy plan, see struct BpAheadCheck."""
 
-    @override(BlockWrapper)
-    def before(self) -> None:
-        self.push(f"{self.function_signature} {{")
+    @override(Block)
+    def render(self) -> None:
+        name = self.formatter.format_bp_ahead_checks_name(self.d)
+        checks = self.formatter.format_bp_ahead_checks(self.d)
+        self.push(f"static const struct BpAheadCheck {name}[{len(checks)}] = {{")
+        for check in checks:
+            self.push(f"{check},", indent=4)
+        self.push("};")
 
-    @override(BlockWrapper)
-    def after(self) -> None:
-        self.push("BpJsonFormatMessage(&descriptor, ctx, data);", indent=4)
-        self.push("}")
 
+class BlockMessageAheadChecksForAheadPlan(BlockBindMessage[F], BlockConditional[F]):
+    @override(BlockConditional)
+    def condition(self) -> bool:
+        return self.formatter.is_ahead_plan(self.d)
 
-class BlockMessageEncoder(BlockMessageEncoderBase):
+    @override(BlockConditional)
+    def block(self) -> Block[F]:
+        return BlockMessageAheadChecks(self.d)
+
+
+class BlockMessageProcessor(BlockMessageProcessorBase):
     @override(Block)
     def render(self) -> None:
-        processor_name = self.formatter.format_bp_message_processor_name(self.d)
+        name = self.formatter.format_bp_message_descriptor_name(self.d)
         self.push(f"{self.function_signature} {{")
-        self.push(
-            "struct BpProcessorContext ctx = BpProcessorContext(true, s);", indent=4
-        )
-        self.push(f"{processor_name}((void *)m, &ctx);", indent=4)
-        self.push("return 0;", indent=4)
+        if self.formatter.is_split_processors(self.d):
+            # Kept for the processors of other protos referencing this message.
+            encoder = self.formatter.format_bp_message_processor_name(self.d, True)
+            decoder = self.formatter.format_bp_message_processor_name(self.d, False)
+            for line in self.formatter.format_bp_split_dispatch(encoder, decoder):
+                self.push(line, indent=4)
+        else:
+            self.push(f"BpEndecodeMessage(&{name}, ctx, data);", indent=4)
         self.push("}")
 
 
-class BlockMessageDecoder(BlockMessageDecoderBase):
+class BlockMessageSplitProcessor(BlockMessageSplitProcessorBase):
+    """The encode (or decode) processor of a message, with option c.split_processors.
+    Fields are processed one after another by direct calls, instead of iterating
+    the field descriptors in BpEndecodeMessage."""
+
     @override(Block)
     def render(self) -> None:
-        processor_name = self.formatter.format_bp_message_processor_name(self.d)
         self.push(f"{self.function_signature} {{")
-        self.push(
-            "struct BpProcessorContext ctx = BpProcessorContext(false, s);", indent=4
-        )
-        self.push(f"{processor_name}((void *)m, &ctx);", indent=4)
-        self.push("return 0;", indent=4)
+        fields = self.d.sorted_fields()
+        if fields:
+            self.push(f"{self.message_type} *m = ({self.message_type} *)data;", indent=4)
+        elif not self.d.extensible:
+            self.push("(void)data;", indent=4)
+            self.push("(void)ctx;", indent=4)
+        if self.d.extensible:
+            if self.is_encode:
+                self.push(f"BpEncodeAhead({self.d.nbits()}, ctx);", indent=4)
+            else:
+                self.push("int i = ctx->i;", indent=4)
+                self.push("int ahead = (int)BpDecodeAhead(ctx);", indent=4)
+        for field in fields:
+            field_name = self.formatter.format_message_field_name(field)
+            data = f"(void *)&(m->{field_name})"
+            t = self.formatter.field_type(field)
+            call = self.formatter.format_bp_split_processor_call(
+                t, field, data, self.is_encode
+            )
+            self.push(call, indent=4)
+            if not self.is_encode and is_validated_enum(t):
+                validator = self.formatter.format_bp_enum_validator_name(t)
+                self.push(f"{validator}({data}, ctx);", indent=4)
+        if self.d.extensible and not self.is_encode:
+            # Skip redundant bits, the same as BpEndecodeMessage.
+            self.push("if (i + ahead >= ctx->i) ctx->i = i + ahead;", indent=4)
         self.push("}")
 
 
-class BlockMessageJsonFormatter(BlockMessageJsonFormatterBase):
+class BlockMessageBpJsonFormatter(BlockMessageBpJsonFormatterBase):
     @override(Block)
     def render(self) -> None:
-        json_formatter_name = self.formatter.format_bp_message_json_formatter_name(
-            self.d
-        )
+        name = self.formatter.format_bp_message_descriptor_name(self.d)
         self.push(f"{self.function_signature} {{")
-        self.push("struct BpJsonFormatContext ctx = BpJsonFormatContext(s);", indent=4)
-        self.push(f"{json_formatter_name}((void *)m, &ctx);", indent=4)
-        self.push("return ctx.n;", indent=4)
+        self.push(f"BpJsonFormatMessage(&{name}, ctx, data);", indent=4)
         self.push("}")
 
 
-class BlockMessageFunctions(BlockBindMessage[F], BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockArrayProcessorForMessageFieldList(self.d),
-            BlockArrayJsonFormatterForMessageFieldList(self.d),
-            BlockMessageFieldDescriptorsIniter(self.d),
-            BlockMessageProcessor(self.d),
-            BlockMessageBpJsonFormatter(self.d),
-            BlockMessageEncoder(self.d),
-            BlockMessageDecoder(self.d),
-            BlockMessageJsonFormatter(self.d),
-        ]
+class BlockMessageBpJsonParser(BlockMessageBpJsonParserBase):
+    """Parses a json object into the message, looking up the keys by a switch on
+    their lengths, instead of comparing with every field name."""
+
+    @override(Block)
+    def render(self) -> None:
+        message_type = self.formatter.format_message_type(self.d)
+        fields = self.d.sorted_fields()
+        items = []
+        for field in fields:
+            field_name = self.formatter.format_message_field_name(field)
+            data = f"(void *)&(m->{field_name})"
+            t = self.formatter.field_type(field)
+            call = self.formatter.format_bp_json_parse_call(t, field, data)
+            items.append((field.name, call))
+        self.push(f"{self.function_signature} {{")
+        if fields:
+            self.push(f"{message_type} *m = ({message_type} *)data;", indent=4)
+        else:
+            self.push("(void)data;", indent=4)
+        self.push("const char *key;", indent=4)
+        self.push("int n;", indent=4)
+        self.push(
+            "for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {", indent=4
+        )
+        for line in self.formatter.format_bp_json_key_switch(items, "key", "n"):
+            self.push(line, indent=8)
+        self.push("BpJsonParseSkip(ctx);", indent=8)
+        self.push("}", indent=4)
+        self.push("}")
+
+
+class BlockMessageEncoder(BlockMessageEncoderBase):
+    def render_encoding(self) -> None:
+        if self.formatter.is_copy_plan(self.d):
+            call = self.formatter.format_bp_plan_call(self.d, "(void *)m", "s", True)
+            self.push(call, indent=4)
+            return
+        processor_name = self.formatter.format_bp_message_processor_name(
+            self.d, self.formatter.bp_processor_direction(self.d, True)
+        )
+        self.push(
+            "struct BpProcessorContext ctx = BpProcessorContext(true, s);", indent=4
+        )
+        self.push(f"{processor_name}((void *)m, &ctx);", indent=4)
+        if not (self.d.is_fixed_size() and self.d.nbits() % 8 == 0):
+            # Defines the padding bits, the buffer s may be not zeroed.
+            self.push("BpEncodePadding(&ctx);", indent=4)
+
+    def push_memcpy(self, statement: str) -> None:
+        """Pushes the memcpy of a message in is_memcpy_type, which is encoded as
+        usual on big-endian hosts if not is_byte_order_free."""
+        if is_byte_order_free(self.d):
+            self.push(statement, indent=4)
+            return
+        self.push("#if BP_BIG_ENDIAN")
+        self.render_encoding()
+        self.push("#else")
+        self.push(statement, indent=4)
+        self.push("#endif")
+
+    @override(Block)
+    def render(self) -> None:
+        size = self.message_size_constant_name
+        self.push(f"{self.function_signature} {{")
+        self.push(self.formatter.format_bp_trace(self.d, "BEGIN", True, size), indent=4)
+        if is_memcpy_type(self.d):
+            # The encoding is exactly the struct's memory.
+            self.push_memcpy(f"memcpy(s, m, {size});")
+        else:
+            self.render_encoding()
+        self.push(self.formatter.format_bp_trace(self.d, "END", True, size), indent=4)
+        if self.d.has_bounded_array():
+            # Bounded arrays take the bits of the elements in use only.
+            self.push("return (ctx.i + 7) >> 3;", indent=4)
+        else:
+            self.push("return 0;", indent=4)
+        self.push("}")
+
+
+class BlockMessageDecoder(BlockMessageDecoderBase):
+    def render_processor_decoding(self, indent: int) -> None:
+        processor_name = self.formatter.format_bp_message_processor_name(
+            self.d, self.formatter.bp_processor_direction(self.d, False)
+        )
+        self.push(
+            "struct BpProcessorContext ctx = BpProcessorContext(false, s);",
+            indent=indent,
+        )
+        self.push(f"{processor_name}((void *)m, &ctx);", indent=indent)
+
+    def render_decoding(self) -> None:
+        if self.formatter.is_copy_plan(self.d):
+            call = self.formatter.format_bp_plan_call(self.d, "(void *)m", "s", False)
+            self.push(call, indent=4)
+            return
+        if not self.formatter.is_ahead_plan(self.d):
+            self.render_processor_decoding(4)
+            return
+        # Buffers encoded by current version are decoded by the copy plan, the
+        # processors are left for other versions.
+        condition = self.formatter.format_bp_ahead_plan_condition(self.d, "s")
+        call = self.formatter.format_bp_plan_call(self.d, "(void *)m", "s", False)
+        self.push(f"if ({condition}) {{", indent=4)
+        self.push(call, indent=8)
+        self.push("} else {", indent=4)
+        self.render_processor_decoding(8)
+        self.push("}", indent=4)
+
+    def push_memcpy(self, statement: str) -> None:
+        """The same as BlockMessageEncoder's."""
+        if is_byte_order_free(self.d):
+            self.push(statement, indent=4)
+            return
+        self.push("#if BP_BIG_ENDIAN")
+        self.render_decoding()
+        self.push("#else")
+        self.push(statement, indent=4)
+        self.push("#endif")
+
+    @override(Block)
+    def render(self) -> None:
+        size = self.message_size_constant_name
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            self.formatter.format_bp_trace(self.d, "BEGIN", False, size), indent=4
+        )
+        if is_memcpy_type(self.d):
+            # The encoding is exactly the struct's memory.
+            self.push_memcpy(f"memcpy(m, s, {size});")
+        else:
+            self.render_decoding()
+        self.push(self.formatter.format_bp_trace(self.d, "END", False, size), indent=4)
+        # Messages with enums to validate are decoded by the processors always.
+        self.push(self.formatter.format_bp_decoder_return(self.d, "ctx.err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageBoundedDecoder(BlockMessageBoundedDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        if not self.d.has_bounded_array():
+            # Messages with bounded arrays may take less bytes than the size, which
+            # are checked after decoded only.
+            size = self.message_size_constant_name
+            self.push(f"if (n < {size}) return BP_ERR_SHORT_INPUT;", indent=4)
+        if self.d.is_fixed_size():
+            # Checking once is enough for a message in fixed size.
+            self.push(f"return Decode{self.message_name}(m, s);", indent=4)
+        else:
+            if self.formatter.is_ahead_plan(self.d):
+                # The layout of current version fits in the size checked.
+                condition = self.formatter.format_bp_ahead_plan_condition(self.d, "s")
+                call = self.formatter.format_bp_plan_call(
+                    self.d, "(void *)m", "s", False
+                )
+                self.push(f"if ({condition}) {{", indent=4)
+                self.push(call, indent=8)
+                self.push("return 0;", indent=8)
+                self.push("}", indent=4)
+            # Extensible types inside may take more bytes than the size.
+            processor_name = self.formatter.format_bp_message_processor_name(
+                self.d, self.formatter.bp_processor_direction(self.d, False)
+            )
+            self.push(
+                "struct BpProcessorContext ctx = BpProcessorContextN(false, s, n);",
+                indent=4,
+            )
+            self.push(f"{processor_name}((void *)m, &ctx);", indent=4)
+            self.push("if (ctx.i > (n << 3)) return BP_ERR_SHORT_INPUT;", indent=4)
+            ret = self.formatter.format_bp_decoder_return(self.d, "ctx.err")
+            self.push(ret, indent=4)
+        self.push("}")
+
+
+class BlockMessageMaskedDecoder(BlockMessageMaskedDecoderBase):
+    """Decodes the fields selected one after another by direct calls, the same as
+    the decode processor of option c.split_processors, and skips the others by
+    their number of bits."""
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.has_masked_decoder:
+            return
+        self.push(f"{self.function_signature} {{")
+        self.push("struct BpProcessorContext c = BpProcessorContext(false, s);", indent=4)
+        self.push("struct BpProcessorContext *ctx = &c;", indent=4)
+        if self.unsized_fields_mask == (1 << self.d.nfields()) - 1:
+            self.push("(void)mask;", indent=4)
+        if self.d.extensible:
+            # Fields are decoded in the layout of current version, the same as the
+            # decoder does, no bits after are read.
+            self.push(f"ctx->i += {self.d.ahead_nbits()};", indent=4)
+        for k, field in enumerate(self.d.sorted_fields()):
+            field_name = self.formatter.format_message_field_name(field)
+            data = f"(void *)&(m->{field_name})"
+            t = self.formatter.field_type(field)
+            sized = not self.unsized_fields_mask & (1 << k)
+            if sized:
+                mask = self.format_field_mask_constant_name(field)
+                self.push(f"if (mask & {mask}) {{", indent=4)
+            else:
+                self.push_comment(
+                    "Not in fixed size, decoded always to know where the next begins.",
+                    indent=4,
+                )
+            indent = 8 if sized else 4
+            call = self.formatter.format_bp_split_processor_call(t, field, data, False)
+            self.push(call, indent=indent)
+            if is_validated_enum(t):
+                validator = self.formatter.format_bp_enum_validator_name(t)
+                self.push(f"{validator}({data}, ctx);", indent=indent)
+            if sized:
+                self.push("} else {", indent=4)
+                self.push(f"ctx->i += {t.nbits()};", indent=8)
+                self.push("}", indent=4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "c.err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageHash(BlockMessageHashBase):
+    """Hash function working directly on struct fields, the same in both modes."""
+
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        self.push("uint64_t h = BP_HASH_INIT;", indent=4)
+        for line in self.formatter.format_bp_hash_statements(self.d, "m"):
+            self.push(line, indent=4)
+        self.push("return h;", indent=4)
+        self.push("}")
+
+
+class BlockMessageEqual(BlockMessageEqualBase):
+    """Equality function working directly on struct fields, the same in both modes."""
+
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        l = self.formatter.format_bp_equal_statements(self.d, "a", "b")
+        if not l:
+            self.push("(void)a;", indent=4)
+            self.push("(void)b;", indent=4)
+        for line in l:
+            self.push(line, indent=4)
+        self.push("return true;", indent=4)
+        self.push("}")
+
+
+class BlockMessageSelfTest(BlockMessageSelfTestBase):
+    """Function BpSelfTestXXX with its test vectors, the same in both modes. Every
+    encoder and decoder generated for the message is checked, whichever path it takes,
+    e.g. copy plans, memcpy layouts and the statements of optimization mode. Encoders
+    write into a dirty buffer, decoders into a struct holding another vector, since
+    neither is required to be zeroed."""
+
+    @cached_property
+    def vectors(self) -> List[Vector]:
+        return message_vectors(self.d, self.nvectors)
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.nvectors:
+            return
+        n = self.formatter.format_int_value(self.nvectors)
+        size = self.message_size_constant_name
+        structs = f"{self.function_name}Structs"
+        buffers = f"{self.function_name}Buffers"
+        lengths = f"{self.function_name}Lengths"
+        bounded = self.d.has_bounded_array()
+
+        self.push_comment(f"Test vectors of struct {self.message_name}.")
+        self.push(f"static const {self.message_type} {structs}[{n}] = {{")
+        for vector in self.vectors:
+            literal = self.formatter.format_literal(self.d, vector.value)
+            self.push(f"{literal},", indent=4)
+        self.push("};")
+        self.push_empty_line()
+        self.push(f"static const unsigned char {buffers}[{n}][{size}] = {{")
+        for vector in self.vectors:
+            self.push("{", indent=4)
+            for i in range(0, len(vector.buffer), 12):
+                line = ", ".join(f"0x{b:02x}" for b in vector.buffer[i : i + 12])
+                self.push(f"{line},", indent=8)
+            self.push("},", indent=4)
+        self.push("};")
+        if bounded:
+            self.push_empty_line()
+            self.push_comment(
+                "Number of bytes of the encodings, bounded arrays take the bytes of "
+                "the elements in use only."
+            )
+            ns = ", ".join(str(len(vector.buffer)) for vector in self.vectors)
+            self.push(f"static const int {lengths}[{n}] = {{{ns}}};")
+        self.push_empty_line()
+
+        name = self.message_name
+        fail = "return BP_ERR_SELF_TEST;"
+        self.push(f"{self.function_signature} {{")
+        self.push(f"unsigned char s[{size}];", indent=4)
+        self.push(f"{self.message_type} m;", indent=4)
+        self.push(f"for (int k = 0; k < {n}; k++) {{", indent=4)
+        self.push(f"const {self.message_type} *v = &{structs}[k];", indent=8)
+        dirty = f"&{structs}[(k + 1) % {n}]"
+        self.push(f"const {self.message_type} *dirty = {dirty};", indent=8)
+        self.push(f"const unsigned char *t = {buffers}[k];", indent=8)
+        self.push(f"int n = {lengths}[k];" if bounded else f"int n = {size};", indent=8)
+        # Encoders of messages with bounded arrays return the number of bytes.
+        encoders = [(f"Encode{name}(v, s)", "n" if bounded else "0")]
+        encoders.append((f"Encode{name}Batch(v, 1, s)", "0"))
+        for call, rc in encoders:
+            self.push("memset(s, 0xa5, sizeof(s));", indent=8)
+            self.push(f"if ({call} != {rc} || memcmp(s, t, n) != 0) {fail}", indent=8)
+        decoders = [f"Decode{name}(&m, t)", f"Decode{name}N(&m, t, n)"]
+        if self.has_masked_decoder:
+            decoders.append(f"Decode{name}Masked(&m, t, ~(uint64_t)0)")
+        decoders.append(f"Decode{name}Batch(&m, 1, t)")
+        for call in decoders:
+            self.push("m = *dirty;", indent=8)
+            self.push(f"if ({call} != 0 || !Equal{name}(&m, v)) {fail}", indent=8)
+        self.push("}", indent=4)
+        self.push("return 0;", indent=4)
+        self.push("}")
+
+
+class BlockMessageBatchEncoder(BlockMessageBatchEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        processor_name = self.formatter.format_bp_message_processor_name(
+            self.d, self.formatter.bp_processor_direction(self.d, True)
+        )
+        self.push(f"{self.function_signature} {{")
+        if is_memcpy_type(self.d):
+            # The records are laid out exactly as the array of structs, processed
+            # as usual on big-endian hosts if not is_byte_order_free.
+            size = self.message_size_constant_name
+            byte_order_free = is_byte_order_free(self.d)
+            if not byte_order_free:
+                self.push("#if !BP_BIG_ENDIAN")
+            self.push(f"memcpy(s, ms, count * {size});", indent=4)
+            self.push("return 0;", indent=4)
+            if byte_order_free:
+                self.push("}")
+                return
+            self.push("#endif")
+        if self.formatter.is_copy_plan(self.d):
+            size = self.message_size_constant_name
+            call = self.formatter.format_bp_plan_call(
+                self.d, "(void *)&ms[k]", f"s + k * {size}", True
+            )
+            self.push("for (size_t k = 0; k < count; k++)", indent=4)
+            self.push(call, indent=8)
+            self.push("return 0;", indent=4)
+            self.push("}")
+            return
+        # Reuses a single context across the records.
+        self.push(
+            "struct BpProcessorContext ctx = BpProcessorContext(true, s);", indent=4
+        )
+        self.push("for (size_t k = 0; k < count; k++) {", indent=4)
+        self.push(f"ctx.s = s + k * {self.message_size_constant_name};", indent=8)
+        self.push("ctx.i = 0;", indent=8)
+        self.push(f"{processor_name}((void *)&ms[k], &ctx);", indent=8)
+        if not (self.d.is_fixed_size() and self.d.nbits() % 8 == 0):
+            self.push("BpEncodePadding(&ctx);", indent=8)
+        self.push("}", indent=4)
+        self.push("return 0;", indent=4)
+        self.push("}")
+
+
+class BlockMessageBatchDecoder(BlockMessageBatchDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        processor_name = self.formatter.format_bp_message_processor_name(
+            self.d, self.formatter.bp_processor_direction(self.d, False)
+        )
+        self.push(f"{self.function_signature} {{")
+        if is_memcpy_type(self.d):
+            # The records are laid out exactly as the array of structs, processed
+            # as usual on big-endian hosts if not is_byte_order_free.
+            size = self.message_size_constant_name
+            byte_order_free = is_byte_order_free(self.d)
+            if not byte_order_free:
+                self.push("#if !BP_BIG_ENDIAN")
+            self.push(f"memcpy(ms, s, count * {size});", indent=4)
+            self.push("return 0;", indent=4)
+            if byte_order_free:
+                self.push("}")
+                return
+            self.push("#endif")
+        if self.formatter.is_copy_plan(self.d):
+            # Decodes the same field of the records at a time, see BpDecodePlanBatch.
+            call = self.formatter.format_bp_plan_batch_call(
+                self.d, "ms", "s", self.message_size_constant_name, "count"
+            )
+            self.push(call, indent=4)
+            self.push("return 0;", indent=4)
+            self.push("}")
+            return
+        # Reuses a single context across the records.
+        self.push(
+            "struct BpProcessorContext ctx = BpProcessorContext(false, s);", indent=4
+        )
+        self.push("for (size_t k = 0; k < count; k++) {", indent=4)
+        # The buffer is only read on decoding, see BpProcessorContext.
+        self.push(f"ctx.s = (unsigned char *)s + k * {self.message_size_constant_name};", indent=8)
+        if self.formatter.is_ahead_plan(self.d):
+            # Records of current version are decoded by the copy plan.
+            condition = self.formatter.format_bp_ahead_plan_condition(self.d, "ctx.s")
+            call = self.formatter.format_bp_plan_call(
+                self.d, "(void *)&ms[k]", "ctx.s", False
+            )
+            self.push(f"if ({condition}) {{", indent=8)
+            self.push(call, indent=12)
+            self.push("continue;", indent=12)
+            self.push("}", indent=8)
+        self.push("ctx.i = 0;", indent=8)
+        self.push(f"{processor_name}((void *)&ms[k], &ctx);", indent=8)
+        self.push("}", indent=4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "ctx.err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageParallelBatch(BlockMessageParallelBatchBase):
+    @cached_property
+    def adapter_name(self) -> str:
+        prefix = self.formatter.bp_descriptor_name_prefix()
+        return f"{prefix}{self.batch_function_name}"
+
+    @override(Block)
+    def render(self) -> None:
+        # Adapts the batch function to the signature of BpBatchFunction.
+        const = "const " if self.is_encode else ""
+        self.push(
+            f"static int {self.adapter_name}(void *ms, size_t count, unsigned char *s) {{"
+        )
+        self.push(
+            f"return {self.batch_function_name}(({const}{self.message_type} *)ms, "
+            "count, s);",
+            indent=4,
+        )
+        self.push("}")
+        self.push_empty_line()
+        self.push(f"{self.function_signature} {{")
+        size = self.formatter.format_sizeof(self.message_type)
+        self.push(
+            f"return BpParallelBatch({self.adapter_name}, (void *)ms, {size}, s, "
+            f"{self.message_size_constant_name}, count, nthreads);",
+            indent=4,
+        )
+        self.push("}")
+
+
+class BlockMessageParallelBatchFunctions(BlockBindMessage[F], BlockWrapper[F]):
+    @override(BlockWrapper)
+    def wraps(self) -> Block[F]:
+        return BlockParallelGuard(
+            BlockMessageParallelBatch(self.d, is_encode=True),
+            BlockMessageParallelBatch(self.d, is_encode=False),
+            separator="\n\n",
+        )
+
+
+class BlockMessageRing(BlockMessageRingBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        if self.is_encode:
+            self.push("unsigned char *s = BpRingAcquire(r);", indent=4)
+            self.push("if (s == NULL) return BP_ERR_RING;", indent=4)
+            self.push(f"int ret = Encode{self.message_name}(m, s);", indent=4)
+            self.push("BpRingCommit(r);", indent=4)
+        else:
+            self.push("const unsigned char *s = BpRingPeek(r);", indent=4)
+            self.push("if (s == NULL) return BP_ERR_RING;", indent=4)
+            self.push(f"int ret = Decode{self.message_name}(m, s);", indent=4)
+            self.push("BpRingRelease(r);", indent=4)
+        self.push("return ret;", indent=4)
+        self.push("}")
+
+
+class BlockMessageRingFunctions(BlockBindMessage[F], BlockWrapper[F]):
+    @override(BlockWrapper)
+    def wraps(self) -> Block[F]:
+        return BlockRingGuard(
+            BlockMessageRing(self.d, is_encode=True),
+            BlockMessageRing(self.d, is_encode=False),
+            separator="\n\n",
+        )
+
+
+class BlockMessageMmsg(BlockMessageMmsgBase):
+    @override(Block)
+    def render(self) -> None:
+        size = self.message_size_constant_name
+        self.push(f"{self.function_signature} {{")
+        if self.is_encode:
+            self.push(f"int ret = {self.batch_function_name}(ms, count, s);", indent=4)
+            self.push("if (ret < 0) return ret;", indent=4)
+            self.push(f"return BpSendFrames(fd, s, {size}, count, flags);", indent=4)
+        else:
+            self.push(f"int n = BpRecvFrames(fd, s, {size}, count, flags);", indent=4)
+            self.push("if (n <= 0) return n;", indent=4)
+            self.push(f"int ret = {self.batch_function_name}(ms, (size_t)n, s);", indent=4)
+            self.push("return (ret < 0) ? ret : n;", indent=4)
+        self.push("}")
+
+
+class BlockMessageMmsgFunctions(BlockBindMessage[F], BlockWrapper[F]):
+    @override(BlockWrapper)
+    def wraps(self) -> Block[F]:
+        return BlockMmsgGuard(
+            BlockMessageMmsg(self.d, is_encode=True),
+            BlockMessageMmsg(self.d, is_encode=False),
+            separator="\n\n",
+        )
+
+
+class BlockMessageStreamDecoder(BlockMessageStreamDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.is_copy_plan(self.d):
+            return
+        decoder = self.formatter.format_bp_plan_decoder(self.d, "(void *)m")
+        self.push(f"{self.function_signature} {{")
+        self.push(f"*ctx = {decoder};", indent=4)
+        self.push("}")
+
+
+class BlockMessageSinkEncoder(BlockMessageSinkEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.is_copy_plan(self.d):
+            return
+        plan, n = self.formatter.format_bp_plan_and_length(self.d)
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            f"BpEncodePlanSink({plan}, {n}, {self.d.nbits()}, (void *)m, s, n, sink, "
+            "arg);",
+            indent=4,
+        )
+        self.push("}")
+
+
+class BlockMessageDeltaEncoder(BlockMessageDeltaEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        name = self.formatter.format_bp_message_descriptor_name(self.d)
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            f"return BpEncodeMessageDelta(&{name}, (void *)prev, (void *)cur, s);",
+            indent=4,
+        )
+        self.push("}")
+
+
+class BlockMessageDeltaDecoder(BlockMessageDeltaDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        name = self.formatter.format_bp_message_descriptor_name(self.d)
+        self.push(f"{self.function_signature} {{")
+        self.push("if (out != prev) *out = *prev;", indent=4)
+        self.push(f"return BpDecodeMessageDelta(&{name}, (void *)out, s, n);", indent=4)
+        self.push("}")
+
+
+class BlockMessageDeltaFunctions(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.is_delta(self.d):
+            return []
+        return [BlockMessageDeltaEncoder(self.d), BlockMessageDeltaDecoder(self.d)]
+
+
+class BlockMessageCheckedEncoder(BlockMessageCheckedEncoderBase):
+    @cached_property
+    def library_function(self) -> str:
+        return f"BpEncode{self.checksum.capitalize()}"
+
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        self.push(f"Encode{self.message_name}(m, s);", indent=4)
+        # Checksums the bytes just encoded, while they are hot in the cache.
+        size = self.message_size_constant_name
+        self.push(f"{self.library_function}(s, {size});", indent=4)
+        self.push("return 0;", indent=4)
+        self.push("}")
+
+
+class BlockMessageCheckedDecoder(BlockMessageCheckedDecoderBase):
+    @cached_property
+    def library_function(self) -> str:
+        return f"BpVerify{self.checksum.capitalize()}"
+
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            f"if (n < {self.checked_size_constant_name}) return BP_ERR_SHORT_INPUT;",
+            indent=4,
+        )
+        self.push(
+            f"if (!{self.library_function}(s, {self.message_size_constant_name})) "
+            "return BP_ERR_CHECKSUM;",
+            indent=4,
+        )
+        self.push(f"return Decode{self.message_name}N(m, s, n);", indent=4)
+        self.push("}")
+
+
+class BlockMessageCheckedFunctions(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.checksum(self.d.bound):
+            return []
+        return [BlockMessageCheckedEncoder(self.d), BlockMessageCheckedDecoder(self.d)]
+
+
+class BlockMessageJsonFormatter(BlockMessageJsonFormatterBase):
+    @override(Block)
+    def render(self) -> None:
+        json_formatter_name = self.formatter.format_bp_message_json_formatter_name(
+            self.d
+        )
+        self.push(f"{self.function_signature} {{")
+        self.push("struct BpJsonFormatContext ctx = BpJsonFormatContext(s);", indent=4)
+        self.push(f"{json_formatter_name}((void *)m, &ctx);", indent=4)
+        self.push("BpJsonFormatEnd(&ctx);", indent=4)
+        self.push("return ctx.n;", indent=4)
+        self.push("}")
+
+
+class BlockMessageBoundedJsonFormatter(BlockMessageBoundedJsonFormatterBase):
+    @override(Block)
+    def render(self) -> None:
+        json_formatter_name = self.formatter.format_bp_message_json_formatter_name(
+            self.d
+        )
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            "struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);", indent=4
+        )
+        self.push(f"{json_formatter_name}((void *)m, &ctx);", indent=4)
+        self.push("BpJsonFormatEnd(&ctx);", indent=4)
+        self.push("return ctx.n;", indent=4)
+        self.push("}")
+
+
+class BlockMessageFramedEncoder(BlockMessageFramedEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        size = self.payload_size_constant_name
+        overhead = f"BP_{self.framing.upper()}_OVERHEAD({size})"
+        library_function = f"Bp{self.framing.capitalize()}Encode"
+        self.push(f"{self.function_signature} {{")
+        # Frames in place, the payload is encoded after the bytes reserved.
+        self.push(
+            f"Encode{self.message_name}{self.payload_suffix}(m, s + {overhead});",
+            indent=4,
+        )
+        self.push(f"return {library_function}(s, {size});", indent=4)
+        self.push("}")
+
+
+class BlockMessageFramedDecoder(BlockMessageFramedDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        library_function = f"Bp{self.framing.capitalize()}Decode"
+        decoder = f"Decode{self.message_name}{self.payload_suffix or 'N'}"
+        self.push(f"{self.function_signature} {{")
+        self.push(f"n = {library_function}(s, n);", indent=4)
+        self.push("if (n < 0) return n;", indent=4)
+        self.push(f"return {decoder}(m, s, n);", indent=4)
+        self.push("}")
+
+
+class BlockMessageFramedFunctions(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.framing(self.d.bound):
+            return []
+        return [BlockMessageFramedEncoder(self.d), BlockMessageFramedDecoder(self.d)]
+
+
+class BlockMessageSinkJsonFormatter(BlockMessageSinkJsonFormatterBase):
+    @override(Block)
+    def render(self) -> None:
+        json_formatter_name = self.formatter.format_bp_message_json_formatter_name(
+            self.d
+        )
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            "struct BpJsonFormatContext ctx = "
+            "BpJsonFormatContextSink(s, n, sink, arg);",
+            indent=4,
+        )
+        self.push(f"{json_formatter_name}((void *)m, &ctx);", indent=4)
+        self.push("BpJsonFormatEnd(&ctx);", indent=4)
+        self.push("return ctx.n;", indent=4)
+        self.push("}")
+
+
+class BlockMessageJsonParser(BlockMessageJsonParserBase):
+    @override(Block)
+    def render(self) -> None:
+        parser_name = self.formatter.format_bp_message_json_parser_name(self.d)
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            "struct BpJsonParseContext ctx = BpJsonParseContext(s, n);", indent=4
+        )
+        self.push(f"{parser_name}((void *)m, &ctx);", indent=4)
+        self.push("return BpJsonParseEnd(&ctx);", indent=4)
+        self.push("}")
+
+
+class BlockMessageFunctions(BlockBindMessage[F], BlockComposition[F]):
+    def codec_blocks(self) -> List[Block[F]]:
+        if self.formatter.is_direct_codec(self.d):
+            # The same to optimization mode's, the rest stays in standard mode.
+            return [
+                BlockMessageNormalizerOpMode(self.d),
+                BlockMessageCurrentDecoderOpMode(self.d),
+                BlockMessageEncoderOpMode(self.d),
+                BlockMessageDecoderOpMode(self.d),
+                BlockMessageBoundedDecoderOpMode(self.d),
+                BlockMessageMaskedDecoderOpMode(self.d),
+                BlockMessageBatchEncoderOpMode(self.d),
+                BlockMessageBatchDecoderOpMode(self.d),
+            ]
+        return [
+            BlockMessageAheadChecksForAheadPlan(self.d),
+            BlockMessageEncoder(self.d),
+            BlockMessageDecoder(self.d),
+            BlockMessageBoundedDecoder(self.d),
+            BlockMessageMaskedDecoder(self.d),
+            BlockMessageBatchEncoder(self.d),
+            BlockMessageBatchDecoder(self.d),
+        ]
+
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if self.formatter.is_split_processors(self.d):
+            # Descriptors are only used by the json formatters then.
+            return [
+                BlockArrayProcessorForMessageFieldList(self.d),
+                BlockMessageProcessor(self.d),
+                BlockMessageSplitProcessor(self.d, is_encode=True),
+                BlockMessageSplitProcessor(self.d, is_encode=False),
+                BlockMessagePlanForCopyPlan(self.d),
+                *self.codec_blocks(),
+                BlockMessageParallelBatchFunctions(self.d),
+                BlockMessageRingFunctions(self.d),
+                BlockMessageMmsgFunctions(self.d),
+                BlockMessageStreamDecoder(self.d),
+                BlockMessageSinkEncoder(self.d),
+                BlockMessageCheckedFunctions(self.d),
+                BlockMessageFramedFunctions(self.d),
+                BlockMessageHash(self.d),
+                BlockMessageEqual(self.d),
+            BlockMessageSelfTest(self.d),
+                BlockJsonGuard(
+                    BlockArrayDescriptorForMessageFieldList(self.d),
+                    BlockArrayJsonFormatterForMessageFieldList(self.d),
+                    BlockMessageFieldDescriptorsForNonEmpty(self.d),
+                    BlockMessageDescriptor(self.d),
+                    BlockMessageBpJsonFormatter(self.d),
+                    BlockMessageJsonFormatter(self.d),
+                    BlockMessageBoundedJsonFormatter(self.d),
+                    BlockMessageSinkJsonFormatter(self.d),
+                    BlockArrayJsonParserForMessageFieldList(self.d),
+                    BlockMessageBpJsonParser(self.d),
+                    BlockMessageJsonParser(self.d),
+                    separator="\n\n",
+                ),
+            ]
+        return [
+            BlockFixedProcessorForMessageFieldList(self.d),
+            BlockArrayDescriptorForMessageFieldList(self.d),
+            BlockArrayProcessorForMessageFieldList(self.d),
+            BlockRangeProcessorForMessageFieldList(self.d),
+            BlockJsonGuard(
+                BlockArrayJsonFormatterForMessageFieldList(self.d), separator="\n\n"
+            ),
+            BlockMessageFieldDescriptorsForNonEmpty(self.d),
+            BlockMessageDescriptor(self.d),
+            BlockMessageProcessor(self.d),
+            BlockMessagePlanForCopyPlan(self.d),
+            *self.codec_blocks(),
+            BlockMessageParallelBatchFunctions(self.d),
+            BlockMessageRingFunctions(self.d),
+            BlockMessageMmsgFunctions(self.d),
+            BlockMessageStreamDecoder(self.d),
+            BlockMessageSinkEncoder(self.d),
+            BlockMessageDeltaFunctions(self.d),
+            BlockMessageCheckedFunctions(self.d),
+            BlockMessageFramedFunctions(self.d),
+            BlockMessageHash(self.d),
+            BlockMessageEqual(self.d),
+            BlockMessageSelfTest(self.d),
+            BlockJsonGuard(
+                BlockMessageBpJsonFormatter(self.d),
+                BlockMessageJsonFormatter(self.d),
+                BlockMessageBoundedJsonFormatter(self.d),
+                BlockMessageSinkJsonFormatter(self.d),
+                BlockArrayJsonParserForMessageFieldList(self.d),
+                BlockMessageBpJsonParser(self.d),
+                BlockMessageJsonParser(self.d),
+                separator="\n\n",
+            ),
+        ]
+
+
+class BlockEnumValuesTable(BlockBindEnum[F]):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.has_enum_values_table(self.d):
+            return
+        self.push_comment(f"Bitmap of values declared in enum {self.enum_name}")
+        self.push(self.formatter.format_bp_enum_values_table(self.d))
+
+
+class BlockEnumValidator(BlockEnumValidatorBase):
+    """Validates an enum just decoded by the bitproto library, see BpValidatedEnum."""
+
+    @override(Block)
+    def render(self) -> None:
+        enum_type = self.formatter.format_enum_type(self.d)
+        check = self.formatter.format_bp_enum_check_statement(
+            self.d, "v", "ctx->err"
+        )
+        self.push(f"{self.function_signature} {{")
+        self.push(f"{enum_type} v = *({enum_type} *)data;", indent=4)
+        self.push(check, indent=4)
+        self.push("}")
+
+
+class BlockEnumFunctions(BlockBindEnum[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [BlockEnumValuesTable(self.d), BlockEnumValidator(self.d)]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
+class BlockOneofBase(BlockBindOneof[F]):
+    def format_variant_function_name(self, v: OneofVariant, is_encode: bool) -> str:
+        """Returns the name of the static encoder (decoder) of given variant."""
+        prefix = "BpEncode" if is_encode else "BpDecode"
+        return f"{prefix}{self.oneof_name}{pascal_case(v.name)}"
+
+    def format_table_name(self, is_encode: bool) -> str:
+        """Returns the name of the jump table of the encoders (decoders)."""
+        prefix = "BpEncode" if is_encode else "BpDecode"
+        return f"{prefix}{self.oneof_name}Table"
+
+    def format_function_pointer(self, name: str, is_encode: bool) -> str:
+        """Formats the declarator of a pointer of given name to a variant's encoder
+        (decoder)."""
+        if is_encode:
+            return (
+                f"int (*{name})(const struct {self.oneof_name} *BP_RESTRICT, "
+                "unsigned char *BP_RESTRICT)"
+            )
+        return f"int (*{name})(struct {self.oneof_name} *, const unsigned char *, int)"
+
+
+class BlockOneofVariantEncoder(BlockOneofBase):
+    def __init__(self, *args: Any, v: OneofVariant, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.v = v
+
+    @override(Block)
+    def render(self) -> None:
+        name = self.format_variant_function_name(self.v, True)
+        self.push(
+            f"static int {name}(const struct {self.oneof_name} *BP_RESTRICT m, "
+            "unsigned char *BP_RESTRICT s) {"
+        )
+        # The tag shares its byte with the leading bits of the variant, which are
+        # or-ed after it.
+        self.push(f"s[0] = {self.format_variant_tag_constant_name(self.v)};", indent=4)
+        l = self.formatter.format_op_mode_endecode_oneof_variant(self.v, True)
+        push_op_mode_statements(self, l, 4)
+        self.push(f"return {self.format_variant_nbytes(self.v)};", indent=4)
+        self.push("}")
+
+
+class BlockOneofVariantDecoder(BlockOneofBase):
+    def __init__(self, *args: Any, v: OneofVariant, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.v = v
+
+    @override(Block)
+    def render(self) -> None:
+        name = self.format_variant_function_name(self.v, False)
+        self.push(
+            f"static int {name}(struct {self.oneof_name} *m, "
+            "const unsigned char *s, int n) {"
+        )
+        nbytes = self.format_variant_nbytes(self.v)
+        self.push(f"if (n < {nbytes}) return BP_ERR_SHORT_INPUT;", indent=4)
+        if has_validated_enums(self.v.message):
+            # Sets to BP_ERR_ENUM by the statements checking enums decoded.
+            self.push("int err = 0;", indent=4)
+        self.push(
+            f"(*m).tag = {self.format_variant_tag_constant_name(self.v)};", indent=4
+        )
+        l = self.formatter.format_op_mode_endecode_oneof_variant(self.v, False)
+        push_op_mode_statements(self, l, 4)
+        ret = self.formatter.format_bp_decoder_return(self.v.message, "err")
+        self.push(ret, indent=4)
+        self.push("}")
+
+
+class BlockOneofJumpTable(BlockOneofBase):
+    """Jump table of the encoders (decoders) of the variants, indexed by the tag,
+    NULL for the tags not declared."""
+
+    def __init__(self, *args: Any, is_encode: bool, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.is_encode = is_encode
+
+    @override(Block)
+    def render(self) -> None:
+        kind = "encoders" if self.is_encode else "decoders"
+        self.push_comment(
+            f"Jump table of the {kind} of the variants of struct {self.oneof_name}, "
+            "indexed by the tag."
+        )
+        name = self.format_table_name(self.is_encode)
+        declarator = f"const {name}[{self.oneof_tag_table_size}]"
+        self.push(
+            f"static {self.format_function_pointer(declarator, self.is_encode)} = {{"
+        )
+        tag_to_variant = {v.tag: v for v in self.d.variants()}
+        for tag in range(self.oneof_tag_table_size):
+            v = tag_to_variant.get(tag, None)
+            if v is None:
+                self.push("NULL,", indent=4)
+            else:
+                function_name = self.format_variant_function_name(v, self.is_encode)
+                self.push(f"{function_name},", indent=4)
+        self.push("};")
+
+
+class BlockOneofEncoder(BlockOneofEncoderBase, BlockOneofBase):
+    @override(Block)
+    def render(self) -> None:
+        table = self.format_table_name(True)
+        self.push(f"{self.function_signature} {{")
+        # The tag is an uint8_t, which can't exceed a table of 256 slots.
+        if self.oneof_tag_table_size < 256:
+            self.push(
+                f"if ((*m).tag >= {self.oneof_tag_table_size}) return BP_ERR_TAG;",
+                indent=4,
+            )
+        self.push(f"if ({table}[(*m).tag] == NULL) return BP_ERR_TAG;", indent=4)
+        self.push(f"return {table}[(*m).tag](m, s);", indent=4)
+        self.push("}")
+
+
+class BlockOneofDecoder(BlockOneofDecoderBase, BlockOneofBase):
+    @override(Block)
+    def render(self) -> None:
+        table = self.format_table_name(False)
+        self.push(f"{self.function_signature} {{")
+        self.push("if (n < 1) return BP_ERR_SHORT_INPUT;", indent=4)
+        f = self.format_function_pointer("f", False)
+        self.push(f"{f} = {table}[s[0] & {self.oneof_tag_mask}];", indent=4)
+        self.push("if (f == NULL) return BP_ERR_TAG;", indent=4)
+        self.push("return f(m, s, n);", indent=4)
+        self.push("}")
+
+
+class BlockOneofFunctions(BlockBindOneof[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = []
+        for v in self.d.sorted_variants():
+            b.append(BlockOneofVariantEncoder(self.d, v=v))
+            b.append(BlockOneofVariantDecoder(self.d, v=v))
+        b.append(BlockOneofJumpTable(self.d, is_encode=True))
+        b.append(BlockOneofJumpTable(self.d, is_encode=False))
+        b.append(BlockOneofEncoder(self.d))
+        b.append(BlockOneofDecoder(self.d))
+        return b
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
 
 
 class BlockBoundDefinitionList(BlockBoundDefinitionDispatcher[F]):
     @override(BlockBoundDefinitionDispatcher)
     def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if not self.is_reachable(d):
+            return None
         if isinstance(d, Alias):
             return BlockAliasFunctions(d)
+        if isinstance(d, Enum) and is_validated_enum(d):
+            return BlockEnumFunctions(d)
         if isinstance(d, Message):
             return BlockMessageFunctions(d)
+        if isinstance(d, Oneof):
+            return BlockOneofFunctions(d)
         return None
 
 
@@ -398,6 +2003,7 @@ class BlockList(BlockComposition[F]):
         return [
             BlockAheadNotice(),
             BlockInclude(),
+            BlockHelperFunctionsDirect(),
             BlockBoundDefinitionList(),
         ]
 
@@ -406,37 +2012,507 @@ class BlockIncludeOpMode(Block[F]):
     @override(Block)
     def render(self) -> None:
         header_filename = self.formatter.format_out_filename(self.bound, extension=".h")
+        self.push("#include <string.h>")
+        self.push("")
         self.push(f'#include "{header_filename}"')
 
 
+class BlockHelperFunctionsOpMode(Block[F]):
+    """Helper functions to decode extensible types in optimization mode.
+    Rendered only if there are messages not in fixed size to render."""
+
+    def has_messages_not_fixed_size(self) -> bool:
+        for _, d in self.bound.filter(Message, recursive=True, bound=self.bound):
+            if is_op_mode_message(self, d) and not d.is_fixed_size():
+                return True
+        return False
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.has_messages_not_fixed_size():
+            return
+        self.push_comment(
+            "BpOpCopyBits copies nbits bits from buffer s starting at bit i to buffer t"
+        )
+        self.push_comment(
+            "starting at bit p. Skips if the bits are out of the n bytes of buffer s,"
+        )
+        self.push_comment("n = -1 disables the checking.")
+        self.push(
+            "static void BpOpCopyBits(unsigned char *t, int p, const unsigned char *s, "
+            "int i, int nbits, int n) {"
+        )
+        self.push("if (n >= 0 && ((i + nbits + 7) >> 3) > n) return;", indent=4)
+        self.push("while (nbits > 0) {", indent=4)
+        self.push("int c = 8 - (p & 7);", indent=8)
+        self.push("if (8 - (i & 7) < c) c = 8 - (i & 7);", indent=8)
+        self.push("if (nbits < c) c = nbits;", indent=8)
+        self.push(
+            "unsigned char mask = (unsigned char)(((1 << c) - 1) << (p & 7));", indent=8
+        )
+        self.push(
+            "unsigned char b = (unsigned char)((s[i >> 3] >> (i & 7)) << (p & 7));",
+            indent=8,
+        )
+        self.push(
+            "t[p >> 3] = (unsigned char)((t[p >> 3] & ~mask) | (b & mask));", indent=8
+        )
+        self.push("p += c;", indent=8)
+        self.push("i += c;", indent=8)
+        self.push("nbits -= c;", indent=8)
+        self.push("}", indent=4)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "BpOpReadAhead reads the ahead flag of an extensible type at bit i of buffer s."
+        )
+        self.push("static uint16_t BpOpReadAhead(const unsigned char *s, int i, int n) {")
+        self.push("unsigned char b[2] = {0, 0};", indent=4)
+        self.push("BpOpCopyBits(b, 0, s, i, 16, n);", indent=4)
+        self.push("return (uint16_t)(b[0] | (b[1] << 8));", indent=4)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "BpOpWriteAhead writes the ahead flag v of an extensible type at bit p of buffer t."
+        )
+        self.push("static void BpOpWriteAhead(unsigned char *t, int p, uint16_t v) {")
+        self.push(
+            "unsigned char b[2] = {(unsigned char)v, (unsigned char)(v >> 8)};", indent=4
+        )
+        self.push("BpOpCopyBits(t, p, b, 0, 16, -1);", indent=4)
+        self.push("}")
+
+
+class BlockBoolArrayHelperFunctionsOpMode(Block[F]):
+    """Helper functions to pack and unpack 8 bools at a time in the loops of bool
+    arrays in optimization mode, the same multiply-and-mask tricks to the bitproto C
+    lib's. Rendered only if there are such loops in the messages to render."""
+
+    def has_bool_array_loops(self, t: Type) -> bool:
+        if isinstance(t, Alias):
+            return self.has_bool_array_loops(t.type)
+        if isinstance(t, Message):
+            return any(
+                self.has_bool_array_loops(self.formatter.field_type(f))
+                for f in t.sorted_fields()
+            )
+        if isinstance(t, Array):
+            if self.formatter.op_mode_is_bool_array(t):
+                return self.formatter.op_mode_is_array_loopable(t)
+            return self.has_bool_array_loops(t.element_type)
+        return False
+
+    @override(Block)
+    def render(self) -> None:
+        messages = [
+            d
+            for _, d in self.bound.filter(Message, recursive=True, bound=self.bound)
+            if is_op_mode_message(self, d)
+        ]
+        # Variants of oneofs are always encoded by the statements of optimization
+        # mode.
+        for _, oneof in self.bound.oneofs(bound=self.bound):
+            messages.extend(v.message for v in oneof.variants())
+        if not any(self.has_bool_array_loops(d) for d in messages):
+            return
+        self.push_comment("BpOpPackBools packs the 8 bools at p into a byte.")
+        self.push("static inline unsigned char BpOpPackBools(const void *p) {")
+        self.push("uint64_t v;", indent=4)
+        self.push("memcpy(&v, p, 8);", indent=4)
+        self.push("v &= 0x0101010101010101ULL;", indent=4)
+        self.push("#if BP_BIG_ENDIAN")
+        self.push(
+            "return (unsigned char)((v * 0x8040201008040201ULL) >> 56);", indent=4
+        )
+        self.push("#else")
+        self.push(
+            "return (unsigned char)((v * 0x0102040810204080ULL) >> 56);", indent=4
+        )
+        self.push("#endif")
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "BpOpUnpackBools unpacks the 8 bits of byte b into the 8 bools at p."
+        )
+        self.push("static inline void BpOpUnpackBools(void *p, unsigned char b) {")
+        self.push("uint64_t v = b * 0x0101010101010101ULL;", indent=4)
+        self.push("#if BP_BIG_ENDIAN")
+        self.push("v &= 0x0102040810204080ULL;", indent=4)
+        self.push("#else")
+        self.push("v &= 0x8040201008040201ULL;", indent=4)
+        self.push("#endif")
+        self.push(
+            "v = ((v + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL;", indent=4
+        )
+        self.push("memcpy(p, &v, 8);", indent=4)
+        self.push("}")
+
+
+class BlockChecksumHelperFunctionsOpMode(Block[F]):
+    """Helper functions to append and verify the checksum in optimization mode, the
+    same to the bitproto C lib's, rendered only with option c.checksum."""
+
+    @override(Block)
+    def render(self) -> None:
+        checksum = self.formatter.checksum(self.bound)
+        if not checksum:
+            return
+        nbytes = self.formatter.checksum_nbytes(self.bound)
+        self.push_comment(f"BpOpChecksum returns the {checksum} of the n bytes at s.")
+        self.push("static uint32_t BpOpChecksum(const unsigned char *s, int n) {")
+        if checksum == "crc8":
+            self.push("uint32_t c = 0x00;", indent=4)
+            self.push("for (int k = 0; k < n; k++) {", indent=4)
+            self.push("c ^= s[k];", indent=8)
+            self.push("for (int b = 0; b < 8; b++)", indent=8)
+            self.push("c = ((c << 1) ^ ((c & 0x80) ? 0x07 : 0)) & 0xff;", indent=12)
+            self.push("}", indent=4)
+            self.push("return c;", indent=4)
+        elif checksum == "crc16":
+            self.push("uint32_t c = 0xffff;", indent=4)
+            self.push("for (int k = 0; k < n; k++) {", indent=4)
+            self.push("c ^= ((uint32_t)s[k]) << 8;", indent=8)
+            self.push("for (int b = 0; b < 8; b++)", indent=8)
+            self.push("c = ((c << 1) ^ ((c & 0x8000) ? 0x1021 : 0)) & 0xffff;", indent=12)
+            self.push("}", indent=4)
+            self.push("return c;", indent=4)
+        else:
+            self.push("uint32_t c = 0xffffffff;", indent=4)
+            self.push("for (int k = 0; k < n; k++) {", indent=4)
+            self.push("c ^= s[k];", indent=8)
+            self.push("for (int b = 0; b < 8; b++)", indent=8)
+            self.push("c = (c >> 1) ^ ((c & 1) ? 0xedb88320 : 0);", indent=12)
+            self.push("}", indent=4)
+            self.push("return ~c;", indent=4)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "BpOpEncodeChecksum writes the checksum of the n bytes at s right after them."
+        )
+        self.push("static void BpOpEncodeChecksum(unsigned char *s, int n) {")
+        self.push("uint32_t c = BpOpChecksum(s, n);", indent=4)
+        self.push(
+            f"for (int k = 0; k < {nbytes}; k++) s[n + k] = (unsigned char)(c >> (8 * k));",
+            indent=4,
+        )
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "BpOpVerifyChecksum returns 1 if the n bytes at s match the checksum after them."
+        )
+        self.push("static int BpOpVerifyChecksum(const unsigned char *s, int n) {")
+        self.push("uint32_t c = 0;", indent=4)
+        self.push(
+            f"for (int k = 0; k < {nbytes}; k++) c |= ((uint32_t)s[n + k]) << (8 * k);",
+            indent=4,
+        )
+        self.push("return BpOpChecksum(s, n) == c;", indent=4)
+        self.push("}")
+
+
+class BlockHelperFunctionsDirect(Block[F]):
+    """The helper functions of optimization mode for the messages with option
+    direct_codec in standard mode. Guarded by macros, the amalgamation of many protos
+    defines them once."""
+
+    def render_guarded(self, block: Block[F], macro: str) -> None:
+        block._render_with_ctx(self._get_ctx_or_raise())
+        if block._is_empty():
+            return
+        if not self._is_empty():
+            self.push_empty_line()
+        self.push(f"#ifndef {macro}")
+        self.push(f"#define {macro} 1")
+        self.push(block._collect(), indent=0)
+        self.push("#endif")
+
+    @override(Block)
+    def render(self) -> None:
+        self.render_guarded(BlockHelperFunctionsOpMode(), "BP_OP_HELPERS")
+        self.render_guarded(
+            BlockBoolArrayHelperFunctionsOpMode(), "BP_OP_BOOL_ARRAY_HELPERS"
+        )
+
+
+class BlockMessageNormalizerOpMode(BlockBindMessage[F]):
+    """Normalizer copies the bits of a message not in fixed size into the layout of
+    current version, for the decoder to decode with the bit offsets known at compile time.
+    """
+
+    @override(Block)
+    def render(self) -> None:
+        if self.d.is_fixed_size():
+            return
+        name = self.formatter.format_op_mode_normalizer_name(self.d)
+        self.push_comment(
+            f"{name} copies struct {self.message_name} encoded in buffer s of n bytes into "
+            "buffer t"
+        )
+        self.push_comment(
+            "in the layout of current version, returns the number of bits processed."
+        )
+        self.push(
+            f"static int {name}(unsigned char *t, const unsigned char *s, int n) {{"
+        )
+        self.push("int i = 0;", indent=4)
+        for line in self.formatter.format_op_mode_normalizer(self.d):
+            self.push(line, indent=4)
+        self.push("return i;", indent=4)
+        self.push("}")
+
+
 class BlockMessageEncoderOpMode(BlockMessageEncoderBase):
     @override(Block)
     def render(self) -> None:
+        size = self.message_size_constant_name
         self.push(f"{self.function_signature} {{")
+        self.push(self.formatter.format_bp_trace(self.d, "BEGIN", True, size), indent=4)
         l = self.formatter.format_op_mode_encode_message(self.d)
-        for line in l:
-            self.push(line, indent=4)
+        push_op_mode_statements(self, l, 4)
+        self.push(self.formatter.format_bp_trace(self.d, "END", True, size), indent=4)
         self.push("return 0;", indent=4)
         self.push("}")
 
 
+class BlockMessageCurrentDecoderOpMode(BlockBindMessage[F]):
+    """Decodes a message not in fixed size from a buffer in the layout of current
+    version, with the bit offsets known at compile time."""
+
+    @override(Block)
+    def render(self) -> None:
+        if self.d.is_fixed_size():
+            return
+        name = self.formatter.format_op_mode_current_decoder_name(self.d)
+        message_type = self.formatter.format_message_type(self.d)
+        self.push_comment(
+            f"{name} decodes struct {self.message_name} from buffer s in the layout of "
+            "current version."
+        )
+        if not has_validated_enums(self.d):
+            self.push(
+                f"static void {name}({message_type} *m, const unsigned char *s) {{"
+            )
+            l = self.formatter.format_op_mode_decode_message(self.d)
+            push_op_mode_statements(self, l, 4)
+            self.push("}")
+            return
+        # Returns BP_ERR_ENUM if an enum decoded holds a value not declared.
+        self.push(
+            f"static int {name}({message_type} *m, const unsigned char *s) {{"
+        )
+        self.push("int err = 0;", indent=4)
+        l = self.formatter.format_op_mode_decode_message(self.d)
+        push_op_mode_statements(self, l, 4)
+        self.push("return err;", indent=4)
+        self.push("}")
+
+
 class BlockMessageDecoderOpMode(BlockMessageDecoderBase):
+    def render_not_fixed_size(self) -> None:
+        # Buffers encoded by current version are decoded as they are, others are
+        # normalized into the layout of current version at first.
+        name = self.formatter.format_op_mode_normalizer_name(self.d)
+        decoder = self.formatter.format_op_mode_current_decoder_name(self.d)
+        checks = self.formatter.format_op_mode_ahead_checks(self.d)
+        # The error code of enums to validate is returned by the decoder.
+        err = "err = " if has_validated_enums(self.d) else ""
+        self.push(f"if ({checks[0]}", indent=4)
+        for check in checks[1:]:
+            self.push_string(" &&", separator="")
+            self.push(check, indent=8)
+        self.push_string(") {", separator="")
+        self.push(f"{err}{decoder}(m, s);", indent=8)
+        self.push("} else {", indent=4)
+        self.push(
+            f"unsigned char t[{self.message_size_constant_name}] = {{0}};", indent=8
+        )
+        self.push(f"{name}(t, s, -1);", indent=8)
+        self.push(f"{err}{decoder}(m, t);", indent=8)
+        self.push("}", indent=4)
+
     @override(Block)
     def render(self) -> None:
+        size = self.message_size_constant_name
         self.push(f"{self.function_signature} {{")
-        l = self.formatter.format_op_mode_decode_message(self.d)
-        for line in l:
-            self.push(line, indent=4)
+        self.push(
+            self.formatter.format_bp_trace(self.d, "BEGIN", False, size), indent=4
+        )
+        if has_validated_enums(self.d):
+            # Sets to BP_ERR_ENUM by the statements checking enums decoded.
+            self.push("int err = 0;", indent=4)
+        if self.d.is_fixed_size():
+            l = self.formatter.format_op_mode_decode_message(self.d)
+            push_op_mode_statements(self, l, 4)
+        else:
+            self.render_not_fixed_size()
+        self.push(self.formatter.format_bp_trace(self.d, "END", False, size), indent=4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageMaskedDecoderOpMode(BlockMessageMaskedDecoderBase):
+    """Bit offsets of the fields are known at compile time, the statements of the
+    fields not selected are just jumped over."""
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.has_masked_decoder:
+            return
+        self.push(f"{self.function_signature} {{")
+        if has_validated_enums(self.d):
+            # Sets to BP_ERR_ENUM by the statements checking enums decoded.
+            self.push("int err = 0;", indent=4)
+        if not self.d.is_fixed_size():
+            # The same to the decoder, buffers in other layouts are normalized.
+            name = self.formatter.format_op_mode_normalizer_name(self.d)
+            checks = self.formatter.format_op_mode_ahead_checks(self.d)
+            self.push(f"unsigned char t[{self.message_size_constant_name}];", indent=4)
+            self.push(f"if (!({checks[0]}", indent=4)
+            for check in checks[1:]:
+                self.push_string(" &&", separator="")
+                self.push(check, indent=10)
+            self.push_string(")) {", separator="")
+            self.push("memset(t, 0, sizeof(t));", indent=8)
+            self.push(f"{name}(t, s, -1);", indent=8)
+            self.push("s = t;", indent=8)
+            self.push("}", indent=4)
+        fields = self.d.sorted_fields()
+        statements = self.formatter.format_op_mode_decode_message_fields(self.d)
+        for field, l in zip(fields, statements):
+            mask = self.format_field_mask_constant_name(field)
+            self.push(f"if (mask & {mask}) {{", indent=4)
+            push_op_mode_statements(self, l, 8)
+            self.push("}", indent=4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageBoundedDecoderOpMode(BlockMessageBoundedDecoderBase):
+    def render_not_fixed_size(self) -> None:
+        # The layout of current version fits in the size checked, while extensible
+        # types inside of other versions may take more bytes than the size.
+        size = self.message_size_constant_name
+        name = self.formatter.format_op_mode_normalizer_name(self.d)
+        decoder = self.formatter.format_op_mode_current_decoder_name(self.d)
+        checks = self.formatter.format_op_mode_ahead_checks(self.d)
+        self.push(f"if (!({checks[0]}", indent=4)
+        for check in checks[1:]:
+            self.push_string(" &&", separator="")
+            self.push(check, indent=10)
+        self.push_string(")) {", separator="")
+        self.push(f"unsigned char t[{size}] = {{0}};", indent=8)
+        self.push(
+            f"if ({name}(t, s, n) > (n << 3)) return BP_ERR_SHORT_INPUT;", indent=8
+        )
+        self.push(f"return Decode{self.message_name}(m, t);", indent=8)
+        self.push("}", indent=4)
+        self.push(self.formatter.format_bp_trace(self.d, "BEGIN", False, size), indent=4)
+        if has_validated_enums(self.d):
+            self.push(f"int err = {decoder}(m, s);", indent=4)
+        else:
+            self.push(f"{decoder}(m, s);", indent=4)
+        self.push(self.formatter.format_bp_trace(self.d, "END", False, size), indent=4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "err"), indent=4)
+
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            f"if (n < {self.message_size_constant_name}) return BP_ERR_SHORT_INPUT;",
+            indent=4,
+        )
+        if not self.d.is_fixed_size():
+            self.render_not_fixed_size()
+        else:
+            self.push(f"return Decode{self.message_name}(m, s);", indent=4)
+        self.push("}")
+
+
+class BlockMessageBatchEncoderOpMode(BlockMessageBatchEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        # The statements for a single record are unrolled in the loop body.
+        self.push(f"{self.function_signature} {{")
+        self.push(
+            f"for (size_t k = 0; k < count; k++, s += {self.message_size_constant_name}) {{",
+            indent=4,
+        )
+        l = self.formatter.format_op_mode_encode_message(self.d)
+        if op_mode_statements_use_message(l):
+            self.push(f"const {self.message_type} *m = &ms[k];", indent=8)
+        push_op_mode_statements(self, l, 8)
+        self.push("}", indent=4)
         self.push("return 0;", indent=4)
         self.push("}")
 
 
+class BlockMessageBatchDecoderOpMode(BlockMessageBatchDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        # The statements for a single record are unrolled in the loop body.
+        validated = has_validated_enums(self.d)
+        self.push(f"{self.function_signature} {{")
+        if validated:
+            self.push("int err = 0;", indent=4)
+        self.push(
+            f"for (size_t k = 0; k < count; k++, s += {self.message_size_constant_name}) {{",
+            indent=4,
+        )
+        if not self.d.is_fixed_size():
+            call = f"Decode{self.message_name}(&ms[k], s)"
+            if validated:
+                self.push(f"if ({call} != 0) err = BP_ERR_ENUM;", indent=8)
+            else:
+                self.push(f"{call};", indent=8)
+        else:
+            l = self.formatter.format_op_mode_decode_message(self.d)
+            if op_mode_statements_use_message(l):
+                self.push(f"{self.message_type} *m = &ms[k];", indent=8)
+            push_op_mode_statements(self, l, 8)
+        self.push("}", indent=4)
+        self.push(self.formatter.format_bp_decoder_return(self.d, "err"), indent=4)
+        self.push("}")
+
+
+class BlockMessageCheckedEncoderOpMode(BlockMessageCheckedEncoder):
+    @cached_property
+    def library_function(self) -> str:
+        return "BpOpEncodeChecksum"
+
+
+class BlockMessageCheckedDecoderOpMode(BlockMessageCheckedDecoder):
+    @cached_property
+    def library_function(self) -> str:
+        return "BpOpVerifyChecksum"
+
+
+class BlockMessageCheckedFunctionsOpMode(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.checksum(self.d.bound):
+            return []
+        return [
+            BlockMessageCheckedEncoderOpMode(self.d),
+            BlockMessageCheckedDecoderOpMode(self.d),
+        ]
+
+
 class BlockMessageFunctionsOpMode(BlockBindMessage[F], BlockComposition[F]):
     @override(BlockComposition)
     def blocks(self) -> List[Block[F]]:
         return [
+            BlockMessageNormalizerOpMode(self.d),
+            BlockMessageCurrentDecoderOpMode(self.d),
             BlockMessageEncoderOpMode(self.d),
             BlockMessageDecoderOpMode(self.d),
+            BlockMessageBoundedDecoderOpMode(self.d),
+            BlockMessageMaskedDecoderOpMode(self.d),
+            BlockMessageBatchEncoderOpMode(self.d),
+            BlockMessageBatchDecoderOpMode(self.d),
+            BlockMessageCheckedFunctionsOpMode(self.d),
+            BlockMessageHash(self.d),
+            BlockMessageEqual(self.d),
+            BlockMessageSelfTest(self.d),
         ]
 
 
@@ -450,6 +2526,10 @@ class BlockBoundDefinitionListOpMode(BlockBoundDefinitionDispatcher[F]):
                 if d.name not in filter_messages:
                     return None
             return BlockMessageFunctionsOpMode(d)
+        if isinstance(d, Enum):
+            return BlockEnumValuesTable(d)
+        if isinstance(d, Oneof):
+            return BlockOneofFunctions(d)
         return None
 
 
@@ -459,10 +2539,103 @@ class BlockListOpMode(BlockComposition[F]):
         return [
             BlockAheadNotice(),
             BlockIncludeOpMode(),
+            BlockHelperFunctionsOpMode(),
+            BlockBoolArrayHelperFunctionsOpMode(),
+            BlockChecksumHelperFunctionsOpMode(),
             BlockBoundDefinitionListOpMode(),
         ]
 
 
+class BlockProtoListAmalgamation(Block[F]):
+    """Renders the block made by given factory for each proto in the amalgamation,
+    the imported protos first, each with the render context bound to it."""
+
+    def __init__(
+        self, factory: Callable[[], Block[F]], separator: str = "\n\n"
+    ) -> None:
+        super().__init__()
+        self.factory = factory
+        self.proto_separator = separator
+
+    def protos(self) -> List[Proto]:
+        protos: List[Proto] = []
+        for _, proto in self.bound.protos(recursive=True):
+            # A proto imported by many is parsed as many.
+            key = proto.filepath or proto.name
+            if all(key != (p.filepath or p.name) for p in protos):
+                protos.append(proto)
+        protos.reverse()  # Nested imports first.
+        protos.append(self.bound)
+        return protos
+
+    @override(Block)
+    def render(self) -> None:
+        ctx = self._get_ctx_or_raise()
+        strings: List[str] = []
+        for proto in self.protos():
+            block = self.factory()
+            block._render_with_ctx(replace(ctx, bound=proto, root=self.bound))
+            if not block._is_empty():
+                strings.append(block._collect())
+        if strings:
+            self.push(self.proto_separator.join(strings), indent=0)
+
+
+class BlockIncludeAmalgamation(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        c_filename = self.formatter.format_out_filename(self.bound, extension=".c")
+        self.push_comment(
+            f"Amalgamation of {c_filename}, the c files of the protos it imports and the"
+        )
+        self.push_comment(
+            "bitproto C library, to compile as the only c file of them, without"
+        )
+        self.push_comment(
+            "bitproto.c. Functions but the encoders and decoders have internal linkage."
+        )
+        self.push("#ifndef BITPROTO_INLINE")
+        self.push("#define BITPROTO_INLINE 1")
+        self.push("#endif")
+        self.push_empty_line()
+        self.push('#include "bitproto.c"')
+        self.push_empty_line()
+        self.push("#include <string.h>")
+
+
+class BlockFunctionDeclarationsForInternalAmalgamation(Block[F]):
+    """Declares the internal functions of the proto static ahead of its header, whose
+    declarations and the definitions then inherit the internal linkage."""
+
+    @override(Block)
+    def render(self) -> None:
+        block = BlockFunctionDeclarationsForInternalList()
+        block._render_with_ctx(self._get_ctx_or_raise())
+        for line in block._collect().splitlines():
+            if line and not line.startswith("#"):
+                line = f"static {line}"
+            self.push(line, indent=0)
+
+
+class BlockIncludeHeaderAmalgamation(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push(self.formatter.format_import_statement(self.bound))
+
+
+class BlockListAmalgamation(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockAheadNotice(),
+            BlockIncludeAmalgamation(),
+            BlockProtoListAmalgamation(BlockFunctionDeclarationsForInternalAmalgamation),
+            BlockProtoListAmalgamation(BlockIncludeHeaderAmalgamation, separator="\n"),
+            BlockProtoListAmalgamation(BlockHelperFunctionsDirect),
+            BlockProtoListAmalgamation(BlockBoundDefinitionList),
+        ]
+
+
 class RendererC(Renderer[F]):
     """Renderer for C language (c file)."""
 
@@ -487,3 +2660,20 @@ class RendererC(Renderer[F]):
         if self.optimization_mode:
             return BlockListOpMode()
         return BlockList()
+
+
+class RendererCAmalgamation(RendererC):
+    """Renderer for C language (amalgamated c file of a proto tree and the library).
+    Optimization mode isn't supported, where the c files need no library."""
+
+    @override(Renderer)
+    def file_extension(self) -> str:
+        return "_amalgamation.c"
+
+    @override(Renderer)
+    def support_optimization(self) -> bool:
+        return False
+
+    @override(Renderer)
+    def block(self) -> Block[F]:
+        return BlockListAmalgamation()
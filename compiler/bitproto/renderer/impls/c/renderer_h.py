@@ -2,9 +2,26 @@
 Renderer for C header file.
 """
 
-from typing import List, Optional
-
-from bitproto._ast import Alias, Array, BoundDefinition, Constant, Enum, Message
+from typing import Any, List, Optional
+
+from bitproto._ast import (
+    Alias,
+    Array,
+    BoundDefinition,
+    Constant,
+    Enum,
+    Message,
+    MessageField,
+    Oneof,
+    Type,
+)
+from bitproto.errors import BoundedStackUnsupported
+from bitproto.layout import (
+    flat_field_layouts,
+    has_validated_enums,
+    is_validated_enum,
+    resolve_alias,
+)
 from bitproto.renderer.block import (
     Block,
     BlockAheadNotice,
@@ -14,6 +31,7 @@ from bitproto.renderer.block import (
     BlockBindEnumField,
     BlockBindMessage,
     BlockBindMessageField,
+    BlockBindOneof,
     BlockBindProto,
     BlockBoundDefinitionDispatcher,
     BlockComposition,
@@ -22,7 +40,64 @@ from bitproto.renderer.block import (
 )
 from bitproto.renderer.impls.c.formatter import CFormatter as F
 from bitproto.renderer.renderer import Renderer
-from bitproto.utils import cached_property, override, snake_case
+from bitproto.utils import cached_property, override, snake_case, upper_case
+
+
+class BlockMacroGuard(Block[F]):
+    """Guards given blocks by a preprocessor conditional directive, e.g.
+    `#ifdef BP_PARALLEL`. Renders nothing if all blocks are empty."""
+
+    def __init__(
+        self, directive: str, *blocks: Block[F], separator: str = "\n"
+    ) -> None:
+        super().__init__()
+        self.guard_directive = directive
+        self.guarded_blocks = blocks
+        self.guarded_separator = separator
+
+    @override(Block)
+    def render(self) -> None:
+        strings: List[str] = []
+        for block in self.guarded_blocks:
+            block._render_with_ctx(self._get_ctx_or_raise())
+            if not block._is_empty():
+                strings.append(block._collect())
+        if strings:
+            self.push(self.guard_directive, indent=0)
+            self.push(self.guarded_separator.join(strings), indent=0)
+            self.push("#endif", indent=0)
+
+
+class BlockJsonGuard(BlockMacroGuard):
+    """Guards given blocks of json formatting by macro BP_NO_JSON, so that they
+    are compiled out if it's defined."""
+
+    def __init__(self, *blocks: Block[F], separator: str = "\n") -> None:
+        super().__init__("#ifndef BP_NO_JSON", *blocks, separator=separator)
+
+
+class BlockParallelGuard(BlockMacroGuard):
+    """Guards given blocks of parallel batch functions by macro BP_PARALLEL, so
+    that they are compiled in only if it's defined, the same as the library."""
+
+    def __init__(self, *blocks: Block[F], separator: str = "\n") -> None:
+        super().__init__("#ifdef BP_PARALLEL", *blocks, separator=separator)
+
+
+class BlockRingGuard(BlockMacroGuard):
+    """Guards given blocks of frame ring functions by macro BP_RING, so that
+    they are compiled in only if it's defined, the same as the library."""
+
+    def __init__(self, *blocks: Block[F], separator: str = "\n") -> None:
+        super().__init__("#ifdef BP_RING", *blocks, separator=separator)
+
+
+class BlockMmsgGuard(BlockMacroGuard):
+    """Guards given blocks of datagram batch functions by macro BP_MMSG, so that
+    they are compiled in only if it's defined, the same as the library."""
+
+    def __init__(self, *blocks: Block[F], separator: str = "\n") -> None:
+        super().__init__("#ifdef BP_MMSG", *blocks, separator=separator)
 
 
 class BlockProtoDocstring(BlockBindProto[F]):
@@ -51,8 +126,12 @@ class BlockIncludeGeneralHeaders(Block[F]):
     @override(Block)
     def render(self) -> None:
         self.push("#include <inttypes.h>")
+        if self.formatter.has_large_messages(self.bound):
+            self.push("#include <limits.h>")
         self.push("#include <stddef.h>")
         self.push("#include <stdint.h>")
+        if self.formatter.has_reals(self.bound):
+            self.push("#include <string.h>")
         self.push("#ifndef __cplusplus")
         self.push("#include <stdbool.h>")
         self.push("#endif")
@@ -64,9 +143,11 @@ class BlockIncludeHeaders(BlockWrapper[F]):
         return BlockIncludeGeneralHeaders()
 
     @override(BlockWrapper)
-    def after(self) -> None:
-        self.push_empty_line()
+    def before(self) -> None:
+        # Ahead of the system headers, which bitproto.h may define feature test
+        # macros for, e.g. _GNU_SOURCE with BP_MMSG.
         self.push('#include "bitproto.h"')
+        self.push_empty_line()
 
 
 class BlockExternCPlusPlus(BlockDeferable[F]):
@@ -115,6 +196,25 @@ class BlockAliasProcessorDeclaration(BlockAliasProcessorBase):
         self.push(f"{self.function_signature};")
 
 
+class BlockAliasSplitProcessorBase(BlockAliasProcessorBase):
+    """Base of the encode (or decode) processor of an alias, generated separately
+    with option c.split_processors."""
+
+    def __init__(self, *args: Any, is_encode: bool, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.is_encode = is_encode
+
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_alias_processor_name(self.d, self.is_encode)
+
+
+class BlockAliasSplitProcessorDeclaration(BlockAliasSplitProcessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
 class BlockAliasJsonFormatterBase(BlockBindAlias[F]):
     @cached_property
     def function_name(self) -> str:
@@ -131,6 +231,22 @@ class BlockAliasJsonFormatterDeclaration(BlockAliasJsonFormatterBase):
         self.push(f"{self.function_signature};")
 
 
+class BlockAliasJsonParserBase(BlockBindAlias[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_alias_json_parser_name(self.d)
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"void {self.function_name}(void *data, struct BpJsonParseContext *ctx)"
+
+
+class BlockAliasJsonParserDeclaration(BlockAliasJsonParserBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
 class BlockAliasDef(BlockBindAlias[F]):
     def render_alias_typedef_to_array(self) -> None:
         self.push(f"typedef {self.aliased_type};")
@@ -154,10 +270,17 @@ class BlockAliasDef(BlockBindAlias[F]):
 class BlockAliasFunctionDeclarationsForInternal(BlockBindAlias[F], BlockComposition[F]):
     @override(BlockComposition)
     def blocks(self) -> List[Block[F]]:
-        return [
-            BlockAliasProcessorDeclaration(self.d),
-            BlockAliasJsonFormatterDeclaration(self.d),
-        ]
+        b: List[Block[F]] = [BlockAliasProcessorDeclaration(self.d)]
+        if self.formatter.is_split_processors(self.d):
+            b.append(BlockAliasSplitProcessorDeclaration(self.d, is_encode=True))
+            b.append(BlockAliasSplitProcessorDeclaration(self.d, is_encode=False))
+        b.append(
+            BlockJsonGuard(
+                BlockAliasJsonFormatterDeclaration(self.d),
+                BlockAliasJsonParserDeclaration(self.d),
+            )
+        )
+        return b
 
     @override(BlockComposition)
     def separator(self) -> str:
@@ -192,15 +315,42 @@ class BlockEnumDef(BlockBindEnum[F]):
         self.push_typing_hint_inline_comment()
 
 
+class BlockEnumValuesTableDeclaration(BlockBindEnum[F]):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.has_enum_values_table(self.d):
+            return
+        self.push_comment(f"Bitmap of values declared in enum {self.enum_name}")
+        declaration = self.formatter.format_bp_enum_values_table_declaration(self.d)
+        self.push(f"extern {declaration};")
+
+
 class BlockEnumDefs(BlockBindEnum[F], BlockComposition[F]):
     @override(BlockComposition)
     def blocks(self) -> List[Block[F]]:
         return [
             BlockEnumDef(self.d),
             BlockEnumFieldList(self.d),
+            BlockEnumValuesTableDeclaration(self.d),
         ]
 
 
+class BlockEnumValidatorBase(BlockBindEnum[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_enum_validator_name(self.d)
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"void {self.function_name}(void *data, struct BpProcessorContext *ctx)"
+
+
+class BlockEnumValidatorDeclaration(BlockEnumValidatorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
 class BlockMessageField(BlockBindMessageField[F]):
     def render_field_declaration_array(self) -> None:
         self.push(f"{self.message_field_type};")
@@ -209,7 +359,7 @@ class BlockMessageField(BlockBindMessageField[F]):
         self.push(f"{self.message_field_type} {self.message_field_name};")
 
     def render_field_declaration(self) -> None:
-        if isinstance(self.d.type, Array):
+        if isinstance(self.formatter.field_type(self.d), Array):
             self.render_field_declaration_array()
         else:
             self.render_field_declaration_common()
@@ -226,6 +376,68 @@ class BlockMessageLengthMacro(BlockBindMessage[F]):
     def render(self) -> None:
         self.push_comment(f"Number of bytes to encode struct {self.message_name}")
         self.push(f"#define {self.message_size_constant_name} {self.message_nbytes}")
+        if self.formatter.is_large_message(self.d):
+            self.push(f"#if INT_MAX < {self.d.nbits()}")
+            self.push(f'#error "struct {self.message_name} requires int of 32 bits"')
+            self.push("#endif")
+        self.push_comment(
+            f"Layout fingerprint of struct {self.message_name}, to check compatibility"
+        )
+        self.push(
+            f"#define {self.message_fingerprint_constant_name} {self.message_fingerprint}ULL"
+        )
+
+
+class BlockMessageStackUsageMacro(BlockBindMessage[F]):
+    """Stack usage bound of the encoder and decoders of a message in standard mode,
+    with option c.bounded_stack. Raises if the message can't be run without
+    recursion."""
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.has_bounded_stack(self.d):
+            raise BoundedStackUnsupported(message_name=self.message_name)
+        name = upper_case(snake_case(self.message_name))
+        self.push_comment(
+            f"Max bytes of stack to encode and decode struct {self.message_name}"
+        )
+        self.push(f"#define BP_STACK_USAGE_{name} BP_STACK_USAGE_BOUND")
+
+
+class BlockMessageFieldLayoutMacros(BlockBindMessage[F]):
+    """Bit offsets and sizes of fields, for external parsers reading the encoded
+    buffer in place. The same offsets the optimization mode generates code by."""
+
+    @override(Block)
+    def render(self) -> None:
+        name = upper_case(snake_case(self.message_name))
+        entries = flat_field_layouts(self.d)
+        self.push_comment(
+            f"Bit offsets and number of bits of the fields of struct {self.message_name}"
+        )
+        for path, offset, nbits in entries:
+            field = upper_case(path.replace(".", "_"))
+            self.push(f"#define BP_OFFSET_BITS_{name}_{field} {offset}")
+            self.push(f"#define BP_NBITS_{name}_{field} {nbits}")
+        self.push_comment(f"Number of entries in BP_FIELDS_{name}")
+        self.push(f"#define BP_NFIELDS_{name} {len(entries)}")
+        self.push_comment(f"Initializer of struct BpFieldLayout[BP_NFIELDS_{name}]")
+        self.push(f"#define BP_FIELDS_{name} {{ \\")
+        for path, offset, nbits in entries:
+            self.push(f'    {{"{path}", {offset}, {nbits}}}, \\')
+        self.push("}")
+
+
+class BlockMessageFieldMaskMacros(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Mask bits selecting the fields of struct {self.message_name} "
+            f"in Decode{self.message_name}Masked"
+        )
+        for k, field in enumerate(self.d.sorted_fields()):
+            name = self.format_field_mask_constant_name(field)
+            self.push(f"#define {name} (1ULL << {k})")
 
 
 class BlockMessageFieldList(BlockBindMessage[F], BlockComposition[F]):
@@ -265,11 +477,20 @@ class BlockMessageEncoderBase(BlockBindMessage[F]):
 
     @cached_property
     def function_comment(self) -> str:
-        return f"Encode struct {self.message_name} to given buffer s."
+        comment = f"Encode struct {self.message_name} to given buffer s."
+        if self.d.has_bounded_array():
+            comment += (
+                " Returns the number of bytes encoded, bounded arrays take the bytes "
+                "of the elements in use only."
+            )
+        return comment
 
     @cached_property
     def function_signature(self) -> str:
-        return f"int {self.function_name}({self.message_type} *m, unsigned char *s)"
+        return (
+            f"int {self.function_name}(const {self.message_type} *BP_RESTRICT m, "
+            "unsigned char *BP_RESTRICT s)"
+        )
 
 
 class BlockMessageEncoderFunctionDeclaration(BlockMessageEncoderBase):
@@ -286,11 +507,22 @@ class BlockMessageDecoderBase(BlockBindMessage[F]):
 
     @cached_property
     def function_comment(self) -> str:
-        return f"Decode struct {self.message_name} from given buffer s."
+        comment = f"Decode struct {self.message_name} from given buffer s."
+        if has_validated_enums(self.d):
+            comment += " Returns BP_ERR_ENUM if an enum holds a value not declared."
+        if self.d.has_bounded_array():
+            comment += " Returns BP_ERR_COUNT if a count exceeds its bounded array."
+        return comment
 
     @cached_property
     def function_signature(self) -> str:
-        return f"int {self.function_name}({self.message_type} *m, unsigned char *s)"
+        # Not restrict-qualified, unlike the encoders. GCC then shares the bytes
+        # loaded across the fields in optimization mode, instead of combining the
+        # loads of each field into a word, which is slower.
+        return (
+            f"int {self.function_name}({self.message_type} *m, "
+            "const unsigned char *s)"
+        )
 
 
 class BlockMessageDecoderFunctionDeclaration(BlockMessageDecoderBase):
@@ -300,155 +532,1326 @@ class BlockMessageDecoderFunctionDeclaration(BlockMessageDecoderBase):
         self.push(f"{self.function_signature};")
 
 
-class BlockMessageBpJsonFormatterBase(BlockBindMessage[F]):
+class BlockMessageBoundedDecoderBase(BlockBindMessage[F]):
     @cached_property
     def function_name(self) -> str:
-        return self.formatter.format_bp_message_json_formatter_name(self.d)
+        return f"Decode{self.message_name}N"
+
+    @cached_property
+    def function_comment(self) -> str:
+        comment = (
+            f"Decode struct {self.message_name} from given buffer s of n bytes. "
+            "Returns BP_ERR_SHORT_INPUT if s is too short."
+        )
+        if self.d.has_bounded_array():
+            comment += " Returns BP_ERR_COUNT if a count exceeds its bounded array."
+        return comment
 
     @cached_property
     def function_signature(self) -> str:
-        return f"void {self.function_name}(void *data, struct BpJsonFormatContext *ctx)"
+        return (
+            f"int {self.function_name}({self.message_type} *m, "
+            "const unsigned char *s, int n)"
+        )
 
 
-class BlockMessageBpJsonFormatterDeclaration(BlockMessageBpJsonFormatterBase):
+class BlockMessageBoundedDecoderFunctionDeclaration(BlockMessageBoundedDecoderBase):
     @override(Block)
     def render(self) -> None:
+        self.push_comment(self.function_comment)
         self.push(f"{self.function_signature};")
 
 
-class BlockMessageJsonFormatterBase(BlockBindMessage[F]):
+class BlockMessageMaskedDecoderBase(BlockBindMessage[F]):
     @cached_property
     def function_name(self) -> str:
-        return f"Json{self.message_name}"
+        return f"Decode{self.message_name}Masked"
 
     @cached_property
     def function_comment(self) -> str:
-        return f"Format struct {self.message_name} to a json format string."
+        bits = "FIELD_MASK_" + upper_case(snake_case(self.message_name)) + "_*"
+        comment = (
+            f"Decode the fields of struct {self.message_name} selected by mask, an or "
+            f"of {bits}, from given buffer s. Others are skipped and left untouched."
+        )
+        if has_validated_enums(self.d):
+            comment += " Returns BP_ERR_ENUM if an enum holds a value not declared."
+        return comment
 
     @cached_property
     def function_signature(self) -> str:
-        return f"int {self.function_name}({self.message_type} *m, char *s)"
+        return (
+            f"int {self.function_name}({self.message_type} *m, "
+            "const unsigned char *s, uint64_t mask)"
+        )
 
 
-class BlockMessageJsonFormatterFunctionDeclaration(BlockMessageJsonFormatterBase):
+class BlockMessageMaskedDecoderFunctionDeclaration(BlockMessageMaskedDecoderBase):
     @override(Block)
     def render(self) -> None:
+        if not self.has_masked_decoder:
+            return
         self.push_comment(self.function_comment)
         self.push(f"{self.function_signature};")
 
 
-class BlockMessageFieldDescriptorsIniterBase(BlockBindMessage[F]):
+class BlockMessageHashBase(BlockBindMessage[F]):
     @cached_property
     def function_name(self) -> str:
-        return self.formatter.format_bp_message_field_descriptor_initer(self.d)
+        return f"Hash{self.message_name}"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Hash struct {self.message_name} by the bits of its fields to encode, "
+            "padding bytes and bits above the fields' widths are not hashed. "
+            f"Messages equal by Equal{self.message_name} have the same hash, on the "
+            "same host."
+        )
 
     @cached_property
     def function_signature(self) -> str:
-        return f"void {self.function_name}({self.message_type} *m, struct BpMessageFieldDescriptor *fds)"
+        return f"uint64_t {self.function_name}(const {self.message_type} *m)"
 
 
-class BlockMessageProcessorBase(BlockBindMessage[F]):
+class BlockMessageHashFunctionDeclaration(BlockMessageHashBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageEqualBase(BlockBindMessage[F]):
     @cached_property
     def function_name(self) -> str:
-        return self.formatter.format_bp_message_processor_name(self.d)
+        return f"Equal{self.message_name}"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Returns true if the structs {self.message_name} at a and b encode the "
+            "same, without encoding them. Padding bytes and bits above the fields' "
+            "widths are not compared, float32s are compared by bits."
+        )
 
     @cached_property
     def function_signature(self) -> str:
-        return f"void {self.function_name}(void *data, struct BpProcessorContext *ctx)"
+        return (
+            f"bool {self.function_name}(const {self.message_type} *a, "
+            f"const {self.message_type} *b)"
+        )
 
 
-class BlockMessageProcessorDeclaration(BlockMessageProcessorBase):
+class BlockMessageEqualFunctionDeclaration(BlockMessageEqualBase):
     @override(Block)
     def render(self) -> None:
+        self.push_comment(self.function_comment)
         self.push(f"{self.function_signature};")
 
 
-class BlockMessageFunctionDeclarationsForUser(BlockBindMessage[F], BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockMessageEncoderFunctionDeclaration(self.d),
-            BlockMessageDecoderFunctionDeclaration(self.d),
-            BlockMessageJsonFormatterFunctionDeclaration(self.d),
-        ]
+class BlockMessageSelfTestBase(BlockBindMessage[F]):
+    """Base of function BpSelfTestXXX of a message, with option self_test."""
 
-    @override(BlockComposition)
-    def separator(self) -> str:
-        return "\n"
+    @cached_property
+    def nvectors(self) -> int:
+        return self.formatter.self_test(self.d)
 
+    @cached_property
+    def function_name(self) -> str:
+        return f"BpSelfTest{self.message_name}"
 
-class BlockMessageFunctionDeclarationsForInternal(
-    BlockBindMessage[F], BlockComposition[F]
-):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockMessageProcessorDeclaration(self.d),
-            BlockMessageBpJsonFormatterDeclaration(self.d),
-        ]
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Checks the encoders and decoders of struct {self.message_name} against "
+            f"{self.nvectors} test vectors computed by the bitproto compiler, e.g. on "
+            "startup, before a build with aggressive optimizations is trusted. "
+            "Returns BP_ERR_SELF_TEST on the first mismatch."
+        )
 
-    @override(BlockComposition)
-    def separator(self) -> str:
-        return "\n"
+    @cached_property
+    def function_signature(self) -> str:
+        return f"int {self.function_name}(void)"
 
 
-class BlockMessageDef(BlockBindMessage[F], BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockMessageLengthMacro(self.d),
-            BlockMessageStruct(self.d),
-        ]
+class BlockMessageSelfTestFunctionDeclaration(BlockMessageSelfTestBase):
+    @override(Block)
+    def render(self) -> None:
+        if not self.nvectors:
+            return
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
 
 
-class BlockImportList(BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockIncludeChildProtoHeader(proto, name=name)
-            for name, proto in self.bound.protos(recursive=False)
-        ]
+class BlockMessageBatchEncoderBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Encode{self.message_name}Batch"
 
-    @override(BlockComposition)
-    def separator(self) -> str:
-        return "\n"
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Encode count structs {self.message_name} at ms to given buffer s, "
+            f"each takes {self.message_size_constant_name} bytes."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}(const {self.message_type} *BP_RESTRICT ms, "
+            "size_t count, unsigned char *BP_RESTRICT s)"
+        )
 
 
-class BlockDefineMacroOpMode(Block[F]):
+class BlockMessageBatchEncoderFunctionDeclaration(BlockMessageBatchEncoderBase):
     @override(Block)
     def render(self) -> None:
-        self.push("#define BITPROTO_OPTIMIZATION_MODE 1")
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
 
 
-class BlockDataStructuresList(BlockBoundDefinitionDispatcher[F]):
-    @override(BlockBoundDefinitionDispatcher)
-    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
-        if isinstance(d, Alias):
-            return BlockAliasDef(d)
-        if isinstance(d, Constant):
-            return BlockConstant(d)
-        if isinstance(d, Enum):
-            return BlockEnumDefs(d)
-        if isinstance(d, Message):
-            return BlockMessageDef(d)
-        return None
+class BlockMessageBatchDecoderBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Decode{self.message_name}Batch"
 
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Decode count structs {self.message_name} to ms from given buffer s, "
+            f"each takes {self.message_size_constant_name} bytes."
+        )
 
-class BlockFunctionDeclarationsForUserList(BlockBoundDefinitionDispatcher[F]):
-    @override(BlockBoundDefinitionDispatcher)
-    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
-        if isinstance(d, Message):
-            return BlockMessageFunctionDeclarationsForUser(d)
-        return None
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}({self.message_type} *ms, size_t count, "
+            "const unsigned char *s)"
+        )
 
 
-class BlockFunctionDeclarationsForInternalList(BlockBoundDefinitionDispatcher[F]):
-    @override(BlockBoundDefinitionDispatcher)
-    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
-        if isinstance(d, Alias):
-            return BlockAliasFunctionDeclarationsForInternal(d)
-        if isinstance(d, Message):
-            return BlockMessageFunctionDeclarationsForInternal(d)
+class BlockMessageBatchDecoderFunctionDeclaration(BlockMessageBatchDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageParallelBatchBase(BlockBindMessage[F]):
+    """Base of the batch encoder (or decoder) of a message, sharding the records
+    across threads by BpParallelBatch, compiled in if BP_PARALLEL is defined."""
+
+    def __init__(self, *args: Any, is_encode: bool, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.is_encode = is_encode
+
+    @cached_property
+    def batch_function_name(self) -> str:
+        direction = "Encode" if self.is_encode else "Decode"
+        return f"{direction}{self.message_name}Batch"
+
+    @cached_property
+    def function_name(self) -> str:
+        return f"{self.batch_function_name}Parallel"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"The same to {self.batch_function_name}, but shards the records across "
+            "nthreads threads, or the number of online processors if nthreads <= 0."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        const = "const " if self.is_encode else ""
+        return (
+            f"int {self.function_name}({const}{self.message_type} *ms, size_t count, "
+            "unsigned char *s, int nthreads)"
+        )
+
+
+class BlockMessageParallelBatchFunctionDeclaration(BlockMessageParallelBatchBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageRingBase(BlockBindMessage[F]):
+    """Base of the function encoding a message into the next slot of a frame ring
+    (or decoding it from the oldest slot), compiled in if BP_RING is defined."""
+
+    def __init__(self, *args: Any, is_encode: bool, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.is_encode = is_encode
+
+    @cached_property
+    def function_name(self) -> str:
+        if self.is_encode:
+            return f"Encode{self.message_name}Into"
+        return f"Decode{self.message_name}From"
+
+    @cached_property
+    def function_comment(self) -> str:
+        if self.is_encode:
+            return (
+                f"Encode struct {self.message_name} m into the next slot of ring r "
+                "and commit it, returns BP_ERR_RING if the ring is full."
+            )
+        return (
+            f"Decode struct {self.message_name} m from the oldest slot of ring r "
+            "and release it, returns BP_ERR_RING if the ring is empty."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        if self.is_encode:
+            return (
+                f"int {self.function_name}(struct BpRing *r, "
+                f"const {self.message_type} *m)"
+            )
+        return f"int {self.function_name}(struct BpRing *r, {self.message_type} *m)"
+
+
+class BlockMessageRingFunctionDeclaration(BlockMessageRingBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageMmsgBase(BlockBindMessage[F]):
+    """Base of the function receiving a batch of datagrams of a message by a
+    recvmmsg and decoding them (or encoding and sending them by sendmmsg),
+    compiled in if BP_MMSG is defined."""
+
+    def __init__(self, *args: Any, is_encode: bool, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.is_encode = is_encode
+
+    @cached_property
+    def batch_function_name(self) -> str:
+        direction = "Encode" if self.is_encode else "Decode"
+        return f"{direction}{self.message_name}Batch"
+
+    @cached_property
+    def function_name(self) -> str:
+        if self.is_encode:
+            return f"Send{self.message_name}Batch"
+        return f"Recv{self.message_name}Batch"
+
+    @cached_property
+    def function_comment(self) -> str:
+        size = self.message_size_constant_name
+        if self.is_encode:
+            return (
+                f"Encode count structs {self.message_name} at ms to given buffer s, "
+                f"and send each of the {size} bytes as a datagram to connected socket "
+                "fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG."
+            )
+        return (
+            f"Receive at most count datagrams from socket fd by a single recvmmsg, "
+            f"each into {size} bytes of given buffer s, and decode them to ms. "
+            "Returns the number of structs decoded, or BP_ERR_MMSG."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        if self.is_encode:
+            return (
+                f"int {self.function_name}(int fd, const {self.message_type} *ms, "
+                "size_t count, unsigned char *s, int flags)"
+            )
+        return (
+            f"int {self.function_name}(int fd, {self.message_type} *ms, "
+            "size_t count, unsigned char *s, int flags)"
+        )
+
+
+class BlockMessageMmsgFunctionDeclaration(BlockMessageMmsgBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageStreamDecoderBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Decode{self.message_name}Start"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Start decoding struct {self.message_name} incrementally into m. Feed "
+            "the chunks of the buffer by BpDecodePlanChunk, until BpPlanDecoderDone."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"void {self.function_name}(struct BpPlanDecoder *ctx, "
+            f"{self.message_type} *m)"
+        )
+
+
+class BlockMessageStreamDecoderFunctionDeclaration(BlockMessageStreamDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.is_copy_plan(self.d):
+            return
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageSinkEncoderBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Encode{self.message_name}Sink"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Encode struct {self.message_name} through given sink in chunks, using "
+            "buffer s of n bytes as the working buffer."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"void {self.function_name}({self.message_type} *m, unsigned char *s, "
+            "int n, BpSink sink, void *arg)"
+        )
+
+
+class BlockMessageSinkEncoderFunctionDeclaration(BlockMessageSinkEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        if not self.formatter.is_copy_plan(self.d):
+            return
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageDeltaBase(BlockBindMessage[F]):
+    """Base of the delta encoder and decoder of a message, with option c.delta."""
+
+    @cached_property
+    def delta_size_constant_name(self) -> str:
+        return f"{self.message_size_constant_name}_DELTA"
+
+
+class BlockMessageDeltaLengthMacro(BlockMessageDeltaBase):
+    @override(Block)
+    def render(self) -> None:
+        # A bit per field in the bitmap, plus all fields changed.
+        n = (self.d.nfields() + self.d.nbits() + 7) // 8
+        self.push_comment(
+            f"Max number of bytes to encode struct {self.message_name} as a delta"
+        )
+        self.push(f"#define {self.delta_size_constant_name} {n}")
+
+
+class BlockMessageDeltaEncoderBase(BlockMessageDeltaBase):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Encode{self.message_name}Delta"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Encode struct {self.message_name} cur to given buffer s as a delta "
+            "against the previous prev, only changed fields are encoded after a bitmap "
+            "of them. Returns the number of bytes encoded."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}({self.message_type} *prev, "
+            f"{self.message_type} *cur, unsigned char *s)"
+        )
+
+
+class BlockMessageDeltaEncoderFunctionDeclaration(BlockMessageDeltaEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageDeltaDecoderBase(BlockMessageDeltaBase):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Decode{self.message_name}Delta"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Decode struct {self.message_name} out from the delta of n bytes at given "
+            "buffer s against the previous prev, out and prev may be the same. Returns "
+            "the number of bytes decoded, or BP_ERR_SHORT_INPUT if s is too short."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}({self.message_type} *prev, unsigned char *s, "
+            f"int n, {self.message_type} *out)"
+        )
+
+
+class BlockMessageDeltaDecoderFunctionDeclaration(BlockMessageDeltaDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageDeltaFunctionDeclarations(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.is_delta(self.d):
+            return []
+        return [
+            BlockMessageDeltaLengthMacro(self.d),
+            BlockMessageDeltaEncoderFunctionDeclaration(self.d),
+            BlockMessageDeltaDecoderFunctionDeclaration(self.d),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockMessageCheckedBase(BlockBindMessage[F]):
+    """Base of the checked encoder and decoder of a message, with option c.checksum.
+    The checksum of the BYTES_LENGTH_XXX encoded bytes follows them in the buffer."""
+
+    @cached_property
+    def checksum(self) -> str:
+        return self.formatter.checksum(self.d.bound)
+
+    @cached_property
+    def checked_size_constant_name(self) -> str:
+        return f"{self.message_size_constant_name}_CHECKED"
+
+
+class BlockMessageCheckedLengthMacro(BlockMessageCheckedBase):
+    @override(Block)
+    def render(self) -> None:
+        n = self.formatter.checksum_nbytes(self.d.bound)
+        self.push_comment(
+            f"Number of bytes to encode struct {self.message_name} with its checksum"
+        )
+        self.push(
+            f"#define {self.checked_size_constant_name} "
+            f"({self.message_size_constant_name} + {n})"
+        )
+
+
+class BlockMessageCheckedEncoderBase(BlockMessageCheckedBase):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Encode{self.message_name}Checked"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Encode struct {self.message_name} to given buffer s, followed by the "
+            f"{self.checksum} checksum in little-endian. The buffer s should be at "
+            f"least {self.checked_size_constant_name} bytes."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}(const {self.message_type} *BP_RESTRICT m, "
+            "unsigned char *BP_RESTRICT s)"
+        )
+
+
+class BlockMessageCheckedEncoderFunctionDeclaration(BlockMessageCheckedEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageCheckedDecoderBase(BlockMessageCheckedBase):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Decode{self.message_name}Checked"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Decode struct {self.message_name} from given buffer s of n bytes, "
+            f"after verifying the {self.checksum} checksum. Returns "
+            "BP_ERR_SHORT_INPUT if s is too short, or BP_ERR_CHECKSUM if the "
+            "checksum mismatches, m is left untouched then."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}({self.message_type} *m, "
+            "const unsigned char *s, int n)"
+        )
+
+
+class BlockMessageCheckedDecoderFunctionDeclaration(BlockMessageCheckedDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageCheckedFunctionDeclarations(
+    BlockBindMessage[F], BlockComposition[F]
+):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.checksum(self.d.bound):
+            return []
+        return [
+            BlockMessageCheckedLengthMacro(self.d),
+            BlockMessageCheckedEncoderFunctionDeclaration(self.d),
+            BlockMessageCheckedDecoderFunctionDeclaration(self.d),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockMessageFramedBase(BlockBindMessage[F]):
+    """Base of the framed encoder and decoder of a message, with option c.framing.
+    The payload of the frame is the checked encoding, if option c.checksum is set."""
+
+    @cached_property
+    def framing(self) -> str:
+        return self.formatter.framing(self.d.bound)
+
+    @cached_property
+    def framed_size_constant_name(self) -> str:
+        return f"{self.message_size_constant_name}_FRAMED"
+
+    @cached_property
+    def payload_suffix(self) -> str:
+        return "Checked" if self.formatter.checksum(self.d.bound) else ""
+
+    @cached_property
+    def payload_size_constant_name(self) -> str:
+        if self.payload_suffix:
+            return f"{self.message_size_constant_name}_CHECKED"
+        return self.message_size_constant_name
+
+
+class BlockMessageFramedLengthMacro(BlockMessageFramedBase):
+    @override(Block)
+    def render(self) -> None:
+        size = self.payload_size_constant_name
+        overhead = f"BP_{self.framing.upper()}_OVERHEAD({size})"
+        self.push_comment(
+            f"Number of bytes of the buffer to encode struct {self.message_name} framed"
+        )
+        self.push(f"#define {self.framed_size_constant_name} ({size} + {overhead} + 1)")
+
+
+class BlockMessageFramedEncoderBase(BlockMessageFramedBase):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Encode{self.message_name}Framed"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Encode struct {self.message_name} to given buffer s in a {self.framing} "
+            "frame, followed by the delimiter. Returns the length of the frame. The "
+            f"buffer s should be at least {self.framed_size_constant_name} bytes."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"int {self.function_name}({self.message_type} *m, unsigned char *s)"
+
+
+class BlockMessageFramedEncoderFunctionDeclaration(BlockMessageFramedEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageFramedDecoderBase(BlockMessageFramedBase):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Decode{self.message_name}Framed"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Decode struct {self.message_name} from the {self.framing} frame of n "
+            "bytes at given buffer s, which is unframed in place. Returns "
+            "BP_ERR_FRAMING if the frame is malformed."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"int {self.function_name}({self.message_type} *m, unsigned char *s, int n)"
+
+
+class BlockMessageFramedDecoderFunctionDeclaration(BlockMessageFramedDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageFramedFunctionDeclarations(
+    BlockBindMessage[F], BlockComposition[F]
+):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        if not self.formatter.framing(self.d.bound):
+            return []
+        return [
+            BlockMessageFramedLengthMacro(self.d),
+            BlockMessageFramedEncoderFunctionDeclaration(self.d),
+            BlockMessageFramedDecoderFunctionDeclaration(self.d),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockMessageBpJsonFormatterBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_message_json_formatter_name(self.d)
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"void {self.function_name}(void *data, struct BpJsonFormatContext *ctx)"
+
+
+class BlockMessageBpJsonFormatterDeclaration(BlockMessageBpJsonFormatterBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageBpJsonParserBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_message_json_parser_name(self.d)
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"void {self.function_name}(void *data, struct BpJsonParseContext *ctx)"
+
+
+class BlockMessageBpJsonParserDeclaration(BlockMessageBpJsonParserBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageJsonFormatterBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Json{self.message_name}"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return f"Format struct {self.message_name} to a json format string."
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"int {self.function_name}({self.message_type} *m, char *s)"
+
+
+class BlockMessageJsonFormatterFunctionDeclaration(BlockMessageJsonFormatterBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageJsonMaxLengthMacro(BlockBindMessage[F]):
+    @cached_property
+    def constant_name(self) -> str:
+        return "JSON_MAX_LENGTH_" + upper_case(snake_case(self.message_name))
+
+    @override(Block)
+    def render(self) -> None:
+        n = self.formatter.json_max_length(self.d)
+        self.push_comment(
+            f"Max length of the json string of struct {self.message_name}, "
+            "excluding the trailing null byte."
+        )
+        self.push(f"#define {self.constant_name} {n}")
+
+
+class BlockMessageBoundedJsonFormatterBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Json{self.message_name}N"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Format struct {self.message_name} to a json format string into given "
+            "buffer s of n bytes, like snprintf. Returns the length of the full json "
+            "string, the output is truncated if the returned value is not less than n."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"int {self.function_name}({self.message_type} *m, char *s, int n)"
+
+
+class BlockMessageBoundedJsonFormatterFunctionDeclaration(
+    BlockMessageBoundedJsonFormatterBase
+):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageSinkJsonFormatterBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Json{self.message_name}Sink"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Format struct {self.message_name} to a json format string through given "
+            "sink in chunks, using buffer s of n bytes as the working buffer. Returns "
+            "the length of the json string, no trailing null byte is written."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}({self.message_type} *m, char *s, int n, "
+            "BpSink sink, void *arg)"
+        )
+
+
+class BlockMessageJsonParserBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"ParseJson{self.message_name}"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Parse a json string of n bytes into struct {self.message_name}, in the "
+            f"format of Json{self.message_name}. Fields and elements missing are left "
+            "untouched, unknown keys are skipped. Returns 0 for success, or "
+            "BP_ERR_JSON if it's malformed or a value is out of range."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}({self.message_type} *m, const char *s, int n)"
+        )
+
+
+class BlockMessageJsonParserFunctionDeclaration(BlockMessageJsonParserBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageSinkJsonFormatterFunctionDeclaration(
+    BlockMessageSinkJsonFormatterBase
+):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageProcessorBase(BlockBindMessage[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_message_processor_name(self.d)
+
+    @cached_property
+    def function_signature(self) -> str:
+        return f"void {self.function_name}(void *data, struct BpProcessorContext *ctx)"
+
+
+class BlockMessageProcessorDeclaration(BlockMessageProcessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageSplitProcessorBase(BlockMessageProcessorBase):
+    """Base of the encode (or decode) processor of a message, generated separately
+    with option c.split_processors."""
+
+    def __init__(self, *args: Any, is_encode: bool, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.is_encode = is_encode
+
+    @cached_property
+    def function_name(self) -> str:
+        return self.formatter.format_bp_message_processor_name(self.d, self.is_encode)
+
+
+class BlockMessageSplitProcessorDeclaration(BlockMessageSplitProcessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"{self.function_signature};")
+
+
+class BlockMessageFieldAccessorBase(BlockBindMessage[F]):
+    """Base of the accessors of a single field in the encoded buffer of a message.
+
+    :param path: The list of fields to reach the field from the message.
+    :param t: The type of the field.
+    :param i: The index of the bit the field starts at in the encoded buffer.
+    """
+
+    def __init__(
+        self, *args: Any, path: List[MessageField], t: Type, i: int = 0, **kwds: Any
+    ) -> None:
+        super().__init__(*args, **kwds)
+        self.path = path
+        self.t = t
+        self.i = i
+
+    @cached_property
+    def field_path(self) -> str:
+        return ".".join(self.formatter.format_message_field_name(f) for f in self.path)
+
+    @cached_property
+    def accessor_name_suffix(self) -> str:
+        return self.message_name + "_" + self.field_path.replace(".", "_")
+
+    @cached_property
+    def field_type(self) -> str:
+        return self.formatter.format_type(self.t)
+
+
+class BlockMessageFieldGetter(BlockMessageFieldAccessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Get field {self.field_path} of struct {self.message_name} "
+            "from given encoded buffer s."
+        )
+        self.push(
+            f"static inline {self.field_type} "
+            f"BpGet{self.accessor_name_suffix}(const unsigned char *s) {{"
+        )
+        self.push(f"{self.field_type} v = 0;", indent=4)
+        # Getters return the value as it is, enums are not validated here.
+        check = ""
+        t = resolve_alias(self.t)
+        if is_validated_enum(t):
+            check = self.formatter.format_bp_enum_check_statement(t, "v", "err")
+        for line in self.formatter.format_op_mode_getter(self.t, "v", self.i):
+            if line != check:
+                self.push(line, indent=4)
+        self.push("return v;", indent=4)
+        self.push("}")
+
+
+class BlockMessageFieldSetter(BlockMessageFieldAccessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Set field {self.field_path} of struct {self.message_name} "
+            "in given encoded buffer s in place."
+        )
+        self.push(
+            f"static inline void BpSet{self.accessor_name_suffix}"
+            f"(unsigned char *s, {self.field_type} v) {{"
+        )
+        for line in self.formatter.format_op_mode_setter(self.t, "v", self.i):
+            self.push(line, indent=4)
+        self.push("}")
+
+
+class BlockMessageFieldAccessorList(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = []
+        for path, t, i in self.formatter.op_mode_accessor_fields(self.d):
+            b.append(BlockMessageFieldGetter(self.d, path=path, t=t, i=i))
+            b.append(BlockMessageFieldSetter(self.d, path=path, t=t, i=i))
+        return b
+
+
+class BlockMessageFunctionDeclarationsForUser(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockMessageEncoderFunctionDeclaration(self.d),
+            BlockMessageDecoderFunctionDeclaration(self.d),
+            BlockMessageBoundedDecoderFunctionDeclaration(self.d),
+            BlockMessageMaskedDecoderFunctionDeclaration(self.d),
+            BlockMessageBatchEncoderFunctionDeclaration(self.d),
+            BlockMessageBatchDecoderFunctionDeclaration(self.d),
+            BlockParallelGuard(
+                BlockMessageParallelBatchFunctionDeclaration(self.d, is_encode=True),
+                BlockMessageParallelBatchFunctionDeclaration(self.d, is_encode=False),
+            ),
+            BlockRingGuard(
+                BlockMessageRingFunctionDeclaration(self.d, is_encode=True),
+                BlockMessageRingFunctionDeclaration(self.d, is_encode=False),
+            ),
+            BlockMmsgGuard(
+                BlockMessageMmsgFunctionDeclaration(self.d, is_encode=True),
+                BlockMessageMmsgFunctionDeclaration(self.d, is_encode=False),
+            ),
+            BlockMessageStreamDecoderFunctionDeclaration(self.d),
+            BlockMessageSinkEncoderFunctionDeclaration(self.d),
+            BlockMessageDeltaFunctionDeclarations(self.d),
+            BlockMessageCheckedFunctionDeclarations(self.d),
+            BlockMessageFramedFunctionDeclarations(self.d),
+            BlockMessageHashFunctionDeclaration(self.d),
+            BlockMessageEqualFunctionDeclaration(self.d),
+            BlockMessageSelfTestFunctionDeclaration(self.d),
+            BlockMessageJsonMaxLengthMacro(self.d),
+            BlockJsonGuard(
+                BlockMessageJsonFormatterFunctionDeclaration(self.d),
+                BlockMessageBoundedJsonFormatterFunctionDeclaration(self.d),
+                BlockMessageSinkJsonFormatterFunctionDeclaration(self.d),
+                BlockMessageJsonParserFunctionDeclaration(self.d),
+            ),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockMessageFunctionDeclarationsForInternal(
+    BlockBindMessage[F], BlockComposition[F]
+):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = [BlockMessageProcessorDeclaration(self.d)]
+        if self.formatter.is_split_processors(self.d):
+            b.append(BlockMessageSplitProcessorDeclaration(self.d, is_encode=True))
+            b.append(BlockMessageSplitProcessorDeclaration(self.d, is_encode=False))
+        b.append(
+            BlockJsonGuard(
+                BlockMessageBpJsonFormatterDeclaration(self.d),
+                BlockMessageBpJsonParserDeclaration(self.d),
+            )
+        )
+        return b
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockMessageDef(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        blocks: List[Block[F]] = [BlockMessageLengthMacro(self.d)]
+        # Messages without functions, in optimization mode or not reachable from the
+        # filter messages, have no stack usage.
+        ctx = self._get_ctx_or_raise()
+        if (
+            self.formatter.is_bounded_stack(self.d)
+            and not ctx.optimization_mode
+            and self.is_reachable(self.d)
+        ):
+            blocks.append(BlockMessageStackUsageMacro(self.d))
+        # Bit offsets of fields are known only in messages in fixed size.
+        if self.d.is_fixed_size() and self.d.fields():
+            blocks.append(BlockMessageFieldLayoutMacros(self.d))
+        if self.has_masked_decoder:
+            blocks.append(BlockMessageFieldMaskMacros(self.d))
+        blocks.append(BlockMessageStruct(self.d))
+        return blocks
+
+
+class BlockOneofMacros(BlockBindOneof[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Number of bytes to encode struct {self.oneof_name} of the largest variant"
+        )
+        self.push(f"#define {self.oneof_size_constant_name} {self.oneof_nbytes}")
+        self.push_comment(f"Tags of the variants of struct {self.oneof_name}")
+        for v in self.d.sorted_variants():
+            name = self.format_variant_tag_constant_name(v)
+            self.push(f"#define {name} {v.tag}")
+
+
+class BlockOneofStruct(BlockBindOneof[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push_definition_comments()
+        self.push(f"struct {self.oneof_name} {{")
+        tags = f"TAG_{upper_case(snake_case(self.oneof_name))}_*"
+        self.push_comment(f"Tag of the active variant, one of {tags}", indent=4)
+        self.push("uint8_t tag;", indent=4)
+        self.push("union {", indent=4)
+        for v in self.d.sorted_variants():
+            for comment in v.comment_block:
+                self.push_comment(comment, indent=8)
+            variant_type = self.formatter.format_message_type(v.message)
+            self.push(f"{variant_type} {self.format_variant_name(v)};", indent=8)
+            self.push_string(self.formatter.format_comment(f"{v.message.nbits()}bit"))
+        self.push("} u;", indent=4)
+        self.push("}")
+        option_name = "c.struct_packing_alignment"
+        alignment = self.bound.get_option_as_int_or_raise(option_name)
+        if alignment > 0:
+            self.push_string(f"__attribute__((packed, aligned({alignment})))")
+        self.push_string(";", separator="")
+
+
+class BlockOneofDef(BlockBindOneof[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [BlockOneofMacros(self.d), BlockOneofStruct(self.d)]
+
+
+class BlockOneofEncoderBase(BlockBindOneof[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Encode{self.oneof_name}"
+
+    @cached_property
+    def function_comment(self) -> str:
+        return (
+            f"Encode struct {self.oneof_name} to given buffer s, the tag followed by "
+            "the active variant. Returns the number of bytes encoded, of the tag and "
+            "the active variant, or BP_ERR_TAG if the tag is unknown."
+        )
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}(const struct {self.oneof_name} *BP_RESTRICT m, "
+            "unsigned char *BP_RESTRICT s)"
+        )
+
+
+class BlockOneofEncoderFunctionDeclaration(BlockOneofEncoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockOneofDecoderBase(BlockBindOneof[F]):
+    @cached_property
+    def function_name(self) -> str:
+        return f"Decode{self.oneof_name}"
+
+    @cached_property
+    def function_comment(self) -> str:
+        comment = (
+            f"Decode struct {self.oneof_name} from given buffer s of n bytes, by the "
+            "decoder of the variant the tag selects. Returns BP_ERR_TAG if the tag is "
+            "unknown, BP_ERR_SHORT_INPUT if n is less than the bytes of the variant."
+        )
+        if any(has_validated_enums(v.message) for v in self.d.variants()):
+            comment += " Returns BP_ERR_ENUM if an enum holds a value not declared."
+        return comment
+
+    @cached_property
+    def function_signature(self) -> str:
+        return (
+            f"int {self.function_name}(struct {self.oneof_name} *m, "
+            "const unsigned char *s, int n)"
+        )
+
+
+class BlockOneofDecoderFunctionDeclaration(BlockOneofDecoderBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(self.function_comment)
+        self.push(f"{self.function_signature};")
+
+
+class BlockOneofFunctionDeclarations(BlockBindOneof[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockOneofEncoderFunctionDeclaration(self.d),
+            BlockOneofDecoderFunctionDeclaration(self.d),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockImportList(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockIncludeChildProtoHeader(proto, name=name)
+            for name, proto in self.bound.protos(recursive=False)
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockDefineMacroOpMode(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push("#define BITPROTO_OPTIMIZATION_MODE 1")
+        self.push_empty_line()
+        # The same byte order detection as the bitproto C lib's.
+        self.push("#ifndef BP_BIG_ENDIAN")
+        self.push(
+            "#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) || \\"
+        )
+        self.push("    defined(__BIG_ENDIAN__)")
+        self.push("#define BP_BIG_ENDIAN 1")
+        self.push("#else")
+        self.push("#define BP_BIG_ENDIAN 0")
+        self.push("#endif")
+        self.push("#endif")
+        self.push_empty_line()
+        # The same restrict qualifier as the bitproto C lib's.
+        self.push("#ifndef BP_RESTRICT")
+        self.push("#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L")
+        self.push("#define BP_RESTRICT restrict")
+        self.push("#elif defined(__GNUC__) || defined(_MSC_VER)")
+        self.push("#define BP_RESTRICT __restrict")
+        self.push("#else")
+        self.push("#define BP_RESTRICT")
+        self.push("#endif")
+        self.push("#endif")
+        self.push_empty_line()
+        # The same error code as the bitproto C lib's, which the optimization mode
+        # doesn't require.
+        self.push("#ifndef BP_ERR_SHORT_INPUT")
+        self.push("#define BP_ERR_SHORT_INPUT -1")
+        self.push("#endif")
+        if self.bound.get_option_as_int_or_raise("self_test"):
+            self.push("#ifndef BP_ERR_SELF_TEST")
+            self.push("#define BP_ERR_SELF_TEST -12")
+            self.push("#endif")
+        # The same hash mixing as the bitproto C lib's.
+        self.push("#ifndef BP_HASH_MIX")
+        self.push("#define BP_HASH_MIX(h, w) \\")
+        self.push(
+            "    ((h) = ((h) ^ (uint64_t)(w)) * 0x9e3779b97f4a7c15ULL, (h) ^= (h) >> 32)"
+        )
+        self.push("#define BP_HASH_INIT 0xcbf29ce484222325ULL")
+        self.push("#define BP_FIXED_WORD(r) \\")
+        self.push("    ((r) >= 0 ? (uint64_t)((r) + 0.5) : \\")
+        self.push("     (r) < 0 ? (uint64_t)(int64_t)((r) - 0.5) : 0)")
+        self.push("#endif")
+        # The same field layout struct as the bitproto C lib's.
+        self.push("#ifndef BP_FIELD_LAYOUT")
+        self.push("#define BP_FIELD_LAYOUT 1")
+        self.push("struct BpFieldLayout {")
+        self.push("    const char *name;")
+        self.push("    int offset;")
+        self.push("    int nbits;")
+        self.push("};")
+        self.push("#endif")
+        if self.formatter.checksum(self.bound):
+            self.push("#ifndef BP_ERR_CHECKSUM")
+            self.push("#define BP_ERR_CHECKSUM -2")
+            self.push("#endif")
+        if self.formatter.validates_enums(self.bound):
+            self.push("#ifndef BP_ERR_ENUM")
+            self.push("#define BP_ERR_ENUM -7")
+            self.push("#endif")
+        if self.bound.oneofs(bound=self.bound):
+            self.push("#ifndef BP_ERR_TAG")
+            self.push("#define BP_ERR_TAG -9")
+            self.push("#endif")
+        self.push_empty_line()
+        # Instrumentation hooks, the same as the bitproto C lib's.
+        self.push("#ifndef BP_TRACE_ENCODE")
+        self.push("#define BP_TRACE_ENCODE 0")
+        self.push("#define BP_TRACE_DECODE 1")
+        self.push("#ifdef BP_TRACE_HEADER")
+        self.push("#include BP_TRACE_HEADER")
+        self.push("#endif")
+        self.push("#endif")
+        self.push("#ifndef BP_TRACE_BEGIN")
+        self.push("#define BP_TRACE_BEGIN(name, dir, nbytes)")
+        self.push("#endif")
+        self.push("#ifndef BP_TRACE_END")
+        self.push("#define BP_TRACE_END(name, dir, nbytes)")
+        self.push("#endif")
+
+
+class BlockDataStructuresList(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if isinstance(d, Alias):
+            return BlockAliasDef(d)
+        if isinstance(d, Constant):
+            return BlockConstant(d)
+        if isinstance(d, Enum):
+            return BlockEnumDefs(d)
+        if isinstance(d, Message):
+            return BlockMessageDef(d)
+        if isinstance(d, Oneof):
+            return BlockOneofDef(d)
+        return None
+
+
+class BlockFunctionDeclarationsForUserList(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if not self.is_reachable(d):
+            return None
+        if isinstance(d, Message):
+            return BlockMessageFunctionDeclarationsForUser(d)
+        if isinstance(d, Oneof):
+            return BlockOneofFunctionDeclarations(d)
+        return None
+
+
+class BlockFunctionDeclarationsForInternalList(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if not self.is_reachable(d):
+            return None
+        if isinstance(d, Alias):
+            return BlockAliasFunctionDeclarationsForInternal(d)
+        if isinstance(d, Enum) and is_validated_enum(d):
+            return BlockEnumValidatorDeclaration(d)
+        if isinstance(d, Message):
+            return BlockMessageFunctionDeclarationsForInternal(d)
+        return None
+
+
+class BlockFieldAccessorsList(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if isinstance(d, Message):
+            # Bit offsets of fields are known only in messages in fixed size.
+            if not d.is_fixed_size():
+                return None
+            if not self.formatter.op_mode_accessor_fields(d):
+                return None
+            filter_messages = self._get_ctx_or_raise().optimization_mode_filter_messages
+            if filter_messages:
+                if d.name not in filter_messages:
+                    return None
+            return BlockMessageFieldAccessorList(d)
         return None
 
 
@@ -464,6 +1867,7 @@ class BlockList(BlockComposition[F]):
             BlockImportList(),
             BlockDataStructuresList(),
             BlockFunctionDeclarationsForUserList(),
+            BlockFieldAccessorsList(),
             BlockFunctionDeclarationsForInternalList(),
         ]
 
@@ -476,6 +1880,14 @@ class BlockMessageFunctionDeclarationsForUserOpMode(
         return [
             BlockMessageEncoderFunctionDeclaration(self.d),
             BlockMessageDecoderFunctionDeclaration(self.d),
+            BlockMessageBoundedDecoderFunctionDeclaration(self.d),
+            BlockMessageMaskedDecoderFunctionDeclaration(self.d),
+            BlockMessageBatchEncoderFunctionDeclaration(self.d),
+            BlockMessageBatchDecoderFunctionDeclaration(self.d),
+            BlockMessageCheckedFunctionDeclarations(self.d),
+            BlockMessageHashFunctionDeclaration(self.d),
+            BlockMessageEqualFunctionDeclaration(self.d),
+            BlockMessageSelfTestFunctionDeclaration(self.d),
         ]
 
     @override(BlockComposition)
@@ -492,6 +1904,8 @@ class BlockFunctionDeclarationsForUserListOpMode(BlockBoundDefinitionDispatcher[
                 if d.name not in filter_messages:
                     return None
             return BlockMessageFunctionDeclarationsForUserOpMode(d)
+        if isinstance(d, Oneof):
+            return BlockOneofFunctionDeclarations(d)
         return None
 
 
@@ -508,6 +1922,7 @@ class BlockListOpMode(BlockComposition[F]):
             BlockDefineMacroOpMode(),
             BlockDataStructuresList(),
             BlockFunctionDeclarationsForUserListOpMode(),
+            BlockFieldAccessorsList(),
         ]
 
 
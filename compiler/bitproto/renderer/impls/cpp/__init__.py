@@ -0,0 +1,3 @@
+from .renderer import RendererCpp
+
+__all__ = ("RendererCpp",)
@@ -0,0 +1,60 @@
+"""
+C++ formatter.
+"""
+
+from typing import Optional
+
+from bitproto._ast import (
+    Alias,
+    Array,
+    Fixed,
+    Float,
+    Message,
+    Proto,
+    SingleType,
+    Type,
+)
+from bitproto.errors import InternalError
+from bitproto.renderer.formatter import Formatter
+from bitproto.renderer.impls.c.formatter import CFormatter
+from bitproto.utils import override
+
+
+class CppFormatter(CFormatter):
+    """CppFormatter implements Formatter for C++ language.
+    The generated C++ code works on the structs generated for C, so the naming is
+    the same to CFormatter's.
+    """
+
+    @override(Formatter)
+    def format_import_statement(self, t: Proto, as_name: Optional[str] = None) -> str:
+        return '#include "{0}_bp.hpp"'.format(t.name)
+
+    def get_single_type_nbits(self, t: Type) -> int:
+        """Returns the number of bits of the single type inside given type t, if t
+        is a single type, or an alias or array of it. Returns 0 for messages, whose
+        layouts are described by their own codecs."""
+        if isinstance(t, Alias):
+            return self.get_single_type_nbits(t.type)
+        if isinstance(t, Array):
+            return self.get_single_type_nbits(t.element_type)
+        if isinstance(t, Message):
+            return 0
+        if isinstance(t, SingleType):
+            return t.nbits()
+        raise InternalError("get_single_type_nbits got unexpected type")
+
+    def format_real_spec(self, t: Type) -> Optional[str]:
+        """Formats the real spec for EncodeReal and DecodeReal, if the single type
+        inside given type t is float32 or fixed-point, e.g. FixedReal<16, 8, true>.
+        Returns None otherwise."""
+        if isinstance(t, Alias):
+            return self.format_real_spec(t.type)
+        if isinstance(t, Array):
+            return self.format_real_spec(t.element_type)
+        if isinstance(t, Float):
+            return "Float32Real"
+        if isinstance(t, Fixed):
+            signed = "true" if t.signed else "false"
+            return f"FixedReal<{t.cap}, {t.frac}, {signed}>"
+        return None
@@ -0,0 +1,188 @@
+"""
+Renderer for C++ header file.
+"""
+
+from typing import List, Optional
+
+from bitproto._ast import BoundDefinition, Message, Range
+from bitproto.renderer.block import (
+    Block,
+    BlockAheadNotice,
+    BlockBindMessage,
+    BlockBindProto,
+    BlockBoundDefinitionDispatcher,
+    BlockComposition,
+    BlockDeferable,
+)
+from bitproto.renderer.impls.cpp.formatter import CppFormatter as F
+from bitproto.renderer.renderer import Renderer
+from bitproto.utils import override, snake_case
+
+
+class BlockProtoDocstring(BlockBindProto[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push_definition_comments()
+
+
+class BlockIncludeGuard(BlockDeferable[F]):
+    def format_proto_macro_name(self) -> str:
+        proto_name = snake_case(self.bound.name).upper()
+        return f"__BITPROTO__{proto_name}_HPP__"
+
+    @override(Block)
+    def render(self) -> None:
+        macro_name = self.format_proto_macro_name()
+        self.push(f"#ifndef {macro_name}")
+        self.push(f"#define {macro_name} 1")
+
+    @override(BlockDeferable)
+    def defer(self) -> None:
+        self.push(f"#endif")
+
+
+class BlockIncludeHeaders(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        # Structs are the ones generated for C.
+        header = self.formatter.format_out_filename(self.bound, ".h")
+        self.push('#include "bitproto.hpp"')
+        self.push_empty_line()
+        self.push(f'#include "{header}"')
+
+
+class BlockIncludeChildProtoHeader(BlockBindProto[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push(self.formatter.format_import_statement(self.d))
+
+
+class BlockImportList(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockIncludeChildProtoHeader(proto, name=name)
+            for name, proto in self.bound.protos(recursive=False)
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockNamespace(BlockDeferable[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push("namespace bitproto {")
+
+    @override(BlockDeferable)
+    def defer(self) -> None:
+        self.push("}  // namespace bitproto")
+
+
+class BlockMessageCodec(BlockBindMessage[F]):
+    def render_endecode_at(self, is_encode: bool) -> None:
+        if is_encode:
+            self.push("template <int I>", indent=4)
+            self.push(
+                f"static inline void EncodeAt(const {self.message_type} &m, unsigned char *s) {{",
+                indent=4,
+            )
+        else:
+            self.push("template <int I>", indent=4)
+            self.push(
+                f"static inline void DecodeAt({self.message_type} &m, const unsigned char *s) {{",
+                indent=4,
+            )
+
+        if self.d.nfields() == 0:
+            self.push("(void)m;", indent=8)
+            self.push("(void)s;", indent=8)
+
+        function = "EncodeValue" if is_encode else "DecodeValue"
+        i = 0
+        for field in self.d.sorted_fields():
+            name = self.formatter.format_message_field_name(field)
+            t = self.formatter.field_type(field)
+            n = self.formatter.get_single_type_nbits(t)
+            spec = self.formatter.format_real_spec(t)
+            if spec is not None:
+                function_real = "EncodeReal" if is_encode else "DecodeReal"
+                self.push(f"{function_real}<I + {i}, {spec}>(s, m.{name});", indent=8)
+            elif isinstance(field.type, Range):
+                function_range = "EncodeRange" if is_encode else "DecodeRange"
+                lo = self.formatter.format_bp_range_lo(field.type)
+                self.push(
+                    f"{function_range}<I + {i}, {n}, {lo}>(s, m.{name});", indent=8
+                )
+            else:
+                self.push(f"{function}<I + {i}, {n}>(s, m.{name});", indent=8)
+            i += field.type.nbits()
+
+        self.push("}", indent=4)
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.d.is_fixed_size():
+            self.push_comment(
+                f"{self.message_type} is not in fixed size, use the C API instead."
+            )
+            return
+
+        self.push_comment(f"Codec of {self.message_type}, in {self.d.nbits()} bits.")
+        self.push("template <>")
+        self.push(f"struct Codec<{self.message_type}> {{")
+        self.push(f"static constexpr int kNbits = {self.d.nbits()};", indent=4)
+        self.push(f"static constexpr int kNbytes = {self.message_nbytes};", indent=4)
+        self.push_empty_line()
+        self.render_endecode_at(True)
+        self.push_empty_line()
+        self.render_endecode_at(False)
+        self.push("};")
+
+
+class BlockBoundDefinitionList(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if isinstance(d, Message):
+            return BlockMessageCodec(d)
+        return None
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
+class BlockList(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockAheadNotice(),
+            BlockProtoDocstring(self.bound),
+            BlockIncludeGuard(),
+            BlockIncludeHeaders(),
+            BlockImportList(),
+            BlockNamespace(),
+            BlockBoundDefinitionList(),
+        ]
+
+
+class RendererCpp(Renderer[F]):
+    """Renderer for C++ language (header only).
+    The generated header works on the structs in the header generated for C."""
+
+    @override(Renderer)
+    def language_name(self) -> str:
+        return "cpp"
+
+    @override(Renderer)
+    def file_extension(self) -> str:
+        return ".hpp"
+
+    @override(Renderer)
+    def formatter(self) -> F:
+        return F()
+
+    @override(Renderer)
+    def block(self) -> Block[F]:
+        return BlockList()
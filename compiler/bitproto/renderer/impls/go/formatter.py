@@ -2,7 +2,7 @@
 Go formatter
 """
 
-from typing import List, Optional
+from typing import List, Optional, Union
 
 from bitproto._ast import (
     Alias,
@@ -12,11 +12,14 @@ from bitproto._ast import (
     Constant,
     Enum,
     EnumField,
+    Fixed,
+    Float,
     Int,
     Integer,
     Message,
     MessageField,
     Proto,
+    Range,
     Type,
     Uint,
 )
@@ -99,8 +102,18 @@ class GoFormatter(Formatter):
     def format_int_type(self, t: Int) -> str:
         return "int{0}".format(self.get_nbits_of_integer(t))
 
+    @override(Formatter)
+    def format_float_type(self) -> str:
+        return "float32"
+
+    @override(Formatter)
+    def format_fixed_type(self, t: Fixed) -> str:
+        return "float64" if t.is_double() else "float32"
+
     @override(Formatter)
     def format_array_type(self, t: Array, name: Optional[str] = None) -> str:
+        if t.bounded:  # Holds the elements in use only.
+            return "[]{type}".format(type=self.format_type(t.element_type))
         return "[{cap}]{type}".format(type=self.format_type(t.element_type), cap=t.cap)
 
     @override(Formatter)
@@ -119,6 +132,15 @@ class GoFormatter(Formatter):
     # Library Supports
     ###################
 
+    def format_processor_var_name(self, t: Union[Alias, Enum, Message]) -> str:
+        """Formats the name of the package-level processor of given type, built once
+        at init and returned by its BpProcessor method."""
+        if isinstance(t, Alias):
+            return f"bpProcessor{self.format_alias_name(t)}"
+        if isinstance(t, Enum):
+            return f"bpProcessor{self.format_enum_name(t)}"
+        return f"bpProcessor{self.format_message_name(t)}"
+
     def format_processor(self, t: Type) -> str:
         if isinstance(t, Bool):
             return self.format_processor_bool()
@@ -136,6 +158,12 @@ class GoFormatter(Formatter):
             return self.format_processor_alias(t)
         elif isinstance(t, Message):
             return self.format_processor_message(t)
+        elif isinstance(t, Range):
+            return self.format_processor_range(t)
+        elif isinstance(t, Float):
+            return "bp.NewFloat32()"
+        elif isinstance(t, Fixed):
+            return f"bp.NewFixed({self.format_int_value(t.nbits())})"
         raise InternalError("format_bp_type got unexpected t")
 
     def format_processor_bool(self) -> str:
@@ -149,15 +177,66 @@ class GoFormatter(Formatter):
         nbits = self.format_int_value(t.nbits())
         return f"bp.NewUint({nbits})"
 
+    def format_processor_range(self, t: Range) -> str:
+        nbits = self.format_int_value(t.nbits())
+        return f"bp.NewRange({nbits})"
+
+    def format_range_lo(self, t: Range) -> str:
+        """Formats the lower bound of given range as an uint64 constant, in two's
+        complement if negative, e.g. 1000 and ^uint64(39) for -40."""
+        if t.lo >= 0:
+            return str(t.lo)
+        return f"^uint64({-t.lo - 1})"
+
+    def format_range_add_lo(self, t: Range, chain: str) -> List[str]:
+        """Formats the statement adding the lower bound of given range to the offset
+        decoded into variable chain, the bits above the offset are cleared by the mask.
+
+        Generated Go statement example:
+
+            m.Altitude = uint16((uint64(m.Altitude) & 32767) + 1000)
+        """
+        type_s = self.format_type(t)
+        v = f"(uint64({chain}) & {(1 << t.nbits()) - 1})"
+        if t.lo != 0:
+            v = f"{v} + {self.format_range_lo(t)}"
+        return [f"{chain} = {type_s}({v})"]
+
+    def format_real_value(self, value: float) -> str:
+        return repr(value)
+
+    def format_fixed_value(self, t: Fixed, w: str) -> str:
+        """Formats the fixed-point value of t from the bits w, an uint64 expression,
+        the same to bp.FixedValue, e.g. float64(int64((w^2048)-2048)) * 0.0625.
+        Bits of w higher than the fixed-point type must be zero."""
+        unit = self.format_real_value(t.unit())
+        if not t.signed:
+            return f"float64({w}) * {unit}"
+        m = 1 << (t.nbits() - 1)
+        return f"float64(int64(({w}^{m})-{m})) * {unit}"
+
     def format_processor_byte(self) -> str:
         return f"bp.NewByte()"
 
     def format_processor_array(self, t: Array) -> str:
+        if t.bounded:
+            return self.format_processor_bounded_array(t)
         extensible = self.format_bool_value(t.extensible)
         capacity = self.format_int_value(t.cap)
         et = self.format_processor(t.element_type)
         return f"bp.NewArray({extensible}, {capacity}, {et})"
 
+    def format_processor_bounded_array(self, t: Array) -> str:
+        capacity = self.format_int_value(t.cap)
+        count_nbits = self.format_int_value(t.count_nbits())
+        et = self.format_processor(t.element_type)
+        return f"bp.NewBoundedArray({capacity}, {count_nbits}, {et})"
+
+    def format_bounded_len(self, t: Array, v: str) -> str:
+        """Formats the number of elements in use of bounded array t held in slice v,
+        those beyond the capacity are dropped on encoding."""
+        return f"bp.BoundedLen(len({v}), {self.format_int_value(t.cap)})"
+
     def format_processor_enum(self, t: Enum) -> str:
         enum_name = self.format_enum_name(t)
         return f"({enum_name}(0)).BpProcessor()"
@@ -167,7 +246,7 @@ class GoFormatter(Formatter):
         s: str
         if isinstance(t.type, Bool):
             s = f"{alias_name}(false)"
-        elif isinstance(t.type, (Integer, Enum, Byte)):
+        elif isinstance(t.type, (Integer, Enum, Byte, Float, Fixed)):
             s = f"{alias_name}(0)"
         elif isinstance(t.type, Array):
             s = f"{alias_name}{{}}"
@@ -179,6 +258,27 @@ class GoFormatter(Formatter):
         message_name = self.format_message_name(t)
         return f"(&{message_name}{{}}).BpProcessor()"
 
+    def format_trace(self, t: Message, is_encode: bool) -> List[str]:
+        """Formats the call of the tracer of bitproto library, if set, around the
+        encoding or decoding of given message."""
+        message_name = self.format_message_name(t)
+        args = f'"{message_name}", {self.format_bool_value(is_encode)}, {t.nbytes()}'
+        return [
+            "if t := bp.GetTracer(); t != nil {",
+            f"\tdefer t.End(t.Begin({args}))",
+            "}",
+        ]
+
+    @override(Formatter)
+    def is_direct_codec(self, t: Message) -> bool:
+        """Proto option go.direct_codec sets it for all messages of the proto, except
+        those with bounded arrays."""
+        if t.has_bounded_array():
+            return False
+        if t.bound.get_option_as_bool_or_raise("go.direct_codec"):
+            return True
+        return super().is_direct_codec(t)
+
     ###################
     # Optimization Mode.
     ###################
@@ -187,6 +287,69 @@ class GoFormatter(Formatter):
     def format_op_mode_endecoder_message_var(self) -> str:
         return "m"
 
+    @override(Formatter)
+    def format_op_mode_range_offset(self, t: Range, chain: str) -> str:
+        """Implements format_op_mode_range_offset for Go.
+        Generated Go expression like:
+
+            (uint64(m.Altitude) - 1000)
+
+        """
+        if t.lo == 0:
+            return f"uint64({chain})"
+        return f"(uint64({chain}) - {self.format_range_lo(t)})"
+
+    @override(Formatter)
+    def format_op_mode_real_block(
+        self, t: Type, chain: str, w: Uint, is_encode: bool, body: List[str]
+    ) -> List[str]:
+        """Implements format_op_mode_real_block for Go.
+        Generated Go statements like:
+
+            {
+                r := float64(m.Heading) * 256.0
+                var w uint16
+                if r >= 0 {
+                    w = uint16(uint64(r + 0.5))
+                } else if r < 0 {
+                    w = uint16(int64(r - 0.5))
+                }
+                ...
+            }
+            {
+                var w uint32
+                ...
+                m.X = float32(math.Float32frombits(w))
+            }
+
+        """
+        t_ = t.type if isinstance(t, Alias) else t
+        type_s = self.format_type(t)
+        type_w = self.format_uint_type(w)
+        indent = self.indent_character()
+        l = ["{"]
+        if isinstance(t_, Float) and is_encode:
+            l.append(f"{indent}w := math.Float32bits(float32({chain}))")
+        elif is_encode:
+            scale = self.format_real_value(cast_or_raise(Fixed, t_).scale())
+            l.append(f"{indent}r := float64({chain}) * {scale}")
+            l.append(f"{indent}var w {type_w}")
+            l.append(f"{indent}if r >= 0 {{")
+            l.append(f"{indent * 2}w = {type_w}(uint64(r + 0.5))")
+            l.append(f"{indent}}} else if r < 0 {{")
+            l.append(f"{indent * 2}w = {type_w}(int64(r - 0.5))")
+            l.append(f"{indent}}}")
+        else:
+            l.append(f"{indent}var w {type_w}")
+        l.extend(indent + line for line in body)
+        if isinstance(t_, Float) and not is_encode:
+            l.append(f"{indent}{chain} = {type_s}(math.Float32frombits(w))")
+        elif isinstance(t_, Fixed) and not is_encode:
+            v = self.format_fixed_value(t_, "uint64(w)")
+            l.append(f"{indent}{chain} = {type_s}({v})")
+        l.append("}")
+        return l
+
     @override(Formatter)
     def format_op_mode_encoder_item(
         self, chain: str, t: Type, si: int, fi: int, shift: int, mask: int, r: int
@@ -199,16 +362,144 @@ class GoFormatter(Formatter):
         """
         bshift = " >> {0}".format(fi * 8) if fi > 0 else ""
         shift_s = self.format_op_mode_smart_shift(shift)
+        chain = self.format_op_mode_encoder_chain(chain, t)
+        return f"s[{self.format_op_mode_buffer_index(si)}] |= (byte({chain}{bshift}) {shift_s}) & {mask}"
 
-        # Handle go's annoying type casting
+    def format_op_mode_encoder_chain(self, chain: str, t: Type) -> str:
+        """Handle go's annoying type casting for booleans to encode."""
         if isinstance(t, Bool):
-            chain = f"bool2byte({chain})"
+            return f"bool2byte({chain})"
         elif isinstance(t, Alias):
             alias_t = cast_or_raise(Alias, t)
             if isinstance(alias_t.type, Bool):
-                chain = f"bool2byte(bool({chain}))"
+                return f"bool2byte(bool({chain}))"
+        return chain
 
-        return f"s[{si}] |= (byte({chain}{bshift}) {shift_s}) & {mask}"
+    @override(Formatter)
+    def format_op_mode_word_encoder_items(
+        self, chain: str, t: Type, si: int, o: int, n: int
+    ) -> List[str]:
+        """Implements format_op_mode_word_encoder_items for Go.
+        Generated Go statements like:
+
+                s[1] |= byte(uint64(m.Id) << 3)
+                s[2] = byte(uint64(m.Id) << 3 >> 8)
+                s[3] = byte(uint64(m.Id) << 3 >> 16) & 7
+
+        The bytes after the first one are not yet written by other fields.
+        """
+        k = self.op_mode_word_byte_count(o, n)
+        word = f"uint64({chain})" + (f" << {o}" if o else "")
+        l: List[str] = []
+        for b in range(k):
+            assign = "|=" if b == 0 and o else "="
+            rshift = f" >> {b * 8}" if b else ""
+            item = f"s[{self.format_op_mode_buffer_index(si + b)}] {assign} byte({word}{rshift})"
+            nbits_last = o + n - (k - 1) * 8
+            if b == k - 1 and nbits_last < 8:
+                item += f" & {(1 << nbits_last) - 1}"
+            l.append(item)
+        return l
+
+    @override(Formatter)
+    def format_op_mode_word_decoder_items(
+        self, chain: str, t: Type, si: int, o: int, n: int
+    ) -> List[str]:
+        """Implements format_op_mode_word_decoder_items for Go.
+        Generated Go statement like:
+
+                m.Id = uint16((uint64(s[1]) | uint64(s[2])<<8 | uint64(s[3])<<16) >> 3 & 1023)
+
+        """
+        k = self.op_mode_word_byte_count(o, n)
+        items = [f"uint64(s[{self.format_op_mode_buffer_index(si)}])"]
+        items.extend(f"uint64(s[{self.format_op_mode_buffer_index(si + b)}])<<{b * 8}" for b in range(1, k))
+        word = "(" + " | ".join(items) + ")"
+        if o:
+            word += f" >> {o}"
+        if n < 64:
+            word += f" & {(1 << n) - 1}"
+        type_s = self.format_type(t)
+        return [f"{chain} = {type_s}({word})"]
+
+    @override(Formatter)
+    def format_op_mode_array_loop(self, n: int, body: List[str]) -> List[str]:
+        """Implements format_op_mode_array_loop for Go.
+        Generated Go statements like:
+
+                for k := 0; k < 33; k++ {
+                        s[3+k] |= (byte(m.Bytes[k]) >> 0) & 255
+                }
+
+        """
+        indent = self.indent_character()
+        l = [f"for k := 0; k < {n}; k++ {{"]
+        l.extend(indent + line for line in body)
+        l.append("}")
+        return l
+
+    @override(Formatter)
+    def format_op_mode_loop_index(self, base: int, stride: int) -> str:
+        """Formats the loop index like `3+2*k` for Go."""
+        k = "k" if stride == 1 else f"{stride}*k"
+        return k if base == 0 else f"{base}+{k}"
+
+    def format_op_mode_normalizer_name(self, t: Message) -> str:
+        return f"bpOpNormalize{self.format_message_name(t)}"
+
+    @override(Formatter)
+    def format_op_mode_encoder_constant_item(self, si: int, value: int, r: int) -> str:
+        """Implements format_op_mode_encoder_constant_item for Go.
+        Generated Go statement like:
+
+                s[0] |= 250
+
+        """
+        return f"s[{si}] |= {value}"
+
+    @override(Formatter)
+    def format_op_mode_ahead_check(self, p: int, value: int) -> str:
+        return f"bpOpReadAhead(s, {p}) == {value}"
+
+    @override(Formatter)
+    def format_op_mode_normalizer_copy(self, p: int, n: int) -> List[str]:
+        return [f"bpOpCopyBits(t, {p}, s, i, {n})", f"i += {n}"]
+
+    @override(Formatter)
+    def format_op_mode_normalizer_ahead_begin(
+        self, k: int, p: int, value: int
+    ) -> List[str]:
+        return [
+            f"i{k} := i",
+            f"a{k} := int(bpOpReadAhead(s, i))",
+            f"bpOpWriteAhead(t, {p}, {value})",
+            "i += 16",
+        ]
+
+    @override(Formatter)
+    def format_op_mode_normalizer_ahead_end(self, k: int, factor: int) -> List[str]:
+        ahead = f"a{k}" if factor == 1 else f"a{k}*{factor}"
+        return [
+            f"if i{k}+{ahead} >= i {{",
+            f"{self.indent_character()}i = i{k} + {ahead}",
+            "}",
+        ]
+
+    @override(Formatter)
+    def format_op_mode_patcher_item(
+        self, chain: str, t: Type, si: int, fi: int, shift: int, mask: int
+    ) -> str:
+        """Implements format_op_mode_patcher_item for Go.
+        Generated Go statement like:
+
+                s[0] = (s[0] & 199) | ((byte(v) << 3) & 56)
+
+        """
+        bshift = " >> {0}".format(fi * 8) if fi > 0 else ""
+        shift_s = self.format_op_mode_smart_shift(shift)
+        chain = self.format_op_mode_encoder_chain(chain, t)
+        keep = 255 ^ mask
+        return f"s[{si}] = (s[{si}] & {keep}) | ((byte({chain}{bshift}) {shift_s}) & {mask})"
 
     @override(Formatter)
     def format_op_mode_decoder_item(
@@ -223,7 +514,7 @@ class GoFormatter(Formatter):
         bshift = " << {0}".format(fi * 8) if fi > 0 else ""
         shift_s = self.format_op_mode_smart_shift(shift)
 
-        byte = f"byte(s[{si}] {shift_s}) & {mask}"
+        byte = f"byte(s[{self.format_op_mode_buffer_index(si)}] {shift_s}) & {mask}"
 
         assign = "|="
         type_s = self.format_type(t)
@@ -252,6 +543,8 @@ class GoFormatter(Formatter):
             t = t.type
         if isinstance(t, Int):
             return self.post_format_op_mode_endecode_int(t, chain, is_encode)
+        if isinstance(t, Range) and not is_encode:
+            return self.format_range_add_lo(t, chain)
         return []
 
     def post_format_op_mode_endecode_int(
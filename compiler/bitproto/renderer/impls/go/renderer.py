@@ -10,11 +10,21 @@ from bitproto._ast import (
     Array,
     Bool,
     BoundDefinition,
+    Byte,
     Constant,
+    Definition,
     Enum,
+    Fixed,
+    Float,
     Int,
     Message,
+    MessageField,
+    Oneof,
+    OneofVariant,
+    Range,
     SingleType,
+    Type,
+    Uint,
 )
 from bitproto.renderer.block import (
     Block,
@@ -25,6 +35,7 @@ from bitproto.renderer.block import (
     BlockBindEnumField,
     BlockBindMessage,
     BlockBindMessageField,
+    BlockBindOneof,
     BlockBindProto,
     BlockBoundDefinitionDispatcher,
     BlockComposition,
@@ -32,11 +43,26 @@ from bitproto.renderer.block import (
 )
 from bitproto.renderer.impls.go.formatter import GoFormatter as F
 from bitproto.renderer.renderer import Renderer
-from bitproto.utils import cached_property, override, snake_case
+from bitproto.utils import (
+    cached_property,
+    overridable,
+    override,
+    pascal_case,
+    snake_case,
+    upper_case,
+)
+from bitproto.vectors import Vector, message_vectors
 
 GO_LIB_IMPORT_PATH = "github.com/hit9/bitproto/lib/go"
 
 
+class BlockBuildConstraint(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        if self.bound.get_option_as_bool_or_raise("go.generics"):
+            self.push("//go:build go1.18")
+
+
 class BlockPackageName(BlockBindProto[F]):
     @override(Block)
     def render(self) -> None:
@@ -48,6 +74,7 @@ class BlockGeneralImports(Block):
     @override(Block)
     def render(self) -> None:
         self.push(f"import (")
+        self.push(f'"math"', indent=1)
         self.push(f'"strconv"', indent=1)
         self.push(f'"encoding/json"', indent=1)
         self.push_empty_line()
@@ -80,6 +107,7 @@ class BlockAvoidGeneralImportsNotUsed(Block):
         self.push_comment("Avoid possible golang import not used error")
         self.push(f"var formatInt = strconv.FormatInt")
         self.push(f"var jsonMarshal = json.Marshal")
+        self.push(f"var float32bits = math.Float32bits")
         self.push(f"var _ = bp.Useless")
 
 
@@ -95,8 +123,11 @@ class BlockAliasMethodBpProcessor(BlockAliasMethodBase):
     @override(Block)
     def render(self) -> None:
         to = self.formatter.format_processor(self.d.type)
+        var_name = self.formatter.format_processor_var_name(self.d)
+        self.push(f"var {var_name} = bp.NewAliasProcessor({to})")
+        self.push_empty_line()
         self.push(f"func (m {self.method_receiver}) BpProcessor() bp.Processor {{")
-        self.push(f"return bp.NewAliasProcessor({to})", indent=self.indent + 1)
+        self.push(f"return {var_name}", indent=self.indent + 1)
         self.push("}")
 
 
@@ -218,8 +249,11 @@ class BlockEnumMethodBpProcessor(BlockBindEnum[F]):
     @override(Block)
     def render(self) -> None:
         uint = self.formatter.format_processor_uint(self.d.type)
+        var_name = self.formatter.format_processor_var_name(self.d)
+        self.push(f"var {var_name} = bp.NewEnumProcessor({uint})")
+        self.push_empty_line()
         self.push(f"func (m {self.enum_name}) BpProcessor() bp.Processor {{")
-        self.push(f"return bp.NewEnumProcessor({uint})", indent=self.indent + 1)
+        self.push(f"return {var_name}", indent=self.indent + 1)
         self.push("}")
 
 
@@ -257,13 +291,34 @@ class BlockEnum(BlockBindEnum[F], BlockComposition[F]):
         return "\n\n"
 
 
+def is_zero_copy_bytes(b: Block[F], field: MessageField) -> bool:
+    """Returns True if given message field is rendered as a []byte slice aliasing the
+    decoding buffer, by option go.zero_copy_bytes. That's a byte array declared
+    without alias, in standard mode, of a message without option direct_codec, where
+    arrays are processed by the bitproto library.
+    """
+    t = field.type
+    if not (isinstance(t, Array) and isinstance(t.element_type, Byte)):
+        return False
+    if t.bounded:
+        return False
+    if b._get_ctx_or_raise().optimization_mode:
+        return False
+    if b.formatter.is_direct_codec(field.message):
+        return False
+    return b.bound.get_option_as_bool_or_raise("go.zero_copy_bytes")
+
+
 class BlockMessageField(BlockBindMessageField[F]):
     @override(Block)
     def render(self) -> None:
         self.push_definition_comments()
         snake_case_name = snake_case(self.message_field_name)
+        field_type = self.message_field_type
+        if is_zero_copy_bytes(self, self.d):
+            field_type = "[]byte"
         self.push(
-            f'{self.message_field_name} {self.message_field_type} `json:"{snake_case_name}"`'
+            f'{self.message_field_name} {field_type} `json:"{snake_case_name}"`'
         )
         self.push_typing_hint_inline_comment()
 
@@ -288,6 +343,27 @@ class BlockMessageSizeConst(BlockBindMessage[F]):
         self.push(
             f"const {self.message_size_constant_name} uint32 = {self.message_nbytes}"
         )
+        self.push_comment(
+            f"Layout fingerprint of struct {self.message_name}, to check compatibility"
+        )
+        self.push(
+            f"const {self.message_fingerprint_constant_name} uint64 = {self.message_fingerprint}"
+        )
+
+
+class BlockMessageFieldMaskConsts(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        if not self.has_masked_decoder:
+            return
+        self.push_comment(
+            f"Mask bits selecting the fields of struct {self.message_name} in DecodeMasked"
+        )
+        self.push("const (")
+        for k, field in enumerate(self.d.sorted_fields()):
+            name = self.format_field_mask_constant_name(field)
+            self.push(f"{name} uint64 = 1 << {k}", indent=1)
+        self.push(")")
 
 
 class BlockMessageStruct(BlockBindMessage[F], BlockWrapper[F]):
@@ -337,28 +413,32 @@ class BlockMessageMethodBpProcessorFieldList(BlockBindMessage[F], BlockCompositi
 class BlockMessageMethodBpProcessor(BlockBindMessage[F], BlockWrapper[F]):
     @override(BlockWrapper)
     def wraps(self) -> Optional[Block[F]]:
-        return BlockMessageMethodBpProcessorFieldList(self.d, indent=self.indent + 2)
+        return BlockMessageMethodBpProcessorFieldList(self.d, indent=self.indent + 1)
 
     @override(BlockWrapper)
     def before(self) -> None:
-        self.push(f"func (m *{self.message_name}) BpProcessor() bp.Processor {{")
+        nbits = self.formatter.format_int_value(self.d.nbits())
+        extensible = self.formatter.format_bool_value(self.d.extensible)
+        var_name = self.formatter.format_processor_var_name(self.d)
+        self.push_comment(
+            f"Processor of struct {self.message_name}, built once at init and shared "
+            "by all encoding and decoding, it's immutable."
+        )
         self.push(
-            "fieldDescriptors := []*bp.MessageFieldProcessor{", indent=self.indent + 1
+            f"var {var_name} = bp.NewMessageProcessor({extensible}, {nbits}, "
+            "[]*bp.MessageFieldProcessor{"
         )
 
     @override(BlockWrapper)
     def after(self) -> None:
-        nbits = self.formatter.format_int_value(self.d.nbits())
-        extensible = self.formatter.format_bool_value(self.d.extensible)
-
+        var_name = self.formatter.format_processor_var_name(self.d)
         if self.d.nfields() == 0:
-            self.push_string("}", separator="")
+            self.push_string("})", separator="")
         else:
-            self.push("}", indent=self.indent + 1)
-        self.push(
-            f"return bp.NewMessageProcessor({extensible}, {nbits}, fieldDescriptors)",
-            indent=self.indent + 1,
-        )
+            self.push("})")
+        self.push_empty_line()
+        self.push(f"func (m *{self.message_name}) BpProcessor() bp.Processor {{")
+        self.push(f"return {var_name}", indent=self.indent + 1)
         self.push("}")
 
 
@@ -383,6 +463,7 @@ class BlockMessageMethodBpGetSetByteItemBase(BlockBindMessageField[F]):
     def render_single(self, single: SingleType, alias: Optional[Alias] = None) -> None:
         raise NotImplementedError
 
+    @overridable
     def render_array(self, array: Array) -> None:
         try:
             self.array_depth += 1
@@ -399,6 +480,7 @@ class BlockMessageMethodBpGetSetByteItemBase(BlockBindMessageField[F]):
         if isinstance(alias.type, Array):
             return self.render_array(alias.type)
 
+    @overridable
     @override(Block)
     def render(self) -> None:
         if isinstance(self.d.type, SingleType):
@@ -429,6 +511,9 @@ class BlockMessageMethodBpSetByteItem(BlockMessageMethodBpGetSetByteItemBase):
             if alias:
                 value = f"{type_name}({value})"
 
+        if isinstance(single, (Float, Fixed)):
+            return self.render_real(single, type_name)
+
         self.render_case()
 
         if shift:
@@ -437,6 +522,23 @@ class BlockMessageMethodBpSetByteItem(BlockMessageMethodBpGetSetByteItemBase):
             self.push(f"{left} {assign} {value}", indent=self.indent + 1)
 
 
+    def render_real(self, single: SingleType, type_name: str) -> None:
+        # Collects the decoded bits in the bits of the value, fixed-point values
+        # are converted in BpProcessInt.
+        left = self.format_data_ref()
+        bits = "Float32"
+        if isinstance(single, Fixed) and single.is_double():
+            bits = "Float64"
+        uint = "uint32" if bits == "Float32" else "uint64"
+        type_bits = bits.lower()
+        value = f"math.{bits}bits({type_bits}({left})) | {uint}(b)<<lshift"
+        self.render_case()
+        self.push(
+            f"{left} = {type_name}(math.{bits}frombits({value}))",
+            indent=self.indent + 1,
+        )
+
+
 class BlockMessageMethodBpSetByteItemDefault(Block[F]):
     @override(Block)
     def render(self) -> None:
@@ -488,6 +590,14 @@ class BlockMessageMethodBpGetByteItem(BlockMessageMethodBpGetSetByteItemBase):
             value = f"bp.Bool2byte({data}) {shift}"
             if alias:
                 value = f"bp.Bool2byte(bool({data})) {shift}"
+        elif isinstance(single, Range) and single.lo != 0:
+            lo = self.formatter.format_range_lo(single)
+            value = f"byte((uint64({data}) - {lo}) {shift})"
+        elif isinstance(single, Float):
+            value = f"byte(math.Float32bits(float32({data})) {shift})"
+        elif isinstance(single, Fixed):
+            scale = self.formatter.format_real_value(single.scale())
+            value = f"byte(bp.FixedBits(float64({data}), {scale}) {shift})"
         else:
             value = f"byte({data} {shift})"
 
@@ -538,8 +648,12 @@ class BlockMessageMethodBpGetByte(BlockBindMessage[F], BlockWrapper[F]):
 class BlockMessageMethodBpProcessIntItem(BlockMessageMethodBpGetSetByteItemBase):
     @override(BlockMessageMethodBpGetSetByteItemBase)
     def render_single(self, single: SingleType, alias: Optional[Alias] = None) -> None:
+        if isinstance(single, Range):
+            return self.render_range(single)
+        if isinstance(single, Fixed):
+            return self.render_fixed(single, alias)
         if not isinstance(single, Int):
-            # BpProcessInt cares only about signed integer type
+            # BpProcessInt cares only about signed integer type and range
             return
 
         # d is how many bits to shift
@@ -555,6 +669,26 @@ class BlockMessageMethodBpProcessIntItem(BlockMessageMethodBpGetSetByteItemBase)
         self.push(f"{left} <<= {d}", indent=self.indent + 1)
         self.push(f"{left} >>= {d}", indent=self.indent + 1)
 
+    def render_fixed(self, single: Fixed, alias: Optional[Alias] = None) -> None:
+        # Converts the bits decoded into the value, see BpSetByte.
+        left = self.format_data_ref()
+        type_name = self.formatter.format_type(alias or single)
+        if single.is_double():
+            w = f"math.Float64bits(float64({left}))"
+        else:
+            w = f"uint64(math.Float32bits(float32({left})))"
+        v = self.formatter.format_fixed_value(single, w)
+        self.render_case()
+        self.push(f"{left} = {type_name}({v})", indent=self.indent + 1)
+
+    def render_range(self, single: Range) -> None:
+        # Adds the lower bound back to the offset decoded.
+        if single.lo == 0:
+            return
+        self.render_case()
+        for line in self.formatter.format_range_add_lo(single, self.format_data_ref()):
+            self.push(line, indent=self.indent + 1)
+
 
 class BlockMessageMethodBpProcessIntItemDefault(Block[F]):
     @override(Block)
@@ -594,6 +728,144 @@ class BlockMessageMethodBpProcessInt(BlockBindMessage[F], BlockWrapper[F]):
         self.push("}")
 
 
+class BlockMessageMethodBpProcessArrayItem(BlockMessageMethodBpGetSetByteItemBase):
+    def is_bulk_element(self, t: Type) -> bool:
+        """Returns True if given array element type is byte, a standard-width
+        integer or float32, which the bitproto library processes in a batch.
+        Keep in sync with function isBulkElement in the library.
+        """
+        if isinstance(t, Byte):
+            return True
+        if isinstance(t, (Int, Uint)):
+            return t.nbits() in (8, 16, 32, 64)
+        return isinstance(t, Float)
+
+    def format_process_function(self, t: Type) -> str:
+        if isinstance(t, Byte) or (isinstance(t, Uint) and t.nbits() == 8):
+            return "bp.ProcessBytes"
+        if isinstance(t, Float):
+            return "bp.ProcessFloat32s"
+        sign = "Int" if isinstance(t, Int) else "Uint"
+        return f"bp.Process{sign}{t.nbits()}s"
+
+    @override(BlockMessageMethodBpGetSetByteItemBase)
+    def render_single(self, single: SingleType, alias: Optional[Alias] = None) -> None:
+        # BpProcessArray cares only about arrays.
+        return
+
+    @override(BlockMessageMethodBpGetSetByteItemBase)
+    def render(self) -> None:
+        if not is_zero_copy_bytes(self, self.d):
+            return super().render()
+        assert isinstance(self.d.type, Array)
+        self.render_case()
+        self.push(
+            f"bp.ProcessByteSlice(ctx, &m.{self.message_field_name}, {self.d.type.cap})",
+            indent=self.indent + 1,
+        )
+        self.push("return true", indent=self.indent + 1)
+
+    @override(BlockMessageMethodBpGetSetByteItemBase)
+    def render_array(self, array: Array) -> None:
+        if not self.is_bulk_element(array.element_type):
+            return super().render_array(array)
+
+        data = self.format_data_ref()
+        if array.bounded:
+            data = f"{data}[:{self.formatter.format_bounded_len(array, data)}]"
+        else:
+            data = f"{data}[:]"
+        function = self.format_process_function(array.element_type)
+        self.render_case()
+        self.push(f"{function}(ctx, {data})", indent=self.indent + 1)
+        self.push("return true", indent=self.indent + 1)
+
+
+class BlockMessageMethodBpProcessArrayItemDefault(Block[F]):
+    @override(Block)
+    def render(self) -> None:
+        self.push("default:")
+        self.push("return false", indent=self.indent + 1)
+
+
+class BlockMessageMethodBpProcessArrayItemList(
+    BlockBindMessage[F], BlockComposition[F]
+):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = [
+            BlockMessageMethodBpProcessArrayItem(field, indent=self.indent)
+            for field in self.d.sorted_fields()
+        ]
+        b.append(BlockMessageMethodBpProcessArrayItemDefault(indent=self.indent))
+        return b
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n"
+
+
+class BlockMessageMethodBpProcessArray(BlockBindMessage[F], BlockWrapper[F]):
+    @override(BlockWrapper)
+    def wraps(self) -> Optional[Block[F]]:
+        return BlockMessageMethodBpProcessArrayItemList(self.d, indent=self.indent + 2)
+
+    @override(BlockWrapper)
+    def before(self) -> None:
+        self.push(
+            f"func (m *{self.message_name}) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {{"
+        )
+        self.push("switch di.F() {", indent=self.indent + 1)
+
+    @override(BlockWrapper)
+    def after(self) -> None:
+        self.push("}", indent=self.indent + 1)
+        self.push("}")
+
+
+class BlockMessageMethodBpGetSetLen(BlockBindMessage[F]):
+    """Methods BpGetLen and BpSetLen implementing bp.BoundedAccessor, rendered only
+    for messages with bounded array fields."""
+
+    @cached_property
+    def bounded_fields(self) -> List[MessageField]:
+        return [
+            field
+            for field in self.d.sorted_fields()
+            if isinstance(field.type, Array) and field.type.bounded
+        ]
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.bounded_fields:
+            return
+        m = f"(m *{self.message_name})"
+        self.push(f"func {m} BpGetLen(di *bp.DataIndexer) int {{")
+        self.push("switch di.F() {", indent=1)
+        for field in self.bounded_fields:
+            name = self.formatter.format_message_field_name(field)
+            self.push(f"case {self.formatter.format_int_value(field.number)}:", indent=1)
+            self.push(f"return len(m.{name})", indent=2)
+        self.push("default:", indent=1)
+        self.push("return 0  // Won't reached", indent=2)
+        self.push("}", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push(f"func {m} BpSetLen(di *bp.DataIndexer, n int) {{")
+        self.push("switch di.F() {", indent=1)
+        for field in self.bounded_fields:
+            assert isinstance(field.type, Array)
+            name = self.formatter.format_message_field_name(field)
+            element_type = self.formatter.format_type(field.type.element_type)
+            self.push(f"case {self.formatter.format_int_value(field.number)}:", indent=1)
+            self.push(
+                f"m.{name} = append(m.{name}[:0], make([]{element_type}, n)...)",
+                indent=2,
+            )
+        self.push("}", indent=1)
+        self.push("}")
+
+
 class BlockMessageMethodBpGetAccessorItem(BlockBindMessageField[F]):
     def __init__(
         self,
@@ -687,170 +959,1236 @@ class BlockMessageMethodString(BlockBindMessage[F]):
             f"Returns string representation for struct {self.message_name}."
         )
         self.push(f"func (m *{self.message_name}) String() string {{")
-        self.push(f"v, _ := jsonMarshal(m)", indent=1)
-        self.push(f"return string(v)", indent=1)
+        self.push(f"return string(m.AppendJSON(nil))", indent=1)
         self.push("}")
 
 
-class BlockMessageMethodEncode(BlockBindMessage[F]):
-    @override(Block)
-    def render(self) -> None:
-        self.push_comment(f"Encode struct {self.message_name} to bytes buffer.")
-        self.push(f"func (m *{self.message_name}) Encode() []byte {{")
-        self.push(f"ctx := bp.NewEncodeContext(int(m.Size()))", indent=1)
-        self.push(f"m.BpProcessor().Process(ctx, nil, m)", indent=1)
-        self.push(f"return ctx.Buffer()", indent=1)
-        self.push("}")
+class BlockMessageMethodAppendJSON(BlockBindMessage[F]):
+    """Json formatting methods without reflection, of which the output is the same to
+    the C library's BpJsonFormatMessage byte for byte: keys are field names, in
+    order of field numbers, enums are numbers, and no spaces."""
 
+    def push_append(self, s: str, indent: int) -> None:
+        self.push(f"b = append(b, `{s}`...)", indent=indent)
+
+    def render_value(
+        self,
+        t: Type,
+        d: Definition,
+        v: str,
+        indent: int,
+        depth: int = 0,
+        aliased: bool = False,
+    ) -> None:
+        """Renders statements appending the json format of value v in type t. The
+        definition d is the message field or alias the type belongs to."""
+        if isinstance(t, Alias):
+            return self.render_value(t.type, t, v, indent, depth, aliased=True)
+        if isinstance(t, Range):
+            return self.render_value(t.type, d, v, indent, depth)
+        if isinstance(t, Bool):
+            v = f"bool({v})" if aliased else v
+            self.push(f"b = strconv.AppendBool(b, {v})", indent=indent)
+        elif isinstance(t, Int):
+            self.push(f"b = strconv.AppendInt(b, int64({v}), 10)", indent=indent)
+        elif isinstance(t, (Uint, Byte, Enum)):
+            self.push(f"b = strconv.AppendUint(b, uint64({v}), 10)", indent=indent)
+        elif isinstance(t, (Float, Fixed)):
+            # Precision of 9 digits for float, 17 for double, null if not finite.
+            digits = 17 if isinstance(t, Fixed) and t.is_double() else 9
+            self.push(f"if f := float64({v}); f-f != 0 {{", indent=indent)
+            self.push_append("null", indent=indent + 1)
+            self.push("} else {", indent=indent)
+            self.push(
+                f"b = strconv.AppendFloat(b, f, 'g', {digits}, 64)", indent=indent + 1
+            )
+            self.push("}", indent=indent)
+        elif isinstance(t, Message):
+            self.push(f"b = {v}.AppendJSON(b)", indent=indent)
+        elif isinstance(t, Array) and self.formatter.json_bytes(t, d) != "array":
+            function = self.json_bytes_function(t, d)
+            n = self.formatter.format_bounded_len(t, v) if t.bounded else t.cap
+            self.push(f"b = bp.{function}(b, {v}[:], {n})", indent=indent)
+        elif isinstance(t, Array):
+            k = f"k{depth}"
+            if t.bounded:
+                v = f"{v}[:{self.formatter.format_bounded_len(t, v)}]"
+            self.push("b = append(b, '[')", indent=indent)
+            self.push(f"for {k} := range {v} {{", indent=indent)
+            self.push(f"if {k} > 0 {{", indent=indent + 1)
+            self.push("b = append(b, ',')", indent=indent + 2)
+            self.push("}", indent=indent + 1)
+            self.render_value(t.element_type, d, f"{v}[{k}]", indent + 1, depth + 1)
+            self.push("}", indent=indent)
+            self.push("b = append(b, ']')", indent=indent)
+
+    def json_bytes_function(self, t: Array, d: Definition) -> str:
+        """Returns the library function appending the json format of byte array t."""
+        json_bytes = self.formatter.json_bytes(t, d)
+        if json_bytes == "hex":
+            return "AppendJSONHex"
+        if json_bytes == "base64":
+            return "AppendJSONBase64"
+        return "AppendJSONBytes"
 
-class BlockMessageMethodDecode(BlockBindMessage[F]):
     @override(Block)
     def render(self) -> None:
-        self.push(f"func (m *{self.message_name}) Decode(s []byte) {{")
-        self.push(f"ctx := bp.NewDecodeContext(s)", indent=1)
-        self.push(f"m.BpProcessor().Process(ctx, nil, m)", indent=1)
+        m = f"(m *{self.message_name})"
+        self.push_comment(
+            f"AppendJSON appends the json format of struct {self.message_name} to b, "
+            "and returns the extended buffer."
+        )
+        self.push_comment(
+            "The output is the same to the C library's, without reflection."
+        )
+        self.push(f"func {m} AppendJSON(b []byte) []byte {{")
+        fields = self.d.sorted_fields()
+        if not fields:
+            self.push_append("{}", indent=1)
+        for k, field in enumerate(fields):
+            self.push_append(("{" if k == 0 else ",") + f'"{field.name}":', indent=1)
+            v = f"m.{self.formatter.format_message_field_name(field)}"
+            if is_zero_copy_bytes(self, field):
+                assert isinstance(field.type, Array)
+                function = self.json_bytes_function(field.type, field)
+                self.push(f"b = bp.{function}(b, {v}, {field.type.cap})", indent=1)
+            else:
+                self.render_value(field.type, field, v, indent=1)
+        if fields:
+            self.push("b = append(b, '}')", indent=1)
+        self.push("return b", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment("MarshalJSON implements json.Marshaler.")
+        self.push(f"func {m} MarshalJSON() ([]byte, error) {{")
+        self.push("return m.AppendJSON(nil), nil", indent=1)
         self.push("}")
 
 
-class BlockMessage(BlockBindMessage[F], BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockMessageStruct(self.d),
-            BlockMessageSizeConst(self.d),
-            BlockMessageMethodSize(self.d),
-            BlockMessageMethodString(self.d),
-            BlockMessageMethodEncode(self.d),
-            BlockMessageMethodDecode(self.d),
-            BlockMessageMethodBpProcessor(self.d),
-            BlockMessageMethodBpGetAccessor(self.d),
-            BlockMessageMethodBpSetByte(self.d),
-            BlockMessageMethodBpGetByte(self.d),
-            BlockMessageMethodBpProcessInt(self.d),
-        ]
+class BlockMessageMethodHashEqualBase(BlockBindMessage[F]):
+    """Base of the Hash and Equal methods, working on the bits of the fields to encode:
+    the bits above an integer's width are masked off, float32s are taken by bits, and
+    fixed-point values are scaled and rounded the same as the encoder."""
+
+    def word(self, t: Type, v: str) -> str:
+        """Formats the meaningful bits of value v of single type t as an uint64."""
+        if isinstance(t, Alias):
+            return self.word(t.type, f"{self.formatter.format_type(t.type)}({v})")
+        nbits = t.nbits()
+        mask = f"&{(1 << nbits) - 1}" if nbits < 64 else ""
+        if isinstance(t, Bool):
+            return f"uint64(bool2byte({v}))"
+        if isinstance(t, Float):
+            return f"uint64(math.Float32bits({v}))"
+        if isinstance(t, Fixed):
+            scale = self.formatter.format_real_value(t.scale())
+            return f"bpFixedWord(float64({v})*{scale}){mask}"
+        if isinstance(t, Range):
+            return f"{self.formatter.format_op_mode_range_offset(t, v)}{mask}"
+        if isinstance(t, (Uint, Int, Enum)):
+            if self.formatter.get_nbits_of_integer(t) == nbits:
+                return f"uint64({v})"
+            return f"uint64({v}){mask}"
+        return f"uint64({v})"
+
+    def is_exact(self, t: Type) -> bool:
+        """Returns True if every bit of type t in Go is meaningful, that is, values of
+        it are equal by == if and only if they encode the same."""
+        if isinstance(t, Alias):
+            return self.is_exact(t.type)
+        if isinstance(t, (Bool, Byte)):
+            return True
+        if isinstance(t, (Uint, Int, Enum)) and not isinstance(t, Range):
+            return self.formatter.get_nbits_of_integer(t) == t.nbits()
+        if isinstance(t, Array):
+            return self.is_exact(t.element_type)
+        return False
+
+
+class BlockMessageMethodHash(BlockMessageMethodHashEqualBase):
+    def render_value(self, t: Type, v: str, indent: int, depth: int = 0) -> None:
+        """Renders statements mixing value v in type t into the hash h."""
+        if isinstance(t, Alias) and isinstance(t.type, Array):
+            return self.render_value(t.type, v, indent, depth)
+        if isinstance(t, Array) and t.bounded:
+            # The count is mixed, then the elements in use.
+            n = self.formatter.format_bounded_len(t, v)
+            self.push(f"h = bpHashMix(h, uint64({n}))", indent=indent)
+            v = f"{v}[:{n}]"
+        if isinstance(t, Message):
+            self.push(f"h = bpHashMix(h, {v}.Hash())", indent=indent)
+        elif isinstance(t, Array) and isinstance(t.element_type, Byte):
+            self.push(f"h = bpHashBytes(h, {v}[:])", indent=indent)
+        elif isinstance(t, Array):
+            k = f"k{depth}"
+            self.push(f"for {k} := range {v} {{", indent=indent)
+            self.render_value(t.element_type, f"{v}[{k}]", indent + 1, depth + 1)
+            self.push("}", indent=indent)
+        else:
+            self.push(f"h = bpHashMix(h, {self.word(t, v)})", indent=indent)
 
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Hash returns the hash of struct {self.message_name} by the bits of its "
+            "fields to encode, without encoding it."
+        )
+        self.push_comment("Messages equal by Equal have the same hash.")
+        self.push(f"func (m *{self.message_name}) Hash() uint64 {{")
+        self.push("h := uint64(0xcbf29ce484222325)", indent=1)
+        for field in self.d.sorted_fields():
+            v = f"m.{self.formatter.format_message_field_name(field)}"
+            if is_zero_copy_bytes(self, field):
+                assert isinstance(field.type, Array)
+                self.push(f"h = bp.HashByteSlice(h, {v}, {field.type.cap})", indent=1)
+            else:
+                self.render_value(field.type, v, indent=1)
+        self.push("return h", indent=1)
+        self.push("}")
 
-class BlockBoundDefinitionList(BlockBoundDefinitionDispatcher[F]):
-    @override(BlockBoundDefinitionDispatcher)
-    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
-        if isinstance(d, Alias):
-            return BlockAlias(d)
-        if isinstance(d, Constant):
-            return BlockConstant(d)
-        if isinstance(d, Enum):
-            return BlockEnum(d)
-        if isinstance(d, Message):
-            return BlockMessage(d)
-        return None
 
+class BlockMessageMethodEqual(BlockMessageMethodHashEqualBase):
+    def render_value(
+        self, t: Type, v: str, o: str, indent: int, depth: int = 0
+    ) -> None:
+        """Renders statements returning false if values v and o in type t differ."""
+        if isinstance(t, Alias) and isinstance(t.type, Array):
+            return self.render_value(t.type, v, o, indent, depth)
+        if isinstance(t, Array) and t.bounded:
+            # The counts are compared, then the elements in use.
+            n = self.formatter.format_bounded_len(t, v)
+            self.push(
+                f"if {n} != {self.formatter.format_bounded_len(t, o)} {{",
+                indent=indent,
+            )
+            self.push("return false", indent=indent + 1)
+            self.push("}", indent=indent)
+            k = f"k{depth}"
+            self.push(f"for {k} := range {v}[:{n}] {{", indent=indent)
+            self.render_value(
+                t.element_type, f"{v}[{k}]", f"{o}[{k}]", indent + 1, depth + 1
+            )
+            self.push("}", indent=indent)
+            return
+        if self.is_exact(t):
+            self.push(f"if {v} != {o} {{", indent=indent)
+        elif isinstance(t, Message):
+            self.push(f"if !{v}.Equal(&{o}) {{", indent=indent)
+        elif isinstance(t, Array):
+            k = f"k{depth}"
+            self.push(f"for {k} := range {v} {{", indent=indent)
+            self.render_value(
+                t.element_type, f"{v}[{k}]", f"{o}[{k}]", indent + 1, depth + 1
+            )
+            self.push("}", indent=indent)
+            return
+        else:
+            self.push(f"if {self.word(t, v)} != {self.word(t, o)} {{", indent=indent)
+        self.push("return false", indent=indent + 1)
+        self.push("}", indent=indent)
 
-class BlockList(BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockAheadNotice(),
-            BlockPackageName(self.bound),
-            BlockGeneralImports(),
-            BlockImportChildProtoList(),
-            BlockAvoidGeneralImportsNotUsed(),
-            BlockBoundDefinitionList(),
-        ]
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Equal reports whether struct {self.message_name} encodes the same as o, "
+            "without encoding them."
+        )
+        self.push(
+            f"func (m *{self.message_name}) Equal(o *{self.message_name}) bool {{"
+        )
+        for field in self.d.sorted_fields():
+            name = self.formatter.format_message_field_name(field)
+            if is_zero_copy_bytes(self, field):
+                assert isinstance(field.type, Array)
+                cap = field.type.cap
+                v = f"bp.EqualByteSlice(m.{name}, o.{name}, {cap})"
+                self.push(f"if !{v} {{", indent=1)
+                self.push("return false", indent=2)
+                self.push("}", indent=1)
+            else:
+                self.render_value(field.type, f"m.{name}", f"o.{name}", indent=1)
+        self.push("return true", indent=1)
+        self.push("}")
 
 
-class BlockGeneralImportsOpMode(Block):
+class BlockGeneralFunctionsHash(Block[F]):
     @override(Block)
     def render(self) -> None:
-        self.push(f"import (")
-        self.push(f'"strconv"', indent=1)
-        self.push(f'"encoding/json"', indent=1)
-        self.push(f")")
-
+        self.push_comment("bpHashMix mixes the 64 bits word w into the hash h.")
+        self.push("func bpHashMix(h, w uint64) uint64 {")
+        self.push("h = (h ^ w) * 0x9e3779b97f4a7c15", indent=1)
+        self.push("return h ^ h>>32", indent=1)
+        self.push("}")
         self.push_empty_line()
-
-        self.push_comment("Avoid possible golang import not used error")
-        self.push(f"var formatInt = strconv.FormatInt")
-        self.push(f"var jsonMarshal = json.Marshal")
+        self.push_comment("bpHashBytes mixes the bytes s into the hash h, 8 at a time.")
+        self.push("func bpHashBytes(h uint64, s []byte) uint64 {")
+        self.push("for ; len(s) >= 8; s = s[8:] {", indent=1)
+        self.push(
+            "w := uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | "
+            "uint64(s[3])<<24 | uint64(s[4])<<32 | uint64(s[5])<<40 | "
+            "uint64(s[6])<<48 | uint64(s[7])<<56",
+            indent=2,
+        )
+        self.push("h = bpHashMix(h, w)", indent=2)
+        self.push("}", indent=1)
+        self.push("if len(s) > 0 {", indent=1)
+        self.push("var w uint64", indent=2)
+        self.push("for k, b := range s {", indent=2)
+        self.push("w |= uint64(b) << (8 * uint(k))", indent=3)
+        self.push("}", indent=2)
+        self.push("h = bpHashMix(h, w)", indent=2)
+        self.push("}", indent=1)
+        self.push("return h", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "bpFixedWord rounds the scaled fixed-point value r the same as the encoder."
+        )
+        self.push("func bpFixedWord(r float64) uint64 {")
+        self.push("if r >= 0 {", indent=1)
+        self.push("return uint64(r + 0.5)", indent=2)
+        self.push("} else if r < 0 {", indent=1)
+        self.push("return uint64(int64(r - 0.5))", indent=2)
+        self.push("}", indent=1)
+        self.push("return 0", indent=1)
+        self.push("}")
 
 
-class BlockEnumOpMode(BlockBindEnum[F], BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        return [
-            BlockEnumType(self.d),
-            BlockEnumFieldListWrapped(self.d),
-            BlockEnumMethodString(self.d),
-        ]
+class BlockMessageMethodReset(BlockBindMessage[F]):
+    """Method Reset zeroing a struct for reuse. The slices of bounded arrays keep
+    their backing arrays, so that decoding into a reused struct doesn't allocate."""
+
+    def render_field(self, t: Type, v: str, zero: str, indent: int, depth: int) -> None:
+        """Renders statements resetting value v in type t, to zero if it doesn't
+        contain bounded arrays."""
+        if isinstance(t, Alias):
+            return self.render_field(t.type, v, zero, indent, depth)
+        if not t.has_bounded_array():
+            self.push(f"{v} = {zero}", indent=indent)
+        elif isinstance(t, Message):
+            self.push(f"{v}.Reset()", indent=indent)
+        elif isinstance(t, Array) and t.bounded:
+            self.push(f"{v} = {v}[:0]", indent=indent)
+        elif isinstance(t, Array):
+            k = f"k{depth}"
+            self.push(f"for {k} := range {v} {{", indent=indent)
+            self.render_field(t.element_type, f"{v}[{k}]", "", indent + 1, depth + 1)
+            self.push("}", indent=indent)
 
-    @override(BlockComposition)
-    def separator(self) -> str:
-        return "\n\n"
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Reset sets struct {self.message_name} to its zero value, for it to be "
+            "reused, e.g. from a sync.Pool."
+        )
+        if self.d.has_bounded_array():
+            self.push_comment(
+                "The slices of bounded arrays are truncated, keeping their capacity."
+            )
+        self.push(f"func (m *{self.message_name}) Reset() {{")
+        if self.d.has_bounded_array():
+            for field in self.d.sorted_fields():
+                name = self.formatter.format_message_field_name(field)
+                zero = f"{self.message_name}{{}}.{name}"
+                self.render_field(field.type, f"m.{name}", zero, indent=1, depth=0)
+        else:
+            self.push(f"*m = {self.message_name}{{}}", indent=1)
+        self.push("}")
 
 
-class BlockMessageMethodEncodeOpMode(BlockBindMessage[F]):
+class BlockMessageMethodEncode(BlockBindMessage[F]):
     @override(Block)
     def render(self) -> None:
-        size = self.formatter.format_int_value(self.d.nbytes())
         self.push_comment(f"Encode struct {self.message_name} to bytes buffer.")
         self.push(f"func (m *{self.message_name}) Encode() []byte {{")
-        self.push(f"s := make([]byte, {size})", indent=1)
-        l = self.formatter.format_op_mode_encode_message(self.d)
-        for line in l:
+        for line in self.formatter.format_trace(self.d, True):
             self.push(line, indent=1)
-        self.push(f"return s", indent=1)
+        self.push("s := make([]byte, m.Size())", indent=1)
+        self.push("ctx := bp.AcquireProcessContext(true, s)", indent=1)
+        self.push(self.format_process(), indent=1)
+        if self.d.has_bounded_array():
+            # Bounded arrays take the bytes of the elements in use only.
+            self.push("s = s[:ctx.NumBytes()]", indent=1)
+        self.push("bp.ReleaseProcessContext(ctx)", indent=1)
+        self.push("return s", indent=1)
         self.push("}")
 
+    @overridable
+    def format_process(self) -> str:
+        var_name = self.formatter.format_processor_var_name(self.d)
+        return f"{var_name}.Process(ctx, nil, m)"
 
-class BlockMessageMethodDecodeOpMode(BlockBindMessage[F]):
+
+def push_decode_comment(block: BlockBindMessage[F]) -> None:
+    """Pushes the comment of a Decode method."""
+    block.push_comment(
+        f"Decode decodes struct {block.message_name} from given buffer s, every field "
+        "is overwritten."
+    )
+    block.push_comment(
+        "The struct is reset before decoding, so that it's safe to reuse, e.g. from "
+        "a sync.Pool."
+    )
+
+
+class BlockMessageMethodDecode(BlockBindMessage[F]):
     @override(Block)
     def render(self) -> None:
+        push_decode_comment(self)
         self.push(f"func (m *{self.message_name}) Decode(s []byte) {{")
-        l = self.formatter.format_op_mode_decode_message(self.d)
-        for line in l:
+        for line in self.formatter.format_trace(self.d, False):
             self.push(line, indent=1)
+        self.push("m.Reset()", indent=1)
+        self.push("ctx := bp.AcquireProcessContext(false, s)", indent=1)
+        self.push(self.format_process(), indent=1)
+        self.push("bp.ReleaseProcessContext(ctx)", indent=1)
         self.push("}")
 
+    @overridable
+    def format_process(self) -> str:
+        var_name = self.formatter.format_processor_var_name(self.d)
+        return f"{var_name}.Process(ctx, nil, m)"
 
-class BlockMessageOpMode(BlockBindMessage[F], BlockComposition[F]):
-    @override(BlockComposition)
-    def blocks(self) -> List[Block[F]]:
-        bs: List[Block[F]] = [
-            BlockMessageStruct(self.d),
-            BlockMessageSizeConst(self.d),
-            BlockMessageMethodSize(self.d),
-            BlockMessageMethodString(self.d),
-        ]
 
-        # Won't render encoder and decoder if not filtered
-        render_ctx = self._get_ctx_or_raise()
-        filter_messages = render_ctx.optimization_mode_filter_messages
-        if filter_messages:
-            if self.d.name not in filter_messages:
-                return bs
+class BlockMessageMethodDecodeMaskedBase(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        if not self.has_masked_decoder:
+            return
+        bits = "FIELD_MASK_" + upper_case(snake_case(self.message_name)) + "_*"
+        self.push_comment(
+            f"DecodeMasked decodes the fields of struct {self.message_name} selected "
+            f"by mask, an or of {bits}, from given buffer s."
+        )
+        self.push_comment(
+            "Others are skipped and left untouched, the fields selected are reset "
+            "before decoding."
+        )
+        self.push(f"func (m *{self.message_name}) DecodeMasked(s []byte, mask uint64) {{")
+        self.render_body()
+        self.push("}")
 
-        bs.extend(
-            [
-                BlockMessageMethodEncodeOpMode(self.d),
-                BlockMessageMethodDecodeOpMode(self.d),
-            ]
+    def format_field_reset(self, field: MessageField) -> str:
+        """Formats the statement resetting given field to its zero value, the
+        decoding statements or bits into it."""
+        name = self.formatter.format_message_field_name(field)
+        return f"m.{name} = {self.message_name}{{}}.{name}"
+
+    @abstractmethod
+    def render_body(self) -> None:
+        raise NotImplementedError
+
+
+class BlockMessageMethodDecodeMasked(BlockMessageMethodDecodeMaskedBase):
+    @override(BlockMessageMethodDecodeMaskedBase)
+    def render_body(self) -> None:
+        unsized = [
+            self.format_field_mask_constant_name(field)
+            for k, field in enumerate(self.d.sorted_fields())
+            if self.unsized_fields_mask & (1 << k)
+        ]
+        if unsized:
+            self.push_comment(
+                "Fields not in fixed size are decoded always, to know where the "
+                "next begins.",
+                indent=1,
+            )
+            self.push(f"mask |= {' | '.join(unsized)}", indent=1)
+        for field in self.d.sorted_fields():
+            mask = self.format_field_mask_constant_name(field)
+            self.push(f"if mask&{mask} != 0 {{", indent=1)
+            self.push(self.format_field_reset(field), indent=2)
+            self.push("}", indent=1)
+        var_name = self.formatter.format_processor_var_name(self.d)
+        self.push("ctx := bp.AcquireProcessContext(false, s)", indent=1)
+        self.push(f"{var_name}.DecodeMasked(ctx, m, mask)", indent=1)
+        self.push("bp.ReleaseProcessContext(ctx)", indent=1)
+
+
+class BlockMessageMethodEncodeToBase(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        size = self.formatter.format_int_value(self.d.nbytes())
+        self.push_comment(
+            f"EncodeTo encodes struct {self.message_name} into given buffer s, "
+            "without allocations."
         )
-        return bs
+        self.push_comment(
+            "It panics if s is shorter than Size() bytes, returns the number of "
+            "bytes written."
+        )
+        if self.d.has_bounded_array():
+            self.push_comment(
+                "Bounded arrays take the bytes of the elements in use only."
+            )
+        self.push(f"func (m *{self.message_name}) EncodeTo(s []byte) int {{")
+        self.render_body(size)
+        if self.d.has_bounded_array():
+            self.push("return n", indent=1)
+        else:
+            self.push(f"return {size}", indent=1)
+        self.push("}")
 
+    @abstractmethod
+    def render_body(self, size: str) -> None:
+        raise NotImplementedError
 
-class BlockBoundDefinitionListOpMode(BlockBoundDefinitionDispatcher[F]):
+
+class BlockMessageMethodEncodeTo(BlockMessageMethodEncodeToBase):
+    @override(BlockMessageMethodEncodeToBase)
+    def render_body(self, size: str) -> None:
+        for line in self.formatter.format_trace(self.d, True):
+            self.push(line, indent=1)
+        self.push(f"ctx := bp.AcquireProcessContext(true, s[:{size}])", indent=1)
+        self.push(self.format_process(), indent=1)
+        if self.d.has_bounded_array():
+            self.push("n := ctx.NumBytes()", indent=1)
+        self.push("bp.ReleaseProcessContext(ctx)", indent=1)
+
+    @overridable
+    def format_process(self) -> str:
+        var_name = self.formatter.format_processor_var_name(self.d)
+        return f"{var_name}.Process(ctx, nil, m)"
+
+
+class BlockMessageMethodDecodeFromBase(BlockBindMessage[F]):
+    error_name = "bp.ErrShortInput"
+
+    @override(Block)
+    def render(self) -> None:
+        size = self.formatter.format_int_value(self.d.nbytes())
+        self.push_comment(
+            f"DecodeFrom decodes struct {self.message_name} from given buffer s, "
+            "without allocations."
+        )
+        self.push_comment(
+            "The struct is reset before decoding, so that it's safe to reuse."
+        )
+        if self.d.has_bounded_array():
+            return self.render_bounded()
+        self.push_comment(
+            f"Returns {self.error_name} if s is shorter than Size() bytes."
+        )
+        self.push(f"func (m *{self.message_name}) DecodeFrom(s []byte) error {{")
+        self.push(f"if len(s) < {size} {{", indent=1)
+        self.push(f"return {self.error_name}", indent=2)
+        self.push("}", indent=1)
+        self.render_reset()
+        self.render_body()
+        self.push("return nil", indent=1)
+        self.push("}")
+
+    def render_bounded(self) -> None:
+        """Renders the method for messages with bounded arrays, of which the size
+        isn't known ahead, so a short s is detected on decoding."""
+        self.push_comment(
+            f"Returns {self.error_name} if s ends before the elements in use of "
+            "bounded arrays, or bp.ErrCount if a count exceeds the capacity."
+        )
+        self.push(
+            f"func (m *{self.message_name}) DecodeFrom(s []byte) (err error) {{"
+        )
+        self.render_reset()
+        self.push("defer bp.RecoverShortInput(&err)", indent=1)
+        self.render_body()
+        self.push("return err", indent=1)
+        self.push("}")
+
+    @overridable
+    def render_reset(self) -> None:
+        self.push("m.Reset()", indent=1)
+
+    @abstractmethod
+    def render_body(self) -> None:
+        raise NotImplementedError
+
+
+class BlockMessageMethodDecodeFrom(BlockMessageMethodDecodeFromBase):
+    @override(BlockMessageMethodDecodeFromBase)
+    def render_body(self) -> None:
+        for line in self.formatter.format_trace(self.d, False):
+            self.push(line, indent=1)
+        self.push("ctx := bp.AcquireProcessContext(false, s)", indent=1)
+        self.push(self.format_process(), indent=1)
+        if self.d.has_bounded_array():
+            self.push("err = ctx.Err()", indent=1)
+        self.push("bp.ReleaseProcessContext(ctx)", indent=1)
+
+    @overridable
+    def format_process(self) -> str:
+        var_name = self.formatter.format_processor_var_name(self.d)
+        return f"{var_name}.Process(ctx, nil, m)"
+
+
+class BlockMessageMethodsBinary(BlockBindMessage[F]):
+    """Methods appending to and marshaling into caller's buffers, on top of EncodeTo
+    and DecodeFrom, implementing encoding.BinaryAppender, encoding.BinaryMarshaler
+    and encoding.BinaryUnmarshaler."""
+
+    @override(Block)
+    def render(self) -> None:
+        size = self.formatter.format_int_value(self.d.nbytes())
+        m = f"(m *{self.message_name})"
+        self.push_comment(
+            f"AppendEncode appends the encoding of struct {self.message_name} to b, "
+            "and returns the extended buffer."
+        )
+        self.push_comment(
+            f"It doesn't allocate if b has a capacity of {size} bytes left."
+        )
+        self.push(f"func {m} AppendEncode(b []byte) []byte {{")
+        self.push("n := len(b)", indent=1)
+        self.push(f"if cap(b)-n < {size} {{", indent=1)
+        self.push(f"b = append(b, make([]byte, {size})...)", indent=2)
+        self.push("} else {", indent=1)
+        self.push(f"b = b[:n+{size}]", indent=2)
+        self.push("}", indent=1)
+        if self.d.has_bounded_array():
+            self.push("return b[:n+m.EncodeTo(b[n:])]", indent=1)
+        else:
+            self.push("m.EncodeTo(b[n:])", indent=1)
+            self.push("return b", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment("AppendBinary implements encoding.BinaryAppender.")
+        self.push(f"func {m} AppendBinary(b []byte) ([]byte, error) {{")
+        self.push("return m.AppendEncode(b), nil", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment("MarshalBinary implements encoding.BinaryMarshaler.")
+        self.push(f"func {m} MarshalBinary() ([]byte, error) {{")
+        self.push(f"return m.AppendEncode(make([]byte, 0, {size})), nil", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to "
+            "DecodeFrom."
+        )
+        self.push(f"func {m} UnmarshalBinary(s []byte) error {{")
+        self.push("return m.DecodeFrom(s)", indent=1)
+        self.push("}")
+
+
+class BlockMessageFieldAccessorBase(BlockBindMessage[F]):
+    """Base of the accessors of a single field in the encoded buffer of a message.
+
+    :param path: The list of fields to reach the field from the message.
+    :param t: The type of the field.
+    :param i: The index of the bit the field starts at in the encoded buffer.
+    """
+
+    def __init__(
+        self, *args: Any, path: List[MessageField], t: Type, i: int = 0, **kwds: Any
+    ) -> None:
+        super().__init__(*args, **kwds)
+        self.path = path
+        self.t = t
+        self.i = i
+
+    @cached_property
+    def field_path(self) -> str:
+        return ".".join(self.formatter.format_message_field_name(f) for f in self.path)
+
+    @cached_property
+    def accessor_name_suffix(self) -> str:
+        return self.message_name + "_" + self.field_path.replace(".", "_")
+
+    @cached_property
+    def field_type(self) -> str:
+        return self.formatter.format_type(self.t)
+
+
+class BlockMessageFieldGetter(BlockMessageFieldAccessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Get field {self.field_path} of struct {self.message_name} "
+            "from given encoded buffer s."
+        )
+        self.push(
+            f"func BpGet{self.accessor_name_suffix}(s []byte) (v {self.field_type}) {{"
+        )
+        for line in self.formatter.format_op_mode_getter(self.t, "v", self.i):
+            self.push(line, indent=1)
+        self.push("return", indent=1)
+        self.push("}")
+
+
+class BlockMessageFieldSetter(BlockMessageFieldAccessorBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Set field {self.field_path} of struct {self.message_name} "
+            "in given encoded buffer s in place."
+        )
+        self.push(
+            f"func BpSet{self.accessor_name_suffix}(s []byte, v {self.field_type}) {{"
+        )
+        for line in self.formatter.format_op_mode_setter(self.t, "v", self.i):
+            self.push(line, indent=1)
+        self.push("}")
+
+
+class BlockMessageFieldAccessorList(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        # Bit offsets of fields are known only in messages in fixed size.
+        if not self.d.is_fixed_size():
+            return []
+        b: List[Block[F]] = []
+        for path, t, i in self.formatter.op_mode_accessor_fields(self.d):
+            b.append(BlockMessageFieldGetter(self.d, path=path, t=t, i=i))
+            b.append(BlockMessageFieldSetter(self.d, path=path, t=t, i=i))
+        return b
+
+
+class BlockMessageSelfTest(BlockBindMessage[F]):
+    """Function BpSelfTestXXX with its test vectors, rendered with option self_test.
+    Every encoder and decoder method of the message is checked, whichever path it
+    takes, e.g. the bitproto library, go.generics and the statements of optimization
+    mode. Decoders decode into a struct holding another vector."""
+
+    @cached_property
+    def nvectors(self) -> int:
+        return self.formatter.self_test(self.d)
+
+    @cached_property
+    def function_name(self) -> str:
+        return f"BpSelfTest{self.message_name}"
+
+    @cached_property
+    def vectors(self) -> List[Vector]:
+        return message_vectors(self.d, self.nvectors)
+
+    def literal(self, t: Type, v: Any, typed: bool) -> str:
+        """Formats the literal of value v in type t of a test vector, composite
+        literals are typed if typed is set, else elided, as elements."""
+        if isinstance(t, Alias):
+            if not isinstance(t.type, (Array, Message)):
+                return self.literal(t.type, v, False)
+            elided = self.literal(t.type, v, False)
+            return f"{self.formatter.format_type(t)}{elided}" if typed else elided
+        if isinstance(t, Bool):
+            return self.formatter.format_bool_value(v)
+        if isinstance(t, (Float, Fixed)):
+            return self.formatter.format_real_value(v)
+        if isinstance(t, Array):
+            elements = ", ".join(self.literal(t.element_type, e, False) for e in v)
+            elided = f"{{{elements}}}"
+        elif isinstance(t, Message):
+            items = []
+            for field in t.sorted_fields():
+                name = self.formatter.format_message_field_name(field)
+                items.append(f"{name}: {self.field_literal(field, v[field.name])}")
+            elided = f"{{{', '.join(items)}}}"
+        else:
+            return self.formatter.format_int_value(v)
+        return f"{self.formatter.format_type(t)}{elided}" if typed else elided
+
+    def field_literal(self, field: MessageField, v: Any) -> str:
+        if is_zero_copy_bytes(self, field):
+            return f"[]byte{self.literal(field.type, v, False)}"
+        return self.literal(field.type, v, True)
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.nvectors:
+            return
+        n = self.formatter.format_int_value(self.nvectors)
+        structs = f"bpSelfTest{self.message_name}Structs"
+        buffers = f"bpSelfTest{self.message_name}Buffers"
+        if self._get_ctx_or_raise().optimization_mode:
+            err = "ErrSelfTest"
+        else:
+            err = "bp.ErrSelfTest"
+
+        self.push_comment(f"Test vectors of struct {self.message_name}.")
+        self.push(f"var {structs} = [{n}]{self.message_name}{{")
+        for vector in self.vectors:
+            self.push(f"{self.literal(self.d, vector.value, False)},", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push(f"var {buffers} = [{n}][]byte{{")
+        for vector in self.vectors:
+            self.push("{", indent=1)
+            for i in range(0, len(vector.buffer), 12):
+                line = ", ".join(f"0x{b:02x}" for b in vector.buffer[i : i + 12])
+                self.push(f"{line},", indent=2)
+            self.push("},", indent=1)
+        self.push("}")
+        self.push_empty_line()
+
+        self.push_comment(
+            f"{self.function_name} checks the encoders and decoders of struct "
+            f"{self.message_name} against {self.nvectors} test vectors computed by "
+            "the bitproto compiler,"
+        )
+        self.push_comment(
+            "e.g. on startup, before a build with aggressive optimizations is "
+            f"trusted. Returns {err} on the first mismatch."
+        )
+        self.push(f"func {self.function_name}() error {{")
+        self.push(f"s := make([]byte, {self.message_size_constant_name})", indent=1)
+        self.push(f"var m {self.message_name}", indent=1)
+        self.push(f"for k := range {structs} {{", indent=1)
+        self.push(f"v, t := &{structs}[k], {buffers}[k]", indent=2)
+        self.push(f"dirty := {buffers}[(k+1)%{n}]", indent=2)
+        self.push("for i := range s {", indent=2)
+        self.push("s[i] = 0xa5", indent=3)
+        self.push("}", indent=2)
+        checks = [
+            ("", "string(v.Encode()) != string(t)"),
+            ("", "string(s[:v.EncodeTo(s)]) != string(t)"),
+            ("", "string(v.AppendEncode(s[:0])) != string(t)"),
+            ("m.Decode(t)", "!m.Equal(v)"),
+            ("err := m.DecodeFrom(t)", "err != nil || !m.Equal(v)"),
+        ]
+        if self.has_masked_decoder:
+            checks.append(("m.DecodeMasked(t, ^uint64(0))", "!m.Equal(v)"))
+        for k, (statement, condition) in enumerate(checks):
+            if statement:
+                if k == 3:
+                    comment = "Decodes into a struct holding another vector."
+                    self.push_comment(comment, indent=2)
+                self.push("m.Decode(dirty)", indent=2)
+                self.push(statement, indent=2)
+            self.push(f"if {condition} {{", indent=2)
+            self.push(f"return {err}", indent=3)
+            self.push("}", indent=2)
+        self.push("}", indent=1)
+        self.push("return nil", indent=1)
+        self.push("}")
+
+
+class BlockMessageCodec(BlockBindMessage[F], BlockComposition[F]):
+    """Encoder and decoder methods going through the bitproto library."""
+
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockMessageMethodEncode(self.d),
+            BlockMessageMethodDecode(self.d),
+            BlockMessageMethodDecodeMasked(self.d),
+            BlockMessageMethodEncodeTo(self.d),
+            BlockMessageMethodDecodeFrom(self.d),
+            BlockMessageMethodsBinary(self.d),
+            BlockMessageSelfTest(self.d),
+        ]
+
+
+class BlockMessageCodecDirect(BlockBindMessage[F], BlockComposition[F]):
+    """Encoder and decoder methods working directly on struct fields, the same to
+    optimization mode's, rendered if option direct_codec is set. The processor
+    and accessor methods are still rendered, for the message to be nested in others
+    going through the bitproto library."""
+
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockMessageNormalizerOpMode(self.d),
+            BlockMessageMethodEncodeOpMode(self.d),
+            BlockMessageMethodEncodeToDirect(self.d),
+            BlockMessageMethodDecodeDirect(self.d),
+            BlockMessageMethodDecodeMaskedOpMode(self.d),
+            BlockMessageMethodDecodeFromDirect(self.d),
+            BlockMessageMethodsBinary(self.d),
+            BlockMessageSelfTest(self.d),
+        ]
+
+
+class BlockMessageMethodBpProcessFields(BlockBindMessage[F]):
+    """Processes the fields of a message in order by the generic functions of the
+    bitproto library on typed pointers to the fields, for option go.generics."""
+
+    def render_field(self, t: Type, v: str, indent: int, depth: int = 0) -> None:
+        """Renders statements processing value v in type t."""
+        if isinstance(t, Alias):
+            return self.render_field(t.type, v, indent, depth)
+        if isinstance(t, Bool):
+            self.push(f"bp.ProcessBool(ctx, &{v})", indent=indent)
+        elif isinstance(t, Range):
+            lo = self.formatter.format_range_lo(t)
+            self.push(f"bp.ProcessRange(ctx, &{v}, {t.nbits()}, {lo})", indent=indent)
+        elif isinstance(t, (Byte, Int, Uint, Enum)):
+            self.push(f"bp.ProcessInteger(ctx, &{v}, {t.nbits()})", indent=indent)
+        elif isinstance(t, Float):
+            self.push(f"bp.ProcessFloat32(ctx, &{v})", indent=indent)
+        elif isinstance(t, Fixed):
+            nbits = t.nbits()
+            signed = self.formatter.format_bool_value(t.signed)
+            scale = self.formatter.format_real_value(t.scale())
+            self.push(
+                f"bp.ProcessFixed(ctx, &{v}, {nbits}, {signed}, {scale})",
+                indent=indent,
+            )
+        elif isinstance(t, Message):
+            if t.bound.get_option_as_bool_or_raise("go.generics"):
+                self.push(f"{v}.BpProcessFields(ctx)", indent=indent)
+            else:  # Imported from a proto without go.generics.
+                self.push(f"{v}.BpProcessor().Process(ctx, nil, &{v})", indent=indent)
+        elif isinstance(t, Array) and t.bounded:
+            cap = self.formatter.format_int_value(t.cap)
+            count_nbits = self.formatter.format_int_value(t.count_nbits())
+            self.push("{", indent=indent)
+            self.push(
+                f"s := bp.ProcessBounded(ctx, &{v}, {cap}, {count_nbits})",
+                indent=indent + 1,
+            )
+            self.render_array(t, "s", indent + 1, depth)
+            self.push("}", indent=indent)
+        elif isinstance(t, Array):
+            if not t.extensible:
+                return self.render_array(t, v, indent, depth)
+            self.push("{", indent=indent)
+            self.push(
+                f"i, ahead := bp.BeginExtensible(ctx, {t.cap})", indent=indent + 1
+            )
+            self.render_array(t, v, indent + 1, depth)
+            self.push(f"bp.EndExtensible(ctx, i, ahead, {t.cap})", indent=indent + 1)
+            self.push("}", indent=indent)
+
+    def render_array(self, t: Array, v: str, indent: int, depth: int) -> None:
+        element = t.element_type
+        while isinstance(element, Alias):
+            element = element.type
+        if isinstance(element, Byte):
+            self.push(f"bp.ProcessBytes(ctx, {v}[:])", indent=indent)
+        elif isinstance(element, (Int, Uint, Enum)):
+            self.push(
+                f"bp.ProcessIntegers(ctx, {v}[:], {element.nbits()})", indent=indent
+            )
+        else:
+            k = f"k{depth}"
+            self.push(f"for {k} := range {v} {{", indent=indent)
+            self.render_field(element, f"{v}[{k}]", indent + 1, depth + 1)
+            self.push("}", indent=indent)
+
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"BpProcessFields encodes or decodes the fields of struct "
+            f"{self.message_name} at the current bit of ctx."
+        )
+        self.push(
+            f"func (m *{self.message_name}) BpProcessFields(ctx *bp.ProcessContext) {{"
+        )
+        if self.d.extensible:
+            nbits = self.formatter.format_int_value(self.d.nbits())
+            self.push(f"i, ahead := bp.BeginExtensible(ctx, {nbits})", indent=1)
+        for field in self.d.sorted_fields():
+            v = f"m.{self.formatter.format_message_field_name(field)}"
+            if is_zero_copy_bytes(self, field):
+                t = field.type
+                assert isinstance(t, Array)
+                if not t.extensible:
+                    self.push(f"bp.ProcessByteSlice(ctx, &{v}, {t.cap})", indent=1)
+                    continue
+                # The ahead flag first, the same as extensible arrays of bytes.
+                self.push("{", indent=1)
+                self.push(f"i, ahead := bp.BeginExtensible(ctx, {t.cap})", indent=2)
+                self.push(f"bp.ProcessByteSlice(ctx, &{v}, {t.cap})", indent=2)
+                self.push(f"bp.EndExtensible(ctx, i, ahead, {t.cap})", indent=2)
+                self.push("}", indent=1)
+            else:
+                self.render_field(field.type, v, indent=1)
+        if self.d.extensible:
+            self.push("bp.EndExtensible(ctx, i, ahead, 1)", indent=1)
+        self.push("}")
+
+
+class BlockMessageMethodEncodeGenerics(BlockMessageMethodEncode):
+    @override(BlockMessageMethodEncode)
+    def format_process(self) -> str:
+        return "m.BpProcessFields(ctx)"
+
+
+class BlockMessageMethodDecodeGenerics(BlockMessageMethodDecode):
+    @override(BlockMessageMethodDecode)
+    def format_process(self) -> str:
+        return "m.BpProcessFields(ctx)"
+
+
+class BlockMessageMethodEncodeToGenerics(BlockMessageMethodEncodeTo):
+    @override(BlockMessageMethodEncodeTo)
+    def format_process(self) -> str:
+        return "m.BpProcessFields(ctx)"
+
+
+class BlockMessageMethodDecodeFromGenerics(BlockMessageMethodDecodeFrom):
+    @override(BlockMessageMethodDecodeFrom)
+    def format_process(self) -> str:
+        return "m.BpProcessFields(ctx)"
+
+
+class BlockMessageCodecGenerics(BlockBindMessage[F], BlockComposition[F]):
+    """Encoder and decoder methods going through BpProcessFields, rendered if option
+    go.generics is set. The processor and accessor methods are still rendered, for
+    the message to be nested in others without the option."""
+
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockMessageMethodEncodeGenerics(self.d),
+            BlockMessageMethodDecodeGenerics(self.d),
+            BlockMessageMethodDecodeMasked(self.d),
+            BlockMessageMethodEncodeToGenerics(self.d),
+            BlockMessageMethodDecodeFromGenerics(self.d),
+            BlockMessageMethodsBinary(self.d),
+            BlockMessageSelfTest(self.d),
+            BlockMessageMethodBpProcessFields(self.d),
+        ]
+
+
+class BlockMessage(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        codec: Block[F] = BlockMessageCodec(self.d)
+        if self.formatter.is_direct_codec(self.d):
+            codec = BlockMessageCodecDirect(self.d)
+        elif self.bound.get_option_as_bool_or_raise("go.generics"):
+            codec = BlockMessageCodecGenerics(self.d)
+        return [
+            BlockMessageStruct(self.d),
+            BlockMessageSizeConst(self.d),
+            BlockMessageFieldMaskConsts(self.d),
+            BlockMessageMethodSize(self.d),
+            BlockMessageMethodString(self.d),
+            BlockMessageMethodAppendJSON(self.d),
+            BlockMessageMethodHash(self.d),
+            BlockMessageMethodEqual(self.d),
+            BlockMessageMethodReset(self.d),
+            codec,
+            BlockMessageMethodBpProcessor(self.d),
+            BlockMessageMethodBpGetAccessor(self.d),
+            BlockMessageMethodBpSetByte(self.d),
+            BlockMessageMethodBpGetByte(self.d),
+            BlockMessageMethodBpProcessInt(self.d),
+            BlockMessageMethodBpProcessArray(self.d),
+            BlockMessageMethodBpGetSetLen(self.d),
+            BlockMessageFieldAccessorList(self.d),
+        ]
+
+
+class BlockOneofBase(BlockBindOneof[F]):
+    def format_error_name(self, name: str) -> str:
+        """Returns the reference to given error, declared in the bitproto library, or
+        in the file itself in optimization mode."""
+        if self._get_ctx_or_raise().optimization_mode:
+            return name
+        return f"bp.{name}"
+
+    def format_variant_function_name(self, v: OneofVariant, is_encode: bool) -> str:
+        """Returns the name of the encoder (decoder) function of given variant."""
+        prefix = "bpEncode" if is_encode else "bpDecode"
+        return f"{prefix}{self.oneof_name}{pascal_case(v.name)}"
+
+    def format_table_name(self, is_encode: bool) -> str:
+        """Returns the name of the jump table of the encoders (decoders)."""
+        prefix = "bpEncode" if is_encode else "bpDecode"
+        return f"{prefix}{self.oneof_name}Table"
+
+
+class BlockOneofConsts(BlockOneofBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_comment(
+            f"Number of bytes to serialize struct {self.oneof_name} of the largest "
+            "variant"
+        )
+        self.push(
+            f"const {self.oneof_size_constant_name} uint32 = {self.oneof_nbytes}"
+        )
+        self.push_empty_line()
+        self.push_comment(f"Tags of the variants of struct {self.oneof_name}")
+        self.push("const (")
+        for v in self.d.sorted_variants():
+            name = self.format_variant_tag_constant_name(v)
+            self.push(f"{name} uint8 = {v.tag}", indent=1)
+        self.push(")")
+
+
+class BlockOneofStruct(BlockOneofBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push_definition_comments()
+        self.push(f"type {self.oneof_name} struct {{")
+        tags = f"TAG_{upper_case(snake_case(self.oneof_name))}_*"
+        self.push_comment(f"Tag of the active variant, one of {tags}", indent=1)
+        self.push('Tag uint8 `json:"tag"`', indent=1)
+        for v in self.d.sorted_variants():
+            for comment in v.comment_block:
+                self.push_comment(comment, indent=1)
+            name = self.format_variant_name(v)
+            variant_type = self.formatter.format_message_type(v.message)
+            self.push(f'{name} {variant_type} `json:"{snake_case(name)}"`', indent=1)
+            self.push_string(self.formatter.format_comment(f"{v.message.nbits()}bit"))
+        self.push("}")
+
+
+class BlockOneofVariantFunctions(BlockOneofBase):
+    def __init__(self, *args: Any, v: OneofVariant, **kwds: Any) -> None:
+        super().__init__(*args, **kwds)
+        self.v = v
+
+    def render_encoder(self) -> None:
+        name = self.format_variant_function_name(self.v, True)
+        nbytes = self.format_variant_nbytes(self.v)
+        self.push(f"func {name}(m *{self.oneof_name}, s []byte) int {{")
+        self.push(f"s = s[:{nbytes}]", indent=1)
+        self.push("for k := range s {", indent=1)
+        self.push("s[k] = 0", indent=2)
+        self.push("}", indent=1)
+        self.push(f"s[0] = {self.format_variant_tag_constant_name(self.v)}", indent=1)
+        for line in self.formatter.format_op_mode_endecode_oneof_variant(self.v, True):
+            self.push(line, indent=1)
+        self.push(f"return {nbytes}", indent=1)
+        self.push("}")
+
+    def render_decoder(self) -> None:
+        name = self.format_variant_function_name(self.v, False)
+        nbytes = self.format_variant_nbytes(self.v)
+        self.push(f"func {name}(m *{self.oneof_name}, s []byte) error {{")
+        self.push(f"if len(s) < {nbytes} {{", indent=1)
+        self.push(f"return {self.format_error_name('ErrShortInput')}", indent=2)
+        self.push("}", indent=1)
+        self.push(f"m.Tag = {self.format_variant_tag_constant_name(self.v)}", indent=1)
+        # The decoding statements or bits into the fields, which are reset first.
+        variant_name = self.format_variant_name(self.v)
+        variant_type = self.formatter.format_message_type(self.v.message)
+        self.push(f"m.{variant_name} = {variant_type}{{}}", indent=1)
+        for line in self.formatter.format_op_mode_endecode_oneof_variant(self.v, False):
+            self.push(line, indent=1)
+        self.push("return nil", indent=1)
+        self.push("}")
+
+    @override(Block)
+    def render(self) -> None:
+        self.render_encoder()
+        self.push_empty_line()
+        self.render_decoder()
+
+
+class BlockOneofJumpTables(BlockOneofBase):
+    """Jump tables of the encoders and decoders of the variants, indexed by the tag,
+    nil for the tags not declared."""
+
+    def render_table(self, is_encode: bool) -> None:
+        kind = "encoders" if is_encode else "decoders"
+        self.push_comment(
+            f"Jump table of the {kind} of the variants of struct {self.oneof_name}, "
+            "indexed by the tag."
+        )
+        name = self.format_table_name(is_encode)
+        size = self.oneof_tag_table_size
+        ret = "int" if is_encode else "error"
+        self.push(f"var {name} = [{size}]func(*{self.oneof_name}, []byte) {ret}{{")
+        for v in self.d.sorted_variants():
+            function_name = self.format_variant_function_name(v, is_encode)
+            self.push(f"{v.tag}: {function_name},", indent=1)
+        self.push("}")
+
+    @override(Block)
+    def render(self) -> None:
+        self.render_table(True)
+        self.push_empty_line()
+        self.render_table(False)
+
+
+class BlockOneofMethods(BlockOneofBase):
+    @override(Block)
+    def render(self) -> None:
+        err_unknown_tag = self.format_error_name("ErrUnknownTag")
+        err_short_input = self.format_error_name("ErrShortInput")
+        encoders = self.format_table_name(True)
+        decoders = self.format_table_name(False)
+
+        self.push_comment(
+            f"Encode struct {self.oneof_name} to bytes buffer, of the tag and the "
+            "active variant."
+        )
+        self.push_comment("Returns nil if the tag is unknown.")
+        self.push(f"func (m *{self.oneof_name}) Encode() []byte {{")
+        self.push(f"s := make([]byte, {self.oneof_nbytes})", indent=1)
+        self.push("n, err := m.EncodeTo(s)", indent=1)
+        self.push("if err != nil {", indent=1)
+        self.push("return nil", indent=2)
+        self.push("}", indent=1)
+        self.push("return s[:n]", indent=1)
+        self.push("}")
+        self.push_empty_line()
+
+        self.push_comment(
+            f"EncodeTo encodes struct {self.oneof_name} into given buffer s, the tag "
+            "followed by the active variant, without allocations."
+        )
+        self.push_comment(
+            "It panics if s is shorter than the bytes of them, returns the number of "
+            f"bytes written, or {err_unknown_tag} if the tag is unknown."
+        )
+        self.push(f"func (m *{self.oneof_name}) EncodeTo(s []byte) (int, error) {{")
+        self.push(
+            f"if int(m.Tag) >= len({encoders}) || {encoders}[m.Tag] == nil {{", indent=1
+        )
+        self.push(f"return 0, {err_unknown_tag}", indent=2)
+        self.push("}", indent=1)
+        self.push(f"return {encoders}[m.Tag](m, s), nil", indent=1)
+        self.push("}")
+        self.push_empty_line()
+
+        self.push_comment(
+            f"Decode decodes struct {self.oneof_name} from given buffer s, by the "
+            "decoder of the variant the tag selects."
+        )
+        self.push_comment(
+            "Only the variant decoded is reset, the others are left as they are."
+        )
+        self.push_comment(
+            f"Returns {err_unknown_tag} if the tag is unknown, {err_short_input} if s "
+            "is shorter than the bytes of the variant."
+        )
+        self.push(f"func (m *{self.oneof_name}) Decode(s []byte) error {{")
+        self.push("if len(s) < 1 {", indent=1)
+        self.push(f"return {err_short_input}", indent=2)
+        self.push("}", indent=1)
+        self.push(f"f := {decoders}[s[0]&{self.oneof_tag_mask}]", indent=1)
+        self.push("if f == nil {", indent=1)
+        self.push(f"return {err_unknown_tag}", indent=2)
+        self.push("}", indent=1)
+        self.push("return f(m, s)", indent=1)
+        self.push("}")
+
+
+class BlockOneof(BlockBindOneof[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = [
+            BlockOneofStruct(self.d),
+            BlockOneofConsts(self.d),
+        ]
+        for v in self.d.sorted_variants():
+            b.append(BlockOneofVariantFunctions(self.d, v=v))
+        b.append(BlockOneofJumpTables(self.d))
+        b.append(BlockOneofMethods(self.d))
+        return b
+
+
+class BlockBoundDefinitionList(BlockBoundDefinitionDispatcher[F]):
     @override(BlockBoundDefinitionDispatcher)
     def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
         if isinstance(d, Alias):
-            return BlockAliasDef(d)
+            return BlockAlias(d)
         if isinstance(d, Constant):
             return BlockConstant(d)
         if isinstance(d, Enum):
-            return BlockEnumOpMode(d)
+            return BlockEnum(d)
         if isinstance(d, Message):
-            return BlockMessageOpMode(d)
+            return BlockMessage(d)
+        if isinstance(d, Oneof):
+            return BlockOneof(d)
         return None
 
 
-class BlockGeneralFunctionBool2ByteOpMode(Block[F]):
+class BlockGeneralFunctionBool2Byte(Block[F]):
     @override(Block)
     def render(self) -> None:
         self.push("func bool2byte(b bool) byte {")
@@ -861,7 +2199,7 @@ class BlockGeneralFunctionBool2ByteOpMode(Block[F]):
         self.push("}")
 
 
-class BlockGeneralFunctionByte2boolOpMode(Block[F]):
+class BlockGeneralFunctionByte2bool(Block[F]):
     @override(Block)
     def render(self) -> None:
         self.push("func byte2bool(b byte) bool {")
@@ -872,6 +2210,338 @@ class BlockGeneralFunctionByte2boolOpMode(Block[F]):
         self.push("}")
 
 
+class BlockList(BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockBuildConstraint(),
+            BlockAheadNotice(),
+            BlockPackageName(self.bound),
+            BlockGeneralImports(),
+            BlockImportChildProtoList(),
+            BlockAvoidGeneralImportsNotUsed(),
+            BlockBoundDefinitionList(),
+            BlockGeneralFunctionBool2Byte(),
+            BlockGeneralFunctionByte2bool(),
+            BlockGeneralFunctionsHash(),
+            BlockHelperFunctionsDirect(),
+        ]
+
+
+class BlockGeneralImportsOpMode(Block):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"import (")
+        self.push(f'"errors"', indent=1)
+        self.push(f'"math"', indent=1)
+        self.push(f'"strconv"', indent=1)
+        self.push(f'"encoding/json"', indent=1)
+        self.push(f")")
+
+        self.push_empty_line()
+
+        self.push_comment("Avoid possible golang import not used error")
+        self.push(f"var formatInt = strconv.FormatInt")
+        self.push(f"var jsonMarshal = json.Marshal")
+        self.push(f"var float32bits = math.Float32bits")
+
+        self.push_empty_line()
+
+        self.push_comment(
+            "ErrShortInput is returned if the buffer to decode is shorter than the message."
+        )
+        self.push('var ErrShortInput = errors.New("bitproto: short input")')
+        if self.bound.oneofs(bound=self.bound):
+            self.push_empty_line()
+            self.push_comment(
+                "ErrUnknownTag is returned if the tag of a oneof selects no variant "
+                "declared."
+            )
+            self.push('var ErrUnknownTag = errors.New("bitproto: unknown tag")')
+        if self.bound.get_option_as_int_or_raise("self_test"):
+            self.push_empty_line()
+            self.push_comment(
+                "ErrSelfTest is returned by the BpSelfTestXXX functions if an encoder "
+                "or decoder disagrees with a test vector."
+            )
+            self.push('var ErrSelfTest = errors.New("bitproto: self test failed")')
+
+
+class BlockEnumOpMode(BlockBindEnum[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        return [
+            BlockEnumType(self.d),
+            BlockEnumFieldListWrapped(self.d),
+            BlockEnumMethodString(self.d),
+        ]
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n"
+
+
+class BlockMessageMethodEncodeOpMode(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        size = self.formatter.format_int_value(self.d.nbytes())
+        self.push_comment(f"Encode struct {self.message_name} to bytes buffer.")
+        self.push(f"func (m *{self.message_name}) Encode() []byte {{")
+        self.push(f"s := make([]byte, {size})", indent=1)
+        self.push("m.EncodeTo(s)", indent=1)
+        self.push(f"return s", indent=1)
+        self.push("}")
+
+
+class BlockMessageMethodEncodeToOpMode(BlockMessageMethodEncodeToBase):
+    @overridable
+    @override(BlockMessageMethodEncodeToBase)
+    def render_body(self, size: str) -> None:
+        self.push(f"s = s[:{size}]", indent=1)
+        self.push("for k := range s {", indent=1)
+        self.push("s[k] = 0", indent=2)
+        self.push("}", indent=1)
+        for line in self.formatter.format_op_mode_encode_message(self.d):
+            self.push(line, indent=1)
+
+
+class BlockMessageMethodDecodeFromOpMode(BlockMessageMethodDecodeFromBase):
+    error_name = "ErrShortInput"
+
+    @override(BlockMessageMethodDecodeFromBase)
+    def render_reset(self) -> None:
+        """Decode resets the struct itself."""
+
+    @override(BlockMessageMethodDecodeFromBase)
+    def render_body(self) -> None:
+        self.push("m.Decode(s)", indent=1)
+
+
+class BlockMessageNormalizerOpMode(BlockBindMessage[F]):
+    """Normalizer copies the bits of a message not in fixed size into the layout of
+    current version, for the decoder to decode with the bit offsets known at compile time.
+    """
+
+    @override(Block)
+    def render(self) -> None:
+        if self.d.is_fixed_size():
+            return
+        name = self.formatter.format_op_mode_normalizer_name(self.d)
+        self.push_comment(
+            f"{name} copies struct {self.message_name} encoded in buffer s into buffer t"
+        )
+        self.push_comment(
+            "in the layout of current version, returns the number of bits processed."
+        )
+        self.push(f"func {name}(t []byte, s []byte) int {{")
+        self.push("i := 0", indent=1)
+        for line in self.formatter.format_op_mode_normalizer(self.d):
+            self.push(line, indent=1)
+        self.push("return i", indent=1)
+        self.push("}")
+
+
+def push_op_mode_normalizing(block: BlockBindMessage[F]) -> None:
+    """Pushes the statements normalizing the buffer s to decode into the layout of
+    current version if it differs, for a message not in fixed size."""
+    d = block.d
+    if d.is_fixed_size():
+        return
+    name = block.formatter.format_op_mode_normalizer_name(d)
+    size = block.formatter.format_int_value(d.nbytes())
+    checks = block.formatter.format_op_mode_ahead_checks(d)
+    block.push(f"if !({checks[0]}", indent=1)
+    for check in checks[1:]:
+        block.push_string(" &&", separator="")
+        block.push(check, indent=2)
+    block.push_string(") {", separator="")
+    block.push(f"t := make([]byte, {size})", indent=2)
+    block.push(f"{name}(t, s)", indent=2)
+    block.push("s = t", indent=2)
+    block.push("}", indent=1)
+
+
+class BlockMessageMethodDecodeOpMode(BlockBindMessage[F]):
+    @override(Block)
+    def render(self) -> None:
+        push_decode_comment(self)
+        self.push(f"func (m *{self.message_name}) Decode(s []byte) {{")
+        self.render_trace()
+        self.push("m.Reset()", indent=1)
+        push_op_mode_normalizing(self)
+        l = self.formatter.format_op_mode_decode_message(self.d)
+        for line in l:
+            self.push(line, indent=1)
+        self.push("}")
+
+    @overridable
+    def render_trace(self) -> None:
+        """Optimization mode doesn't import the bitproto library to trace."""
+
+
+class BlockMessageMethodDecodeMaskedOpMode(BlockMessageMethodDecodeMaskedBase):
+    """Bit offsets of the fields are known at compile time, the statements of the
+    fields not selected are just jumped over."""
+
+    @override(BlockMessageMethodDecodeMaskedBase)
+    def render_body(self) -> None:
+        push_op_mode_normalizing(self)
+        fields = self.d.sorted_fields()
+        statements = self.formatter.format_op_mode_decode_message_fields(self.d)
+        for field, l in zip(fields, statements):
+            mask = self.format_field_mask_constant_name(field)
+            self.push(f"if mask&{mask} != 0 {{", indent=1)
+            self.push(self.format_field_reset(field), indent=2)
+            for line in l:
+                self.push(line, indent=2)
+            self.push("}", indent=1)
+
+
+class BlockMessageMethodEncodeToDirect(BlockMessageMethodEncodeToOpMode):
+    @override(BlockMessageMethodEncodeToOpMode)
+    def render_body(self, size: str) -> None:
+        for line in self.formatter.format_trace(self.d, True):
+            self.push(line, indent=1)
+        super().render_body(size)
+
+
+class BlockMessageMethodDecodeDirect(BlockMessageMethodDecodeOpMode):
+    @override(BlockMessageMethodDecodeOpMode)
+    def render_trace(self) -> None:
+        for line in self.formatter.format_trace(self.d, False):
+            self.push(line, indent=1)
+
+
+class BlockMessageMethodDecodeFromDirect(BlockMessageMethodDecodeFromOpMode):
+    error_name = BlockMessageMethodDecodeFromBase.error_name
+
+
+class BlockMessageOpMode(BlockBindMessage[F], BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        bs: List[Block[F]] = [
+            BlockMessageStruct(self.d),
+            BlockMessageSizeConst(self.d),
+            BlockMessageFieldMaskConsts(self.d),
+            BlockMessageMethodSize(self.d),
+            BlockMessageMethodString(self.d),
+            BlockMessageMethodAppendJSON(self.d),
+            BlockMessageMethodHash(self.d),
+            BlockMessageMethodEqual(self.d),
+            BlockMessageMethodReset(self.d),
+        ]
+
+        # Won't render encoder and decoder if not filtered
+        render_ctx = self._get_ctx_or_raise()
+        filter_messages = render_ctx.optimization_mode_filter_messages
+        if filter_messages:
+            if self.d.name not in filter_messages:
+                return bs
+
+        bs.extend(
+            [
+                BlockMessageNormalizerOpMode(self.d),
+                BlockMessageMethodEncodeOpMode(self.d),
+                BlockMessageMethodEncodeToOpMode(self.d),
+                BlockMessageMethodDecodeOpMode(self.d),
+                BlockMessageMethodDecodeMaskedOpMode(self.d),
+                BlockMessageMethodDecodeFromOpMode(self.d),
+                BlockMessageMethodsBinary(self.d),
+                BlockMessageSelfTest(self.d),
+                BlockMessageFieldAccessorList(self.d),
+            ]
+        )
+        return bs
+
+
+class BlockBoundDefinitionListOpMode(BlockBoundDefinitionDispatcher[F]):
+    @override(BlockBoundDefinitionDispatcher)
+    def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
+        if isinstance(d, Alias):
+            return BlockAliasDef(d)
+        if isinstance(d, Constant):
+            return BlockConstant(d)
+        if isinstance(d, Enum):
+            return BlockEnumOpMode(d)
+        if isinstance(d, Message):
+            return BlockMessageOpMode(d)
+        if isinstance(d, Oneof):
+            return BlockOneof(d)
+        return None
+
+
+class BlockHelperFunctionsOpMode(Block[F]):
+    """Helper functions to decode extensible types in optimization mode.
+    Rendered only if there are messages not in fixed size to render."""
+
+    @overridable
+    def is_op_mode_message(self, d: Message) -> bool:
+        filter_messages = self._get_ctx_or_raise().optimization_mode_filter_messages
+        return not filter_messages or d.name in filter_messages
+
+    def has_messages_not_fixed_size(self) -> bool:
+        for _, d in self.bound.filter(Message, recursive=True, bound=self.bound):
+            if self.is_op_mode_message(d) and not d.is_fixed_size():
+                return True
+        return False
+
+    @override(Block)
+    def render(self) -> None:
+        if not self.has_messages_not_fixed_size():
+            return
+        self.push_comment(
+            "bpOpCopyBits copies n bits from buffer s starting at bit i to buffer t"
+        )
+        self.push_comment(
+            "starting at bit p. Skips if the bits are out of the range of buffer s."
+        )
+        self.push("func bpOpCopyBits(t []byte, p int, s []byte, i int, n int) {")
+        self.push("if (i+n+7)>>3 > len(s) {", indent=1)
+        self.push("return", indent=2)
+        self.push("}", indent=1)
+        self.push("for n > 0 {", indent=1)
+        self.push("c := 8 - (p & 7)", indent=2)
+        self.push("if 8-(i&7) < c {", indent=2)
+        self.push("c = 8 - (i & 7)", indent=3)
+        self.push("}", indent=2)
+        self.push("if n < c {", indent=2)
+        self.push("c = n", indent=3)
+        self.push("}", indent=2)
+        self.push("mask := byte(((1 << uint(c)) - 1) << uint(p&7))", indent=2)
+        self.push("b := (s[i>>3] >> uint(i&7)) << uint(p&7)", indent=2)
+        self.push("t[p>>3] = (t[p>>3] &^ mask) | (b & mask)", indent=2)
+        self.push("p += c", indent=2)
+        self.push("i += c", indent=2)
+        self.push("n -= c", indent=2)
+        self.push("}", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "bpOpReadAhead reads the ahead flag of an extensible type at bit i of buffer s."
+        )
+        self.push("func bpOpReadAhead(s []byte, i int) uint16 {")
+        self.push("var b [2]byte", indent=1)
+        self.push("bpOpCopyBits(b[:], 0, s, i, 16)", indent=1)
+        self.push("return uint16(b[0]) | uint16(b[1])<<8", indent=1)
+        self.push("}")
+        self.push_empty_line()
+        self.push_comment(
+            "bpOpWriteAhead writes the ahead flag v of an extensible type at bit p of buffer t."
+        )
+        self.push("func bpOpWriteAhead(t []byte, p int, v uint16) {")
+        self.push("b := [2]byte{byte(v), byte(v >> 8)}", indent=1)
+        self.push("bpOpCopyBits(t, p, b[:], 0, 16)", indent=1)
+        self.push("}")
+
+
+class BlockHelperFunctionsDirect(BlockHelperFunctionsOpMode):
+    """Helper functions for the direct encoders and decoders in standard mode."""
+
+    @override(BlockHelperFunctionsOpMode)
+    def is_op_mode_message(self, d: Message) -> bool:
+        return self.formatter.is_direct_codec(d)
+
+
 class BlockListOpMode(BlockComposition[F]):
     @override(BlockComposition)
     def blocks(self) -> List[Block[F]]:
@@ -881,8 +2551,10 @@ class BlockListOpMode(BlockComposition[F]):
             BlockGeneralImportsOpMode(),
             BlockImportChildProtoList(),
             BlockBoundDefinitionListOpMode(),
-            BlockGeneralFunctionBool2ByteOpMode(),
-            BlockGeneralFunctionByte2boolOpMode(),
+            BlockGeneralFunctionBool2Byte(),
+            BlockGeneralFunctionByte2bool(),
+            BlockGeneralFunctionsHash(),
+            BlockHelperFunctionsOpMode(),
         ]
 
 
@@ -2,7 +2,7 @@
 Python formatter.
 """
 
-from typing import List, Optional
+from typing import Dict, List, Optional, Tuple
 
 from bitproto._ast import (
     Alias,
@@ -10,11 +10,17 @@ from bitproto._ast import (
     Bool,
     Byte,
     Constant,
+    Definition,
     Enum,
     EnumField,
+    Fixed,
+    Float,
     Int,
+    Integer,
     Message,
     Proto,
+    Range,
+    SingleType,
     Type,
     Uint,
 )
@@ -24,7 +30,14 @@ from bitproto.utils import final, override, upper_case
 
 
 class PyFormatter(Formatter):
-    """Formatter for Python language."""
+    """Formatter for Python language.
+
+    :param slots: Whether option py.slots is set on the proto rendering, that arrays
+       of integers are generated as array.array.
+    """
+
+    def __init__(self, slots: bool = False) -> None:
+        self.slots = slots
 
     @override(Formatter)
     def case_style_mapping(self) -> CaseStyleMapping:
@@ -83,21 +96,33 @@ class PyFormatter(Formatter):
     def format_int_type(self, t: Int) -> str:
         return "int"
 
+    @override(Formatter)
+    def format_float_type(self) -> str:
+        return "float"
+
+    @override(Formatter)
+    def format_fixed_type(self, t: Fixed) -> str:
+        return "float"
+
     @override(Formatter)
     def format_array_type(self, t: Array, name: Optional[str] = None) -> str:
         if isinstance(t.element_type, Byte):  # Array of byte is bytearray
             return "bytearray"
+        if self.int_array_element_type(t) is not None:
+            return "array"
         return "List[{type}]".format(type=self.format_type(t.element_type))
 
     @override(Formatter)
     def format_import_statement(self, t: Proto, as_name: Optional[str] = None) -> str:
-        module_name = (
-            t.get_option_as_string_or_raise("py.module_name") or f"{t.name}_bp"
-        )
+        module_name = self.format_module_name(t)
         if as_name:
             return f"import {module_name} as {as_name}"
         return f"import {module_name}"
 
+    def format_module_name(self, t: Proto) -> str:
+        """Formats the name of the module generated for given proto."""
+        return t.get_option_as_string_or_raise("py.module_name") or f"{t.name}_bp"
+
     @override(Formatter)
     def format_int_value_type(self) -> str:
         return "int"
@@ -115,6 +140,24 @@ class PyFormatter(Formatter):
         enum_name = self.format_enum_name(enum)
         return upper_case("_{0}_VALUE_TO_NAME_MAP".format(enum_name))
 
+    def int_array_element_type(self, t: Array) -> Optional[Integer]:
+        """Returns the integer element type of given array if the array is generated
+        as an array.array, with option py.slots, otherwise None."""
+        et = t.element_type
+        if isinstance(et, Alias):
+            et = et.type
+        if self.slots and isinstance(et, Integer):
+            return et
+        return None
+
+    def format_int_array_typecode(self, t: Integer) -> str:
+        """Returns the smallest array.array typecode to hold integers of type t."""
+        typecodes = "bhiq" if isinstance(t, Int) else "BHIQ"
+        for k, nbits in enumerate((8, 16, 32, 64)):
+            if t.nbits() <= nbits:
+                return typecodes[k]
+        raise InternalError("format_int_array_typecode got nbits out of range")
+
     def format_default_value_bool(self) -> str:
         return "False"
 
@@ -135,12 +178,36 @@ class PyFormatter(Formatter):
         return f"{self.format_type(t)}.{self.format_enum_field_name(t.fields()[0])}"
 
     def format_default_value_array(self, t: Array) -> str:
+        if t.bounded:  # Holds the elements in use only, none by default.
+            return self.format_default_value_bounded_array(t)
         cap = self.format_int_value(t.cap)
         if isinstance(t.element_type, Byte):
             return f"bytearray({cap})"
+        et = self.int_array_element_type(t)
+        if et is not None:
+            typecode = self.format_int_array_typecode(et)
+            return f'array("{typecode}", [0]) * {cap}'
         element_default_value = self.format_default_value(t.element_type)
         return f"[{element_default_value} for _ in range({cap})]"
 
+    def format_default_value_bounded_array(self, t: Array) -> str:
+        if isinstance(t.element_type, Byte):
+            return "bytearray()"
+        et = self.int_array_element_type(t)
+        if et is not None:
+            return f'array("{self.format_int_array_typecode(et)}")'
+        return "[]"
+
+    def format_bounded_array_value(self, t: Array, n: str) -> str:
+        """Formats the value of bounded array t holding n zero elements."""
+        if isinstance(t.element_type, Byte):
+            return f"bytearray({n})"
+        et = self.int_array_element_type(t)
+        if et is not None:
+            return f'array("{self.format_int_array_typecode(et)}", [0]) * {n}'
+        element_default_value = self.format_default_value(t.element_type)
+        return f"[{element_default_value} for _ in range({n})]"
+
     def format_default_value_alias(self, t: Alias) -> str:
         factory = self.formart_default_factory_alias(t)
         return f"{factory}()"
@@ -163,6 +230,10 @@ class PyFormatter(Formatter):
             return self.format_default_value_message(t)
         elif isinstance(t, Alias):
             return self.format_default_value_alias(t)
+        elif isinstance(t, Range):
+            return self.format_default_value(t.type)
+        elif isinstance(t, (Float, Fixed)):
+            return "0.0"
         raise InternalError(f"format_default_value got unexpected type {t}")
 
     def format_field_with_default_factory(self, default_factory: str) -> str:
@@ -210,6 +281,10 @@ class PyFormatter(Formatter):
             return self.format_field_default_message(t)
         elif isinstance(t, Alias):
             return self.format_field_default_alias(t)
+        elif isinstance(t, Range):
+            return self.format_field_default_value(t.type)
+        elif isinstance(t, (Float, Fixed)):
+            return "0.0"
         raise InternalError(f"format_field_default_value got unexpected type {t}")
 
     def format_processor(self, t: Type) -> str:
@@ -229,6 +304,12 @@ class PyFormatter(Formatter):
             return self.format_processor_alias(t)
         elif isinstance(t, Message):
             return self.format_processor_message(t)
+        elif isinstance(t, Range):
+            return self.format_processor_range(t)
+        elif isinstance(t, Float):
+            return "bp.Float32()"
+        elif isinstance(t, Fixed):
+            return f"bp.Fixed({self.format_int_value(t.nbits())})"
         raise InternalError("format_bp_type got unexpected t")
 
     def format_processor_bool(self) -> str:
@@ -242,10 +323,49 @@ class PyFormatter(Formatter):
         nbits = self.format_int_value(t.nbits())
         return f"bp.Uint({nbits})"
 
+    def format_processor_range(self, t: Range) -> str:
+        nbits = self.format_int_value(t.nbits())
+        return f"bp.Range({nbits})"
+
+    def format_range_offset(self, t: Range, chain: str) -> str:
+        """Formats the expression of the value of variable chain minus the lower bound
+        of given range, e.g. (self.altitude - 1000) and (self.temperature + 40)."""
+        if t.lo < 0:
+            return f"({chain} + {-t.lo})"
+        return f"({chain} - {t.lo})"
+
+    def format_range_value(self, t: Range, offset: str) -> str:
+        """Formats the expression of the value of given range from expression offset,
+        by adding the lower bound."""
+        if t.lo < 0:
+            return f"({offset}) - {-t.lo}"
+        return f"({offset}) + {t.lo}"
+
+    def format_real_value(self, value: float) -> str:
+        return repr(value)
+
+    def format_fixed_size_bits(self, t: Type, chain: str) -> str:
+        """Formats the expression of the bits on the wire of the value of variable
+        chain, of single type t, e.g. the offset of a range, and the bits of a float32
+        or fixed-point value. Bits higher than the type may be set."""
+        if isinstance(t, Range) and t.lo != 0:
+            return self.format_range_offset(t, chain)
+        if isinstance(t, Float):
+            return f"bp.float32_to_bits({chain})"
+        if isinstance(t, Fixed):
+            scale = self.format_real_value(t.scale())
+            return f"bp.fixed_to_bits({chain}, {scale})"
+        return chain
+
     def format_processor_byte(self) -> str:
         return f"bp.Byte()"
 
     def format_processor_array(self, t: Array) -> str:
+        if t.bounded:
+            capacity = self.format_int_value(t.cap)
+            count_nbits = self.format_int_value(t.count_nbits())
+            et = self.format_processor(t.element_type)
+            return f"bp.BoundedArray({capacity}, {count_nbits}, {et})"
         extensible = self.format_bool_value(t.extensible)
         capacity = self.format_int_value(t.cap)
         et = self.format_processor(t.element_type)
@@ -272,3 +392,404 @@ class PyFormatter(Formatter):
     def format_processor_message(self, t: Message) -> str:
         message_name = self.format_message_name(t)
         return f"{message_name}().bp_processor()"
+
+    def format_fixed_size_shift(self, value: str, i: int) -> str:
+        if i == 0:
+            return value
+        return f"({value} >> {i})"
+
+    def format_bigint_offset(self, base: Optional[str], i: int) -> str:
+        """Formats the bit offset i after the offset in variable base, if not None."""
+        if base is None:
+            return str(i)
+        if i == 0:
+            return base
+        return f"{base} + {i}"
+
+    def format_bigint_shift(self, value: str, base: Optional[str], i: int) -> str:
+        if base is None:
+            return self.format_fixed_size_shift(value, i)
+        return f"({value} >> ({self.format_bigint_offset(base, i)}))"
+
+    def format_bigint_or(self, r: str, base: Optional[str], i: int) -> str:
+        """Formats the statement to or the bits of expression r into the big integer v
+        at the ith bit after offset in variable base, if not None."""
+        if base is None:
+            return f"v |= {r} << {i}" if i else f"v |= {r}"
+        return f"v |= {r} << ({self.format_bigint_offset(base, i)})"
+
+    def format_bigint_mask(self, n: int) -> str:
+        """Formats the mask of n bits. Masks of large arrays are formatted as
+        expressions, Python refuses to convert integers of too many digits."""
+        if n > 4096:
+            return f"((1 << {n}) - 1)"
+        return str((1 << n) - 1)
+
+    def format_fixed_size_value(self, t: Type, r: str) -> str:
+        """Formats the value of single type t from expression r, the bits of the
+        value extracted from the big integer."""
+        if isinstance(t, Bool):
+            return f"bool({r})"
+        if isinstance(t, Int):
+            # Sign extension: (r ^ m) - m, where m is the sign bit.
+            m = 1 << (t.nbits() - 1)
+            return f"(({r}) ^ {m}) - {m}"
+        if isinstance(t, Range) and t.lo != 0:
+            return self.format_range_value(t, r)
+        if isinstance(t, Float):
+            return f"bp.float32_from_bits({r})"
+        if isinstance(t, Fixed):
+            signed = self.format_bool_value(t.signed)
+            unit = self.format_real_value(t.unit())
+            return f"bp.fixed_from_bits({r}, {t.nbits()}, {signed}, {unit})"
+        return r
+
+    def format_bigint_endecode(self, t: Type, chain: str, is_encode: bool) -> List[str]:
+        """Formats the statements to encode or decode the data referenced by chain,
+        of type t, at the start of the encoded buffer.
+
+        The whole buffer is taken as a big integer v in little endian, that the bits
+        are copied by shifts and masks on it, instead of byte by byte.
+
+        The bit offsets of all fields are known at compile time for fixed size types,
+        and on encoding types without bounded arrays. On decoding an extensible type,
+        the ahead flag decoded may differ from ours, the offsets after it are then
+        relative to variables tracking the bits skipped at runtime, the same way as the
+        library does. So are the offsets after a bounded array, of which the elements
+        in use are known at runtime only.
+        """
+        self.bigint_nvars = 0
+        l: List[str] = []
+        self.format_bigint_endecode_type(t, chain, None, 0, is_encode, l)
+        return l
+
+    def format_bigint_ahead(
+        self, base: Optional[str], i: int, l: List[str]
+    ) -> Tuple[str, str]:
+        """Formats the statements to decode an ahead flag at given offset, returns the
+        names of the variables holding the offset of the extensible type and the
+        ahead flag."""
+        self.bigint_nvars += 1
+        o, ahead = f"i{self.bigint_nvars}", f"ahead{self.bigint_nvars}"
+        l.append(f"{o} = {self.format_bigint_offset(base, i)}")
+        l.append(f"{ahead} = {self.format_bigint_shift('v', o, 0)} & 65535")
+        return o, ahead
+
+    def format_bigint_endecode_type(
+        self,
+        t: Type,
+        chain: str,
+        base: Optional[str],
+        i: int,
+        is_encode: bool,
+        l: List[str],
+    ) -> Tuple[Optional[str], int]:
+        """Appends the statements to encode or decode the data referenced by chain,
+        of type t, which starts at the ith bit after offset base of the encoded buffer,
+        to l. Returns the offset where it ends, in the same form.
+        """
+        if isinstance(t, Alias):
+            return self.format_bigint_endecode_type(
+                t.type, chain, base, i, is_encode, l
+            )
+
+        if isinstance(t, SingleType):
+            mask = (1 << t.nbits()) - 1
+            if is_encode:
+                chain = self.format_fixed_size_bits(t, chain)
+                if base is None and not i:
+                    l.append(f"v |= {chain} & {mask}")
+                else:
+                    l.append(self.format_bigint_or(f"({chain} & {mask})", base, i))
+            else:
+                r = f"{self.format_bigint_shift('v', base, i)} & {mask}"
+                l.append(f"{chain} = {self.format_fixed_size_value(t, r)}")
+            return base, i + t.nbits()
+
+        if not isinstance(t, (Message, Array)):
+            raise InternalError("format_bigint_endecode_type got unexpected type")
+
+        if isinstance(t, Array) and t.bounded:
+            return self.format_bigint_endecode_bounded_array(
+                t, chain, base, i, is_encode, l
+            )
+
+        o: Optional[str] = None
+        ahead = ""
+        if t.extensible:
+            if is_encode:
+                # Encode the message nbits, or the array capacity, as the ahead flag.
+                value = t.nbits() if isinstance(t, Message) else t.cap
+                l.append(self.format_bigint_or(str(value), base, i))
+            else:
+                o, ahead = self.format_bigint_ahead(base, i, l)
+                base, i = o, 0
+            i += t.ahead_nbits()
+
+        if isinstance(t, Message):
+            for field in t.sorted_fields():
+                chain_ = f"{chain}.{self.format_message_field_name(field)}"
+                base, i = self.format_bigint_endecode_type(
+                    field.type, chain_, base, i, is_encode, l
+                )
+        else:
+            base, i = self.format_bigint_endecode_array(t, chain, base, i, is_encode, l)
+
+        if o is not None:
+            # Skip redundant bits of the extensible type, if the ahead flag is larger.
+            skip = ahead if isinstance(t, Message) else f"{ahead} * {t.cap}"
+            l.append(f"{o} = max({o} + {skip}, {self.format_bigint_offset(base, i)})")
+            base, i = o, 0
+        return base, i
+
+    def format_bigint_endecode_array(
+        self,
+        t: Array,
+        chain: str,
+        base: Optional[str],
+        i: int,
+        is_encode: bool,
+        l: List[str],
+    ) -> Tuple[Optional[str], int]:
+        """Appends the statements to encode or decode the elements of array t, see
+        format_bigint_endecode_type."""
+        et = t.element_type
+        if isinstance(et, Alias) and isinstance(et.type, SingleType):
+            et = et.type
+
+        if not isinstance(et, SingleType):
+            for k in range(t.cap):
+                chain_ = f"{chain}[{k}]"
+                base, i = self.format_bigint_endecode_type(
+                    et, chain_, base, i, is_encode, l
+                )
+            return base, i
+
+        en = et.nbits()
+        n = t.cap * en
+        mask = self.format_bigint_mask(n)
+        v = self.format_bigint_shift("v", base, i)
+
+        if isinstance(et, Byte):
+            # Arrays of byte are bytearrays, copy them at once.
+            if is_encode:
+                r = f"(int.from_bytes({chain}, 'little') & {mask})"
+                l.append(self.format_bigint_or(r, base, i))
+            else:
+                l.append(f"{chain}[:] = ({v} & {mask}).to_bytes({t.cap}, 'little')")
+            return base, i + n
+
+        emask = (1 << en) - 1
+        if is_encode:
+            x = self.format_fixed_size_bits(et, "x")
+            r = f"sum(({x} & {emask}) << ({en} * k) for k, x in enumerate({chain}[:{t.cap}]))"
+            l.append(self.format_bigint_or(r, base, i))
+            return base, i + n
+
+        r = self.format_fixed_size_value(et, f"(w >> ({en} * k)) & {emask}")
+        l.append(f"w = {v} & {mask}")
+        if self.slots:
+            # Sets elements in place, array.array takes no list on slicing.
+            l.append(f"for k in range({t.cap}):")
+            l.append(f"    {chain}[k] = {r}")
+        else:
+            l.append(f"{chain}[:] = [{r} for k in range({t.cap})]")
+        return base, i + n
+
+    def format_bigint_endecode_bounded_array(
+        self,
+        t: Array,
+        chain: str,
+        base: Optional[str],
+        i: int,
+        is_encode: bool,
+        l: List[str],
+    ) -> Tuple[Optional[str], int]:
+        """Appends the statements to encode or decode bounded array t, the count and
+        then the elements in use, see format_bigint_endecode_type. Returns the offset
+        where it ends, relative to a new variable tracking it at runtime."""
+        self.bigint_nvars += 1
+        o, n = f"i{self.bigint_nvars}", f"n{self.bigint_nvars}"
+        if is_encode:
+            l.append(f"{n} = min(len({chain}), {t.cap})")
+            l.append(self.format_bigint_or(n, base, i))
+        else:
+            mask = (1 << t.count_nbits()) - 1
+            l.append(f"{n} = {self.format_bigint_shift('v', base, i)} & {mask}")
+            if t.cap < mask:
+                l.append(f"if {n} > {t.cap}:")
+                l.append("    raise bp.CountExceedsCapacity()")
+        l.append(f"{o} = {self.format_bigint_offset(base, i + t.count_nbits())}")
+
+        et = t.element_type
+        if isinstance(et, Alias) and isinstance(et.type, SingleType):
+            et = et.type
+
+        if not isinstance(et, SingleType):
+            if not is_encode:
+                l.append(f"{chain}[:] = {self.format_bounded_array_value(t, n)}")
+            k = f"k{self.bigint_nvars}"
+            body: List[str] = []
+            base_, i_ = self.format_bigint_endecode_type(
+                et, f"{chain}[{k}]", o, 0, is_encode, body
+            )
+            l.append(f"for {k} in range({n}):")
+            l.extend(f"    {line}" for line in body)
+            l.append(f"    {o} = {self.format_bigint_offset(base_, i_)}")
+            return o, 0
+
+        en = et.nbits()
+        mask_s = f"((1 << ({en} * {n})) - 1)"
+        if isinstance(et, Byte):
+            if is_encode:
+                r = f"int.from_bytes({chain}[:{n}], 'little')"
+                l.append(self.format_bigint_or(r, o, 0))
+            else:
+                r = f"((v >> {o}) & {mask_s}).to_bytes({n}, 'little')"
+                l.append(f"{chain}[:] = {r}")
+        elif is_encode:
+            emask = (1 << en) - 1
+            x = self.format_fixed_size_bits(et, "x")
+            xs = f"enumerate({chain}[:{n}])"
+            r = f"sum(({x} & {emask}) << ({en} * k) for k, x in {xs})"
+            l.append(self.format_bigint_or(f"({r})", o, 0))
+        else:
+            emask = (1 << en) - 1
+            r = self.format_fixed_size_value(et, f"(w >> ({en} * k)) & {emask}")
+            l.append(f"w = (v >> {o}) & {mask_s}")
+            values = f"[{r} for k in range({n})]"
+            it = self.int_array_element_type(t)
+            if it is not None:  # Slicing an array.array takes no list.
+                values = f'array("{self.format_int_array_typecode(it)}", {values})'
+            l.append(f"{chain}[:] = {values}")
+        l.append(f"{o} += {en} * {n}")
+        return o, 0
+
+    def format_bigint_nbits(self, t: Type, chain: str) -> str:
+        """Formats the expression of the number of bits the data referenced by chain,
+        of type t, is encoded in, for types with bounded arrays, of which only the
+        elements in use take bits."""
+        if not t.has_bounded_array():
+            return str(t.nbits())
+        if isinstance(t, Message):
+            terms = [
+                self.format_bigint_nbits(
+                    field.type, f"{chain}.{self.format_message_field_name(field)}"
+                )
+                for field in t.sorted_fields()
+            ]
+            n = sum(int(term) for term in terms if term.isdigit())
+            terms = [term for term in terms if not term.isdigit()]
+            return " + ".join(([str(n)] if n else []) + terms)
+        assert isinstance(t, Array)
+        if t.bounded and not t.element_type.has_bounded_array():
+            en = t.element_type.nbits()
+            return f"({t.count_nbits()} + {en} * min(len({chain}), {t.cap}))"
+        x = self.format_bigint_nbits(t.element_type, "x")
+        s = f"sum({x} for x in {chain}[:{t.cap}])"
+        return f"({t.count_nbits()} + {s})" if t.bounded else s
+
+    def format_fixed_size_columns(self, t: Type, name: str, i: int) -> List[str]:
+        """Formats the columns of the data named name, of fixed size type t, which
+        starts at the ith bit of the encoded buffer, for bp.decode_columns.
+        Messages and arrays are walked recursively to the single types inside, named
+        like "flight.pose.yaw" and "propellers[0].id".
+        """
+        if isinstance(t, Alias):
+            return self.format_fixed_size_columns(t.type, name, i)
+
+        if isinstance(t, SingleType):
+            kind = "uint"
+            if isinstance(t, Bool):
+                kind = "bool"
+            elif isinstance(t, Int):
+                kind = "int"
+            return [f'("{name}", {i}, {t.nbits()}, "{kind}"),']
+
+        l: List[str] = []
+
+        if isinstance(t, Message):
+            for field in t.sorted_fields():
+                field_name = self.format_message_field_name(field)
+                name_ = f"{name}.{field_name}" if name else field_name
+                l.extend(self.format_fixed_size_columns(field.type, name_, i))
+                i += field.type.nbits()
+            return l
+
+        if isinstance(t, Array):
+            for k in range(t.cap):
+                l.extend(self.format_fixed_size_columns(t.element_type, f"{name}[{k}]", i))
+                i += t.element_type.nbits()
+            return l
+
+        raise InternalError("format_fixed_size_columns got unexpected type")
+
+    def format_view_name(self, t: Message) -> str:
+        """Formats the name of the view class of given message, e.g. DroneView."""
+        return self.format_name_related_to_definition(t, "{definition_name}View")
+
+    def format_view_type(self, t: Type) -> str:
+        """Formats the type of the values the view of type t returns."""
+        if isinstance(t, Alias):
+            return self.format_view_type(t.type)
+        if isinstance(t, Message):
+            return f'"{self.format_view_name(t)}"'
+        if isinstance(t, Array):
+            if isinstance(t.element_type, Byte):
+                return "bytes"
+            return f"List[{self.format_view_type(t.element_type)}]"
+        return self.format_type(t)
+
+    def format_view_value(self, t: Type, i: str, depth: int = 0) -> str:
+        """Formats the expression extracting the value of fixed size type t, which
+        starts at the bit offset expression i of the message view, from the encoded
+        buffer. Views of nested messages are returned for messages.
+        """
+        if isinstance(t, Alias):
+            return self.format_view_value(t.type, i, depth)
+        if isinstance(t, Bool):
+            return f"self.bp_uint({i}, 1) != 0"
+        if isinstance(t, Int):
+            return f"self.bp_int({i}, {t.nbits()})"
+        if isinstance(t, (Range, Float, Fixed)):
+            return self.format_fixed_size_value(t, f"self.bp_uint({i}, {t.nbits()})")
+        if isinstance(t, (Uint, Byte)):
+            return f"self.bp_uint({i}, {t.nbits()})"
+        if isinstance(t, Enum):
+            return f"{self.format_type(t)}(self.bp_uint({i}, {t.nbits()}))"
+        if isinstance(t, Message):
+            return f"{self.format_view_name(t)}.bp_at(self.bp_s, self.bp_i + {i})"
+        if isinstance(t, Array):
+            if isinstance(t.element_type, Byte):
+                return f"self.bp_bytes({i}, {t.cap})"
+            k = f"k{depth}"
+            element_i = f"{i} + {t.element_type.nbits()} * {k}"
+            element = self.format_view_value(t.element_type, element_i, depth + 1)
+            return f"[{element} for {k} in range({t.cap})]"
+        raise InternalError("format_view_value got unexpected type")
+
+    def json_bytes_fields(self, m: Message) -> Dict[str, str]:
+        """Returns the json formats of byte arrays in given message by field name, see
+        option json_bytes. Fields of nested messages with such byte arrays inside
+        are included with an empty format, to format them recursively.
+        """
+        formats: Dict[str, str] = {}
+        for field in m.sorted_fields():
+            t: Type = field.type
+            d: Definition = field
+            while isinstance(t, Alias):
+                t, d = t.type, t
+            json_bytes = ""
+            if isinstance(t, Array):
+                json_bytes = self.json_bytes(t, d)
+                element = t.element_type
+                while isinstance(element, Alias):
+                    element, d = element.type, element
+                if json_bytes == "array" and isinstance(element, Array):
+                    json_bytes = self.json_bytes(element, d)
+                t = element
+            if json_bytes in ("hex", "base64"):
+                formats[self.format_message_field_name(field)] = json_bytes
+            elif isinstance(t, Message) and self.json_bytes_fields(t):
+                formats[self.format_message_field_name(field)] = ""
+        return formats
@@ -12,10 +12,14 @@ from bitproto._ast import (
     BoundDefinition,
     Constant,
     Enum,
+    Fixed,
+    Float,
     Int,
     Message,
+    Range,
     SingleType,
 )
+from bitproto.layout import has_ranges, has_reals
 from bitproto.renderer.block import (
     Block,
     BlockAheadNotice,
@@ -47,8 +51,10 @@ class BlockGeneralImports(Block[F]):
     @override(Block)
     def render(self) -> None:
         self.push("import json")
+        if self.bound.get_option_as_bool_or_raise("py.slots"):
+            self.push("from array import array")
         self.push("from dataclasses import dataclass, field")
-        self.push("from typing import ClassVar, Dict, List, Union")
+        self.push("from typing import Any, ClassVar, Dict, List, Optional, Union")
         self.push("from enum import IntEnum, unique")
         self.push_empty_line()
         self.push("from bitprotolib import bp")
@@ -295,6 +301,11 @@ class BlockMessageBase(BlockBindMessage[F]):
     def message_size_constant_name(self) -> str:
         return "BYTES_LENGTH"
 
+    @override(BlockBindMessage)
+    @cached_property
+    def message_fingerprint_constant_name(self) -> str:
+        return "FINGERPRINT"
+
 
 class BlockMessageSize(BlockMessageBase):
     @override(Block)
@@ -303,6 +314,19 @@ class BlockMessageSize(BlockMessageBase):
         self.push(
             f"{self.message_size_constant_name}: ClassVar[int] = {self.message_nbytes}"
         )
+        self.push_comment(
+            f"Layout fingerprint of class {self.message_name}, to check compatibility"
+        )
+        self.push(
+            f"{self.message_fingerprint_constant_name}: ClassVar[int] = {self.message_fingerprint}"
+        )
+        json_bytes = self.formatter.json_bytes_fields(self.d)
+        if json_bytes:
+            self.push_comment(
+                f"Json formats of byte arrays of class {self.message_name} by field, "
+                "see option json_bytes"
+            )
+            self.push(f"JSON_BYTES: ClassVar[Dict[str, str]] = {json_bytes!r}")
 
 
 class BlockMessageFieldList(BlockMessageBase, BlockComposition[F]):
@@ -338,6 +362,8 @@ class BlockMessageClass(BlockMessageBase, BlockWrapper[F]):
 
     @override(BlockWrapper)
     def before(self) -> None:
+        if self.bound.get_option_as_bool_or_raise("py.slots"):
+            self.push("@bp.slots")
         self.push("@dataclass")
         self.push(f"class {self.message_name}(bp.MessageBase):")
         self.push_definition_docstring(indent=4)
@@ -569,6 +595,12 @@ class BlockMessageMethodSetByteItem(BlockMessageMethodGetSetByteItemBase):
 
         right = value = f"{type_name}(b)"
 
+        if isinstance(single, (Float, Fixed)):
+            # Collects the bits in place of the value, see bp_process_int.
+            assign = "="
+            right = f"int({left}) | (int(b) << lshift)"
+            shift = ""
+
         if shift:
             right = f"({value} {shift})"
 
@@ -621,6 +653,8 @@ class BlockMessageMethodGetByteItem(BlockMessageMethodGetSetByteItemBase):
 
         if isinstance(single, Bool):
             value = f"int({data})"
+        if isinstance(single, (Range, Float, Fixed)):
+            value = self.formatter.format_fixed_size_bits(single, data)
 
         self.render_case()
         self.push(f"return ({value} {shift}) & 255", indent=self.indent + 4)
@@ -660,8 +694,12 @@ class BlockMessageMethodGetByte(BlockMessageBase, BlockWrapper[F]):
 class BlockMessageMethodProcessIntItem(BlockMessageMethodGetSetByteItemBase):
     @override(BlockMessageMethodGetSetByteItemBase)
     def render_single(self, single: SingleType) -> None:
+        if isinstance(single, Range):
+            return self.render_range(single)
+        if isinstance(single, (Float, Fixed)):
+            return self.render_real(single)
         if not isinstance(single, Int):
-            # Cares only about signed integer.
+            # Cares only about signed integer, range, and reals.
             return
 
         n = single.nbits()
@@ -680,6 +718,24 @@ class BlockMessageMethodProcessIntItem(BlockMessageMethodGetSetByteItemBase):
         self.push(f"{name} |= {mask}", indent=self.indent + 4 + 4)
         self.push("return", indent=self.indent + 4)
 
+    def render_real(self, single: SingleType) -> None:
+        # Converts the bits decoded to the value.
+        name = self.format_data_ref()
+        self.render_case()
+        value = self.formatter.format_fixed_size_value(single, name)
+        self.push(f"{name} = {value}", indent=self.indent + 4)
+        self.push("return", indent=self.indent + 4)
+
+    def render_range(self, single: Range) -> None:
+        # Adds the lower bound back to the offset decoded.
+        if single.lo == 0:
+            return
+        name = self.format_data_ref()
+        self.render_case()
+        value = self.formatter.format_range_value(single, name)
+        self.push(f"{name} = {value}", indent=self.indent + 4)
+        self.push("return", indent=self.indent + 4)
+
 
 class BlockMessageMethodProcessIntDefaultItem(Block[F]):
     @override(Block)
@@ -789,36 +845,221 @@ class BlockMessageMethodGetAccessor(BlockMessageBase, BlockWrapper[F]):
         self.push(f"def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:")
 
 
+class BlockMessageMethodGetSetLen(BlockMessageBase):
+    """Methods bp_get_len and bp_set_len for the processor of bounded arrays, rendered
+    only for messages with bounded array fields."""
+
+    @override(Block)
+    def render(self) -> None:
+        fields = [
+            field
+            for field in self.d.sorted_fields()
+            if isinstance(field.type, Array) and field.type.bounded
+        ]
+        if not fields:
+            return
+        self.push("def bp_get_len(self, di: bp.DataIndexer) -> int:")
+        for field in fields:
+            name = self.formatter.format_message_field_name(field)
+            self.push(f"if di.field_number == {field.number}:", indent=self.indent + 4)
+            self.push(f"return len(self.{name})", indent=self.indent + 8)
+        self.push("return 0", indent=self.indent + 4)
+        self.push_empty_line()
+        self.push("def bp_set_len(self, di: bp.DataIndexer, n: int) -> None:")
+        for field in fields:
+            assert isinstance(field.type, Array)
+            name = self.formatter.format_message_field_name(field)
+            value = self.formatter.format_bounded_array_value(field.type, "n")
+            self.push(f"if di.field_number == {field.number}:", indent=self.indent + 4)
+            self.push(f"self.{name}[:] = {value}", indent=self.indent + 8)
+
+
+class BlockMessageMethodNbits(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        """The number of bits encoded varies with the elements in use of bounded
+        arrays, rendered only for messages with them."""
+        if not self.d.has_bounded_array():
+            return
+        self.push("def bp_nbits(self) -> int:")
+        self.push_docstring(
+            "Returns the number of bits this object is encoded in, bounded arrays take",
+            "the bits of the elements in use only.",
+            indent=self.indent + 4,
+        )
+        nbits = self.formatter.format_bigint_nbits(self.d, "self")
+        self.push(f"return {nbits}", indent=self.indent + 4)
+
+
+class BlockMessageMethodEncodeBigint(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        """Encodes fields into a big integer, since the bit offsets of all fields are
+        known on encoding."""
+        self.push(f"def bp_encode_bigint(self) -> int:")
+        self.push_docstring(
+            "Encode this object to a big integer in little endian.",
+            indent=self.indent + 4,
+        )
+        self.push("v = 0", indent=self.indent + 4)
+        for line in self.formatter.format_bigint_endecode(self.d, "self", True):
+            self.push(line, indent=self.indent + 4)
+        self.push("return v", indent=self.indent + 4)
+
+
+class BlockMessageMethodDecodeBigint(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        """Extracts fields from the big integer converted from the bytes at once."""
+        self.push(f"def bp_decode_bigint(self, v: int) -> None:")
+        self.push_docstring(
+            "Decode given big integer v in little endian to this object.",
+            indent=self.indent + 4,
+        )
+        for line in self.formatter.format_bigint_endecode(self.d, "self", False):
+            self.push(line, indent=self.indent + 4)
+
+
+def push_bounded_nbytes(b: BlockMessageBase) -> str:
+    """Pushes the statement computing the number of bytes the message is encoded in,
+    if it has bounded arrays, returns the expression of it."""
+    if not b.d.has_bounded_array():
+        return "self.BYTES_LENGTH"
+    b.push("n = (self.bp_nbits() + 7) >> 3", indent=b.indent + 4)
+    return "n"
+
+
 class BlockMessageMethodEncode(BlockMessageBase):
     @override(Block)
     def render(self) -> None:
         self.push(f"def encode(self) -> bytearray:")
         self.push_docstring("Encode this object to bytearray.", indent=self.indent + 4)
-        self.push(f"s = bytearray(self.BYTES_LENGTH)", indent=self.indent + 4)
-        self.push(f"ctx = bp.ProcessContext(True, s)", indent=self.indent + 4)
+        n = push_bounded_nbytes(self)
         self.push(
-            f"self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)",
+            f"return bytearray(self.bp_encode_bigint().to_bytes({n}, 'little'))",
             indent=self.indent + 4,
         )
-        self.push(f"return ctx.s", indent=self.indent + 4)
+
+
+class BlockMessageMethodEncodeInto(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(
+            f"def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:"
+        )
+        self.push_docstring(
+            "Encode this object into given buffer buf at offset, without allocating a bytearray.",
+            ":param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least",
+            "   `BYTES_LENGTH` bytes after offset.",
+            "Returns the number of bytes written, that's `BYTES_LENGTH`"
+            + (", or less for bounded arrays." if self.d.has_bounded_array() else "."),
+            indent=self.indent + 4,
+        )
+        n = push_bounded_nbytes(self)
+        self.push(
+            f"assert len(buf) - offset >= {n}, bp.NotEnoughBytes()",
+            indent=self.indent + 4,
+        )
+        self.push(
+            f"buf[offset : offset + {n}] = self.bp_encode_bigint().to_bytes({n}, 'little')",
+            indent=self.indent + 4,
+        )
+        self.push(f"return {n}", indent=self.indent + 4)
 
 
 class BlockMessageMethodDecode(BlockMessageBase):
     @override(Block)
     def render(self) -> None:
+        """Converts the bytes into a big integer at once and extracts fields from it.
+        An extensible message may span more bytes than ours, if the ahead flags
+        decoded are larger, the whole buffer is converted then."""
         self.push(f"def decode(self, s: bytearray) -> None:")
         self.push_docstring(
             "Decode given bytearray s to this object.",
             ":param s: A bytearray with length at least `BYTES_LENGTH`.",
             indent=self.indent + 4,
         )
+        if self.d.has_bounded_array():
+            # The length is known after the counts are decoded.
+            self.push("self.bp_decode_bigint(int.from_bytes(s, 'little'))", indent=self.indent + 4)
+            self.push(
+                "assert len(s) >= (self.bp_nbits() + 7) >> 3, bp.NotEnoughBytes()",
+                indent=self.indent + 4,
+            )
+            return
         self.push(
             f"assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()",
             indent=self.indent + 4,
         )
-        self.push(f"ctx = bp.ProcessContext(False, s)", indent=self.indent + 4)
+        r = "s[: self.BYTES_LENGTH]" if self.d.is_fixed_size() else "s"
+        self.push(
+            f"self.bp_decode_bigint(int.from_bytes({r}, 'little'))",
+            indent=self.indent + 4,
+        )
+
+
+class BlockMessageMethodDecodeFrom(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        """Slices a memoryview of the buffer, which doesn't copy."""
         self.push(
-            f"self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)",
+            f"def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:"
+        )
+        self.push_docstring(
+            "Decode the bytes in given buffer s at offset to this object, without slicing copies.",
+            ":param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`",
+            "   bytes after offset.",
+            indent=self.indent + 4,
+        )
+        self.push("mv = memoryview(s)", indent=self.indent + 4)
+        if self.d.has_bounded_array():
+            # The length is known after the counts are decoded.
+            self.push(
+                "self.bp_decode_bigint(int.from_bytes(mv[offset:], 'little'))",
+                indent=self.indent + 4,
+            )
+            self.push(
+                "assert len(mv) - offset >= (self.bp_nbits() + 7) >> 3, bp.NotEnoughBytes()",
+                indent=self.indent + 4,
+            )
+            return
+        self.push(
+            f"assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()",
+            indent=self.indent + 4,
+        )
+        r = "mv[offset : offset + self.BYTES_LENGTH]"
+        if not self.d.is_fixed_size():
+            r = "mv[offset:]"
+        self.push(
+            f"self.bp_decode_bigint(int.from_bytes({r}, 'little'))",
+            indent=self.indent + 4,
+        )
+
+
+class BlockMessageMethodDecodeColumns(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        if not self.d.is_fixed_size():
+            return
+        if has_ranges(self.d) or has_reals(self.d):
+            # Columns are the bits on the wire, the offsets of fields of option range,
+            # and the bits of float32 and fixed-point values.
+            return
+        self.push("@classmethod")
+        self.push(
+            "def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:"
+        )
+        self.push_docstring(
+            "Decode concatenated frames of this message in buffer s into columns.",
+            "Returns a dict of field name to an array of values, see bp.decode_columns.",
+            indent=self.indent + 4,
+        )
+        self.push(f"columns: List[bp.Column] = [", indent=self.indent + 4)
+        for line in self.formatter.format_fixed_size_columns(self.d, "", 0):
+            self.push(line, indent=self.indent + 8)
+        self.push("]", indent=self.indent + 4)
+        self.push(
+            "return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)",
             indent=self.indent + 4,
         )
 
@@ -835,8 +1076,15 @@ class BlockMessage(BlockMessageBase, BlockComposition[F]):
             BlockMessageMethodSetByte(self.d, indent=4),
             BlockMessageMethodGetByte(self.d, indent=4),
             BlockMessageMethodGetAccessor(self.d, indent=4),
+            BlockMessageMethodGetSetLen(self.d, indent=4),
+            BlockMessageMethodNbits(self.d, indent=4),
+            BlockMessageMethodEncodeBigint(self.d, indent=4),
+            BlockMessageMethodDecodeBigint(self.d, indent=4),
             BlockMessageMethodEncode(self.d, indent=4),
+            BlockMessageMethodEncodeInto(self.d, indent=4),
             BlockMessageMethodDecode(self.d, indent=4),
+            BlockMessageMethodDecodeFrom(self.d, indent=4),
+            BlockMessageMethodDecodeColumns(self.d, indent=4),
             BlockMessageMethodProcessInt(self.d, indent=4),
         ]
 
@@ -845,6 +1093,81 @@ class BlockMessage(BlockMessageBase, BlockComposition[F]):
         return "\n\n"
 
 
+class BlockMessageViewField(BlockBindMessageField[F]):
+    @override(Block)
+    def render(self) -> None:
+        fields = self.d.message.sorted_fields()
+        i = sum(f.type.nbits() for f in fields if f.number < self.d.number)
+        view_type = self.formatter.format_view_type(self.d.type)
+        value = self.formatter.format_view_value(self.d.type, str(i))
+        self.push("@property")
+        self.push(f"def {self.message_field_name}(self) -> {view_type}:")
+        self.push(f"return {value}", indent=self.indent + 4)
+
+
+class BlockMessageViewMethodToMessage(BlockMessageBase):
+    @override(Block)
+    def render(self) -> None:
+        self.push(f"def to_message(self) -> {self.message_name}:")
+        self.push_docstring(
+            f"Decode the whole message to a {self.message_name} object.",
+            indent=self.indent + 4,
+        )
+        self.push(f"m = {self.message_name}()", indent=self.indent + 4)
+        self.push(
+            f"m.bp_decode_bigint(self.bp_uint(0, {self.d.nbits()}))",
+            indent=self.indent + 4,
+        )
+        self.push("return m", indent=self.indent + 4)
+
+
+class BlockMessageViewBody(BlockMessageBase, BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = [
+            BlockMessageViewField(field, indent=self.indent)
+            for field in self.d.sorted_fields()
+        ]
+        b.append(BlockMessageViewMethodToMessage(self.d, indent=self.indent))
+        return b
+
+
+class BlockMessageView(BlockMessageBase, BlockWrapper[F]):
+    @override(BlockWrapper)
+    def wraps(self) -> Optional[Block[F]]:
+        return BlockMessageViewBody(self.d, indent=4)
+
+    @override(BlockWrapper)
+    def before(self) -> None:
+        view_name = self.formatter.format_view_name(self.d)
+        self.push(f"class {view_name}(bp.MessageView):")
+        self.push_docstring(
+            f"Read-only view of a {self.message_name} in an encoded buffer, of which the properties",
+            "extract fields from the buffer on access, see bp.MessageView.",
+            indent=4,
+        )
+        self.push("__slots__ = ()", indent=4)
+        self.push(
+            f"{self.message_size_constant_name}: ClassVar[int] = {self.message_nbytes}\n",
+            indent=4,
+        )
+
+
+class BlockMessageWithView(BlockMessageBase, BlockComposition[F]):
+    @override(BlockComposition)
+    def blocks(self) -> List[Block[F]]:
+        b: List[Block[F]] = [BlockMessage(self.d)]
+        if self.d.is_fixed_size():
+            # Bit offsets of fields are known at compile time for messages in fixed
+            # size only.
+            b.append(BlockMessageView(self.d))
+        return b
+
+    @override(BlockComposition)
+    def separator(self) -> str:
+        return "\n\n\n"
+
+
 class BlockBoundDefinitionList(BlockBoundDefinitionDispatcher):
     @override(BlockBoundDefinitionDispatcher)
     def dispatch(self, d: BoundDefinition) -> Optional[Block[F]]:
@@ -855,7 +1178,7 @@ class BlockBoundDefinitionList(BlockBoundDefinitionDispatcher):
         if isinstance(d, Enum):
             return BlockEnum(d)
         if isinstance(d, Message):
-            return BlockMessage(d)
+            return BlockMessageWithView(d)
         return None
 
     @override(BlockComposition)
@@ -891,7 +1214,7 @@ class RendererPy(Renderer[F]):
 
     @override(Renderer)
     def formatter(self) -> F:
-        return F()
+        return F(slots=self.proto.get_option_as_bool_or_raise("py.slots"))
 
     @override(Renderer)
     def block(self) -> Block[F]:
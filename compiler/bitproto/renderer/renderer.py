@@ -10,10 +10,14 @@ from abc import abstractmethod
 from typing import Generic, List, Optional
 
 from bitproto._ast import Proto
-from bitproto.errors import InternalError, LanguageNotSupportOptimizationMode
+from bitproto.errors import (
+    BoundedArrayInOptimizationModeUnsupported,
+    InternalError,
+    LanguageNotSupportOptimizationMode,
+)
 from bitproto.renderer.block import Block, BlockRenderContext
 from bitproto.renderer.formatter import F
-from bitproto.utils import final, overridable
+from bitproto.utils import final, overridable, write_file_if_changed
 
 
 class Renderer(Generic[F]):
@@ -35,8 +39,8 @@ class Renderer(Generic[F]):
         self.proto = proto
         self.outdir = outdir or self.get_outdir_default(proto)
         self.optimization_mode = optimization_mode
-        self.check_proto_for_optimization_mode()
         self.optimization_mode_filter_messages = optimization_mode_filter_messages
+        self.check_proto_for_optimization_mode()
 
         self.out_filename = self.get_out_filename()
         self.out_filepath = os.path.join(self.outdir, self.out_filename)
@@ -66,6 +70,7 @@ class Renderer(Generic[F]):
             formatter=formatter,
             bound=self.proto,
             optimization_mode_filter_messages=self.optimization_mode_filter_messages,
+            optimization_mode=self.optimization_mode,
         )
         block._render_with_ctx(ctx)
         return block._collect()
@@ -73,11 +78,11 @@ class Renderer(Generic[F]):
     def render(self) -> str:
         """Render current proto to file(s).
         Returns the filepath generated.
+        The file is left untouched if its content doesn't change, so that its
+        modification time is kept for build systems.
         """
         content = self.render_string()
-
-        with open(self.out_filepath, "w") as f:
-            f.write(content)
+        write_file_if_changed(self.out_filepath, content)
         return self.out_filepath
 
     @final
@@ -85,13 +90,26 @@ class Renderer(Generic[F]):
         """Raises if proto contains non-traditional definitions.
 
         Proto's definitions and types aren't checked whether to be traditional here. The
-        parser is enforced to traditional mode to check it during parsing.
+        parser is enforced to traditional mode to check it during parsing. Except bounded
+        arrays, which are checked for the messages to generate.
         """
         if not self.optimization_mode:
             return
         if not self.support_optimization():
             raise LanguageNotSupportOptimizationMode(lang=self.language_name())
 
+        filter_messages = self.optimization_mode_filter_messages
+        paths = None
+        if filter_messages:
+            paths = self.proto.reachable_paths(tuple(filter_messages))
+        for _, message in self.proto.messages(recursive=True):
+            if paths is not None and message.path not in paths:
+                continue
+            if message.has_bounded_array():
+                raise BoundedArrayInOptimizationModeUnsupported(
+                    message_name=message.name
+                )
+
     @abstractmethod
     def language_name(self) -> str:
         """Returns the language name of this renderer."""
@@ -0,0 +1,138 @@
+"""
+bitproto.schema
+~~~~~~~~~~~~~~~
+
+Binary schema of messages, loaded by the dynamic codecs of the C and Go libraries at
+runtime, to encode and decode messages without generated code, e.g. in a gateway to
+handle schemas changing faster than it's rebuilt.
+
+All integers are little-endian. A schema is:
+
+    "BPSC" u8 version(1) u8 reserved(0) u16 nmessages message*
+
+where a message is:
+
+    str name, u64 fingerprint, u8 extensible, u16 nfields, (str name, type)*
+
+a str is a u8 length followed by the bytes, and a type is a u8 flag, the same to the
+BP_TYPE_XXX flags of the C library, followed by:
+
+    BOOL, BYTE           nothing
+    INT, UINT, ENUM      u8 nbits
+    ARRAY                u8 extensible, u16 cap, type of the element
+    MESSAGE              u16 index of the message in this schema
+
+Aliases are resolved. Fields of option range, float32 and fixed-point types are not
+supported. Fields are in the order of field numbers, as laid out on the wire. Messages
+are the ones defined in the proto, nested ones included, followed by the ones imported
+and referenced.
+"""
+
+import struct
+from typing import Dict, List
+
+from bitproto._ast import (
+    Alias,
+    Array,
+    Bool,
+    Byte,
+    Enum,
+    Fixed,
+    Float,
+    Int,
+    Integer,
+    Message,
+    Proto,
+    Range,
+    Type,
+)
+from bitproto.errors import (
+    BoundedArrayInSchemaUnsupported,
+    FloatInSchemaUnsupported,
+    InternalError,
+    RangeInSchemaUnsupported,
+)
+from bitproto.layout import fingerprint, format_qualified_name, resolve_alias
+
+MAGIC = b"BPSC"
+VERSION = 1
+
+# The same to the BP_TYPE_XXX flags of the C library.
+FLAG_BOOL = 1
+FLAG_INT = 2
+FLAG_UINT = 3
+FLAG_BYTE = 4
+FLAG_ENUM = 5
+FLAG_ARRAY = 7
+FLAG_MESSAGE = 8
+
+
+class SchemaWriter:
+    """Collects messages of a proto and the ones they reference, and dumps them."""
+
+    def __init__(self, proto: Proto) -> None:
+        self.messages: List[Message] = []
+        self.indexes: Dict[int, int] = {}  # id of a message => index.
+        for _, message in proto.messages(recursive=True, bound=proto):
+            self.index_of(message)
+
+    def index_of(self, m: Message) -> int:
+        """Returns the index of given message, appending it if not seen yet."""
+        key = id(m)
+        if key not in self.indexes:
+            self.indexes[key] = len(self.messages)
+            self.messages.append(m)
+        return self.indexes[key]
+
+    def dump_str(self, s: str) -> bytes:
+        b = s.encode()
+        if len(b) > 255:
+            raise InternalError(f"schema name too long: {s}")
+        return struct.pack("<B", len(b)) + b
+
+    def dump_type(self, t: Type) -> bytes:
+        t = resolve_alias(t)
+        if isinstance(t, Bool):
+            return struct.pack("<B", FLAG_BOOL)
+        if isinstance(t, Byte):
+            return struct.pack("<B", FLAG_BYTE)
+        if isinstance(t, Range):
+            raise RangeInSchemaUnsupported()
+        if isinstance(t, (Float, Fixed)):
+            raise FloatInSchemaUnsupported()
+        if isinstance(t, Enum):
+            return struct.pack("<BB", FLAG_ENUM, t.nbits())
+        if isinstance(t, Int):
+            return struct.pack("<BB", FLAG_INT, t.nbits())
+        if isinstance(t, Integer):
+            return struct.pack("<BB", FLAG_UINT, t.nbits())
+        if isinstance(t, Array) and t.bounded:
+            raise BoundedArrayInSchemaUnsupported()
+        if isinstance(t, Array):
+            head = struct.pack("<BBH", FLAG_ARRAY, int(t.extensible), t.cap)
+            return head + self.dump_type(t.element_type)
+        if isinstance(t, Message):
+            return struct.pack("<BH", FLAG_MESSAGE, self.index_of(t))
+        raise InternalError("schema dump_type got unexpected type")
+
+    def dump_message(self, m: Message) -> bytes:
+        fields = m.sorted_fields()
+        b = self.dump_str(format_qualified_name(m))
+        b += struct.pack("<QBH", fingerprint(m), int(m.extensible), len(fields))
+        for field in fields:
+            b += self.dump_str(field.name) + self.dump_type(field.type)
+        return b
+
+    def dump(self) -> bytes:
+        body = b""
+        k = 0
+        # Messages referenced are appended while dumping.
+        while k < len(self.messages):
+            body += self.dump_message(self.messages[k])
+            k += 1
+        return MAGIC + struct.pack("<BBH", VERSION, 0, len(self.messages)) + body
+
+
+def dump(proto: Proto) -> bytes:
+    """Returns the binary schema of messages in given proto."""
+    return SchemaWriter(proto).dump()
@@ -40,6 +40,7 @@ __all__ = (
     "overridable",
     "isabstractmethod",
     "write_file",
+    "write_file_if_changed",
     "Color",
     "colored",
     "pascal_case",
@@ -284,6 +285,32 @@ def write_file(filepath: str, s: str) -> None:
         f.write(s)
 
 
+def write_file_if_changed(filepath: str, s: str) -> bool:
+    """Write given s to filepath, skips if the file's content is already s, to keep
+    its modification time for build systems. Returns True if written."""
+    try:
+        with open(filepath, "r") as f:
+            if f.read() == s:
+                return False
+    except (IOError, UnicodeDecodeError):
+        pass
+    write_file(filepath, s)
+    return True
+
+
+def write_binary_file_if_changed(filepath: str, b: bytes) -> bool:
+    """Binary version of write_file_if_changed."""
+    try:
+        with open(filepath, "rb") as f:
+            if f.read() == b:
+                return False
+    except IOError:
+        pass
+    with open(filepath, "wb") as f:
+        f.write(b)
+    return True
+
+
 def write_stderr(s: str) -> None:
     """Write a line of string to stderr."""
     sys.stderr.write(s + "\n")
@@ -0,0 +1,185 @@
+"""
+bitproto.vectors
+~~~~~~~~~~~~~~~~
+
+Test vectors of messages for option self_test: pseudo-random structs and their
+encodings, computed by the Python implementation, the generated Python module and
+the bitproto Python library. The C and Go renderers generate them as tables, and
+functions BpSelfTestXXX checking the encoders and decoders against them at runtime.
+
+Values are picked to be held exactly in every language, enums of the values declared,
+integers of option range in the range, float32s and fixed-point numbers exact in their
+types, so that a mismatch is a bug of the encoder or decoder checked.
+"""
+
+import random
+import sys
+from dataclasses import dataclass
+from types import ModuleType
+from typing import Any, Dict, List, Tuple
+
+from bitproto._ast import (
+    Array,
+    Bool,
+    Byte,
+    Enum,
+    Fixed,
+    Float,
+    Int,
+    Integer,
+    Message,
+    Proto,
+    Range,
+    Type,
+)
+from bitproto.errors import InternalError, SelfTestVectorsUnavailable
+from bitproto.layout import format_qualified_name, resolve_alias
+
+
+@dataclass
+class Vector:
+    """A test vector of a message.
+
+    :param value: The field values by field name, nested messages are dicts as well,
+       arrays are lists, bounded arrays hold the elements in use only.
+    :param buffer: The encoding of the value by the Python implementation.
+    """
+
+    value: Dict[str, Any]
+    buffer: bytes
+
+
+def random_value(t: Type, rng: random.Random) -> Any:
+    """Returns a pseudo-random value of given type."""
+    t = resolve_alias(t)
+    if isinstance(t, Bool):
+        return rng.random() < 0.5
+    if isinstance(t, Enum):
+        return rng.choice([field.value for field in t.fields()])
+    if isinstance(t, Range):
+        return rng.randint(t.lo, t.hi)
+    if isinstance(t, Int):
+        return rng.randint(-(1 << (t.nbits() - 1)), (1 << (t.nbits() - 1)) - 1)
+    if isinstance(t, (Integer, Byte)):
+        return rng.randint(0, (1 << t.nbits()) - 1)
+    if isinstance(t, Float):
+        # Within the 24 bits significand, exact in float32.
+        return rng.randint(-(1 << 23), 1 << 23) * 2.0 ** rng.randint(-30, 10)
+    if isinstance(t, Fixed):
+        # Within the significand of the float or double holding it.
+        nbits = min(t.cap, 52)
+        if t.signed:
+            w = rng.randint(-(1 << (nbits - 1)), (1 << (nbits - 1)) - 1)
+        else:
+            w = rng.randint(0, (1 << nbits) - 1)
+        return w * t.unit()
+    if isinstance(t, Array):
+        n = rng.randint(0, t.cap) if t.bounded else t.cap
+        return [random_value(t.element_type, rng) for _ in range(n)]
+    if isinstance(t, Message):
+        return {
+            field.name: random_value(field.type, rng) for field in t.sorted_fields()
+        }
+    raise InternalError("random_value got unexpected type")
+
+
+def message_vectors(m: Message, n: int) -> List[Vector]:
+    """Returns n test vectors of given message, the same on every run."""
+    modules = reference_modules(m.bound)
+    vectors: List[Vector] = []
+    for k in range(n):
+        rng = random.Random(f"{format_qualified_name(m)}/{k}")
+        value = random_value(m, rng)
+        obj = to_reference(m, value, modules)
+        buffer = bytes(obj.encode())
+        # Decodes back to the same encoding, or the value is not held exactly.
+        decoded = reference_class(m, modules)()
+        decoded.decode(bytearray(buffer))
+        if bytes(decoded.encode()) != buffer:
+            raise InternalError(f"test vector {k} of message {m.name} not stable")
+        vectors.append(Vector(value=value, buffer=buffer))
+    return vectors
+
+
+def to_reference(t: Type, v: Any, modules: Dict[str, ModuleType]) -> Any:
+    """Returns the value of the Python implementation for value v of given type."""
+    t = resolve_alias(t)
+    if isinstance(t, Message):
+        obj = reference_class(t, modules)()
+        for field in t.sorted_fields():
+            name = reference_formatter().format_message_field_name(field)
+            setattr(obj, name, to_reference(field.type, v[field.name], modules))
+        return obj
+    if isinstance(t, Array):
+        return [to_reference(t.element_type, e, modules) for e in v]
+    return v
+
+
+def reference_formatter() -> Any:
+    from bitproto.renderer.impls.py.formatter import PyFormatter
+
+    return PyFormatter()
+
+
+def reference_class(t: Message, modules: Dict[str, ModuleType]) -> Any:
+    module = modules[proto_key(t.bound)]
+    return getattr(module, reference_formatter().format_definition_name_inner_proto(t))
+
+
+def proto_key(proto: Proto) -> str:
+    return proto.filepath or proto.name
+
+
+# Modules of the Python implementation by the protos rendered, see reference_modules.
+_modules: Dict[int, Tuple[Proto, Dict[str, ModuleType]]] = {}
+
+
+def reference_modules(proto: Proto) -> Dict[str, ModuleType]:
+    """Returns the generated Python modules of given proto and the protos it imports,
+    by proto_key, executed in memory. Raises SelfTestVectorsUnavailable if the
+    bitproto Python library is not installed."""
+    cached = _modules.get(id(proto))
+    if cached is not None and cached[0] is proto:
+        return cached[1]
+
+    try:
+        import bitprotolib  # noqa: F401
+    except ImportError:
+        raise SelfTestVectorsUnavailable()
+
+    from bitproto.parser import parse
+    from bitproto.renderer.impls.py import RendererPy
+
+    protos = [child for _, child in proto.protos(recursive=True)]
+    protos.reverse()  # Nested imports first.
+    protos.append(proto)
+
+    modules: Dict[str, ModuleType] = {}
+    for p in protos:
+        key = proto_key(p)
+        if key in modules:
+            continue
+        # Imported protos are rendered on their own, as they are compiled.
+        renderer = RendererPy(parse(p.filepath) if p is not proto else p, outdir="")
+        name = reference_formatter().format_module_name(p)
+        module = ModuleType(name)
+        # Registered while executing only, for the imports of the protos and the
+        # dataclasses inside.
+        names = [name] + [m.__name__ for m in modules.values()]
+        saved = {n: sys.modules.get(n) for n in names}
+        try:
+            for m in modules.values():
+                sys.modules[m.__name__] = m
+            sys.modules[name] = module
+            exec(compile(renderer.render_string(), name, "exec"), module.__dict__)
+        finally:
+            for n, saved_module in saved.items():
+                if saved_module is None:
+                    sys.modules.pop(n, None)
+                else:
+                    sys.modules[n] = saved_module
+        modules[key] = module
+
+    _modules[id(proto)] = (proto, modules)
+    return modules
+
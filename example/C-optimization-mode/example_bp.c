@@ -1,297 +1,401 @@
 // Code generated by bitproto. DO NOT EDIT.
 
+#include <string.h>
+
 #include "example_bp.h"
 
-int EncodeDrone(struct Drone *m, unsigned char *s) {
+int EncodeDrone(const struct Drone *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Drone", BP_TRACE_ENCODE, BYTES_LENGTH_DRONE);
     s[0] = (((unsigned char *)&((*m).status))[0] ) & 7;
-    s[0] |= (((unsigned char *)&((*m).position.latitude))[0] << 3) & 248;
-    s[1] = (((unsigned char *)&((*m).position.latitude))[0] >> 5) & 7;
-    s[1] |= (((unsigned char *)&((*m).position.latitude))[1] << 3) & 248;
-    s[2] = (((unsigned char *)&((*m).position.latitude))[1] >> 5) & 7;
-    s[2] |= (((unsigned char *)&((*m).position.latitude))[2] << 3) & 248;
-    s[3] = (((unsigned char *)&((*m).position.latitude))[2] >> 5) & 7;
-    s[3] |= (((unsigned char *)&((*m).position.latitude))[3] << 3) & 248;
-    s[4] = (((unsigned char *)&((*m).position.latitude))[3] >> 5) & 7;
-    s[4] |= (((unsigned char *)&((*m).position.longitude))[0] << 3) & 248;
-    s[5] = (((unsigned char *)&((*m).position.longitude))[0] >> 5) & 7;
-    s[5] |= (((unsigned char *)&((*m).position.longitude))[1] << 3) & 248;
-    s[6] = (((unsigned char *)&((*m).position.longitude))[1] >> 5) & 7;
-    s[6] |= (((unsigned char *)&((*m).position.longitude))[2] << 3) & 248;
-    s[7] = (((unsigned char *)&((*m).position.longitude))[2] >> 5) & 7;
-    s[7] |= (((unsigned char *)&((*m).position.longitude))[3] << 3) & 248;
-    s[8] = (((unsigned char *)&((*m).position.longitude))[3] >> 5) & 7;
-    s[8] |= (((unsigned char *)&((*m).position.altitude))[0] << 3) & 248;
-    s[9] = (((unsigned char *)&((*m).position.altitude))[0] >> 5) & 7;
-    s[9] |= (((unsigned char *)&((*m).position.altitude))[1] << 3) & 248;
-    s[10] = (((unsigned char *)&((*m).position.altitude))[1] >> 5) & 7;
-    s[10] |= (((unsigned char *)&((*m).position.altitude))[2] << 3) & 248;
-    s[11] = (((unsigned char *)&((*m).position.altitude))[2] >> 5) & 7;
-    s[11] |= (((unsigned char *)&((*m).position.altitude))[3] << 3) & 248;
-    s[12] = (((unsigned char *)&((*m).position.altitude))[3] >> 5) & 7;
-    s[12] |= (((unsigned char *)&((*m).flight.pose.yaw))[0] << 3) & 248;
-    s[13] = (((unsigned char *)&((*m).flight.pose.yaw))[0] >> 5) & 7;
-    s[13] |= (((unsigned char *)&((*m).flight.pose.yaw))[1] << 3) & 248;
-    s[14] = (((unsigned char *)&((*m).flight.pose.yaw))[1] >> 5) & 7;
-    s[14] |= (((unsigned char *)&((*m).flight.pose.yaw))[2] << 3) & 248;
-    s[15] = (((unsigned char *)&((*m).flight.pose.yaw))[2] >> 5) & 7;
-    s[15] |= (((unsigned char *)&((*m).flight.pose.yaw))[3] << 3) & 248;
-    s[16] = (((unsigned char *)&((*m).flight.pose.yaw))[3] >> 5) & 7;
-    s[16] |= (((unsigned char *)&((*m).flight.pose.pitch))[0] << 3) & 248;
-    s[17] = (((unsigned char *)&((*m).flight.pose.pitch))[0] >> 5) & 7;
-    s[17] |= (((unsigned char *)&((*m).flight.pose.pitch))[1] << 3) & 248;
-    s[18] = (((unsigned char *)&((*m).flight.pose.pitch))[1] >> 5) & 7;
-    s[18] |= (((unsigned char *)&((*m).flight.pose.pitch))[2] << 3) & 248;
-    s[19] = (((unsigned char *)&((*m).flight.pose.pitch))[2] >> 5) & 7;
-    s[19] |= (((unsigned char *)&((*m).flight.pose.pitch))[3] << 3) & 248;
-    s[20] = (((unsigned char *)&((*m).flight.pose.pitch))[3] >> 5) & 7;
-    s[20] |= (((unsigned char *)&((*m).flight.pose.roll))[0] << 3) & 248;
-    s[21] = (((unsigned char *)&((*m).flight.pose.roll))[0] >> 5) & 7;
-    s[21] |= (((unsigned char *)&((*m).flight.pose.roll))[1] << 3) & 248;
-    s[22] = (((unsigned char *)&((*m).flight.pose.roll))[1] >> 5) & 7;
-    s[22] |= (((unsigned char *)&((*m).flight.pose.roll))[2] << 3) & 248;
-    s[23] = (((unsigned char *)&((*m).flight.pose.roll))[2] >> 5) & 7;
-    s[23] |= (((unsigned char *)&((*m).flight.pose.roll))[3] << 3) & 248;
-    s[24] = (((unsigned char *)&((*m).flight.pose.roll))[3] >> 5) & 7;
-    s[24] |= (((unsigned char *)&((*m).flight.velocity[0]))[0] << 3) & 248;
-    s[25] = (((unsigned char *)&((*m).flight.velocity[0]))[0] >> 5) & 7;
-    s[25] |= (((unsigned char *)&((*m).flight.velocity[0]))[1] << 3) & 248;
-    s[26] = (((unsigned char *)&((*m).flight.velocity[0]))[1] >> 5) & 7;
-    s[26] |= (((unsigned char *)&((*m).flight.velocity[0]))[2] << 3) & 248;
-    s[27] = (((unsigned char *)&((*m).flight.velocity[0]))[2] >> 5) & 7;
-    s[27] |= (((unsigned char *)&((*m).flight.velocity[0]))[3] << 3) & 248;
-    s[28] = (((unsigned char *)&((*m).flight.velocity[0]))[3] >> 5) & 7;
-    s[28] |= (((unsigned char *)&((*m).flight.velocity[1]))[0] << 3) & 248;
-    s[29] = (((unsigned char *)&((*m).flight.velocity[1]))[0] >> 5) & 7;
-    s[29] |= (((unsigned char *)&((*m).flight.velocity[1]))[1] << 3) & 248;
-    s[30] = (((unsigned char *)&((*m).flight.velocity[1]))[1] >> 5) & 7;
-    s[30] |= (((unsigned char *)&((*m).flight.velocity[1]))[2] << 3) & 248;
-    s[31] = (((unsigned char *)&((*m).flight.velocity[1]))[2] >> 5) & 7;
-    s[31] |= (((unsigned char *)&((*m).flight.velocity[1]))[3] << 3) & 248;
-    s[32] = (((unsigned char *)&((*m).flight.velocity[1]))[3] >> 5) & 7;
-    s[32] |= (((unsigned char *)&((*m).flight.velocity[2]))[0] << 3) & 248;
-    s[33] = (((unsigned char *)&((*m).flight.velocity[2]))[0] >> 5) & 7;
-    s[33] |= (((unsigned char *)&((*m).flight.velocity[2]))[1] << 3) & 248;
-    s[34] = (((unsigned char *)&((*m).flight.velocity[2]))[1] >> 5) & 7;
-    s[34] |= (((unsigned char *)&((*m).flight.velocity[2]))[2] << 3) & 248;
-    s[35] = (((unsigned char *)&((*m).flight.velocity[2]))[2] >> 5) & 7;
-    s[35] |= (((unsigned char *)&((*m).flight.velocity[2]))[3] << 3) & 248;
-    s[36] = (((unsigned char *)&((*m).flight.velocity[2]))[3] >> 5) & 7;
-    s[36] |= (((unsigned char *)&((*m).flight.acceleration[0]))[0] << 3) & 248;
-    s[37] = (((unsigned char *)&((*m).flight.acceleration[0]))[0] >> 5) & 7;
-    s[37] |= (((unsigned char *)&((*m).flight.acceleration[0]))[1] << 3) & 248;
-    s[38] = (((unsigned char *)&((*m).flight.acceleration[0]))[1] >> 5) & 7;
-    s[38] |= (((unsigned char *)&((*m).flight.acceleration[0]))[2] << 3) & 248;
-    s[39] = (((unsigned char *)&((*m).flight.acceleration[0]))[2] >> 5) & 7;
-    s[39] |= (((unsigned char *)&((*m).flight.acceleration[0]))[3] << 3) & 248;
-    s[40] = (((unsigned char *)&((*m).flight.acceleration[0]))[3] >> 5) & 7;
-    s[40] |= (((unsigned char *)&((*m).flight.acceleration[1]))[0] << 3) & 248;
-    s[41] = (((unsigned char *)&((*m).flight.acceleration[1]))[0] >> 5) & 7;
-    s[41] |= (((unsigned char *)&((*m).flight.acceleration[1]))[1] << 3) & 248;
-    s[42] = (((unsigned char *)&((*m).flight.acceleration[1]))[1] >> 5) & 7;
-    s[42] |= (((unsigned char *)&((*m).flight.acceleration[1]))[2] << 3) & 248;
-    s[43] = (((unsigned char *)&((*m).flight.acceleration[1]))[2] >> 5) & 7;
-    s[43] |= (((unsigned char *)&((*m).flight.acceleration[1]))[3] << 3) & 248;
-    s[44] = (((unsigned char *)&((*m).flight.acceleration[1]))[3] >> 5) & 7;
-    s[44] |= (((unsigned char *)&((*m).flight.acceleration[2]))[0] << 3) & 248;
-    s[45] = (((unsigned char *)&((*m).flight.acceleration[2]))[0] >> 5) & 7;
-    s[45] |= (((unsigned char *)&((*m).flight.acceleration[2]))[1] << 3) & 248;
-    s[46] = (((unsigned char *)&((*m).flight.acceleration[2]))[1] >> 5) & 7;
-    s[46] |= (((unsigned char *)&((*m).flight.acceleration[2]))[2] << 3) & 248;
-    s[47] = (((unsigned char *)&((*m).flight.acceleration[2]))[2] >> 5) & 7;
-    s[47] |= (((unsigned char *)&((*m).flight.acceleration[2]))[3] << 3) & 248;
-    s[48] = (((unsigned char *)&((*m).flight.acceleration[2]))[3] >> 5) & 7;
-    s[48] |= (((unsigned char *)&((*m).propellers[0].id))[0] << 3) & 248;
-    s[49] = (((unsigned char *)&((*m).propellers[0].id))[0] >> 5) & 7;
+    s[0] |= (unsigned char)((uint64_t)((*m).position.latitude) << 3);
+    s[1] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 8);
+    s[2] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 16);
+    s[3] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 24);
+    s[4] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 32) & 7;
+    s[4] |= (unsigned char)((uint64_t)((*m).position.longitude) << 3);
+    s[5] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 8);
+    s[6] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 16);
+    s[7] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 24);
+    s[8] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 32) & 7;
+    s[8] |= (unsigned char)((uint64_t)((*m).position.altitude) << 3);
+    s[9] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 8);
+    s[10] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 16);
+    s[11] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 24);
+    s[12] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 32) & 7;
+    s[12] |= (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3);
+    s[13] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 8);
+    s[14] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 16);
+    s[15] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 24);
+    s[16] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 32) & 7;
+    s[16] |= (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3);
+    s[17] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 8);
+    s[18] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 16);
+    s[19] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 24);
+    s[20] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 32) & 7;
+    s[20] |= (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3);
+    s[21] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 8);
+    s[22] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 16);
+    s[23] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 24);
+    s[24] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 32) & 7;
+    s[24] |= (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3);
+    s[25] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 8);
+    s[26] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 16);
+    s[27] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 24);
+    s[28] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 32) & 7;
+    s[28] |= (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3);
+    s[29] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 8);
+    s[30] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 16);
+    s[31] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 24);
+    s[32] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 32) & 7;
+    s[32] |= (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3);
+    s[33] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 8);
+    s[34] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 16);
+    s[35] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 24);
+    s[36] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 32) & 7;
+    s[36] |= (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3);
+    s[37] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 8);
+    s[38] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 16);
+    s[39] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 24);
+    s[40] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 32) & 7;
+    s[40] |= (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3);
+    s[41] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 8);
+    s[42] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 16);
+    s[43] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 24);
+    s[44] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 32) & 7;
+    s[44] |= (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3);
+    s[45] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 8);
+    s[46] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 16);
+    s[47] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 24);
+    s[48] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 32) & 7;
+    s[48] |= (unsigned char)((uint64_t)((*m).propellers[0].id) << 3);
+    s[49] = (unsigned char)((uint64_t)((*m).propellers[0].id) << 3 >> 8) & 7;
     s[49] |= (((unsigned char *)&((*m).propellers[0].status))[0] << 3) & 24;
     s[49] |= (((unsigned char *)&((*m).propellers[0].direction))[0] << 5) & 96;
-    s[49] |= (((unsigned char *)&((*m).propellers[1].id))[0] << 7) & 128;
-    s[50] = (((unsigned char *)&((*m).propellers[1].id))[0] >> 1) & 127;
-    s[50] |= (((unsigned char *)&((*m).propellers[1].status))[0] << 7) & 128;
-    s[51] = (((unsigned char *)&((*m).propellers[1].status))[0] >> 1) & 1;
+    s[49] |= (unsigned char)((uint64_t)((*m).propellers[1].id) << 7);
+    s[50] = (unsigned char)((uint64_t)((*m).propellers[1].id) << 7 >> 8) & 127;
+    s[50] |= (unsigned char)((uint64_t)((*m).propellers[1].status) << 7);
+    s[51] = (unsigned char)((uint64_t)((*m).propellers[1].status) << 7 >> 8) & 1;
     s[51] |= (((unsigned char *)&((*m).propellers[1].direction))[0] << 1) & 6;
-    s[51] |= (((unsigned char *)&((*m).propellers[2].id))[0] << 3) & 248;
-    s[52] = (((unsigned char *)&((*m).propellers[2].id))[0] >> 5) & 7;
+    s[51] |= (unsigned char)((uint64_t)((*m).propellers[2].id) << 3);
+    s[52] = (unsigned char)((uint64_t)((*m).propellers[2].id) << 3 >> 8) & 7;
     s[52] |= (((unsigned char *)&((*m).propellers[2].status))[0] << 3) & 24;
     s[52] |= (((unsigned char *)&((*m).propellers[2].direction))[0] << 5) & 96;
-    s[52] |= (((unsigned char *)&((*m).propellers[3].id))[0] << 7) & 128;
-    s[53] = (((unsigned char *)&((*m).propellers[3].id))[0] >> 1) & 127;
-    s[53] |= (((unsigned char *)&((*m).propellers[3].status))[0] << 7) & 128;
-    s[54] = (((unsigned char *)&((*m).propellers[3].status))[0] >> 1) & 1;
+    s[52] |= (unsigned char)((uint64_t)((*m).propellers[3].id) << 7);
+    s[53] = (unsigned char)((uint64_t)((*m).propellers[3].id) << 7 >> 8) & 127;
+    s[53] |= (unsigned char)((uint64_t)((*m).propellers[3].status) << 7);
+    s[54] = (unsigned char)((uint64_t)((*m).propellers[3].status) << 7 >> 8) & 1;
     s[54] |= (((unsigned char *)&((*m).propellers[3].direction))[0] << 1) & 6;
-    s[54] |= (((unsigned char *)&((*m).power.battery))[0] << 3) & 248;
-    s[55] = (((unsigned char *)&((*m).power.battery))[0] >> 5) & 7;
+    s[54] |= (unsigned char)((uint64_t)((*m).power.battery) << 3);
+    s[55] = (unsigned char)((uint64_t)((*m).power.battery) << 3 >> 8) & 7;
     s[55] |= (((unsigned char *)&((*m).power.status))[0] << 3) & 24;
     s[55] |= (((unsigned char *)&((*m).power.is_charging))[0] << 5) & 32;
-    s[55] |= (((unsigned char *)&((*m).network.signal))[0] << 6) & 192;
-    s[56] = (((unsigned char *)&((*m).network.signal))[0] >> 2) & 3;
-    s[56] |= (((unsigned char *)&((*m).network.heartbeat_at))[0] << 2) & 252;
-    s[57] = (((unsigned char *)&((*m).network.heartbeat_at))[0] >> 6) & 3;
-    s[57] |= (((unsigned char *)&((*m).network.heartbeat_at))[1] << 2) & 252;
-    s[58] = (((unsigned char *)&((*m).network.heartbeat_at))[1] >> 6) & 3;
-    s[58] |= (((unsigned char *)&((*m).network.heartbeat_at))[2] << 2) & 252;
-    s[59] = (((unsigned char *)&((*m).network.heartbeat_at))[2] >> 6) & 3;
-    s[59] |= (((unsigned char *)&((*m).network.heartbeat_at))[3] << 2) & 252;
-    s[60] = (((unsigned char *)&((*m).network.heartbeat_at))[3] >> 6) & 3;
+    s[55] |= (unsigned char)((uint64_t)((*m).network.signal) << 6);
+    s[56] = (unsigned char)((uint64_t)((*m).network.signal) << 6 >> 8) & 3;
+    s[56] |= (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2);
+    s[57] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 8);
+    s[58] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 16);
+    s[59] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 24);
+    s[60] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 32) & 3;
     s[60] |= (((unsigned char *)&((*m).landing_gear.status))[0] << 2) & 12;
-    s[60] |= (((unsigned char *)&((*m).pressure_sensor.pressures[0]))[0] << 4) & 240;
-    s[61] = (((unsigned char *)&((*m).pressure_sensor.pressures[0]))[0] >> 4) & 15;
-    s[61] |= (((unsigned char *)&((*m).pressure_sensor.pressures[0]))[1] << 4) & 240;
-    s[62] = (((unsigned char *)&((*m).pressure_sensor.pressures[0]))[1] >> 4) & 15;
-    s[62] |= (((unsigned char *)&((*m).pressure_sensor.pressures[0]))[2] << 4) & 240;
-    s[63] = (((unsigned char *)&((*m).pressure_sensor.pressures[0]))[2] >> 4) & 15;
-    s[63] |= (((unsigned char *)&((*m).pressure_sensor.pressures[1]))[0] << 4) & 240;
-    s[64] = (((unsigned char *)&((*m).pressure_sensor.pressures[1]))[0] >> 4) & 15;
-    s[64] |= (((unsigned char *)&((*m).pressure_sensor.pressures[1]))[1] << 4) & 240;
-    s[65] = (((unsigned char *)&((*m).pressure_sensor.pressures[1]))[1] >> 4) & 15;
-    s[65] |= (((unsigned char *)&((*m).pressure_sensor.pressures[1]))[2] << 4) & 240;
-    s[66] = (((unsigned char *)&((*m).pressure_sensor.pressures[1]))[2] >> 4) & 15;
+    s[60] |= (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4);
+    s[61] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4 >> 8);
+    s[62] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4 >> 16);
+    s[63] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4 >> 24) & 15;
+    s[63] |= (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4);
+    s[64] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4 >> 8);
+    s[65] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4 >> 16);
+    s[66] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4 >> 24) & 15;
+    BP_TRACE_END("Drone", BP_TRACE_ENCODE, BYTES_LENGTH_DRONE);
     return 0;
 }
 
-int DecodeDrone(struct Drone *m, unsigned char *s) {
+int DecodeDrone(struct Drone *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Drone", BP_TRACE_DECODE, BYTES_LENGTH_DRONE);
     ((unsigned char *)&((*m).status))[0] = (s[0] ) & 7;
-    ((unsigned char *)&((*m).position.latitude))[0] = (s[0] >> 3) & 31;
-    ((unsigned char *)&((*m).position.latitude))[0] |= (s[1] << 5) & 224;
-    ((unsigned char *)&((*m).position.latitude))[1] = (s[1] >> 3) & 31;
-    ((unsigned char *)&((*m).position.latitude))[1] |= (s[2] << 5) & 224;
-    ((unsigned char *)&((*m).position.latitude))[2] = (s[2] >> 3) & 31;
-    ((unsigned char *)&((*m).position.latitude))[2] |= (s[3] << 5) & 224;
-    ((unsigned char *)&((*m).position.latitude))[3] = (s[3] >> 3) & 31;
-    ((unsigned char *)&((*m).position.latitude))[3] |= (s[4] << 5) & 224;
-    ((unsigned char *)&((*m).position.longitude))[0] = (s[4] >> 3) & 31;
-    ((unsigned char *)&((*m).position.longitude))[0] |= (s[5] << 5) & 224;
-    ((unsigned char *)&((*m).position.longitude))[1] = (s[5] >> 3) & 31;
-    ((unsigned char *)&((*m).position.longitude))[1] |= (s[6] << 5) & 224;
-    ((unsigned char *)&((*m).position.longitude))[2] = (s[6] >> 3) & 31;
-    ((unsigned char *)&((*m).position.longitude))[2] |= (s[7] << 5) & 224;
-    ((unsigned char *)&((*m).position.longitude))[3] = (s[7] >> 3) & 31;
-    ((unsigned char *)&((*m).position.longitude))[3] |= (s[8] << 5) & 224;
-    ((unsigned char *)&((*m).position.altitude))[0] = (s[8] >> 3) & 31;
-    ((unsigned char *)&((*m).position.altitude))[0] |= (s[9] << 5) & 224;
-    ((unsigned char *)&((*m).position.altitude))[1] = (s[9] >> 3) & 31;
-    ((unsigned char *)&((*m).position.altitude))[1] |= (s[10] << 5) & 224;
-    ((unsigned char *)&((*m).position.altitude))[2] = (s[10] >> 3) & 31;
-    ((unsigned char *)&((*m).position.altitude))[2] |= (s[11] << 5) & 224;
-    ((unsigned char *)&((*m).position.altitude))[3] = (s[11] >> 3) & 31;
-    ((unsigned char *)&((*m).position.altitude))[3] |= (s[12] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.yaw))[0] = (s[12] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.yaw))[0] |= (s[13] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.yaw))[1] = (s[13] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.yaw))[1] |= (s[14] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.yaw))[2] = (s[14] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.yaw))[2] |= (s[15] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.yaw))[3] = (s[15] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.yaw))[3] |= (s[16] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.pitch))[0] = (s[16] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.pitch))[0] |= (s[17] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.pitch))[1] = (s[17] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.pitch))[1] |= (s[18] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.pitch))[2] = (s[18] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.pitch))[2] |= (s[19] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.pitch))[3] = (s[19] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.pitch))[3] |= (s[20] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.roll))[0] = (s[20] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.roll))[0] |= (s[21] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.roll))[1] = (s[21] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.roll))[1] |= (s[22] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.roll))[2] = (s[22] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.roll))[2] |= (s[23] << 5) & 224;
-    ((unsigned char *)&((*m).flight.pose.roll))[3] = (s[23] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.pose.roll))[3] |= (s[24] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[0]))[0] = (s[24] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[0]))[0] |= (s[25] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[0]))[1] = (s[25] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[0]))[1] |= (s[26] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[0]))[2] = (s[26] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[0]))[2] |= (s[27] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[0]))[3] = (s[27] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[0]))[3] |= (s[28] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[1]))[0] = (s[28] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[1]))[0] |= (s[29] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[1]))[1] = (s[29] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[1]))[1] |= (s[30] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[1]))[2] = (s[30] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[1]))[2] |= (s[31] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[1]))[3] = (s[31] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[1]))[3] |= (s[32] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[2]))[0] = (s[32] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[2]))[0] |= (s[33] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[2]))[1] = (s[33] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[2]))[1] |= (s[34] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[2]))[2] = (s[34] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[2]))[2] |= (s[35] << 5) & 224;
-    ((unsigned char *)&((*m).flight.velocity[2]))[3] = (s[35] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.velocity[2]))[3] |= (s[36] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[0] = (s[36] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[0] |= (s[37] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[1] = (s[37] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[1] |= (s[38] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[2] = (s[38] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[2] |= (s[39] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[3] = (s[39] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[0]))[3] |= (s[40] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[0] = (s[40] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[0] |= (s[41] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[1] = (s[41] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[1] |= (s[42] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[2] = (s[42] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[2] |= (s[43] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[3] = (s[43] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[1]))[3] |= (s[44] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[0] = (s[44] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[0] |= (s[45] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[1] = (s[45] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[1] |= (s[46] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[2] = (s[46] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[2] |= (s[47] << 5) & 224;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[3] = (s[47] >> 3) & 31;
-    ((unsigned char *)&((*m).flight.acceleration[2]))[3] |= (s[48] << 5) & 224;
-    ((unsigned char *)&((*m).propellers[0].id))[0] = (s[48] >> 3) & 31;
-    ((unsigned char *)&((*m).propellers[0].id))[0] |= (s[49] << 5) & 224;
+    (*m).position.latitude = (uint32_t)((((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24 | (uint64_t)s[4] << 32) >> 3) & 4294967295);
+    (*m).position.longitude = (uint32_t)((((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24 | (uint64_t)s[8] << 32) >> 3) & 4294967295);
+    (*m).position.altitude = (uint32_t)((((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24 | (uint64_t)s[12] << 32) >> 3) & 4294967295);
+    (*m).flight.pose.yaw = (int32_t)((((uint64_t)s[12] | (uint64_t)s[13] << 8 | (uint64_t)s[14] << 16 | (uint64_t)s[15] << 24 | (uint64_t)s[16] << 32) >> 3) & 4294967295);
+    (*m).flight.pose.pitch = (int32_t)((((uint64_t)s[16] | (uint64_t)s[17] << 8 | (uint64_t)s[18] << 16 | (uint64_t)s[19] << 24 | (uint64_t)s[20] << 32) >> 3) & 4294967295);
+    (*m).flight.pose.roll = (int32_t)((((uint64_t)s[20] | (uint64_t)s[21] << 8 | (uint64_t)s[22] << 16 | (uint64_t)s[23] << 24 | (uint64_t)s[24] << 32) >> 3) & 4294967295);
+    (*m).flight.velocity[0] = (int32_t)((((uint64_t)s[24] | (uint64_t)s[25] << 8 | (uint64_t)s[26] << 16 | (uint64_t)s[27] << 24 | (uint64_t)s[28] << 32) >> 3) & 4294967295);
+    (*m).flight.velocity[1] = (int32_t)((((uint64_t)s[28] | (uint64_t)s[29] << 8 | (uint64_t)s[30] << 16 | (uint64_t)s[31] << 24 | (uint64_t)s[32] << 32) >> 3) & 4294967295);
+    (*m).flight.velocity[2] = (int32_t)((((uint64_t)s[32] | (uint64_t)s[33] << 8 | (uint64_t)s[34] << 16 | (uint64_t)s[35] << 24 | (uint64_t)s[36] << 32) >> 3) & 4294967295);
+    (*m).flight.acceleration[0] = (int32_t)((((uint64_t)s[36] | (uint64_t)s[37] << 8 | (uint64_t)s[38] << 16 | (uint64_t)s[39] << 24 | (uint64_t)s[40] << 32) >> 3) & 4294967295);
+    (*m).flight.acceleration[1] = (int32_t)((((uint64_t)s[40] | (uint64_t)s[41] << 8 | (uint64_t)s[42] << 16 | (uint64_t)s[43] << 24 | (uint64_t)s[44] << 32) >> 3) & 4294967295);
+    (*m).flight.acceleration[2] = (int32_t)((((uint64_t)s[44] | (uint64_t)s[45] << 8 | (uint64_t)s[46] << 16 | (uint64_t)s[47] << 24 | (uint64_t)s[48] << 32) >> 3) & 4294967295);
+    (*m).propellers[0].id = (uint8_t)((((uint64_t)s[48] | (uint64_t)s[49] << 8) >> 3) & 255);
     ((unsigned char *)&((*m).propellers[0].status))[0] = (s[49] >> 3) & 3;
     ((unsigned char *)&((*m).propellers[0].direction))[0] = (s[49] >> 5) & 3;
-    ((unsigned char *)&((*m).propellers[1].id))[0] = (s[49] >> 7) & 1;
-    ((unsigned char *)&((*m).propellers[1].id))[0] |= (s[50] << 1) & 254;
-    ((unsigned char *)&((*m).propellers[1].status))[0] = (s[50] >> 7) & 1;
-    ((unsigned char *)&((*m).propellers[1].status))[0] |= (s[51] << 1) & 2;
+    (*m).propellers[1].id = (uint8_t)((((uint64_t)s[49] | (uint64_t)s[50] << 8) >> 7) & 255);
+    (*m).propellers[1].status = (PropellerStatus)((((uint64_t)s[50] | (uint64_t)s[51] << 8) >> 7) & 3);
     ((unsigned char *)&((*m).propellers[1].direction))[0] = (s[51] >> 1) & 3;
-    ((unsigned char *)&((*m).propellers[2].id))[0] = (s[51] >> 3) & 31;
-    ((unsigned char *)&((*m).propellers[2].id))[0] |= (s[52] << 5) & 224;
+    (*m).propellers[2].id = (uint8_t)((((uint64_t)s[51] | (uint64_t)s[52] << 8) >> 3) & 255);
     ((unsigned char *)&((*m).propellers[2].status))[0] = (s[52] >> 3) & 3;
     ((unsigned char *)&((*m).propellers[2].direction))[0] = (s[52] >> 5) & 3;
-    ((unsigned char *)&((*m).propellers[3].id))[0] = (s[52] >> 7) & 1;
-    ((unsigned char *)&((*m).propellers[3].id))[0] |= (s[53] << 1) & 254;
-    ((unsigned char *)&((*m).propellers[3].status))[0] = (s[53] >> 7) & 1;
-    ((unsigned char *)&((*m).propellers[3].status))[0] |= (s[54] << 1) & 2;
+    (*m).propellers[3].id = (uint8_t)((((uint64_t)s[52] | (uint64_t)s[53] << 8) >> 7) & 255);
+    (*m).propellers[3].status = (PropellerStatus)((((uint64_t)s[53] | (uint64_t)s[54] << 8) >> 7) & 3);
     ((unsigned char *)&((*m).propellers[3].direction))[0] = (s[54] >> 1) & 3;
-    ((unsigned char *)&((*m).power.battery))[0] = (s[54] >> 3) & 31;
-    ((unsigned char *)&((*m).power.battery))[0] |= (s[55] << 5) & 224;
+    (*m).power.battery = (uint8_t)((((uint64_t)s[54] | (uint64_t)s[55] << 8) >> 3) & 255);
     ((unsigned char *)&((*m).power.status))[0] = (s[55] >> 3) & 3;
     ((unsigned char *)&((*m).power.is_charging))[0] = (s[55] >> 5) & 1;
-    ((unsigned char *)&((*m).network.signal))[0] = (s[55] >> 6) & 3;
-    ((unsigned char *)&((*m).network.signal))[0] |= (s[56] << 2) & 12;
-    ((unsigned char *)&((*m).network.heartbeat_at))[0] = (s[56] >> 2) & 63;
-    ((unsigned char *)&((*m).network.heartbeat_at))[0] |= (s[57] << 6) & 192;
-    ((unsigned char *)&((*m).network.heartbeat_at))[1] = (s[57] >> 2) & 63;
-    ((unsigned char *)&((*m).network.heartbeat_at))[1] |= (s[58] << 6) & 192;
-    ((unsigned char *)&((*m).network.heartbeat_at))[2] = (s[58] >> 2) & 63;
-    ((unsigned char *)&((*m).network.heartbeat_at))[2] |= (s[59] << 6) & 192;
-    ((unsigned char *)&((*m).network.heartbeat_at))[3] = (s[59] >> 2) & 63;
-    ((unsigned char *)&((*m).network.heartbeat_at))[3] |= (s[60] << 6) & 192;
+    (*m).network.signal = (uint8_t)((((uint64_t)s[55] | (uint64_t)s[56] << 8) >> 6) & 15);
+    (*m).network.heartbeat_at = (Timestamp)((((uint64_t)s[56] | (uint64_t)s[57] << 8 | (uint64_t)s[58] << 16 | (uint64_t)s[59] << 24 | (uint64_t)s[60] << 32) >> 2) & 4294967295);
     ((unsigned char *)&((*m).landing_gear.status))[0] = (s[60] >> 2) & 3;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[0]))[0] = (s[60] >> 4) & 15;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[0]))[0] |= (s[61] << 4) & 240;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[0]))[1] = (s[61] >> 4) & 15;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[0]))[1] |= (s[62] << 4) & 240;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[0]))[2] = (s[62] >> 4) & 15;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[0]))[2] |= (s[63] << 4) & 240;
-    if (((*m).pressure_sensor.pressures[0] >> 23) & 1) (*m).pressure_sensor.pressures[0] |= -16777216;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[1]))[0] = (s[63] >> 4) & 15;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[1]))[0] |= (s[64] << 4) & 240;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[1]))[1] = (s[64] >> 4) & 15;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[1]))[1] |= (s[65] << 4) & 240;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[1]))[2] = (s[65] >> 4) & 15;
-    ((unsigned char *)&((*m).pressure_sensor.pressures[1]))[2] |= (s[66] << 4) & 240;
-    if (((*m).pressure_sensor.pressures[1] >> 23) & 1) (*m).pressure_sensor.pressures[1] |= -16777216;
+    (*m).pressure_sensor.pressures[0] = (int32_t)((((uint64_t)s[60] | (uint64_t)s[61] << 8 | (uint64_t)s[62] << 16 | (uint64_t)s[63] << 24) >> 4) & 16777215);
+    (*m).pressure_sensor.pressures[1] = (int32_t)((((uint64_t)s[63] | (uint64_t)s[64] << 8 | (uint64_t)s[65] << 16 | (uint64_t)s[66] << 24) >> 4) & 16777215);
+    for (int k = 0; k < 2; k++) (*m).pressure_sensor.pressures[k] = (int32_t)((int64_t)(((uint64_t)((*m).pressure_sensor.pressures[k]) & 16777215ULL) ^ 8388608ULL) - 8388608LL);
+    BP_TRACE_END("Drone", BP_TRACE_DECODE, BYTES_LENGTH_DRONE);
+    return 0;
+}
+
+int DecodeDroneN(struct Drone *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_DRONE) return BP_ERR_SHORT_INPUT;
+    return DecodeDrone(m, s);
+}
+
+int DecodeDroneMasked(struct Drone *m, const unsigned char *s, uint64_t mask) {
+    if (mask & FIELD_MASK_DRONE_STATUS) {
+        ((unsigned char *)&((*m).status))[0] = (s[0] ) & 7;
+    }
+    if (mask & FIELD_MASK_DRONE_POSITION) {
+        (*m).position.latitude = (uint32_t)((((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24 | (uint64_t)s[4] << 32) >> 3) & 4294967295);
+        (*m).position.longitude = (uint32_t)((((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24 | (uint64_t)s[8] << 32) >> 3) & 4294967295);
+        (*m).position.altitude = (uint32_t)((((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24 | (uint64_t)s[12] << 32) >> 3) & 4294967295);
+    }
+    if (mask & FIELD_MASK_DRONE_FLIGHT) {
+        (*m).flight.pose.yaw = (int32_t)((((uint64_t)s[12] | (uint64_t)s[13] << 8 | (uint64_t)s[14] << 16 | (uint64_t)s[15] << 24 | (uint64_t)s[16] << 32) >> 3) & 4294967295);
+        (*m).flight.pose.pitch = (int32_t)((((uint64_t)s[16] | (uint64_t)s[17] << 8 | (uint64_t)s[18] << 16 | (uint64_t)s[19] << 24 | (uint64_t)s[20] << 32) >> 3) & 4294967295);
+        (*m).flight.pose.roll = (int32_t)((((uint64_t)s[20] | (uint64_t)s[21] << 8 | (uint64_t)s[22] << 16 | (uint64_t)s[23] << 24 | (uint64_t)s[24] << 32) >> 3) & 4294967295);
+        (*m).flight.velocity[0] = (int32_t)((((uint64_t)s[24] | (uint64_t)s[25] << 8 | (uint64_t)s[26] << 16 | (uint64_t)s[27] << 24 | (uint64_t)s[28] << 32) >> 3) & 4294967295);
+        (*m).flight.velocity[1] = (int32_t)((((uint64_t)s[28] | (uint64_t)s[29] << 8 | (uint64_t)s[30] << 16 | (uint64_t)s[31] << 24 | (uint64_t)s[32] << 32) >> 3) & 4294967295);
+        (*m).flight.velocity[2] = (int32_t)((((uint64_t)s[32] | (uint64_t)s[33] << 8 | (uint64_t)s[34] << 16 | (uint64_t)s[35] << 24 | (uint64_t)s[36] << 32) >> 3) & 4294967295);
+        (*m).flight.acceleration[0] = (int32_t)((((uint64_t)s[36] | (uint64_t)s[37] << 8 | (uint64_t)s[38] << 16 | (uint64_t)s[39] << 24 | (uint64_t)s[40] << 32) >> 3) & 4294967295);
+        (*m).flight.acceleration[1] = (int32_t)((((uint64_t)s[40] | (uint64_t)s[41] << 8 | (uint64_t)s[42] << 16 | (uint64_t)s[43] << 24 | (uint64_t)s[44] << 32) >> 3) & 4294967295);
+        (*m).flight.acceleration[2] = (int32_t)((((uint64_t)s[44] | (uint64_t)s[45] << 8 | (uint64_t)s[46] << 16 | (uint64_t)s[47] << 24 | (uint64_t)s[48] << 32) >> 3) & 4294967295);
+    }
+    if (mask & FIELD_MASK_DRONE_PROPELLERS) {
+        (*m).propellers[0].id = (uint8_t)((((uint64_t)s[48] | (uint64_t)s[49] << 8) >> 3) & 255);
+        ((unsigned char *)&((*m).propellers[0].status))[0] = (s[49] >> 3) & 3;
+        ((unsigned char *)&((*m).propellers[0].direction))[0] = (s[49] >> 5) & 3;
+        (*m).propellers[1].id = (uint8_t)((((uint64_t)s[49] | (uint64_t)s[50] << 8) >> 7) & 255);
+        (*m).propellers[1].status = (PropellerStatus)((((uint64_t)s[50] | (uint64_t)s[51] << 8) >> 7) & 3);
+        ((unsigned char *)&((*m).propellers[1].direction))[0] = (s[51] >> 1) & 3;
+        (*m).propellers[2].id = (uint8_t)((((uint64_t)s[51] | (uint64_t)s[52] << 8) >> 3) & 255);
+        ((unsigned char *)&((*m).propellers[2].status))[0] = (s[52] >> 3) & 3;
+        ((unsigned char *)&((*m).propellers[2].direction))[0] = (s[52] >> 5) & 3;
+        (*m).propellers[3].id = (uint8_t)((((uint64_t)s[52] | (uint64_t)s[53] << 8) >> 7) & 255);
+        (*m).propellers[3].status = (PropellerStatus)((((uint64_t)s[53] | (uint64_t)s[54] << 8) >> 7) & 3);
+        ((unsigned char *)&((*m).propellers[3].direction))[0] = (s[54] >> 1) & 3;
+    }
+    if (mask & FIELD_MASK_DRONE_POWER) {
+        (*m).power.battery = (uint8_t)((((uint64_t)s[54] | (uint64_t)s[55] << 8) >> 3) & 255);
+        ((unsigned char *)&((*m).power.status))[0] = (s[55] >> 3) & 3;
+        ((unsigned char *)&((*m).power.is_charging))[0] = (s[55] >> 5) & 1;
+    }
+    if (mask & FIELD_MASK_DRONE_NETWORK) {
+        (*m).network.signal = (uint8_t)((((uint64_t)s[55] | (uint64_t)s[56] << 8) >> 6) & 15);
+        (*m).network.heartbeat_at = (Timestamp)((((uint64_t)s[56] | (uint64_t)s[57] << 8 | (uint64_t)s[58] << 16 | (uint64_t)s[59] << 24 | (uint64_t)s[60] << 32) >> 2) & 4294967295);
+    }
+    if (mask & FIELD_MASK_DRONE_LANDING_GEAR) {
+        ((unsigned char *)&((*m).landing_gear.status))[0] = (s[60] >> 2) & 3;
+    }
+    if (mask & FIELD_MASK_DRONE_PRESSURE_SENSOR) {
+        (*m).pressure_sensor.pressures[0] = (int32_t)((((uint64_t)s[60] | (uint64_t)s[61] << 8 | (uint64_t)s[62] << 16 | (uint64_t)s[63] << 24) >> 4) & 16777215);
+        (*m).pressure_sensor.pressures[1] = (int32_t)((((uint64_t)s[63] | (uint64_t)s[64] << 8 | (uint64_t)s[65] << 16 | (uint64_t)s[66] << 24) >> 4) & 16777215);
+        for (int k = 0; k < 2; k++) (*m).pressure_sensor.pressures[k] = (int32_t)((int64_t)(((uint64_t)((*m).pressure_sensor.pressures[k]) & 16777215ULL) ^ 8388608ULL) - 8388608LL);
+    }
+    return 0;
+}
+
+int EncodeDroneBatch(const struct Drone *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    for (size_t k = 0; k < count; k++, s += BYTES_LENGTH_DRONE) {
+        const struct Drone *m = &ms[k];
+        s[0] = (((unsigned char *)&((*m).status))[0] ) & 7;
+        s[0] |= (unsigned char)((uint64_t)((*m).position.latitude) << 3);
+        s[1] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 8);
+        s[2] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 16);
+        s[3] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 24);
+        s[4] = (unsigned char)((uint64_t)((*m).position.latitude) << 3 >> 32) & 7;
+        s[4] |= (unsigned char)((uint64_t)((*m).position.longitude) << 3);
+        s[5] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 8);
+        s[6] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 16);
+        s[7] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 24);
+        s[8] = (unsigned char)((uint64_t)((*m).position.longitude) << 3 >> 32) & 7;
+        s[8] |= (unsigned char)((uint64_t)((*m).position.altitude) << 3);
+        s[9] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 8);
+        s[10] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 16);
+        s[11] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 24);
+        s[12] = (unsigned char)((uint64_t)((*m).position.altitude) << 3 >> 32) & 7;
+        s[12] |= (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3);
+        s[13] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 8);
+        s[14] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 16);
+        s[15] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 24);
+        s[16] = (unsigned char)((uint64_t)((*m).flight.pose.yaw) << 3 >> 32) & 7;
+        s[16] |= (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3);
+        s[17] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 8);
+        s[18] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 16);
+        s[19] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 24);
+        s[20] = (unsigned char)((uint64_t)((*m).flight.pose.pitch) << 3 >> 32) & 7;
+        s[20] |= (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3);
+        s[21] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 8);
+        s[22] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 16);
+        s[23] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 24);
+        s[24] = (unsigned char)((uint64_t)((*m).flight.pose.roll) << 3 >> 32) & 7;
+        s[24] |= (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3);
+        s[25] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 8);
+        s[26] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 16);
+        s[27] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 24);
+        s[28] = (unsigned char)((uint64_t)((*m).flight.velocity[0]) << 3 >> 32) & 7;
+        s[28] |= (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3);
+        s[29] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 8);
+        s[30] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 16);
+        s[31] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 24);
+        s[32] = (unsigned char)((uint64_t)((*m).flight.velocity[1]) << 3 >> 32) & 7;
+        s[32] |= (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3);
+        s[33] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 8);
+        s[34] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 16);
+        s[35] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 24);
+        s[36] = (unsigned char)((uint64_t)((*m).flight.velocity[2]) << 3 >> 32) & 7;
+        s[36] |= (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3);
+        s[37] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 8);
+        s[38] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 16);
+        s[39] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 24);
+        s[40] = (unsigned char)((uint64_t)((*m).flight.acceleration[0]) << 3 >> 32) & 7;
+        s[40] |= (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3);
+        s[41] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 8);
+        s[42] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 16);
+        s[43] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 24);
+        s[44] = (unsigned char)((uint64_t)((*m).flight.acceleration[1]) << 3 >> 32) & 7;
+        s[44] |= (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3);
+        s[45] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 8);
+        s[46] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 16);
+        s[47] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 24);
+        s[48] = (unsigned char)((uint64_t)((*m).flight.acceleration[2]) << 3 >> 32) & 7;
+        s[48] |= (unsigned char)((uint64_t)((*m).propellers[0].id) << 3);
+        s[49] = (unsigned char)((uint64_t)((*m).propellers[0].id) << 3 >> 8) & 7;
+        s[49] |= (((unsigned char *)&((*m).propellers[0].status))[0] << 3) & 24;
+        s[49] |= (((unsigned char *)&((*m).propellers[0].direction))[0] << 5) & 96;
+        s[49] |= (unsigned char)((uint64_t)((*m).propellers[1].id) << 7);
+        s[50] = (unsigned char)((uint64_t)((*m).propellers[1].id) << 7 >> 8) & 127;
+        s[50] |= (unsigned char)((uint64_t)((*m).propellers[1].status) << 7);
+        s[51] = (unsigned char)((uint64_t)((*m).propellers[1].status) << 7 >> 8) & 1;
+        s[51] |= (((unsigned char *)&((*m).propellers[1].direction))[0] << 1) & 6;
+        s[51] |= (unsigned char)((uint64_t)((*m).propellers[2].id) << 3);
+        s[52] = (unsigned char)((uint64_t)((*m).propellers[2].id) << 3 >> 8) & 7;
+        s[52] |= (((unsigned char *)&((*m).propellers[2].status))[0] << 3) & 24;
+        s[52] |= (((unsigned char *)&((*m).propellers[2].direction))[0] << 5) & 96;
+        s[52] |= (unsigned char)((uint64_t)((*m).propellers[3].id) << 7);
+        s[53] = (unsigned char)((uint64_t)((*m).propellers[3].id) << 7 >> 8) & 127;
+        s[53] |= (unsigned char)((uint64_t)((*m).propellers[3].status) << 7);
+        s[54] = (unsigned char)((uint64_t)((*m).propellers[3].status) << 7 >> 8) & 1;
+        s[54] |= (((unsigned char *)&((*m).propellers[3].direction))[0] << 1) & 6;
+        s[54] |= (unsigned char)((uint64_t)((*m).power.battery) << 3);
+        s[55] = (unsigned char)((uint64_t)((*m).power.battery) << 3 >> 8) & 7;
+        s[55] |= (((unsigned char *)&((*m).power.status))[0] << 3) & 24;
+        s[55] |= (((unsigned char *)&((*m).power.is_charging))[0] << 5) & 32;
+        s[55] |= (unsigned char)((uint64_t)((*m).network.signal) << 6);
+        s[56] = (unsigned char)((uint64_t)((*m).network.signal) << 6 >> 8) & 3;
+        s[56] |= (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2);
+        s[57] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 8);
+        s[58] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 16);
+        s[59] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 24);
+        s[60] = (unsigned char)((uint64_t)((*m).network.heartbeat_at) << 2 >> 32) & 3;
+        s[60] |= (((unsigned char *)&((*m).landing_gear.status))[0] << 2) & 12;
+        s[60] |= (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4);
+        s[61] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4 >> 8);
+        s[62] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4 >> 16);
+        s[63] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[0]) << 4 >> 24) & 15;
+        s[63] |= (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4);
+        s[64] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4 >> 8);
+        s[65] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4 >> 16);
+        s[66] = (unsigned char)((uint64_t)((*m).pressure_sensor.pressures[1]) << 4 >> 24) & 15;
+    }
+    return 0;
+}
+
+int DecodeDroneBatch(struct Drone *ms, size_t count, const unsigned char *s) {
+    for (size_t k = 0; k < count; k++, s += BYTES_LENGTH_DRONE) {
+        struct Drone *m = &ms[k];
+        ((unsigned char *)&((*m).status))[0] = (s[0] ) & 7;
+        (*m).position.latitude = (uint32_t)((((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24 | (uint64_t)s[4] << 32) >> 3) & 4294967295);
+        (*m).position.longitude = (uint32_t)((((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24 | (uint64_t)s[8] << 32) >> 3) & 4294967295);
+        (*m).position.altitude = (uint32_t)((((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24 | (uint64_t)s[12] << 32) >> 3) & 4294967295);
+        (*m).flight.pose.yaw = (int32_t)((((uint64_t)s[12] | (uint64_t)s[13] << 8 | (uint64_t)s[14] << 16 | (uint64_t)s[15] << 24 | (uint64_t)s[16] << 32) >> 3) & 4294967295);
+        (*m).flight.pose.pitch = (int32_t)((((uint64_t)s[16] | (uint64_t)s[17] << 8 | (uint64_t)s[18] << 16 | (uint64_t)s[19] << 24 | (uint64_t)s[20] << 32) >> 3) & 4294967295);
+        (*m).flight.pose.roll = (int32_t)((((uint64_t)s[20] | (uint64_t)s[21] << 8 | (uint64_t)s[22] << 16 | (uint64_t)s[23] << 24 | (uint64_t)s[24] << 32) >> 3) & 4294967295);
+        (*m).flight.velocity[0] = (int32_t)((((uint64_t)s[24] | (uint64_t)s[25] << 8 | (uint64_t)s[26] << 16 | (uint64_t)s[27] << 24 | (uint64_t)s[28] << 32) >> 3) & 4294967295);
+        (*m).flight.velocity[1] = (int32_t)((((uint64_t)s[28] | (uint64_t)s[29] << 8 | (uint64_t)s[30] << 16 | (uint64_t)s[31] << 24 | (uint64_t)s[32] << 32) >> 3) & 4294967295);
+        (*m).flight.velocity[2] = (int32_t)((((uint64_t)s[32] | (uint64_t)s[33] << 8 | (uint64_t)s[34] << 16 | (uint64_t)s[35] << 24 | (uint64_t)s[36] << 32) >> 3) & 4294967295);
+        (*m).flight.acceleration[0] = (int32_t)((((uint64_t)s[36] | (uint64_t)s[37] << 8 | (uint64_t)s[38] << 16 | (uint64_t)s[39] << 24 | (uint64_t)s[40] << 32) >> 3) & 4294967295);
+        (*m).flight.acceleration[1] = (int32_t)((((uint64_t)s[40] | (uint64_t)s[41] << 8 | (uint64_t)s[42] << 16 | (uint64_t)s[43] << 24 | (uint64_t)s[44] << 32) >> 3) & 4294967295);
+        (*m).flight.acceleration[2] = (int32_t)((((uint64_t)s[44] | (uint64_t)s[45] << 8 | (uint64_t)s[46] << 16 | (uint64_t)s[47] << 24 | (uint64_t)s[48] << 32) >> 3) & 4294967295);
+        (*m).propellers[0].id = (uint8_t)((((uint64_t)s[48] | (uint64_t)s[49] << 8) >> 3) & 255);
+        ((unsigned char *)&((*m).propellers[0].status))[0] = (s[49] >> 3) & 3;
+        ((unsigned char *)&((*m).propellers[0].direction))[0] = (s[49] >> 5) & 3;
+        (*m).propellers[1].id = (uint8_t)((((uint64_t)s[49] | (uint64_t)s[50] << 8) >> 7) & 255);
+        (*m).propellers[1].status = (PropellerStatus)((((uint64_t)s[50] | (uint64_t)s[51] << 8) >> 7) & 3);
+        ((unsigned char *)&((*m).propellers[1].direction))[0] = (s[51] >> 1) & 3;
+        (*m).propellers[2].id = (uint8_t)((((uint64_t)s[51] | (uint64_t)s[52] << 8) >> 3) & 255);
+        ((unsigned char *)&((*m).propellers[2].status))[0] = (s[52] >> 3) & 3;
+        ((unsigned char *)&((*m).propellers[2].direction))[0] = (s[52] >> 5) & 3;
+        (*m).propellers[3].id = (uint8_t)((((uint64_t)s[52] | (uint64_t)s[53] << 8) >> 7) & 255);
+        (*m).propellers[3].status = (PropellerStatus)((((uint64_t)s[53] | (uint64_t)s[54] << 8) >> 7) & 3);
+        ((unsigned char *)&((*m).propellers[3].direction))[0] = (s[54] >> 1) & 3;
+        (*m).power.battery = (uint8_t)((((uint64_t)s[54] | (uint64_t)s[55] << 8) >> 3) & 255);
+        ((unsigned char *)&((*m).power.status))[0] = (s[55] >> 3) & 3;
+        ((unsigned char *)&((*m).power.is_charging))[0] = (s[55] >> 5) & 1;
+        (*m).network.signal = (uint8_t)((((uint64_t)s[55] | (uint64_t)s[56] << 8) >> 6) & 15);
+        (*m).network.heartbeat_at = (Timestamp)((((uint64_t)s[56] | (uint64_t)s[57] << 8 | (uint64_t)s[58] << 16 | (uint64_t)s[59] << 24 | (uint64_t)s[60] << 32) >> 2) & 4294967295);
+        ((unsigned char *)&((*m).landing_gear.status))[0] = (s[60] >> 2) & 3;
+        (*m).pressure_sensor.pressures[0] = (int32_t)((((uint64_t)s[60] | (uint64_t)s[61] << 8 | (uint64_t)s[62] << 16 | (uint64_t)s[63] << 24) >> 4) & 16777215);
+        (*m).pressure_sensor.pressures[1] = (int32_t)((((uint64_t)s[63] | (uint64_t)s[64] << 8 | (uint64_t)s[65] << 16 | (uint64_t)s[66] << 24) >> 4) & 16777215);
+        for (int k = 0; k < 2; k++) (*m).pressure_sensor.pressures[k] = (int32_t)((int64_t)(((uint64_t)((*m).pressure_sensor.pressures[k]) & 16777215ULL) ^ 8388608ULL) - 8388608LL);
+    }
     return 0;
+}
+
+uint64_t HashDrone(const struct Drone *m) {
+    uint64_t h = BP_HASH_INIT;
+    BP_HASH_MIX(h, ((uint64_t)((*m).status) & 7ULL));
+    for (int j = 0; j < 48; j += 8) {
+        uint64_t w;
+        memcpy(&w, (const unsigned char *)(&((*m).position)) + j, 8);
+        BP_HASH_MIX(h, w);
+    }
+    for (int k0 = 0; k0 < 4; k0++) {
+        BP_HASH_MIX(h, (uint64_t)((*m).propellers[k0].id));
+        BP_HASH_MIX(h, ((uint64_t)((*m).propellers[k0].status) & 3ULL));
+        BP_HASH_MIX(h, ((uint64_t)((*m).propellers[k0].direction) & 3ULL));
+    }
+    BP_HASH_MIX(h, (uint64_t)((*m).power.battery));
+    BP_HASH_MIX(h, ((uint64_t)((*m).power.status) & 3ULL));
+    BP_HASH_MIX(h, (uint64_t)((*m).power.is_charging));
+    BP_HASH_MIX(h, ((uint64_t)((*m).network.signal) & 15ULL));
+    BP_HASH_MIX(h, (uint64_t)((*m).network.heartbeat_at));
+    BP_HASH_MIX(h, ((uint64_t)((*m).landing_gear.status) & 3ULL));
+    for (int k0 = 0; k0 < 2; k0++) {
+        BP_HASH_MIX(h, ((uint64_t)((*m).pressure_sensor.pressures[k0]) & 16777215ULL));
+    }
+    return h;
+}
+
+bool EqualDrone(const struct Drone *a, const struct Drone *b) {
+    if (((uint64_t)((*a).status) & 7ULL) != ((uint64_t)((*b).status) & 7ULL)) return false;
+    if (memcmp(&((*a).position), &((*b).position), 48) != 0) return false;
+    for (int k0 = 0; k0 < 4; k0++) {
+        if ((uint64_t)((*a).propellers[k0].id) != (uint64_t)((*b).propellers[k0].id)) return false;
+        if (((uint64_t)((*a).propellers[k0].status) & 3ULL) != ((uint64_t)((*b).propellers[k0].status) & 3ULL)) return false;
+        if (((uint64_t)((*a).propellers[k0].direction) & 3ULL) != ((uint64_t)((*b).propellers[k0].direction) & 3ULL)) return false;
+    }
+    if ((uint64_t)((*a).power.battery) != (uint64_t)((*b).power.battery)) return false;
+    if (((uint64_t)((*a).power.status) & 3ULL) != ((uint64_t)((*b).power.status) & 3ULL)) return false;
+    if ((uint64_t)((*a).power.is_charging) != (uint64_t)((*b).power.is_charging)) return false;
+    if (((uint64_t)((*a).network.signal) & 15ULL) != ((uint64_t)((*b).network.signal) & 15ULL)) return false;
+    if ((uint64_t)((*a).network.heartbeat_at) != (uint64_t)((*b).network.heartbeat_at)) return false;
+    if (((uint64_t)((*a).landing_gear.status) & 3ULL) != ((uint64_t)((*b).landing_gear.status) & 3ULL)) return false;
+    for (int k0 = 0; k0 < 2; k0++) {
+        if (((uint64_t)((*a).pressure_sensor.pressures[k0]) & 16777215ULL) != ((uint64_t)((*b).pressure_sensor.pressures[k0]) & 16777215ULL)) return false;
+    }
+    return true;
 }
\ No newline at end of file
@@ -18,6 +18,59 @@ extern "C" {
 
 #define BITPROTO_OPTIMIZATION_MODE 1
 
+#ifndef BP_BIG_ENDIAN
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) || \
+    defined(__BIG_ENDIAN__)
+#define BP_BIG_ENDIAN 1
+#else
+#define BP_BIG_ENDIAN 0
+#endif
+#endif
+
+#ifndef BP_RESTRICT
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define BP_RESTRICT restrict
+#elif defined(__GNUC__) || defined(_MSC_VER)
+#define BP_RESTRICT __restrict
+#else
+#define BP_RESTRICT
+#endif
+#endif
+
+#ifndef BP_ERR_SHORT_INPUT
+#define BP_ERR_SHORT_INPUT -1
+#endif
+#ifndef BP_HASH_MIX
+#define BP_HASH_MIX(h, w) \
+    ((h) = ((h) ^ (uint64_t)(w)) * 0x9e3779b97f4a7c15ULL, (h) ^= (h) >> 32)
+#define BP_HASH_INIT 0xcbf29ce484222325ULL
+#define BP_FIXED_WORD(r) \
+    ((r) >= 0 ? (uint64_t)((r) + 0.5) : \
+     (r) < 0 ? (uint64_t)(int64_t)((r) - 0.5) : 0)
+#endif
+#ifndef BP_FIELD_LAYOUT
+#define BP_FIELD_LAYOUT 1
+struct BpFieldLayout {
+    const char *name;
+    int offset;
+    int nbits;
+};
+#endif
+
+#ifndef BP_TRACE_ENCODE
+#define BP_TRACE_ENCODE 0
+#define BP_TRACE_DECODE 1
+#ifdef BP_TRACE_HEADER
+#include BP_TRACE_HEADER
+#endif
+#endif
+#ifndef BP_TRACE_BEGIN
+#define BP_TRACE_BEGIN(name, dir, nbytes)
+#endif
+#ifndef BP_TRACE_END
+#define BP_TRACE_END(name, dir, nbytes)
+#endif
+
 typedef int32_t Timestamp; // 32bit
 
 typedef int32_t TernaryInt32[3]; // 96bit
@@ -56,6 +109,29 @@ typedef uint8_t LandingGearStatus; // 2bit
 
 // Number of bytes to encode struct Propeller
 #define BYTES_LENGTH_PROPELLER 2
+// Layout fingerprint of struct Propeller, to check compatibility
+#define FINGERPRINT_PROPELLER 0x1241850b2d64cf1dULL
+
+// Bit offsets and number of bits of the fields of struct Propeller
+#define BP_OFFSET_BITS_PROPELLER_ID 0
+#define BP_NBITS_PROPELLER_ID 8
+#define BP_OFFSET_BITS_PROPELLER_STATUS 8
+#define BP_NBITS_PROPELLER_STATUS 2
+#define BP_OFFSET_BITS_PROPELLER_DIRECTION 10
+#define BP_NBITS_PROPELLER_DIRECTION 2
+// Number of entries in BP_FIELDS_PROPELLER
+#define BP_NFIELDS_PROPELLER 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_PROPELLER]
+#define BP_FIELDS_PROPELLER { \
+    {"id", 0, 8}, \
+    {"status", 8, 2}, \
+    {"direction", 10, 2}, \
+}
+
+// Mask bits selecting the fields of struct Propeller in DecodePropellerMasked
+#define FIELD_MASK_PROPELLER_ID (1ULL << 0)
+#define FIELD_MASK_PROPELLER_STATUS (1ULL << 1)
+#define FIELD_MASK_PROPELLER_DIRECTION (1ULL << 2)
 
 struct Propeller {
     uint8_t id; // 8bit
@@ -65,6 +141,29 @@ struct Propeller {
 
 // Number of bytes to encode struct Power
 #define BYTES_LENGTH_POWER 2
+// Layout fingerprint of struct Power, to check compatibility
+#define FINGERPRINT_POWER 0x7f6afefbea0323acULL
+
+// Bit offsets and number of bits of the fields of struct Power
+#define BP_OFFSET_BITS_POWER_BATTERY 0
+#define BP_NBITS_POWER_BATTERY 8
+#define BP_OFFSET_BITS_POWER_STATUS 8
+#define BP_NBITS_POWER_STATUS 2
+#define BP_OFFSET_BITS_POWER_IS_CHARGING 10
+#define BP_NBITS_POWER_IS_CHARGING 1
+// Number of entries in BP_FIELDS_POWER
+#define BP_NFIELDS_POWER 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_POWER]
+#define BP_FIELDS_POWER { \
+    {"battery", 0, 8}, \
+    {"status", 8, 2}, \
+    {"is_charging", 10, 1}, \
+}
+
+// Mask bits selecting the fields of struct Power in DecodePowerMasked
+#define FIELD_MASK_POWER_BATTERY (1ULL << 0)
+#define FIELD_MASK_POWER_STATUS (1ULL << 1)
+#define FIELD_MASK_POWER_IS_CHARGING (1ULL << 2)
 
 struct Power {
     uint8_t battery; // 8bit
@@ -74,6 +173,25 @@ struct Power {
 
 // Number of bytes to encode struct Network
 #define BYTES_LENGTH_NETWORK 5
+// Layout fingerprint of struct Network, to check compatibility
+#define FINGERPRINT_NETWORK 0x1c0359e538b559ecULL
+
+// Bit offsets and number of bits of the fields of struct Network
+#define BP_OFFSET_BITS_NETWORK_SIGNAL 0
+#define BP_NBITS_NETWORK_SIGNAL 4
+#define BP_OFFSET_BITS_NETWORK_HEARTBEAT_AT 4
+#define BP_NBITS_NETWORK_HEARTBEAT_AT 32
+// Number of entries in BP_FIELDS_NETWORK
+#define BP_NFIELDS_NETWORK 2
+// Initializer of struct BpFieldLayout[BP_NFIELDS_NETWORK]
+#define BP_FIELDS_NETWORK { \
+    {"signal", 0, 4}, \
+    {"heartbeat_at", 4, 32}, \
+}
+
+// Mask bits selecting the fields of struct Network in DecodeNetworkMasked
+#define FIELD_MASK_NETWORK_SIGNAL (1ULL << 0)
+#define FIELD_MASK_NETWORK_HEARTBEAT_AT (1ULL << 1)
 
 struct Network {
     // Degree of signal, between 1~10.
@@ -84,6 +202,21 @@ struct Network {
 
 // Number of bytes to encode struct LandingGear
 #define BYTES_LENGTH_LANDING_GEAR 1
+// Layout fingerprint of struct LandingGear, to check compatibility
+#define FINGERPRINT_LANDING_GEAR 0x5121345b5280acf2ULL
+
+// Bit offsets and number of bits of the fields of struct LandingGear
+#define BP_OFFSET_BITS_LANDING_GEAR_STATUS 0
+#define BP_NBITS_LANDING_GEAR_STATUS 2
+// Number of entries in BP_FIELDS_LANDING_GEAR
+#define BP_NFIELDS_LANDING_GEAR 1
+// Initializer of struct BpFieldLayout[BP_NFIELDS_LANDING_GEAR]
+#define BP_FIELDS_LANDING_GEAR { \
+    {"status", 0, 2}, \
+}
+
+// Mask bits selecting the fields of struct LandingGear in DecodeLandingGearMasked
+#define FIELD_MASK_LANDING_GEAR_STATUS (1ULL << 0)
 
 struct LandingGear {
     LandingGearStatus status; // 2bit
@@ -91,6 +224,29 @@ struct LandingGear {
 
 // Number of bytes to encode struct Position
 #define BYTES_LENGTH_POSITION 12
+// Layout fingerprint of struct Position, to check compatibility
+#define FINGERPRINT_POSITION 0x630a402d68f5f706ULL
+
+// Bit offsets and number of bits of the fields of struct Position
+#define BP_OFFSET_BITS_POSITION_LATITUDE 0
+#define BP_NBITS_POSITION_LATITUDE 32
+#define BP_OFFSET_BITS_POSITION_LONGITUDE 32
+#define BP_NBITS_POSITION_LONGITUDE 32
+#define BP_OFFSET_BITS_POSITION_ALTITUDE 64
+#define BP_NBITS_POSITION_ALTITUDE 32
+// Number of entries in BP_FIELDS_POSITION
+#define BP_NFIELDS_POSITION 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_POSITION]
+#define BP_FIELDS_POSITION { \
+    {"latitude", 0, 32}, \
+    {"longitude", 32, 32}, \
+    {"altitude", 64, 32}, \
+}
+
+// Mask bits selecting the fields of struct Position in DecodePositionMasked
+#define FIELD_MASK_POSITION_LATITUDE (1ULL << 0)
+#define FIELD_MASK_POSITION_LONGITUDE (1ULL << 1)
+#define FIELD_MASK_POSITION_ALTITUDE (1ULL << 2)
 
 struct Position {
     uint32_t latitude; // 32bit
@@ -100,6 +256,29 @@ struct Position {
 
 // Number of bytes to encode struct Pose
 #define BYTES_LENGTH_POSE 12
+// Layout fingerprint of struct Pose, to check compatibility
+#define FINGERPRINT_POSE 0xc2e32b9442c9c9a5ULL
+
+// Bit offsets and number of bits of the fields of struct Pose
+#define BP_OFFSET_BITS_POSE_YAW 0
+#define BP_NBITS_POSE_YAW 32
+#define BP_OFFSET_BITS_POSE_PITCH 32
+#define BP_NBITS_POSE_PITCH 32
+#define BP_OFFSET_BITS_POSE_ROLL 64
+#define BP_NBITS_POSE_ROLL 32
+// Number of entries in BP_FIELDS_POSE
+#define BP_NFIELDS_POSE 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_POSE]
+#define BP_FIELDS_POSE { \
+    {"yaw", 0, 32}, \
+    {"pitch", 32, 32}, \
+    {"roll", 64, 32}, \
+}
+
+// Mask bits selecting the fields of struct Pose in DecodePoseMasked
+#define FIELD_MASK_POSE_YAW (1ULL << 0)
+#define FIELD_MASK_POSE_PITCH (1ULL << 1)
+#define FIELD_MASK_POSE_ROLL (1ULL << 2)
 
 // Pose in flight. https://en.wikipedia.org/wiki/Aircraft_principal_axes
 struct Pose {
@@ -110,6 +289,38 @@ struct Pose {
 
 // Number of bytes to encode struct Flight
 #define BYTES_LENGTH_FLIGHT 36
+// Layout fingerprint of struct Flight, to check compatibility
+#define FINGERPRINT_FLIGHT 0xcc6f06d016770753ULL
+
+// Bit offsets and number of bits of the fields of struct Flight
+#define BP_OFFSET_BITS_FLIGHT_POSE 0
+#define BP_NBITS_FLIGHT_POSE 96
+#define BP_OFFSET_BITS_FLIGHT_POSE_YAW 0
+#define BP_NBITS_FLIGHT_POSE_YAW 32
+#define BP_OFFSET_BITS_FLIGHT_POSE_PITCH 32
+#define BP_NBITS_FLIGHT_POSE_PITCH 32
+#define BP_OFFSET_BITS_FLIGHT_POSE_ROLL 64
+#define BP_NBITS_FLIGHT_POSE_ROLL 32
+#define BP_OFFSET_BITS_FLIGHT_VELOCITY 96
+#define BP_NBITS_FLIGHT_VELOCITY 96
+#define BP_OFFSET_BITS_FLIGHT_ACCELERATION 192
+#define BP_NBITS_FLIGHT_ACCELERATION 96
+// Number of entries in BP_FIELDS_FLIGHT
+#define BP_NFIELDS_FLIGHT 6
+// Initializer of struct BpFieldLayout[BP_NFIELDS_FLIGHT]
+#define BP_FIELDS_FLIGHT { \
+    {"pose", 0, 96}, \
+    {"pose.yaw", 0, 32}, \
+    {"pose.pitch", 32, 32}, \
+    {"pose.roll", 64, 32}, \
+    {"velocity", 96, 96}, \
+    {"acceleration", 192, 96}, \
+}
+
+// Mask bits selecting the fields of struct Flight in DecodeFlightMasked
+#define FIELD_MASK_FLIGHT_POSE (1ULL << 0)
+#define FIELD_MASK_FLIGHT_VELOCITY (1ULL << 1)
+#define FIELD_MASK_FLIGHT_ACCELERATION (1ULL << 2)
 
 struct Flight {
     struct Pose pose; // 96bit
@@ -121,6 +332,21 @@ struct Flight {
 
 // Number of bytes to encode struct PressureSensor
 #define BYTES_LENGTH_PRESSURE_SENSOR 6
+// Layout fingerprint of struct PressureSensor, to check compatibility
+#define FINGERPRINT_PRESSURE_SENSOR 0x25520a077a42ca16ULL
+
+// Bit offsets and number of bits of the fields of struct PressureSensor
+#define BP_OFFSET_BITS_PRESSURE_SENSOR_PRESSURES 0
+#define BP_NBITS_PRESSURE_SENSOR_PRESSURES 48
+// Number of entries in BP_FIELDS_PRESSURE_SENSOR
+#define BP_NFIELDS_PRESSURE_SENSOR 1
+// Initializer of struct BpFieldLayout[BP_NFIELDS_PRESSURE_SENSOR]
+#define BP_FIELDS_PRESSURE_SENSOR { \
+    {"pressures", 0, 48}, \
+}
+
+// Mask bits selecting the fields of struct PressureSensor in DecodePressureSensorMasked
+#define FIELD_MASK_PRESSURE_SENSOR_PRESSURES (1ULL << 0)
 
 struct PressureSensor {
     int32_t pressures[2]; // 48bit
@@ -128,6 +354,97 @@ struct PressureSensor {
 
 // Number of bytes to encode struct Drone
 #define BYTES_LENGTH_DRONE 67
+// Layout fingerprint of struct Drone, to check compatibility
+#define FINGERPRINT_DRONE 0x91865dcd474f9fe9ULL
+
+// Bit offsets and number of bits of the fields of struct Drone
+#define BP_OFFSET_BITS_DRONE_STATUS 0
+#define BP_NBITS_DRONE_STATUS 3
+#define BP_OFFSET_BITS_DRONE_POSITION 3
+#define BP_NBITS_DRONE_POSITION 96
+#define BP_OFFSET_BITS_DRONE_POSITION_LATITUDE 3
+#define BP_NBITS_DRONE_POSITION_LATITUDE 32
+#define BP_OFFSET_BITS_DRONE_POSITION_LONGITUDE 35
+#define BP_NBITS_DRONE_POSITION_LONGITUDE 32
+#define BP_OFFSET_BITS_DRONE_POSITION_ALTITUDE 67
+#define BP_NBITS_DRONE_POSITION_ALTITUDE 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT 99
+#define BP_NBITS_DRONE_FLIGHT 288
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE 99
+#define BP_NBITS_DRONE_FLIGHT_POSE 96
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE_YAW 99
+#define BP_NBITS_DRONE_FLIGHT_POSE_YAW 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE_PITCH 131
+#define BP_NBITS_DRONE_FLIGHT_POSE_PITCH 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE_ROLL 163
+#define BP_NBITS_DRONE_FLIGHT_POSE_ROLL 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT_VELOCITY 195
+#define BP_NBITS_DRONE_FLIGHT_VELOCITY 96
+#define BP_OFFSET_BITS_DRONE_FLIGHT_ACCELERATION 291
+#define BP_NBITS_DRONE_FLIGHT_ACCELERATION 96
+#define BP_OFFSET_BITS_DRONE_PROPELLERS 387
+#define BP_NBITS_DRONE_PROPELLERS 48
+#define BP_OFFSET_BITS_DRONE_POWER 435
+#define BP_NBITS_DRONE_POWER 11
+#define BP_OFFSET_BITS_DRONE_POWER_BATTERY 435
+#define BP_NBITS_DRONE_POWER_BATTERY 8
+#define BP_OFFSET_BITS_DRONE_POWER_STATUS 443
+#define BP_NBITS_DRONE_POWER_STATUS 2
+#define BP_OFFSET_BITS_DRONE_POWER_IS_CHARGING 445
+#define BP_NBITS_DRONE_POWER_IS_CHARGING 1
+#define BP_OFFSET_BITS_DRONE_NETWORK 446
+#define BP_NBITS_DRONE_NETWORK 36
+#define BP_OFFSET_BITS_DRONE_NETWORK_SIGNAL 446
+#define BP_NBITS_DRONE_NETWORK_SIGNAL 4
+#define BP_OFFSET_BITS_DRONE_NETWORK_HEARTBEAT_AT 450
+#define BP_NBITS_DRONE_NETWORK_HEARTBEAT_AT 32
+#define BP_OFFSET_BITS_DRONE_LANDING_GEAR 482
+#define BP_NBITS_DRONE_LANDING_GEAR 2
+#define BP_OFFSET_BITS_DRONE_LANDING_GEAR_STATUS 482
+#define BP_NBITS_DRONE_LANDING_GEAR_STATUS 2
+#define BP_OFFSET_BITS_DRONE_PRESSURE_SENSOR 484
+#define BP_NBITS_DRONE_PRESSURE_SENSOR 48
+#define BP_OFFSET_BITS_DRONE_PRESSURE_SENSOR_PRESSURES 484
+#define BP_NBITS_DRONE_PRESSURE_SENSOR_PRESSURES 48
+// Number of entries in BP_FIELDS_DRONE
+#define BP_NFIELDS_DRONE 24
+// Initializer of struct BpFieldLayout[BP_NFIELDS_DRONE]
+#define BP_FIELDS_DRONE { \
+    {"status", 0, 3}, \
+    {"position", 3, 96}, \
+    {"position.latitude", 3, 32}, \
+    {"position.longitude", 35, 32}, \
+    {"position.altitude", 67, 32}, \
+    {"flight", 99, 288}, \
+    {"flight.pose", 99, 96}, \
+    {"flight.pose.yaw", 99, 32}, \
+    {"flight.pose.pitch", 131, 32}, \
+    {"flight.pose.roll", 163, 32}, \
+    {"flight.velocity", 195, 96}, \
+    {"flight.acceleration", 291, 96}, \
+    {"propellers", 387, 48}, \
+    {"power", 435, 11}, \
+    {"power.battery", 435, 8}, \
+    {"power.status", 443, 2}, \
+    {"power.is_charging", 445, 1}, \
+    {"network", 446, 36}, \
+    {"network.signal", 446, 4}, \
+    {"network.heartbeat_at", 450, 32}, \
+    {"landing_gear", 482, 2}, \
+    {"landing_gear.status", 482, 2}, \
+    {"pressure_sensor", 484, 48}, \
+    {"pressure_sensor.pressures", 484, 48}, \
+}
+
+// Mask bits selecting the fields of struct Drone in DecodeDroneMasked
+#define FIELD_MASK_DRONE_STATUS (1ULL << 0)
+#define FIELD_MASK_DRONE_POSITION (1ULL << 1)
+#define FIELD_MASK_DRONE_FLIGHT (1ULL << 2)
+#define FIELD_MASK_DRONE_PROPELLERS (1ULL << 3)
+#define FIELD_MASK_DRONE_POWER (1ULL << 4)
+#define FIELD_MASK_DRONE_NETWORK (1ULL << 5)
+#define FIELD_MASK_DRONE_LANDING_GEAR (1ULL << 6)
+#define FIELD_MASK_DRONE_PRESSURE_SENSOR (1ULL << 7)
 
 struct Drone {
     DroneStatus status; // 3bit
@@ -141,9 +458,228 @@ struct Drone {
 };
 
 // Encode struct Drone to given buffer s.
-int EncodeDrone(struct Drone *m, unsigned char *s);
+int EncodeDrone(const struct Drone *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Drone from given buffer s.
-int DecodeDrone(struct Drone *m, unsigned char *s);
+int DecodeDrone(struct Drone *m, const unsigned char *s);
+// Decode struct Drone from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodeDroneN(struct Drone *m, const unsigned char *s, int n);
+// Decode the fields of struct Drone selected by mask, an or of FIELD_MASK_DRONE_*, from given buffer s. Others are skipped and left untouched.
+int DecodeDroneMasked(struct Drone *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Drone at ms to given buffer s, each takes BYTES_LENGTH_DRONE bytes.
+int EncodeDroneBatch(const struct Drone *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Drone to ms from given buffer s, each takes BYTES_LENGTH_DRONE bytes.
+int DecodeDroneBatch(struct Drone *ms, size_t count, const unsigned char *s);
+// Hash struct Drone by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualDrone have the same hash, on the same host.
+uint64_t HashDrone(const struct Drone *m);
+// Returns true if the structs Drone at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualDrone(const struct Drone *a, const struct Drone *b);
+
+// Get field status of struct Drone from given encoded buffer s.
+static inline DroneStatus BpGetDrone_status(const unsigned char *s) {
+    DroneStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[0] ) & 7;
+    return v;
+}
+
+// Set field status of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_status(unsigned char *s, DroneStatus v) {
+    s[0] = (s[0] & 248) | ((((unsigned char *)&(v))[0] ) & 7);
+}
+
+// Get field position.latitude of struct Drone from given encoded buffer s.
+static inline uint32_t BpGetDrone_position_latitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)((((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24 | (uint64_t)s[4] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field position.latitude of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_position_latitude(unsigned char *s, uint32_t v) {
+    s[0] = (s[0] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[1] = (s[1] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[1] = (s[1] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[2] = (s[2] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[2] = (s[2] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[3] = (s[3] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[3] = (s[3] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[4] = (s[4] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field position.longitude of struct Drone from given encoded buffer s.
+static inline uint32_t BpGetDrone_position_longitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)((((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24 | (uint64_t)s[8] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field position.longitude of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_position_longitude(unsigned char *s, uint32_t v) {
+    s[4] = (s[4] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[5] = (s[5] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[5] = (s[5] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[6] = (s[6] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[6] = (s[6] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[7] = (s[7] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[7] = (s[7] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[8] = (s[8] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field position.altitude of struct Drone from given encoded buffer s.
+static inline uint32_t BpGetDrone_position_altitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)((((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24 | (uint64_t)s[12] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field position.altitude of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_position_altitude(unsigned char *s, uint32_t v) {
+    s[8] = (s[8] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[9] = (s[9] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[9] = (s[9] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[10] = (s[10] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[10] = (s[10] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[11] = (s[11] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[11] = (s[11] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[12] = (s[12] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field flight.pose.yaw of struct Drone from given encoded buffer s.
+static inline int32_t BpGetDrone_flight_pose_yaw(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)((((uint64_t)s[12] | (uint64_t)s[13] << 8 | (uint64_t)s[14] << 16 | (uint64_t)s[15] << 24 | (uint64_t)s[16] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field flight.pose.yaw of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_flight_pose_yaw(unsigned char *s, int32_t v) {
+    s[12] = (s[12] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[13] = (s[13] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[13] = (s[13] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[14] = (s[14] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[14] = (s[14] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[15] = (s[15] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[15] = (s[15] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[16] = (s[16] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field flight.pose.pitch of struct Drone from given encoded buffer s.
+static inline int32_t BpGetDrone_flight_pose_pitch(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)((((uint64_t)s[16] | (uint64_t)s[17] << 8 | (uint64_t)s[18] << 16 | (uint64_t)s[19] << 24 | (uint64_t)s[20] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field flight.pose.pitch of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_flight_pose_pitch(unsigned char *s, int32_t v) {
+    s[16] = (s[16] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[17] = (s[17] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[17] = (s[17] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[18] = (s[18] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[18] = (s[18] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[19] = (s[19] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[19] = (s[19] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[20] = (s[20] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field flight.pose.roll of struct Drone from given encoded buffer s.
+static inline int32_t BpGetDrone_flight_pose_roll(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)((((uint64_t)s[20] | (uint64_t)s[21] << 8 | (uint64_t)s[22] << 16 | (uint64_t)s[23] << 24 | (uint64_t)s[24] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field flight.pose.roll of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_flight_pose_roll(unsigned char *s, int32_t v) {
+    s[20] = (s[20] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[21] = (s[21] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[21] = (s[21] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[22] = (s[22] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[22] = (s[22] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[23] = (s[23] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[23] = (s[23] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[24] = (s[24] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field power.battery of struct Drone from given encoded buffer s.
+static inline uint8_t BpGetDrone_power_battery(const unsigned char *s) {
+    uint8_t v = 0;
+    v = (uint8_t)((((uint64_t)s[54] | (uint64_t)s[55] << 8) >> 3) & 255);
+    return v;
+}
+
+// Set field power.battery of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_power_battery(unsigned char *s, uint8_t v) {
+    s[54] = (s[54] & 7) | ((((unsigned char *)&(v))[0] << 3) & 248);
+    s[55] = (s[55] & 248) | ((((unsigned char *)&(v))[0] >> 5) & 7);
+}
+
+// Get field power.status of struct Drone from given encoded buffer s.
+static inline PowerStatus BpGetDrone_power_status(const unsigned char *s) {
+    PowerStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[55] >> 3) & 3;
+    return v;
+}
+
+// Set field power.status of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_power_status(unsigned char *s, PowerStatus v) {
+    s[55] = (s[55] & 231) | ((((unsigned char *)&(v))[0] << 3) & 24);
+}
+
+// Get field power.is_charging of struct Drone from given encoded buffer s.
+static inline bool BpGetDrone_power_is_charging(const unsigned char *s) {
+    bool v = 0;
+    ((unsigned char *)&(v))[0] = (s[55] >> 5) & 1;
+    return v;
+}
+
+// Set field power.is_charging of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_power_is_charging(unsigned char *s, bool v) {
+    s[55] = (s[55] & 223) | ((((unsigned char *)&(v))[0] << 5) & 32);
+}
+
+// Get field network.signal of struct Drone from given encoded buffer s.
+static inline uint8_t BpGetDrone_network_signal(const unsigned char *s) {
+    uint8_t v = 0;
+    v = (uint8_t)((((uint64_t)s[55] | (uint64_t)s[56] << 8) >> 6) & 15);
+    return v;
+}
+
+// Set field network.signal of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_network_signal(unsigned char *s, uint8_t v) {
+    s[55] = (s[55] & 63) | ((((unsigned char *)&(v))[0] << 6) & 192);
+    s[56] = (s[56] & 252) | ((((unsigned char *)&(v))[0] >> 2) & 3);
+}
+
+// Get field network.heartbeat_at of struct Drone from given encoded buffer s.
+static inline Timestamp BpGetDrone_network_heartbeat_at(const unsigned char *s) {
+    Timestamp v = 0;
+    v = (Timestamp)((((uint64_t)s[56] | (uint64_t)s[57] << 8 | (uint64_t)s[58] << 16 | (uint64_t)s[59] << 24 | (uint64_t)s[60] << 32) >> 2) & 4294967295);
+    return v;
+}
+
+// Set field network.heartbeat_at of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_network_heartbeat_at(unsigned char *s, Timestamp v) {
+    s[56] = (s[56] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 2) & 252);
+    s[57] = (s[57] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 6) & 3);
+    s[57] = (s[57] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 2) & 252);
+    s[58] = (s[58] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 6) & 3);
+    s[58] = (s[58] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 2) & 252);
+    s[59] = (s[59] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 6) & 3);
+    s[59] = (s[59] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 2) & 252);
+    s[60] = (s[60] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 6) & 3);
+}
+
+// Get field landing_gear.status of struct Drone from given encoded buffer s.
+static inline LandingGearStatus BpGetDrone_landing_gear_status(const unsigned char *s) {
+    LandingGearStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[60] >> 2) & 3;
+    return v;
+}
+
+// Set field landing_gear.status of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_landing_gear_status(unsigned char *s, LandingGearStatus v) {
+    s[60] = (s[60] & 243) | ((((unsigned char *)&(v))[0] << 2) & 12);
+}
 
 #if defined(__cplusplus)
 }
@@ -3,412 +3,2010 @@
 #include "bitproto.h"
 #include "example_bp.h"
 
+#include <string.h>
+
+#ifndef BP_NO_JSON
+static const struct BpAliasDescriptor BpXXXAliasDescriptorTimestamp = BpAliasDescriptor(BpInt(32, sizeof(int32_t)));
+#endif
+
 void BpXXXProcessTimestamp(void *data, struct BpProcessorContext *ctx) {
-    struct BpAliasDescriptor descriptor = BpAliasDescriptor(BpInt(32, sizeof(int32_t)));
-    BpEndecodeAlias(&descriptor, ctx, data);
+    BpEndecodeInt(sizeof(int32_t), 32, ctx, data);
 }
 
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatTimestamp(void *data, struct BpJsonFormatContext *ctx) {
-    struct BpAliasDescriptor descriptor = BpAliasDescriptor(BpInt(32, sizeof(int32_t)));
-    BpJsonFormatAlias(&descriptor, ctx, data);
+    BpJsonFormatAlias(&BpXXXAliasDescriptorTimestamp, ctx, data);
 }
 
-void BpXXXProcessArrayTernaryInt32(void *data, struct BpProcessorContext *ctx) {
-    struct BpArrayDescriptor descriptor = BpArrayDescriptor(false, 3, BpInt(32, sizeof(int32_t)));
-    BpEndecodeArray(&descriptor, ctx, data);
+void BpXXXJsonParseTimestamp(void *data, struct BpJsonParseContext *ctx) {
+    BpJsonParseBaseType(BP_TYPE_INT, 32, ctx, data);
 }
+#endif
 
-void BpXXXJsonFormatArrayTernaryInt32(void *data, struct BpJsonFormatContext *ctx) {
-    struct BpArrayDescriptor descriptor = BpArrayDescriptor(false, 3, BpInt(32, sizeof(int32_t)));
-    BpJsonFormatArray(&descriptor, ctx, data);
+static const struct BpArrayDescriptor BpXXXArrayDescriptorTernaryInt32 = BpArrayDescriptor(false, 3, BpInt(32, sizeof(int32_t)));
+
+static void BpXXXProcessArrayTernaryInt32(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeArray(&BpXXXArrayDescriptorTernaryInt32, ctx, data);
 }
 
+#ifndef BP_NO_JSON
+static void BpXXXJsonFormatArrayTernaryInt32(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatArray(&BpXXXArrayDescriptorTernaryInt32, ctx, data);
+}
+#endif
+
+#ifndef BP_NO_JSON
+static const struct BpAliasDescriptor BpXXXAliasDescriptorTernaryInt32 = BpAliasDescriptor(BpArray(96, 3 * sizeof(int32_t), BpXXXProcessArrayTernaryInt32, BpXXXJsonFormatArrayTernaryInt32));
+#endif
+
 void BpXXXProcessTernaryInt32(void *data, struct BpProcessorContext *ctx) {
-    struct BpAliasDescriptor descriptor = BpAliasDescriptor(BpArray(96, 3 * sizeof(int32_t), BpXXXProcessArrayTernaryInt32, BpXXXJsonFormatArrayTernaryInt32));
-    BpEndecodeAlias(&descriptor, ctx, data);
+    BpXXXProcessArrayTernaryInt32(data, ctx);
 }
 
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatTernaryInt32(void *data, struct BpJsonFormatContext *ctx) {
-    struct BpAliasDescriptor descriptor = BpAliasDescriptor(BpArray(96, 3 * sizeof(int32_t), BpXXXProcessArrayTernaryInt32, BpXXXJsonFormatArrayTernaryInt32));
-    BpJsonFormatAlias(&descriptor, ctx, data);
+    BpJsonFormatAlias(&BpXXXAliasDescriptorTernaryInt32, ctx, data);
 }
 
-void BpFieldDescriptorsInitPropeller(struct Propeller *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->id), BpUint(8, sizeof(uint8_t)), "id");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->status), BpEnum(2, sizeof(PropellerStatus)), "status");
-    fds[2] = BpMessageFieldDescriptor((void *)&(m->direction), BpEnum(2, sizeof(RotatingDirection)), "direction");
+static void BpXXXJsonParseArrayTernaryInt32(void *data, struct BpJsonParseContext *ctx) {
+    int32_t *a = (int32_t *)data;
+    for (int k = 0; BpJsonParseNextElement(ctx, k, 3); k++) {
+        BpJsonParseBaseType(BP_TYPE_INT, 32, ctx, (void *)&(a[k]));
+    }
 }
 
-void BpXXXProcessPropeller(void *data, struct BpProcessorContext *ctx) {
-    struct Propeller *m = (struct Propeller *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPropeller(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 12, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+void BpXXXJsonParseTernaryInt32(void *data, struct BpJsonParseContext *ctx) {
+    BpXXXJsonParseArrayTernaryInt32(data, ctx);
 }
+#endif
 
-void BpXXXJsonFormatPropeller(void *data, struct BpJsonFormatContext *ctx) {
-    struct Propeller *m = (struct Propeller *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPropeller(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 12, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsPropeller[3] = {
+    BpMessageFieldDescriptor(offsetof(struct Propeller, id), BpUint(8, sizeof(uint8_t)), "id"),
+    BpMessageFieldDescriptor(offsetof(struct Propeller, status), BpEnum(2, sizeof(PropellerStatus)), "status"),
+    BpMessageFieldDescriptor(offsetof(struct Propeller, direction), BpEnum(2, sizeof(RotatingDirection)), "direction"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorPropeller = BpMessageDescriptor(false, 3, 12, BpXXXFieldDescriptorsPropeller);
+
+void BpXXXProcessPropeller(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorPropeller, ctx, data);
 }
 
-int EncodePropeller(struct Propeller *m, unsigned char *s) {
+int EncodePropeller(const struct Propeller *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Propeller", BP_TRACE_ENCODE, BYTES_LENGTH_PROPELLER);
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessPropeller((void *)m, &ctx);
+    BpEncodePadding(&ctx);
+    BP_TRACE_END("Propeller", BP_TRACE_ENCODE, BYTES_LENGTH_PROPELLER);
     return 0;
 }
 
-int DecodePropeller(struct Propeller *m, unsigned char *s) {
+int DecodePropeller(struct Propeller *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Propeller", BP_TRACE_DECODE, BYTES_LENGTH_PROPELLER);
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessPropeller((void *)m, &ctx);
+    BP_TRACE_END("Propeller", BP_TRACE_DECODE, BYTES_LENGTH_PROPELLER);
+    return 0;
+}
+
+int DecodePropellerN(struct Propeller *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_PROPELLER) return BP_ERR_SHORT_INPUT;
+    return DecodePropeller(m, s);
+}
+
+int DecodePropellerMasked(struct Propeller *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_PROPELLER_ID) {
+        BpDecodeBaseType(8, ctx, (void *)&(m->id));
+    } else {
+        ctx->i += 8;
+    }
+    if (mask & FIELD_MASK_PROPELLER_STATUS) {
+        BpDecodeUint(sizeof(PropellerStatus), 2, ctx, (void *)&(m->status));
+    } else {
+        ctx->i += 2;
+    }
+    if (mask & FIELD_MASK_PROPELLER_DIRECTION) {
+        BpDecodeUint(sizeof(RotatingDirection), 2, ctx, (void *)&(m->direction));
+    } else {
+        ctx->i += 2;
+    }
+    return 0;
+}
+
+int EncodePropellerBatch(const struct Propeller *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_PROPELLER;
+        ctx.i = 0;
+        BpXXXProcessPropeller((void *)&ms[k], &ctx);
+        BpEncodePadding(&ctx);
+    }
+    return 0;
+}
+
+int DecodePropellerBatch(struct Propeller *ms, size_t count, const unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_PROPELLER;
+        ctx.i = 0;
+        BpXXXProcessPropeller((void *)&ms[k], &ctx);
+    }
     return 0;
 }
 
+#ifdef BP_PARALLEL
+static int BpXXXEncodePropellerBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodePropellerBatch((const struct Propeller *)ms, count, s);
+}
+
+int EncodePropellerBatchParallel(const struct Propeller *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodePropellerBatch, (void *)ms, sizeof(struct Propeller), s, BYTES_LENGTH_PROPELLER, count, nthreads);
+}
+
+static int BpXXXDecodePropellerBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodePropellerBatch((struct Propeller *)ms, count, s);
+}
+
+int DecodePropellerBatchParallel(struct Propeller *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodePropellerBatch, (void *)ms, sizeof(struct Propeller), s, BYTES_LENGTH_PROPELLER, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodePropellerInto(struct BpRing *r, const struct Propeller *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodePropeller(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodePropellerFrom(struct BpRing *r, struct Propeller *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodePropeller(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendPropellerBatch(int fd, const struct Propeller *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodePropellerBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_PROPELLER, count, flags);
+}
+
+int RecvPropellerBatch(int fd, struct Propeller *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_PROPELLER, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodePropellerBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashPropeller(const struct Propeller *m) {
+    uint64_t h = BP_HASH_INIT;
+    BP_HASH_MIX(h, (uint64_t)((*m).id));
+    BP_HASH_MIX(h, ((uint64_t)((*m).status) & 3ULL));
+    BP_HASH_MIX(h, ((uint64_t)((*m).direction) & 3ULL));
+    return h;
+}
+
+bool EqualPropeller(const struct Propeller *a, const struct Propeller *b) {
+    if ((uint64_t)((*a).id) != (uint64_t)((*b).id)) return false;
+    if (((uint64_t)((*a).status) & 3ULL) != ((uint64_t)((*b).status) & 3ULL)) return false;
+    if (((uint64_t)((*a).direction) & 3ULL) != ((uint64_t)((*b).direction) & 3ULL)) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatPropeller(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorPropeller, ctx, data);
+}
+
 int JsonPropeller(struct Propeller *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatPropeller((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpFieldDescriptorsInitPower(struct Power *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->battery), BpUint(8, sizeof(uint8_t)), "battery");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->status), BpEnum(2, sizeof(PowerStatus)), "status");
-    fds[2] = BpMessageFieldDescriptor((void *)&(m->is_charging), BpBool(), "is_charging");
+int JsonPropellerN(struct Propeller *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatPropeller((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXProcessPower(void *data, struct BpProcessorContext *ctx) {
-    struct Power *m = (struct Power *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPower(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 11, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+int JsonPropellerSink(struct Propeller *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatPropeller((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXJsonFormatPower(void *data, struct BpJsonFormatContext *ctx) {
-    struct Power *m = (struct Power *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPower(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 11, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+void BpXXXJsonParsePropeller(void *data, struct BpJsonParseContext *ctx) {
+    struct Propeller *m = (struct Propeller *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 2:
+                if (memcmp(key, "id", 2) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_UINT, 8, ctx, (void *)&(m->id));
+                    continue;
+                }
+                break;
+            case 6:
+                if (memcmp(key, "status", 6) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_ENUM, 2, ctx, (void *)&(m->status));
+                    continue;
+                }
+                break;
+            case 9:
+                if (memcmp(key, "direction", 9) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_ENUM, 2, ctx, (void *)&(m->direction));
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
+}
+
+int ParseJsonPropeller(struct Propeller *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParsePropeller((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
+}
+#endif
+
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsPower[3] = {
+    BpMessageFieldDescriptor(offsetof(struct Power, battery), BpUint(8, sizeof(uint8_t)), "battery"),
+    BpMessageFieldDescriptor(offsetof(struct Power, status), BpEnum(2, sizeof(PowerStatus)), "status"),
+    BpMessageFieldDescriptor(offsetof(struct Power, is_charging), BpBool(), "is_charging"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorPower = BpMessageDescriptor(false, 3, 11, BpXXXFieldDescriptorsPower);
+
+void BpXXXProcessPower(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorPower, ctx, data);
 }
 
-int EncodePower(struct Power *m, unsigned char *s) {
+int EncodePower(const struct Power *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Power", BP_TRACE_ENCODE, BYTES_LENGTH_POWER);
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessPower((void *)m, &ctx);
+    BpEncodePadding(&ctx);
+    BP_TRACE_END("Power", BP_TRACE_ENCODE, BYTES_LENGTH_POWER);
     return 0;
 }
 
-int DecodePower(struct Power *m, unsigned char *s) {
+int DecodePower(struct Power *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Power", BP_TRACE_DECODE, BYTES_LENGTH_POWER);
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessPower((void *)m, &ctx);
+    BP_TRACE_END("Power", BP_TRACE_DECODE, BYTES_LENGTH_POWER);
+    return 0;
+}
+
+int DecodePowerN(struct Power *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_POWER) return BP_ERR_SHORT_INPUT;
+    return DecodePower(m, s);
+}
+
+int DecodePowerMasked(struct Power *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_POWER_BATTERY) {
+        BpDecodeBaseType(8, ctx, (void *)&(m->battery));
+    } else {
+        ctx->i += 8;
+    }
+    if (mask & FIELD_MASK_POWER_STATUS) {
+        BpDecodeUint(sizeof(PowerStatus), 2, ctx, (void *)&(m->status));
+    } else {
+        ctx->i += 2;
+    }
+    if (mask & FIELD_MASK_POWER_IS_CHARGING) {
+        BpDecodeUint(sizeof(bool), 1, ctx, (void *)&(m->is_charging));
+    } else {
+        ctx->i += 1;
+    }
+    return 0;
+}
+
+int EncodePowerBatch(const struct Power *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_POWER;
+        ctx.i = 0;
+        BpXXXProcessPower((void *)&ms[k], &ctx);
+        BpEncodePadding(&ctx);
+    }
+    return 0;
+}
+
+int DecodePowerBatch(struct Power *ms, size_t count, const unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_POWER;
+        ctx.i = 0;
+        BpXXXProcessPower((void *)&ms[k], &ctx);
+    }
     return 0;
 }
 
+#ifdef BP_PARALLEL
+static int BpXXXEncodePowerBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodePowerBatch((const struct Power *)ms, count, s);
+}
+
+int EncodePowerBatchParallel(const struct Power *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodePowerBatch, (void *)ms, sizeof(struct Power), s, BYTES_LENGTH_POWER, count, nthreads);
+}
+
+static int BpXXXDecodePowerBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodePowerBatch((struct Power *)ms, count, s);
+}
+
+int DecodePowerBatchParallel(struct Power *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodePowerBatch, (void *)ms, sizeof(struct Power), s, BYTES_LENGTH_POWER, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodePowerInto(struct BpRing *r, const struct Power *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodePower(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodePowerFrom(struct BpRing *r, struct Power *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodePower(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendPowerBatch(int fd, const struct Power *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodePowerBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_POWER, count, flags);
+}
+
+int RecvPowerBatch(int fd, struct Power *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_POWER, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodePowerBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashPower(const struct Power *m) {
+    uint64_t h = BP_HASH_INIT;
+    BP_HASH_MIX(h, (uint64_t)((*m).battery));
+    BP_HASH_MIX(h, ((uint64_t)((*m).status) & 3ULL));
+    BP_HASH_MIX(h, (uint64_t)((*m).is_charging));
+    return h;
+}
+
+bool EqualPower(const struct Power *a, const struct Power *b) {
+    if ((uint64_t)((*a).battery) != (uint64_t)((*b).battery)) return false;
+    if (((uint64_t)((*a).status) & 3ULL) != ((uint64_t)((*b).status) & 3ULL)) return false;
+    if ((uint64_t)((*a).is_charging) != (uint64_t)((*b).is_charging)) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatPower(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorPower, ctx, data);
+}
+
 int JsonPower(struct Power *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatPower((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpFieldDescriptorsInitNetwork(struct Network *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->signal), BpUint(4, sizeof(uint8_t)), "signal");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->heartbeat_at), BpAlias(32, sizeof(Timestamp), BpXXXProcessTimestamp, BpXXXJsonFormatTimestamp, BP_TYPE_INT), "heartbeat_at");
+int JsonPowerN(struct Power *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatPower((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXProcessNetwork(void *data, struct BpProcessorContext *ctx) {
-    struct Network *m = (struct Network *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[2];
-    BpFieldDescriptorsInitNetwork(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 2, 36, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+int JsonPowerSink(struct Power *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatPower((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXJsonFormatNetwork(void *data, struct BpJsonFormatContext *ctx) {
-    struct Network *m = (struct Network *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[2];
-    BpFieldDescriptorsInitNetwork(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 2, 36, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+void BpXXXJsonParsePower(void *data, struct BpJsonParseContext *ctx) {
+    struct Power *m = (struct Power *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 6:
+                if (memcmp(key, "status", 6) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_ENUM, 2, ctx, (void *)&(m->status));
+                    continue;
+                }
+                break;
+            case 7:
+                if (memcmp(key, "battery", 7) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_UINT, 8, ctx, (void *)&(m->battery));
+                    continue;
+                }
+                break;
+            case 11:
+                if (memcmp(key, "is_charging", 11) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_BOOL, 1, ctx, (void *)&(m->is_charging));
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
 }
 
-int EncodeNetwork(struct Network *m, unsigned char *s) {
+int ParseJsonPower(struct Power *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParsePower((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
+}
+#endif
+
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsNetwork[2] = {
+    BpMessageFieldDescriptor(offsetof(struct Network, signal), BpUint(4, sizeof(uint8_t)), "signal"),
+    BpMessageFieldDescriptor(offsetof(struct Network, heartbeat_at), BpAlias(32, sizeof(Timestamp), BpXXXProcessTimestamp, BpXXXJsonFormatTimestamp, BP_TYPE_INT), "heartbeat_at"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorNetwork = BpMessageDescriptor(false, 2, 36, BpXXXFieldDescriptorsNetwork);
+
+void BpXXXProcessNetwork(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorNetwork, ctx, data);
+}
+
+int EncodeNetwork(const struct Network *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Network", BP_TRACE_ENCODE, BYTES_LENGTH_NETWORK);
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessNetwork((void *)m, &ctx);
+    BpEncodePadding(&ctx);
+    BP_TRACE_END("Network", BP_TRACE_ENCODE, BYTES_LENGTH_NETWORK);
     return 0;
 }
 
-int DecodeNetwork(struct Network *m, unsigned char *s) {
+int DecodeNetwork(struct Network *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Network", BP_TRACE_DECODE, BYTES_LENGTH_NETWORK);
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessNetwork((void *)m, &ctx);
+    BP_TRACE_END("Network", BP_TRACE_DECODE, BYTES_LENGTH_NETWORK);
+    return 0;
+}
+
+int DecodeNetworkN(struct Network *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_NETWORK) return BP_ERR_SHORT_INPUT;
+    return DecodeNetwork(m, s);
+}
+
+int DecodeNetworkMasked(struct Network *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_NETWORK_SIGNAL) {
+        BpDecodeUint(sizeof(uint8_t), 4, ctx, (void *)&(m->signal));
+    } else {
+        ctx->i += 4;
+    }
+    if (mask & FIELD_MASK_NETWORK_HEARTBEAT_AT) {
+        BpXXXProcessTimestamp((void *)&(m->heartbeat_at), ctx);
+    } else {
+        ctx->i += 32;
+    }
+    return 0;
+}
+
+int EncodeNetworkBatch(const struct Network *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_NETWORK;
+        ctx.i = 0;
+        BpXXXProcessNetwork((void *)&ms[k], &ctx);
+        BpEncodePadding(&ctx);
+    }
     return 0;
 }
 
+int DecodeNetworkBatch(struct Network *ms, size_t count, const unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_NETWORK;
+        ctx.i = 0;
+        BpXXXProcessNetwork((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodeNetworkBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodeNetworkBatch((const struct Network *)ms, count, s);
+}
+
+int EncodeNetworkBatchParallel(const struct Network *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodeNetworkBatch, (void *)ms, sizeof(struct Network), s, BYTES_LENGTH_NETWORK, count, nthreads);
+}
+
+static int BpXXXDecodeNetworkBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodeNetworkBatch((struct Network *)ms, count, s);
+}
+
+int DecodeNetworkBatchParallel(struct Network *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodeNetworkBatch, (void *)ms, sizeof(struct Network), s, BYTES_LENGTH_NETWORK, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodeNetworkInto(struct BpRing *r, const struct Network *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodeNetwork(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodeNetworkFrom(struct BpRing *r, struct Network *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodeNetwork(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendNetworkBatch(int fd, const struct Network *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodeNetworkBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_NETWORK, count, flags);
+}
+
+int RecvNetworkBatch(int fd, struct Network *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_NETWORK, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodeNetworkBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashNetwork(const struct Network *m) {
+    uint64_t h = BP_HASH_INIT;
+    BP_HASH_MIX(h, ((uint64_t)((*m).signal) & 15ULL));
+    BP_HASH_MIX(h, (uint64_t)((*m).heartbeat_at));
+    return h;
+}
+
+bool EqualNetwork(const struct Network *a, const struct Network *b) {
+    if (((uint64_t)((*a).signal) & 15ULL) != ((uint64_t)((*b).signal) & 15ULL)) return false;
+    if ((uint64_t)((*a).heartbeat_at) != (uint64_t)((*b).heartbeat_at)) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatNetwork(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorNetwork, ctx, data);
+}
+
 int JsonNetwork(struct Network *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatNetwork((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpFieldDescriptorsInitLandingGear(struct LandingGear *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->status), BpEnum(2, sizeof(LandingGearStatus)), "status");
+int JsonNetworkN(struct Network *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatNetwork((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXProcessLandingGear(void *data, struct BpProcessorContext *ctx) {
-    struct LandingGear *m = (struct LandingGear *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[1];
-    BpFieldDescriptorsInitLandingGear(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 1, 2, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+int JsonNetworkSink(struct Network *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatNetwork((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXJsonFormatLandingGear(void *data, struct BpJsonFormatContext *ctx) {
-    struct LandingGear *m = (struct LandingGear *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[1];
-    BpFieldDescriptorsInitLandingGear(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 1, 2, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+void BpXXXJsonParseNetwork(void *data, struct BpJsonParseContext *ctx) {
+    struct Network *m = (struct Network *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 6:
+                if (memcmp(key, "signal", 6) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_UINT, 4, ctx, (void *)&(m->signal));
+                    continue;
+                }
+                break;
+            case 12:
+                if (memcmp(key, "heartbeat_at", 12) == 0) {
+                    BpXXXJsonParseTimestamp((void *)&(m->heartbeat_at), ctx);
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
+}
+
+int ParseJsonNetwork(struct Network *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParseNetwork((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
 }
+#endif
+
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsLandingGear[1] = {
+    BpMessageFieldDescriptor(offsetof(struct LandingGear, status), BpEnum(2, sizeof(LandingGearStatus)), "status"),
+};
 
-int EncodeLandingGear(struct LandingGear *m, unsigned char *s) {
+static const struct BpMessageDescriptor BpXXXMessageDescriptorLandingGear = BpMessageDescriptor(false, 1, 2, BpXXXFieldDescriptorsLandingGear);
+
+void BpXXXProcessLandingGear(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorLandingGear, ctx, data);
+}
+
+int EncodeLandingGear(const struct LandingGear *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("LandingGear", BP_TRACE_ENCODE, BYTES_LENGTH_LANDING_GEAR);
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessLandingGear((void *)m, &ctx);
+    BpEncodePadding(&ctx);
+    BP_TRACE_END("LandingGear", BP_TRACE_ENCODE, BYTES_LENGTH_LANDING_GEAR);
     return 0;
 }
 
-int DecodeLandingGear(struct LandingGear *m, unsigned char *s) {
+int DecodeLandingGear(struct LandingGear *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("LandingGear", BP_TRACE_DECODE, BYTES_LENGTH_LANDING_GEAR);
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessLandingGear((void *)m, &ctx);
+    BP_TRACE_END("LandingGear", BP_TRACE_DECODE, BYTES_LENGTH_LANDING_GEAR);
+    return 0;
+}
+
+int DecodeLandingGearN(struct LandingGear *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_LANDING_GEAR) return BP_ERR_SHORT_INPUT;
+    return DecodeLandingGear(m, s);
+}
+
+int DecodeLandingGearMasked(struct LandingGear *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_LANDING_GEAR_STATUS) {
+        BpDecodeUint(sizeof(LandingGearStatus), 2, ctx, (void *)&(m->status));
+    } else {
+        ctx->i += 2;
+    }
+    return 0;
+}
+
+int EncodeLandingGearBatch(const struct LandingGear *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_LANDING_GEAR;
+        ctx.i = 0;
+        BpXXXProcessLandingGear((void *)&ms[k], &ctx);
+        BpEncodePadding(&ctx);
+    }
     return 0;
 }
 
+int DecodeLandingGearBatch(struct LandingGear *ms, size_t count, const unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_LANDING_GEAR;
+        ctx.i = 0;
+        BpXXXProcessLandingGear((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodeLandingGearBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodeLandingGearBatch((const struct LandingGear *)ms, count, s);
+}
+
+int EncodeLandingGearBatchParallel(const struct LandingGear *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodeLandingGearBatch, (void *)ms, sizeof(struct LandingGear), s, BYTES_LENGTH_LANDING_GEAR, count, nthreads);
+}
+
+static int BpXXXDecodeLandingGearBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodeLandingGearBatch((struct LandingGear *)ms, count, s);
+}
+
+int DecodeLandingGearBatchParallel(struct LandingGear *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodeLandingGearBatch, (void *)ms, sizeof(struct LandingGear), s, BYTES_LENGTH_LANDING_GEAR, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodeLandingGearInto(struct BpRing *r, const struct LandingGear *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodeLandingGear(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodeLandingGearFrom(struct BpRing *r, struct LandingGear *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodeLandingGear(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendLandingGearBatch(int fd, const struct LandingGear *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodeLandingGearBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_LANDING_GEAR, count, flags);
+}
+
+int RecvLandingGearBatch(int fd, struct LandingGear *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_LANDING_GEAR, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodeLandingGearBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashLandingGear(const struct LandingGear *m) {
+    uint64_t h = BP_HASH_INIT;
+    BP_HASH_MIX(h, ((uint64_t)((*m).status) & 3ULL));
+    return h;
+}
+
+bool EqualLandingGear(const struct LandingGear *a, const struct LandingGear *b) {
+    if (((uint64_t)((*a).status) & 3ULL) != ((uint64_t)((*b).status) & 3ULL)) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatLandingGear(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorLandingGear, ctx, data);
+}
+
 int JsonLandingGear(struct LandingGear *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatLandingGear((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonLandingGearN(struct LandingGear *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatLandingGear((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpFieldDescriptorsInitPosition(struct Position *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->latitude), BpUint(32, sizeof(uint32_t)), "latitude");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->longitude), BpUint(32, sizeof(uint32_t)), "longitude");
-    fds[2] = BpMessageFieldDescriptor((void *)&(m->altitude), BpUint(32, sizeof(uint32_t)), "altitude");
+int JsonLandingGearSink(struct LandingGear *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatLandingGear((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXProcessPosition(void *data, struct BpProcessorContext *ctx) {
-    struct Position *m = (struct Position *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPosition(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 96, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+void BpXXXJsonParseLandingGear(void *data, struct BpJsonParseContext *ctx) {
+    struct LandingGear *m = (struct LandingGear *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 6:
+                if (memcmp(key, "status", 6) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_ENUM, 2, ctx, (void *)&(m->status));
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
 }
 
-void BpXXXJsonFormatPosition(void *data, struct BpJsonFormatContext *ctx) {
-    struct Position *m = (struct Position *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPosition(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 96, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+int ParseJsonLandingGear(struct LandingGear *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParseLandingGear((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
 }
+#endif
 
-int EncodePosition(struct Position *m, unsigned char *s) {
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsPosition[3] = {
+    BpMessageFieldDescriptor(offsetof(struct Position, latitude), BpUint(32, sizeof(uint32_t)), "latitude"),
+    BpMessageFieldDescriptor(offsetof(struct Position, longitude), BpUint(32, sizeof(uint32_t)), "longitude"),
+    BpMessageFieldDescriptor(offsetof(struct Position, altitude), BpUint(32, sizeof(uint32_t)), "altitude"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorPosition = BpMessageDescriptor(false, 3, 96, BpXXXFieldDescriptorsPosition);
+
+void BpXXXProcessPosition(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorPosition, ctx, data);
+}
+
+int EncodePosition(const struct Position *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Position", BP_TRACE_ENCODE, BYTES_LENGTH_POSITION);
+#if BP_BIG_ENDIAN
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessPosition((void *)m, &ctx);
+#else
+    memcpy(s, m, BYTES_LENGTH_POSITION);
+#endif
+    BP_TRACE_END("Position", BP_TRACE_ENCODE, BYTES_LENGTH_POSITION);
     return 0;
 }
 
-int DecodePosition(struct Position *m, unsigned char *s) {
+int DecodePosition(struct Position *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Position", BP_TRACE_DECODE, BYTES_LENGTH_POSITION);
+#if BP_BIG_ENDIAN
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessPosition((void *)m, &ctx);
+#else
+    memcpy(m, s, BYTES_LENGTH_POSITION);
+#endif
+    BP_TRACE_END("Position", BP_TRACE_DECODE, BYTES_LENGTH_POSITION);
+    return 0;
+}
+
+int DecodePositionN(struct Position *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_POSITION) return BP_ERR_SHORT_INPUT;
+    return DecodePosition(m, s);
+}
+
+int DecodePositionMasked(struct Position *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_POSITION_LATITUDE) {
+        BpDecodeUint(sizeof(uint32_t), 32, ctx, (void *)&(m->latitude));
+    } else {
+        ctx->i += 32;
+    }
+    if (mask & FIELD_MASK_POSITION_LONGITUDE) {
+        BpDecodeUint(sizeof(uint32_t), 32, ctx, (void *)&(m->longitude));
+    } else {
+        ctx->i += 32;
+    }
+    if (mask & FIELD_MASK_POSITION_ALTITUDE) {
+        BpDecodeUint(sizeof(uint32_t), 32, ctx, (void *)&(m->altitude));
+    } else {
+        ctx->i += 32;
+    }
+    return 0;
+}
+
+int EncodePositionBatch(const struct Position *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+#if !BP_BIG_ENDIAN
+    memcpy(s, ms, count * BYTES_LENGTH_POSITION);
+    return 0;
+#endif
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_POSITION;
+        ctx.i = 0;
+        BpXXXProcessPosition((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+int DecodePositionBatch(struct Position *ms, size_t count, const unsigned char *s) {
+#if !BP_BIG_ENDIAN
+    memcpy(ms, s, count * BYTES_LENGTH_POSITION);
     return 0;
+#endif
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_POSITION;
+        ctx.i = 0;
+        BpXXXProcessPosition((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodePositionBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodePositionBatch((const struct Position *)ms, count, s);
+}
+
+int EncodePositionBatchParallel(const struct Position *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodePositionBatch, (void *)ms, sizeof(struct Position), s, BYTES_LENGTH_POSITION, count, nthreads);
+}
+
+static int BpXXXDecodePositionBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodePositionBatch((struct Position *)ms, count, s);
+}
+
+int DecodePositionBatchParallel(struct Position *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodePositionBatch, (void *)ms, sizeof(struct Position), s, BYTES_LENGTH_POSITION, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodePositionInto(struct BpRing *r, const struct Position *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodePosition(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodePositionFrom(struct BpRing *r, struct Position *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodePosition(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendPositionBatch(int fd, const struct Position *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodePositionBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_POSITION, count, flags);
+}
+
+int RecvPositionBatch(int fd, struct Position *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_POSITION, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodePositionBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashPosition(const struct Position *m) {
+    uint64_t h = BP_HASH_INIT;
+    {
+        uint64_t w;
+        memcpy(&w, &((*m).latitude), 8);
+        BP_HASH_MIX(h, w);
+    }
+    {
+        uint64_t w = 0;
+        memcpy(&w, (const unsigned char *)(&((*m).latitude)) + 8, 4);
+        BP_HASH_MIX(h, w);
+    }
+    return h;
+}
+
+bool EqualPosition(const struct Position *a, const struct Position *b) {
+    if (memcmp(&((*a).latitude), &((*b).latitude), 12) != 0) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatPosition(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorPosition, ctx, data);
 }
 
 int JsonPosition(struct Position *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatPosition((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonPositionN(struct Position *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatPosition((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpFieldDescriptorsInitPose(struct Pose *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->yaw), BpInt(32, sizeof(int32_t)), "yaw");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->pitch), BpInt(32, sizeof(int32_t)), "pitch");
-    fds[2] = BpMessageFieldDescriptor((void *)&(m->roll), BpInt(32, sizeof(int32_t)), "roll");
+int JsonPositionSink(struct Position *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatPosition((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXProcessPose(void *data, struct BpProcessorContext *ctx) {
-    struct Pose *m = (struct Pose *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPose(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 96, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+void BpXXXJsonParsePosition(void *data, struct BpJsonParseContext *ctx) {
+    struct Position *m = (struct Position *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 8:
+                if (memcmp(key, "latitude", 8) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_UINT, 32, ctx, (void *)&(m->latitude));
+                    continue;
+                }
+                if (memcmp(key, "altitude", 8) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_UINT, 32, ctx, (void *)&(m->altitude));
+                    continue;
+                }
+                break;
+            case 9:
+                if (memcmp(key, "longitude", 9) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_UINT, 32, ctx, (void *)&(m->longitude));
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
 }
 
-void BpXXXJsonFormatPose(void *data, struct BpJsonFormatContext *ctx) {
-    struct Pose *m = (struct Pose *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitPose(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 96, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+int ParseJsonPosition(struct Position *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParsePosition((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
 }
+#endif
 
-int EncodePose(struct Pose *m, unsigned char *s) {
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsPose[3] = {
+    BpMessageFieldDescriptor(offsetof(struct Pose, yaw), BpInt(32, sizeof(int32_t)), "yaw"),
+    BpMessageFieldDescriptor(offsetof(struct Pose, pitch), BpInt(32, sizeof(int32_t)), "pitch"),
+    BpMessageFieldDescriptor(offsetof(struct Pose, roll), BpInt(32, sizeof(int32_t)), "roll"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorPose = BpMessageDescriptor(false, 3, 96, BpXXXFieldDescriptorsPose);
+
+void BpXXXProcessPose(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorPose, ctx, data);
+}
+
+int EncodePose(const struct Pose *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Pose", BP_TRACE_ENCODE, BYTES_LENGTH_POSE);
+#if BP_BIG_ENDIAN
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessPose((void *)m, &ctx);
+#else
+    memcpy(s, m, BYTES_LENGTH_POSE);
+#endif
+    BP_TRACE_END("Pose", BP_TRACE_ENCODE, BYTES_LENGTH_POSE);
     return 0;
 }
 
-int DecodePose(struct Pose *m, unsigned char *s) {
+int DecodePose(struct Pose *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Pose", BP_TRACE_DECODE, BYTES_LENGTH_POSE);
+#if BP_BIG_ENDIAN
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessPose((void *)m, &ctx);
+#else
+    memcpy(m, s, BYTES_LENGTH_POSE);
+#endif
+    BP_TRACE_END("Pose", BP_TRACE_DECODE, BYTES_LENGTH_POSE);
+    return 0;
+}
+
+int DecodePoseN(struct Pose *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_POSE) return BP_ERR_SHORT_INPUT;
+    return DecodePose(m, s);
+}
+
+int DecodePoseMasked(struct Pose *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_POSE_YAW) {
+        BpDecodeInt(sizeof(int32_t), 32, ctx, (void *)&(m->yaw));
+    } else {
+        ctx->i += 32;
+    }
+    if (mask & FIELD_MASK_POSE_PITCH) {
+        BpDecodeInt(sizeof(int32_t), 32, ctx, (void *)&(m->pitch));
+    } else {
+        ctx->i += 32;
+    }
+    if (mask & FIELD_MASK_POSE_ROLL) {
+        BpDecodeInt(sizeof(int32_t), 32, ctx, (void *)&(m->roll));
+    } else {
+        ctx->i += 32;
+    }
+    return 0;
+}
+
+int EncodePoseBatch(const struct Pose *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+#if !BP_BIG_ENDIAN
+    memcpy(s, ms, count * BYTES_LENGTH_POSE);
+    return 0;
+#endif
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_POSE;
+        ctx.i = 0;
+        BpXXXProcessPose((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+int DecodePoseBatch(struct Pose *ms, size_t count, const unsigned char *s) {
+#if !BP_BIG_ENDIAN
+    memcpy(ms, s, count * BYTES_LENGTH_POSE);
     return 0;
+#endif
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_POSE;
+        ctx.i = 0;
+        BpXXXProcessPose((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodePoseBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodePoseBatch((const struct Pose *)ms, count, s);
+}
+
+int EncodePoseBatchParallel(const struct Pose *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodePoseBatch, (void *)ms, sizeof(struct Pose), s, BYTES_LENGTH_POSE, count, nthreads);
+}
+
+static int BpXXXDecodePoseBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodePoseBatch((struct Pose *)ms, count, s);
+}
+
+int DecodePoseBatchParallel(struct Pose *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodePoseBatch, (void *)ms, sizeof(struct Pose), s, BYTES_LENGTH_POSE, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodePoseInto(struct BpRing *r, const struct Pose *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodePose(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodePoseFrom(struct BpRing *r, struct Pose *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodePose(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendPoseBatch(int fd, const struct Pose *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodePoseBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_POSE, count, flags);
+}
+
+int RecvPoseBatch(int fd, struct Pose *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_POSE, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodePoseBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashPose(const struct Pose *m) {
+    uint64_t h = BP_HASH_INIT;
+    {
+        uint64_t w;
+        memcpy(&w, &((*m).yaw), 8);
+        BP_HASH_MIX(h, w);
+    }
+    {
+        uint64_t w = 0;
+        memcpy(&w, (const unsigned char *)(&((*m).yaw)) + 8, 4);
+        BP_HASH_MIX(h, w);
+    }
+    return h;
+}
+
+bool EqualPose(const struct Pose *a, const struct Pose *b) {
+    if (memcmp(&((*a).yaw), &((*b).yaw), 12) != 0) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatPose(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorPose, ctx, data);
 }
 
 int JsonPose(struct Pose *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatPose((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonPoseN(struct Pose *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatPose((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpFieldDescriptorsInitFlight(struct Flight *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->pose), BpMessage(96, sizeof(struct Pose), BpXXXProcessPose, BpXXXJsonFormatPose), "pose");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->velocity), BpAlias(96, sizeof(TernaryInt32), BpXXXProcessTernaryInt32, BpXXXJsonFormatTernaryInt32, BP_TYPE_ARRAY), "velocity");
-    fds[2] = BpMessageFieldDescriptor((void *)&(m->acceleration), BpAlias(96, sizeof(TernaryInt32), BpXXXProcessTernaryInt32, BpXXXJsonFormatTernaryInt32, BP_TYPE_ARRAY), "acceleration");
+int JsonPoseSink(struct Pose *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatPose((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXProcessFlight(void *data, struct BpProcessorContext *ctx) {
-    struct Flight *m = (struct Flight *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitFlight(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 288, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+void BpXXXJsonParsePose(void *data, struct BpJsonParseContext *ctx) {
+    struct Pose *m = (struct Pose *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 3:
+                if (memcmp(key, "yaw", 3) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_INT, 32, ctx, (void *)&(m->yaw));
+                    continue;
+                }
+                break;
+            case 4:
+                if (memcmp(key, "roll", 4) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_INT, 32, ctx, (void *)&(m->roll));
+                    continue;
+                }
+                break;
+            case 5:
+                if (memcmp(key, "pitch", 5) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_INT, 32, ctx, (void *)&(m->pitch));
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
 }
 
-void BpXXXJsonFormatFlight(void *data, struct BpJsonFormatContext *ctx) {
-    struct Flight *m = (struct Flight *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[3];
-    BpFieldDescriptorsInitFlight(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 3, 288, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+int ParseJsonPose(struct Pose *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParsePose((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
 }
+#endif
 
-int EncodeFlight(struct Flight *m, unsigned char *s) {
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsFlight[3] = {
+    BpMessageFieldDescriptor(offsetof(struct Flight, pose), BpMessage(96, sizeof(struct Pose), BpXXXProcessPose, BpXXXJsonFormatPose), "pose"),
+    BpMessageFieldDescriptor(offsetof(struct Flight, velocity), BpAlias(96, sizeof(TernaryInt32), BpXXXProcessTernaryInt32, BpXXXJsonFormatTernaryInt32, BP_TYPE_ARRAY), "velocity"),
+    BpMessageFieldDescriptor(offsetof(struct Flight, acceleration), BpAlias(96, sizeof(TernaryInt32), BpXXXProcessTernaryInt32, BpXXXJsonFormatTernaryInt32, BP_TYPE_ARRAY), "acceleration"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorFlight = BpMessageDescriptor(false, 3, 288, BpXXXFieldDescriptorsFlight);
+
+void BpXXXProcessFlight(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorFlight, ctx, data);
+}
+
+int EncodeFlight(const struct Flight *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Flight", BP_TRACE_ENCODE, BYTES_LENGTH_FLIGHT);
+#if BP_BIG_ENDIAN
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessFlight((void *)m, &ctx);
+#else
+    memcpy(s, m, BYTES_LENGTH_FLIGHT);
+#endif
+    BP_TRACE_END("Flight", BP_TRACE_ENCODE, BYTES_LENGTH_FLIGHT);
     return 0;
 }
 
-int DecodeFlight(struct Flight *m, unsigned char *s) {
+int DecodeFlight(struct Flight *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Flight", BP_TRACE_DECODE, BYTES_LENGTH_FLIGHT);
+#if BP_BIG_ENDIAN
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessFlight((void *)m, &ctx);
+#else
+    memcpy(m, s, BYTES_LENGTH_FLIGHT);
+#endif
+    BP_TRACE_END("Flight", BP_TRACE_DECODE, BYTES_LENGTH_FLIGHT);
+    return 0;
+}
+
+int DecodeFlightN(struct Flight *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_FLIGHT) return BP_ERR_SHORT_INPUT;
+    return DecodeFlight(m, s);
+}
+
+int DecodeFlightMasked(struct Flight *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_FLIGHT_POSE) {
+        BpXXXProcessPose((void *)&(m->pose), ctx);
+    } else {
+        ctx->i += 96;
+    }
+    if (mask & FIELD_MASK_FLIGHT_VELOCITY) {
+        BpXXXProcessTernaryInt32((void *)&(m->velocity), ctx);
+    } else {
+        ctx->i += 96;
+    }
+    if (mask & FIELD_MASK_FLIGHT_ACCELERATION) {
+        BpXXXProcessTernaryInt32((void *)&(m->acceleration), ctx);
+    } else {
+        ctx->i += 96;
+    }
+    return 0;
+}
+
+int EncodeFlightBatch(const struct Flight *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+#if !BP_BIG_ENDIAN
+    memcpy(s, ms, count * BYTES_LENGTH_FLIGHT);
+    return 0;
+#endif
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_FLIGHT;
+        ctx.i = 0;
+        BpXXXProcessFlight((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+int DecodeFlightBatch(struct Flight *ms, size_t count, const unsigned char *s) {
+#if !BP_BIG_ENDIAN
+    memcpy(ms, s, count * BYTES_LENGTH_FLIGHT);
     return 0;
+#endif
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_FLIGHT;
+        ctx.i = 0;
+        BpXXXProcessFlight((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodeFlightBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodeFlightBatch((const struct Flight *)ms, count, s);
+}
+
+int EncodeFlightBatchParallel(const struct Flight *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodeFlightBatch, (void *)ms, sizeof(struct Flight), s, BYTES_LENGTH_FLIGHT, count, nthreads);
+}
+
+static int BpXXXDecodeFlightBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodeFlightBatch((struct Flight *)ms, count, s);
+}
+
+int DecodeFlightBatchParallel(struct Flight *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodeFlightBatch, (void *)ms, sizeof(struct Flight), s, BYTES_LENGTH_FLIGHT, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodeFlightInto(struct BpRing *r, const struct Flight *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodeFlight(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodeFlightFrom(struct BpRing *r, struct Flight *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodeFlight(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendFlightBatch(int fd, const struct Flight *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodeFlightBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_FLIGHT, count, flags);
+}
+
+int RecvFlightBatch(int fd, struct Flight *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_FLIGHT, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodeFlightBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashFlight(const struct Flight *m) {
+    uint64_t h = BP_HASH_INIT;
+    for (int j = 0; j < 32; j += 8) {
+        uint64_t w;
+        memcpy(&w, (const unsigned char *)(&((*m).pose)) + j, 8);
+        BP_HASH_MIX(h, w);
+    }
+    {
+        uint64_t w = 0;
+        memcpy(&w, (const unsigned char *)(&((*m).pose)) + 32, 4);
+        BP_HASH_MIX(h, w);
+    }
+    return h;
+}
+
+bool EqualFlight(const struct Flight *a, const struct Flight *b) {
+    if (memcmp(&((*a).pose), &((*b).pose), 36) != 0) return false;
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatFlight(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorFlight, ctx, data);
 }
 
 int JsonFlight(struct Flight *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatFlight((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonFlightN(struct Flight *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatFlight((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpXXXProcessArrayPressureSensor1(void *data, struct BpProcessorContext *ctx) {
-    struct BpArrayDescriptor descriptor = BpArrayDescriptor(false, 2, BpInt(24, sizeof(int32_t)));
-    BpEndecodeArray(&descriptor, ctx, data);
+int JsonFlightSink(struct Flight *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatFlight((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXJsonFormatArrayPressureSensor1(void *data, struct BpJsonFormatContext *ctx) {
-    struct BpArrayDescriptor descriptor = BpArrayDescriptor(false, 2, BpInt(24, sizeof(int32_t)));
-    BpJsonFormatArray(&descriptor, ctx, data);
+void BpXXXJsonParseFlight(void *data, struct BpJsonParseContext *ctx) {
+    struct Flight *m = (struct Flight *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 4:
+                if (memcmp(key, "pose", 4) == 0) {
+                    BpXXXJsonParsePose((void *)&(m->pose), ctx);
+                    continue;
+                }
+                break;
+            case 8:
+                if (memcmp(key, "velocity", 8) == 0) {
+                    BpXXXJsonParseTernaryInt32((void *)&(m->velocity), ctx);
+                    continue;
+                }
+                break;
+            case 12:
+                if (memcmp(key, "acceleration", 12) == 0) {
+                    BpXXXJsonParseTernaryInt32((void *)&(m->acceleration), ctx);
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
 }
 
-void BpFieldDescriptorsInitPressureSensor(struct PressureSensor *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->pressures), BpArray(48, 2 * sizeof(int32_t), BpXXXProcessArrayPressureSensor1, BpXXXJsonFormatArrayPressureSensor1), "pressures");
+int ParseJsonFlight(struct Flight *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParseFlight((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
 }
+#endif
 
-void BpXXXProcessPressureSensor(void *data, struct BpProcessorContext *ctx) {
-    struct PressureSensor *m = (struct PressureSensor *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[1];
-    BpFieldDescriptorsInitPressureSensor(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 1, 48, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+static const struct BpArrayDescriptor BpXXXArrayDescriptorPressureSensor1 = BpArrayDescriptor(false, 2, BpInt(24, sizeof(int32_t)));
+
+static void BpXXXProcessArrayPressureSensor1(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeArray(&BpXXXArrayDescriptorPressureSensor1, ctx, data);
 }
 
-void BpXXXJsonFormatPressureSensor(void *data, struct BpJsonFormatContext *ctx) {
-    struct PressureSensor *m = (struct PressureSensor *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[1];
-    BpFieldDescriptorsInitPressureSensor(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 1, 48, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+#ifndef BP_NO_JSON
+static void BpXXXJsonFormatArrayPressureSensor1(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatArray(&BpXXXArrayDescriptorPressureSensor1, ctx, data);
 }
+#endif
+
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsPressureSensor[1] = {
+    BpMessageFieldDescriptor(offsetof(struct PressureSensor, pressures), BpArray(48, 2 * sizeof(int32_t), BpXXXProcessArrayPressureSensor1, BpXXXJsonFormatArrayPressureSensor1), "pressures"),
+};
 
-int EncodePressureSensor(struct PressureSensor *m, unsigned char *s) {
+static const struct BpMessageDescriptor BpXXXMessageDescriptorPressureSensor = BpMessageDescriptor(false, 1, 48, BpXXXFieldDescriptorsPressureSensor);
+
+void BpXXXProcessPressureSensor(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorPressureSensor, ctx, data);
+}
+
+int EncodePressureSensor(const struct PressureSensor *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("PressureSensor", BP_TRACE_ENCODE, BYTES_LENGTH_PRESSURE_SENSOR);
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessPressureSensor((void *)m, &ctx);
+    BP_TRACE_END("PressureSensor", BP_TRACE_ENCODE, BYTES_LENGTH_PRESSURE_SENSOR);
     return 0;
 }
 
-int DecodePressureSensor(struct PressureSensor *m, unsigned char *s) {
+int DecodePressureSensor(struct PressureSensor *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("PressureSensor", BP_TRACE_DECODE, BYTES_LENGTH_PRESSURE_SENSOR);
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessPressureSensor((void *)m, &ctx);
+    BP_TRACE_END("PressureSensor", BP_TRACE_DECODE, BYTES_LENGTH_PRESSURE_SENSOR);
+    return 0;
+}
+
+int DecodePressureSensorN(struct PressureSensor *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_PRESSURE_SENSOR) return BP_ERR_SHORT_INPUT;
+    return DecodePressureSensor(m, s);
+}
+
+int DecodePressureSensorMasked(struct PressureSensor *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_PRESSURE_SENSOR_PRESSURES) {
+        BpXXXProcessArrayPressureSensor1((void *)&(m->pressures), ctx);
+    } else {
+        ctx->i += 48;
+    }
+    return 0;
+}
+
+int EncodePressureSensorBatch(const struct PressureSensor *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_PRESSURE_SENSOR;
+        ctx.i = 0;
+        BpXXXProcessPressureSensor((void *)&ms[k], &ctx);
+    }
     return 0;
 }
 
+int DecodePressureSensorBatch(struct PressureSensor *ms, size_t count, const unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_PRESSURE_SENSOR;
+        ctx.i = 0;
+        BpXXXProcessPressureSensor((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodePressureSensorBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodePressureSensorBatch((const struct PressureSensor *)ms, count, s);
+}
+
+int EncodePressureSensorBatchParallel(const struct PressureSensor *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodePressureSensorBatch, (void *)ms, sizeof(struct PressureSensor), s, BYTES_LENGTH_PRESSURE_SENSOR, count, nthreads);
+}
+
+static int BpXXXDecodePressureSensorBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodePressureSensorBatch((struct PressureSensor *)ms, count, s);
+}
+
+int DecodePressureSensorBatchParallel(struct PressureSensor *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodePressureSensorBatch, (void *)ms, sizeof(struct PressureSensor), s, BYTES_LENGTH_PRESSURE_SENSOR, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodePressureSensorInto(struct BpRing *r, const struct PressureSensor *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodePressureSensor(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodePressureSensorFrom(struct BpRing *r, struct PressureSensor *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodePressureSensor(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendPressureSensorBatch(int fd, const struct PressureSensor *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodePressureSensorBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_PRESSURE_SENSOR, count, flags);
+}
+
+int RecvPressureSensorBatch(int fd, struct PressureSensor *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_PRESSURE_SENSOR, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodePressureSensorBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashPressureSensor(const struct PressureSensor *m) {
+    uint64_t h = BP_HASH_INIT;
+    for (int k0 = 0; k0 < 2; k0++) {
+        BP_HASH_MIX(h, ((uint64_t)((*m).pressures[k0]) & 16777215ULL));
+    }
+    return h;
+}
+
+bool EqualPressureSensor(const struct PressureSensor *a, const struct PressureSensor *b) {
+    for (int k0 = 0; k0 < 2; k0++) {
+        if (((uint64_t)((*a).pressures[k0]) & 16777215ULL) != ((uint64_t)((*b).pressures[k0]) & 16777215ULL)) return false;
+    }
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatPressureSensor(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorPressureSensor, ctx, data);
+}
+
 int JsonPressureSensor(struct PressureSensor *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatPressureSensor((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonPressureSensorN(struct PressureSensor *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatPressureSensor((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
 }
 
-void BpXXXProcessArrayDrone4(void *data, struct BpProcessorContext *ctx) {
-    struct BpArrayDescriptor descriptor = BpArrayDescriptor(false, 4, BpMessage(12, sizeof(struct Propeller), BpXXXProcessPropeller, BpXXXJsonFormatPropeller));
-    BpEndecodeArray(&descriptor, ctx, data);
+int JsonPressureSensorSink(struct PressureSensor *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatPressureSensor((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
 }
 
-void BpXXXJsonFormatArrayDrone4(void *data, struct BpJsonFormatContext *ctx) {
-    struct BpArrayDescriptor descriptor = BpArrayDescriptor(false, 4, BpMessage(12, sizeof(struct Propeller), BpXXXProcessPropeller, BpXXXJsonFormatPropeller));
-    BpJsonFormatArray(&descriptor, ctx, data);
+static void BpXXXJsonParseArrayPressureSensor1(void *data, struct BpJsonParseContext *ctx) {
+    int32_t *a = (int32_t *)data;
+    for (int k = 0; BpJsonParseNextElement(ctx, k, 2); k++) {
+        BpJsonParseBaseType(BP_TYPE_INT, 24, ctx, (void *)&(a[k]));
+    }
 }
 
-void BpFieldDescriptorsInitDrone(struct Drone *m, struct BpMessageFieldDescriptor *fds) {
-    fds[0] = BpMessageFieldDescriptor((void *)&(m->status), BpEnum(3, sizeof(DroneStatus)), "status");
-    fds[1] = BpMessageFieldDescriptor((void *)&(m->position), BpMessage(96, sizeof(struct Position), BpXXXProcessPosition, BpXXXJsonFormatPosition), "position");
-    fds[2] = BpMessageFieldDescriptor((void *)&(m->flight), BpMessage(288, sizeof(struct Flight), BpXXXProcessFlight, BpXXXJsonFormatFlight), "flight");
-    fds[3] = BpMessageFieldDescriptor((void *)&(m->propellers), BpArray(48, 4 * sizeof(struct Propeller), BpXXXProcessArrayDrone4, BpXXXJsonFormatArrayDrone4), "propellers");
-    fds[4] = BpMessageFieldDescriptor((void *)&(m->power), BpMessage(11, sizeof(struct Power), BpXXXProcessPower, BpXXXJsonFormatPower), "power");
-    fds[5] = BpMessageFieldDescriptor((void *)&(m->network), BpMessage(36, sizeof(struct Network), BpXXXProcessNetwork, BpXXXJsonFormatNetwork), "network");
-    fds[6] = BpMessageFieldDescriptor((void *)&(m->landing_gear), BpMessage(2, sizeof(struct LandingGear), BpXXXProcessLandingGear, BpXXXJsonFormatLandingGear), "landing_gear");
-    fds[7] = BpMessageFieldDescriptor((void *)&(m->pressure_sensor), BpMessage(48, sizeof(struct PressureSensor), BpXXXProcessPressureSensor, BpXXXJsonFormatPressureSensor), "pressure_sensor");
+void BpXXXJsonParsePressureSensor(void *data, struct BpJsonParseContext *ctx) {
+    struct PressureSensor *m = (struct PressureSensor *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 9:
+                if (memcmp(key, "pressures", 9) == 0) {
+                    BpXXXJsonParseArrayPressureSensor1((void *)&(m->pressures), ctx);
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
 }
 
-void BpXXXProcessDrone(void *data, struct BpProcessorContext *ctx) {
-    struct Drone *m = (struct Drone *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[8];
-    BpFieldDescriptorsInitDrone(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 8, 532, field_descriptors);
-    BpEndecodeMessage(&descriptor, ctx, data);
+int ParseJsonPressureSensor(struct PressureSensor *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParsePressureSensor((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
 }
+#endif
 
-void BpXXXJsonFormatDrone(void *data, struct BpJsonFormatContext *ctx) {
-    struct Drone *m = (struct Drone *)(data);
-    struct BpMessageFieldDescriptor field_descriptors[8];
-    BpFieldDescriptorsInitDrone(m, field_descriptors);
-    struct BpMessageDescriptor descriptor = BpMessageDescriptor(false, 8, 532, field_descriptors);
-    BpJsonFormatMessage(&descriptor, ctx, data);
+#ifndef BP_NO_JSON
+static const struct BpArrayDescriptor BpXXXArrayDescriptorDrone4 = BpArrayDescriptor(false, 4, BpMessage(12, sizeof(struct Propeller), BpXXXProcessPropeller, BpXXXJsonFormatPropeller));
+#endif
+
+static void BpXXXProcessArrayDrone4(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessageArray(&BpXXXMessageDescriptorPropeller, 4, sizeof(struct Propeller), ctx, data);
 }
 
-int EncodeDrone(struct Drone *m, unsigned char *s) {
+#ifndef BP_NO_JSON
+static void BpXXXJsonFormatArrayDrone4(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatArray(&BpXXXArrayDescriptorDrone4, ctx, data);
+}
+#endif
+
+static const struct BpMessageFieldDescriptor BpXXXFieldDescriptorsDrone[8] = {
+    BpMessageFieldDescriptor(offsetof(struct Drone, status), BpEnum(3, sizeof(DroneStatus)), "status"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, position), BpMessage(96, sizeof(struct Position), BpXXXProcessPosition, BpXXXJsonFormatPosition), "position"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, flight), BpMessage(288, sizeof(struct Flight), BpXXXProcessFlight, BpXXXJsonFormatFlight), "flight"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, propellers), BpArray(48, 4 * sizeof(struct Propeller), BpXXXProcessArrayDrone4, BpXXXJsonFormatArrayDrone4), "propellers"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, power), BpMessage(11, sizeof(struct Power), BpXXXProcessPower, BpXXXJsonFormatPower), "power"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, network), BpMessage(36, sizeof(struct Network), BpXXXProcessNetwork, BpXXXJsonFormatNetwork), "network"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, landing_gear), BpMessage(2, sizeof(struct LandingGear), BpXXXProcessLandingGear, BpXXXJsonFormatLandingGear), "landing_gear"),
+    BpMessageFieldDescriptor(offsetof(struct Drone, pressure_sensor), BpMessage(48, sizeof(struct PressureSensor), BpXXXProcessPressureSensor, BpXXXJsonFormatPressureSensor), "pressure_sensor"),
+};
+
+static const struct BpMessageDescriptor BpXXXMessageDescriptorDrone = BpMessageDescriptor(false, 8, 532, BpXXXFieldDescriptorsDrone);
+
+void BpXXXProcessDrone(void *data, struct BpProcessorContext *ctx) {
+    BpEndecodeMessage(&BpXXXMessageDescriptorDrone, ctx, data);
+}
+
+int EncodeDrone(const struct Drone *BP_RESTRICT m, unsigned char *BP_RESTRICT s) {
+    BP_TRACE_BEGIN("Drone", BP_TRACE_ENCODE, BYTES_LENGTH_DRONE);
     struct BpProcessorContext ctx = BpProcessorContext(true, s);
     BpXXXProcessDrone((void *)m, &ctx);
+    BpEncodePadding(&ctx);
+    BP_TRACE_END("Drone", BP_TRACE_ENCODE, BYTES_LENGTH_DRONE);
     return 0;
 }
 
-int DecodeDrone(struct Drone *m, unsigned char *s) {
+int DecodeDrone(struct Drone *m, const unsigned char *s) {
+    BP_TRACE_BEGIN("Drone", BP_TRACE_DECODE, BYTES_LENGTH_DRONE);
     struct BpProcessorContext ctx = BpProcessorContext(false, s);
     BpXXXProcessDrone((void *)m, &ctx);
+    BP_TRACE_END("Drone", BP_TRACE_DECODE, BYTES_LENGTH_DRONE);
+    return 0;
+}
+
+int DecodeDroneN(struct Drone *m, const unsigned char *s, int n) {
+    if (n < BYTES_LENGTH_DRONE) return BP_ERR_SHORT_INPUT;
+    return DecodeDrone(m, s);
+}
+
+int DecodeDroneMasked(struct Drone *m, const unsigned char *s, uint64_t mask) {
+    struct BpProcessorContext c = BpProcessorContext(false, s);
+    struct BpProcessorContext *ctx = &c;
+    if (mask & FIELD_MASK_DRONE_STATUS) {
+        BpDecodeUint(sizeof(DroneStatus), 3, ctx, (void *)&(m->status));
+    } else {
+        ctx->i += 3;
+    }
+    if (mask & FIELD_MASK_DRONE_POSITION) {
+        BpXXXProcessPosition((void *)&(m->position), ctx);
+    } else {
+        ctx->i += 96;
+    }
+    if (mask & FIELD_MASK_DRONE_FLIGHT) {
+        BpXXXProcessFlight((void *)&(m->flight), ctx);
+    } else {
+        ctx->i += 288;
+    }
+    if (mask & FIELD_MASK_DRONE_PROPELLERS) {
+        BpXXXProcessArrayDrone4((void *)&(m->propellers), ctx);
+    } else {
+        ctx->i += 48;
+    }
+    if (mask & FIELD_MASK_DRONE_POWER) {
+        BpXXXProcessPower((void *)&(m->power), ctx);
+    } else {
+        ctx->i += 11;
+    }
+    if (mask & FIELD_MASK_DRONE_NETWORK) {
+        BpXXXProcessNetwork((void *)&(m->network), ctx);
+    } else {
+        ctx->i += 36;
+    }
+    if (mask & FIELD_MASK_DRONE_LANDING_GEAR) {
+        BpXXXProcessLandingGear((void *)&(m->landing_gear), ctx);
+    } else {
+        ctx->i += 2;
+    }
+    if (mask & FIELD_MASK_DRONE_PRESSURE_SENSOR) {
+        BpXXXProcessPressureSensor((void *)&(m->pressure_sensor), ctx);
+    } else {
+        ctx->i += 48;
+    }
+    return 0;
+}
+
+int EncodeDroneBatch(const struct Drone *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = s + k * BYTES_LENGTH_DRONE;
+        ctx.i = 0;
+        BpXXXProcessDrone((void *)&ms[k], &ctx);
+        BpEncodePadding(&ctx);
+    }
     return 0;
 }
 
+int DecodeDroneBatch(struct Drone *ms, size_t count, const unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(false, s);
+    for (size_t k = 0; k < count; k++) {
+        ctx.s = (unsigned char *)s + k * BYTES_LENGTH_DRONE;
+        ctx.i = 0;
+        BpXXXProcessDrone((void *)&ms[k], &ctx);
+    }
+    return 0;
+}
+
+#ifdef BP_PARALLEL
+static int BpXXXEncodeDroneBatch(void *ms, size_t count, unsigned char *s) {
+    return EncodeDroneBatch((const struct Drone *)ms, count, s);
+}
+
+int EncodeDroneBatchParallel(const struct Drone *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXEncodeDroneBatch, (void *)ms, sizeof(struct Drone), s, BYTES_LENGTH_DRONE, count, nthreads);
+}
+
+static int BpXXXDecodeDroneBatch(void *ms, size_t count, unsigned char *s) {
+    return DecodeDroneBatch((struct Drone *)ms, count, s);
+}
+
+int DecodeDroneBatchParallel(struct Drone *ms, size_t count, unsigned char *s, int nthreads) {
+    return BpParallelBatch(BpXXXDecodeDroneBatch, (void *)ms, sizeof(struct Drone), s, BYTES_LENGTH_DRONE, count, nthreads);
+}
+#endif
+
+#ifdef BP_RING
+int EncodeDroneInto(struct BpRing *r, const struct Drone *m) {
+    unsigned char *s = BpRingAcquire(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = EncodeDrone(m, s);
+    BpRingCommit(r);
+    return ret;
+}
+
+int DecodeDroneFrom(struct BpRing *r, struct Drone *m) {
+    const unsigned char *s = BpRingPeek(r);
+    if (s == NULL) return BP_ERR_RING;
+    int ret = DecodeDrone(m, s);
+    BpRingRelease(r);
+    return ret;
+}
+#endif
+
+#ifdef BP_MMSG
+int SendDroneBatch(int fd, const struct Drone *ms, size_t count, unsigned char *s, int flags) {
+    int ret = EncodeDroneBatch(ms, count, s);
+    if (ret < 0) return ret;
+    return BpSendFrames(fd, s, BYTES_LENGTH_DRONE, count, flags);
+}
+
+int RecvDroneBatch(int fd, struct Drone *ms, size_t count, unsigned char *s, int flags) {
+    int n = BpRecvFrames(fd, s, BYTES_LENGTH_DRONE, count, flags);
+    if (n <= 0) return n;
+    int ret = DecodeDroneBatch(ms, (size_t)n, s);
+    return (ret < 0) ? ret : n;
+}
+#endif
+
+uint64_t HashDrone(const struct Drone *m) {
+    uint64_t h = BP_HASH_INIT;
+    BP_HASH_MIX(h, ((uint64_t)((*m).status) & 7ULL));
+    for (int j = 0; j < 48; j += 8) {
+        uint64_t w;
+        memcpy(&w, (const unsigned char *)(&((*m).position)) + j, 8);
+        BP_HASH_MIX(h, w);
+    }
+    for (int k0 = 0; k0 < 4; k0++) {
+        BP_HASH_MIX(h, (uint64_t)((*m).propellers[k0].id));
+        BP_HASH_MIX(h, ((uint64_t)((*m).propellers[k0].status) & 3ULL));
+        BP_HASH_MIX(h, ((uint64_t)((*m).propellers[k0].direction) & 3ULL));
+    }
+    BP_HASH_MIX(h, (uint64_t)((*m).power.battery));
+    BP_HASH_MIX(h, ((uint64_t)((*m).power.status) & 3ULL));
+    BP_HASH_MIX(h, (uint64_t)((*m).power.is_charging));
+    BP_HASH_MIX(h, ((uint64_t)((*m).network.signal) & 15ULL));
+    BP_HASH_MIX(h, (uint64_t)((*m).network.heartbeat_at));
+    BP_HASH_MIX(h, ((uint64_t)((*m).landing_gear.status) & 3ULL));
+    for (int k0 = 0; k0 < 2; k0++) {
+        BP_HASH_MIX(h, ((uint64_t)((*m).pressure_sensor.pressures[k0]) & 16777215ULL));
+    }
+    return h;
+}
+
+bool EqualDrone(const struct Drone *a, const struct Drone *b) {
+    if (((uint64_t)((*a).status) & 7ULL) != ((uint64_t)((*b).status) & 7ULL)) return false;
+    if (memcmp(&((*a).position), &((*b).position), 48) != 0) return false;
+    for (int k0 = 0; k0 < 4; k0++) {
+        if ((uint64_t)((*a).propellers[k0].id) != (uint64_t)((*b).propellers[k0].id)) return false;
+        if (((uint64_t)((*a).propellers[k0].status) & 3ULL) != ((uint64_t)((*b).propellers[k0].status) & 3ULL)) return false;
+        if (((uint64_t)((*a).propellers[k0].direction) & 3ULL) != ((uint64_t)((*b).propellers[k0].direction) & 3ULL)) return false;
+    }
+    if ((uint64_t)((*a).power.battery) != (uint64_t)((*b).power.battery)) return false;
+    if (((uint64_t)((*a).power.status) & 3ULL) != ((uint64_t)((*b).power.status) & 3ULL)) return false;
+    if ((uint64_t)((*a).power.is_charging) != (uint64_t)((*b).power.is_charging)) return false;
+    if (((uint64_t)((*a).network.signal) & 15ULL) != ((uint64_t)((*b).network.signal) & 15ULL)) return false;
+    if ((uint64_t)((*a).network.heartbeat_at) != (uint64_t)((*b).network.heartbeat_at)) return false;
+    if (((uint64_t)((*a).landing_gear.status) & 3ULL) != ((uint64_t)((*b).landing_gear.status) & 3ULL)) return false;
+    for (int k0 = 0; k0 < 2; k0++) {
+        if (((uint64_t)((*a).pressure_sensor.pressures[k0]) & 16777215ULL) != ((uint64_t)((*b).pressure_sensor.pressures[k0]) & 16777215ULL)) return false;
+    }
+    return true;
+}
+
+#ifndef BP_NO_JSON
+void BpXXXJsonFormatDrone(void *data, struct BpJsonFormatContext *ctx) {
+    BpJsonFormatMessage(&BpXXXMessageDescriptorDrone, ctx, data);
+}
+
 int JsonDrone(struct Drone *m, char *s) {
     struct BpJsonFormatContext ctx = BpJsonFormatContext(s);
     BpXXXJsonFormatDrone((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonDroneN(struct Drone *m, char *s, int n) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextN(s, n);
+    BpXXXJsonFormatDrone((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
+    return ctx.n;
+}
+
+int JsonDroneSink(struct Drone *m, char *s, int n, BpSink sink, void *arg) {
+    struct BpJsonFormatContext ctx = BpJsonFormatContextSink(s, n, sink, arg);
+    BpXXXJsonFormatDrone((void *)m, &ctx);
+    BpJsonFormatEnd(&ctx);
     return ctx.n;
-}
\ No newline at end of file
+}
+
+static void BpXXXJsonParseArrayDrone4(void *data, struct BpJsonParseContext *ctx) {
+    struct Propeller *a = (struct Propeller *)data;
+    for (int k = 0; BpJsonParseNextElement(ctx, k, 4); k++) {
+        BpXXXJsonParsePropeller((void *)&(a[k]), ctx);
+    }
+}
+
+void BpXXXJsonParseDrone(void *data, struct BpJsonParseContext *ctx) {
+    struct Drone *m = (struct Drone *)data;
+    const char *key;
+    int n;
+    for (int k = 0; BpJsonParseNextKey(ctx, k, &key, &n); k++) {
+        switch (n) {
+            case 5:
+                if (memcmp(key, "power", 5) == 0) {
+                    BpXXXJsonParsePower((void *)&(m->power), ctx);
+                    continue;
+                }
+                break;
+            case 6:
+                if (memcmp(key, "status", 6) == 0) {
+                    BpJsonParseBaseType(BP_TYPE_ENUM, 3, ctx, (void *)&(m->status));
+                    continue;
+                }
+                if (memcmp(key, "flight", 6) == 0) {
+                    BpXXXJsonParseFlight((void *)&(m->flight), ctx);
+                    continue;
+                }
+                break;
+            case 7:
+                if (memcmp(key, "network", 7) == 0) {
+                    BpXXXJsonParseNetwork((void *)&(m->network), ctx);
+                    continue;
+                }
+                break;
+            case 8:
+                if (memcmp(key, "position", 8) == 0) {
+                    BpXXXJsonParsePosition((void *)&(m->position), ctx);
+                    continue;
+                }
+                break;
+            case 10:
+                if (memcmp(key, "propellers", 10) == 0) {
+                    BpXXXJsonParseArrayDrone4((void *)&(m->propellers), ctx);
+                    continue;
+                }
+                break;
+            case 12:
+                if (memcmp(key, "landing_gear", 12) == 0) {
+                    BpXXXJsonParseLandingGear((void *)&(m->landing_gear), ctx);
+                    continue;
+                }
+                break;
+            case 15:
+                if (memcmp(key, "pressure_sensor", 15) == 0) {
+                    BpXXXJsonParsePressureSensor((void *)&(m->pressure_sensor), ctx);
+                    continue;
+                }
+                break;
+        }
+        BpJsonParseSkip(ctx);
+    }
+}
+
+int ParseJsonDrone(struct Drone *m, const char *s, int n) {
+    struct BpJsonParseContext ctx = BpJsonParseContext(s, n);
+    BpXXXJsonParseDrone((void *)m, &ctx);
+    return BpJsonParseEnd(&ctx);
+}
+#endif
\ No newline at end of file
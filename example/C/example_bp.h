@@ -5,6 +5,8 @@
 #ifndef __BITPROTO__DRONE_H__
 #define __BITPROTO__DRONE_H__ 1
 
+#include "bitproto.h"
+
 #include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -12,8 +14,6 @@
 #include <stdbool.h>
 #endif
 
-#include "bitproto.h"
-
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -56,6 +56,29 @@ typedef uint8_t LandingGearStatus; // 2bit
 
 // Number of bytes to encode struct Propeller
 #define BYTES_LENGTH_PROPELLER 2
+// Layout fingerprint of struct Propeller, to check compatibility
+#define FINGERPRINT_PROPELLER 0x1241850b2d64cf1dULL
+
+// Bit offsets and number of bits of the fields of struct Propeller
+#define BP_OFFSET_BITS_PROPELLER_ID 0
+#define BP_NBITS_PROPELLER_ID 8
+#define BP_OFFSET_BITS_PROPELLER_STATUS 8
+#define BP_NBITS_PROPELLER_STATUS 2
+#define BP_OFFSET_BITS_PROPELLER_DIRECTION 10
+#define BP_NBITS_PROPELLER_DIRECTION 2
+// Number of entries in BP_FIELDS_PROPELLER
+#define BP_NFIELDS_PROPELLER 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_PROPELLER]
+#define BP_FIELDS_PROPELLER { \
+    {"id", 0, 8}, \
+    {"status", 8, 2}, \
+    {"direction", 10, 2}, \
+}
+
+// Mask bits selecting the fields of struct Propeller in DecodePropellerMasked
+#define FIELD_MASK_PROPELLER_ID (1ULL << 0)
+#define FIELD_MASK_PROPELLER_STATUS (1ULL << 1)
+#define FIELD_MASK_PROPELLER_DIRECTION (1ULL << 2)
 
 struct Propeller {
     uint8_t id; // 8bit
@@ -65,6 +88,29 @@ struct Propeller {
 
 // Number of bytes to encode struct Power
 #define BYTES_LENGTH_POWER 2
+// Layout fingerprint of struct Power, to check compatibility
+#define FINGERPRINT_POWER 0x7f6afefbea0323acULL
+
+// Bit offsets and number of bits of the fields of struct Power
+#define BP_OFFSET_BITS_POWER_BATTERY 0
+#define BP_NBITS_POWER_BATTERY 8
+#define BP_OFFSET_BITS_POWER_STATUS 8
+#define BP_NBITS_POWER_STATUS 2
+#define BP_OFFSET_BITS_POWER_IS_CHARGING 10
+#define BP_NBITS_POWER_IS_CHARGING 1
+// Number of entries in BP_FIELDS_POWER
+#define BP_NFIELDS_POWER 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_POWER]
+#define BP_FIELDS_POWER { \
+    {"battery", 0, 8}, \
+    {"status", 8, 2}, \
+    {"is_charging", 10, 1}, \
+}
+
+// Mask bits selecting the fields of struct Power in DecodePowerMasked
+#define FIELD_MASK_POWER_BATTERY (1ULL << 0)
+#define FIELD_MASK_POWER_STATUS (1ULL << 1)
+#define FIELD_MASK_POWER_IS_CHARGING (1ULL << 2)
 
 struct Power {
     uint8_t battery; // 8bit
@@ -74,6 +120,25 @@ struct Power {
 
 // Number of bytes to encode struct Network
 #define BYTES_LENGTH_NETWORK 5
+// Layout fingerprint of struct Network, to check compatibility
+#define FINGERPRINT_NETWORK 0x1c0359e538b559ecULL
+
+// Bit offsets and number of bits of the fields of struct Network
+#define BP_OFFSET_BITS_NETWORK_SIGNAL 0
+#define BP_NBITS_NETWORK_SIGNAL 4
+#define BP_OFFSET_BITS_NETWORK_HEARTBEAT_AT 4
+#define BP_NBITS_NETWORK_HEARTBEAT_AT 32
+// Number of entries in BP_FIELDS_NETWORK
+#define BP_NFIELDS_NETWORK 2
+// Initializer of struct BpFieldLayout[BP_NFIELDS_NETWORK]
+#define BP_FIELDS_NETWORK { \
+    {"signal", 0, 4}, \
+    {"heartbeat_at", 4, 32}, \
+}
+
+// Mask bits selecting the fields of struct Network in DecodeNetworkMasked
+#define FIELD_MASK_NETWORK_SIGNAL (1ULL << 0)
+#define FIELD_MASK_NETWORK_HEARTBEAT_AT (1ULL << 1)
 
 struct Network {
     // Degree of signal, between 1~10.
@@ -84,6 +149,21 @@ struct Network {
 
 // Number of bytes to encode struct LandingGear
 #define BYTES_LENGTH_LANDING_GEAR 1
+// Layout fingerprint of struct LandingGear, to check compatibility
+#define FINGERPRINT_LANDING_GEAR 0x5121345b5280acf2ULL
+
+// Bit offsets and number of bits of the fields of struct LandingGear
+#define BP_OFFSET_BITS_LANDING_GEAR_STATUS 0
+#define BP_NBITS_LANDING_GEAR_STATUS 2
+// Number of entries in BP_FIELDS_LANDING_GEAR
+#define BP_NFIELDS_LANDING_GEAR 1
+// Initializer of struct BpFieldLayout[BP_NFIELDS_LANDING_GEAR]
+#define BP_FIELDS_LANDING_GEAR { \
+    {"status", 0, 2}, \
+}
+
+// Mask bits selecting the fields of struct LandingGear in DecodeLandingGearMasked
+#define FIELD_MASK_LANDING_GEAR_STATUS (1ULL << 0)
 
 struct LandingGear {
     LandingGearStatus status; // 2bit
@@ -91,6 +171,29 @@ struct LandingGear {
 
 // Number of bytes to encode struct Position
 #define BYTES_LENGTH_POSITION 12
+// Layout fingerprint of struct Position, to check compatibility
+#define FINGERPRINT_POSITION 0x630a402d68f5f706ULL
+
+// Bit offsets and number of bits of the fields of struct Position
+#define BP_OFFSET_BITS_POSITION_LATITUDE 0
+#define BP_NBITS_POSITION_LATITUDE 32
+#define BP_OFFSET_BITS_POSITION_LONGITUDE 32
+#define BP_NBITS_POSITION_LONGITUDE 32
+#define BP_OFFSET_BITS_POSITION_ALTITUDE 64
+#define BP_NBITS_POSITION_ALTITUDE 32
+// Number of entries in BP_FIELDS_POSITION
+#define BP_NFIELDS_POSITION 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_POSITION]
+#define BP_FIELDS_POSITION { \
+    {"latitude", 0, 32}, \
+    {"longitude", 32, 32}, \
+    {"altitude", 64, 32}, \
+}
+
+// Mask bits selecting the fields of struct Position in DecodePositionMasked
+#define FIELD_MASK_POSITION_LATITUDE (1ULL << 0)
+#define FIELD_MASK_POSITION_LONGITUDE (1ULL << 1)
+#define FIELD_MASK_POSITION_ALTITUDE (1ULL << 2)
 
 struct Position {
     uint32_t latitude; // 32bit
@@ -100,6 +203,29 @@ struct Position {
 
 // Number of bytes to encode struct Pose
 #define BYTES_LENGTH_POSE 12
+// Layout fingerprint of struct Pose, to check compatibility
+#define FINGERPRINT_POSE 0xc2e32b9442c9c9a5ULL
+
+// Bit offsets and number of bits of the fields of struct Pose
+#define BP_OFFSET_BITS_POSE_YAW 0
+#define BP_NBITS_POSE_YAW 32
+#define BP_OFFSET_BITS_POSE_PITCH 32
+#define BP_NBITS_POSE_PITCH 32
+#define BP_OFFSET_BITS_POSE_ROLL 64
+#define BP_NBITS_POSE_ROLL 32
+// Number of entries in BP_FIELDS_POSE
+#define BP_NFIELDS_POSE 3
+// Initializer of struct BpFieldLayout[BP_NFIELDS_POSE]
+#define BP_FIELDS_POSE { \
+    {"yaw", 0, 32}, \
+    {"pitch", 32, 32}, \
+    {"roll", 64, 32}, \
+}
+
+// Mask bits selecting the fields of struct Pose in DecodePoseMasked
+#define FIELD_MASK_POSE_YAW (1ULL << 0)
+#define FIELD_MASK_POSE_PITCH (1ULL << 1)
+#define FIELD_MASK_POSE_ROLL (1ULL << 2)
 
 // Pose in flight. https://en.wikipedia.org/wiki/Aircraft_principal_axes
 struct Pose {
@@ -110,6 +236,38 @@ struct Pose {
 
 // Number of bytes to encode struct Flight
 #define BYTES_LENGTH_FLIGHT 36
+// Layout fingerprint of struct Flight, to check compatibility
+#define FINGERPRINT_FLIGHT 0xcc6f06d016770753ULL
+
+// Bit offsets and number of bits of the fields of struct Flight
+#define BP_OFFSET_BITS_FLIGHT_POSE 0
+#define BP_NBITS_FLIGHT_POSE 96
+#define BP_OFFSET_BITS_FLIGHT_POSE_YAW 0
+#define BP_NBITS_FLIGHT_POSE_YAW 32
+#define BP_OFFSET_BITS_FLIGHT_POSE_PITCH 32
+#define BP_NBITS_FLIGHT_POSE_PITCH 32
+#define BP_OFFSET_BITS_FLIGHT_POSE_ROLL 64
+#define BP_NBITS_FLIGHT_POSE_ROLL 32
+#define BP_OFFSET_BITS_FLIGHT_VELOCITY 96
+#define BP_NBITS_FLIGHT_VELOCITY 96
+#define BP_OFFSET_BITS_FLIGHT_ACCELERATION 192
+#define BP_NBITS_FLIGHT_ACCELERATION 96
+// Number of entries in BP_FIELDS_FLIGHT
+#define BP_NFIELDS_FLIGHT 6
+// Initializer of struct BpFieldLayout[BP_NFIELDS_FLIGHT]
+#define BP_FIELDS_FLIGHT { \
+    {"pose", 0, 96}, \
+    {"pose.yaw", 0, 32}, \
+    {"pose.pitch", 32, 32}, \
+    {"pose.roll", 64, 32}, \
+    {"velocity", 96, 96}, \
+    {"acceleration", 192, 96}, \
+}
+
+// Mask bits selecting the fields of struct Flight in DecodeFlightMasked
+#define FIELD_MASK_FLIGHT_POSE (1ULL << 0)
+#define FIELD_MASK_FLIGHT_VELOCITY (1ULL << 1)
+#define FIELD_MASK_FLIGHT_ACCELERATION (1ULL << 2)
 
 struct Flight {
     struct Pose pose; // 96bit
@@ -121,6 +279,21 @@ struct Flight {
 
 // Number of bytes to encode struct PressureSensor
 #define BYTES_LENGTH_PRESSURE_SENSOR 6
+// Layout fingerprint of struct PressureSensor, to check compatibility
+#define FINGERPRINT_PRESSURE_SENSOR 0x25520a077a42ca16ULL
+
+// Bit offsets and number of bits of the fields of struct PressureSensor
+#define BP_OFFSET_BITS_PRESSURE_SENSOR_PRESSURES 0
+#define BP_NBITS_PRESSURE_SENSOR_PRESSURES 48
+// Number of entries in BP_FIELDS_PRESSURE_SENSOR
+#define BP_NFIELDS_PRESSURE_SENSOR 1
+// Initializer of struct BpFieldLayout[BP_NFIELDS_PRESSURE_SENSOR]
+#define BP_FIELDS_PRESSURE_SENSOR { \
+    {"pressures", 0, 48}, \
+}
+
+// Mask bits selecting the fields of struct PressureSensor in DecodePressureSensorMasked
+#define FIELD_MASK_PRESSURE_SENSOR_PRESSURES (1ULL << 0)
 
 struct PressureSensor {
     int32_t pressures[2]; // 48bit
@@ -128,6 +301,97 @@ struct PressureSensor {
 
 // Number of bytes to encode struct Drone
 #define BYTES_LENGTH_DRONE 67
+// Layout fingerprint of struct Drone, to check compatibility
+#define FINGERPRINT_DRONE 0x91865dcd474f9fe9ULL
+
+// Bit offsets and number of bits of the fields of struct Drone
+#define BP_OFFSET_BITS_DRONE_STATUS 0
+#define BP_NBITS_DRONE_STATUS 3
+#define BP_OFFSET_BITS_DRONE_POSITION 3
+#define BP_NBITS_DRONE_POSITION 96
+#define BP_OFFSET_BITS_DRONE_POSITION_LATITUDE 3
+#define BP_NBITS_DRONE_POSITION_LATITUDE 32
+#define BP_OFFSET_BITS_DRONE_POSITION_LONGITUDE 35
+#define BP_NBITS_DRONE_POSITION_LONGITUDE 32
+#define BP_OFFSET_BITS_DRONE_POSITION_ALTITUDE 67
+#define BP_NBITS_DRONE_POSITION_ALTITUDE 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT 99
+#define BP_NBITS_DRONE_FLIGHT 288
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE 99
+#define BP_NBITS_DRONE_FLIGHT_POSE 96
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE_YAW 99
+#define BP_NBITS_DRONE_FLIGHT_POSE_YAW 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE_PITCH 131
+#define BP_NBITS_DRONE_FLIGHT_POSE_PITCH 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT_POSE_ROLL 163
+#define BP_NBITS_DRONE_FLIGHT_POSE_ROLL 32
+#define BP_OFFSET_BITS_DRONE_FLIGHT_VELOCITY 195
+#define BP_NBITS_DRONE_FLIGHT_VELOCITY 96
+#define BP_OFFSET_BITS_DRONE_FLIGHT_ACCELERATION 291
+#define BP_NBITS_DRONE_FLIGHT_ACCELERATION 96
+#define BP_OFFSET_BITS_DRONE_PROPELLERS 387
+#define BP_NBITS_DRONE_PROPELLERS 48
+#define BP_OFFSET_BITS_DRONE_POWER 435
+#define BP_NBITS_DRONE_POWER 11
+#define BP_OFFSET_BITS_DRONE_POWER_BATTERY 435
+#define BP_NBITS_DRONE_POWER_BATTERY 8
+#define BP_OFFSET_BITS_DRONE_POWER_STATUS 443
+#define BP_NBITS_DRONE_POWER_STATUS 2
+#define BP_OFFSET_BITS_DRONE_POWER_IS_CHARGING 445
+#define BP_NBITS_DRONE_POWER_IS_CHARGING 1
+#define BP_OFFSET_BITS_DRONE_NETWORK 446
+#define BP_NBITS_DRONE_NETWORK 36
+#define BP_OFFSET_BITS_DRONE_NETWORK_SIGNAL 446
+#define BP_NBITS_DRONE_NETWORK_SIGNAL 4
+#define BP_OFFSET_BITS_DRONE_NETWORK_HEARTBEAT_AT 450
+#define BP_NBITS_DRONE_NETWORK_HEARTBEAT_AT 32
+#define BP_OFFSET_BITS_DRONE_LANDING_GEAR 482
+#define BP_NBITS_DRONE_LANDING_GEAR 2
+#define BP_OFFSET_BITS_DRONE_LANDING_GEAR_STATUS 482
+#define BP_NBITS_DRONE_LANDING_GEAR_STATUS 2
+#define BP_OFFSET_BITS_DRONE_PRESSURE_SENSOR 484
+#define BP_NBITS_DRONE_PRESSURE_SENSOR 48
+#define BP_OFFSET_BITS_DRONE_PRESSURE_SENSOR_PRESSURES 484
+#define BP_NBITS_DRONE_PRESSURE_SENSOR_PRESSURES 48
+// Number of entries in BP_FIELDS_DRONE
+#define BP_NFIELDS_DRONE 24
+// Initializer of struct BpFieldLayout[BP_NFIELDS_DRONE]
+#define BP_FIELDS_DRONE { \
+    {"status", 0, 3}, \
+    {"position", 3, 96}, \
+    {"position.latitude", 3, 32}, \
+    {"position.longitude", 35, 32}, \
+    {"position.altitude", 67, 32}, \
+    {"flight", 99, 288}, \
+    {"flight.pose", 99, 96}, \
+    {"flight.pose.yaw", 99, 32}, \
+    {"flight.pose.pitch", 131, 32}, \
+    {"flight.pose.roll", 163, 32}, \
+    {"flight.velocity", 195, 96}, \
+    {"flight.acceleration", 291, 96}, \
+    {"propellers", 387, 48}, \
+    {"power", 435, 11}, \
+    {"power.battery", 435, 8}, \
+    {"power.status", 443, 2}, \
+    {"power.is_charging", 445, 1}, \
+    {"network", 446, 36}, \
+    {"network.signal", 446, 4}, \
+    {"network.heartbeat_at", 450, 32}, \
+    {"landing_gear", 482, 2}, \
+    {"landing_gear.status", 482, 2}, \
+    {"pressure_sensor", 484, 48}, \
+    {"pressure_sensor.pressures", 484, 48}, \
+}
+
+// Mask bits selecting the fields of struct Drone in DecodeDroneMasked
+#define FIELD_MASK_DRONE_STATUS (1ULL << 0)
+#define FIELD_MASK_DRONE_POSITION (1ULL << 1)
+#define FIELD_MASK_DRONE_FLIGHT (1ULL << 2)
+#define FIELD_MASK_DRONE_PROPELLERS (1ULL << 3)
+#define FIELD_MASK_DRONE_POWER (1ULL << 4)
+#define FIELD_MASK_DRONE_NETWORK (1ULL << 5)
+#define FIELD_MASK_DRONE_LANDING_GEAR (1ULL << 6)
+#define FIELD_MASK_DRONE_PRESSURE_SENSOR (1ULL << 7)
 
 struct Drone {
     DroneStatus status; // 3bit
@@ -141,100 +405,950 @@ struct Drone {
 };
 
 // Encode struct Propeller to given buffer s.
-int EncodePropeller(struct Propeller *m, unsigned char *s);
+int EncodePropeller(const struct Propeller *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Propeller from given buffer s.
-int DecodePropeller(struct Propeller *m, unsigned char *s);
+int DecodePropeller(struct Propeller *m, const unsigned char *s);
+// Decode struct Propeller from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodePropellerN(struct Propeller *m, const unsigned char *s, int n);
+// Decode the fields of struct Propeller selected by mask, an or of FIELD_MASK_PROPELLER_*, from given buffer s. Others are skipped and left untouched.
+int DecodePropellerMasked(struct Propeller *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Propeller at ms to given buffer s, each takes BYTES_LENGTH_PROPELLER bytes.
+int EncodePropellerBatch(const struct Propeller *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Propeller to ms from given buffer s, each takes BYTES_LENGTH_PROPELLER bytes.
+int DecodePropellerBatch(struct Propeller *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodePropellerBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodePropellerBatchParallel(const struct Propeller *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodePropellerBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodePropellerBatchParallel(struct Propeller *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Propeller m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodePropellerInto(struct BpRing *r, const struct Propeller *m);
+// Decode struct Propeller m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodePropellerFrom(struct BpRing *r, struct Propeller *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Propeller at ms to given buffer s, and send each of the BYTES_LENGTH_PROPELLER bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendPropellerBatch(int fd, const struct Propeller *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_PROPELLER bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvPropellerBatch(int fd, struct Propeller *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Propeller by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualPropeller have the same hash, on the same host.
+uint64_t HashPropeller(const struct Propeller *m);
+// Returns true if the structs Propeller at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualPropeller(const struct Propeller *a, const struct Propeller *b);
+// Max length of the json string of struct Propeller, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_PROPELLER 39
+#ifndef BP_NO_JSON
 // Format struct Propeller to a json format string.
 int JsonPropeller(struct Propeller *m, char *s);
+// Format struct Propeller to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonPropellerN(struct Propeller *m, char *s, int n);
+// Format struct Propeller to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonPropellerSink(struct Propeller *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Propeller, in the format of JsonPropeller. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonPropeller(struct Propeller *m, const char *s, int n);
+#endif
 
 // Encode struct Power to given buffer s.
-int EncodePower(struct Power *m, unsigned char *s);
+int EncodePower(const struct Power *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Power from given buffer s.
-int DecodePower(struct Power *m, unsigned char *s);
+int DecodePower(struct Power *m, const unsigned char *s);
+// Decode struct Power from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodePowerN(struct Power *m, const unsigned char *s, int n);
+// Decode the fields of struct Power selected by mask, an or of FIELD_MASK_POWER_*, from given buffer s. Others are skipped and left untouched.
+int DecodePowerMasked(struct Power *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Power at ms to given buffer s, each takes BYTES_LENGTH_POWER bytes.
+int EncodePowerBatch(const struct Power *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Power to ms from given buffer s, each takes BYTES_LENGTH_POWER bytes.
+int DecodePowerBatch(struct Power *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodePowerBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodePowerBatchParallel(const struct Power *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodePowerBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodePowerBatchParallel(struct Power *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Power m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodePowerInto(struct BpRing *r, const struct Power *m);
+// Decode struct Power m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodePowerFrom(struct BpRing *r, struct Power *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Power at ms to given buffer s, and send each of the BYTES_LENGTH_POWER bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendPowerBatch(int fd, const struct Power *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_POWER bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvPowerBatch(int fd, struct Power *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Power by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualPower have the same hash, on the same host.
+uint64_t HashPower(const struct Power *m);
+// Returns true if the structs Power at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualPower(const struct Power *a, const struct Power *b);
+// Max length of the json string of struct Power, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_POWER 48
+#ifndef BP_NO_JSON
 // Format struct Power to a json format string.
 int JsonPower(struct Power *m, char *s);
+// Format struct Power to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonPowerN(struct Power *m, char *s, int n);
+// Format struct Power to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonPowerSink(struct Power *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Power, in the format of JsonPower. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonPower(struct Power *m, const char *s, int n);
+#endif
 
 // Encode struct Network to given buffer s.
-int EncodeNetwork(struct Network *m, unsigned char *s);
+int EncodeNetwork(const struct Network *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Network from given buffer s.
-int DecodeNetwork(struct Network *m, unsigned char *s);
+int DecodeNetwork(struct Network *m, const unsigned char *s);
+// Decode struct Network from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodeNetworkN(struct Network *m, const unsigned char *s, int n);
+// Decode the fields of struct Network selected by mask, an or of FIELD_MASK_NETWORK_*, from given buffer s. Others are skipped and left untouched.
+int DecodeNetworkMasked(struct Network *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Network at ms to given buffer s, each takes BYTES_LENGTH_NETWORK bytes.
+int EncodeNetworkBatch(const struct Network *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Network to ms from given buffer s, each takes BYTES_LENGTH_NETWORK bytes.
+int DecodeNetworkBatch(struct Network *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodeNetworkBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodeNetworkBatchParallel(const struct Network *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodeNetworkBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodeNetworkBatchParallel(struct Network *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Network m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodeNetworkInto(struct BpRing *r, const struct Network *m);
+// Decode struct Network m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodeNetworkFrom(struct BpRing *r, struct Network *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Network at ms to given buffer s, and send each of the BYTES_LENGTH_NETWORK bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendNetworkBatch(int fd, const struct Network *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_NETWORK bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvNetworkBatch(int fd, struct Network *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Network by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualNetwork have the same hash, on the same host.
+uint64_t HashNetwork(const struct Network *m);
+// Returns true if the structs Network at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualNetwork(const struct Network *a, const struct Network *b);
+// Max length of the json string of struct Network, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_NETWORK 41
+#ifndef BP_NO_JSON
 // Format struct Network to a json format string.
 int JsonNetwork(struct Network *m, char *s);
+// Format struct Network to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonNetworkN(struct Network *m, char *s, int n);
+// Format struct Network to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonNetworkSink(struct Network *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Network, in the format of JsonNetwork. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonNetwork(struct Network *m, const char *s, int n);
+#endif
 
 // Encode struct LandingGear to given buffer s.
-int EncodeLandingGear(struct LandingGear *m, unsigned char *s);
+int EncodeLandingGear(const struct LandingGear *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct LandingGear from given buffer s.
-int DecodeLandingGear(struct LandingGear *m, unsigned char *s);
+int DecodeLandingGear(struct LandingGear *m, const unsigned char *s);
+// Decode struct LandingGear from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodeLandingGearN(struct LandingGear *m, const unsigned char *s, int n);
+// Decode the fields of struct LandingGear selected by mask, an or of FIELD_MASK_LANDING_GEAR_*, from given buffer s. Others are skipped and left untouched.
+int DecodeLandingGearMasked(struct LandingGear *m, const unsigned char *s, uint64_t mask);
+// Encode count structs LandingGear at ms to given buffer s, each takes BYTES_LENGTH_LANDING_GEAR bytes.
+int EncodeLandingGearBatch(const struct LandingGear *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs LandingGear to ms from given buffer s, each takes BYTES_LENGTH_LANDING_GEAR bytes.
+int DecodeLandingGearBatch(struct LandingGear *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodeLandingGearBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodeLandingGearBatchParallel(const struct LandingGear *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodeLandingGearBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodeLandingGearBatchParallel(struct LandingGear *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct LandingGear m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodeLandingGearInto(struct BpRing *r, const struct LandingGear *m);
+// Decode struct LandingGear m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodeLandingGearFrom(struct BpRing *r, struct LandingGear *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs LandingGear at ms to given buffer s, and send each of the BYTES_LENGTH_LANDING_GEAR bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendLandingGearBatch(int fd, const struct LandingGear *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_LANDING_GEAR bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvLandingGearBatch(int fd, struct LandingGear *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct LandingGear by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualLandingGear have the same hash, on the same host.
+uint64_t HashLandingGear(const struct LandingGear *m);
+// Returns true if the structs LandingGear at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualLandingGear(const struct LandingGear *a, const struct LandingGear *b);
+// Max length of the json string of struct LandingGear, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_LANDING_GEAR 14
+#ifndef BP_NO_JSON
 // Format struct LandingGear to a json format string.
 int JsonLandingGear(struct LandingGear *m, char *s);
+// Format struct LandingGear to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonLandingGearN(struct LandingGear *m, char *s, int n);
+// Format struct LandingGear to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonLandingGearSink(struct LandingGear *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct LandingGear, in the format of JsonLandingGear. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonLandingGear(struct LandingGear *m, const char *s, int n);
+#endif
 
 // Encode struct Position to given buffer s.
-int EncodePosition(struct Position *m, unsigned char *s);
+int EncodePosition(const struct Position *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Position from given buffer s.
-int DecodePosition(struct Position *m, unsigned char *s);
+int DecodePosition(struct Position *m, const unsigned char *s);
+// Decode struct Position from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodePositionN(struct Position *m, const unsigned char *s, int n);
+// Decode the fields of struct Position selected by mask, an or of FIELD_MASK_POSITION_*, from given buffer s. Others are skipped and left untouched.
+int DecodePositionMasked(struct Position *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Position at ms to given buffer s, each takes BYTES_LENGTH_POSITION bytes.
+int EncodePositionBatch(const struct Position *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Position to ms from given buffer s, each takes BYTES_LENGTH_POSITION bytes.
+int DecodePositionBatch(struct Position *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodePositionBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodePositionBatchParallel(const struct Position *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodePositionBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodePositionBatchParallel(struct Position *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Position m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodePositionInto(struct BpRing *r, const struct Position *m);
+// Decode struct Position m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodePositionFrom(struct BpRing *r, struct Position *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Position at ms to given buffer s, and send each of the BYTES_LENGTH_POSITION bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendPositionBatch(int fd, const struct Position *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_POSITION bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvPositionBatch(int fd, struct Position *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Position by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualPosition have the same hash, on the same host.
+uint64_t HashPosition(const struct Position *m);
+// Returns true if the structs Position at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualPosition(const struct Position *a, const struct Position *b);
+// Max length of the json string of struct Position, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_POSITION 68
+#ifndef BP_NO_JSON
 // Format struct Position to a json format string.
 int JsonPosition(struct Position *m, char *s);
+// Format struct Position to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonPositionN(struct Position *m, char *s, int n);
+// Format struct Position to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonPositionSink(struct Position *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Position, in the format of JsonPosition. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonPosition(struct Position *m, const char *s, int n);
+#endif
 
 // Encode struct Pose to given buffer s.
-int EncodePose(struct Pose *m, unsigned char *s);
+int EncodePose(const struct Pose *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Pose from given buffer s.
-int DecodePose(struct Pose *m, unsigned char *s);
+int DecodePose(struct Pose *m, const unsigned char *s);
+// Decode struct Pose from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodePoseN(struct Pose *m, const unsigned char *s, int n);
+// Decode the fields of struct Pose selected by mask, an or of FIELD_MASK_POSE_*, from given buffer s. Others are skipped and left untouched.
+int DecodePoseMasked(struct Pose *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Pose at ms to given buffer s, each takes BYTES_LENGTH_POSE bytes.
+int EncodePoseBatch(const struct Pose *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Pose to ms from given buffer s, each takes BYTES_LENGTH_POSE bytes.
+int DecodePoseBatch(struct Pose *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodePoseBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodePoseBatchParallel(const struct Pose *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodePoseBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodePoseBatchParallel(struct Pose *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Pose m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodePoseInto(struct BpRing *r, const struct Pose *m);
+// Decode struct Pose m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodePoseFrom(struct BpRing *r, struct Pose *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Pose at ms to given buffer s, and send each of the BYTES_LENGTH_POSE bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendPoseBatch(int fd, const struct Pose *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_POSE bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvPoseBatch(int fd, struct Pose *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Pose by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualPose have the same hash, on the same host.
+uint64_t HashPose(const struct Pose *m);
+// Returns true if the structs Pose at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualPose(const struct Pose *a, const struct Pose *b);
+// Max length of the json string of struct Pose, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_POSE 58
+#ifndef BP_NO_JSON
 // Format struct Pose to a json format string.
 int JsonPose(struct Pose *m, char *s);
+// Format struct Pose to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonPoseN(struct Pose *m, char *s, int n);
+// Format struct Pose to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonPoseSink(struct Pose *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Pose, in the format of JsonPose. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonPose(struct Pose *m, const char *s, int n);
+#endif
 
 // Encode struct Flight to given buffer s.
-int EncodeFlight(struct Flight *m, unsigned char *s);
+int EncodeFlight(const struct Flight *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Flight from given buffer s.
-int DecodeFlight(struct Flight *m, unsigned char *s);
+int DecodeFlight(struct Flight *m, const unsigned char *s);
+// Decode struct Flight from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodeFlightN(struct Flight *m, const unsigned char *s, int n);
+// Decode the fields of struct Flight selected by mask, an or of FIELD_MASK_FLIGHT_*, from given buffer s. Others are skipped and left untouched.
+int DecodeFlightMasked(struct Flight *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Flight at ms to given buffer s, each takes BYTES_LENGTH_FLIGHT bytes.
+int EncodeFlightBatch(const struct Flight *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Flight to ms from given buffer s, each takes BYTES_LENGTH_FLIGHT bytes.
+int DecodeFlightBatch(struct Flight *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodeFlightBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodeFlightBatchParallel(const struct Flight *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodeFlightBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodeFlightBatchParallel(struct Flight *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Flight m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodeFlightInto(struct BpRing *r, const struct Flight *m);
+// Decode struct Flight m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodeFlightFrom(struct BpRing *r, struct Flight *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Flight at ms to given buffer s, and send each of the BYTES_LENGTH_FLIGHT bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendFlightBatch(int fd, const struct Flight *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_FLIGHT bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvFlightBatch(int fd, struct Flight *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Flight by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualFlight have the same hash, on the same host.
+uint64_t HashFlight(const struct Flight *m);
+// Returns true if the structs Flight at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualFlight(const struct Flight *a, const struct Flight *b);
+// Max length of the json string of struct Flight, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_FLIGHT 169
+#ifndef BP_NO_JSON
 // Format struct Flight to a json format string.
 int JsonFlight(struct Flight *m, char *s);
+// Format struct Flight to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonFlightN(struct Flight *m, char *s, int n);
+// Format struct Flight to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonFlightSink(struct Flight *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Flight, in the format of JsonFlight. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonFlight(struct Flight *m, const char *s, int n);
+#endif
 
 // Encode struct PressureSensor to given buffer s.
-int EncodePressureSensor(struct PressureSensor *m, unsigned char *s);
+int EncodePressureSensor(const struct PressureSensor *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct PressureSensor from given buffer s.
-int DecodePressureSensor(struct PressureSensor *m, unsigned char *s);
+int DecodePressureSensor(struct PressureSensor *m, const unsigned char *s);
+// Decode struct PressureSensor from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodePressureSensorN(struct PressureSensor *m, const unsigned char *s, int n);
+// Decode the fields of struct PressureSensor selected by mask, an or of FIELD_MASK_PRESSURE_SENSOR_*, from given buffer s. Others are skipped and left untouched.
+int DecodePressureSensorMasked(struct PressureSensor *m, const unsigned char *s, uint64_t mask);
+// Encode count structs PressureSensor at ms to given buffer s, each takes BYTES_LENGTH_PRESSURE_SENSOR bytes.
+int EncodePressureSensorBatch(const struct PressureSensor *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs PressureSensor to ms from given buffer s, each takes BYTES_LENGTH_PRESSURE_SENSOR bytes.
+int DecodePressureSensorBatch(struct PressureSensor *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodePressureSensorBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodePressureSensorBatchParallel(const struct PressureSensor *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodePressureSensorBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodePressureSensorBatchParallel(struct PressureSensor *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct PressureSensor m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodePressureSensorInto(struct BpRing *r, const struct PressureSensor *m);
+// Decode struct PressureSensor m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodePressureSensorFrom(struct BpRing *r, struct PressureSensor *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs PressureSensor at ms to given buffer s, and send each of the BYTES_LENGTH_PRESSURE_SENSOR bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendPressureSensorBatch(int fd, const struct PressureSensor *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_PRESSURE_SENSOR bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvPressureSensorBatch(int fd, struct PressureSensor *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct PressureSensor by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualPressureSensor have the same hash, on the same host.
+uint64_t HashPressureSensor(const struct PressureSensor *m);
+// Returns true if the structs PressureSensor at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualPressureSensor(const struct PressureSensor *a, const struct PressureSensor *b);
+// Max length of the json string of struct PressureSensor, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_PRESSURE_SENSOR 39
+#ifndef BP_NO_JSON
 // Format struct PressureSensor to a json format string.
 int JsonPressureSensor(struct PressureSensor *m, char *s);
+// Format struct PressureSensor to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonPressureSensorN(struct PressureSensor *m, char *s, int n);
+// Format struct PressureSensor to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonPressureSensorSink(struct PressureSensor *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct PressureSensor, in the format of JsonPressureSensor. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonPressureSensor(struct PressureSensor *m, const char *s, int n);
+#endif
 
 // Encode struct Drone to given buffer s.
-int EncodeDrone(struct Drone *m, unsigned char *s);
+int EncodeDrone(const struct Drone *BP_RESTRICT m, unsigned char *BP_RESTRICT s);
 // Decode struct Drone from given buffer s.
-int DecodeDrone(struct Drone *m, unsigned char *s);
+int DecodeDrone(struct Drone *m, const unsigned char *s);
+// Decode struct Drone from given buffer s of n bytes. Returns BP_ERR_SHORT_INPUT if s is too short.
+int DecodeDroneN(struct Drone *m, const unsigned char *s, int n);
+// Decode the fields of struct Drone selected by mask, an or of FIELD_MASK_DRONE_*, from given buffer s. Others are skipped and left untouched.
+int DecodeDroneMasked(struct Drone *m, const unsigned char *s, uint64_t mask);
+// Encode count structs Drone at ms to given buffer s, each takes BYTES_LENGTH_DRONE bytes.
+int EncodeDroneBatch(const struct Drone *BP_RESTRICT ms, size_t count, unsigned char *BP_RESTRICT s);
+// Decode count structs Drone to ms from given buffer s, each takes BYTES_LENGTH_DRONE bytes.
+int DecodeDroneBatch(struct Drone *ms, size_t count, const unsigned char *s);
+#ifdef BP_PARALLEL
+// The same to EncodeDroneBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int EncodeDroneBatchParallel(const struct Drone *ms, size_t count, unsigned char *s, int nthreads);
+// The same to DecodeDroneBatch, but shards the records across nthreads threads, or the number of online processors if nthreads <= 0.
+int DecodeDroneBatchParallel(struct Drone *ms, size_t count, unsigned char *s, int nthreads);
+#endif
+#ifdef BP_RING
+// Encode struct Drone m into the next slot of ring r and commit it, returns BP_ERR_RING if the ring is full.
+int EncodeDroneInto(struct BpRing *r, const struct Drone *m);
+// Decode struct Drone m from the oldest slot of ring r and release it, returns BP_ERR_RING if the ring is empty.
+int DecodeDroneFrom(struct BpRing *r, struct Drone *m);
+#endif
+#ifdef BP_MMSG
+// Encode count structs Drone at ms to given buffer s, and send each of the BYTES_LENGTH_DRONE bytes as a datagram to connected socket fd by sendmmsg. Returns the number of datagrams sent, or BP_ERR_MMSG.
+int SendDroneBatch(int fd, const struct Drone *ms, size_t count, unsigned char *s, int flags);
+// Receive at most count datagrams from socket fd by a single recvmmsg, each into BYTES_LENGTH_DRONE bytes of given buffer s, and decode them to ms. Returns the number of structs decoded, or BP_ERR_MMSG.
+int RecvDroneBatch(int fd, struct Drone *ms, size_t count, unsigned char *s, int flags);
+#endif
+// Hash struct Drone by the bits of its fields to encode, padding bytes and bits above the fields' widths are not hashed. Messages equal by EqualDrone have the same hash, on the same host.
+uint64_t HashDrone(const struct Drone *m);
+// Returns true if the structs Drone at a and b encode the same, without encoding them. Padding bytes and bits above the fields' widths are not compared, float32s are compared by bits.
+bool EqualDrone(const struct Drone *a, const struct Drone *b);
+// Max length of the json string of struct Drone, excluding the trailing null byte.
+#define JSON_MAX_LENGTH_DRONE 645
+#ifndef BP_NO_JSON
 // Format struct Drone to a json format string.
 int JsonDrone(struct Drone *m, char *s);
+// Format struct Drone to a json format string into given buffer s of n bytes, like snprintf. Returns the length of the full json string, the output is truncated if the returned value is not less than n.
+int JsonDroneN(struct Drone *m, char *s, int n);
+// Format struct Drone to a json format string through given sink in chunks, using buffer s of n bytes as the working buffer. Returns the length of the json string, no trailing null byte is written.
+int JsonDroneSink(struct Drone *m, char *s, int n, BpSink sink, void *arg);
+// Parse a json string of n bytes into struct Drone, in the format of JsonDrone. Fields and elements missing are left untouched, unknown keys are skipped. Returns 0 for success, or BP_ERR_JSON if it's malformed or a value is out of range.
+int ParseJsonDrone(struct Drone *m, const char *s, int n);
+#endif
+
+// Get field id of struct Propeller from given encoded buffer s.
+static inline uint8_t BpGetPropeller_id(const unsigned char *s) {
+    uint8_t v = 0;
+    ((unsigned char *)&(v))[0] = (s[0] ) & 255;
+    return v;
+}
+
+// Set field id of struct Propeller in given encoded buffer s in place.
+static inline void BpSetPropeller_id(unsigned char *s, uint8_t v) {
+    s[0] = (s[0] & 0) | ((((unsigned char *)&(v))[0] ) & 255);
+}
+
+// Get field status of struct Propeller from given encoded buffer s.
+static inline PropellerStatus BpGetPropeller_status(const unsigned char *s) {
+    PropellerStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[1] ) & 3;
+    return v;
+}
+
+// Set field status of struct Propeller in given encoded buffer s in place.
+static inline void BpSetPropeller_status(unsigned char *s, PropellerStatus v) {
+    s[1] = (s[1] & 252) | ((((unsigned char *)&(v))[0] ) & 3);
+}
+
+// Get field direction of struct Propeller from given encoded buffer s.
+static inline RotatingDirection BpGetPropeller_direction(const unsigned char *s) {
+    RotatingDirection v = 0;
+    ((unsigned char *)&(v))[0] = (s[1] >> 2) & 3;
+    return v;
+}
+
+// Set field direction of struct Propeller in given encoded buffer s in place.
+static inline void BpSetPropeller_direction(unsigned char *s, RotatingDirection v) {
+    s[1] = (s[1] & 243) | ((((unsigned char *)&(v))[0] << 2) & 12);
+}
+
+// Get field battery of struct Power from given encoded buffer s.
+static inline uint8_t BpGetPower_battery(const unsigned char *s) {
+    uint8_t v = 0;
+    ((unsigned char *)&(v))[0] = (s[0] ) & 255;
+    return v;
+}
+
+// Set field battery of struct Power in given encoded buffer s in place.
+static inline void BpSetPower_battery(unsigned char *s, uint8_t v) {
+    s[0] = (s[0] & 0) | ((((unsigned char *)&(v))[0] ) & 255);
+}
+
+// Get field status of struct Power from given encoded buffer s.
+static inline PowerStatus BpGetPower_status(const unsigned char *s) {
+    PowerStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[1] ) & 3;
+    return v;
+}
+
+// Set field status of struct Power in given encoded buffer s in place.
+static inline void BpSetPower_status(unsigned char *s, PowerStatus v) {
+    s[1] = (s[1] & 252) | ((((unsigned char *)&(v))[0] ) & 3);
+}
+
+// Get field is_charging of struct Power from given encoded buffer s.
+static inline bool BpGetPower_is_charging(const unsigned char *s) {
+    bool v = 0;
+    ((unsigned char *)&(v))[0] = (s[1] >> 2) & 1;
+    return v;
+}
+
+// Set field is_charging of struct Power in given encoded buffer s in place.
+static inline void BpSetPower_is_charging(unsigned char *s, bool v) {
+    s[1] = (s[1] & 251) | ((((unsigned char *)&(v))[0] << 2) & 4);
+}
+
+// Get field signal of struct Network from given encoded buffer s.
+static inline uint8_t BpGetNetwork_signal(const unsigned char *s) {
+    uint8_t v = 0;
+    ((unsigned char *)&(v))[0] = (s[0] ) & 15;
+    return v;
+}
+
+// Set field signal of struct Network in given encoded buffer s in place.
+static inline void BpSetNetwork_signal(unsigned char *s, uint8_t v) {
+    s[0] = (s[0] & 240) | ((((unsigned char *)&(v))[0] ) & 15);
+}
+
+// Get field heartbeat_at of struct Network from given encoded buffer s.
+static inline Timestamp BpGetNetwork_heartbeat_at(const unsigned char *s) {
+    Timestamp v = 0;
+    v = (Timestamp)((((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24 | (uint64_t)s[4] << 32) >> 4) & 4294967295);
+    return v;
+}
+
+// Set field heartbeat_at of struct Network in given encoded buffer s in place.
+static inline void BpSetNetwork_heartbeat_at(unsigned char *s, Timestamp v) {
+    s[0] = (s[0] & 15) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 4) & 240);
+    s[1] = (s[1] & 240) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 4) & 15);
+    s[1] = (s[1] & 15) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 4) & 240);
+    s[2] = (s[2] & 240) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 4) & 15);
+    s[2] = (s[2] & 15) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 4) & 240);
+    s[3] = (s[3] & 240) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 4) & 15);
+    s[3] = (s[3] & 15) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 4) & 240);
+    s[4] = (s[4] & 240) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 4) & 15);
+}
+
+// Get field status of struct LandingGear from given encoded buffer s.
+static inline LandingGearStatus BpGetLandingGear_status(const unsigned char *s) {
+    LandingGearStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[0] ) & 3;
+    return v;
+}
+
+// Set field status of struct LandingGear in given encoded buffer s in place.
+static inline void BpSetLandingGear_status(unsigned char *s, LandingGearStatus v) {
+    s[0] = (s[0] & 252) | ((((unsigned char *)&(v))[0] ) & 3);
+}
+
+// Get field latitude of struct Position from given encoded buffer s.
+static inline uint32_t BpGetPosition_latitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)(((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24) & 4294967295);
+    return v;
+}
+
+// Set field latitude of struct Position in given encoded buffer s in place.
+static inline void BpSetPosition_latitude(unsigned char *s, uint32_t v) {
+    s[0] = (s[0] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[1] = (s[1] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[2] = (s[2] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[3] = (s[3] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field longitude of struct Position from given encoded buffer s.
+static inline uint32_t BpGetPosition_longitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)(((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24) & 4294967295);
+    return v;
+}
+
+// Set field longitude of struct Position in given encoded buffer s in place.
+static inline void BpSetPosition_longitude(unsigned char *s, uint32_t v) {
+    s[4] = (s[4] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[5] = (s[5] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[6] = (s[6] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[7] = (s[7] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field altitude of struct Position from given encoded buffer s.
+static inline uint32_t BpGetPosition_altitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)(((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24) & 4294967295);
+    return v;
+}
+
+// Set field altitude of struct Position in given encoded buffer s in place.
+static inline void BpSetPosition_altitude(unsigned char *s, uint32_t v) {
+    s[8] = (s[8] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[9] = (s[9] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[10] = (s[10] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[11] = (s[11] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field yaw of struct Pose from given encoded buffer s.
+static inline int32_t BpGetPose_yaw(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)(((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24) & 4294967295);
+    return v;
+}
+
+// Set field yaw of struct Pose in given encoded buffer s in place.
+static inline void BpSetPose_yaw(unsigned char *s, int32_t v) {
+    s[0] = (s[0] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[1] = (s[1] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[2] = (s[2] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[3] = (s[3] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field pitch of struct Pose from given encoded buffer s.
+static inline int32_t BpGetPose_pitch(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)(((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24) & 4294967295);
+    return v;
+}
+
+// Set field pitch of struct Pose in given encoded buffer s in place.
+static inline void BpSetPose_pitch(unsigned char *s, int32_t v) {
+    s[4] = (s[4] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[5] = (s[5] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[6] = (s[6] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[7] = (s[7] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field roll of struct Pose from given encoded buffer s.
+static inline int32_t BpGetPose_roll(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)(((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24) & 4294967295);
+    return v;
+}
+
+// Set field roll of struct Pose in given encoded buffer s in place.
+static inline void BpSetPose_roll(unsigned char *s, int32_t v) {
+    s[8] = (s[8] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[9] = (s[9] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[10] = (s[10] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[11] = (s[11] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field pose.yaw of struct Flight from given encoded buffer s.
+static inline int32_t BpGetFlight_pose_yaw(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)(((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24) & 4294967295);
+    return v;
+}
+
+// Set field pose.yaw of struct Flight in given encoded buffer s in place.
+static inline void BpSetFlight_pose_yaw(unsigned char *s, int32_t v) {
+    s[0] = (s[0] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[1] = (s[1] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[2] = (s[2] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[3] = (s[3] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field pose.pitch of struct Flight from given encoded buffer s.
+static inline int32_t BpGetFlight_pose_pitch(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)(((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24) & 4294967295);
+    return v;
+}
+
+// Set field pose.pitch of struct Flight in given encoded buffer s in place.
+static inline void BpSetFlight_pose_pitch(unsigned char *s, int32_t v) {
+    s[4] = (s[4] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[5] = (s[5] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[6] = (s[6] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[7] = (s[7] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field pose.roll of struct Flight from given encoded buffer s.
+static inline int32_t BpGetFlight_pose_roll(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)(((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24) & 4294967295);
+    return v;
+}
+
+// Set field pose.roll of struct Flight in given encoded buffer s in place.
+static inline void BpSetFlight_pose_roll(unsigned char *s, int32_t v) {
+    s[8] = (s[8] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] ) & 255);
+    s[9] = (s[9] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] ) & 255);
+    s[10] = (s[10] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] ) & 255);
+    s[11] = (s[11] & 0) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] ) & 255);
+}
+
+// Get field status of struct Drone from given encoded buffer s.
+static inline DroneStatus BpGetDrone_status(const unsigned char *s) {
+    DroneStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[0] ) & 7;
+    return v;
+}
+
+// Set field status of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_status(unsigned char *s, DroneStatus v) {
+    s[0] = (s[0] & 248) | ((((unsigned char *)&(v))[0] ) & 7);
+}
+
+// Get field position.latitude of struct Drone from given encoded buffer s.
+static inline uint32_t BpGetDrone_position_latitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)((((uint64_t)s[0] | (uint64_t)s[1] << 8 | (uint64_t)s[2] << 16 | (uint64_t)s[3] << 24 | (uint64_t)s[4] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field position.latitude of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_position_latitude(unsigned char *s, uint32_t v) {
+    s[0] = (s[0] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[1] = (s[1] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[1] = (s[1] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[2] = (s[2] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[2] = (s[2] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[3] = (s[3] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[3] = (s[3] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[4] = (s[4] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field position.longitude of struct Drone from given encoded buffer s.
+static inline uint32_t BpGetDrone_position_longitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)((((uint64_t)s[4] | (uint64_t)s[5] << 8 | (uint64_t)s[6] << 16 | (uint64_t)s[7] << 24 | (uint64_t)s[8] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field position.longitude of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_position_longitude(unsigned char *s, uint32_t v) {
+    s[4] = (s[4] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[5] = (s[5] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[5] = (s[5] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[6] = (s[6] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[6] = (s[6] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[7] = (s[7] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[7] = (s[7] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[8] = (s[8] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field position.altitude of struct Drone from given encoded buffer s.
+static inline uint32_t BpGetDrone_position_altitude(const unsigned char *s) {
+    uint32_t v = 0;
+    v = (uint32_t)((((uint64_t)s[8] | (uint64_t)s[9] << 8 | (uint64_t)s[10] << 16 | (uint64_t)s[11] << 24 | (uint64_t)s[12] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field position.altitude of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_position_altitude(unsigned char *s, uint32_t v) {
+    s[8] = (s[8] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[9] = (s[9] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[9] = (s[9] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[10] = (s[10] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[10] = (s[10] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[11] = (s[11] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[11] = (s[11] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[12] = (s[12] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field flight.pose.yaw of struct Drone from given encoded buffer s.
+static inline int32_t BpGetDrone_flight_pose_yaw(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)((((uint64_t)s[12] | (uint64_t)s[13] << 8 | (uint64_t)s[14] << 16 | (uint64_t)s[15] << 24 | (uint64_t)s[16] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field flight.pose.yaw of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_flight_pose_yaw(unsigned char *s, int32_t v) {
+    s[12] = (s[12] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[13] = (s[13] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[13] = (s[13] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[14] = (s[14] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[14] = (s[14] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[15] = (s[15] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[15] = (s[15] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[16] = (s[16] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field flight.pose.pitch of struct Drone from given encoded buffer s.
+static inline int32_t BpGetDrone_flight_pose_pitch(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)((((uint64_t)s[16] | (uint64_t)s[17] << 8 | (uint64_t)s[18] << 16 | (uint64_t)s[19] << 24 | (uint64_t)s[20] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field flight.pose.pitch of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_flight_pose_pitch(unsigned char *s, int32_t v) {
+    s[16] = (s[16] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[17] = (s[17] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[17] = (s[17] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[18] = (s[18] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[18] = (s[18] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[19] = (s[19] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[19] = (s[19] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[20] = (s[20] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field flight.pose.roll of struct Drone from given encoded buffer s.
+static inline int32_t BpGetDrone_flight_pose_roll(const unsigned char *s) {
+    int32_t v = 0;
+    v = (int32_t)((((uint64_t)s[20] | (uint64_t)s[21] << 8 | (uint64_t)s[22] << 16 | (uint64_t)s[23] << 24 | (uint64_t)s[24] << 32) >> 3) & 4294967295);
+    return v;
+}
+
+// Set field flight.pose.roll of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_flight_pose_roll(unsigned char *s, int32_t v) {
+    s[20] = (s[20] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 3) & 248);
+    s[21] = (s[21] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 5) & 7);
+    s[21] = (s[21] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 3) & 248);
+    s[22] = (s[22] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 5) & 7);
+    s[22] = (s[22] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 3) & 248);
+    s[23] = (s[23] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 5) & 7);
+    s[23] = (s[23] & 7) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 3) & 248);
+    s[24] = (s[24] & 248) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 5) & 7);
+}
+
+// Get field power.battery of struct Drone from given encoded buffer s.
+static inline uint8_t BpGetDrone_power_battery(const unsigned char *s) {
+    uint8_t v = 0;
+    v = (uint8_t)((((uint64_t)s[54] | (uint64_t)s[55] << 8) >> 3) & 255);
+    return v;
+}
+
+// Set field power.battery of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_power_battery(unsigned char *s, uint8_t v) {
+    s[54] = (s[54] & 7) | ((((unsigned char *)&(v))[0] << 3) & 248);
+    s[55] = (s[55] & 248) | ((((unsigned char *)&(v))[0] >> 5) & 7);
+}
+
+// Get field power.status of struct Drone from given encoded buffer s.
+static inline PowerStatus BpGetDrone_power_status(const unsigned char *s) {
+    PowerStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[55] >> 3) & 3;
+    return v;
+}
+
+// Set field power.status of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_power_status(unsigned char *s, PowerStatus v) {
+    s[55] = (s[55] & 231) | ((((unsigned char *)&(v))[0] << 3) & 24);
+}
+
+// Get field power.is_charging of struct Drone from given encoded buffer s.
+static inline bool BpGetDrone_power_is_charging(const unsigned char *s) {
+    bool v = 0;
+    ((unsigned char *)&(v))[0] = (s[55] >> 5) & 1;
+    return v;
+}
+
+// Set field power.is_charging of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_power_is_charging(unsigned char *s, bool v) {
+    s[55] = (s[55] & 223) | ((((unsigned char *)&(v))[0] << 5) & 32);
+}
+
+// Get field network.signal of struct Drone from given encoded buffer s.
+static inline uint8_t BpGetDrone_network_signal(const unsigned char *s) {
+    uint8_t v = 0;
+    v = (uint8_t)((((uint64_t)s[55] | (uint64_t)s[56] << 8) >> 6) & 15);
+    return v;
+}
+
+// Set field network.signal of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_network_signal(unsigned char *s, uint8_t v) {
+    s[55] = (s[55] & 63) | ((((unsigned char *)&(v))[0] << 6) & 192);
+    s[56] = (s[56] & 252) | ((((unsigned char *)&(v))[0] >> 2) & 3);
+}
+
+// Get field network.heartbeat_at of struct Drone from given encoded buffer s.
+static inline Timestamp BpGetDrone_network_heartbeat_at(const unsigned char *s) {
+    Timestamp v = 0;
+    v = (Timestamp)((((uint64_t)s[56] | (uint64_t)s[57] << 8 | (uint64_t)s[58] << 16 | (uint64_t)s[59] << 24 | (uint64_t)s[60] << 32) >> 2) & 4294967295);
+    return v;
+}
+
+// Set field network.heartbeat_at of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_network_heartbeat_at(unsigned char *s, Timestamp v) {
+    s[56] = (s[56] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] << 2) & 252);
+    s[57] = (s[57] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 3 : 0] >> 6) & 3);
+    s[57] = (s[57] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] << 2) & 252);
+    s[58] = (s[58] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 2 : 1] >> 6) & 3);
+    s[58] = (s[58] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] << 2) & 252);
+    s[59] = (s[59] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 1 : 2] >> 6) & 3);
+    s[59] = (s[59] & 3) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] << 2) & 252);
+    s[60] = (s[60] & 252) | ((((unsigned char *)&(v))[BP_BIG_ENDIAN ? 0 : 3] >> 6) & 3);
+}
+
+// Get field landing_gear.status of struct Drone from given encoded buffer s.
+static inline LandingGearStatus BpGetDrone_landing_gear_status(const unsigned char *s) {
+    LandingGearStatus v = 0;
+    ((unsigned char *)&(v))[0] = (s[60] >> 2) & 3;
+    return v;
+}
+
+// Set field landing_gear.status of struct Drone in given encoded buffer s in place.
+static inline void BpSetDrone_landing_gear_status(unsigned char *s, LandingGearStatus v) {
+    s[60] = (s[60] & 243) | ((((unsigned char *)&(v))[0] << 2) & 12);
+}
 
 void BpXXXProcessTimestamp(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatTimestamp(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParseTimestamp(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessTernaryInt32(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatTernaryInt32(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParseTernaryInt32(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessPropeller(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatPropeller(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParsePropeller(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessPower(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatPower(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParsePower(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessNetwork(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatNetwork(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParseNetwork(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessLandingGear(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatLandingGear(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParseLandingGear(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessPosition(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatPosition(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParsePosition(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessPose(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatPose(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParsePose(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessFlight(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatFlight(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParseFlight(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessPressureSensor(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatPressureSensor(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParsePressureSensor(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 void BpXXXProcessDrone(void *data, struct BpProcessorContext *ctx);
+#ifndef BP_NO_JSON
 void BpXXXJsonFormatDrone(void *data, struct BpJsonFormatContext *ctx);
+void BpXXXJsonParseDrone(void *data, struct BpJsonParseContext *ctx);
+#endif
 
 #if defined(__cplusplus)
 }
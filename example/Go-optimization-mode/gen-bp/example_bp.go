@@ -4,6 +4,8 @@
 package drone
 
 import (
+	"errors"
+	"math"
 	"strconv"
 	"encoding/json"
 )
@@ -11,6 +13,10 @@ import (
 // Avoid possible golang import not used error
 var formatInt = strconv.FormatInt
 var jsonMarshal = json.Marshal
+var float32bits = math.Float32bits
+
+// ErrShortInput is returned if the buffer to decode is shorter than the message.
+var ErrShortInput = errors.New("bitproto: short input")
 
 type Timestamp int32 // 32bit
 
@@ -140,13 +146,68 @@ type Propeller struct {
 
 // Number of bytes to serialize struct Propeller
 const BYTES_LENGTH_PROPELLER uint32 = 2
+// Layout fingerprint of struct Propeller, to check compatibility
+const FINGERPRINT_PROPELLER uint64 = 0x1241850b2d64cf1d
+
+// Mask bits selecting the fields of struct Propeller in DecodeMasked
+const (
+	FIELD_MASK_PROPELLER_ID uint64 = 1 << 0
+	FIELD_MASK_PROPELLER_STATUS uint64 = 1 << 1
+	FIELD_MASK_PROPELLER_DIRECTION uint64 = 1 << 2
+)
 
 func (m *Propeller) Size() uint32 { return 2 }
 
 // Returns string representation for struct Propeller.
 func (m *Propeller) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Propeller to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Propeller) AppendJSON(b []byte) []byte {
+	b = append(b, `{"id":`...)
+	b = strconv.AppendUint(b, uint64(m.Id), 10)
+	b = append(b, `,"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, `,"direction":`...)
+	b = strconv.AppendUint(b, uint64(m.Direction), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Propeller) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Propeller by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Propeller) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Id))
+	h = bpHashMix(h, uint64(m.Status)&3)
+	h = bpHashMix(h, uint64(m.Direction)&3)
+	return h
+}
+
+// Equal reports whether struct Propeller encodes the same as o, without encoding them.
+func (m *Propeller) Equal(o *Propeller) bool {
+	if m.Id != o.Id {
+		return false
+	}
+	if uint64(m.Status)&3 != uint64(o.Status)&3 {
+		return false
+	}
+	if uint64(m.Direction)&3 != uint64(o.Direction)&3 {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Propeller to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Propeller) Reset() {
+	*m = Propeller{}
 }
 
 type Power struct {
@@ -157,13 +218,68 @@ type Power struct {
 
 // Number of bytes to serialize struct Power
 const BYTES_LENGTH_POWER uint32 = 2
+// Layout fingerprint of struct Power, to check compatibility
+const FINGERPRINT_POWER uint64 = 0x7f6afefbea0323ac
+
+// Mask bits selecting the fields of struct Power in DecodeMasked
+const (
+	FIELD_MASK_POWER_BATTERY uint64 = 1 << 0
+	FIELD_MASK_POWER_STATUS uint64 = 1 << 1
+	FIELD_MASK_POWER_IS_CHARGING uint64 = 1 << 2
+)
 
 func (m *Power) Size() uint32 { return 2 }
 
 // Returns string representation for struct Power.
 func (m *Power) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Power to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Power) AppendJSON(b []byte) []byte {
+	b = append(b, `{"battery":`...)
+	b = strconv.AppendUint(b, uint64(m.Battery), 10)
+	b = append(b, `,"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, `,"is_charging":`...)
+	b = strconv.AppendBool(b, m.IsCharging)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Power) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Power by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Power) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Battery))
+	h = bpHashMix(h, uint64(m.Status)&3)
+	h = bpHashMix(h, uint64(bool2byte(m.IsCharging)))
+	return h
+}
+
+// Equal reports whether struct Power encodes the same as o, without encoding them.
+func (m *Power) Equal(o *Power) bool {
+	if m.Battery != o.Battery {
+		return false
+	}
+	if uint64(m.Status)&3 != uint64(o.Status)&3 {
+		return false
+	}
+	if m.IsCharging != o.IsCharging {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Power to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Power) Reset() {
+	*m = Power{}
 }
 
 type Network struct {
@@ -175,13 +291,61 @@ type Network struct {
 
 // Number of bytes to serialize struct Network
 const BYTES_LENGTH_NETWORK uint32 = 5
+// Layout fingerprint of struct Network, to check compatibility
+const FINGERPRINT_NETWORK uint64 = 0x1c0359e538b559ec
+
+// Mask bits selecting the fields of struct Network in DecodeMasked
+const (
+	FIELD_MASK_NETWORK_SIGNAL uint64 = 1 << 0
+	FIELD_MASK_NETWORK_HEARTBEAT_AT uint64 = 1 << 1
+)
 
 func (m *Network) Size() uint32 { return 5 }
 
 // Returns string representation for struct Network.
 func (m *Network) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Network to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Network) AppendJSON(b []byte) []byte {
+	b = append(b, `{"signal":`...)
+	b = strconv.AppendUint(b, uint64(m.Signal), 10)
+	b = append(b, `,"heartbeat_at":`...)
+	b = strconv.AppendInt(b, int64(m.HeartbeatAt), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Network) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Network by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Network) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Signal)&15)
+	h = bpHashMix(h, uint64(int32(m.HeartbeatAt)))
+	return h
+}
+
+// Equal reports whether struct Network encodes the same as o, without encoding them.
+func (m *Network) Equal(o *Network) bool {
+	if uint64(m.Signal)&15 != uint64(o.Signal)&15 {
+		return false
+	}
+	if m.HeartbeatAt != o.HeartbeatAt {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Network to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Network) Reset() {
+	*m = Network{}
 }
 
 type LandingGear struct {
@@ -190,13 +354,54 @@ type LandingGear struct {
 
 // Number of bytes to serialize struct LandingGear
 const BYTES_LENGTH_LANDING_GEAR uint32 = 1
+// Layout fingerprint of struct LandingGear, to check compatibility
+const FINGERPRINT_LANDING_GEAR uint64 = 0x5121345b5280acf2
+
+// Mask bits selecting the fields of struct LandingGear in DecodeMasked
+const (
+	FIELD_MASK_LANDING_GEAR_STATUS uint64 = 1 << 0
+)
 
 func (m *LandingGear) Size() uint32 { return 1 }
 
 // Returns string representation for struct LandingGear.
 func (m *LandingGear) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct LandingGear to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *LandingGear) AppendJSON(b []byte) []byte {
+	b = append(b, `{"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *LandingGear) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct LandingGear by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *LandingGear) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Status)&3)
+	return h
+}
+
+// Equal reports whether struct LandingGear encodes the same as o, without encoding them.
+func (m *LandingGear) Equal(o *LandingGear) bool {
+	if uint64(m.Status)&3 != uint64(o.Status)&3 {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct LandingGear to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *LandingGear) Reset() {
+	*m = LandingGear{}
 }
 
 type Position struct {
@@ -207,13 +412,68 @@ type Position struct {
 
 // Number of bytes to serialize struct Position
 const BYTES_LENGTH_POSITION uint32 = 12
+// Layout fingerprint of struct Position, to check compatibility
+const FINGERPRINT_POSITION uint64 = 0x630a402d68f5f706
+
+// Mask bits selecting the fields of struct Position in DecodeMasked
+const (
+	FIELD_MASK_POSITION_LATITUDE uint64 = 1 << 0
+	FIELD_MASK_POSITION_LONGITUDE uint64 = 1 << 1
+	FIELD_MASK_POSITION_ALTITUDE uint64 = 1 << 2
+)
 
 func (m *Position) Size() uint32 { return 12 }
 
 // Returns string representation for struct Position.
 func (m *Position) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Position to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Position) AppendJSON(b []byte) []byte {
+	b = append(b, `{"latitude":`...)
+	b = strconv.AppendUint(b, uint64(m.Latitude), 10)
+	b = append(b, `,"longitude":`...)
+	b = strconv.AppendUint(b, uint64(m.Longitude), 10)
+	b = append(b, `,"altitude":`...)
+	b = strconv.AppendUint(b, uint64(m.Altitude), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Position) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Position by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Position) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Latitude))
+	h = bpHashMix(h, uint64(m.Longitude))
+	h = bpHashMix(h, uint64(m.Altitude))
+	return h
+}
+
+// Equal reports whether struct Position encodes the same as o, without encoding them.
+func (m *Position) Equal(o *Position) bool {
+	if m.Latitude != o.Latitude {
+		return false
+	}
+	if m.Longitude != o.Longitude {
+		return false
+	}
+	if m.Altitude != o.Altitude {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Position to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Position) Reset() {
+	*m = Position{}
 }
 
 // Pose in flight. https://en.wikipedia.org/wiki/Aircraft_principal_axes
@@ -225,13 +485,68 @@ type Pose struct {
 
 // Number of bytes to serialize struct Pose
 const BYTES_LENGTH_POSE uint32 = 12
+// Layout fingerprint of struct Pose, to check compatibility
+const FINGERPRINT_POSE uint64 = 0xc2e32b9442c9c9a5
+
+// Mask bits selecting the fields of struct Pose in DecodeMasked
+const (
+	FIELD_MASK_POSE_YAW uint64 = 1 << 0
+	FIELD_MASK_POSE_PITCH uint64 = 1 << 1
+	FIELD_MASK_POSE_ROLL uint64 = 1 << 2
+)
 
 func (m *Pose) Size() uint32 { return 12 }
 
 // Returns string representation for struct Pose.
 func (m *Pose) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Pose to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Pose) AppendJSON(b []byte) []byte {
+	b = append(b, `{"yaw":`...)
+	b = strconv.AppendInt(b, int64(m.Yaw), 10)
+	b = append(b, `,"pitch":`...)
+	b = strconv.AppendInt(b, int64(m.Pitch), 10)
+	b = append(b, `,"roll":`...)
+	b = strconv.AppendInt(b, int64(m.Roll), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Pose) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Pose by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Pose) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Yaw))
+	h = bpHashMix(h, uint64(m.Pitch))
+	h = bpHashMix(h, uint64(m.Roll))
+	return h
+}
+
+// Equal reports whether struct Pose encodes the same as o, without encoding them.
+func (m *Pose) Equal(o *Pose) bool {
+	if m.Yaw != o.Yaw {
+		return false
+	}
+	if m.Pitch != o.Pitch {
+		return false
+	}
+	if m.Roll != o.Roll {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Pose to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Pose) Reset() {
+	*m = Pose{}
 }
 
 type Flight struct {
@@ -244,13 +559,86 @@ type Flight struct {
 
 // Number of bytes to serialize struct Flight
 const BYTES_LENGTH_FLIGHT uint32 = 36
+// Layout fingerprint of struct Flight, to check compatibility
+const FINGERPRINT_FLIGHT uint64 = 0xcc6f06d016770753
+
+// Mask bits selecting the fields of struct Flight in DecodeMasked
+const (
+	FIELD_MASK_FLIGHT_POSE uint64 = 1 << 0
+	FIELD_MASK_FLIGHT_VELOCITY uint64 = 1 << 1
+	FIELD_MASK_FLIGHT_ACCELERATION uint64 = 1 << 2
+)
 
 func (m *Flight) Size() uint32 { return 36 }
 
 // Returns string representation for struct Flight.
 func (m *Flight) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Flight to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Flight) AppendJSON(b []byte) []byte {
+	b = append(b, `{"pose":`...)
+	b = m.Pose.AppendJSON(b)
+	b = append(b, `,"velocity":`...)
+	b = append(b, '[')
+	for k0 := range m.Velocity {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = strconv.AppendInt(b, int64(m.Velocity[k0]), 10)
+	}
+	b = append(b, ']')
+	b = append(b, `,"acceleration":`...)
+	b = append(b, '[')
+	for k0 := range m.Acceleration {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = strconv.AppendInt(b, int64(m.Acceleration[k0]), 10)
+	}
+	b = append(b, ']')
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Flight) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Flight by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Flight) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, m.Pose.Hash())
+	for k0 := range m.Velocity {
+		h = bpHashMix(h, uint64(m.Velocity[k0]))
+	}
+	for k0 := range m.Acceleration {
+		h = bpHashMix(h, uint64(m.Acceleration[k0]))
+	}
+	return h
+}
+
+// Equal reports whether struct Flight encodes the same as o, without encoding them.
+func (m *Flight) Equal(o *Flight) bool {
+	if !m.Pose.Equal(&o.Pose) {
+		return false
+	}
+	if m.Velocity != o.Velocity {
+		return false
+	}
+	if m.Acceleration != o.Acceleration {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Flight to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Flight) Reset() {
+	*m = Flight{}
 }
 
 type PressureSensor struct {
@@ -259,13 +647,65 @@ type PressureSensor struct {
 
 // Number of bytes to serialize struct PressureSensor
 const BYTES_LENGTH_PRESSURE_SENSOR uint32 = 6
+// Layout fingerprint of struct PressureSensor, to check compatibility
+const FINGERPRINT_PRESSURE_SENSOR uint64 = 0x25520a077a42ca16
+
+// Mask bits selecting the fields of struct PressureSensor in DecodeMasked
+const (
+	FIELD_MASK_PRESSURE_SENSOR_PRESSURES uint64 = 1 << 0
+)
 
 func (m *PressureSensor) Size() uint32 { return 6 }
 
 // Returns string representation for struct PressureSensor.
 func (m *PressureSensor) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct PressureSensor to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *PressureSensor) AppendJSON(b []byte) []byte {
+	b = append(b, `{"pressures":`...)
+	b = append(b, '[')
+	for k0 := range m.Pressures {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = strconv.AppendInt(b, int64(m.Pressures[k0]), 10)
+	}
+	b = append(b, ']')
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *PressureSensor) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct PressureSensor by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *PressureSensor) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	for k0 := range m.Pressures {
+		h = bpHashMix(h, uint64(m.Pressures[k0])&16777215)
+	}
+	return h
+}
+
+// Equal reports whether struct PressureSensor encodes the same as o, without encoding them.
+func (m *PressureSensor) Equal(o *PressureSensor) bool {
+	for k0 := range m.Pressures {
+		if uint64(m.Pressures[k0])&16777215 != uint64(o.Pressures[k0])&16777215 {
+			return false
+		}
+	}
+	return true
+}
+
+// Reset sets struct PressureSensor to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *PressureSensor) Reset() {
+	*m = PressureSensor{}
 }
 
 type Drone struct {
@@ -281,312 +721,574 @@ type Drone struct {
 
 // Number of bytes to serialize struct Drone
 const BYTES_LENGTH_DRONE uint32 = 67
+// Layout fingerprint of struct Drone, to check compatibility
+const FINGERPRINT_DRONE uint64 = 0x91865dcd474f9fe9
+
+// Mask bits selecting the fields of struct Drone in DecodeMasked
+const (
+	FIELD_MASK_DRONE_STATUS uint64 = 1 << 0
+	FIELD_MASK_DRONE_POSITION uint64 = 1 << 1
+	FIELD_MASK_DRONE_FLIGHT uint64 = 1 << 2
+	FIELD_MASK_DRONE_PROPELLERS uint64 = 1 << 3
+	FIELD_MASK_DRONE_POWER uint64 = 1 << 4
+	FIELD_MASK_DRONE_NETWORK uint64 = 1 << 5
+	FIELD_MASK_DRONE_LANDING_GEAR uint64 = 1 << 6
+	FIELD_MASK_DRONE_PRESSURE_SENSOR uint64 = 1 << 7
+)
 
 func (m *Drone) Size() uint32 { return 67 }
 
 // Returns string representation for struct Drone.
 func (m *Drone) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Drone to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Drone) AppendJSON(b []byte) []byte {
+	b = append(b, `{"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, `,"position":`...)
+	b = m.Position.AppendJSON(b)
+	b = append(b, `,"flight":`...)
+	b = m.Flight.AppendJSON(b)
+	b = append(b, `,"propellers":`...)
+	b = append(b, '[')
+	for k0 := range m.Propellers {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = m.Propellers[k0].AppendJSON(b)
+	}
+	b = append(b, ']')
+	b = append(b, `,"power":`...)
+	b = m.Power.AppendJSON(b)
+	b = append(b, `,"network":`...)
+	b = m.Network.AppendJSON(b)
+	b = append(b, `,"landing_gear":`...)
+	b = m.LandingGear.AppendJSON(b)
+	b = append(b, `,"pressure_sensor":`...)
+	b = m.PressureSensor.AppendJSON(b)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Drone) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Drone by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Drone) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Status)&7)
+	h = bpHashMix(h, m.Position.Hash())
+	h = bpHashMix(h, m.Flight.Hash())
+	for k0 := range m.Propellers {
+		h = bpHashMix(h, m.Propellers[k0].Hash())
+	}
+	h = bpHashMix(h, m.Power.Hash())
+	h = bpHashMix(h, m.Network.Hash())
+	h = bpHashMix(h, m.LandingGear.Hash())
+	h = bpHashMix(h, m.PressureSensor.Hash())
+	return h
+}
+
+// Equal reports whether struct Drone encodes the same as o, without encoding them.
+func (m *Drone) Equal(o *Drone) bool {
+	if uint64(m.Status)&7 != uint64(o.Status)&7 {
+		return false
+	}
+	if !m.Position.Equal(&o.Position) {
+		return false
+	}
+	if !m.Flight.Equal(&o.Flight) {
+		return false
+	}
+	for k0 := range m.Propellers {
+		if !m.Propellers[k0].Equal(&o.Propellers[k0]) {
+			return false
+		}
+	}
+	if !m.Power.Equal(&o.Power) {
+		return false
+	}
+	if !m.Network.Equal(&o.Network) {
+		return false
+	}
+	if !m.LandingGear.Equal(&o.LandingGear) {
+		return false
+	}
+	if !m.PressureSensor.Equal(&o.PressureSensor) {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Drone to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Drone) Reset() {
+	*m = Drone{}
 }
 
 // Encode struct Drone to bytes buffer.
 func (m *Drone) Encode() []byte {
 	s := make([]byte, 67)
+	m.EncodeTo(s)
+	return s
+}
+
+// EncodeTo encodes struct Drone into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Drone) EncodeTo(s []byte) int {
+	s = s[:67]
+	for k := range s {
+		s[k] = 0
+	}
 	s[0] |= (byte(m.Status) ) & 7
-	s[0] |= (byte(m.Position.Latitude) << 3) & 248
-	s[1] |= (byte(m.Position.Latitude) >> 5) & 7
-	s[1] |= (byte(m.Position.Latitude >> 8) << 3) & 248
-	s[2] |= (byte(m.Position.Latitude >> 8) >> 5) & 7
-	s[2] |= (byte(m.Position.Latitude >> 16) << 3) & 248
-	s[3] |= (byte(m.Position.Latitude >> 16) >> 5) & 7
-	s[3] |= (byte(m.Position.Latitude >> 24) << 3) & 248
-	s[4] |= (byte(m.Position.Latitude >> 24) >> 5) & 7
-	s[4] |= (byte(m.Position.Longitude) << 3) & 248
-	s[5] |= (byte(m.Position.Longitude) >> 5) & 7
-	s[5] |= (byte(m.Position.Longitude >> 8) << 3) & 248
-	s[6] |= (byte(m.Position.Longitude >> 8) >> 5) & 7
-	s[6] |= (byte(m.Position.Longitude >> 16) << 3) & 248
-	s[7] |= (byte(m.Position.Longitude >> 16) >> 5) & 7
-	s[7] |= (byte(m.Position.Longitude >> 24) << 3) & 248
-	s[8] |= (byte(m.Position.Longitude >> 24) >> 5) & 7
-	s[8] |= (byte(m.Position.Altitude) << 3) & 248
-	s[9] |= (byte(m.Position.Altitude) >> 5) & 7
-	s[9] |= (byte(m.Position.Altitude >> 8) << 3) & 248
-	s[10] |= (byte(m.Position.Altitude >> 8) >> 5) & 7
-	s[10] |= (byte(m.Position.Altitude >> 16) << 3) & 248
-	s[11] |= (byte(m.Position.Altitude >> 16) >> 5) & 7
-	s[11] |= (byte(m.Position.Altitude >> 24) << 3) & 248
-	s[12] |= (byte(m.Position.Altitude >> 24) >> 5) & 7
-	s[12] |= (byte(m.Flight.Pose.Yaw) << 3) & 248
-	s[13] |= (byte(m.Flight.Pose.Yaw) >> 5) & 7
-	s[13] |= (byte(m.Flight.Pose.Yaw >> 8) << 3) & 248
-	s[14] |= (byte(m.Flight.Pose.Yaw >> 8) >> 5) & 7
-	s[14] |= (byte(m.Flight.Pose.Yaw >> 16) << 3) & 248
-	s[15] |= (byte(m.Flight.Pose.Yaw >> 16) >> 5) & 7
-	s[15] |= (byte(m.Flight.Pose.Yaw >> 24) << 3) & 248
-	s[16] |= (byte(m.Flight.Pose.Yaw >> 24) >> 5) & 7
-	s[16] |= (byte(m.Flight.Pose.Pitch) << 3) & 248
-	s[17] |= (byte(m.Flight.Pose.Pitch) >> 5) & 7
-	s[17] |= (byte(m.Flight.Pose.Pitch >> 8) << 3) & 248
-	s[18] |= (byte(m.Flight.Pose.Pitch >> 8) >> 5) & 7
-	s[18] |= (byte(m.Flight.Pose.Pitch >> 16) << 3) & 248
-	s[19] |= (byte(m.Flight.Pose.Pitch >> 16) >> 5) & 7
-	s[19] |= (byte(m.Flight.Pose.Pitch >> 24) << 3) & 248
-	s[20] |= (byte(m.Flight.Pose.Pitch >> 24) >> 5) & 7
-	s[20] |= (byte(m.Flight.Pose.Roll) << 3) & 248
-	s[21] |= (byte(m.Flight.Pose.Roll) >> 5) & 7
-	s[21] |= (byte(m.Flight.Pose.Roll >> 8) << 3) & 248
-	s[22] |= (byte(m.Flight.Pose.Roll >> 8) >> 5) & 7
-	s[22] |= (byte(m.Flight.Pose.Roll >> 16) << 3) & 248
-	s[23] |= (byte(m.Flight.Pose.Roll >> 16) >> 5) & 7
-	s[23] |= (byte(m.Flight.Pose.Roll >> 24) << 3) & 248
-	s[24] |= (byte(m.Flight.Pose.Roll >> 24) >> 5) & 7
-	s[24] |= (byte(m.Flight.Velocity[0]) << 3) & 248
-	s[25] |= (byte(m.Flight.Velocity[0]) >> 5) & 7
-	s[25] |= (byte(m.Flight.Velocity[0] >> 8) << 3) & 248
-	s[26] |= (byte(m.Flight.Velocity[0] >> 8) >> 5) & 7
-	s[26] |= (byte(m.Flight.Velocity[0] >> 16) << 3) & 248
-	s[27] |= (byte(m.Flight.Velocity[0] >> 16) >> 5) & 7
-	s[27] |= (byte(m.Flight.Velocity[0] >> 24) << 3) & 248
-	s[28] |= (byte(m.Flight.Velocity[0] >> 24) >> 5) & 7
-	s[28] |= (byte(m.Flight.Velocity[1]) << 3) & 248
-	s[29] |= (byte(m.Flight.Velocity[1]) >> 5) & 7
-	s[29] |= (byte(m.Flight.Velocity[1] >> 8) << 3) & 248
-	s[30] |= (byte(m.Flight.Velocity[1] >> 8) >> 5) & 7
-	s[30] |= (byte(m.Flight.Velocity[1] >> 16) << 3) & 248
-	s[31] |= (byte(m.Flight.Velocity[1] >> 16) >> 5) & 7
-	s[31] |= (byte(m.Flight.Velocity[1] >> 24) << 3) & 248
-	s[32] |= (byte(m.Flight.Velocity[1] >> 24) >> 5) & 7
-	s[32] |= (byte(m.Flight.Velocity[2]) << 3) & 248
-	s[33] |= (byte(m.Flight.Velocity[2]) >> 5) & 7
-	s[33] |= (byte(m.Flight.Velocity[2] >> 8) << 3) & 248
-	s[34] |= (byte(m.Flight.Velocity[2] >> 8) >> 5) & 7
-	s[34] |= (byte(m.Flight.Velocity[2] >> 16) << 3) & 248
-	s[35] |= (byte(m.Flight.Velocity[2] >> 16) >> 5) & 7
-	s[35] |= (byte(m.Flight.Velocity[2] >> 24) << 3) & 248
-	s[36] |= (byte(m.Flight.Velocity[2] >> 24) >> 5) & 7
-	s[36] |= (byte(m.Flight.Acceleration[0]) << 3) & 248
-	s[37] |= (byte(m.Flight.Acceleration[0]) >> 5) & 7
-	s[37] |= (byte(m.Flight.Acceleration[0] >> 8) << 3) & 248
-	s[38] |= (byte(m.Flight.Acceleration[0] >> 8) >> 5) & 7
-	s[38] |= (byte(m.Flight.Acceleration[0] >> 16) << 3) & 248
-	s[39] |= (byte(m.Flight.Acceleration[0] >> 16) >> 5) & 7
-	s[39] |= (byte(m.Flight.Acceleration[0] >> 24) << 3) & 248
-	s[40] |= (byte(m.Flight.Acceleration[0] >> 24) >> 5) & 7
-	s[40] |= (byte(m.Flight.Acceleration[1]) << 3) & 248
-	s[41] |= (byte(m.Flight.Acceleration[1]) >> 5) & 7
-	s[41] |= (byte(m.Flight.Acceleration[1] >> 8) << 3) & 248
-	s[42] |= (byte(m.Flight.Acceleration[1] >> 8) >> 5) & 7
-	s[42] |= (byte(m.Flight.Acceleration[1] >> 16) << 3) & 248
-	s[43] |= (byte(m.Flight.Acceleration[1] >> 16) >> 5) & 7
-	s[43] |= (byte(m.Flight.Acceleration[1] >> 24) << 3) & 248
-	s[44] |= (byte(m.Flight.Acceleration[1] >> 24) >> 5) & 7
-	s[44] |= (byte(m.Flight.Acceleration[2]) << 3) & 248
-	s[45] |= (byte(m.Flight.Acceleration[2]) >> 5) & 7
-	s[45] |= (byte(m.Flight.Acceleration[2] >> 8) << 3) & 248
-	s[46] |= (byte(m.Flight.Acceleration[2] >> 8) >> 5) & 7
-	s[46] |= (byte(m.Flight.Acceleration[2] >> 16) << 3) & 248
-	s[47] |= (byte(m.Flight.Acceleration[2] >> 16) >> 5) & 7
-	s[47] |= (byte(m.Flight.Acceleration[2] >> 24) << 3) & 248
-	s[48] |= (byte(m.Flight.Acceleration[2] >> 24) >> 5) & 7
-	s[48] |= (byte(m.Propellers[0].Id) << 3) & 248
-	s[49] |= (byte(m.Propellers[0].Id) >> 5) & 7
+	s[0] |= byte(uint64(m.Position.Latitude) << 3)
+	s[1] = byte(uint64(m.Position.Latitude) << 3 >> 8)
+	s[2] = byte(uint64(m.Position.Latitude) << 3 >> 16)
+	s[3] = byte(uint64(m.Position.Latitude) << 3 >> 24)
+	s[4] = byte(uint64(m.Position.Latitude) << 3 >> 32) & 7
+	s[4] |= byte(uint64(m.Position.Longitude) << 3)
+	s[5] = byte(uint64(m.Position.Longitude) << 3 >> 8)
+	s[6] = byte(uint64(m.Position.Longitude) << 3 >> 16)
+	s[7] = byte(uint64(m.Position.Longitude) << 3 >> 24)
+	s[8] = byte(uint64(m.Position.Longitude) << 3 >> 32) & 7
+	s[8] |= byte(uint64(m.Position.Altitude) << 3)
+	s[9] = byte(uint64(m.Position.Altitude) << 3 >> 8)
+	s[10] = byte(uint64(m.Position.Altitude) << 3 >> 16)
+	s[11] = byte(uint64(m.Position.Altitude) << 3 >> 24)
+	s[12] = byte(uint64(m.Position.Altitude) << 3 >> 32) & 7
+	s[12] |= byte(uint64(m.Flight.Pose.Yaw) << 3)
+	s[13] = byte(uint64(m.Flight.Pose.Yaw) << 3 >> 8)
+	s[14] = byte(uint64(m.Flight.Pose.Yaw) << 3 >> 16)
+	s[15] = byte(uint64(m.Flight.Pose.Yaw) << 3 >> 24)
+	s[16] = byte(uint64(m.Flight.Pose.Yaw) << 3 >> 32) & 7
+	s[16] |= byte(uint64(m.Flight.Pose.Pitch) << 3)
+	s[17] = byte(uint64(m.Flight.Pose.Pitch) << 3 >> 8)
+	s[18] = byte(uint64(m.Flight.Pose.Pitch) << 3 >> 16)
+	s[19] = byte(uint64(m.Flight.Pose.Pitch) << 3 >> 24)
+	s[20] = byte(uint64(m.Flight.Pose.Pitch) << 3 >> 32) & 7
+	s[20] |= byte(uint64(m.Flight.Pose.Roll) << 3)
+	s[21] = byte(uint64(m.Flight.Pose.Roll) << 3 >> 8)
+	s[22] = byte(uint64(m.Flight.Pose.Roll) << 3 >> 16)
+	s[23] = byte(uint64(m.Flight.Pose.Roll) << 3 >> 24)
+	s[24] = byte(uint64(m.Flight.Pose.Roll) << 3 >> 32) & 7
+	s[24] |= byte(uint64(m.Flight.Velocity[0]) << 3)
+	s[25] = byte(uint64(m.Flight.Velocity[0]) << 3 >> 8)
+	s[26] = byte(uint64(m.Flight.Velocity[0]) << 3 >> 16)
+	s[27] = byte(uint64(m.Flight.Velocity[0]) << 3 >> 24)
+	s[28] = byte(uint64(m.Flight.Velocity[0]) << 3 >> 32) & 7
+	s[28] |= byte(uint64(m.Flight.Velocity[1]) << 3)
+	s[29] = byte(uint64(m.Flight.Velocity[1]) << 3 >> 8)
+	s[30] = byte(uint64(m.Flight.Velocity[1]) << 3 >> 16)
+	s[31] = byte(uint64(m.Flight.Velocity[1]) << 3 >> 24)
+	s[32] = byte(uint64(m.Flight.Velocity[1]) << 3 >> 32) & 7
+	s[32] |= byte(uint64(m.Flight.Velocity[2]) << 3)
+	s[33] = byte(uint64(m.Flight.Velocity[2]) << 3 >> 8)
+	s[34] = byte(uint64(m.Flight.Velocity[2]) << 3 >> 16)
+	s[35] = byte(uint64(m.Flight.Velocity[2]) << 3 >> 24)
+	s[36] = byte(uint64(m.Flight.Velocity[2]) << 3 >> 32) & 7
+	s[36] |= byte(uint64(m.Flight.Acceleration[0]) << 3)
+	s[37] = byte(uint64(m.Flight.Acceleration[0]) << 3 >> 8)
+	s[38] = byte(uint64(m.Flight.Acceleration[0]) << 3 >> 16)
+	s[39] = byte(uint64(m.Flight.Acceleration[0]) << 3 >> 24)
+	s[40] = byte(uint64(m.Flight.Acceleration[0]) << 3 >> 32) & 7
+	s[40] |= byte(uint64(m.Flight.Acceleration[1]) << 3)
+	s[41] = byte(uint64(m.Flight.Acceleration[1]) << 3 >> 8)
+	s[42] = byte(uint64(m.Flight.Acceleration[1]) << 3 >> 16)
+	s[43] = byte(uint64(m.Flight.Acceleration[1]) << 3 >> 24)
+	s[44] = byte(uint64(m.Flight.Acceleration[1]) << 3 >> 32) & 7
+	s[44] |= byte(uint64(m.Flight.Acceleration[2]) << 3)
+	s[45] = byte(uint64(m.Flight.Acceleration[2]) << 3 >> 8)
+	s[46] = byte(uint64(m.Flight.Acceleration[2]) << 3 >> 16)
+	s[47] = byte(uint64(m.Flight.Acceleration[2]) << 3 >> 24)
+	s[48] = byte(uint64(m.Flight.Acceleration[2]) << 3 >> 32) & 7
+	s[48] |= byte(uint64(m.Propellers[0].Id) << 3)
+	s[49] = byte(uint64(m.Propellers[0].Id) << 3 >> 8) & 7
 	s[49] |= (byte(m.Propellers[0].Status) << 3) & 24
 	s[49] |= (byte(m.Propellers[0].Direction) << 5) & 96
-	s[49] |= (byte(m.Propellers[1].Id) << 7) & 128
-	s[50] |= (byte(m.Propellers[1].Id) >> 1) & 127
-	s[50] |= (byte(m.Propellers[1].Status) << 7) & 128
-	s[51] |= (byte(m.Propellers[1].Status) >> 1) & 1
+	s[49] |= byte(uint64(m.Propellers[1].Id) << 7)
+	s[50] = byte(uint64(m.Propellers[1].Id) << 7 >> 8) & 127
+	s[50] |= byte(uint64(m.Propellers[1].Status) << 7)
+	s[51] = byte(uint64(m.Propellers[1].Status) << 7 >> 8) & 1
 	s[51] |= (byte(m.Propellers[1].Direction) << 1) & 6
-	s[51] |= (byte(m.Propellers[2].Id) << 3) & 248
-	s[52] |= (byte(m.Propellers[2].Id) >> 5) & 7
+	s[51] |= byte(uint64(m.Propellers[2].Id) << 3)
+	s[52] = byte(uint64(m.Propellers[2].Id) << 3 >> 8) & 7
 	s[52] |= (byte(m.Propellers[2].Status) << 3) & 24
 	s[52] |= (byte(m.Propellers[2].Direction) << 5) & 96
-	s[52] |= (byte(m.Propellers[3].Id) << 7) & 128
-	s[53] |= (byte(m.Propellers[3].Id) >> 1) & 127
-	s[53] |= (byte(m.Propellers[3].Status) << 7) & 128
-	s[54] |= (byte(m.Propellers[3].Status) >> 1) & 1
+	s[52] |= byte(uint64(m.Propellers[3].Id) << 7)
+	s[53] = byte(uint64(m.Propellers[3].Id) << 7 >> 8) & 127
+	s[53] |= byte(uint64(m.Propellers[3].Status) << 7)
+	s[54] = byte(uint64(m.Propellers[3].Status) << 7 >> 8) & 1
 	s[54] |= (byte(m.Propellers[3].Direction) << 1) & 6
-	s[54] |= (byte(m.Power.Battery) << 3) & 248
-	s[55] |= (byte(m.Power.Battery) >> 5) & 7
+	s[54] |= byte(uint64(m.Power.Battery) << 3)
+	s[55] = byte(uint64(m.Power.Battery) << 3 >> 8) & 7
 	s[55] |= (byte(m.Power.Status) << 3) & 24
 	s[55] |= (byte(bool2byte(m.Power.IsCharging)) << 5) & 32
-	s[55] |= (byte(m.Network.Signal) << 6) & 192
-	s[56] |= (byte(m.Network.Signal) >> 2) & 3
-	s[56] |= (byte(m.Network.HeartbeatAt) << 2) & 252
-	s[57] |= (byte(m.Network.HeartbeatAt) >> 6) & 3
-	s[57] |= (byte(m.Network.HeartbeatAt >> 8) << 2) & 252
-	s[58] |= (byte(m.Network.HeartbeatAt >> 8) >> 6) & 3
-	s[58] |= (byte(m.Network.HeartbeatAt >> 16) << 2) & 252
-	s[59] |= (byte(m.Network.HeartbeatAt >> 16) >> 6) & 3
-	s[59] |= (byte(m.Network.HeartbeatAt >> 24) << 2) & 252
-	s[60] |= (byte(m.Network.HeartbeatAt >> 24) >> 6) & 3
+	s[55] |= byte(uint64(m.Network.Signal) << 6)
+	s[56] = byte(uint64(m.Network.Signal) << 6 >> 8) & 3
+	s[56] |= byte(uint64(m.Network.HeartbeatAt) << 2)
+	s[57] = byte(uint64(m.Network.HeartbeatAt) << 2 >> 8)
+	s[58] = byte(uint64(m.Network.HeartbeatAt) << 2 >> 16)
+	s[59] = byte(uint64(m.Network.HeartbeatAt) << 2 >> 24)
+	s[60] = byte(uint64(m.Network.HeartbeatAt) << 2 >> 32) & 3
 	s[60] |= (byte(m.LandingGear.Status) << 2) & 12
-	s[60] |= (byte(m.PressureSensor.Pressures[0]) << 4) & 240
-	s[61] |= (byte(m.PressureSensor.Pressures[0]) >> 4) & 15
-	s[61] |= (byte(m.PressureSensor.Pressures[0] >> 8) << 4) & 240
-	s[62] |= (byte(m.PressureSensor.Pressures[0] >> 8) >> 4) & 15
-	s[62] |= (byte(m.PressureSensor.Pressures[0] >> 16) << 4) & 240
-	s[63] |= (byte(m.PressureSensor.Pressures[0] >> 16) >> 4) & 15
-	s[63] |= (byte(m.PressureSensor.Pressures[1]) << 4) & 240
-	s[64] |= (byte(m.PressureSensor.Pressures[1]) >> 4) & 15
-	s[64] |= (byte(m.PressureSensor.Pressures[1] >> 8) << 4) & 240
-	s[65] |= (byte(m.PressureSensor.Pressures[1] >> 8) >> 4) & 15
-	s[65] |= (byte(m.PressureSensor.Pressures[1] >> 16) << 4) & 240
-	s[66] |= (byte(m.PressureSensor.Pressures[1] >> 16) >> 4) & 15
-	return s
+	s[60] |= byte(uint64(m.PressureSensor.Pressures[0]) << 4)
+	s[61] = byte(uint64(m.PressureSensor.Pressures[0]) << 4 >> 8)
+	s[62] = byte(uint64(m.PressureSensor.Pressures[0]) << 4 >> 16)
+	s[63] = byte(uint64(m.PressureSensor.Pressures[0]) << 4 >> 24) & 15
+	s[63] |= byte(uint64(m.PressureSensor.Pressures[1]) << 4)
+	s[64] = byte(uint64(m.PressureSensor.Pressures[1]) << 4 >> 8)
+	s[65] = byte(uint64(m.PressureSensor.Pressures[1]) << 4 >> 16)
+	s[66] = byte(uint64(m.PressureSensor.Pressures[1]) << 4 >> 24) & 15
+	return 67
 }
 
+// Decode decodes struct Drone from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Drone) Decode(s []byte) {
+	m.Reset()
 	m.Status |= DroneStatus(byte(s[0] ) & 7)
-	m.Position.Latitude |= uint32(byte(s[0] >> 3) & 31)
-	m.Position.Latitude |= uint32(byte(s[1] << 5) & 224)
-	m.Position.Latitude |= uint32(byte(s[1] >> 3) & 31) << 8
-	m.Position.Latitude |= uint32(byte(s[2] << 5) & 224) << 8
-	m.Position.Latitude |= uint32(byte(s[2] >> 3) & 31) << 16
-	m.Position.Latitude |= uint32(byte(s[3] << 5) & 224) << 16
-	m.Position.Latitude |= uint32(byte(s[3] >> 3) & 31) << 24
-	m.Position.Latitude |= uint32(byte(s[4] << 5) & 224) << 24
-	m.Position.Longitude |= uint32(byte(s[4] >> 3) & 31)
-	m.Position.Longitude |= uint32(byte(s[5] << 5) & 224)
-	m.Position.Longitude |= uint32(byte(s[5] >> 3) & 31) << 8
-	m.Position.Longitude |= uint32(byte(s[6] << 5) & 224) << 8
-	m.Position.Longitude |= uint32(byte(s[6] >> 3) & 31) << 16
-	m.Position.Longitude |= uint32(byte(s[7] << 5) & 224) << 16
-	m.Position.Longitude |= uint32(byte(s[7] >> 3) & 31) << 24
-	m.Position.Longitude |= uint32(byte(s[8] << 5) & 224) << 24
-	m.Position.Altitude |= uint32(byte(s[8] >> 3) & 31)
-	m.Position.Altitude |= uint32(byte(s[9] << 5) & 224)
-	m.Position.Altitude |= uint32(byte(s[9] >> 3) & 31) << 8
-	m.Position.Altitude |= uint32(byte(s[10] << 5) & 224) << 8
-	m.Position.Altitude |= uint32(byte(s[10] >> 3) & 31) << 16
-	m.Position.Altitude |= uint32(byte(s[11] << 5) & 224) << 16
-	m.Position.Altitude |= uint32(byte(s[11] >> 3) & 31) << 24
-	m.Position.Altitude |= uint32(byte(s[12] << 5) & 224) << 24
-	m.Flight.Pose.Yaw |= int32(byte(s[12] >> 3) & 31)
-	m.Flight.Pose.Yaw |= int32(byte(s[13] << 5) & 224)
-	m.Flight.Pose.Yaw |= int32(byte(s[13] >> 3) & 31) << 8
-	m.Flight.Pose.Yaw |= int32(byte(s[14] << 5) & 224) << 8
-	m.Flight.Pose.Yaw |= int32(byte(s[14] >> 3) & 31) << 16
-	m.Flight.Pose.Yaw |= int32(byte(s[15] << 5) & 224) << 16
-	m.Flight.Pose.Yaw |= int32(byte(s[15] >> 3) & 31) << 24
-	m.Flight.Pose.Yaw |= int32(byte(s[16] << 5) & 224) << 24
-	m.Flight.Pose.Pitch |= int32(byte(s[16] >> 3) & 31)
-	m.Flight.Pose.Pitch |= int32(byte(s[17] << 5) & 224)
-	m.Flight.Pose.Pitch |= int32(byte(s[17] >> 3) & 31) << 8
-	m.Flight.Pose.Pitch |= int32(byte(s[18] << 5) & 224) << 8
-	m.Flight.Pose.Pitch |= int32(byte(s[18] >> 3) & 31) << 16
-	m.Flight.Pose.Pitch |= int32(byte(s[19] << 5) & 224) << 16
-	m.Flight.Pose.Pitch |= int32(byte(s[19] >> 3) & 31) << 24
-	m.Flight.Pose.Pitch |= int32(byte(s[20] << 5) & 224) << 24
-	m.Flight.Pose.Roll |= int32(byte(s[20] >> 3) & 31)
-	m.Flight.Pose.Roll |= int32(byte(s[21] << 5) & 224)
-	m.Flight.Pose.Roll |= int32(byte(s[21] >> 3) & 31) << 8
-	m.Flight.Pose.Roll |= int32(byte(s[22] << 5) & 224) << 8
-	m.Flight.Pose.Roll |= int32(byte(s[22] >> 3) & 31) << 16
-	m.Flight.Pose.Roll |= int32(byte(s[23] << 5) & 224) << 16
-	m.Flight.Pose.Roll |= int32(byte(s[23] >> 3) & 31) << 24
-	m.Flight.Pose.Roll |= int32(byte(s[24] << 5) & 224) << 24
-	m.Flight.Velocity[0] |= int32(byte(s[24] >> 3) & 31)
-	m.Flight.Velocity[0] |= int32(byte(s[25] << 5) & 224)
-	m.Flight.Velocity[0] |= int32(byte(s[25] >> 3) & 31) << 8
-	m.Flight.Velocity[0] |= int32(byte(s[26] << 5) & 224) << 8
-	m.Flight.Velocity[0] |= int32(byte(s[26] >> 3) & 31) << 16
-	m.Flight.Velocity[0] |= int32(byte(s[27] << 5) & 224) << 16
-	m.Flight.Velocity[0] |= int32(byte(s[27] >> 3) & 31) << 24
-	m.Flight.Velocity[0] |= int32(byte(s[28] << 5) & 224) << 24
-	m.Flight.Velocity[1] |= int32(byte(s[28] >> 3) & 31)
-	m.Flight.Velocity[1] |= int32(byte(s[29] << 5) & 224)
-	m.Flight.Velocity[1] |= int32(byte(s[29] >> 3) & 31) << 8
-	m.Flight.Velocity[1] |= int32(byte(s[30] << 5) & 224) << 8
-	m.Flight.Velocity[1] |= int32(byte(s[30] >> 3) & 31) << 16
-	m.Flight.Velocity[1] |= int32(byte(s[31] << 5) & 224) << 16
-	m.Flight.Velocity[1] |= int32(byte(s[31] >> 3) & 31) << 24
-	m.Flight.Velocity[1] |= int32(byte(s[32] << 5) & 224) << 24
-	m.Flight.Velocity[2] |= int32(byte(s[32] >> 3) & 31)
-	m.Flight.Velocity[2] |= int32(byte(s[33] << 5) & 224)
-	m.Flight.Velocity[2] |= int32(byte(s[33] >> 3) & 31) << 8
-	m.Flight.Velocity[2] |= int32(byte(s[34] << 5) & 224) << 8
-	m.Flight.Velocity[2] |= int32(byte(s[34] >> 3) & 31) << 16
-	m.Flight.Velocity[2] |= int32(byte(s[35] << 5) & 224) << 16
-	m.Flight.Velocity[2] |= int32(byte(s[35] >> 3) & 31) << 24
-	m.Flight.Velocity[2] |= int32(byte(s[36] << 5) & 224) << 24
-	m.Flight.Acceleration[0] |= int32(byte(s[36] >> 3) & 31)
-	m.Flight.Acceleration[0] |= int32(byte(s[37] << 5) & 224)
-	m.Flight.Acceleration[0] |= int32(byte(s[37] >> 3) & 31) << 8
-	m.Flight.Acceleration[0] |= int32(byte(s[38] << 5) & 224) << 8
-	m.Flight.Acceleration[0] |= int32(byte(s[38] >> 3) & 31) << 16
-	m.Flight.Acceleration[0] |= int32(byte(s[39] << 5) & 224) << 16
-	m.Flight.Acceleration[0] |= int32(byte(s[39] >> 3) & 31) << 24
-	m.Flight.Acceleration[0] |= int32(byte(s[40] << 5) & 224) << 24
-	m.Flight.Acceleration[1] |= int32(byte(s[40] >> 3) & 31)
-	m.Flight.Acceleration[1] |= int32(byte(s[41] << 5) & 224)
-	m.Flight.Acceleration[1] |= int32(byte(s[41] >> 3) & 31) << 8
-	m.Flight.Acceleration[1] |= int32(byte(s[42] << 5) & 224) << 8
-	m.Flight.Acceleration[1] |= int32(byte(s[42] >> 3) & 31) << 16
-	m.Flight.Acceleration[1] |= int32(byte(s[43] << 5) & 224) << 16
-	m.Flight.Acceleration[1] |= int32(byte(s[43] >> 3) & 31) << 24
-	m.Flight.Acceleration[1] |= int32(byte(s[44] << 5) & 224) << 24
-	m.Flight.Acceleration[2] |= int32(byte(s[44] >> 3) & 31)
-	m.Flight.Acceleration[2] |= int32(byte(s[45] << 5) & 224)
-	m.Flight.Acceleration[2] |= int32(byte(s[45] >> 3) & 31) << 8
-	m.Flight.Acceleration[2] |= int32(byte(s[46] << 5) & 224) << 8
-	m.Flight.Acceleration[2] |= int32(byte(s[46] >> 3) & 31) << 16
-	m.Flight.Acceleration[2] |= int32(byte(s[47] << 5) & 224) << 16
-	m.Flight.Acceleration[2] |= int32(byte(s[47] >> 3) & 31) << 24
-	m.Flight.Acceleration[2] |= int32(byte(s[48] << 5) & 224) << 24
-	m.Propellers[0].Id |= uint8(byte(s[48] >> 3) & 31)
-	m.Propellers[0].Id |= uint8(byte(s[49] << 5) & 224)
+	m.Position.Latitude = uint32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32) >> 3 & 4294967295)
+	m.Position.Longitude = uint32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24 | uint64(s[8])<<32) >> 3 & 4294967295)
+	m.Position.Altitude = uint32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24 | uint64(s[12])<<32) >> 3 & 4294967295)
+	m.Flight.Pose.Yaw = int32((uint64(s[12]) | uint64(s[13])<<8 | uint64(s[14])<<16 | uint64(s[15])<<24 | uint64(s[16])<<32) >> 3 & 4294967295)
+	m.Flight.Pose.Pitch = int32((uint64(s[16]) | uint64(s[17])<<8 | uint64(s[18])<<16 | uint64(s[19])<<24 | uint64(s[20])<<32) >> 3 & 4294967295)
+	m.Flight.Pose.Roll = int32((uint64(s[20]) | uint64(s[21])<<8 | uint64(s[22])<<16 | uint64(s[23])<<24 | uint64(s[24])<<32) >> 3 & 4294967295)
+	m.Flight.Velocity[0] = int32((uint64(s[24]) | uint64(s[25])<<8 | uint64(s[26])<<16 | uint64(s[27])<<24 | uint64(s[28])<<32) >> 3 & 4294967295)
+	m.Flight.Velocity[1] = int32((uint64(s[28]) | uint64(s[29])<<8 | uint64(s[30])<<16 | uint64(s[31])<<24 | uint64(s[32])<<32) >> 3 & 4294967295)
+	m.Flight.Velocity[2] = int32((uint64(s[32]) | uint64(s[33])<<8 | uint64(s[34])<<16 | uint64(s[35])<<24 | uint64(s[36])<<32) >> 3 & 4294967295)
+	m.Flight.Acceleration[0] = int32((uint64(s[36]) | uint64(s[37])<<8 | uint64(s[38])<<16 | uint64(s[39])<<24 | uint64(s[40])<<32) >> 3 & 4294967295)
+	m.Flight.Acceleration[1] = int32((uint64(s[40]) | uint64(s[41])<<8 | uint64(s[42])<<16 | uint64(s[43])<<24 | uint64(s[44])<<32) >> 3 & 4294967295)
+	m.Flight.Acceleration[2] = int32((uint64(s[44]) | uint64(s[45])<<8 | uint64(s[46])<<16 | uint64(s[47])<<24 | uint64(s[48])<<32) >> 3 & 4294967295)
+	m.Propellers[0].Id = uint8((uint64(s[48]) | uint64(s[49])<<8) >> 3 & 255)
 	m.Propellers[0].Status |= PropellerStatus(byte(s[49] >> 3) & 3)
 	m.Propellers[0].Direction |= RotatingDirection(byte(s[49] >> 5) & 3)
-	m.Propellers[1].Id |= uint8(byte(s[49] >> 7) & 1)
-	m.Propellers[1].Id |= uint8(byte(s[50] << 1) & 254)
-	m.Propellers[1].Status |= PropellerStatus(byte(s[50] >> 7) & 1)
-	m.Propellers[1].Status |= PropellerStatus(byte(s[51] << 1) & 2)
+	m.Propellers[1].Id = uint8((uint64(s[49]) | uint64(s[50])<<8) >> 7 & 255)
+	m.Propellers[1].Status = PropellerStatus((uint64(s[50]) | uint64(s[51])<<8) >> 7 & 3)
 	m.Propellers[1].Direction |= RotatingDirection(byte(s[51] >> 1) & 3)
-	m.Propellers[2].Id |= uint8(byte(s[51] >> 3) & 31)
-	m.Propellers[2].Id |= uint8(byte(s[52] << 5) & 224)
+	m.Propellers[2].Id = uint8((uint64(s[51]) | uint64(s[52])<<8) >> 3 & 255)
 	m.Propellers[2].Status |= PropellerStatus(byte(s[52] >> 3) & 3)
 	m.Propellers[2].Direction |= RotatingDirection(byte(s[52] >> 5) & 3)
-	m.Propellers[3].Id |= uint8(byte(s[52] >> 7) & 1)
-	m.Propellers[3].Id |= uint8(byte(s[53] << 1) & 254)
-	m.Propellers[3].Status |= PropellerStatus(byte(s[53] >> 7) & 1)
-	m.Propellers[3].Status |= PropellerStatus(byte(s[54] << 1) & 2)
+	m.Propellers[3].Id = uint8((uint64(s[52]) | uint64(s[53])<<8) >> 7 & 255)
+	m.Propellers[3].Status = PropellerStatus((uint64(s[53]) | uint64(s[54])<<8) >> 7 & 3)
 	m.Propellers[3].Direction |= RotatingDirection(byte(s[54] >> 1) & 3)
-	m.Power.Battery |= uint8(byte(s[54] >> 3) & 31)
-	m.Power.Battery |= uint8(byte(s[55] << 5) & 224)
+	m.Power.Battery = uint8((uint64(s[54]) | uint64(s[55])<<8) >> 3 & 255)
 	m.Power.Status |= PowerStatus(byte(s[55] >> 3) & 3)
 	m.Power.IsCharging = byte2bool(byte(s[55] >> 5) & 1)
-	m.Network.Signal |= uint8(byte(s[55] >> 6) & 3)
-	m.Network.Signal |= uint8(byte(s[56] << 2) & 12)
-	m.Network.HeartbeatAt |= Timestamp(byte(s[56] >> 2) & 63)
-	m.Network.HeartbeatAt |= Timestamp(byte(s[57] << 6) & 192)
-	m.Network.HeartbeatAt |= Timestamp(byte(s[57] >> 2) & 63) << 8
-	m.Network.HeartbeatAt |= Timestamp(byte(s[58] << 6) & 192) << 8
-	m.Network.HeartbeatAt |= Timestamp(byte(s[58] >> 2) & 63) << 16
-	m.Network.HeartbeatAt |= Timestamp(byte(s[59] << 6) & 192) << 16
-	m.Network.HeartbeatAt |= Timestamp(byte(s[59] >> 2) & 63) << 24
-	m.Network.HeartbeatAt |= Timestamp(byte(s[60] << 6) & 192) << 24
+	m.Network.Signal = uint8((uint64(s[55]) | uint64(s[56])<<8) >> 6 & 15)
+	m.Network.HeartbeatAt = Timestamp((uint64(s[56]) | uint64(s[57])<<8 | uint64(s[58])<<16 | uint64(s[59])<<24 | uint64(s[60])<<32) >> 2 & 4294967295)
 	m.LandingGear.Status |= LandingGearStatus(byte(s[60] >> 2) & 3)
-	m.PressureSensor.Pressures[0] |= int32(byte(s[60] >> 4) & 15)
-	m.PressureSensor.Pressures[0] |= int32(byte(s[61] << 4) & 240)
-	m.PressureSensor.Pressures[0] |= int32(byte(s[61] >> 4) & 15) << 8
-	m.PressureSensor.Pressures[0] |= int32(byte(s[62] << 4) & 240) << 8
-	m.PressureSensor.Pressures[0] |= int32(byte(s[62] >> 4) & 15) << 16
-	m.PressureSensor.Pressures[0] |= int32(byte(s[63] << 4) & 240) << 16
+	m.PressureSensor.Pressures[0] = int32((uint64(s[60]) | uint64(s[61])<<8 | uint64(s[62])<<16 | uint64(s[63])<<24) >> 4 & 16777215)
 	m.PressureSensor.Pressures[0] <<= 8
 	m.PressureSensor.Pressures[0] >>= 8
-	m.PressureSensor.Pressures[1] |= int32(byte(s[63] >> 4) & 15)
-	m.PressureSensor.Pressures[1] |= int32(byte(s[64] << 4) & 240)
-	m.PressureSensor.Pressures[1] |= int32(byte(s[64] >> 4) & 15) << 8
-	m.PressureSensor.Pressures[1] |= int32(byte(s[65] << 4) & 240) << 8
-	m.PressureSensor.Pressures[1] |= int32(byte(s[65] >> 4) & 15) << 16
-	m.PressureSensor.Pressures[1] |= int32(byte(s[66] << 4) & 240) << 16
+	m.PressureSensor.Pressures[1] = int32((uint64(s[63]) | uint64(s[64])<<8 | uint64(s[65])<<16 | uint64(s[66])<<24) >> 4 & 16777215)
 	m.PressureSensor.Pressures[1] <<= 8
 	m.PressureSensor.Pressures[1] >>= 8
 }
 
+// DecodeMasked decodes the fields of struct Drone selected by mask, an or of FIELD_MASK_DRONE_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Drone) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_DRONE_STATUS != 0 {
+		m.Status = Drone{}.Status
+		m.Status |= DroneStatus(byte(s[0] ) & 7)
+	}
+	if mask&FIELD_MASK_DRONE_POSITION != 0 {
+		m.Position = Drone{}.Position
+		m.Position.Latitude = uint32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32) >> 3 & 4294967295)
+		m.Position.Longitude = uint32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24 | uint64(s[8])<<32) >> 3 & 4294967295)
+		m.Position.Altitude = uint32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24 | uint64(s[12])<<32) >> 3 & 4294967295)
+	}
+	if mask&FIELD_MASK_DRONE_FLIGHT != 0 {
+		m.Flight = Drone{}.Flight
+		m.Flight.Pose.Yaw = int32((uint64(s[12]) | uint64(s[13])<<8 | uint64(s[14])<<16 | uint64(s[15])<<24 | uint64(s[16])<<32) >> 3 & 4294967295)
+		m.Flight.Pose.Pitch = int32((uint64(s[16]) | uint64(s[17])<<8 | uint64(s[18])<<16 | uint64(s[19])<<24 | uint64(s[20])<<32) >> 3 & 4294967295)
+		m.Flight.Pose.Roll = int32((uint64(s[20]) | uint64(s[21])<<8 | uint64(s[22])<<16 | uint64(s[23])<<24 | uint64(s[24])<<32) >> 3 & 4294967295)
+		m.Flight.Velocity[0] = int32((uint64(s[24]) | uint64(s[25])<<8 | uint64(s[26])<<16 | uint64(s[27])<<24 | uint64(s[28])<<32) >> 3 & 4294967295)
+		m.Flight.Velocity[1] = int32((uint64(s[28]) | uint64(s[29])<<8 | uint64(s[30])<<16 | uint64(s[31])<<24 | uint64(s[32])<<32) >> 3 & 4294967295)
+		m.Flight.Velocity[2] = int32((uint64(s[32]) | uint64(s[33])<<8 | uint64(s[34])<<16 | uint64(s[35])<<24 | uint64(s[36])<<32) >> 3 & 4294967295)
+		m.Flight.Acceleration[0] = int32((uint64(s[36]) | uint64(s[37])<<8 | uint64(s[38])<<16 | uint64(s[39])<<24 | uint64(s[40])<<32) >> 3 & 4294967295)
+		m.Flight.Acceleration[1] = int32((uint64(s[40]) | uint64(s[41])<<8 | uint64(s[42])<<16 | uint64(s[43])<<24 | uint64(s[44])<<32) >> 3 & 4294967295)
+		m.Flight.Acceleration[2] = int32((uint64(s[44]) | uint64(s[45])<<8 | uint64(s[46])<<16 | uint64(s[47])<<24 | uint64(s[48])<<32) >> 3 & 4294967295)
+	}
+	if mask&FIELD_MASK_DRONE_PROPELLERS != 0 {
+		m.Propellers = Drone{}.Propellers
+		m.Propellers[0].Id = uint8((uint64(s[48]) | uint64(s[49])<<8) >> 3 & 255)
+		m.Propellers[0].Status |= PropellerStatus(byte(s[49] >> 3) & 3)
+		m.Propellers[0].Direction |= RotatingDirection(byte(s[49] >> 5) & 3)
+		m.Propellers[1].Id = uint8((uint64(s[49]) | uint64(s[50])<<8) >> 7 & 255)
+		m.Propellers[1].Status = PropellerStatus((uint64(s[50]) | uint64(s[51])<<8) >> 7 & 3)
+		m.Propellers[1].Direction |= RotatingDirection(byte(s[51] >> 1) & 3)
+		m.Propellers[2].Id = uint8((uint64(s[51]) | uint64(s[52])<<8) >> 3 & 255)
+		m.Propellers[2].Status |= PropellerStatus(byte(s[52] >> 3) & 3)
+		m.Propellers[2].Direction |= RotatingDirection(byte(s[52] >> 5) & 3)
+		m.Propellers[3].Id = uint8((uint64(s[52]) | uint64(s[53])<<8) >> 7 & 255)
+		m.Propellers[3].Status = PropellerStatus((uint64(s[53]) | uint64(s[54])<<8) >> 7 & 3)
+		m.Propellers[3].Direction |= RotatingDirection(byte(s[54] >> 1) & 3)
+	}
+	if mask&FIELD_MASK_DRONE_POWER != 0 {
+		m.Power = Drone{}.Power
+		m.Power.Battery = uint8((uint64(s[54]) | uint64(s[55])<<8) >> 3 & 255)
+		m.Power.Status |= PowerStatus(byte(s[55] >> 3) & 3)
+		m.Power.IsCharging = byte2bool(byte(s[55] >> 5) & 1)
+	}
+	if mask&FIELD_MASK_DRONE_NETWORK != 0 {
+		m.Network = Drone{}.Network
+		m.Network.Signal = uint8((uint64(s[55]) | uint64(s[56])<<8) >> 6 & 15)
+		m.Network.HeartbeatAt = Timestamp((uint64(s[56]) | uint64(s[57])<<8 | uint64(s[58])<<16 | uint64(s[59])<<24 | uint64(s[60])<<32) >> 2 & 4294967295)
+	}
+	if mask&FIELD_MASK_DRONE_LANDING_GEAR != 0 {
+		m.LandingGear = Drone{}.LandingGear
+		m.LandingGear.Status |= LandingGearStatus(byte(s[60] >> 2) & 3)
+	}
+	if mask&FIELD_MASK_DRONE_PRESSURE_SENSOR != 0 {
+		m.PressureSensor = Drone{}.PressureSensor
+		m.PressureSensor.Pressures[0] = int32((uint64(s[60]) | uint64(s[61])<<8 | uint64(s[62])<<16 | uint64(s[63])<<24) >> 4 & 16777215)
+		m.PressureSensor.Pressures[0] <<= 8
+		m.PressureSensor.Pressures[0] >>= 8
+		m.PressureSensor.Pressures[1] = int32((uint64(s[63]) | uint64(s[64])<<8 | uint64(s[65])<<16 | uint64(s[66])<<24) >> 4 & 16777215)
+		m.PressureSensor.Pressures[1] <<= 8
+		m.PressureSensor.Pressures[1] >>= 8
+	}
+}
+
+// DecodeFrom decodes struct Drone from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns ErrShortInput if s is shorter than Size() bytes.
+func (m *Drone) DecodeFrom(s []byte) error {
+	if len(s) < 67 {
+		return ErrShortInput
+	}
+	m.Decode(s)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Drone to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 67 bytes left.
+func (m *Drone) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 67 {
+		b = append(b, make([]byte, 67)...)
+	} else {
+		b = b[:n+67]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Drone) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Drone) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 67)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Drone) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Get field Status of struct Drone from given encoded buffer s.
+func BpGetDrone_Status(s []byte) (v DroneStatus) {
+	v |= DroneStatus(byte(s[0] ) & 7)
+	return
+}
+
+// Set field Status of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Status(s []byte, v DroneStatus) {
+	s[0] = (s[0] & 248) | ((byte(v) ) & 7)
+}
+
+// Get field Position.Latitude of struct Drone from given encoded buffer s.
+func BpGetDrone_Position_Latitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Position.Latitude of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Position_Latitude(s []byte, v uint32) {
+	s[0] = (s[0] & 7) | ((byte(v) << 3) & 248)
+	s[1] = (s[1] & 248) | ((byte(v) >> 5) & 7)
+	s[1] = (s[1] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[2] = (s[2] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[2] = (s[2] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[3] = (s[3] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[3] = (s[3] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[4] = (s[4] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Position.Longitude of struct Drone from given encoded buffer s.
+func BpGetDrone_Position_Longitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24 | uint64(s[8])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Position.Longitude of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Position_Longitude(s []byte, v uint32) {
+	s[4] = (s[4] & 7) | ((byte(v) << 3) & 248)
+	s[5] = (s[5] & 248) | ((byte(v) >> 5) & 7)
+	s[5] = (s[5] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[6] = (s[6] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[6] = (s[6] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[7] = (s[7] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[7] = (s[7] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[8] = (s[8] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Position.Altitude of struct Drone from given encoded buffer s.
+func BpGetDrone_Position_Altitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24 | uint64(s[12])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Position.Altitude of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Position_Altitude(s []byte, v uint32) {
+	s[8] = (s[8] & 7) | ((byte(v) << 3) & 248)
+	s[9] = (s[9] & 248) | ((byte(v) >> 5) & 7)
+	s[9] = (s[9] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[10] = (s[10] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[10] = (s[10] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[11] = (s[11] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[11] = (s[11] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[12] = (s[12] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Flight.Pose.Yaw of struct Drone from given encoded buffer s.
+func BpGetDrone_Flight_Pose_Yaw(s []byte) (v int32) {
+	v = int32((uint64(s[12]) | uint64(s[13])<<8 | uint64(s[14])<<16 | uint64(s[15])<<24 | uint64(s[16])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Flight.Pose.Yaw of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Flight_Pose_Yaw(s []byte, v int32) {
+	s[12] = (s[12] & 7) | ((byte(v) << 3) & 248)
+	s[13] = (s[13] & 248) | ((byte(v) >> 5) & 7)
+	s[13] = (s[13] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[14] = (s[14] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[14] = (s[14] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[15] = (s[15] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[15] = (s[15] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[16] = (s[16] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Flight.Pose.Pitch of struct Drone from given encoded buffer s.
+func BpGetDrone_Flight_Pose_Pitch(s []byte) (v int32) {
+	v = int32((uint64(s[16]) | uint64(s[17])<<8 | uint64(s[18])<<16 | uint64(s[19])<<24 | uint64(s[20])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Flight.Pose.Pitch of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Flight_Pose_Pitch(s []byte, v int32) {
+	s[16] = (s[16] & 7) | ((byte(v) << 3) & 248)
+	s[17] = (s[17] & 248) | ((byte(v) >> 5) & 7)
+	s[17] = (s[17] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[18] = (s[18] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[18] = (s[18] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[19] = (s[19] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[19] = (s[19] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[20] = (s[20] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Flight.Pose.Roll of struct Drone from given encoded buffer s.
+func BpGetDrone_Flight_Pose_Roll(s []byte) (v int32) {
+	v = int32((uint64(s[20]) | uint64(s[21])<<8 | uint64(s[22])<<16 | uint64(s[23])<<24 | uint64(s[24])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Flight.Pose.Roll of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Flight_Pose_Roll(s []byte, v int32) {
+	s[20] = (s[20] & 7) | ((byte(v) << 3) & 248)
+	s[21] = (s[21] & 248) | ((byte(v) >> 5) & 7)
+	s[21] = (s[21] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[22] = (s[22] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[22] = (s[22] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[23] = (s[23] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[23] = (s[23] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[24] = (s[24] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Power.Battery of struct Drone from given encoded buffer s.
+func BpGetDrone_Power_Battery(s []byte) (v uint8) {
+	v = uint8((uint64(s[54]) | uint64(s[55])<<8) >> 3 & 255)
+	return
+}
+
+// Set field Power.Battery of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Power_Battery(s []byte, v uint8) {
+	s[54] = (s[54] & 7) | ((byte(v) << 3) & 248)
+	s[55] = (s[55] & 248) | ((byte(v) >> 5) & 7)
+}
+
+// Get field Power.Status of struct Drone from given encoded buffer s.
+func BpGetDrone_Power_Status(s []byte) (v PowerStatus) {
+	v |= PowerStatus(byte(s[55] >> 3) & 3)
+	return
+}
+
+// Set field Power.Status of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Power_Status(s []byte, v PowerStatus) {
+	s[55] = (s[55] & 231) | ((byte(v) << 3) & 24)
+}
+
+// Get field Power.IsCharging of struct Drone from given encoded buffer s.
+func BpGetDrone_Power_IsCharging(s []byte) (v bool) {
+	v = byte2bool(byte(s[55] >> 5) & 1)
+	return
+}
+
+// Set field Power.IsCharging of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Power_IsCharging(s []byte, v bool) {
+	s[55] = (s[55] & 223) | ((byte(bool2byte(v)) << 5) & 32)
+}
+
+// Get field Network.Signal of struct Drone from given encoded buffer s.
+func BpGetDrone_Network_Signal(s []byte) (v uint8) {
+	v = uint8((uint64(s[55]) | uint64(s[56])<<8) >> 6 & 15)
+	return
+}
+
+// Set field Network.Signal of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Network_Signal(s []byte, v uint8) {
+	s[55] = (s[55] & 63) | ((byte(v) << 6) & 192)
+	s[56] = (s[56] & 252) | ((byte(v) >> 2) & 3)
+}
+
+// Get field Network.HeartbeatAt of struct Drone from given encoded buffer s.
+func BpGetDrone_Network_HeartbeatAt(s []byte) (v Timestamp) {
+	v = Timestamp((uint64(s[56]) | uint64(s[57])<<8 | uint64(s[58])<<16 | uint64(s[59])<<24 | uint64(s[60])<<32) >> 2 & 4294967295)
+	return
+}
+
+// Set field Network.HeartbeatAt of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Network_HeartbeatAt(s []byte, v Timestamp) {
+	s[56] = (s[56] & 3) | ((byte(v) << 2) & 252)
+	s[57] = (s[57] & 252) | ((byte(v) >> 6) & 3)
+	s[57] = (s[57] & 3) | ((byte(v >> 8) << 2) & 252)
+	s[58] = (s[58] & 252) | ((byte(v >> 8) >> 6) & 3)
+	s[58] = (s[58] & 3) | ((byte(v >> 16) << 2) & 252)
+	s[59] = (s[59] & 252) | ((byte(v >> 16) >> 6) & 3)
+	s[59] = (s[59] & 3) | ((byte(v >> 24) << 2) & 252)
+	s[60] = (s[60] & 252) | ((byte(v >> 24) >> 6) & 3)
+}
+
+// Get field LandingGear.Status of struct Drone from given encoded buffer s.
+func BpGetDrone_LandingGear_Status(s []byte) (v LandingGearStatus) {
+	v |= LandingGearStatus(byte(s[60] >> 2) & 3)
+	return
+}
+
+// Set field LandingGear.Status of struct Drone in given encoded buffer s in place.
+func BpSetDrone_LandingGear_Status(s []byte, v LandingGearStatus) {
+	s[60] = (s[60] & 243) | ((byte(v) << 2) & 12)
+}
+
 func bool2byte(b bool) byte {
 	if b {
 		return 1
@@ -599,4 +1301,36 @@ func byte2bool(b byte) bool {
 		return true
 	}
 	return false
+}
+
+// bpHashMix mixes the 64 bits word w into the hash h.
+func bpHashMix(h, w uint64) uint64 {
+	h = (h ^ w) * 0x9e3779b97f4a7c15
+	return h ^ h>>32
+}
+
+// bpHashBytes mixes the bytes s into the hash h, 8 at a time.
+func bpHashBytes(h uint64, s []byte) uint64 {
+	for ; len(s) >= 8; s = s[8:] {
+		w := uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32 | uint64(s[5])<<40 | uint64(s[6])<<48 | uint64(s[7])<<56
+		h = bpHashMix(h, w)
+	}
+	if len(s) > 0 {
+		var w uint64
+		for k, b := range s {
+			w |= uint64(b) << (8 * uint(k))
+		}
+		h = bpHashMix(h, w)
+	}
+	return h
+}
+
+// bpFixedWord rounds the scaled fixed-point value r the same as the encoder.
+func bpFixedWord(r float64) uint64 {
+	if r >= 0 {
+		return uint64(r + 0.5)
+	} else if r < 0 {
+		return uint64(int64(r - 0.5))
+	}
+	return 0
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 package drone
 
 import (
+	"math"
 	"strconv"
 	"encoding/json"
 
@@ -13,18 +14,23 @@ import (
 // Avoid possible golang import not used error
 var formatInt = strconv.FormatInt
 var jsonMarshal = json.Marshal
+var float32bits = math.Float32bits
 var _ = bp.Useless
 
 type Timestamp int32 // 32bit
 
+var bpProcessorTimestamp = bp.NewAliasProcessor(bp.NewInt(32))
+
 func (m Timestamp) BpProcessor() bp.Processor {
-	return bp.NewAliasProcessor(bp.NewInt(32))
+	return bpProcessorTimestamp
 }
 
 type TernaryInt32 [3]int32 // 96bit
 
+var bpProcessorTernaryInt32 = bp.NewAliasProcessor(bp.NewArray(false, 3, bp.NewInt(32)))
+
 func (m TernaryInt32) BpProcessor() bp.Processor {
-	return bp.NewAliasProcessor(bp.NewArray(false, 3, bp.NewInt(32)))
+	return bpProcessorTernaryInt32
 }
 
 type DroneStatus uint8 // 3bit
@@ -37,8 +43,10 @@ const (
 	DRONE_STATUS_FLYING = 4
 )
 
+var bpProcessorDroneStatus = bp.NewEnumProcessor(bp.NewUint(3))
+
 func (m DroneStatus) BpProcessor() bp.Processor {
-	return bp.NewEnumProcessor(bp.NewUint(3))
+	return bpProcessorDroneStatus
 }
 
 // String returns the name of this enum item.
@@ -67,8 +75,10 @@ const (
 	PROPELLER_STATUS_ROTATING = 2
 )
 
+var bpProcessorPropellerStatus = bp.NewEnumProcessor(bp.NewUint(2))
+
 func (m PropellerStatus) BpProcessor() bp.Processor {
-	return bp.NewEnumProcessor(bp.NewUint(2))
+	return bpProcessorPropellerStatus
 }
 
 // String returns the name of this enum item.
@@ -93,8 +103,10 @@ const (
 	ROTATING_DIRECTION_ANTI_CLOCK_WISE = 2
 )
 
+var bpProcessorRotatingDirection = bp.NewEnumProcessor(bp.NewUint(2))
+
 func (m RotatingDirection) BpProcessor() bp.Processor {
-	return bp.NewEnumProcessor(bp.NewUint(2))
+	return bpProcessorRotatingDirection
 }
 
 // String returns the name of this enum item.
@@ -119,8 +131,10 @@ const (
 	POWER_STATUS_ON = 2
 )
 
+var bpProcessorPowerStatus = bp.NewEnumProcessor(bp.NewUint(2))
+
 func (m PowerStatus) BpProcessor() bp.Processor {
-	return bp.NewEnumProcessor(bp.NewUint(2))
+	return bpProcessorPowerStatus
 }
 
 // String returns the name of this enum item.
@@ -145,8 +159,10 @@ const (
 	LANDING_GEAR_STATUS_FOLDED = 2
 )
 
+var bpProcessorLandingGearStatus = bp.NewEnumProcessor(bp.NewUint(2))
+
 func (m LandingGearStatus) BpProcessor() bp.Processor {
-	return bp.NewEnumProcessor(bp.NewUint(2))
+	return bpProcessorLandingGearStatus
 }
 
 // String returns the name of this enum item.
@@ -171,34 +187,177 @@ type Propeller struct {
 
 // Number of bytes to serialize struct Propeller
 const BYTES_LENGTH_PROPELLER uint32 = 2
+// Layout fingerprint of struct Propeller, to check compatibility
+const FINGERPRINT_PROPELLER uint64 = 0x1241850b2d64cf1d
+
+// Mask bits selecting the fields of struct Propeller in DecodeMasked
+const (
+	FIELD_MASK_PROPELLER_ID uint64 = 1 << 0
+	FIELD_MASK_PROPELLER_STATUS uint64 = 1 << 1
+	FIELD_MASK_PROPELLER_DIRECTION uint64 = 1 << 2
+)
 
 func (m *Propeller) Size() uint32 { return 2 }
 
 // Returns string representation for struct Propeller.
 func (m *Propeller) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Propeller to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Propeller) AppendJSON(b []byte) []byte {
+	b = append(b, `{"id":`...)
+	b = strconv.AppendUint(b, uint64(m.Id), 10)
+	b = append(b, `,"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, `,"direction":`...)
+	b = strconv.AppendUint(b, uint64(m.Direction), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Propeller) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Propeller by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Propeller) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Id))
+	h = bpHashMix(h, uint64(m.Status)&3)
+	h = bpHashMix(h, uint64(m.Direction)&3)
+	return h
+}
+
+// Equal reports whether struct Propeller encodes the same as o, without encoding them.
+func (m *Propeller) Equal(o *Propeller) bool {
+	if m.Id != o.Id {
+		return false
+	}
+	if uint64(m.Status)&3 != uint64(o.Status)&3 {
+		return false
+	}
+	if uint64(m.Direction)&3 != uint64(o.Direction)&3 {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Propeller to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Propeller) Reset() {
+	*m = Propeller{}
 }
 
 // Encode struct Propeller to bytes buffer.
 func (m *Propeller) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Propeller", true, 2))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorPropeller.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Propeller from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Propeller) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Propeller", false, 2))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPropeller.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Propeller) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, bp.NewUint(8)),
-		bp.NewMessageFieldProcessor(2, (PropellerStatus(0)).BpProcessor()),
-		bp.NewMessageFieldProcessor(3, (RotatingDirection(0)).BpProcessor()),
+// DecodeMasked decodes the fields of struct Propeller selected by mask, an or of FIELD_MASK_PROPELLER_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Propeller) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_PROPELLER_ID != 0 {
+		m.Id = Propeller{}.Id
+	}
+	if mask&FIELD_MASK_PROPELLER_STATUS != 0 {
+		m.Status = Propeller{}.Status
+	}
+	if mask&FIELD_MASK_PROPELLER_DIRECTION != 0 {
+		m.Direction = Propeller{}.Direction
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPropeller.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Propeller into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Propeller) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Propeller", true, 2))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:2])
+	bpProcessorPropeller.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 2
+}
+
+// DecodeFrom decodes struct Propeller from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Propeller) DecodeFrom(s []byte) error {
+	if len(s) < 2 {
+		return bp.ErrShortInput
 	}
-	return bp.NewMessageProcessor(false, 12, fieldDescriptors)
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Propeller", false, 2))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPropeller.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Propeller to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 2 bytes left.
+func (m *Propeller) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 2 {
+		b = append(b, make([]byte, 2)...)
+	} else {
+		b = b[:n+2]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Propeller) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Propeller) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 2)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Propeller) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Propeller, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorPropeller = bp.NewMessageProcessor(false, 12, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, bp.NewUint(8)),
+	bp.NewMessageFieldProcessor(2, (PropellerStatus(0)).BpProcessor()),
+	bp.NewMessageFieldProcessor(3, (RotatingDirection(0)).BpProcessor()),
+})
+
+func (m *Propeller) BpProcessor() bp.Processor {
+	return bpProcessorPropeller
 }
 
 func (m *Propeller) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -241,6 +400,46 @@ func (m *Propeller) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *Propeller) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
+// Get field Id of struct Propeller from given encoded buffer s.
+func BpGetPropeller_Id(s []byte) (v uint8) {
+	v |= uint8(byte(s[0] ) & 255)
+	return
+}
+
+// Set field Id of struct Propeller in given encoded buffer s in place.
+func BpSetPropeller_Id(s []byte, v uint8) {
+	s[0] = (s[0] & 0) | ((byte(v) ) & 255)
+}
+
+// Get field Status of struct Propeller from given encoded buffer s.
+func BpGetPropeller_Status(s []byte) (v PropellerStatus) {
+	v |= PropellerStatus(byte(s[1] ) & 3)
+	return
+}
+
+// Set field Status of struct Propeller in given encoded buffer s in place.
+func BpSetPropeller_Status(s []byte, v PropellerStatus) {
+	s[1] = (s[1] & 252) | ((byte(v) ) & 3)
+}
+
+// Get field Direction of struct Propeller from given encoded buffer s.
+func BpGetPropeller_Direction(s []byte) (v RotatingDirection) {
+	v |= RotatingDirection(byte(s[1] >> 2) & 3)
+	return
+}
+
+// Set field Direction of struct Propeller in given encoded buffer s in place.
+func BpSetPropeller_Direction(s []byte, v RotatingDirection) {
+	s[1] = (s[1] & 243) | ((byte(v) << 2) & 12)
+}
+
 type Power struct {
 	Battery uint8 `json:"battery"` // 8bit
 	Status PowerStatus `json:"status"` // 2bit
@@ -249,34 +448,177 @@ type Power struct {
 
 // Number of bytes to serialize struct Power
 const BYTES_LENGTH_POWER uint32 = 2
+// Layout fingerprint of struct Power, to check compatibility
+const FINGERPRINT_POWER uint64 = 0x7f6afefbea0323ac
+
+// Mask bits selecting the fields of struct Power in DecodeMasked
+const (
+	FIELD_MASK_POWER_BATTERY uint64 = 1 << 0
+	FIELD_MASK_POWER_STATUS uint64 = 1 << 1
+	FIELD_MASK_POWER_IS_CHARGING uint64 = 1 << 2
+)
 
 func (m *Power) Size() uint32 { return 2 }
 
 // Returns string representation for struct Power.
 func (m *Power) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Power to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Power) AppendJSON(b []byte) []byte {
+	b = append(b, `{"battery":`...)
+	b = strconv.AppendUint(b, uint64(m.Battery), 10)
+	b = append(b, `,"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, `,"is_charging":`...)
+	b = strconv.AppendBool(b, m.IsCharging)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Power) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Power by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Power) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Battery))
+	h = bpHashMix(h, uint64(m.Status)&3)
+	h = bpHashMix(h, uint64(bool2byte(m.IsCharging)))
+	return h
+}
+
+// Equal reports whether struct Power encodes the same as o, without encoding them.
+func (m *Power) Equal(o *Power) bool {
+	if m.Battery != o.Battery {
+		return false
+	}
+	if uint64(m.Status)&3 != uint64(o.Status)&3 {
+		return false
+	}
+	if m.IsCharging != o.IsCharging {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Power to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Power) Reset() {
+	*m = Power{}
 }
 
 // Encode struct Power to bytes buffer.
 func (m *Power) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Power", true, 2))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorPower.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Power from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Power) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Power", false, 2))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPower.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Power) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, bp.NewUint(8)),
-		bp.NewMessageFieldProcessor(2, (PowerStatus(0)).BpProcessor()),
-		bp.NewMessageFieldProcessor(3, bp.NewBool()),
+// DecodeMasked decodes the fields of struct Power selected by mask, an or of FIELD_MASK_POWER_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Power) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_POWER_BATTERY != 0 {
+		m.Battery = Power{}.Battery
 	}
-	return bp.NewMessageProcessor(false, 11, fieldDescriptors)
+	if mask&FIELD_MASK_POWER_STATUS != 0 {
+		m.Status = Power{}.Status
+	}
+	if mask&FIELD_MASK_POWER_IS_CHARGING != 0 {
+		m.IsCharging = Power{}.IsCharging
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPower.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Power into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Power) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Power", true, 2))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:2])
+	bpProcessorPower.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 2
+}
+
+// DecodeFrom decodes struct Power from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Power) DecodeFrom(s []byte) error {
+	if len(s) < 2 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Power", false, 2))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPower.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Power to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 2 bytes left.
+func (m *Power) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 2 {
+		b = append(b, make([]byte, 2)...)
+	} else {
+		b = b[:n+2]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Power) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Power) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 2)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Power) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Power, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorPower = bp.NewMessageProcessor(false, 11, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, bp.NewUint(8)),
+	bp.NewMessageFieldProcessor(2, (PowerStatus(0)).BpProcessor()),
+	bp.NewMessageFieldProcessor(3, bp.NewBool()),
+})
+
+func (m *Power) BpProcessor() bp.Processor {
+	return bpProcessorPower
 }
 
 func (m *Power) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -319,6 +661,46 @@ func (m *Power) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *Power) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
+// Get field Battery of struct Power from given encoded buffer s.
+func BpGetPower_Battery(s []byte) (v uint8) {
+	v |= uint8(byte(s[0] ) & 255)
+	return
+}
+
+// Set field Battery of struct Power in given encoded buffer s in place.
+func BpSetPower_Battery(s []byte, v uint8) {
+	s[0] = (s[0] & 0) | ((byte(v) ) & 255)
+}
+
+// Get field Status of struct Power from given encoded buffer s.
+func BpGetPower_Status(s []byte) (v PowerStatus) {
+	v |= PowerStatus(byte(s[1] ) & 3)
+	return
+}
+
+// Set field Status of struct Power in given encoded buffer s in place.
+func BpSetPower_Status(s []byte, v PowerStatus) {
+	s[1] = (s[1] & 252) | ((byte(v) ) & 3)
+}
+
+// Get field IsCharging of struct Power from given encoded buffer s.
+func BpGetPower_IsCharging(s []byte) (v bool) {
+	v = byte2bool(byte(s[1] >> 2) & 1)
+	return
+}
+
+// Set field IsCharging of struct Power in given encoded buffer s in place.
+func BpSetPower_IsCharging(s []byte, v bool) {
+	s[1] = (s[1] & 251) | ((byte(bool2byte(v)) << 2) & 4)
+}
+
 type Network struct {
 	// Degree of signal, between 1~10.
 	Signal uint8 `json:"signal"` // 4bit
@@ -328,33 +710,166 @@ type Network struct {
 
 // Number of bytes to serialize struct Network
 const BYTES_LENGTH_NETWORK uint32 = 5
+// Layout fingerprint of struct Network, to check compatibility
+const FINGERPRINT_NETWORK uint64 = 0x1c0359e538b559ec
+
+// Mask bits selecting the fields of struct Network in DecodeMasked
+const (
+	FIELD_MASK_NETWORK_SIGNAL uint64 = 1 << 0
+	FIELD_MASK_NETWORK_HEARTBEAT_AT uint64 = 1 << 1
+)
 
 func (m *Network) Size() uint32 { return 5 }
 
 // Returns string representation for struct Network.
 func (m *Network) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Network to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Network) AppendJSON(b []byte) []byte {
+	b = append(b, `{"signal":`...)
+	b = strconv.AppendUint(b, uint64(m.Signal), 10)
+	b = append(b, `,"heartbeat_at":`...)
+	b = strconv.AppendInt(b, int64(m.HeartbeatAt), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Network) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Network by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Network) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Signal)&15)
+	h = bpHashMix(h, uint64(int32(m.HeartbeatAt)))
+	return h
+}
+
+// Equal reports whether struct Network encodes the same as o, without encoding them.
+func (m *Network) Equal(o *Network) bool {
+	if uint64(m.Signal)&15 != uint64(o.Signal)&15 {
+		return false
+	}
+	if m.HeartbeatAt != o.HeartbeatAt {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Network to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Network) Reset() {
+	*m = Network{}
 }
 
 // Encode struct Network to bytes buffer.
 func (m *Network) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Network", true, 5))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorNetwork.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Network from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Network) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Network", false, 5))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorNetwork.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Network) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, bp.NewUint(4)),
-		bp.NewMessageFieldProcessor(2, (Timestamp(0)).BpProcessor()),
+// DecodeMasked decodes the fields of struct Network selected by mask, an or of FIELD_MASK_NETWORK_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Network) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_NETWORK_SIGNAL != 0 {
+		m.Signal = Network{}.Signal
+	}
+	if mask&FIELD_MASK_NETWORK_HEARTBEAT_AT != 0 {
+		m.HeartbeatAt = Network{}.HeartbeatAt
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorNetwork.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Network into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Network) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Network", true, 5))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:5])
+	bpProcessorNetwork.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 5
+}
+
+// DecodeFrom decodes struct Network from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Network) DecodeFrom(s []byte) error {
+	if len(s) < 5 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Network", false, 5))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorNetwork.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Network to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 5 bytes left.
+func (m *Network) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 5 {
+		b = append(b, make([]byte, 5)...)
+	} else {
+		b = b[:n+5]
 	}
-	return bp.NewMessageProcessor(false, 36, fieldDescriptors)
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Network) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Network) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 5)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Network) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Network, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorNetwork = bp.NewMessageProcessor(false, 36, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, bp.NewUint(4)),
+	bp.NewMessageFieldProcessor(2, (Timestamp(0)).BpProcessor()),
+})
+
+func (m *Network) BpProcessor() bp.Processor {
+	return bpProcessorNetwork
 }
 
 func (m *Network) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -393,38 +908,197 @@ func (m *Network) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *Network) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
+// Get field Signal of struct Network from given encoded buffer s.
+func BpGetNetwork_Signal(s []byte) (v uint8) {
+	v |= uint8(byte(s[0] ) & 15)
+	return
+}
+
+// Set field Signal of struct Network in given encoded buffer s in place.
+func BpSetNetwork_Signal(s []byte, v uint8) {
+	s[0] = (s[0] & 240) | ((byte(v) ) & 15)
+}
+
+// Get field HeartbeatAt of struct Network from given encoded buffer s.
+func BpGetNetwork_HeartbeatAt(s []byte) (v Timestamp) {
+	v = Timestamp((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32) >> 4 & 4294967295)
+	return
+}
+
+// Set field HeartbeatAt of struct Network in given encoded buffer s in place.
+func BpSetNetwork_HeartbeatAt(s []byte, v Timestamp) {
+	s[0] = (s[0] & 15) | ((byte(v) << 4) & 240)
+	s[1] = (s[1] & 240) | ((byte(v) >> 4) & 15)
+	s[1] = (s[1] & 15) | ((byte(v >> 8) << 4) & 240)
+	s[2] = (s[2] & 240) | ((byte(v >> 8) >> 4) & 15)
+	s[2] = (s[2] & 15) | ((byte(v >> 16) << 4) & 240)
+	s[3] = (s[3] & 240) | ((byte(v >> 16) >> 4) & 15)
+	s[3] = (s[3] & 15) | ((byte(v >> 24) << 4) & 240)
+	s[4] = (s[4] & 240) | ((byte(v >> 24) >> 4) & 15)
+}
+
 type LandingGear struct {
 	Status LandingGearStatus `json:"status"` // 2bit
 }
 
 // Number of bytes to serialize struct LandingGear
 const BYTES_LENGTH_LANDING_GEAR uint32 = 1
+// Layout fingerprint of struct LandingGear, to check compatibility
+const FINGERPRINT_LANDING_GEAR uint64 = 0x5121345b5280acf2
+
+// Mask bits selecting the fields of struct LandingGear in DecodeMasked
+const (
+	FIELD_MASK_LANDING_GEAR_STATUS uint64 = 1 << 0
+)
 
 func (m *LandingGear) Size() uint32 { return 1 }
 
 // Returns string representation for struct LandingGear.
 func (m *LandingGear) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct LandingGear to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *LandingGear) AppendJSON(b []byte) []byte {
+	b = append(b, `{"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *LandingGear) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct LandingGear by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *LandingGear) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Status)&3)
+	return h
+}
+
+// Equal reports whether struct LandingGear encodes the same as o, without encoding them.
+func (m *LandingGear) Equal(o *LandingGear) bool {
+	if uint64(m.Status)&3 != uint64(o.Status)&3 {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct LandingGear to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *LandingGear) Reset() {
+	*m = LandingGear{}
 }
 
 // Encode struct LandingGear to bytes buffer.
 func (m *LandingGear) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("LandingGear", true, 1))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorLandingGear.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct LandingGear from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *LandingGear) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("LandingGear", false, 1))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorLandingGear.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *LandingGear) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, (LandingGearStatus(0)).BpProcessor()),
+// DecodeMasked decodes the fields of struct LandingGear selected by mask, an or of FIELD_MASK_LANDING_GEAR_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *LandingGear) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_LANDING_GEAR_STATUS != 0 {
+		m.Status = LandingGear{}.Status
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorLandingGear.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct LandingGear into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *LandingGear) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("LandingGear", true, 1))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:1])
+	bpProcessorLandingGear.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 1
+}
+
+// DecodeFrom decodes struct LandingGear from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *LandingGear) DecodeFrom(s []byte) error {
+	if len(s) < 1 {
+		return bp.ErrShortInput
 	}
-	return bp.NewMessageProcessor(false, 2, fieldDescriptors)
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("LandingGear", false, 1))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorLandingGear.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct LandingGear to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 1 bytes left.
+func (m *LandingGear) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 1 {
+		b = append(b, make([]byte, 1)...)
+	} else {
+		b = b[:n+1]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *LandingGear) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *LandingGear) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 1)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *LandingGear) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct LandingGear, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorLandingGear = bp.NewMessageProcessor(false, 2, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, (LandingGearStatus(0)).BpProcessor()),
+})
+
+func (m *LandingGear) BpProcessor() bp.Processor {
+	return bpProcessorLandingGear
 }
 
 func (m *LandingGear) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -459,6 +1133,24 @@ func (m *LandingGear) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *LandingGear) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
+// Get field Status of struct LandingGear from given encoded buffer s.
+func BpGetLandingGear_Status(s []byte) (v LandingGearStatus) {
+	v |= LandingGearStatus(byte(s[0] ) & 3)
+	return
+}
+
+// Set field Status of struct LandingGear in given encoded buffer s in place.
+func BpSetLandingGear_Status(s []byte, v LandingGearStatus) {
+	s[0] = (s[0] & 252) | ((byte(v) ) & 3)
+}
+
 type Position struct {
 	Latitude uint32 `json:"latitude"` // 32bit
 	Longitude uint32 `json:"longitude"` // 32bit
@@ -467,34 +1159,177 @@ type Position struct {
 
 // Number of bytes to serialize struct Position
 const BYTES_LENGTH_POSITION uint32 = 12
+// Layout fingerprint of struct Position, to check compatibility
+const FINGERPRINT_POSITION uint64 = 0x630a402d68f5f706
+
+// Mask bits selecting the fields of struct Position in DecodeMasked
+const (
+	FIELD_MASK_POSITION_LATITUDE uint64 = 1 << 0
+	FIELD_MASK_POSITION_LONGITUDE uint64 = 1 << 1
+	FIELD_MASK_POSITION_ALTITUDE uint64 = 1 << 2
+)
 
 func (m *Position) Size() uint32 { return 12 }
 
 // Returns string representation for struct Position.
 func (m *Position) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Position to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Position) AppendJSON(b []byte) []byte {
+	b = append(b, `{"latitude":`...)
+	b = strconv.AppendUint(b, uint64(m.Latitude), 10)
+	b = append(b, `,"longitude":`...)
+	b = strconv.AppendUint(b, uint64(m.Longitude), 10)
+	b = append(b, `,"altitude":`...)
+	b = strconv.AppendUint(b, uint64(m.Altitude), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Position) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Position by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Position) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Latitude))
+	h = bpHashMix(h, uint64(m.Longitude))
+	h = bpHashMix(h, uint64(m.Altitude))
+	return h
+}
+
+// Equal reports whether struct Position encodes the same as o, without encoding them.
+func (m *Position) Equal(o *Position) bool {
+	if m.Latitude != o.Latitude {
+		return false
+	}
+	if m.Longitude != o.Longitude {
+		return false
+	}
+	if m.Altitude != o.Altitude {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Position to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Position) Reset() {
+	*m = Position{}
 }
 
 // Encode struct Position to bytes buffer.
 func (m *Position) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Position", true, 12))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorPosition.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Position from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Position) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Position", false, 12))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPosition.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Position) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, bp.NewUint(32)),
-		bp.NewMessageFieldProcessor(2, bp.NewUint(32)),
-		bp.NewMessageFieldProcessor(3, bp.NewUint(32)),
+// DecodeMasked decodes the fields of struct Position selected by mask, an or of FIELD_MASK_POSITION_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Position) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_POSITION_LATITUDE != 0 {
+		m.Latitude = Position{}.Latitude
 	}
-	return bp.NewMessageProcessor(false, 96, fieldDescriptors)
+	if mask&FIELD_MASK_POSITION_LONGITUDE != 0 {
+		m.Longitude = Position{}.Longitude
+	}
+	if mask&FIELD_MASK_POSITION_ALTITUDE != 0 {
+		m.Altitude = Position{}.Altitude
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPosition.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Position into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Position) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Position", true, 12))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:12])
+	bpProcessorPosition.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 12
+}
+
+// DecodeFrom decodes struct Position from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Position) DecodeFrom(s []byte) error {
+	if len(s) < 12 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Position", false, 12))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPosition.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Position to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 12 bytes left.
+func (m *Position) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 12 {
+		b = append(b, make([]byte, 12)...)
+	} else {
+		b = b[:n+12]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Position) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Position) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 12)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Position) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Position, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorPosition = bp.NewMessageProcessor(false, 96, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, bp.NewUint(32)),
+	bp.NewMessageFieldProcessor(2, bp.NewUint(32)),
+	bp.NewMessageFieldProcessor(3, bp.NewUint(32)),
+})
+
+func (m *Position) BpProcessor() bp.Processor {
+	return bpProcessorPosition
 }
 
 func (m *Position) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -537,43 +1372,235 @@ func (m *Position) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
-// Pose in flight. https://en.wikipedia.org/wiki/Aircraft_principal_axes
-type Pose struct {
-	Yaw int32 `json:"yaw"` // 32bit
-	Pitch int32 `json:"pitch"` // 32bit
-	Roll int32 `json:"roll"` // 32bit
+func (m *Position) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
 }
 
-// Number of bytes to serialize struct Pose
-const BYTES_LENGTH_POSE uint32 = 12
+// Get field Latitude of struct Position from given encoded buffer s.
+func BpGetPosition_Latitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24) & 4294967295)
+	return
+}
 
-func (m *Pose) Size() uint32 { return 12 }
+// Set field Latitude of struct Position in given encoded buffer s in place.
+func BpSetPosition_Latitude(s []byte, v uint32) {
+	s[0] = (s[0] & 0) | ((byte(v) ) & 255)
+	s[1] = (s[1] & 0) | ((byte(v >> 8) ) & 255)
+	s[2] = (s[2] & 0) | ((byte(v >> 16) ) & 255)
+	s[3] = (s[3] & 0) | ((byte(v >> 24) ) & 255)
+}
 
-// Returns string representation for struct Pose.
+// Get field Longitude of struct Position from given encoded buffer s.
+func BpGetPosition_Longitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24) & 4294967295)
+	return
+}
+
+// Set field Longitude of struct Position in given encoded buffer s in place.
+func BpSetPosition_Longitude(s []byte, v uint32) {
+	s[4] = (s[4] & 0) | ((byte(v) ) & 255)
+	s[5] = (s[5] & 0) | ((byte(v >> 8) ) & 255)
+	s[6] = (s[6] & 0) | ((byte(v >> 16) ) & 255)
+	s[7] = (s[7] & 0) | ((byte(v >> 24) ) & 255)
+}
+
+// Get field Altitude of struct Position from given encoded buffer s.
+func BpGetPosition_Altitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24) & 4294967295)
+	return
+}
+
+// Set field Altitude of struct Position in given encoded buffer s in place.
+func BpSetPosition_Altitude(s []byte, v uint32) {
+	s[8] = (s[8] & 0) | ((byte(v) ) & 255)
+	s[9] = (s[9] & 0) | ((byte(v >> 8) ) & 255)
+	s[10] = (s[10] & 0) | ((byte(v >> 16) ) & 255)
+	s[11] = (s[11] & 0) | ((byte(v >> 24) ) & 255)
+}
+
+// Pose in flight. https://en.wikipedia.org/wiki/Aircraft_principal_axes
+type Pose struct {
+	Yaw int32 `json:"yaw"` // 32bit
+	Pitch int32 `json:"pitch"` // 32bit
+	Roll int32 `json:"roll"` // 32bit
+}
+
+// Number of bytes to serialize struct Pose
+const BYTES_LENGTH_POSE uint32 = 12
+// Layout fingerprint of struct Pose, to check compatibility
+const FINGERPRINT_POSE uint64 = 0xc2e32b9442c9c9a5
+
+// Mask bits selecting the fields of struct Pose in DecodeMasked
+const (
+	FIELD_MASK_POSE_YAW uint64 = 1 << 0
+	FIELD_MASK_POSE_PITCH uint64 = 1 << 1
+	FIELD_MASK_POSE_ROLL uint64 = 1 << 2
+)
+
+func (m *Pose) Size() uint32 { return 12 }
+
+// Returns string representation for struct Pose.
 func (m *Pose) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Pose to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Pose) AppendJSON(b []byte) []byte {
+	b = append(b, `{"yaw":`...)
+	b = strconv.AppendInt(b, int64(m.Yaw), 10)
+	b = append(b, `,"pitch":`...)
+	b = strconv.AppendInt(b, int64(m.Pitch), 10)
+	b = append(b, `,"roll":`...)
+	b = strconv.AppendInt(b, int64(m.Roll), 10)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Pose) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Pose by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Pose) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Yaw))
+	h = bpHashMix(h, uint64(m.Pitch))
+	h = bpHashMix(h, uint64(m.Roll))
+	return h
+}
+
+// Equal reports whether struct Pose encodes the same as o, without encoding them.
+func (m *Pose) Equal(o *Pose) bool {
+	if m.Yaw != o.Yaw {
+		return false
+	}
+	if m.Pitch != o.Pitch {
+		return false
+	}
+	if m.Roll != o.Roll {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Pose to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Pose) Reset() {
+	*m = Pose{}
 }
 
 // Encode struct Pose to bytes buffer.
 func (m *Pose) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Pose", true, 12))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorPose.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Pose from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Pose) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Pose", false, 12))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPose.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Pose) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, bp.NewInt(32)),
-		bp.NewMessageFieldProcessor(2, bp.NewInt(32)),
-		bp.NewMessageFieldProcessor(3, bp.NewInt(32)),
+// DecodeMasked decodes the fields of struct Pose selected by mask, an or of FIELD_MASK_POSE_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Pose) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_POSE_YAW != 0 {
+		m.Yaw = Pose{}.Yaw
+	}
+	if mask&FIELD_MASK_POSE_PITCH != 0 {
+		m.Pitch = Pose{}.Pitch
+	}
+	if mask&FIELD_MASK_POSE_ROLL != 0 {
+		m.Roll = Pose{}.Roll
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPose.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Pose into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Pose) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Pose", true, 12))
 	}
-	return bp.NewMessageProcessor(false, 96, fieldDescriptors)
+	ctx := bp.AcquireProcessContext(true, s[:12])
+	bpProcessorPose.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 12
+}
+
+// DecodeFrom decodes struct Pose from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Pose) DecodeFrom(s []byte) error {
+	if len(s) < 12 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Pose", false, 12))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPose.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Pose to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 12 bytes left.
+func (m *Pose) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 12 {
+		b = append(b, make([]byte, 12)...)
+	} else {
+		b = b[:n+12]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Pose) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Pose) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 12)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Pose) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Pose, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorPose = bp.NewMessageProcessor(false, 96, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, bp.NewInt(32)),
+	bp.NewMessageFieldProcessor(2, bp.NewInt(32)),
+	bp.NewMessageFieldProcessor(3, bp.NewInt(32)),
+})
+
+func (m *Pose) BpProcessor() bp.Processor {
+	return bpProcessorPose
 }
 
 func (m *Pose) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -616,6 +1643,55 @@ func (m *Pose) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *Pose) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
+// Get field Yaw of struct Pose from given encoded buffer s.
+func BpGetPose_Yaw(s []byte) (v int32) {
+	v = int32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24) & 4294967295)
+	return
+}
+
+// Set field Yaw of struct Pose in given encoded buffer s in place.
+func BpSetPose_Yaw(s []byte, v int32) {
+	s[0] = (s[0] & 0) | ((byte(v) ) & 255)
+	s[1] = (s[1] & 0) | ((byte(v >> 8) ) & 255)
+	s[2] = (s[2] & 0) | ((byte(v >> 16) ) & 255)
+	s[3] = (s[3] & 0) | ((byte(v >> 24) ) & 255)
+}
+
+// Get field Pitch of struct Pose from given encoded buffer s.
+func BpGetPose_Pitch(s []byte) (v int32) {
+	v = int32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24) & 4294967295)
+	return
+}
+
+// Set field Pitch of struct Pose in given encoded buffer s in place.
+func BpSetPose_Pitch(s []byte, v int32) {
+	s[4] = (s[4] & 0) | ((byte(v) ) & 255)
+	s[5] = (s[5] & 0) | ((byte(v >> 8) ) & 255)
+	s[6] = (s[6] & 0) | ((byte(v >> 16) ) & 255)
+	s[7] = (s[7] & 0) | ((byte(v >> 24) ) & 255)
+}
+
+// Get field Roll of struct Pose from given encoded buffer s.
+func BpGetPose_Roll(s []byte) (v int32) {
+	v = int32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24) & 4294967295)
+	return
+}
+
+// Set field Roll of struct Pose in given encoded buffer s in place.
+func BpSetPose_Roll(s []byte, v int32) {
+	s[8] = (s[8] & 0) | ((byte(v) ) & 255)
+	s[9] = (s[9] & 0) | ((byte(v >> 8) ) & 255)
+	s[10] = (s[10] & 0) | ((byte(v >> 16) ) & 255)
+	s[11] = (s[11] & 0) | ((byte(v >> 24) ) & 255)
+}
+
 type Flight struct {
 	Pose Pose `json:"pose"` // 96bit
 	// Velocity at X, Y, Z axis.
@@ -626,34 +1702,195 @@ type Flight struct {
 
 // Number of bytes to serialize struct Flight
 const BYTES_LENGTH_FLIGHT uint32 = 36
+// Layout fingerprint of struct Flight, to check compatibility
+const FINGERPRINT_FLIGHT uint64 = 0xcc6f06d016770753
+
+// Mask bits selecting the fields of struct Flight in DecodeMasked
+const (
+	FIELD_MASK_FLIGHT_POSE uint64 = 1 << 0
+	FIELD_MASK_FLIGHT_VELOCITY uint64 = 1 << 1
+	FIELD_MASK_FLIGHT_ACCELERATION uint64 = 1 << 2
+)
 
 func (m *Flight) Size() uint32 { return 36 }
 
 // Returns string representation for struct Flight.
 func (m *Flight) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Flight to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Flight) AppendJSON(b []byte) []byte {
+	b = append(b, `{"pose":`...)
+	b = m.Pose.AppendJSON(b)
+	b = append(b, `,"velocity":`...)
+	b = append(b, '[')
+	for k0 := range m.Velocity {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = strconv.AppendInt(b, int64(m.Velocity[k0]), 10)
+	}
+	b = append(b, ']')
+	b = append(b, `,"acceleration":`...)
+	b = append(b, '[')
+	for k0 := range m.Acceleration {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = strconv.AppendInt(b, int64(m.Acceleration[k0]), 10)
+	}
+	b = append(b, ']')
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Flight) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Flight by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Flight) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, m.Pose.Hash())
+	for k0 := range m.Velocity {
+		h = bpHashMix(h, uint64(m.Velocity[k0]))
+	}
+	for k0 := range m.Acceleration {
+		h = bpHashMix(h, uint64(m.Acceleration[k0]))
+	}
+	return h
+}
+
+// Equal reports whether struct Flight encodes the same as o, without encoding them.
+func (m *Flight) Equal(o *Flight) bool {
+	if !m.Pose.Equal(&o.Pose) {
+		return false
+	}
+	if m.Velocity != o.Velocity {
+		return false
+	}
+	if m.Acceleration != o.Acceleration {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Flight to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Flight) Reset() {
+	*m = Flight{}
 }
 
 // Encode struct Flight to bytes buffer.
 func (m *Flight) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Flight", true, 36))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorFlight.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Flight from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Flight) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Flight", false, 36))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorFlight.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Flight) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, (&Pose{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(2, (TernaryInt32{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(3, (TernaryInt32{}).BpProcessor()),
+// DecodeMasked decodes the fields of struct Flight selected by mask, an or of FIELD_MASK_FLIGHT_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Flight) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_FLIGHT_POSE != 0 {
+		m.Pose = Flight{}.Pose
+	}
+	if mask&FIELD_MASK_FLIGHT_VELOCITY != 0 {
+		m.Velocity = Flight{}.Velocity
+	}
+	if mask&FIELD_MASK_FLIGHT_ACCELERATION != 0 {
+		m.Acceleration = Flight{}.Acceleration
 	}
-	return bp.NewMessageProcessor(false, 288, fieldDescriptors)
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorFlight.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Flight into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Flight) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Flight", true, 36))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:36])
+	bpProcessorFlight.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 36
+}
+
+// DecodeFrom decodes struct Flight from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Flight) DecodeFrom(s []byte) error {
+	if len(s) < 36 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Flight", false, 36))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorFlight.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Flight to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 36 bytes left.
+func (m *Flight) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 36 {
+		b = append(b, make([]byte, 36)...)
+	} else {
+		b = b[:n+36]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Flight) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Flight) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 36)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Flight) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Flight, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorFlight = bp.NewMessageProcessor(false, 288, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, (&Pose{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(2, (TernaryInt32{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(3, (TernaryInt32{}).BpProcessor()),
+})
+
+func (m *Flight) BpProcessor() bp.Processor {
+	return bpProcessorFlight
 }
 
 func (m *Flight) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -694,38 +1931,227 @@ func (m *Flight) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *Flight) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		case 2:
+			bp.ProcessInt32s(ctx, m.Velocity[:])
+			return true
+		case 3:
+			bp.ProcessInt32s(ctx, m.Acceleration[:])
+			return true
+		default:
+			return false
+	}
+}
+
+// Get field Pose.Yaw of struct Flight from given encoded buffer s.
+func BpGetFlight_Pose_Yaw(s []byte) (v int32) {
+	v = int32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24) & 4294967295)
+	return
+}
+
+// Set field Pose.Yaw of struct Flight in given encoded buffer s in place.
+func BpSetFlight_Pose_Yaw(s []byte, v int32) {
+	s[0] = (s[0] & 0) | ((byte(v) ) & 255)
+	s[1] = (s[1] & 0) | ((byte(v >> 8) ) & 255)
+	s[2] = (s[2] & 0) | ((byte(v >> 16) ) & 255)
+	s[3] = (s[3] & 0) | ((byte(v >> 24) ) & 255)
+}
+
+// Get field Pose.Pitch of struct Flight from given encoded buffer s.
+func BpGetFlight_Pose_Pitch(s []byte) (v int32) {
+	v = int32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24) & 4294967295)
+	return
+}
+
+// Set field Pose.Pitch of struct Flight in given encoded buffer s in place.
+func BpSetFlight_Pose_Pitch(s []byte, v int32) {
+	s[4] = (s[4] & 0) | ((byte(v) ) & 255)
+	s[5] = (s[5] & 0) | ((byte(v >> 8) ) & 255)
+	s[6] = (s[6] & 0) | ((byte(v >> 16) ) & 255)
+	s[7] = (s[7] & 0) | ((byte(v >> 24) ) & 255)
+}
+
+// Get field Pose.Roll of struct Flight from given encoded buffer s.
+func BpGetFlight_Pose_Roll(s []byte) (v int32) {
+	v = int32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24) & 4294967295)
+	return
+}
+
+// Set field Pose.Roll of struct Flight in given encoded buffer s in place.
+func BpSetFlight_Pose_Roll(s []byte, v int32) {
+	s[8] = (s[8] & 0) | ((byte(v) ) & 255)
+	s[9] = (s[9] & 0) | ((byte(v >> 8) ) & 255)
+	s[10] = (s[10] & 0) | ((byte(v >> 16) ) & 255)
+	s[11] = (s[11] & 0) | ((byte(v >> 24) ) & 255)
+}
+
 type PressureSensor struct {
 	Pressures [2]int32 `json:"pressures"` // 48bit
 }
 
 // Number of bytes to serialize struct PressureSensor
 const BYTES_LENGTH_PRESSURE_SENSOR uint32 = 6
+// Layout fingerprint of struct PressureSensor, to check compatibility
+const FINGERPRINT_PRESSURE_SENSOR uint64 = 0x25520a077a42ca16
+
+// Mask bits selecting the fields of struct PressureSensor in DecodeMasked
+const (
+	FIELD_MASK_PRESSURE_SENSOR_PRESSURES uint64 = 1 << 0
+)
 
 func (m *PressureSensor) Size() uint32 { return 6 }
 
 // Returns string representation for struct PressureSensor.
 func (m *PressureSensor) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct PressureSensor to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *PressureSensor) AppendJSON(b []byte) []byte {
+	b = append(b, `{"pressures":`...)
+	b = append(b, '[')
+	for k0 := range m.Pressures {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = strconv.AppendInt(b, int64(m.Pressures[k0]), 10)
+	}
+	b = append(b, ']')
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *PressureSensor) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct PressureSensor by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *PressureSensor) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	for k0 := range m.Pressures {
+		h = bpHashMix(h, uint64(m.Pressures[k0])&16777215)
+	}
+	return h
+}
+
+// Equal reports whether struct PressureSensor encodes the same as o, without encoding them.
+func (m *PressureSensor) Equal(o *PressureSensor) bool {
+	for k0 := range m.Pressures {
+		if uint64(m.Pressures[k0])&16777215 != uint64(o.Pressures[k0])&16777215 {
+			return false
+		}
+	}
+	return true
+}
+
+// Reset sets struct PressureSensor to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *PressureSensor) Reset() {
+	*m = PressureSensor{}
 }
 
 // Encode struct PressureSensor to bytes buffer.
 func (m *PressureSensor) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("PressureSensor", true, 6))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorPressureSensor.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct PressureSensor from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *PressureSensor) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("PressureSensor", false, 6))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPressureSensor.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *PressureSensor) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, bp.NewArray(false, 2, bp.NewInt(24))),
+// DecodeMasked decodes the fields of struct PressureSensor selected by mask, an or of FIELD_MASK_PRESSURE_SENSOR_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *PressureSensor) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_PRESSURE_SENSOR_PRESSURES != 0 {
+		m.Pressures = PressureSensor{}.Pressures
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPressureSensor.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct PressureSensor into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *PressureSensor) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("PressureSensor", true, 6))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:6])
+	bpProcessorPressureSensor.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 6
+}
+
+// DecodeFrom decodes struct PressureSensor from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *PressureSensor) DecodeFrom(s []byte) error {
+	if len(s) < 6 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("PressureSensor", false, 6))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorPressureSensor.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct PressureSensor to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 6 bytes left.
+func (m *PressureSensor) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 6 {
+		b = append(b, make([]byte, 6)...)
+	} else {
+		b = b[:n+6]
 	}
-	return bp.NewMessageProcessor(false, 48, fieldDescriptors)
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *PressureSensor) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *PressureSensor) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 6)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *PressureSensor) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct PressureSensor, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorPressureSensor = bp.NewMessageProcessor(false, 48, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, bp.NewArray(false, 2, bp.NewInt(24))),
+})
+
+func (m *PressureSensor) BpProcessor() bp.Processor {
+	return bpProcessorPressureSensor
 }
 
 func (m *PressureSensor) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -763,6 +2189,13 @@ func (m *PressureSensor) BpProcessInt(di *bp.DataIndexer) {
 	}
 }
 
+func (m *PressureSensor) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
 type Drone struct {
 	Status DroneStatus `json:"status"` // 3bit
 	Position Position `json:"position"` // 96bit
@@ -776,39 +2209,243 @@ type Drone struct {
 
 // Number of bytes to serialize struct Drone
 const BYTES_LENGTH_DRONE uint32 = 67
+// Layout fingerprint of struct Drone, to check compatibility
+const FINGERPRINT_DRONE uint64 = 0x91865dcd474f9fe9
+
+// Mask bits selecting the fields of struct Drone in DecodeMasked
+const (
+	FIELD_MASK_DRONE_STATUS uint64 = 1 << 0
+	FIELD_MASK_DRONE_POSITION uint64 = 1 << 1
+	FIELD_MASK_DRONE_FLIGHT uint64 = 1 << 2
+	FIELD_MASK_DRONE_PROPELLERS uint64 = 1 << 3
+	FIELD_MASK_DRONE_POWER uint64 = 1 << 4
+	FIELD_MASK_DRONE_NETWORK uint64 = 1 << 5
+	FIELD_MASK_DRONE_LANDING_GEAR uint64 = 1 << 6
+	FIELD_MASK_DRONE_PRESSURE_SENSOR uint64 = 1 << 7
+)
 
 func (m *Drone) Size() uint32 { return 67 }
 
 // Returns string representation for struct Drone.
 func (m *Drone) String() string {
-	v, _ := jsonMarshal(m)
-	return string(v)
+	return string(m.AppendJSON(nil))
+}
+
+// AppendJSON appends the json format of struct Drone to b, and returns the extended buffer.
+// The output is the same to the C library's, without reflection.
+func (m *Drone) AppendJSON(b []byte) []byte {
+	b = append(b, `{"status":`...)
+	b = strconv.AppendUint(b, uint64(m.Status), 10)
+	b = append(b, `,"position":`...)
+	b = m.Position.AppendJSON(b)
+	b = append(b, `,"flight":`...)
+	b = m.Flight.AppendJSON(b)
+	b = append(b, `,"propellers":`...)
+	b = append(b, '[')
+	for k0 := range m.Propellers {
+		if k0 > 0 {
+			b = append(b, ',')
+		}
+		b = m.Propellers[k0].AppendJSON(b)
+	}
+	b = append(b, ']')
+	b = append(b, `,"power":`...)
+	b = m.Power.AppendJSON(b)
+	b = append(b, `,"network":`...)
+	b = m.Network.AppendJSON(b)
+	b = append(b, `,"landing_gear":`...)
+	b = m.LandingGear.AppendJSON(b)
+	b = append(b, `,"pressure_sensor":`...)
+	b = m.PressureSensor.AppendJSON(b)
+	b = append(b, '}')
+	return b
+}
+
+// MarshalJSON implements json.Marshaler.
+func (m *Drone) MarshalJSON() ([]byte, error) {
+	return m.AppendJSON(nil), nil
+}
+
+// Hash returns the hash of struct Drone by the bits of its fields to encode, without encoding it.
+// Messages equal by Equal have the same hash.
+func (m *Drone) Hash() uint64 {
+	h := uint64(0xcbf29ce484222325)
+	h = bpHashMix(h, uint64(m.Status)&7)
+	h = bpHashMix(h, m.Position.Hash())
+	h = bpHashMix(h, m.Flight.Hash())
+	for k0 := range m.Propellers {
+		h = bpHashMix(h, m.Propellers[k0].Hash())
+	}
+	h = bpHashMix(h, m.Power.Hash())
+	h = bpHashMix(h, m.Network.Hash())
+	h = bpHashMix(h, m.LandingGear.Hash())
+	h = bpHashMix(h, m.PressureSensor.Hash())
+	return h
+}
+
+// Equal reports whether struct Drone encodes the same as o, without encoding them.
+func (m *Drone) Equal(o *Drone) bool {
+	if uint64(m.Status)&7 != uint64(o.Status)&7 {
+		return false
+	}
+	if !m.Position.Equal(&o.Position) {
+		return false
+	}
+	if !m.Flight.Equal(&o.Flight) {
+		return false
+	}
+	for k0 := range m.Propellers {
+		if !m.Propellers[k0].Equal(&o.Propellers[k0]) {
+			return false
+		}
+	}
+	if !m.Power.Equal(&o.Power) {
+		return false
+	}
+	if !m.Network.Equal(&o.Network) {
+		return false
+	}
+	if !m.LandingGear.Equal(&o.LandingGear) {
+		return false
+	}
+	if !m.PressureSensor.Equal(&o.PressureSensor) {
+		return false
+	}
+	return true
+}
+
+// Reset sets struct Drone to its zero value, for it to be reused, e.g. from a sync.Pool.
+func (m *Drone) Reset() {
+	*m = Drone{}
 }
 
 // Encode struct Drone to bytes buffer.
 func (m *Drone) Encode() []byte {
-	ctx := bp.NewEncodeContext(int(m.Size()))
-	m.BpProcessor().Process(ctx, nil, m)
-	return ctx.Buffer()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Drone", true, 67))
+	}
+	s := make([]byte, m.Size())
+	ctx := bp.AcquireProcessContext(true, s)
+	bpProcessorDrone.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return s
 }
 
+// Decode decodes struct Drone from given buffer s, every field is overwritten.
+// The struct is reset before decoding, so that it's safe to reuse, e.g. from a sync.Pool.
 func (m *Drone) Decode(s []byte) {
-	ctx := bp.NewDecodeContext(s)
-	m.BpProcessor().Process(ctx, nil, m)
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Drone", false, 67))
+	}
+	m.Reset()
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorDrone.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
 }
 
-func (m *Drone) BpProcessor() bp.Processor {
-	fieldDescriptors := []*bp.MessageFieldProcessor{
-		bp.NewMessageFieldProcessor(1, (DroneStatus(0)).BpProcessor()),
-		bp.NewMessageFieldProcessor(2, (&Position{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(3, (&Flight{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(4, bp.NewArray(false, 4, (&Propeller{}).BpProcessor())),
-		bp.NewMessageFieldProcessor(5, (&Power{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(6, (&Network{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(7, (&LandingGear{}).BpProcessor()),
-		bp.NewMessageFieldProcessor(8, (&PressureSensor{}).BpProcessor()),
+// DecodeMasked decodes the fields of struct Drone selected by mask, an or of FIELD_MASK_DRONE_*, from given buffer s.
+// Others are skipped and left untouched, the fields selected are reset before decoding.
+func (m *Drone) DecodeMasked(s []byte, mask uint64) {
+	if mask&FIELD_MASK_DRONE_STATUS != 0 {
+		m.Status = Drone{}.Status
+	}
+	if mask&FIELD_MASK_DRONE_POSITION != 0 {
+		m.Position = Drone{}.Position
+	}
+	if mask&FIELD_MASK_DRONE_FLIGHT != 0 {
+		m.Flight = Drone{}.Flight
+	}
+	if mask&FIELD_MASK_DRONE_PROPELLERS != 0 {
+		m.Propellers = Drone{}.Propellers
+	}
+	if mask&FIELD_MASK_DRONE_POWER != 0 {
+		m.Power = Drone{}.Power
+	}
+	if mask&FIELD_MASK_DRONE_NETWORK != 0 {
+		m.Network = Drone{}.Network
 	}
-	return bp.NewMessageProcessor(false, 532, fieldDescriptors)
+	if mask&FIELD_MASK_DRONE_LANDING_GEAR != 0 {
+		m.LandingGear = Drone{}.LandingGear
+	}
+	if mask&FIELD_MASK_DRONE_PRESSURE_SENSOR != 0 {
+		m.PressureSensor = Drone{}.PressureSensor
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorDrone.DecodeMasked(ctx, m, mask)
+	bp.ReleaseProcessContext(ctx)
+}
+
+// EncodeTo encodes struct Drone into given buffer s, without allocations.
+// It panics if s is shorter than Size() bytes, returns the number of bytes written.
+func (m *Drone) EncodeTo(s []byte) int {
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Drone", true, 67))
+	}
+	ctx := bp.AcquireProcessContext(true, s[:67])
+	bpProcessorDrone.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return 67
+}
+
+// DecodeFrom decodes struct Drone from given buffer s, without allocations.
+// The struct is reset before decoding, so that it's safe to reuse.
+// Returns bp.ErrShortInput if s is shorter than Size() bytes.
+func (m *Drone) DecodeFrom(s []byte) error {
+	if len(s) < 67 {
+		return bp.ErrShortInput
+	}
+	m.Reset()
+	if t := bp.GetTracer(); t != nil {
+		defer t.End(t.Begin("Drone", false, 67))
+	}
+	ctx := bp.AcquireProcessContext(false, s)
+	bpProcessorDrone.Process(ctx, nil, m)
+	bp.ReleaseProcessContext(ctx)
+	return nil
+}
+
+// AppendEncode appends the encoding of struct Drone to b, and returns the extended buffer.
+// It doesn't allocate if b has a capacity of 67 bytes left.
+func (m *Drone) AppendEncode(b []byte) []byte {
+	n := len(b)
+	if cap(b)-n < 67 {
+		b = append(b, make([]byte, 67)...)
+	} else {
+		b = b[:n+67]
+	}
+	m.EncodeTo(b[n:])
+	return b
+}
+
+// AppendBinary implements encoding.BinaryAppender.
+func (m *Drone) AppendBinary(b []byte) ([]byte, error) {
+	return m.AppendEncode(b), nil
+}
+
+// MarshalBinary implements encoding.BinaryMarshaler.
+func (m *Drone) MarshalBinary() ([]byte, error) {
+	return m.AppendEncode(make([]byte, 0, 67)), nil
+}
+
+// UnmarshalBinary implements encoding.BinaryUnmarshaler, the same to DecodeFrom.
+func (m *Drone) UnmarshalBinary(s []byte) error {
+	return m.DecodeFrom(s)
+}
+
+// Processor of struct Drone, built once at init and shared by all encoding and decoding, it's immutable.
+var bpProcessorDrone = bp.NewMessageProcessor(false, 532, []*bp.MessageFieldProcessor{
+	bp.NewMessageFieldProcessor(1, (DroneStatus(0)).BpProcessor()),
+	bp.NewMessageFieldProcessor(2, (&Position{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(3, (&Flight{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(4, bp.NewArray(false, 4, (&Propeller{}).BpProcessor())),
+	bp.NewMessageFieldProcessor(5, (&Power{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(6, (&Network{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(7, (&LandingGear{}).BpProcessor()),
+	bp.NewMessageFieldProcessor(8, (&PressureSensor{}).BpProcessor()),
+})
+
+func (m *Drone) BpProcessor() bp.Processor {
+	return bpProcessorDrone
 }
 
 func (m *Drone) BpGetAccessor(di *bp.DataIndexer) bp.Accessor {
@@ -855,4 +2492,251 @@ func (m *Drone) BpProcessInt(di *bp.DataIndexer) {
 		default:
 			return
 	}
+}
+
+func (m *Drone) BpProcessArray(ctx *bp.ProcessContext, di *bp.DataIndexer) bool {
+	switch di.F() {
+		default:
+			return false
+	}
+}
+
+// Get field Status of struct Drone from given encoded buffer s.
+func BpGetDrone_Status(s []byte) (v DroneStatus) {
+	v |= DroneStatus(byte(s[0] ) & 7)
+	return
+}
+
+// Set field Status of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Status(s []byte, v DroneStatus) {
+	s[0] = (s[0] & 248) | ((byte(v) ) & 7)
+}
+
+// Get field Position.Latitude of struct Drone from given encoded buffer s.
+func BpGetDrone_Position_Latitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Position.Latitude of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Position_Latitude(s []byte, v uint32) {
+	s[0] = (s[0] & 7) | ((byte(v) << 3) & 248)
+	s[1] = (s[1] & 248) | ((byte(v) >> 5) & 7)
+	s[1] = (s[1] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[2] = (s[2] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[2] = (s[2] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[3] = (s[3] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[3] = (s[3] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[4] = (s[4] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Position.Longitude of struct Drone from given encoded buffer s.
+func BpGetDrone_Position_Longitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[4]) | uint64(s[5])<<8 | uint64(s[6])<<16 | uint64(s[7])<<24 | uint64(s[8])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Position.Longitude of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Position_Longitude(s []byte, v uint32) {
+	s[4] = (s[4] & 7) | ((byte(v) << 3) & 248)
+	s[5] = (s[5] & 248) | ((byte(v) >> 5) & 7)
+	s[5] = (s[5] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[6] = (s[6] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[6] = (s[6] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[7] = (s[7] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[7] = (s[7] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[8] = (s[8] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Position.Altitude of struct Drone from given encoded buffer s.
+func BpGetDrone_Position_Altitude(s []byte) (v uint32) {
+	v = uint32((uint64(s[8]) | uint64(s[9])<<8 | uint64(s[10])<<16 | uint64(s[11])<<24 | uint64(s[12])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Position.Altitude of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Position_Altitude(s []byte, v uint32) {
+	s[8] = (s[8] & 7) | ((byte(v) << 3) & 248)
+	s[9] = (s[9] & 248) | ((byte(v) >> 5) & 7)
+	s[9] = (s[9] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[10] = (s[10] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[10] = (s[10] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[11] = (s[11] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[11] = (s[11] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[12] = (s[12] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Flight.Pose.Yaw of struct Drone from given encoded buffer s.
+func BpGetDrone_Flight_Pose_Yaw(s []byte) (v int32) {
+	v = int32((uint64(s[12]) | uint64(s[13])<<8 | uint64(s[14])<<16 | uint64(s[15])<<24 | uint64(s[16])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Flight.Pose.Yaw of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Flight_Pose_Yaw(s []byte, v int32) {
+	s[12] = (s[12] & 7) | ((byte(v) << 3) & 248)
+	s[13] = (s[13] & 248) | ((byte(v) >> 5) & 7)
+	s[13] = (s[13] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[14] = (s[14] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[14] = (s[14] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[15] = (s[15] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[15] = (s[15] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[16] = (s[16] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Flight.Pose.Pitch of struct Drone from given encoded buffer s.
+func BpGetDrone_Flight_Pose_Pitch(s []byte) (v int32) {
+	v = int32((uint64(s[16]) | uint64(s[17])<<8 | uint64(s[18])<<16 | uint64(s[19])<<24 | uint64(s[20])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Flight.Pose.Pitch of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Flight_Pose_Pitch(s []byte, v int32) {
+	s[16] = (s[16] & 7) | ((byte(v) << 3) & 248)
+	s[17] = (s[17] & 248) | ((byte(v) >> 5) & 7)
+	s[17] = (s[17] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[18] = (s[18] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[18] = (s[18] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[19] = (s[19] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[19] = (s[19] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[20] = (s[20] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Flight.Pose.Roll of struct Drone from given encoded buffer s.
+func BpGetDrone_Flight_Pose_Roll(s []byte) (v int32) {
+	v = int32((uint64(s[20]) | uint64(s[21])<<8 | uint64(s[22])<<16 | uint64(s[23])<<24 | uint64(s[24])<<32) >> 3 & 4294967295)
+	return
+}
+
+// Set field Flight.Pose.Roll of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Flight_Pose_Roll(s []byte, v int32) {
+	s[20] = (s[20] & 7) | ((byte(v) << 3) & 248)
+	s[21] = (s[21] & 248) | ((byte(v) >> 5) & 7)
+	s[21] = (s[21] & 7) | ((byte(v >> 8) << 3) & 248)
+	s[22] = (s[22] & 248) | ((byte(v >> 8) >> 5) & 7)
+	s[22] = (s[22] & 7) | ((byte(v >> 16) << 3) & 248)
+	s[23] = (s[23] & 248) | ((byte(v >> 16) >> 5) & 7)
+	s[23] = (s[23] & 7) | ((byte(v >> 24) << 3) & 248)
+	s[24] = (s[24] & 248) | ((byte(v >> 24) >> 5) & 7)
+}
+
+// Get field Power.Battery of struct Drone from given encoded buffer s.
+func BpGetDrone_Power_Battery(s []byte) (v uint8) {
+	v = uint8((uint64(s[54]) | uint64(s[55])<<8) >> 3 & 255)
+	return
+}
+
+// Set field Power.Battery of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Power_Battery(s []byte, v uint8) {
+	s[54] = (s[54] & 7) | ((byte(v) << 3) & 248)
+	s[55] = (s[55] & 248) | ((byte(v) >> 5) & 7)
+}
+
+// Get field Power.Status of struct Drone from given encoded buffer s.
+func BpGetDrone_Power_Status(s []byte) (v PowerStatus) {
+	v |= PowerStatus(byte(s[55] >> 3) & 3)
+	return
+}
+
+// Set field Power.Status of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Power_Status(s []byte, v PowerStatus) {
+	s[55] = (s[55] & 231) | ((byte(v) << 3) & 24)
+}
+
+// Get field Power.IsCharging of struct Drone from given encoded buffer s.
+func BpGetDrone_Power_IsCharging(s []byte) (v bool) {
+	v = byte2bool(byte(s[55] >> 5) & 1)
+	return
+}
+
+// Set field Power.IsCharging of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Power_IsCharging(s []byte, v bool) {
+	s[55] = (s[55] & 223) | ((byte(bool2byte(v)) << 5) & 32)
+}
+
+// Get field Network.Signal of struct Drone from given encoded buffer s.
+func BpGetDrone_Network_Signal(s []byte) (v uint8) {
+	v = uint8((uint64(s[55]) | uint64(s[56])<<8) >> 6 & 15)
+	return
+}
+
+// Set field Network.Signal of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Network_Signal(s []byte, v uint8) {
+	s[55] = (s[55] & 63) | ((byte(v) << 6) & 192)
+	s[56] = (s[56] & 252) | ((byte(v) >> 2) & 3)
+}
+
+// Get field Network.HeartbeatAt of struct Drone from given encoded buffer s.
+func BpGetDrone_Network_HeartbeatAt(s []byte) (v Timestamp) {
+	v = Timestamp((uint64(s[56]) | uint64(s[57])<<8 | uint64(s[58])<<16 | uint64(s[59])<<24 | uint64(s[60])<<32) >> 2 & 4294967295)
+	return
+}
+
+// Set field Network.HeartbeatAt of struct Drone in given encoded buffer s in place.
+func BpSetDrone_Network_HeartbeatAt(s []byte, v Timestamp) {
+	s[56] = (s[56] & 3) | ((byte(v) << 2) & 252)
+	s[57] = (s[57] & 252) | ((byte(v) >> 6) & 3)
+	s[57] = (s[57] & 3) | ((byte(v >> 8) << 2) & 252)
+	s[58] = (s[58] & 252) | ((byte(v >> 8) >> 6) & 3)
+	s[58] = (s[58] & 3) | ((byte(v >> 16) << 2) & 252)
+	s[59] = (s[59] & 252) | ((byte(v >> 16) >> 6) & 3)
+	s[59] = (s[59] & 3) | ((byte(v >> 24) << 2) & 252)
+	s[60] = (s[60] & 252) | ((byte(v >> 24) >> 6) & 3)
+}
+
+// Get field LandingGear.Status of struct Drone from given encoded buffer s.
+func BpGetDrone_LandingGear_Status(s []byte) (v LandingGearStatus) {
+	v |= LandingGearStatus(byte(s[60] >> 2) & 3)
+	return
+}
+
+// Set field LandingGear.Status of struct Drone in given encoded buffer s in place.
+func BpSetDrone_LandingGear_Status(s []byte, v LandingGearStatus) {
+	s[60] = (s[60] & 243) | ((byte(v) << 2) & 12)
+}
+
+func bool2byte(b bool) byte {
+	if b {
+		return 1
+	}
+	return 0
+}
+
+func byte2bool(b byte) bool {
+	if b > 0 {
+		return true
+	}
+	return false
+}
+
+// bpHashMix mixes the 64 bits word w into the hash h.
+func bpHashMix(h, w uint64) uint64 {
+	h = (h ^ w) * 0x9e3779b97f4a7c15
+	return h ^ h>>32
+}
+
+// bpHashBytes mixes the bytes s into the hash h, 8 at a time.
+func bpHashBytes(h uint64, s []byte) uint64 {
+	for ; len(s) >= 8; s = s[8:] {
+		w := uint64(s[0]) | uint64(s[1])<<8 | uint64(s[2])<<16 | uint64(s[3])<<24 | uint64(s[4])<<32 | uint64(s[5])<<40 | uint64(s[6])<<48 | uint64(s[7])<<56
+		h = bpHashMix(h, w)
+	}
+	if len(s) > 0 {
+		var w uint64
+		for k, b := range s {
+			w |= uint64(b) << (8 * uint(k))
+		}
+		h = bpHashMix(h, w)
+	}
+	return h
+}
+
+// bpFixedWord rounds the scaled fixed-point value r the same as the encoder.
+func bpFixedWord(r float64) uint64 {
+	if r >= 0 {
+		return uint64(r + 0.5)
+	} else if r < 0 {
+		return uint64(int64(r - 0.5))
+	}
+	return 0
 }
\ No newline at end of file
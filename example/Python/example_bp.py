@@ -8,7 +8,7 @@ Proto drone describes the structure of the drone.
 
 import json
 from dataclasses import dataclass, field
-from typing import ClassVar, Dict, List, Union
+from typing import Any, ClassVar, Dict, List, Optional, Union
 from enum import IntEnum, unique
 
 from bitprotolib import bp
@@ -157,6 +157,8 @@ def bp_processor_LandingGearStatus() -> bp.Processor:
 class Propeller(bp.MessageBase):
     # Number of bytes to serialize class Propeller
     BYTES_LENGTH: ClassVar[int] = 2
+    # Layout fingerprint of class Propeller, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x1241850b2d64cf1d
 
     id: int = 0 # 8bit
     status: Union[int, PropellerStatus] = PropellerStatus.PROPELLER_STATUS_UNKNOWN
@@ -224,14 +226,40 @@ class Propeller(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.id & 255
+        v |= (self.status & 3) << 8
+        v |= (self.direction & 3) << 10
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.id = v & 255
+        self.status = (v >> 8) & 3
+        self.direction = (v >> 10) & 3
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -239,17 +267,70 @@ class Propeller(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("id", 0, 8, "uint"),
+            ("status", 8, 2, "uint"),
+            ("direction", 10, 2, "uint"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class PropellerView(bp.MessageView):
+    """
+    Read-only view of a Propeller in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 2
+
+    @property
+    def id(self) -> int:
+        return self.bp_uint(0, 8)
+
+    @property
+    def status(self) -> PropellerStatus:
+        return PropellerStatus(self.bp_uint(8, 2))
+
+    @property
+    def direction(self) -> RotatingDirection:
+        return RotatingDirection(self.bp_uint(10, 2))
+
+    def to_message(self) -> Propeller:
+        """
+        Decode the whole message to a Propeller object.
+        """
+        m = Propeller()
+        m.bp_decode_bigint(self.bp_uint(0, 12))
+        return m
+
+
 @dataclass
 class Power(bp.MessageBase):
     # Number of bytes to serialize class Power
     BYTES_LENGTH: ClassVar[int] = 2
+    # Layout fingerprint of class Power, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x7f6afefbea0323ac
 
     battery: int = 0 # 8bit
     status: Union[int, PowerStatus] = PowerStatus.POWER_STATUS_UNKNOWN
@@ -304,14 +385,40 @@ class Power(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.battery & 255
+        v |= (self.status & 3) << 8
+        v |= (self.is_charging & 1) << 10
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.battery = v & 255
+        self.status = (v >> 8) & 3
+        self.is_charging = bool((v >> 10) & 1)
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -319,17 +426,70 @@ class Power(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("battery", 0, 8, "uint"),
+            ("status", 8, 2, "uint"),
+            ("is_charging", 10, 1, "bool"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class PowerView(bp.MessageView):
+    """
+    Read-only view of a Power in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 2
+
+    @property
+    def battery(self) -> int:
+        return self.bp_uint(0, 8)
+
+    @property
+    def status(self) -> PowerStatus:
+        return PowerStatus(self.bp_uint(8, 2))
+
+    @property
+    def is_charging(self) -> bool:
+        return self.bp_uint(10, 1) != 0
+
+    def to_message(self) -> Power:
+        """
+        Decode the whole message to a Power object.
+        """
+        m = Power()
+        m.bp_decode_bigint(self.bp_uint(0, 11))
+        return m
+
+
 @dataclass
 class Network(bp.MessageBase):
     # Number of bytes to serialize class Network
     BYTES_LENGTH: ClassVar[int] = 5
+    # Layout fingerprint of class Network, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x1c0359e538b559ec
 
     # Degree of signal, between 1~10.
     signal: int = 0 # 4bit
@@ -367,14 +527,38 @@ class Network(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.signal & 15
+        v |= (self.heartbeat_at & 4294967295) << 4
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.signal = v & 15
+        self.heartbeat_at = (((v >> 4) & 4294967295) ^ 2147483648) - 2147483648
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -382,17 +566,65 @@ class Network(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("signal", 0, 4, "uint"),
+            ("heartbeat_at", 4, 32, "int"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class NetworkView(bp.MessageView):
+    """
+    Read-only view of a Network in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 5
+
+    @property
+    def signal(self) -> int:
+        return self.bp_uint(0, 4)
+
+    @property
+    def heartbeat_at(self) -> int:
+        return self.bp_int(4, 32)
+
+    def to_message(self) -> Network:
+        """
+        Decode the whole message to a Network object.
+        """
+        m = Network()
+        m.bp_decode_bigint(self.bp_uint(0, 36))
+        return m
+
+
 @dataclass
 class LandingGear(bp.MessageBase):
     # Number of bytes to serialize class LandingGear
     BYTES_LENGTH: ClassVar[int] = 1
+    # Layout fingerprint of class LandingGear, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x5121345b5280acf2
 
     status: Union[int, LandingGearStatus] = LandingGearStatus.LANDING_GEAR_STATUS_UNKNOWN
     # This field is a proxy to hold integer value of enum field 'status'
@@ -435,14 +667,36 @@ class LandingGear(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.status & 3
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.status = v & 3
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -450,17 +704,60 @@ class LandingGear(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("status", 0, 2, "uint"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class LandingGearView(bp.MessageView):
+    """
+    Read-only view of a LandingGear in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 1
+
+    @property
+    def status(self) -> LandingGearStatus:
+        return LandingGearStatus(self.bp_uint(0, 2))
+
+    def to_message(self) -> LandingGear:
+        """
+        Decode the whole message to a LandingGear object.
+        """
+        m = LandingGear()
+        m.bp_decode_bigint(self.bp_uint(0, 2))
+        return m
+
+
 @dataclass
 class Position(bp.MessageBase):
     # Number of bytes to serialize class Position
     BYTES_LENGTH: ClassVar[int] = 12
+    # Layout fingerprint of class Position, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x630a402d68f5f706
 
     latitude: int = 0 # 32bit
     longitude: int = 0 # 32bit
@@ -502,14 +799,40 @@ class Position(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.latitude & 4294967295
+        v |= (self.longitude & 4294967295) << 32
+        v |= (self.altitude & 4294967295) << 64
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.latitude = v & 4294967295
+        self.longitude = (v >> 32) & 4294967295
+        self.altitude = (v >> 64) & 4294967295
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -517,13 +840,64 @@ class Position(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("latitude", 0, 32, "uint"),
+            ("longitude", 32, 32, "uint"),
+            ("altitude", 64, 32, "uint"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class PositionView(bp.MessageView):
+    """
+    Read-only view of a Position in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 12
+
+    @property
+    def latitude(self) -> int:
+        return self.bp_uint(0, 32)
+
+    @property
+    def longitude(self) -> int:
+        return self.bp_uint(32, 32)
+
+    @property
+    def altitude(self) -> int:
+        return self.bp_uint(64, 32)
+
+    def to_message(self) -> Position:
+        """
+        Decode the whole message to a Position object.
+        """
+        m = Position()
+        m.bp_decode_bigint(self.bp_uint(0, 96))
+        return m
+
+
 @dataclass
 class Pose(bp.MessageBase):
     """
@@ -531,6 +905,8 @@ class Pose(bp.MessageBase):
     """
     # Number of bytes to serialize class Pose
     BYTES_LENGTH: ClassVar[int] = 12
+    # Layout fingerprint of class Pose, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0xc2e32b9442c9c9a5
 
     yaw: int = 0 # 32bit
     pitch: int = 0 # 32bit
@@ -572,14 +948,40 @@ class Pose(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.yaw & 4294967295
+        v |= (self.pitch & 4294967295) << 32
+        v |= (self.roll & 4294967295) << 64
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.yaw = ((v & 4294967295) ^ 2147483648) - 2147483648
+        self.pitch = (((v >> 32) & 4294967295) ^ 2147483648) - 2147483648
+        self.roll = (((v >> 64) & 4294967295) ^ 2147483648) - 2147483648
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -587,17 +989,70 @@ class Pose(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("yaw", 0, 32, "int"),
+            ("pitch", 32, 32, "int"),
+            ("roll", 64, 32, "int"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class PoseView(bp.MessageView):
+    """
+    Read-only view of a Pose in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 12
+
+    @property
+    def yaw(self) -> int:
+        return self.bp_int(0, 32)
+
+    @property
+    def pitch(self) -> int:
+        return self.bp_int(32, 32)
+
+    @property
+    def roll(self) -> int:
+        return self.bp_int(64, 32)
+
+    def to_message(self) -> Pose:
+        """
+        Decode the whole message to a Pose object.
+        """
+        m = Pose()
+        m.bp_decode_bigint(self.bp_uint(0, 96))
+        return m
+
+
 @dataclass
 class Flight(bp.MessageBase):
     # Number of bytes to serialize class Flight
     BYTES_LENGTH: ClassVar[int] = 36
+    # Layout fingerprint of class Flight, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0xcc6f06d016770753
 
     pose: Pose = field(default_factory=Pose) # 96bit
     # Velocity at X, Y, Z axis.
@@ -639,14 +1094,46 @@ class Flight(bp.MessageBase):
             return self.pose
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.pose.yaw & 4294967295
+        v |= (self.pose.pitch & 4294967295) << 32
+        v |= (self.pose.roll & 4294967295) << 64
+        v |= sum((x & 4294967295) << (32 * k) for k, x in enumerate(self.velocity[:3])) << 96
+        v |= sum((x & 4294967295) << (32 * k) for k, x in enumerate(self.acceleration[:3])) << 192
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.pose.yaw = ((v & 4294967295) ^ 2147483648) - 2147483648
+        self.pose.pitch = (((v >> 32) & 4294967295) ^ 2147483648) - 2147483648
+        self.pose.roll = (((v >> 64) & 4294967295) ^ 2147483648) - 2147483648
+        w = (v >> 96) & 79228162514264337593543950335
+        self.velocity[:] = [(((w >> (32 * k)) & 4294967295) ^ 2147483648) - 2147483648 for k in range(3)]
+        w = (v >> 192) & 79228162514264337593543950335
+        self.acceleration[:] = [(((w >> (32 * k)) & 4294967295) ^ 2147483648) - 2147483648 for k in range(3)]
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -654,17 +1141,76 @@ class Flight(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("pose.yaw", 0, 32, "int"),
+            ("pose.pitch", 32, 32, "int"),
+            ("pose.roll", 64, 32, "int"),
+            ("velocity[0]", 96, 32, "int"),
+            ("velocity[1]", 128, 32, "int"),
+            ("velocity[2]", 160, 32, "int"),
+            ("acceleration[0]", 192, 32, "int"),
+            ("acceleration[1]", 224, 32, "int"),
+            ("acceleration[2]", 256, 32, "int"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         return
 
 
+class FlightView(bp.MessageView):
+    """
+    Read-only view of a Flight in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 36
+
+    @property
+    def pose(self) -> "PoseView":
+        return PoseView.bp_at(self.bp_s, self.bp_i + 0)
+
+    @property
+    def velocity(self) -> List[int]:
+        return [self.bp_int(96 + 32 * k0, 32) for k0 in range(3)]
+
+    @property
+    def acceleration(self) -> List[int]:
+        return [self.bp_int(192 + 32 * k0, 32) for k0 in range(3)]
+
+    def to_message(self) -> Flight:
+        """
+        Decode the whole message to a Flight object.
+        """
+        m = Flight()
+        m.bp_decode_bigint(self.bp_uint(0, 288))
+        return m
+
+
 @dataclass
 class PressureSensor(bp.MessageBase):
     # Number of bytes to serialize class PressureSensor
     BYTES_LENGTH: ClassVar[int] = 6
+    # Layout fingerprint of class PressureSensor, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x25520a077a42ca16
 
     pressures: List[int] = field(default_factory=lambda: [0 for _ in range(2)]) # 48bit
 
@@ -694,14 +1240,37 @@ class PressureSensor(bp.MessageBase):
     def bp_get_accessor(self, di: bp.DataIndexer) -> bp.Accessor:
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= sum((x & 16777215) << (24 * k) for k, x in enumerate(self.pressures[:2]))
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        w = v & 281474976710655
+        self.pressures[:] = [(((w >> (24 * k)) & 16777215) ^ 8388608) - 8388608 for k in range(2)]
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -709,8 +1278,29 @@ class PressureSensor(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("pressures[0]", 0, 24, "int"),
+            ("pressures[1]", 24, 24, "int"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
         if di.field_number == 1:
@@ -720,10 +1310,33 @@ class PressureSensor(bp.MessageBase):
         return
 
 
+class PressureSensorView(bp.MessageView):
+    """
+    Read-only view of a PressureSensor in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 6
+
+    @property
+    def pressures(self) -> List[int]:
+        return [self.bp_int(0 + 24 * k0, 24) for k0 in range(2)]
+
+    def to_message(self) -> PressureSensor:
+        """
+        Decode the whole message to a PressureSensor object.
+        """
+        m = PressureSensor()
+        m.bp_decode_bigint(self.bp_uint(0, 48))
+        return m
+
+
 @dataclass
 class Drone(bp.MessageBase):
     # Number of bytes to serialize class Drone
     BYTES_LENGTH: ClassVar[int] = 67
+    # Layout fingerprint of class Drone, to check compatibility
+    FINGERPRINT: ClassVar[int] = 0x91865dcd474f9fe9
 
     status: Union[int, DroneStatus] = DroneStatus.DRONE_STATUS_UNKNOWN
     # This field is a proxy to hold integer value of enum field 'status'
@@ -794,14 +1407,93 @@ class Drone(bp.MessageBase):
             return self.pressure_sensor
         return bp.NilAccessor() # Won't reached
 
+    def bp_encode_bigint(self) -> int:
+        """
+        Encode this object to a big integer in little endian.
+        """
+        v = 0
+        v |= self.status & 7
+        v |= (self.position.latitude & 4294967295) << 3
+        v |= (self.position.longitude & 4294967295) << 35
+        v |= (self.position.altitude & 4294967295) << 67
+        v |= (self.flight.pose.yaw & 4294967295) << 99
+        v |= (self.flight.pose.pitch & 4294967295) << 131
+        v |= (self.flight.pose.roll & 4294967295) << 163
+        v |= sum((x & 4294967295) << (32 * k) for k, x in enumerate(self.flight.velocity[:3])) << 195
+        v |= sum((x & 4294967295) << (32 * k) for k, x in enumerate(self.flight.acceleration[:3])) << 291
+        v |= (self.propellers[0].id & 255) << 387
+        v |= (self.propellers[0].status & 3) << 395
+        v |= (self.propellers[0].direction & 3) << 397
+        v |= (self.propellers[1].id & 255) << 399
+        v |= (self.propellers[1].status & 3) << 407
+        v |= (self.propellers[1].direction & 3) << 409
+        v |= (self.propellers[2].id & 255) << 411
+        v |= (self.propellers[2].status & 3) << 419
+        v |= (self.propellers[2].direction & 3) << 421
+        v |= (self.propellers[3].id & 255) << 423
+        v |= (self.propellers[3].status & 3) << 431
+        v |= (self.propellers[3].direction & 3) << 433
+        v |= (self.power.battery & 255) << 435
+        v |= (self.power.status & 3) << 443
+        v |= (self.power.is_charging & 1) << 445
+        v |= (self.network.signal & 15) << 446
+        v |= (self.network.heartbeat_at & 4294967295) << 450
+        v |= (self.landing_gear.status & 3) << 482
+        v |= sum((x & 16777215) << (24 * k) for k, x in enumerate(self.pressure_sensor.pressures[:2])) << 484
+        return v
+
+    def bp_decode_bigint(self, v: int) -> None:
+        """
+        Decode given big integer v in little endian to this object.
+        """
+        self.status = v & 7
+        self.position.latitude = (v >> 3) & 4294967295
+        self.position.longitude = (v >> 35) & 4294967295
+        self.position.altitude = (v >> 67) & 4294967295
+        self.flight.pose.yaw = (((v >> 99) & 4294967295) ^ 2147483648) - 2147483648
+        self.flight.pose.pitch = (((v >> 131) & 4294967295) ^ 2147483648) - 2147483648
+        self.flight.pose.roll = (((v >> 163) & 4294967295) ^ 2147483648) - 2147483648
+        w = (v >> 195) & 79228162514264337593543950335
+        self.flight.velocity[:] = [(((w >> (32 * k)) & 4294967295) ^ 2147483648) - 2147483648 for k in range(3)]
+        w = (v >> 291) & 79228162514264337593543950335
+        self.flight.acceleration[:] = [(((w >> (32 * k)) & 4294967295) ^ 2147483648) - 2147483648 for k in range(3)]
+        self.propellers[0].id = (v >> 387) & 255
+        self.propellers[0].status = (v >> 395) & 3
+        self.propellers[0].direction = (v >> 397) & 3
+        self.propellers[1].id = (v >> 399) & 255
+        self.propellers[1].status = (v >> 407) & 3
+        self.propellers[1].direction = (v >> 409) & 3
+        self.propellers[2].id = (v >> 411) & 255
+        self.propellers[2].status = (v >> 419) & 3
+        self.propellers[2].direction = (v >> 421) & 3
+        self.propellers[3].id = (v >> 423) & 255
+        self.propellers[3].status = (v >> 431) & 3
+        self.propellers[3].direction = (v >> 433) & 3
+        self.power.battery = (v >> 435) & 255
+        self.power.status = (v >> 443) & 3
+        self.power.is_charging = bool((v >> 445) & 1)
+        self.network.signal = (v >> 446) & 15
+        self.network.heartbeat_at = (((v >> 450) & 4294967295) ^ 2147483648) - 2147483648
+        self.landing_gear.status = (v >> 482) & 3
+        w = (v >> 484) & 281474976710655
+        self.pressure_sensor.pressures[:] = [(((w >> (24 * k)) & 16777215) ^ 8388608) - 8388608 for k in range(2)]
+
     def encode(self) -> bytearray:
         """
         Encode this object to bytearray.
         """
-        s = bytearray(self.BYTES_LENGTH)
-        ctx = bp.ProcessContext(True, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
-        return ctx.s
+        return bytearray(self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little'))
+
+    def encode_into(self, buf: Union[bytearray, memoryview], offset: int = 0) -> int:
+        """
+        Encode this object into given buffer buf at offset, without allocating a bytearray.
+        :param buf: A writable buffer, e.g. a bytearray, memoryview or mmap, with at least
+           `BYTES_LENGTH` bytes after offset.
+        Returns the number of bytes written, that's `BYTES_LENGTH`.
+        """
+        assert len(buf) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        buf[offset : offset + self.BYTES_LENGTH] = self.bp_encode_bigint().to_bytes(self.BYTES_LENGTH, 'little')
+        return self.BYTES_LENGTH
 
     def decode(self, s: bytearray) -> None:
         """
@@ -809,8 +1501,109 @@ class Drone(bp.MessageBase):
         :param s: A bytearray with length at least `BYTES_LENGTH`.
         """
         assert len(s) >= self.BYTES_LENGTH, bp.NotEnoughBytes()
-        ctx = bp.ProcessContext(False, s)
-        self.bp_processor().process(ctx, bp.NIL_DATA_INDEXER, self)
+        self.bp_decode_bigint(int.from_bytes(s[: self.BYTES_LENGTH], 'little'))
+
+    def decode_from(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        """
+        Decode the bytes in given buffer s at offset to this object, without slicing copies.
+        :param s: A buffer, e.g. a bytes, memoryview or mmap, with at least `BYTES_LENGTH`
+           bytes after offset.
+        """
+        mv = memoryview(s)
+        assert len(mv) - offset >= self.BYTES_LENGTH, bp.NotEnoughBytes()
+        self.bp_decode_bigint(int.from_bytes(mv[offset : offset + self.BYTES_LENGTH], 'little'))
+
+    @classmethod
+    def decode_columns(cls, s: bytes, use_numpy: Optional[bool] = None) -> Dict[str, Any]:
+        """
+        Decode concatenated frames of this message in buffer s into columns.
+        Returns a dict of field name to an array of values, see bp.decode_columns.
+        """
+        columns: List[bp.Column] = [
+            ("status", 0, 3, "uint"),
+            ("position.latitude", 3, 32, "uint"),
+            ("position.longitude", 35, 32, "uint"),
+            ("position.altitude", 67, 32, "uint"),
+            ("flight.pose.yaw", 99, 32, "int"),
+            ("flight.pose.pitch", 131, 32, "int"),
+            ("flight.pose.roll", 163, 32, "int"),
+            ("flight.velocity[0]", 195, 32, "int"),
+            ("flight.velocity[1]", 227, 32, "int"),
+            ("flight.velocity[2]", 259, 32, "int"),
+            ("flight.acceleration[0]", 291, 32, "int"),
+            ("flight.acceleration[1]", 323, 32, "int"),
+            ("flight.acceleration[2]", 355, 32, "int"),
+            ("propellers[0].id", 387, 8, "uint"),
+            ("propellers[0].status", 395, 2, "uint"),
+            ("propellers[0].direction", 397, 2, "uint"),
+            ("propellers[1].id", 399, 8, "uint"),
+            ("propellers[1].status", 407, 2, "uint"),
+            ("propellers[1].direction", 409, 2, "uint"),
+            ("propellers[2].id", 411, 8, "uint"),
+            ("propellers[2].status", 419, 2, "uint"),
+            ("propellers[2].direction", 421, 2, "uint"),
+            ("propellers[3].id", 423, 8, "uint"),
+            ("propellers[3].status", 431, 2, "uint"),
+            ("propellers[3].direction", 433, 2, "uint"),
+            ("power.battery", 435, 8, "uint"),
+            ("power.status", 443, 2, "uint"),
+            ("power.is_charging", 445, 1, "bool"),
+            ("network.signal", 446, 4, "uint"),
+            ("network.heartbeat_at", 450, 32, "int"),
+            ("landing_gear.status", 482, 2, "uint"),
+            ("pressure_sensor.pressures[0]", 484, 24, "int"),
+            ("pressure_sensor.pressures[1]", 508, 24, "int"),
+        ]
+        return bp.decode_columns(s, cls.BYTES_LENGTH, columns, use_numpy)
 
     def bp_process_int(self, di: bp.DataIndexer) -> None:
-        return
\ No newline at end of file
+        return
+
+
+class DroneView(bp.MessageView):
+    """
+    Read-only view of a Drone in an encoded buffer, of which the properties
+    extract fields from the buffer on access, see bp.MessageView.
+    """
+    __slots__ = ()
+    BYTES_LENGTH: ClassVar[int] = 67
+
+    @property
+    def status(self) -> DroneStatus:
+        return DroneStatus(self.bp_uint(0, 3))
+
+    @property
+    def position(self) -> "PositionView":
+        return PositionView.bp_at(self.bp_s, self.bp_i + 3)
+
+    @property
+    def flight(self) -> "FlightView":
+        return FlightView.bp_at(self.bp_s, self.bp_i + 99)
+
+    @property
+    def propellers(self) -> List["PropellerView"]:
+        return [PropellerView.bp_at(self.bp_s, self.bp_i + 387 + 12 * k0) for k0 in range(4)]
+
+    @property
+    def power(self) -> "PowerView":
+        return PowerView.bp_at(self.bp_s, self.bp_i + 435)
+
+    @property
+    def network(self) -> "NetworkView":
+        return NetworkView.bp_at(self.bp_s, self.bp_i + 446)
+
+    @property
+    def landing_gear(self) -> "LandingGearView":
+        return LandingGearView.bp_at(self.bp_s, self.bp_i + 482)
+
+    @property
+    def pressure_sensor(self) -> "PressureSensorView":
+        return PressureSensorView.bp_at(self.bp_s, self.bp_i + 484)
+
+    def to_message(self) -> Drone:
+        """
+        Decode the whole message to a Drone object.
+        """
+        m = Drone()
+        m.bp_decode_bigint(self.bp_uint(0, 532))
+        return m
\ No newline at end of file
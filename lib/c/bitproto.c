@@ -1,8 +1,148 @@
 // Copyright (c) 2021~2023, hit9. https://github.com/hit9/bitproto
 // Encoding library for bitproto in C language.
 
+// With BITPROTO_INLINE, bitproto.h includes this file, to build the library in
+// every translation unit including the header. Compiled on its own then, this
+// file builds only the parts shared by the translation units, see BpTraceStats.
+#ifndef __BITPROTO_LIB_H__
+#define BP_LIB_TRANSLATION_UNIT 1
+#endif
+
 #include "bitproto.h"
 
+#ifndef __BITPROTO_LIB_C__
+#define __BITPROTO_LIB_C__ 1
+
+// Vectorize signed integer arrays processing where SIMD is available.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BP_SIGN_EXTEND_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BP_SIGN_EXTEND_NEON 1
+#endif
+
+// Gathers of AVX2 to decode batches of messages, see BpDecodePlanBatch. With
+// GCC and Clang on x86-64, AVX2 is detected at runtime if not targeted already.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BP_BATCH_AVX2 1
+#define BP_BATCH_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define BP_BATCH_AVX2 1
+#define BP_BATCH_AVX2_DETECT 1
+#define BP_BATCH_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+// PDEP and PEXT of BMI2 to unpack and pack arrays of integers in odd widths,
+// see BpUnpackIntegers. With GCC and Clang on x86-64, BMI2 is detected at
+// runtime if not targeted already. They are microcoded and slow on AMD cores
+// before Zen 3, define BP_PACK_BMI2 to 0 to use the scalar kernels instead.
+#ifndef BP_PACK_BMI2
+#if defined(__BMI2__) || \
+    ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__))
+#define BP_PACK_BMI2 1
+#else
+#define BP_PACK_BMI2 0
+#endif
+#endif
+
+#if BP_PACK_BMI2
+#include <immintrin.h>
+#if defined(__BMI2__)
+#define BP_PACK_BMI2_TARGET
+#else
+#define BP_PACK_BMI2_DETECT 1
+#define BP_PACK_BMI2_TARGET __attribute__((target("bmi2")))
+#endif
+#endif
+
+// Table lookups of AArch64 NEON to unpack arrays of narrow integers.
+#if defined(BP_SIGN_EXTEND_NEON) && defined(__aarch64__) && !BP_BIG_ENDIAN
+#define BP_PACK_NEON 1
+#endif
+
+// Threads of parallel batches, see BpParallelBatch.
+#if defined(BP_PARALLEL)
+#if defined(_OPENMP)
+#include <omp.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#endif
+
+// Batches of datagrams, see BpRecvFrames.
+#if defined(BP_MMSG)
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+// Hardware CRC32 instructions on ARMv8, see BpCrc32.
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+// Words copied in BpCopyBufferBits are loaded and stored at any byte address.
+// On targets supporting unaligned accesses (x86, aarch64, ARMv7-M and other
+// ARM cores with __ARM_FEATURE_UNALIGNED), memcpy of a word compiles into a
+// single load or store instruction. Others, e.g. ARMv6-M (Cortex-M0/M0+)
+// faulting on unaligned accesses, assemble the words byte by byte.
+// Define BP_UNALIGNED_ACCESS to 0 or 1 to override the detection.
+#ifndef BP_UNALIGNED_ACCESS
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86) || defined(__aarch64__) || defined(_M_ARM64) ||  \
+    defined(__ARM_FEATURE_UNALIGNED)
+#define BP_UNALIGNED_ACCESS 1
+#else
+#define BP_UNALIGNED_ACCESS 0
+#endif
+#endif
+
+#if BP_UNALIGNED_ACCESS
+#if defined(__GNUC__) || defined(__clang__)
+#define BpMemcpy __builtin_memcpy
+#else
+#include <string.h>
+#define BpMemcpy memcpy
+#endif
+#endif
+
+// Json numbers of float32 and fixed-point types are parsed by strtod, and null
+// stands for NAN.
+#ifndef BP_NO_JSON
+#include <math.h>
+#include <stdlib.h>
+#endif
+
+// The encoding is little-endian. On big-endian hosts, see BP_BIG_ENDIAN, words
+// loaded from and stored to buffers, and integers in structs, are byte-swapped
+// by a single instruction each with GCC and Clang.
+#if BP_BIG_ENDIAN
+#if defined(__GNUC__) || defined(__clang__)
+#define BpBswap16 __builtin_bswap16
+#define BpBswap32 __builtin_bswap32
+#define BpBswap64 __builtin_bswap64
+#else
+static inline uint16_t BpBswap16(uint16_t v) {
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+static inline uint32_t BpBswap32(uint32_t v) {
+    return ((uint32_t)BpBswap16((uint16_t)v) << 16) |
+           BpBswap16((uint16_t)(v >> 16));
+}
+
+static inline uint64_t BpBswap64(uint64_t v) {
+    return ((uint64_t)BpBswap32((uint32_t)v) << 32) |
+           BpBswap32((uint32_t)(v >> 32));
+}
+#endif
+#endif
+
 ///////////////////
 // Implementations
 ///////////////////
@@ -10,11 +150,6 @@
 // BpMin returns the smaller one int.
 static inline int BpMin(int a, int b) { return (a < b) ? a : b; }
 
-// BpMinTriple returns the smaller one of given three integers.
-static inline int BpMinTriple(int a, int b, int c) {
-    return (a < b) ? ((a < c) ? a : c) : ((b < c) ? b : c);
-}
-
 // BpIsNbitsStandard returns true if given nbits is one of 8/16/32/64.
 static inline bool BpIsNbitsStandard(int nbits) {
     return nbits == 8 || nbits == 16 || nbits == 32 || nbits == 64;
@@ -27,10 +162,96 @@ static inline bool BpIsBaseIntegerType(int flag) {
            flag == BP_TYPE_ENUM || flag == BP_TYPE_INT;
 }
 
+#if BP_BIG_ENDIAN
+// BpSwapIntegers swaps the byte order of cap integers of size bytes each,
+// stored contiguously at given data, in place. Decoding copies the bits into
+// the struct members in little-endian, and then swaps them to the host order.
+// The integers are not required to be aligned, e.g. members of packed structs,
+// and are copied through typed temporaries.
+static void BpSwapIntegers(int size, int cap, void *data) {
+    unsigned char *p = (unsigned char *)data;
+    for (int k = 0; k < cap; k++, p += size) {
+        switch (size) {
+            case 2: {
+                uint16_t v;
+                BpMemcpy(&v, p, sizeof(v));
+                v = BpBswap16(v);
+                BpMemcpy(p, &v, sizeof(v));
+                break;
+            }
+            case 4: {
+                uint32_t v;
+                BpMemcpy(&v, p, sizeof(v));
+                v = BpBswap32(v);
+                BpMemcpy(p, &v, sizeof(v));
+                break;
+            }
+            case 8: {
+                uint64_t v;
+                BpMemcpy(&v, p, sizeof(v));
+                v = BpBswap64(v);
+                BpMemcpy(p, &v, sizeof(v));
+                break;
+            }
+        }
+    }
+}
+
+// BpLittleEndianWord returns the integer of size bytes at p byte-swapped, so
+// that the bytes of the returned word in memory are in little-endian. The
+// integer is not required to be aligned, the same as BpSwapIntegers.
+static inline uint64_t BpLittleEndianWord(const unsigned char *p, int size) {
+    switch (size) {
+        case 2: {
+            uint16_t v;
+            BpMemcpy(&v, p, sizeof(v));
+            return BpBswap64((uint64_t)v);
+        }
+        case 4: {
+            uint32_t v;
+            BpMemcpy(&v, p, sizeof(v));
+            return BpBswap64((uint64_t)v);
+        }
+        case 8: {
+            uint64_t v;
+            BpMemcpy(&v, p, sizeof(v));
+            return BpBswap64(v);
+        }
+    }
+    return BpBswap64((uint64_t)(*p));
+}
+#endif
+
+// BpEncodeSource returns the address to copy the bits of the integer of size
+// bytes at p from, in little-endian. On big-endian hosts, an integer of more
+// than one byte is byte-swapped into given word w, and w is returned.
+static inline unsigned char *BpEncodeSource(unsigned char *p, int size,
+                                            uint64_t *w) {
+#if BP_BIG_ENDIAN
+    if (size > 1) {
+        *w = BpLittleEndianWord(p, size);
+        return (unsigned char *)w;
+    }
+#else
+    (void)size;
+    (void)w;
+#endif
+    return p;
+}
+
+// BpValidateEnums calls the validator of given enum type on each of the n
+// enums at data just decoded, if it's validated, see option c.validate_enums.
+static inline void BpValidateEnums(const struct BpType *t, int n,
+                                   struct BpProcessorContext *ctx, void *data) {
+    if (ctx->is_encode || t->processor == NULL) return;
+    unsigned char *p = (unsigned char *)data;
+    for (int k = 0; k < n; k++, p += t->size) t->processor(p, ctx);
+}
+
 // BpEndecodeMessage process given message at data with provided message
 // descriptor. It iterates all message fields to process.
-void BpEndecodeMessage(struct BpMessageDescriptor *descriptor,
-                       struct BpProcessorContext *ctx, void *data) {
+BP_API void BpEndecodeMessage(const struct BpMessageDescriptor *descriptor,
+                              struct BpProcessorContext *ctx, void *data) {
     // Keep current number of bits total processed.
     int i = ctx->i;
     // Opponent message nbits if extensible is set.
@@ -47,10 +268,12 @@ void BpEndecodeMessage(struct BpMessageDescriptor *descriptor,
     }
 
     // Process message fields.
+    // The data of each field is located by its offset in the message struct.
     for (int k = 0; k < descriptor->nfields; k++) {
-        struct BpMessageFieldDescriptor *field_descriptor =
+        const struct BpMessageFieldDescriptor *field_descriptor =
             &(descriptor->field_descriptors[k]);
-        BpEndecodeMessageField(field_descriptor, ctx, NULL);
+        void *field_data = (unsigned char *)data + field_descriptor->offset;
+        BpEndecodeMessageField(field_descriptor, ctx, field_data);
     }
 
     // Skip redundant bits if decoding.
@@ -63,23 +286,33 @@ void BpEndecodeMessage(struct BpMessageDescriptor *descriptor,
 }
 
 // BpEndecodeMessageField dispatch the process by given message field's type.
-void BpEndecodeMessageField(struct BpMessageFieldDescriptor *descriptor,
-                            struct BpProcessorContext *ctx, void *data) {
+// The argument data is the address of this field's data.
+BP_API void BpEndecodeMessageField(
+    const struct BpMessageFieldDescriptor *descriptor,
+    struct BpProcessorContext *ctx, void *data) {
     switch (descriptor->type.flag) {
         case BP_TYPE_BOOL:
         case BP_TYPE_UINT:
         case BP_TYPE_BYTE:
+        case BP_TYPE_FLOAT:
+            BpEndecodeUint((descriptor->type).size, (descriptor->type).nbits,
+                           ctx, data);
+            break;
         case BP_TYPE_ENUM:
-            BpEndecodeBaseType((descriptor->type).nbits, ctx, descriptor->data);
+            BpEndecodeUint((descriptor->type).size, (descriptor->type).nbits,
+                           ctx, data);
+            BpValidateEnums(&(descriptor->type), 1, ctx, data);
             break;
         case BP_TYPE_INT:
             BpEndecodeInt((descriptor->type).size, (descriptor->type).nbits,
-                          ctx, descriptor->data);
+                          ctx, data);
             break;
         case BP_TYPE_ALIAS:
         case BP_TYPE_ARRAY:
         case BP_TYPE_MESSAGE:
-            descriptor->type.processor(descriptor->data, ctx);
+        case BP_TYPE_RANGE:
+        case BP_TYPE_FIXED:
+            descriptor->type.processor(data, ctx);
             break;
     }
 }
@@ -87,19 +320,22 @@ void BpEndecodeMessageField(struct BpMessageFieldDescriptor *descriptor,
 // BpEndecodeAlias process alias at given data and described by given
 // descriptor. It simply propagates the process to the type it alias to.
 // In bitproto, only types without names can be aliased
-// (bool/int/uint/byte/array).
-void BpEndecodeAlias(struct BpAliasDescriptor *descriptor,
-                     struct BpProcessorContext *ctx, void *data) {
+// (bool/int/uint/byte/float32/fixed-point/array).
+BP_API void BpEndecodeAlias(const struct BpAliasDescriptor *descriptor,
+                            struct BpProcessorContext *ctx, void *data) {
     switch (descriptor->to.flag) {
         case BP_TYPE_BOOL:
         case BP_TYPE_UINT:
         case BP_TYPE_BYTE:
-            BpEndecodeBaseType((descriptor->to).nbits, ctx, data);
+        case BP_TYPE_FLOAT:
+            BpEndecodeUint((descriptor->to).size, (descriptor->to).nbits, ctx,
+                           data);
             break;
         case BP_TYPE_INT:
             BpEndecodeInt((descriptor->to).size, (descriptor->to).nbits, ctx,
                           data);
             break;
+        case BP_TYPE_FIXED:
         case BP_TYPE_ARRAY:
             descriptor->to.processor(data, ctx);
             break;
@@ -107,9 +343,10 @@ void BpEndecodeAlias(struct BpAliasDescriptor *descriptor,
 }
 
 // BpEndecodeArray process given array at data with provided descriptor. It
-// iterates all array elements to process.
-void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
-                     struct BpProcessorContext *ctx, void *data) {
+// iterates all array elements to process, or the elements in use only if it's
+// bounded, after their count.
+BP_API void BpEndecodeArray(const struct BpArrayDescriptor *descriptor,
+                            struct BpProcessorContext *ctx, void *data) {
     // Keep current number of bits total processed.
     int i = ctx->i;
     // Opponent array capacity if extensible is set.
@@ -128,7 +365,7 @@ void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
     int cap = descriptor->cap;
     int element_nbits = descriptor->element_type.nbits;
     int element_size = descriptor->element_type.size;
-    struct BpType *element_type = &(descriptor->element_type);
+    const struct BpType *element_type = &(descriptor->element_type);
 
     int flag = element_type->flag;
     // The type flag behind if the element_type is an alias.
@@ -137,8 +374,20 @@ void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
 
     unsigned char *data_ptr = (unsigned char *)data;
 
-    if (BpIsNbitsStandard(element_nbits) &&
-        (BpIsBaseIntegerType(flag) || BpIsBaseIntegerType(to_flag))) {
+    if (descriptor->count_nbits > 0) {
+        // A bounded array: the batch paths below apply to the elements in use,
+        // as if the capacity were their count.
+        if (ctx->is_encode) {
+            cap = BpEncodeArrayCount(cap, descriptor->count_nbits, ctx, data);
+        } else {
+            cap = BpDecodeArrayCount(cap, descriptor->count_nbits, ctx, data);
+        }
+        data_ptr += descriptor->offset;
+    }
+
+    if ((BpIsNbitsStandard(element_nbits) &&
+         (BpIsBaseIntegerType(flag) || BpIsBaseIntegerType(to_flag))) ||
+        flag == BP_TYPE_FLOAT || to_flag == BP_TYPE_FLOAT) {
         // Performance improvement for C arrays of integers (byte/uint/int):
         // Since arrays in C are contiguous in memory layout, so we call
         // BpCopyBufferBits only once instead of calling it one by one
@@ -147,16 +396,38 @@ void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
         // now. It's really a great optimization for arrays of complete integer
         // types one of byte/uint8/uint16/uint32/uint64/int8/int16/int32/int64.
         // andd enums of these uints, and alias to these types.
+        // For int8/16/32/64 signed integers, the sign bit is already on the
+        // most-left bit position, no sign handling is required. Arrays of
+        // float32 are copied the same as arrays of uint32.
+        // On big-endian hosts, the elements are swapped one by one.
+
+        if (ctx->is_encode) {
+            BpEncodeIntegers(element_size, element_nbits, cap, ctx, data_ptr);
+        } else {
+            BpDecodeBaseType(element_nbits * cap, ctx, data_ptr);
+            BpClearArrayHighBitsAfterDecode(element_size, element_nbits, cap,
+                                            data_ptr);
+            if (flag == BP_TYPE_ENUM)
+                BpValidateEnums(element_type, cap, ctx, data_ptr);
+        }
 
-        BpEndecodeBaseType(element_nbits * cap, ctx, data_ptr);
+    } else if (BpIsBaseIntegerType(flag) || BpIsBaseIntegerType(to_flag) ||
+               flag == BP_TYPE_BOOL || to_flag == BP_TYPE_BOOL) {
+        // Arrays of integers in non-standard widths and bools, e.g.
+        // uint12[256], int24[2] and bool[128]: Packed and unpacked by the
+        // kernels in a batch, instead of a switch and a bits copying per
+        // element. The signs of signed integers are handled in a batch after
+        // unpacked. An alias to an integer is processed as the integer it
+        // aliases to.
 
-        if (flag == BP_TYPE_INT || to_flag == BP_TYPE_INT) {
-            // We should handle the signed integer's sign after bits copying.
-            for (int k = 0; k < cap; k++) {
-                BpHandleIntSignAfterEndecode(element_size, element_nbits, ctx,
-                                             data_ptr);
-                data_ptr += element_size;
-            }
+        if (ctx->is_encode) {
+            BpEncodeIntegers(element_size, element_nbits, cap, ctx, data_ptr);
+        } else if (flag == BP_TYPE_INT || to_flag == BP_TYPE_INT) {
+            BpDecodeIntArray(element_size, element_nbits, cap, ctx, data_ptr);
+        } else {
+            BpDecodeUintArray(element_size, element_nbits, cap, ctx, data_ptr);
+            if (flag == BP_TYPE_ENUM)
+                BpValidateEnums(element_type, cap, ctx, data_ptr);
         }
 
     } else {
@@ -167,14 +438,21 @@ void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
                 case BP_TYPE_BOOL:
                 case BP_TYPE_UINT:
                 case BP_TYPE_BYTE:
+                case BP_TYPE_FLOAT:
+                    BpEndecodeUint(element_size, element_nbits, ctx,
+                                   data_ptr);
+                    break;
                 case BP_TYPE_ENUM:
-                    BpEndecodeBaseType(element_nbits, ctx, data_ptr);
+                    BpEndecodeUint(element_size, element_nbits, ctx,
+                                   data_ptr);
+                    BpValidateEnums(element_type, 1, ctx, data_ptr);
                     break;
                 case BP_TYPE_INT:
                     BpEndecodeInt(element_size, element_nbits, ctx, data_ptr);
                     break;
                 case BP_TYPE_ALIAS:
                 case BP_TYPE_MESSAGE:
+                case BP_TYPE_FIXED:
                     descriptor->element_type.processor(data_ptr, ctx);
                     break;
             }
@@ -192,6 +470,100 @@ void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
     }
 }
 
+// BpEndecodeMessageArray process given array of cap messages at data, each
+// occupies size bytes in memory, with the descriptor of the element message.
+// Called by the processors of arrays of messages instead of BpEndecodeArray,
+// which calls the processor of the element message per element, and the
+// processor calls BpEndecodeMessage. Here the fields of all elements are
+// processed by the same field descriptors, only the address of the element
+// changes. Elements of extensible messages still go through BpEndecodeMessage,
+// for the ahead flag of each element.
+BP_API void BpEndecodeMessageArray(const struct BpMessageDescriptor *descriptor,
+                                   int cap, int size,
+                                   struct BpProcessorContext *ctx, void *data) {
+    unsigned char *data_ptr = (unsigned char *)data;
+
+    if (descriptor->extensible) {
+        for (int k = 0; k < cap; k++, data_ptr += size)
+            BpEndecodeMessage(descriptor, ctx, data_ptr);
+        return;
+    }
+
+    int nfields = descriptor->nfields;
+    const struct BpMessageFieldDescriptor *field_descriptors =
+        descriptor->field_descriptors;
+
+    for (int k = 0; k < cap; k++, data_ptr += size) {
+        for (int j = 0; j < nfields; j++) {
+            const struct BpMessageFieldDescriptor *field_descriptor =
+                &field_descriptors[j];
+            BpEndecodeMessageField(field_descriptor, ctx,
+                                   data_ptr + field_descriptor->offset);
+        }
+    }
+}
+
+// BpLoadUint32 reads an uint32 from the 4 bytes at given buffer p in
+// little-endian. The buffer p is not required to be aligned.
+static inline uint32_t BpLoadUint32(const unsigned char *p) {
+#if BP_UNALIGNED_ACCESS
+    uint32_t v;
+    BpMemcpy(&v, p, sizeof(v));
+#if BP_BIG_ENDIAN
+    v = BpBswap32(v);
+#endif
+    return v;
+#else
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+#endif
+}
+
+// BpStoreUint32 writes an uint32 v to the 4 bytes at given buffer p in
+// little-endian. The buffer p is not required to be aligned.
+static inline void BpStoreUint32(unsigned char *p, uint32_t v) {
+#if BP_UNALIGNED_ACCESS
+#if BP_BIG_ENDIAN
+    v = BpBswap32(v);
+#endif
+    BpMemcpy(p, &v, sizeof(v));
+#else
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+#endif
+}
+
+// BpLoadUint64 reads an uint64 from the 8 bytes at given buffer p in
+// little-endian. The buffer p is not required to be aligned.
+static inline uint64_t BpLoadUint64(const unsigned char *p) {
+#if BP_UNALIGNED_ACCESS
+    uint64_t v;
+    BpMemcpy(&v, p, sizeof(v));
+#if BP_BIG_ENDIAN
+    v = BpBswap64(v);
+#endif
+    return v;
+#else
+    return (uint64_t)BpLoadUint32(p) | ((uint64_t)BpLoadUint32(p + 4) << 32);
+#endif
+}
+
+// BpStoreUint64 writes an uint64 v to the 8 bytes at given buffer p in
+// little-endian. The buffer p is not required to be aligned.
+static inline void BpStoreUint64(unsigned char *p, uint64_t v) {
+#if BP_UNALIGNED_ACCESS
+#if BP_BIG_ENDIAN
+    v = BpBswap64(v);
+#endif
+    BpMemcpy(p, &v, sizeof(v));
+#else
+    BpStoreUint32(p, (uint32_t)v);
+    BpStoreUint32(p + 4, (uint32_t)(v >> 32));
+#endif
+}
+
 // BpCopyBufferBits copy number of nbits from source buffer src to
 // destination buffer dst. The argument n is the total number of bits to
 // copy. The argument si is the index to start coping on buffer src.
@@ -199,241 +571,2477 @@ void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
 // Note that this function DOESN'T suppose current processing type is a base
 // type, that's to say, we can process n bits copying where n could be a large
 // number than 64.
-void BpCopyBufferBits(int n, unsigned char *dst, unsigned char *src, int di,
-                      int si) {
-    // n is the number of bits remaining to process.
-    while (n) {
-        // Byte index in buffer is (idx >> 3)
-        // where `>> 3` is faster than `/8`.
+//
+// The copy works for any pair of si and di: a word is loaded from src, shifted
+// right by si to drop the bits already consumed, shifted left by di to margin
+// with dst, and merged into dst keeping the lower di bits of dst untouched.
+// Only the bits in range [di, di+n) of dst are written, and no bytes out of
+// range [si, si+n) of src are read. The buffers must not overlap, which lets
+// the compiler keep the word loaded from src across the store to dst.
+BP_API void BpCopyBufferBits(int n, unsigned char *BP_RESTRICT dst,
+                             const unsigned char *BP_RESTRICT src, int di,
+                             int si) {
+    // Byte index in buffer is (idx >> 3)
+    // where `>> 3` is faster than `/8`.
+    dst += (di >> 3);
+    src += (si >> 3);
+
+    // Bit position inside current buffer byte.
+    // where `& 7` faster than `%8`
+    di &= 7;
+    si &= 7;
+
+    // c is the number of bits to copy in each iteration.
+    int c = 0;
+
+    // Copy as uint64 words for long runs, e.g. large byte arrays.
+    // The 8 bytes loaded and stored are always in range, since n >= 64.
+    // Each round copies 64 - max(si, di) bits, at least 57 bits.
+    while (n >= 64) {
+        uint64_t v = BpLoadUint64(src) >> si;
+        uint64_t mask = (((uint64_t)1) << di) - 1;
+        BpStoreUint64(dst, (BpLoadUint64(dst) & mask) | (v << di));
+
+        c = 64 - ((si > di) ? si : di);
+        n -= c;
+        di += c;
+        si += c;
         dst += (di >> 3);
         src += (si >> 3);
+        di &= 7;
+        si &= 7;
+    }
+
+    // Copy as uint32 words, the same as above, at least 25 bits each round.
+    while (n >= 32) {
+        uint32_t v = BpLoadUint32(src) >> si;
+        uint32_t mask = (((uint32_t)1) << di) - 1;
+        BpStoreUint32(dst, (BpLoadUint32(dst) & mask) | (v << di));
 
-        // Bit position inside current buffer byte.
-        // where `& 7` faster than `%8`
+        c = 32 - ((si > di) ? si : di);
+        n -= c;
+        di += c;
+        si += c;
+        dst += (di >> 3);
+        src += (si >> 3);
         di &= 7;
         si &= 7;
+    }
+
+    // Copy the remaining bits (less than 32) byte by byte on dst side.
+    // Each round fills a destination byte up to its end (or to the end of the
+    // bits remaining), gathering bits across 2 source bytes if necessary.
+    // After the first round, di goes to 0.
+    while (n > 0) {
+        c = BpMin(8 - di, n);
+
+        unsigned int v = src[0] >> si;
+        // Reads the next source byte only if the bits required span it.
+        if (si + c > 8) v |= ((unsigned int)src[1]) << (8 - si);
+
+        // Mask of the bits to write in dst byte, e.g. 00111000 for di=3, c=3.
+        unsigned char mask = (unsigned char)(((1u << c) - 1) << di);
+        dst[0] = (dst[0] & ~mask) | ((v << di) & mask);
 
-        // c is the number of bits to copy in this iteration.
-        int c = 0;
-
-        if (di == 0) {
-            // When di == 0, we can directly ASSGIN values from
-            // shifted src byte.
-
-            // Number of bits to process during batch copy.
-            int bits = n + si;
-
-            if (bits >= 32) {
-                // Copy as an uint32 integer.
-                // This way, performance faster x2 than bits copy approach.
-                ((uint32_t *)dst)[0] = ((uint32_t *)(src))[0] >> si;
-                c = 32 - si;
-            } else if (bits >= 16) {
-                // Copy as an uint16 integer.
-                ((uint16_t *)dst)[0] = ((uint16_t *)(src))[0] >> si;
-                c = 16 - si;
-            } else if (bits >= 8) {
-                // Copy as an unsigned char.
-                dst[0] = (src[0] >> si) & 0xff;
-                c = 8 - si;
-            } else {
-                // When bits < 8 and di == 0
-                // Copy partial bits inside a byte.
-                // For the original statement:
-                // c = BpMinTriple(8 - di, 8 - si, n);
-                // since di is 0 and bits <8, then 8-di is 8
-                // and n <8 , the 8-di won't be the smallest, we
-                // just pick function BpMin over BpMinTriple for the little
-                // little performance improvement.
-                c = BpMin(8 - si, n);
-                // Also, when di is 0, special case of next case.
-                dst[0] |= ((src[0] >> si) & ~(0xff << c));
-            }
-        } else {
-            // When di != 0, we have to copy partial bits inside a
-            // single byte.
-            // But, after some rounds of this case, di would goes to 0,
-            // for large sized types.
-
-            // Number of bits to copy.
-            // 8-di ensures the destination space is enough.
-            // 8-si ensures the source space is enough.
-            // nbits ensures the total bits remaining enough.
-            c = BpMinTriple(8 - di, 8 - si, n);
-
-            // Explaination:
-            // src >> si << di  Margins byte src with byte dst at position
-            // di. this also clears the right bits up to position si.
-            // ~(0xff << di << c) Gives a mask to clear higher not-need bits
-            // all to 0, e.g. 00001111 on di=4, c=4; Finally: dst |= src to
-            // copy bits.
-            // The ch is the first byte at pointer src. If this byte is Zero,
-            // then there's no need to copy anything, just count c. The
-            // benchmark on stm32 seems performance is improved by 2us by adding
-            // an if statement that skip the Zero byte.
-            unsigned char ch = src[0];
-            if (ch) dst[0] |= ((ch >> si << di) & ~(0xff << di << c));
-        }
-
-        // Maintain in(de)crements.
         n -= c;
         di += c;
         si += c;
+        dst += (di >> 3);
+        src += (si >> 3);
+        di &= 7;
+        si &= 7;
+    }
+}
+
+// Arrays of integers in odd widths, e.g. uint12[256] and uint4[64], are packed
+// and unpacked by the kernels below, instead of copying the bits element by
+// element. An element of at most BP_PACK_MAX_NBITS bits is in the 64-bit word
+// loaded at the byte of its first bit, after shifting out the lower bits of the
+// byte, and fits in the bits left in the word packing it.
+#define BP_PACK_MAX_NBITS 56
+
+// BpLoadElement returns the integer of size bytes at p, in the host order.
+// The element is not required to be aligned, e.g. a member of a struct packed
+// by option c.struct_packing_alignment, and is copied into a typed temporary,
+// which compilers lower to a single load where unaligned loads are allowed.
+static inline uint64_t BpLoadElement(const unsigned char *p, int size) {
+    switch (size) {
+        case 2: {
+            uint16_t v;
+            BpMemcpy(&v, p, sizeof(v));
+            return v;
+        }
+        case 4: {
+            uint32_t v;
+            BpMemcpy(&v, p, sizeof(v));
+            return v;
+        }
+        case 8: {
+            uint64_t v;
+            BpMemcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+    return *p;
+}
+
+// BpStoreElement writes v to the integer of size bytes at p, in the host order.
+// The element is not required to be aligned, the same as BpLoadElement.
+static inline void BpStoreElement(unsigned char *p, int size, uint64_t v) {
+    switch (size) {
+        case 1:
+            *p = (uint8_t)v;
+            break;
+        case 2: {
+            uint16_t u = (uint16_t)v;
+            BpMemcpy(p, &u, sizeof(u));
+            break;
+        }
+        case 4: {
+            uint32_t u = (uint32_t)v;
+            BpMemcpy(p, &u, sizeof(u));
+            break;
+        }
+        case 8:
+            BpMemcpy(p, &v, sizeof(v));
+            break;
+    }
+}
+
+// BpPackLanes returns the number of elements packed or unpacked in one word,
+// at most n, the lanes of an element of size bytes in the word.
+static inline int BpPackLanes(int size, int nbits, int n) {
+    return BpMin(BpMin(n, 8 / size), BP_PACK_MAX_NBITS / nbits);
+}
+
+// BpPackLaneMask returns the mask of the lower nbits of each of the lanes of
+// size bytes in a word, e.g. 0x00000fff00000fff for size=4, nbits=12, lanes=2.
+static inline uint64_t BpPackLaneMask(int size, int nbits, int lanes) {
+    uint64_t mask = 0;
+    for (int j = 0; j < lanes; j++)
+        mask |= ((((uint64_t)1) << nbits) - 1) << (j * (size << 3));
+    return mask;
+}
+
+// BpPacker accumulates the bits packed into a buffer, and stores them byte by
+// byte, or in a word if the 8 bytes are all in the bits to pack.
+struct BpPacker {
+    // The byte to store the next bits at.
+    unsigned char *q;
+    // The end of the bytes in the bits to pack, excluding the last partial one.
+    unsigned char *end;
+    // The bits accumulated, and the number of them, less than 8 after a flush.
+    uint64_t acc;
+    int a;
+};
+
+// BpPackerFlush stores the whole bytes accumulated by given packer.
+static inline void BpPackerFlush(struct BpPacker *w) {
+    int nb = w->a >> 3;
+    if (w->q + 8 <= w->end) {
+        BpStoreUint64(w->q, w->acc);
+    } else {
+        for (int x = 0; x < nb; x++)
+            w->q[x] = (unsigned char)(w->acc >> (x << 3));
+    }
+    w->q += nb;
+    w->acc >>= (nb << 3);
+    w->a &= 7;
+}
+
+// BpPackBools packs the bools (or uint1s) of the array at data into given
+// packer, 8 at a time: the 8 bytes are loaded into a word in little-endian,
+// and the multiplication gathers the lowest bit of each byte j into the bit j
+// of the highest byte, without carries. Returns the number of bools packed.
+static int BpPackBools(int cap, unsigned char *data, struct BpPacker *w) {
+    int k = 0;
+    while (k + 8 <= cap) {
+        // Up to 7 bytes are accumulated between the flushes.
+        for (int g = 0; g < 7 && k + 8 <= cap; g++, k += 8) {
+            uint64_t v = BpLoadUint64(data + k) & 0x0101010101010101ULL;
+            w->acc |= ((v * 0x0102040810204080ULL) >> 56) << w->a;
+            w->a += 8;
+        }
+        BpPackerFlush(w);
+    }
+    return k;
+}
+
+// BpUnpackBools unpacks the bools (or uint1s) of the array at data from buffer
+// s at bit i, 8 at a time: the byte of 8 bits is broadcast to the bytes of a
+// word, the byte j keeps the bit j only, and then is normalized to 0 or 1 by
+// carrying the bit into its highest bit. Returns the number of bools unpacked.
+static int BpUnpackBools(int cap, unsigned char *s, int i,
+                         unsigned char *data) {
+    int k = 0;
+    for (; k + 8 <= cap; k += 8) {
+        int b = i + k, r = b & 7;
+        unsigned char *p = s + (b >> 3);
+        // The next byte is in the bits to unpack, if the 8 bits span it.
+        unsigned int v = p[0] >> r;
+        if (r) v |= ((unsigned int)p[1]) << (8 - r);
+        uint64_t u = (uint64_t)(v & 0xff) * 0x0101010101010101ULL;
+        u &= 0x8040201008040201ULL;
+        u = ((u + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL;
+        BpStoreUint64(data + k, u);
+    }
+    return k;
+}
+
+#if BP_PACK_BMI2
+// BpPackHasBmi2 returns true if the BMI2 instructions are available.
+static inline bool BpPackHasBmi2(void) {
+#if defined(BP_PACK_BMI2_DETECT)
+    static int has = -1;
+    if (has < 0) has = __builtin_cpu_supports("bmi2") ? 1 : 0;
+    return has == 1;
+#else
+    return true;
+#endif
+}
+
+// BpPackIntegersBmi2 packs the elements of the array at data into given packer,
+// a word of elements at a time, extracting their lower nbits by PEXT. Returns
+// the number of elements packed.
+BP_PACK_BMI2_TARGET static int BpPackIntegersBmi2(int size, int nbits, int cap,
+                                                  unsigned char *data,
+                                                  struct BpPacker *w) {
+    int lanes = BpPackLanes(size, nbits, 8);
+    uint64_t mask = BpPackLaneMask(size, nbits, lanes);
+    int k = 0;
+    // The 8 bytes loaded at element k are in the array.
+    for (; k + 8 / size <= cap; k += lanes) {
+        w->acc |= _pext_u64(BpLoadUint64(data + k * size), mask) << w->a;
+        w->a += lanes * nbits;
+        BpPackerFlush(w);
+    }
+    return k;
+}
+
+// BpUnpackIntegersBmi2 unpacks the elements of the array at data from buffer
+// s at bit i, a word of elements at a time, depositing them by PDEP. Returns
+// the number of elements unpacked.
+BP_PACK_BMI2_TARGET static int BpUnpackIntegersBmi2(int size, int nbits,
+                                                    int cap, unsigned char *s,
+                                                    int i, unsigned char *end,
+                                                    unsigned char *data) {
+    int lanes = BpPackLanes(size, nbits, 8);
+    uint64_t mask = BpPackLaneMask(size, nbits, lanes);
+    int k = 0;
+    // The 8 bytes stored at element k are in the array.
+    for (; k + 8 / size <= cap; k += lanes) {
+        int b = i + k * nbits;
+        unsigned char *p = s + (b >> 3);
+        if (p + 8 > end) break;
+        uint64_t v = _pdep_u64(BpLoadUint64(p) >> (b & 7), mask);
+        BpStoreUint64(data + k * size, v);
+    }
+    return k;
+}
+#endif
+
+#if defined(BP_PACK_NEON)
+// BpUnpackIntegersNeon unpacks the elements of at most 12 bits of the array at
+// data, of uint8_t or uint16_t, from buffer s at bit i, 8 elements at a time.
+// The 8 elements are in nbits bytes, and their bits start at the same offsets
+// in each round, so that the bytes of each element are gathered into a lane of
+// 32 bits by a table lookup, and then shifted and masked. Returns the number
+// of elements unpacked.
+static int BpUnpackIntegersNeon(int size, int nbits, int cap, unsigned char *s,
+                                int i, unsigned char *end,
+                                unsigned char *data) {
+    if (size > 2 || nbits > 12) return 0;
+    uint8_t index[32];
+    int32_t shift[8];
+    for (int j = 0; j < 8; j++) {
+        int b = (i & 7) + j * nbits;
+        for (int x = 0; x < 4; x++)
+            index[(j << 2) + x] = (uint8_t)((b >> 3) + x);
+        shift[j] = -(b & 7);
+    }
+    uint8x16_t index0 = vld1q_u8(index), index1 = vld1q_u8(index + 16);
+    int32x4_t shift0 = vld1q_s32(shift), shift1 = vld1q_s32(shift + 4);
+    uint32x4_t mask = vdupq_n_u32((1u << nbits) - 1);
+    unsigned char *p = s + (i >> 3);
+    int k = 0;
+    // The 16 bytes loaded at p are in the bits to unpack.
+    for (; k + 8 <= cap && p + 16 <= end; k += 8, p += nbits) {
+        uint8x16_t v = vld1q_u8(p);
+        uint32x4_t v0 = vreinterpretq_u32_u8(vqtbl1q_u8(v, index0));
+        uint32x4_t v1 = vreinterpretq_u32_u8(vqtbl1q_u8(v, index1));
+        v0 = vandq_u32(vshlq_u32(v0, shift0), mask);
+        v1 = vandq_u32(vshlq_u32(v1, shift1), mask);
+        uint16x8_t u = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+        if (size == 2) {
+            vst1q_u16((uint16_t *)(data + (k << 1)), u);
+        } else {
+            vst1_u8(data + k, vmovn_u16(u));
+        }
+    }
+    return k;
+}
+#endif
+
+// BpPackIntegers encodes cap integers of size bytes each at data, in the host
+// order, into buffer s at bit i, nbits each, where nbits is at most
+// BP_PACK_MAX_NBITS. The same as BpCopyBufferBits, only the bits in range
+// [i, i+nbits*cap) of s are written.
+static void BpPackIntegers(int size, int nbits, int cap, unsigned char *data,
+                           unsigned char *s, int i) {
+    struct BpPacker w;
+    w.q = s + (i >> 3);
+    w.end = s + ((i + nbits * cap) >> 3);
+    w.a = i & 7;
+    // Keeps the bits before i in the first byte.
+    w.acc = w.a ? (w.q[0] & ((1u << w.a) - 1)) : 0;
+
+    int k = 0;
+    if (size == 1 && nbits == 1) {
+        k = BpPackBools(cap, data, &w);
+    } else {
+#if BP_PACK_BMI2
+        if (BpPackHasBmi2()) k = BpPackIntegersBmi2(size, nbits, cap, data, &w);
+#endif
+    }
+    // Unrolled, up to 4 elements are accumulated between the flushes.
+    uint64_t mask = (((uint64_t)1) << nbits) - 1;
+    int lanes = BpPackLanes(size, nbits, 4);
+    for (; k + lanes <= cap; k += lanes) {
+        for (int j = 0; j < lanes; j++) {
+            uint64_t v = BpLoadElement(data + (k + j) * size, size) & mask;
+            w.acc |= v << w.a;
+            w.a += nbits;
+        }
+        BpPackerFlush(&w);
+    }
+    for (; k < cap; k++) {
+        w.acc |= (BpLoadElement(data + k * size, size) & mask) << w.a;
+        w.a += nbits;
+        BpPackerFlush(&w);
+    }
+
+    // Keeps the bits after the last one in the last byte.
+    if (w.a) {
+        unsigned char m = (unsigned char)((1u << w.a) - 1);
+        w.q[0] = (unsigned char)((w.q[0] & ~m) | (w.acc & m));
+    }
+}
+
+// BpUnpackIntegers decodes cap unsigned integers of nbits each from buffer s
+// at bit i, into the integers of size bytes each at data, in the host order,
+// with the bits above nbits cleared, where nbits is at most BP_PACK_MAX_NBITS.
+// The same as BpCopyBufferBits, no bytes out of the bits to unpack are read.
+static void BpUnpackIntegers(int size, int nbits, int cap, unsigned char *s,
+                             int i, unsigned char *data) {
+    unsigned char *end = s + ((i + nbits * cap + 7) >> 3);
+    int k = 0;
+    if (size == 1 && nbits == 1) {
+        k = BpUnpackBools(cap, s, i, data);
+    } else {
+#if BP_PACK_BMI2
+        if (BpPackHasBmi2())
+            k = BpUnpackIntegersBmi2(size, nbits, cap, s, i, end, data);
+#elif defined(BP_PACK_NEON)
+        k = BpUnpackIntegersNeon(size, nbits, cap, s, i, end, data);
+#endif
+    }
+    // Unrolled, up to 4 elements are unpacked in a round, while the words
+    // loaded are all in the bits to unpack.
+    uint64_t mask = (((uint64_t)1) << nbits) - 1;
+    int lanes = BpPackLanes(size, nbits, 4);
+    for (; k + lanes <= cap; k += lanes) {
+        int b = i + k * nbits;
+        if (s + ((b + (lanes - 1) * nbits) >> 3) + 8 > end) break;
+        for (int j = 0; j < lanes; j++, b += nbits) {
+            uint64_t v = BpLoadUint64(s + (b >> 3)) >> (b & 7);
+            BpStoreElement(data + (k + j) * size, size, v & mask);
+        }
+    }
+    // The last elements, reading the bytes left one by one.
+    for (; k < cap; k++) {
+        int b = i + k * nbits;
+        unsigned char *p = s + (b >> 3);
+        uint64_t v = 0;
+        if (p + 8 <= end) {
+            v = BpLoadUint64(p);
+        } else {
+            for (int x = 0; p + x < end; x++) v |= ((uint64_t)p[x]) << (x << 3);
+        }
+        BpStoreElement(data + k * size, size, (v >> (b & 7)) & mask);
     }
 }
 
 // BpEndecodeBaseType process given base type at given data.
 // This function guarantees to work geven a nbits > 64 is passed in.
-void BpEndecodeBaseType(int nbits, struct BpProcessorContext *ctx, void *data) {
+BP_API void BpEndecodeBaseType(int nbits, struct BpProcessorContext *ctx,
+                               void *data) {
     if (ctx->is_encode) {
-        BpCopyBufferBits(nbits, ctx->s, (unsigned char *)data, ctx->i, 0);
+        BpEncodeBaseType(nbits, ctx, data);
     } else {
-        BpCopyBufferBits(nbits, (unsigned char *)data, ctx->s, 0, ctx->i);
+        BpDecodeBaseType(nbits, ctx, data);
+    }
+}
+
+// BpEncodeBaseType encodes given base type at given data into ctx->s.
+// The bits at data are copied in little-endian, see BpEncodeIntegers for the
+// integers of more than one byte.
+BP_API void BpEncodeBaseType(int nbits, struct BpProcessorContext *ctx,
+                             void *data) {
+    BpCopyBufferBits(nbits, ctx->s, (unsigned char *)data, ctx->i, 0);
+    ctx->i += nbits;
+}
+
+// BpEncodeIntegers encodes cap integers (or bools, bytes and enums) of size
+// bytes each, stored contiguously at given data, nbits each. Integers in
+// standard widths are copied in a batch, except on big-endian hosts, where
+// the integers of more than one byte are byte-swapped one by one. Arrays of
+// integers in odd widths are packed by BpPackIntegers.
+BP_API void BpEncodeIntegers(int size, int nbits, int cap,
+                             struct BpProcessorContext *ctx, void *data) {
+    if ((size == 1 || !BP_BIG_ENDIAN) && nbits == (size << 3)) {
+        BpEncodeBaseType(nbits * cap, ctx, data);
+        return;
+    }
+    if (cap > 1 && nbits <= BP_PACK_MAX_NBITS) {
+        BpPackIntegers(size, nbits, cap, (unsigned char *)data, ctx->s, ctx->i);
+        ctx->i += nbits * cap;
+        return;
     }
+    unsigned char *p = (unsigned char *)data;
+    uint64_t w;
+    for (int k = 0; k < cap; k++, p += size)
+        BpEncodeBaseType(nbits, ctx, BpEncodeSource(p, size, &w));
+}
+
+// BpDecodeBaseType decodes given base type from ctx->s into given data, in
+// little-endian. It's followed by BpClearArrayHighBitsAfterDecode or
+// BpHandleIntArraySignAfterDecode for the integers of more than one byte, which
+// swap them to the host order on big-endian hosts.
+BP_API void BpDecodeBaseType(int nbits, struct BpProcessorContext *ctx,
+                             void *data) {
+    if (ctx->n >= 0 && ((ctx->i + nbits + 7) >> 3) > ctx->n) {
+        // Bits out of the bounds of the buffer, skip the copy, and let the
+        // caller find ctx->i overflows ctx->n.
+        ctx->i += nbits;
+        return;
+    }
+    BpCopyBufferBits(nbits, (unsigned char *)data, ctx->s, 0, ctx->i);
     ctx->i += nbits;
 }
 
+// BpEncodePadding clears the padding bits after the last encoded bit in its
+// byte, so that every byte the encoder touched is fully defined, and the
+// buffer to encode into is not required to be zeroed.
+BP_API void BpEncodePadding(struct BpProcessorContext *ctx) {
+    int r = ctx->i & 7;
+    if (r) ctx->s[ctx->i >> 3] &= (unsigned char)((1 << r) - 1);
+}
+
+// BpSignExtendInt8s extends the sign bit of each of the cap int8_t integers
+// at p, which are int{nbits} integers in bitproto.
+// Suppose an int24 value V is stored in an int32_t:
+// 1. Clears the bits not belong to this integer: V &= (1 << 24) - 1
+// 2. Flips the sign bit and then subtract it: (V ^ (1 << 23)) - (1 << 23)
+//    For positive V, the flip sets the sign bit and the subtraction clears it.
+//    For negative V, the flip clears the sign bit and the subtraction borrows
+//    all the left bits to be 1.
+// It is branchless and lets the compiler vectorize the loop, and doesn't
+// depend on the implementation-defined arithmetic right shifting.
+static inline void BpSignExtendInt8s(int8_t *p, int cap, int nbits) {
+    uint8_t mask = (uint8_t)((1u << nbits) - 1);
+    uint8_t m = (uint8_t)(1u << (nbits - 1));
+    for (int k = 0; k < cap; k++) {
+        p[k] = (int8_t)((uint8_t)((((uint8_t)p[k]) & mask) ^ m) - m);
+    }
+}
+
+// BpSignExtendInt16s is the int16_t version of BpSignExtendInt8s.
+static inline void BpSignExtendInt16s(int16_t *p, int cap, int nbits) {
+    uint16_t mask = (uint16_t)((1u << nbits) - 1);
+    uint16_t m = (uint16_t)(1u << (nbits - 1));
+    int k = 0;
+#if defined(BP_SIGN_EXTEND_SSE2)
+    __m128i vmask = _mm_set1_epi16((short)mask);
+    __m128i vm = _mm_set1_epi16((short)m);
+    for (; k + 8 <= cap; k += 8) {
+        __m128i v = _mm_loadu_si128((__m128i *)(p + k));
+        v = _mm_sub_epi16(_mm_xor_si128(_mm_and_si128(v, vmask), vm), vm);
+        _mm_storeu_si128((__m128i *)(p + k), v);
+    }
+#elif defined(BP_SIGN_EXTEND_NEON)
+    uint16x8_t vmask = vdupq_n_u16(mask);
+    uint16x8_t vm = vdupq_n_u16(m);
+    for (; k + 8 <= cap; k += 8) {
+        uint16x8_t v = vld1q_u16((uint16_t *)(p + k));
+        v = vsubq_u16(veorq_u16(vandq_u16(v, vmask), vm), vm);
+        vst1q_u16((uint16_t *)(p + k), v);
+    }
+#endif
+    for (; k < cap; k++) {
+        p[k] = (int16_t)((uint16_t)((((uint16_t)p[k]) & mask) ^ m) - m);
+    }
+}
+
+// BpSignExtendInt32s is the int32_t version of BpSignExtendInt8s.
+static inline void BpSignExtendInt32s(int32_t *p, int cap, int nbits) {
+    uint32_t mask = (((uint32_t)1) << nbits) - 1;
+    uint32_t m = ((uint32_t)1) << (nbits - 1);
+    int k = 0;
+#if defined(BP_SIGN_EXTEND_SSE2)
+    __m128i vmask = _mm_set1_epi32((int)mask);
+    __m128i vm = _mm_set1_epi32((int)m);
+    for (; k + 4 <= cap; k += 4) {
+        __m128i v = _mm_loadu_si128((__m128i *)(p + k));
+        v = _mm_sub_epi32(_mm_xor_si128(_mm_and_si128(v, vmask), vm), vm);
+        _mm_storeu_si128((__m128i *)(p + k), v);
+    }
+#elif defined(BP_SIGN_EXTEND_NEON)
+    uint32x4_t vmask = vdupq_n_u32(mask);
+    uint32x4_t vm = vdupq_n_u32(m);
+    for (; k + 4 <= cap; k += 4) {
+        uint32x4_t v = vld1q_u32((uint32_t *)(p + k));
+        v = vsubq_u32(veorq_u32(vandq_u32(v, vmask), vm), vm);
+        vst1q_u32((uint32_t *)(p + k), v);
+    }
+#endif
+    for (; k < cap; k++) {
+        p[k] = (int32_t)(((((uint32_t)p[k]) & mask) ^ m) - m);
+    }
+}
+
+// BpSignExtendInt64s is the int64_t version of BpSignExtendInt8s.
+static inline void BpSignExtendInt64s(int64_t *p, int cap, int nbits) {
+    uint64_t mask = (((uint64_t)1) << nbits) - 1;
+    uint64_t m = ((uint64_t)1) << (nbits - 1);
+    for (int k = 0; k < cap; k++) {
+        p[k] = (int64_t)(((((uint64_t)p[k]) & mask) ^ m) - m);
+    }
+}
+
 // BpHandleIntSignAfterEndecode processes signed integer at given data after
 // this integer is endecode. The most left bit (Nth bit for int{N}) of a signed
 // integer indicates the sign. For example 00000101 is a negative integer for a
 // int3, but a positive integer for a int4. Where nbits is the number of bits
 // for this bitproto signed integer, for int{N}, its the N, the argument size is
 // the number of bytes in C language.
-void BpHandleIntSignAfterEndecode(int size, int nbits,
-                                  struct BpProcessorContext *ctx, void *data) {
+BP_API void BpHandleIntSignAfterEndecode(int size, int nbits,
+                                         struct BpProcessorContext *ctx,
+                                         void *data) {
+    BpHandleIntArraySignAfterEndecode(size, nbits, 1, ctx, data);
+}
+
+// BpHandleIntArraySignAfterEndecode processes cap signed integers stored
+// contiguously at given data after they are endecode, e.g. an int24[2] array.
+// It's the batch version of BpHandleIntSignAfterEndecode.
+BP_API void BpHandleIntArraySignAfterEndecode(int size, int nbits, int cap,
+                                              struct BpProcessorContext *ctx,
+                                              void *data) {
     // Signed integer's sign bit processing is only about decoding.
     if (ctx->is_encode) return;
+    BpHandleIntArraySignAfterDecode(size, nbits, cap, data);
+}
 
+// BpSignExtendIntegers extends the signs of cap signed integers of size bytes
+// each in the host order, stored contiguously at given data.
+static void BpSignExtendIntegers(int size, int nbits, int cap, void *data) {
     // For int8/16/32/64 signed integers, the sign bit is already on the
     // most-left bit position. There's no additional actions should be done.
-    if (nbits == 8 || nbits == 16 || nbits == 32 || nbits == 64) return;
+    if (BpIsNbitsStandard(nbits)) return;
+
+    // Members of packed structs, see c.struct_packing_alignment, may not be
+    // aligned for the typed loops below, which are then not taken.
+    if (((uintptr_t)data & (uintptr_t)(size - 1)) != 0) {
+        uint64_t mask = (((uint64_t)1) << nbits) - 1;
+        uint64_t m = ((uint64_t)1) << (nbits - 1);
+        unsigned char *p = (unsigned char *)data;
+        for (int k = 0; k < cap; k++, p += size) {
+            uint64_t v = BpLoadElement(p, size);
+            BpStoreElement(p, size, ((v & mask) ^ m) - m);
+        }
+        return;
+    }
 
     // Number of bits occupied in C intXX_t types, aka: n = size * 8
-    int n = size << 3;
-
-    switch (n) {
-        // Suppose pointer data points to a int24 value V:
-        // 1. Check its sign: (V >> (24-1)) & 1
-        // 2. If V is negative:
-        //    Make a mask that keeps right 24bits be 0, left 8bits be 1:
-        //    mask = ~(1 << 24 - 1)
-        //    Recover the original integer is: V | mask.
-        //
-        // Why not use V << 8 >> 8 solution here? This depends on arithmetic
-        // shifting. Which propagates the sign bit on the left vacant bits
-        // when doing a right shift. But C standard points that this
-        // behavior is implementation-defined.
+    switch (size << 3) {
         case 8:  // int8_t
-            if (((*(int8_t *)data) >> (nbits - 1)) & 1) {
-                *(int8_t *)data |= ~((1 << nbits) - 1);
-            }
+            BpSignExtendInt8s((int8_t *)data, cap, nbits);
             break;
         case 16:  // int16_t
-            if (((*(int16_t *)data) >> (nbits - 1)) & 1) {
-                *(int16_t *)data |= ~((1 << nbits) - 1);
-            }
+            BpSignExtendInt16s((int16_t *)data, cap, nbits);
             break;
         case 32:  // int32_t
-            if (((*(int32_t *)data) >> (nbits - 1)) & 1) {
-                *(int32_t *)data |= ~((1 << nbits) - 1);
-            }
+            BpSignExtendInt32s((int32_t *)data, cap, nbits);
             break;
         case 64:  // int64_t
-            if (((*(int64_t *)data) >> (nbits - 1)) & 1) {
-                *(int64_t *)data |= ~((1 << nbits) - 1);
-            }
+            BpSignExtendInt64s((int64_t *)data, cap, nbits);
             break;
     }
 }
 
-// BpEndecodeInt process a single signed integer at given data.
-void BpEndecodeInt(int size, int nbits, struct BpProcessorContext *ctx,
-                   void *data) {
-    // Copy bits without concern about sign bit.
-    BpEndecodeBaseType(nbits, ctx, data);
-    // Handle the signed bit.
-    BpHandleIntSignAfterEndecode(size, nbits, ctx, data);
+// BpHandleIntArraySignAfterDecode extends the signs of cap signed integers
+// stored contiguously at given data after they are decoded.
+BP_API void BpHandleIntArraySignAfterDecode(int size, int nbits, int cap,
+                                            void *data) {
+#if BP_BIG_ENDIAN
+    BpSwapIntegers(size, cap, data);
+#endif
+    BpSignExtendIntegers(size, nbits, cap, data);
 }
 
-// BpEncodeArrayExtensibleAhead encode the array capacity as the ahead flag
-// to current bit encoding stream.
-void BpEncodeArrayExtensibleAhead(struct BpArrayDescriptor *descriptor,
-                                  struct BpProcessorContext *ctx) {
-    // Safe to cast to uint16_t:
-    // the capacity of an array always <= 65535.
-    uint16_t data = (uint16_t)(descriptor->cap);
-    BpEndecodeBaseType(16, ctx, (void *)&data);
+// BpClearArrayHighBitsAfterDecode clears the bits above nbits of cap unsigned
+// integers (or bools, bytes and enums) stored contiguously at given data, each
+// in size bytes, after they are decoded. Decoding copies only the nbits of an
+// integer, so that every bit of the destination is defined, and a struct could
+// be decoded into again without zeroing it at first. On big-endian hosts, the
+// integers are swapped to the host order then.
+BP_API void BpClearArrayHighBitsAfterDecode(int size, int nbits, int cap,
+                                            void *data) {
+    if (nbits < (size << 3)) {
+        int b = nbits >> 3, r = nbits & 7;
+        unsigned char *p = (unsigned char *)data;
+        for (int k = 0; k < cap; k++, p += size) {
+            int t = b;
+            if (r) p[t++] &= (unsigned char)((1u << r) - 1);
+            while (t < size) p[t++] = 0;
+        }
+    }
+#if BP_BIG_ENDIAN
+    BpSwapIntegers(size, cap, data);
+#endif
 }
 
-// BpDecodeArrayExtensibleAhead decode the ahead flag as the array capacity
-// from current bit decoding buffer.
-uint16_t BpDecodeArrayExtensibleAhead(struct BpArrayDescriptor *descriptor,
-                                      struct BpProcessorContext *ctx) {
-    uint16_t data = 0;
-    BpEndecodeBaseType(16, ctx, (void *)&data);
-    return data;
+// BpEndecodeUint process a single unsigned integer (or bool, byte and enum) at
+// given data, which occupies size bytes in C.
+BP_API void BpEndecodeUint(int size, int nbits, struct BpProcessorContext *ctx,
+                           void *data) {
+    if (ctx->is_encode) {
+        BpEncodeIntegers(size, nbits, 1, ctx, data);
+    } else {
+        BpDecodeUint(size, nbits, ctx, data);
+    }
 }
 
-// BpEncodeMessageExtensibleAhead encode the message number of bits as the
-// ahead flag to current bit encoding stream.
-void BpEncodeMessageExtensibleAhead(struct BpMessageDescriptor *descriptor,
-                                    struct BpProcessorContext *ctx) {
-    // Safe to cast to uint16_t:
-    // The bitproto compiler constraints message size up to 65535 bits.
-    uint16_t data = (uint16_t)(descriptor->nbits);
-    BpEndecodeBaseType(16, ctx, (void *)&data);
+// BpDecodeUint decodes a single unsigned integer (or bool, byte and enum) at
+// given data, which occupies size bytes in C.
+BP_API void BpDecodeUint(int size, int nbits, struct BpProcessorContext *ctx,
+                         void *data) {
+    BpDecodeBaseType(nbits, ctx, data);
+    BpClearArrayHighBitsAfterDecode(size, nbits, 1, data);
 }
 
-// BpDecodeMessageExtensibleAhead decode the ahead flag as message's number
-// of bits from current decoding buffer.
-uint16_t BpDecodeMessageExtensibleAhead(struct BpMessageDescriptor *descriptor,
-                                        struct BpProcessorContext *ctx) {
-    uint16_t data = 0;
-    BpEndecodeBaseType(16, ctx, (void *)&data);
-    return data;
+// BpEndecodeInt process a single signed integer at given data.
+BP_API void BpEndecodeInt(int size, int nbits, struct BpProcessorContext *ctx,
+                          void *data) {
+    if (ctx->is_encode) {
+        // Copy bits without concern about sign bit.
+        BpEncodeIntegers(size, nbits, 1, ctx, data);
+    } else {
+        // Handle the signed bit after bits copied.
+        BpDecodeInt(size, nbits, ctx, data);
+    }
 }
 
-// BpJsonFormatString is a simple wrapper on sprintf that accepts
-// BpJsonFormatContext as an argment.
-void BpJsonFormatString(struct BpJsonFormatContext *ctx, const char *format,
-                        ...) {
-    va_list va;
-    va_start(va, format);
-    ctx->n += vsprintf((char *)&(ctx->s[ctx->n]), format, va);
-    va_end(va);
+// BpDecodeInt decodes a single signed integer at given data.
+BP_API void BpDecodeInt(int size, int nbits, struct BpProcessorContext *ctx,
+                        void *data) {
+    BpDecodeBaseType(nbits, ctx, data);
+    BpHandleIntArraySignAfterDecode(size, nbits, 1, data);
 }
 
-// BpJsonFormatMessage formats the message with given descriptor to json
-// format string and writes the formatted string into buffer given by ctx.
-void BpJsonFormatMessage(struct BpMessageDescriptor *descriptor,
-                         struct BpJsonFormatContext *ctx, void *data) {
-    // Formats left brace.
-    BpJsonFormatString(ctx, "{");
+// BpEndecodeRange process a single integer of a message field of option range
+// at given data, which occupies size bytes in C. The value minus lo is encoded
+// in nbits, lo is the lower bound in two's complement for signed integers.
+BP_API void BpEndecodeRange(int size, int nbits, uint64_t lo,
+                            struct BpProcessorContext *ctx, void *data) {
+    if (ctx->is_encode) {
+        BpEncodeRange(size, nbits, lo, ctx, data);
+    } else {
+        BpDecodeRange(size, nbits, lo, ctx, data);
+    }
+}
 
-    // Format key values.
-    for (int k = 0; k < descriptor->nfields; k++) {
-        struct BpMessageFieldDescriptor *field_descriptor =
-            &(descriptor->field_descriptors[k]);
+// BpEncodeRange encodes a single integer of option range at given data. The
+// offset wraps around in 64 bits, its lower nbits are the same for signed and
+// unsigned integers.
+BP_API void BpEncodeRange(int size, int nbits, uint64_t lo,
+                          struct BpProcessorContext *ctx, void *data) {
+    uint64_t w = BpLoadElement((unsigned char *)data, size) - lo;
+#if BP_BIG_ENDIAN
+    w = BpBswap64(w);
+#endif
+    BpEncodeBaseType(nbits, ctx, &w);
+}
 
-        BpJsonFormatMessageField(field_descriptor, ctx);
+// BpDecodeRange decodes a single integer of option range into given data, the
+// value decoded plus lo.
+BP_API void BpDecodeRange(int size, int nbits, uint64_t lo,
+                          struct BpProcessorContext *ctx, void *data) {
+    uint64_t w = 0;
+    BpDecodeBaseType(nbits, ctx, &w);
+#if BP_BIG_ENDIAN
+    w = BpBswap64(w);
+#endif
+    BpStoreElement((unsigned char *)data, size, w + lo);
+}
 
-        if (k + 1 < descriptor->nfields) {
-            BpJsonFormatString(ctx, ",");
-        }
+// BpFixedBits returns the bits on the wire of fixed-point value v, that is v
+// times scale rounded half away from zero, wrapping around in 64 bits. NaN is
+// encoded as zero.
+static inline uint64_t BpFixedBits(double v, double scale) {
+    v *= scale;
+    if (v >= 0) return (uint64_t)(v + 0.5);
+    if (v < 0) return (uint64_t)(int64_t)(v - 0.5);
+    return 0;
+}
+
+// BpFixedValue returns the fixed-point value of the nbits bits w on the wire,
+// which are sign-extended if is_signed.
+static inline double BpFixedValue(uint64_t w, int nbits, bool is_signed,
+                                  double unit) {
+    if (is_signed) {
+        uint64_t m = (uint64_t)1 << (nbits - 1);
+        return (double)(int64_t)((w ^ m) - m) * unit;
     }
+    return (double)w * unit;
+}
 
-    // Formats right brace.
-    BpJsonFormatString(ctx, "}");
+// BpEndecodeFixed process a single fixed-point number at given data, which is
+// a float or a double of size bytes in C. The value divided by unit, the value
+// of the least significant bit, is rounded to an integer encoded in nbits.
+BP_API void BpEndecodeFixed(int size, int nbits, bool is_signed, double unit,
+                            struct BpProcessorContext *ctx, void *data) {
+    if (ctx->is_encode) {
+        BpEncodeFixed(size, nbits, is_signed, unit, ctx, data);
+    } else {
+        BpDecodeFixed(size, nbits, is_signed, unit, ctx, data);
+    }
 }
 
-// BpJsonFormatMessageField formats a message field with given descriptor to
-// json format into target buffer in given ctx.
-void BpJsonFormatMessageField(struct BpMessageFieldDescriptor *descriptor,
-                              struct BpJsonFormatContext *ctx) {
-    // Format key.
-    BpJsonFormatString(ctx, "\"%s\":", descriptor->name);
+// BpEncodeFixed encodes a single fixed-point number at given data. The lower
+// nbits of the integer are the same for signed and unsigned numbers.
+BP_API void BpEncodeFixed(int size, int nbits, bool is_signed, double unit,
+                          struct BpProcessorContext *ctx, void *data) {
+    (void)is_signed;
+    double v = size == 4 ? (double)*(float *)data : *(double *)data;
+    // The unit is a power of two, of which the reciprocal is exact.
+    uint64_t w = BpFixedBits(v, 1.0 / unit);
+#if BP_BIG_ENDIAN
+    w = BpBswap64(w);
+#endif
+    BpEncodeBaseType(nbits, ctx, &w);
+}
 
-    int flag = descriptor->type.flag;
+// BpDecodeFixed decodes a single fixed-point number into given data.
+BP_API void BpDecodeFixed(int size, int nbits, bool is_signed, double unit,
+                          struct BpProcessorContext *ctx, void *data) {
+    uint64_t w = 0;
+    BpDecodeBaseType(nbits, ctx, &w);
+#if BP_BIG_ENDIAN
+    w = BpBswap64(w);
+#endif
+    double v = BpFixedValue(w, nbits, is_signed, unit);
+    if (size == 4) {
+        *(float *)data = (float)v;
+    } else {
+        *(double *)data = v;
+    }
+}
+
+// BpDecodeCount returns the number of the cap elements of nbits each in the
+// bounds of the buffer to decode, the others are skipped by BpDecodeBaseType.
+static inline int BpDecodeCount(int nbits, int cap,
+                                struct BpProcessorContext *ctx) {
+    if (ctx->n < 0) return cap;
+    int avail = (ctx->n << 3) - ctx->i;
+    return (avail <= 0) ? 0 : BpMin(cap, avail / nbits);
+}
+
+// BpDecodeUintArray decodes cap unsigned integers (or bools, bytes and enums) of
+// nbits each into the integers of size bytes each, stored contiguously at given
+// data. Arrays in odd widths, e.g. uint12[256] and bool[128], are unpacked by
+// BpUnpackIntegers, instead of copying the bits element by element.
+BP_API void BpDecodeUintArray(int size, int nbits, int cap,
+                              struct BpProcessorContext *ctx, void *data) {
+    unsigned char *p = (unsigned char *)data;
+    if (nbits > BP_PACK_MAX_NBITS) {
+        for (int k = 0; k < cap; k++, p += size)
+            BpDecodeBaseType(nbits, ctx, p);
+        BpClearArrayHighBitsAfterDecode(size, nbits, cap, data);
+        return;
+    }
+    int count = BpDecodeCount(nbits, cap, ctx);
+    BpUnpackIntegers(size, nbits, count, ctx->s, ctx->i, p);
+    ctx->i += nbits * cap;
+}
+
+// BpDecodeIntArray decodes cap signed integers of nbits each into the integers
+// of size bytes each, stored contiguously at given data, e.g. an int24[2]
+// array. The same as BpDecodeUintArray, and then the signs are extended.
+BP_API void BpDecodeIntArray(int size, int nbits, int cap,
+                             struct BpProcessorContext *ctx, void *data) {
+    unsigned char *p = (unsigned char *)data;
+    if (nbits > BP_PACK_MAX_NBITS) {
+        for (int k = 0; k < cap; k++, p += size)
+            BpDecodeBaseType(nbits, ctx, p);
+        BpHandleIntArraySignAfterDecode(size, nbits, cap, data);
+        return;
+    }
+    int count = BpDecodeCount(nbits, cap, ctx);
+    BpUnpackIntegers(size, nbits, count, ctx->s, ctx->i, p);
+    BpSignExtendIntegers(size, nbits, count, data);
+    ctx->i += nbits * cap;
+}
+
+// BpEncodeAhead encodes the ahead flag of an extensible type, that's the
+// capacity of an array, or the number of bits of a message.
+BP_API void BpEncodeAhead(uint16_t ahead, struct BpProcessorContext *ctx) {
+    unsigned char b[2] = {(unsigned char)ahead, (unsigned char)(ahead >> 8)};
+    BpEncodeBaseType(16, ctx, (void *)b);
+}
+
+// BpDecodeAhead decodes the ahead flag of an extensible type.
+BP_API uint16_t BpDecodeAhead(struct BpProcessorContext *ctx) {
+    unsigned char b[2] = {0, 0};
+    BpDecodeBaseType(16, ctx, (void *)b);
+    return (uint16_t)(b[0] | (b[1] << 8));
+}
+
+// BpEncodeArrayCount encodes the count of elements in use of a bounded array
+// in nbits, the uint16_t at data, capped to cap. Returns the count encoded.
+BP_API int BpEncodeArrayCount(int cap, int nbits,
+                              struct BpProcessorContext *ctx,
+                              const void *data) {
+    int n = *(const uint16_t *)data;
+    if (n > cap) n = cap;
+    unsigned char b[2] = {(unsigned char)n, (unsigned char)(n >> 8)};
+    BpEncodeBaseType(nbits, ctx, (void *)b);
+    return n;
+}
+
+// BpDecodeArrayCount decodes the count of elements in use of a bounded array
+// from nbits into the uint16_t at data. A count exceeding cap sets ctx->err to
+// BP_ERR_COUNT, and is capped. Returns the count decoded.
+BP_API int BpDecodeArrayCount(int cap, int nbits,
+                              struct BpProcessorContext *ctx, void *data) {
+    unsigned char b[2] = {0, 0};
+    BpDecodeBaseType(nbits, ctx, (void *)b);
+    int n = b[0] | (b[1] << 8);
+    if (n > cap) {
+        ctx->err = BP_ERR_COUNT;
+        n = cap;
+    }
+    *(uint16_t *)data = (uint16_t)n;
+    return n;
+}
+
+// BpMemoryDiffers returns true if the n bytes at p and q differ.
+static inline bool BpMemoryDiffers(const unsigned char *p,
+                                   const unsigned char *q, int n) {
+    for (int k = 0; k < n; k++)
+        if (p[k] != q[k]) return true;
+    return false;
+}
+
+// BpEncodeMessageDelta encodes the message with given descriptor at cur into
+// buffer s, as a delta against the previous one at prev: a bitmap of the
+// changed fields, one bit per field in the order of the descriptors, followed
+// by the changed fields only. A field is changed if its memory differs, so
+// padding bytes inside nested structs should be zeroed. Returns the number of
+// bytes encoded, the buffer s is not required to be zeroed.
+BP_API int BpEncodeMessageDelta(const struct BpMessageDescriptor *descriptor,
+                                void *prev, void *cur, unsigned char *s) {
+    struct BpProcessorContext ctx = BpProcessorContext(true, s);
+    ctx.i = descriptor->nfields;
+    for (int k = 0; k < descriptor->nfields; k++) {
+        const struct BpMessageFieldDescriptor *field_descriptor =
+            &(descriptor->field_descriptors[k]);
+        unsigned char *p = (unsigned char *)prev + field_descriptor->offset;
+        unsigned char *q = (unsigned char *)cur + field_descriptor->offset;
+        unsigned char changed =
+            BpMemoryDiffers(p, q, field_descriptor->type.size);
+        BpCopyBufferBits(1, s, &changed, k, 0);
+        if (changed) BpEndecodeMessageField(field_descriptor, &ctx, q);
+    }
+    BpEncodePadding(&ctx);
+    return (ctx.i + 7) >> 3;
+}
+
+// BpDecodeMessageDelta decodes the delta encoded by BpEncodeMessageDelta from
+// the n bytes at s, onto the message with given descriptor at data, which holds
+// the previous message. Returns the number of bytes decoded, or
+// BP_ERR_SHORT_INPUT if s is too short, the message may be updated partly then.
+BP_API int BpDecodeMessageDelta(const struct BpMessageDescriptor *descriptor,
+                                void *data, unsigned char *s, int n) {
+    if (((descriptor->nfields + 7) >> 3) > n) return BP_ERR_SHORT_INPUT;
+    struct BpProcessorContext ctx = BpProcessorContextN(false, s, n);
+    ctx.i = descriptor->nfields;
+    for (int k = 0; k < descriptor->nfields; k++) {
+        const struct BpMessageFieldDescriptor *field_descriptor =
+            &(descriptor->field_descriptors[k]);
+        unsigned char changed = 0;
+        BpCopyBufferBits(1, &changed, s, 0, k);
+        if (changed)
+            BpEndecodeMessageField(field_descriptor, &ctx,
+                                   (unsigned char *)data +
+                                       field_descriptor->offset);
+    }
+    if (ctx.i > (n << 3)) return BP_ERR_SHORT_INPUT;
+    if (ctx.err) return ctx.err;
+    return (ctx.i + 7) >> 3;
+}
+
+// BpEncodePlan encodes the message at data into buffer s by running n ops of
+// its copy plan, which occupies nbits in the buffer. The padding bits are
+// cleared, so the buffer s is not required to be zeroed.
+BP_API void BpEncodePlan(const struct BpPlanOp *ops, int n, int nbits,
+                         void *data, unsigned char *s) {
+    for (int k = 0; k < n; k++) {
+        const struct BpPlanOp *op = &ops[k];
+        unsigned char *p = (unsigned char *)data + op->offset;
+        int i = op->i;
+        uint64_t w;
+        for (int e = 0; e < op->count; e++, p += op->size, i += op->nbits)
+            BpCopyBufferBits(op->nbits, s, BpEncodeSource(p, op->size, &w), i,
+                             0);
+    }
+    int r = nbits & 7;
+    if (r) s[nbits >> 3] &= (unsigned char)((1 << r) - 1);
+}
+
+// BpDecodePlan decodes the message at data from buffer s by running n ops of
+// its copy plan.
+BP_API void BpDecodePlan(const struct BpPlanOp *ops, int n, void *data,
+                         const unsigned char *s) {
+    for (int k = 0; k < n; k++) {
+        const struct BpPlanOp *op = &ops[k];
+        unsigned char *p = (unsigned char *)data + op->offset;
+        int i = op->i;
+        for (int e = 0; e < op->count; e++, p += op->size, i += op->nbits)
+            BpCopyBufferBits(op->nbits, p, s, 0, i);
+        p = (unsigned char *)data + op->offset;
+        if (op->sign)
+            BpHandleIntArraySignAfterDecode(op->size, op->nbits, op->count, p);
+        else
+            BpClearArrayHighBitsAfterDecode(op->size, op->nbits, op->count, p);
+    }
+}
+
+// BP_BATCH_TILE is the number of messages BpDecodePlanBatch decodes at a time,
+// op by op, so that the bytes of them stay in cache across the ops.
+#define BP_BATCH_TILE 64
+
+// BpBatchLoad reads the nb bytes at p as a little-endian integer, for the last
+// messages in a batch, where a word load would overrun the buffer.
+static inline uint64_t BpBatchLoad(const unsigned char *p, int nb) {
+    uint64_t v = 0;
+    for (int t = 0; t < nb; t++) v |= (uint64_t)p[t] << (t << 3);
+    return v;
+}
+
+// BpBatchStore writes the lower size bytes of v to the struct member at p.
+static inline void BpBatchStore(unsigned char *p, int size, uint64_t v) {
+#if BP_BIG_ENDIAN
+    // Stored in little-endian below, swaps the lower size bytes at first.
+    v = BpBswap64(v) >> (64 - (size << 3));
+#endif
+    switch (size) {
+        case 1:
+            *p = (unsigned char)v;
+            break;
+        case 4:
+            BpStoreUint32(p, (uint32_t)v);
+            break;
+        case 8:
+            BpStoreUint64(p, v);
+            break;
+        default:
+            for (int t = 0; t < size; t++)
+                p[t] = (unsigned char)(v >> (t << 3));
+    }
+}
+
+// BpBatchColumn is an element of an op of a copy plan, to decode from the
+// messages of a batch, at the same bits in every message.
+struct BpBatchColumn {
+    // The struct member of the first message, and the size of the struct.
+    unsigned char *p;
+    size_t stride;
+    // Number of bytes the member occupies in the struct.
+    int size;
+    // The byte where the element starts in the first message, and the size of
+    // the messages in the buffer.
+    const unsigned char *s;
+    size_t nbytes;
+    // The index of the bit where the element starts in the byte at s.
+    int r;
+    // Masks the nbits of the element, and the sign bit of a signed integer in
+    // nbits, or 0 for others, to extend the sign by (v ^ m) - m.
+    uint64_t mask;
+    uint64_t m;
+};
+
+#if defined(BP_BATCH_AVX2)
+// BpBatchHasAvx2 returns true if the AVX2 instructions are available.
+static inline bool BpBatchHasAvx2(void) {
+#if defined(BP_BATCH_AVX2_DETECT)
+    static int has = -1;
+    if (has < 0) has = __builtin_cpu_supports("avx2") ? 1 : 0;
+    return has == 1;
+#else
+    return true;
+#endif
+}
+
+// BpDecodeBatchColumnAvx2x8 decodes the element of column c from the first
+// messages in 4 bytes words of which safe ones are in the buffer, 8 messages
+// at a time, by 8 lanes of 32 bits. Returns the number of messages decoded.
+BP_BATCH_AVX2_TARGET static size_t BpDecodeBatchColumnAvx2x8(
+    const struct BpBatchColumn *c, size_t safe) {
+    const int nbytes = (int)c->nbytes;
+    const __m256i vindex =
+        _mm256_set_epi32(7 * nbytes, 6 * nbytes, 5 * nbytes, 4 * nbytes,
+                         3 * nbytes, 2 * nbytes, nbytes, 0);
+    const __m128i vr = _mm_cvtsi32_si128(c->r);
+    const __m256i vmask = _mm256_set1_epi32((int)(uint32_t)c->mask);
+    const __m256i vm = _mm256_set1_epi32((int)(uint32_t)c->m);
+    uint32_t v[8];
+    size_t j = 0;
+    for (; j + 8 <= safe; j += 8) {
+        __m256i x = _mm256_i32gather_epi32((const int *)(c->s + j * c->nbytes),
+                                           vindex, 1);
+        x = _mm256_and_si256(_mm256_srl_epi32(x, vr), vmask);
+        x = _mm256_sub_epi32(_mm256_xor_si256(x, vm), vm);
+        _mm256_storeu_si256((__m256i *)v, x);
+        for (int t = 0; t < 8; t++)
+            BpBatchStore(c->p + (j + t) * c->stride, c->size, v[t]);
+    }
+    return j;
+}
+
+// BpDecodeBatchColumnAvx2x4 decodes the element of column c from the first
+// messages in 8 bytes words of which safe ones are in the buffer, 4 messages
+// at a time, by 4 lanes of 64 bits. Returns the number of messages decoded.
+BP_BATCH_AVX2_TARGET static size_t BpDecodeBatchColumnAvx2x4(
+    const struct BpBatchColumn *c, size_t safe) {
+    const long long nbytes = (long long)c->nbytes;
+    const __m256i vindex =
+        _mm256_set_epi64x(3 * nbytes, 2 * nbytes, nbytes, 0);
+    const __m128i vr = _mm_cvtsi32_si128(c->r);
+    const __m256i vmask = _mm256_set1_epi64x((long long)c->mask);
+    const __m256i vm = _mm256_set1_epi64x((long long)c->m);
+    uint64_t v[4];
+    size_t j = 0;
+    for (; j + 4 <= safe; j += 4) {
+        __m256i x = _mm256_i64gather_epi64(
+            (const long long *)(c->s + j * c->nbytes), vindex, 1);
+        x = _mm256_and_si256(_mm256_srl_epi64(x, vr), vmask);
+        x = _mm256_sub_epi64(_mm256_xor_si256(x, vm), vm);
+        _mm256_storeu_si256((__m256i *)v, x);
+        for (int t = 0; t < 4; t++)
+            BpBatchStore(c->p + (j + t) * c->stride, c->size, v[t]);
+    }
+    return j;
+}
+#elif defined(BP_SIGN_EXTEND_NEON) && !BP_BIG_ENDIAN
+// BpDecodeBatchColumnNeon decodes the element of column c from the first
+// messages in 8 bytes words of which safe ones are in the buffer, 2 messages
+// at a time, by 2 lanes of 64 bits. Returns the number of messages decoded.
+static size_t BpDecodeBatchColumnNeon(const struct BpBatchColumn *c,
+                                      size_t safe) {
+    const int64x2_t vr = vdupq_n_s64(-(int64_t)c->r);
+    const uint64x2_t vmask = vdupq_n_u64(c->mask);
+    const uint64x2_t vm = vdupq_n_u64(c->m);
+    size_t j = 0;
+    for (; j + 2 <= safe; j += 2) {
+        const unsigned char *q = c->s + j * c->nbytes;
+        uint64x2_t x =
+            vcombine_u64(vreinterpret_u64_u8(vld1_u8(q)),
+                         vreinterpret_u64_u8(vld1_u8(q + c->nbytes)));
+        x = vandq_u64(vshlq_u64(x, vr), vmask);
+        x = vsubq_u64(veorq_u64(x, vm), vm);
+        BpBatchStore(c->p + j * c->stride, c->size, vgetq_lane_u64(x, 0));
+        BpBatchStore(c->p + (j + 1) * c->stride, c->size,
+                     vgetq_lane_u64(x, 1));
+    }
+    return j;
+}
+#endif
+
+// BpDecodeBatchColumn decodes the element of column c from count messages,
+// which occupies nb bytes from the byte at s, r + nbits <= 64. For the first
+// safe4 or safe8 messages, a word of 4 or 8 bytes from s is in the buffer.
+static void BpDecodeBatchColumn(const struct BpBatchColumn *c, size_t count,
+                                int nb, size_t safe4, size_t safe8) {
+    size_t j = 0;
+#if defined(BP_BATCH_AVX2)
+    if (BpBatchHasAvx2())
+        j = (nb <= 4 && c->size <= 4) ? BpDecodeBatchColumnAvx2x8(c, safe4)
+                      : BpDecodeBatchColumnAvx2x4(c, safe8);
+#elif defined(BP_SIGN_EXTEND_NEON) && !BP_BIG_ENDIAN
+    j = BpDecodeBatchColumnNeon(c, safe8);
+#endif
+    for (; j < count; j++) {
+        const unsigned char *q = c->s + j * c->nbytes;
+        uint64_t v = (j < safe8) ? BpLoadUint64(q) : BpBatchLoad(q, nb);
+        v = (((v >> c->r) & c->mask) ^ c->m) - c->m;
+        BpBatchStore(c->p + j * c->stride, c->size, v);
+    }
+}
+
+// BpBatchSafe returns the number of the first messages of count in a buffer of
+// end bytes, each in nbytes, to read a word of w bytes from their bth byte.
+static inline size_t BpBatchSafe(size_t end, size_t b, size_t w, size_t nbytes,
+                                 size_t count) {
+    if (end < b + w) return 0;
+    size_t safe = (end - b - w) / nbytes + 1;
+    return safe < count ? safe : count;
+}
+
+// BpDecodePlanBatch decodes count messages one after another in buffer s, each
+// in nbytes, to the array of structs at data, each in size bytes, by n ops of
+// their copy plan. The same element of every message is at the same bits, which
+// are decoded for a tile of messages at a time, by the same shift and mask, in
+// the lanes of AVX2 or NEON where available. Elements across more than 8 bytes
+// and the runs of memcpy are copied message by message.
+BP_API void BpDecodePlanBatch(const struct BpPlanOp *ops, int n, void *data,
+                              size_t size, const unsigned char *s, int nbytes,
+                              size_t count) {
+    const size_t end = count * (size_t)nbytes;
+    for (size_t t = 0; t < count; t += BP_BATCH_TILE) {
+        size_t tile = (count - t < BP_BATCH_TILE) ? count - t : BP_BATCH_TILE;
+        unsigned char *dt = (unsigned char *)data + t * size;
+        const unsigned char *st = s + t * (size_t)nbytes;
+        for (int k = 0; k < n; k++) {
+            const struct BpPlanOp *op = &ops[k];
+            unsigned char *p = dt + op->offset;
+            int i = op->i;
+            for (int e = 0; e < op->count; e++, p += op->size, i += op->nbits) {
+                int r = i & 7;
+                if (op->size == 0 || op->size > 8 || r + op->nbits > 64) {
+                    for (size_t j = 0; j < tile; j++) {
+                        unsigned char *pj = p + j * size;
+                        BpCopyBufferBits(op->nbits, pj, st + j * nbytes, 0, i);
+                        if (op->sign)
+                            BpHandleIntArraySignAfterDecode(op->size,
+                                                            op->nbits, 1, pj);
+                        else
+                            BpClearArrayHighBitsAfterDecode(op->size,
+                                                            op->nbits, 1, pj);
+                    }
+                    continue;
+                }
+                size_t b = (size_t)(i >> 3);
+                size_t safe4 = BpBatchSafe(end, b, 4, nbytes, count);
+                size_t safe8 = BpBatchSafe(end, b, 8, nbytes, count);
+                safe4 = (safe4 > t) ? safe4 - t : 0;
+                safe8 = (safe8 > t) ? safe8 - t : 0;
+                struct BpBatchColumn c;
+                c.p = p;
+                c.stride = size;
+                c.size = op->size;
+                c.s = st + (i >> 3);
+                c.nbytes = (size_t)nbytes;
+                c.r = r;
+                c.mask = (op->nbits == 64) ? ~(uint64_t)0
+                                           : ((uint64_t)1 << op->nbits) - 1;
+                c.m = op->sign ? (uint64_t)1 << (op->nbits - 1) : 0;
+                BpDecodeBatchColumn(&c, tile, (r + op->nbits + 7) >> 3,
+                                    (safe4 < tile) ? safe4 : tile,
+                                    (safe8 < tile) ? safe8 : tile);
+            }
+        }
+    }
+}
+
+#if defined(BP_PARALLEL)
+// BpParallelShard is the records a thread of BpParallelBatch processes, no
+// state is shared across the threads.
+struct BpParallelShard {
+    BpBatchFunction f;
+    void *ms;
+    unsigned char *s;
+    size_t count;
+    // The return value of f.
+    int ret;
+};
+
+static void *BpParallelRun(void *arg) {
+    struct BpParallelShard *shard = (struct BpParallelShard *)arg;
+    shard->ret = shard->f(shard->ms, shard->count, shard->s);
+    return NULL;
+}
+
+// BpParallelNumProcessors returns the number of processors online.
+static int BpParallelNumProcessors(void) {
+#if defined(_OPENMP)
+    return omp_get_num_procs();
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+// BpParallelBatch runs batch function f over count records at ms, each in size
+// bytes, and buffer s, each in nbytes, split into contiguous shards of about
+// the same size, one for each of nthreads threads, or the number of processors
+// online if nthreads <= 0. The first shard runs on the calling thread. A shard
+// is run on the calling thread as well if its thread fails to start. Returns
+// the first non-zero return value of f in the order of shards, or 0.
+BP_API int BpParallelBatch(BpBatchFunction f, void *ms, size_t size,
+                           unsigned char *s, size_t nbytes, size_t count,
+                           int nthreads) {
+    if (nthreads <= 0) nthreads = BpParallelNumProcessors();
+    size_t most = count / BP_PARALLEL_MIN_RECORDS;
+    if (most < 1) most = 1;
+    if ((size_t)nthreads > most) nthreads = (int)most;
+    if (nthreads > BP_PARALLEL_MAX_THREADS) nthreads = BP_PARALLEL_MAX_THREADS;
+
+    struct BpParallelShard shards[BP_PARALLEL_MAX_THREADS];
+    size_t lo = 0;
+    for (int k = 0; k < nthreads; k++) {
+        size_t n = count / nthreads + ((size_t)k < count % nthreads);
+        shards[k].f = f;
+        shards[k].ms = (unsigned char *)ms + lo * size;
+        shards[k].s = s + lo * nbytes;
+        shards[k].count = n;
+        shards[k].ret = 0;
+        lo += n;
+    }
+
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nthreads) schedule(static, 1)
+    for (int k = 0; k < nthreads; k++) BpParallelRun(&shards[k]);
+#else
+    pthread_t threads[BP_PARALLEL_MAX_THREADS];
+    bool started[BP_PARALLEL_MAX_THREADS];
+    for (int k = 1; k < nthreads; k++)
+        started[k] =
+            pthread_create(&threads[k], NULL, BpParallelRun, &shards[k]) == 0;
+    BpParallelRun(&shards[0]);
+    for (int k = 1; k < nthreads; k++) {
+        if (started[k])
+            pthread_join(threads[k], NULL);
+        else
+            BpParallelRun(&shards[k]);
+    }
+#endif
+
+    for (int k = 0; k < nthreads; k++)
+        if (shards[k].ret != 0) return shards[k].ret;
+    return 0;
+}
+#endif
+
+// BpEncodePlanSink encodes the message at data by running n ops of its copy
+// plan, which occupies nbits in the buffer. The bytes are produced into buffer s
+// of cap bytes, and flushed through given sink every time s is full, so that the
+// first bytes go out before the encoding finishes. The bits of an element across
+// chunks are copied part by part.
+BP_API void BpEncodePlanSink(const struct BpPlanOp *ops, int n, int nbits,
+                             void *data, unsigned char *s, int cap, BpSink sink,
+                             void *arg) {
+    int k = 0, e = 0, d = 0;  // The same to the ones of struct BpPlanDecoder.
+
+    for (int base = 0; base < nbits; base += cap << 3) {
+        int end = BpMin(base + (cap << 3), nbits);
+
+        while (k < n) {
+            const struct BpPlanOp *op = &ops[k];
+            int i = op->i + e * op->nbits + d;
+            if (i >= end) break;
+
+            int c = BpMin(op->nbits - d, end - i);
+            unsigned char *p = (unsigned char *)data + op->offset + e * op->size;
+            uint64_t w;
+            p = BpEncodeSource(p, op->size, &w);
+            BpCopyBufferBits(c, s, p, i - base, d);
+            d += c;
+            if (d < op->nbits) break;
+
+            d = 0;
+            if (++e < op->count) continue;
+            e = 0;
+            k++;
+        }
+
+        // Clears the padding bits of the last byte, the ops cover the others.
+        int r = (end - base) & 7;
+        if (r) s[(end - base) >> 3] &= (unsigned char)((1 << r) - 1);
+        sink(s, (end - base + 7) >> 3, arg);
+    }
+}
+
+// BpDecodePlanChunk feeds the next chunk of n bytes at s to decode incrementally
+// by given plan decoder. The bits of an element across chunks are copied part by
+// part. Returns the number of bytes consumed, which is less than n if the message
+// ends inside this chunk, the rest bytes are left to the next message.
+BP_API int BpDecodePlanChunk(struct BpPlanDecoder *ctx, const unsigned char *s,
+                             int n) {
+    int nbytes = ((ctx->nbits + 7) >> 3) - (ctx->i >> 3);
+    if (n > nbytes) n = nbytes;
+    // The bits fed are in range [ctx->i, end).
+    int end = ctx->i + (n << 3);
+
+    while (ctx->k < ctx->n) {
+        const struct BpPlanOp *op = &ctx->ops[ctx->k];
+        // Where the bits of current element left start in the buffer.
+        int i = op->i + ctx->e * op->nbits + ctx->d;
+        if (i >= end) break;
+
+        int c = BpMin(op->nbits - ctx->d, end - i);
+        unsigned char *p =
+            (unsigned char *)ctx->data + op->offset + ctx->e * op->size;
+        BpCopyBufferBits(c, p, s, ctx->d, i - ctx->i);
+        ctx->d += c;
+        if (ctx->d < op->nbits) break;  // Continues with the next chunk.
+
+        ctx->d = 0;
+        if (++ctx->e < op->count) continue;
+
+        p = (unsigned char *)ctx->data + op->offset;
+        if (op->sign)
+            BpHandleIntArraySignAfterDecode(op->size, op->nbits, op->count, p);
+        else
+            BpClearArrayHighBitsAfterDecode(op->size, op->nbits, op->count, p);
+        ctx->e = 0;
+        ctx->k++;
+    }
+
+    ctx->i = end;
+    return n;
+}
+
+// BpPlanDecoderDone returns true if all bits of the message are fed to given
+// plan decoder.
+BP_API bool BpPlanDecoderDone(const struct BpPlanDecoder *ctx) {
+    return ctx->i >= ctx->nbits;
+}
+
+// BpMatchAheads returns true if the n ahead flags in buffer s all match given
+// checks, that is, buffer s is in the layout of current version, for the copy
+// plan to decode. The checks after a mismatch are not read, which may be out of
+// the buffer encoded by another version.
+BP_API bool BpMatchAheads(const struct BpAheadCheck *checks, int n,
+                          const unsigned char *s) {
+    for (int k = 0; k < n; k++) {
+        unsigned char b[2] = {0, 0};
+        BpCopyBufferBits(16, b, s, 0, checks[k].i);
+        if ((uint16_t)(b[0] | (b[1] << 8)) != checks[k].value) return false;
+    }
+    return true;
+}
+
+// Checksums are computed by tables of 16 entries, indexed by 4 bits at a time,
+// trading a little speed for flash on small targets.
+
+static const uint8_t BpCrc8Table[16] = {0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b,
+                                        0x12, 0x15, 0x38, 0x3f, 0x36, 0x31,
+                                        0x24, 0x23, 0x2a, 0x2d};
+
+static const uint16_t BpCrc16Table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef};
+
+#if !defined(BP_CRC32_EXTERNAL) && !defined(__ARM_FEATURE_CRC32)
+static const uint32_t BpCrc32Table[16] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4,
+    0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c};
+#endif
+
+// BpCrc8 updates given crc with n bytes at s, in CRC-8/SMBUS (poly 0x07).
+BP_API uint8_t BpCrc8(uint8_t crc, const unsigned char *s, size_t n) {
+    unsigned int c = crc;
+    while (n--) {
+        c ^= *s++;
+        c = ((c << 4) & 0xff) ^ BpCrc8Table[c >> 4];
+        c = ((c << 4) & 0xff) ^ BpCrc8Table[c >> 4];
+    }
+    return (uint8_t)c;
+}
+
+// BpCrc16 updates given crc with n bytes at s, in CRC-16/CCITT-FALSE (poly
+// 0x1021), starting from BP_CRC16_INIT.
+BP_API uint16_t BpCrc16(uint16_t crc, const unsigned char *s, size_t n) {
+    unsigned int c = crc;
+    while (n--) {
+        unsigned int b = *s++;
+        c = ((c << 4) & 0xffff) ^ BpCrc16Table[((c >> 12) ^ (b >> 4)) & 15];
+        c = ((c << 4) & 0xffff) ^ BpCrc16Table[((c >> 12) ^ b) & 15];
+    }
+    return (uint16_t)c;
+}
+
+#ifndef BP_CRC32_EXTERNAL
+// BpCrc32 updates given crc with n bytes at s, in CRC-32/ISO-HDLC, the same to
+// zlib's crc32. The CRC32 instructions are used on ARMv8 cores supporting them.
+// Define BP_CRC32_EXTERNAL to provide another implementation, e.g. by the CRC
+// calculation unit of STM32.
+BP_API uint32_t BpCrc32(uint32_t crc, const unsigned char *s, size_t n) {
+    uint32_t c = ~crc;
+#if defined(__ARM_FEATURE_CRC32)
+    for (; n >= 4; n -= 4, s += 4) {
+        // Little-endian words, the same as the library assumes.
+        c = __crc32w(c, BpLoadUint32((unsigned char *)s));
+    }
+    while (n--) c = __crc32b(c, *s++);
+#else
+    while (n--) {
+        c ^= *s++;
+        c = (c >> 4) ^ BpCrc32Table[c & 15];
+        c = (c >> 4) ^ BpCrc32Table[c & 15];
+    }
+#endif
+    return ~c;
+}
+#endif
+
+// BpEncodeCrc8 writes the crc8 checksum of the n bytes at s right after them.
+BP_API void BpEncodeCrc8(unsigned char *s, size_t n) {
+    s[n] = BpCrc8(BP_CRC8_INIT, s, n);
+}
+
+// BpEncodeCrc16 writes the crc16 checksum of the n bytes at s right after them,
+// in little-endian.
+BP_API void BpEncodeCrc16(unsigned char *s, size_t n) {
+    uint16_t crc = BpCrc16(BP_CRC16_INIT, s, n);
+    s[n] = (unsigned char)crc;
+    s[n + 1] = (unsigned char)(crc >> 8);
+}
+
+// BpEncodeCrc32 writes the crc32 checksum of the n bytes at s right after them,
+// in little-endian.
+BP_API void BpEncodeCrc32(unsigned char *s, size_t n) {
+    uint32_t crc = BpCrc32(BP_CRC32_INIT, s, n);
+    for (int k = 0; k < 4; k++) s[n + k] = (unsigned char)(crc >> (8 * k));
+}
+
+// BpVerifyCrc8 returns true if the n bytes at s match the crc8 checksum after
+// them.
+BP_API bool BpVerifyCrc8(const unsigned char *s, size_t n) {
+    return BpCrc8(BP_CRC8_INIT, s, n) == s[n];
+}
+
+// BpVerifyCrc16 returns true if the n bytes at s match the crc16 checksum after
+// them.
+BP_API bool BpVerifyCrc16(const unsigned char *s, size_t n) {
+    uint16_t crc = (uint16_t)(s[n] | (s[n + 1] << 8));
+    return BpCrc16(BP_CRC16_INIT, s, n) == crc;
+}
+
+// BpVerifyCrc32 returns true if the n bytes at s match the crc32 checksum after
+// them.
+BP_API bool BpVerifyCrc32(const unsigned char *s, size_t n) {
+    uint32_t crc = 0;
+    for (int k = 0; k < 4; k++) crc |= ((uint32_t)s[n + k]) << (8 * k);
+    return BpCrc32(BP_CRC32_INIT, s, n) == crc;
+}
+
+// BpCobsEncode frames the n bytes at s + BP_COBS_OVERHEAD(n) by COBS in place,
+// into buffer s followed by a zero delimiter. Returns the length of the frame,
+// including the delimiter. Writing never overtakes reading, since the bytes
+// written for the kth byte are at most 1 + k / 254 more than it.
+BP_API int BpCobsEncode(unsigned char *s, int n) {
+    const unsigned char *p = s + BP_COBS_OVERHEAD(n);
+    int code = 0;  // Where the code byte of current block is.
+    int w = 1;     // Where to write the next byte.
+    for (int k = 0; k < n; k++) {
+        unsigned char b = p[k];
+        if (b != 0) {
+            s[w++] = b;
+            // A full block of 254 non-zero bytes ends, if more bytes follow.
+            if (w - code < 255 || k + 1 == n) continue;
+        }
+        s[code] = (unsigned char)(w - code);
+        code = w++;
+    }
+    s[code] = (unsigned char)(w - code);
+    s[w++] = 0;
+    return w;
+}
+
+// BpCobsDecode unframes the COBS frame of n bytes at s in place, the trailing
+// zero delimiter is optional. Returns the number of bytes decoded, or
+// BP_ERR_FRAMING if the frame is malformed.
+BP_API int BpCobsDecode(unsigned char *s, int n) {
+    if (n > 0 && s[n - 1] == 0) n--;
+    int r = 0, w = 0;
+    while (r < n) {
+        int code = s[r++];
+        if (code == 0 || r + code - 1 > n) return BP_ERR_FRAMING;
+        for (int k = 1; k < code; k++) {
+            if (s[r] == 0) return BP_ERR_FRAMING;
+            s[w++] = s[r++];
+        }
+        // The last block is not followed by a zero, so is a full block.
+        if (code < 255 && r < n) s[w++] = 0;
+    }
+    return w;
+}
+
+// SLIP special characters.
+#define BP_SLIP_END 0xc0
+#define BP_SLIP_ESC 0xdb
+#define BP_SLIP_ESC_END 0xdc
+#define BP_SLIP_ESC_ESC 0xdd
+
+// BpSlipEncode frames the n bytes at s + BP_SLIP_OVERHEAD(n) by SLIP in place,
+// into buffer s followed by an END delimiter. Returns the length of the frame,
+// including the delimiter. Writing never overtakes reading, since the kth byte
+// is written at most at 2k + 1.
+BP_API int BpSlipEncode(unsigned char *s, int n) {
+    const unsigned char *p = s + BP_SLIP_OVERHEAD(n);
+    int w = 0;
+    for (int k = 0; k < n; k++) {
+        unsigned char b = p[k];
+        if (b == BP_SLIP_END) {
+            s[w++] = BP_SLIP_ESC;
+            s[w++] = BP_SLIP_ESC_END;
+        } else if (b == BP_SLIP_ESC) {
+            s[w++] = BP_SLIP_ESC;
+            s[w++] = BP_SLIP_ESC_ESC;
+        } else {
+            s[w++] = b;
+        }
+    }
+    s[w++] = BP_SLIP_END;
+    return w;
+}
+
+// BpSlipDecode unframes the SLIP frame of n bytes at s in place, the trailing
+// END delimiter is optional. Returns the number of bytes decoded, or
+// BP_ERR_FRAMING if the frame is malformed.
+BP_API int BpSlipDecode(unsigned char *s, int n) {
+    if (n > 0 && s[n - 1] == BP_SLIP_END) n--;
+    int w = 0;
+    for (int r = 0; r < n; r++) {
+        unsigned char b = s[r];
+        if (b == BP_SLIP_END) return BP_ERR_FRAMING;
+        if (b == BP_SLIP_ESC) {
+            if (++r == n) return BP_ERR_FRAMING;
+            if (s[r] == BP_SLIP_ESC_END) {
+                b = BP_SLIP_END;
+            } else if (s[r] == BP_SLIP_ESC_ESC) {
+                b = BP_SLIP_ESC;
+            } else {
+                return BP_ERR_FRAMING;
+            }
+        }
+        s[w++] = b;
+    }
+    return w;
+}
+
+// The table is defined once, in the translation unit of bitproto.c.
+#if defined(BP_TRACE_STATS) && \
+    (!defined(BITPROTO_INLINE) || defined(BP_LIB_TRANSLATION_UNIT))
+struct BpTraceStat BpTraceStats[BP_TRACE_STATS];
+
+// BpTraceIsName returns true if the entry e is of message name. The names are
+// string literals, which are mostly the same pointer for the same message.
+static bool BpTraceIsName(struct BpTraceStat *e, const char *name) {
+    if (e->name == name) return true;
+    const char *a = e->name, *b = name;
+    while (*a != '\0' && *a == *b) a++, b++;
+    return *a == *b;
+}
+
+// BpTraceRecord records a call of the encoder or the decoder for given
+// message, bound to BP_TRACE_END if BP_TRACE_STATS is defined. Calls of more
+// messages than BP_TRACE_STATS are dropped.
+void BpTraceRecord(const char *name, int dir, int nbytes, uint64_t ticks) {
+    for (int k = 0; k < BP_TRACE_STATS; k++) {
+        struct BpTraceStat *e = &BpTraceStats[k];
+        if (e->name == NULL) e->name = name;
+        if (BpTraceIsName(e, name)) {
+            e->count[dir]++;
+            e->bytes[dir] += (uint64_t)nbytes;
+            e->ticks[dir] += ticks;
+            return;
+        }
+    }
+}
+#endif
+
+// BpLogPut writes the lower n bytes of v at s in little-endian.
+static void BpLogPut(unsigned char *s, uint64_t v, int n) {
+    for (int k = 0; k < n; k++) s[k] = (unsigned char)(v >> (8 * k));
+}
+
+// BpLogGet reads n bytes at s in little-endian.
+static uint64_t BpLogGet(const unsigned char *s, int n) {
+    uint64_t v = 0;
+    for (int k = 0; k < n; k++) v |= ((uint64_t)s[k]) << (8 * k);
+    return v;
+}
+
+// BpLogWriteHeader writes the header of a log container with given schema
+// fingerprint at s, returns BP_LOG_HEADER_LENGTH.
+BP_API size_t BpLogWriteHeader(unsigned char *s, uint64_t fingerprint) {
+    s[0] = 'B', s[1] = 'P', s[2] = 'L', s[3] = 'G';
+    s[4] = 1;  // Version.
+    s[5] = s[6] = s[7] = 0;
+    BpLogPut(s + 8, fingerprint, 8);
+    return BP_LOG_HEADER_LENGTH;
+}
+
+// BpLogWriteFrameHeader writes the header of a frame of a message in n bytes
+// with given tag at s, returns BP_LOG_FRAME_HEADER_LENGTH. The message is
+// expected to be encoded right after, e.g. by EncodeXXX(m, s + 4).
+BP_API size_t BpLogWriteFrameHeader(unsigned char *s, uint16_t tag,
+                                    uint16_t n) {
+    BpLogPut(s, tag, 2);
+    BpLogPut(s + 2, n, 2);
+    return BP_LOG_FRAME_HEADER_LENGTH;
+}
+
+// BpLogWriteIndex writes the index of count frames at given offsets in the
+// container at s, after the last frame. Returns the number of bytes written,
+// 8 * count + 12.
+BP_API size_t BpLogWriteIndex(unsigned char *s, const uint64_t *offsets,
+                              size_t count) {
+    for (size_t k = 0; k < count; k++) BpLogPut(s + 8 * k, offsets[k], 8);
+    s += 8 * count;
+    BpLogPut(s, count, 8);
+    s[8] = 'B', s[9] = 'P', s[10] = 'I', s[11] = 'X';
+    return 8 * count + 12;
+}
+
+// BpLogOpen opens the log container of n bytes at s for reading by r, detects
+// the index at the end. Returns BP_ERR_LOG if it's not a log container.
+BP_API int BpLogOpen(struct BpLogReader *r, const unsigned char *s, size_t n) {
+    if (n < BP_LOG_HEADER_LENGTH || s[0] != 'B' || s[1] != 'P' || s[2] != 'L' ||
+        s[3] != 'G' || s[4] != 1)
+        return BP_ERR_LOG;
+    r->s = s;
+    r->n = n;
+    r->fingerprint = BpLogGet(s + 8, 8);
+    r->end = n;
+    r->count = 0;
+    r->i = BP_LOG_HEADER_LENGTH;
+
+    // An index is trusted if its size fits, the frames end where it starts.
+    const unsigned char *t = s + n - 4;
+    if (n >= BP_LOG_HEADER_LENGTH + 12 && t[0] == 'B' && t[1] == 'P' &&
+        t[2] == 'I' && t[3] == 'X') {
+        uint64_t count = BpLogGet(t - 8, 8);
+        if (count <= (n - BP_LOG_HEADER_LENGTH - 12) / 8) {
+            size_t end = n - 12 - (size_t)count * 8;
+            size_t last = count ? (size_t)BpLogGet(s + n - 20, 8) : end;
+            if (last + BP_LOG_FRAME_HEADER_LENGTH <= end &&
+                last + BP_LOG_FRAME_HEADER_LENGTH + BpLogGet(s + last + 2, 2) ==
+                    end) {
+                r->end = end;
+                r->count = (size_t)count;
+            }
+        }
+    }
+    return 0;
+}
+
+// BpLogNext reads the next frame of the container by r into frame. Returns 1 if
+// a frame is read, 0 at the end, or BP_ERR_LOG if the frame is truncated.
+BP_API int BpLogNext(struct BpLogReader *r, struct BpLogFrame *frame) {
+    if (r->i >= r->end) return 0;
+    if (r->end - r->i < BP_LOG_FRAME_HEADER_LENGTH) return BP_ERR_LOG;
+    const unsigned char *p = r->s + r->i;
+    uint16_t n = (uint16_t)BpLogGet(p + 2, 2);
+    if (r->end - r->i - BP_LOG_FRAME_HEADER_LENGTH < n) return BP_ERR_LOG;
+    frame->tag = (uint16_t)BpLogGet(p, 2);
+    frame->n = n;
+    frame->s = p + BP_LOG_FRAME_HEADER_LENGTH;
+    frame->offset = r->i;
+    r->i += BP_LOG_FRAME_HEADER_LENGTH + n;
+    return 1;
+}
+
+// BpLogSeek reads the kth frame of the container by r into frame by its index,
+// the iteration continues after it. Returns BP_ERR_LOG if the container is not
+// indexed, or k is out of range.
+BP_API int BpLogSeek(struct BpLogReader *r, size_t k,
+                     struct BpLogFrame *frame) {
+    if (k >= r->count) return BP_ERR_LOG;
+    uint64_t offset = BpLogGet(r->s + r->end + 8 * k, 8);
+    if (offset < BP_LOG_HEADER_LENGTH || offset >= r->end) return BP_ERR_LOG;
+    r->i = (size_t)offset;
+    return BpLogNext(r, frame) == 1 ? 0 : BP_ERR_LOG;
+}
+
+// BpTxInit initializes tx to double-buffer frames in buffers a and b, each large
+// enough for a frame, transmitted by given start function with arg.
+BP_API void BpTxInit(struct BpTxBuffers *tx, unsigned char *a, unsigned char *b,
+                     BpTxStart start, void *arg) {
+    tx->s[0] = a;
+    tx->s[1] = b;
+    tx->n[0] = tx->n[1] = 0;
+    tx->sending = -1;
+    tx->next = 0;
+    tx->start = start;
+    tx->arg = arg;
+}
+
+// BpTxAcquire returns the buffer to encode the next frame into, or NULL if both
+// are in use, one transmitting and the other waiting for it.
+BP_API unsigned char *BpTxAcquire(struct BpTxBuffers *tx) {
+    if (tx->n[tx->next] != 0) return NULL;
+    return tx->s[tx->next];
+}
+
+// BpTxCommit queues the frame of n bytes (n > 0) encoded into the buffer
+// acquired, and starts transmitting it if the transmitter is idle.
+BP_API void BpTxCommit(struct BpTxBuffers *tx, int n) {
+    int k = tx->next;
+    tx->n[k] = n;
+    tx->next = k ^ 1;
+    // The length is set ahead of the check, a completion in between starts
+    // this frame itself, leaving sending not -1.
+    if (tx->sending < 0) {
+        tx->sending = k;
+        tx->start(tx->s[k], n, tx->arg);
+    }
+}
+
+// BpTxComplete frees the buffer transmitted, and starts transmitting the other
+// if a frame is waiting in it. It's to call on the completion of a transmission,
+// e.g. in HAL_UART_TxCpltCallback.
+BP_API void BpTxComplete(struct BpTxBuffers *tx) {
+    int k = tx->sending;
+    if (k < 0) return;
+    tx->n[k] = 0;
+    k ^= 1;
+    if (tx->n[k] != 0) {
+        tx->sending = k;
+        tx->start(tx->s[k], tx->n[k], tx->arg);
+    } else {
+        tx->sending = -1;
+    }
+}
+
+// BpTxIdle returns true if all frames committed are transmitted.
+BP_API bool BpTxIdle(const struct BpTxBuffers *tx) { return tx->sending < 0; }
+
+#if defined(BP_RING)
+// BpRingInit initializes ring r over buffer s of n slots, each of size bytes,
+// e.g. BYTES_LENGTH_XXX rounded up to a multiple of BP_CACHE_LINE, so that the
+// two threads never write the same cache line. Returns BP_ERR_RING if n is not
+// a power of 2.
+BP_API int BpRingInit(struct BpRing *r, unsigned char *s, size_t size,
+                      size_t n) {
+    if (n == 0 || (n & (n - 1)) != 0) return BP_ERR_RING;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    r->tail_cached = r->head_cached = 0;
+    r->s = s;
+    r->size = size;
+    r->mask = n - 1;
+    return 0;
+}
+
+// BpRingAcquire returns the slot to encode the next frame into, or NULL if the
+// ring is full. Called by the producer only.
+BP_API unsigned char *BpRingAcquire(struct BpRing *r) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    if (head - r->tail_cached > r->mask) {
+        // Acquires the consumer's reads of the slots it released.
+        r->tail_cached = atomic_load_explicit(&r->tail, memory_order_acquire);
+        if (head - r->tail_cached > r->mask) return NULL;
+    }
+    return r->s + (head & r->mask) * r->size;
+}
+
+// BpRingCommit publishes the frame encoded into the slot acquired to the
+// consumer. Called by the producer only.
+BP_API void BpRingCommit(struct BpRing *r) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+}
+
+// BpRingPeek returns the slot of the oldest frame committed, or NULL if the
+// ring is empty. Called by the consumer only.
+BP_API const unsigned char *BpRingPeek(struct BpRing *r) {
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    if (tail == r->head_cached) {
+        // Acquires the producer's writes of the slots it committed.
+        r->head_cached = atomic_load_explicit(&r->head, memory_order_acquire);
+        if (tail == r->head_cached) return NULL;
+    }
+    return r->s + (tail & r->mask) * r->size;
+}
+
+// BpRingRelease frees the slot peeked for the producer to reuse. Called by the
+// consumer only.
+BP_API void BpRingRelease(struct BpRing *r) {
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+}
+#endif
+
+#if defined(BP_MMSG)
+// BpRecvFrames receives at most n datagrams, and at most BP_MMSG_MAX, from
+// socket fd by a single recvmmsg, each into a slot of size bytes of buffer s,
+// e.g. BYTES_LENGTH_XXX, for a batch decoder to decode them in one loop. Flags
+// are passed to recvmmsg, e.g. MSG_WAITFORONE to block for the first datagram
+// only. The bytes of a slot after a shorter datagram are zeroed, and a longer
+// datagram is truncated to the slot, e.g. of an extensible message of a newer
+// version. Returns the number of datagrams received, or BP_ERR_MMSG with errno
+// set if recvmmsg fails, e.g. EAGAIN if none is waiting to receive.
+BP_API int BpRecvFrames(int fd, unsigned char *s, size_t size, size_t n,
+                        int flags) {
+    struct mmsghdr msgs[BP_MMSG_MAX];
+    struct iovec iovs[BP_MMSG_MAX];
+    if (n > BP_MMSG_MAX) n = BP_MMSG_MAX;
+    memset(msgs, 0, n * sizeof(struct mmsghdr));
+    for (size_t k = 0; k < n; k++) {
+        iovs[k].iov_base = s + k * size;
+        iovs[k].iov_len = size;
+        msgs[k].msg_hdr.msg_iov = &iovs[k];
+        msgs[k].msg_hdr.msg_iovlen = 1;
+    }
+    int m = recvmmsg(fd, msgs, (unsigned int)n, flags, NULL);
+    if (m < 0) return BP_ERR_MMSG;
+    for (int k = 0; k < m; k++)
+        if (msgs[k].msg_len < size)
+            memset(s + k * size + msgs[k].msg_len, 0, size - msgs[k].msg_len);
+    return m;
+}
+
+// BpSendFrames sends n datagrams to connected socket fd, each of a slot of size
+// bytes of buffer s, by a sendmmsg for every BP_MMSG_MAX of them. Flags are
+// passed to sendmmsg. Returns the number of datagrams sent, less than n if a
+// sendmmsg fails after some are sent, or BP_ERR_MMSG with errno set if none is.
+BP_API int BpSendFrames(int fd, const unsigned char *s, size_t size, size_t n,
+                        int flags) {
+    struct mmsghdr msgs[BP_MMSG_MAX];
+    struct iovec iovs[BP_MMSG_MAX];
+    size_t sent = 0;
+    while (sent < n) {
+        size_t c = (n - sent < BP_MMSG_MAX) ? n - sent : BP_MMSG_MAX;
+        memset(msgs, 0, c * sizeof(struct mmsghdr));
+        for (size_t k = 0; k < c; k++) {
+            iovs[k].iov_base = (void *)(s + (sent + k) * size);
+            iovs[k].iov_len = size;
+            msgs[k].msg_hdr.msg_iov = &iovs[k];
+            msgs[k].msg_hdr.msg_iovlen = 1;
+        }
+        int m = sendmmsg(fd, msgs, (unsigned int)c, flags);
+        if (m <= 0) break;
+        sent += (size_t)m;
+    }
+    if (sent == 0 && n > 0) return BP_ERR_MMSG;
+    return (int)sent;
+}
+#endif
+
+// Dynamic codec.
+//
+// BpDynLoad compiles each message of a binary schema into a flat copy plan,
+// once at loading, with nested messages and arrays flattened, the same to the
+// plans generated with option c.copy_plans. Encoding and decoding run the plan
+// over a field table then, without walking the schema. The loader allocates
+// from the arena given instead of malloc, see bitproto/schema.py for the format
+// of binary schemas.
+
+// BP_DYN_MAX_DEPTH limits the nesting of types in a schema, to reject the
+// malformed ones referencing messages in a cycle.
+#define BP_DYN_MAX_DEPTH 32
+
+// BP_DYN_MAX_NBITS limits the number of bits of a type in a schema, so that the
+// sizes of arrays, multiplied by their capacities, are not overflowing.
+#define BP_DYN_MAX_NBITS (1 << 24)
+
+// BP_DYN_MAX_STEPS limits the number of types compiled for a message, to reject
+// the schemas of nested arrays flattened into too many elements, e.g. of empty
+// messages, taking no bits and slots.
+#define BP_DYN_MAX_STEPS (1 << 20)
+
+// BpDynLoader is the context of BpDynLoad.
+struct BpDynLoader {
+    // The schema, and the number of bytes of it.
+    const unsigned char *s;
+    size_t n;
+    // The arena, the capacity of it, and the number of bytes allocated.
+    unsigned char *arena;
+    size_t cap;
+    size_t used;
+    // The messages, and where the fields of each message start in the schema.
+    struct BpDynMessage *messages;
+    size_t *bodies;
+    int nmessages;
+    // The message being compiled, ops and fields are counted without being
+    // written if the arrays are NULL.
+    struct BpDynOp *ops;
+    struct BpDynField *fields;
+    char *names;
+    int nops;
+    int nfields;
+    int nnames;
+    int nslots;
+    // The bit of the buffer current type starts.
+    int i;
+    // The number of types compiled for the message, see BP_DYN_MAX_STEPS.
+    int nsteps;
+    // The path of current field.
+    char path[256];
+    int pathlen;
+    bool failed;
+};
+
+// BpDynAlloc allocates n bytes aligned to 8 from the arena of ld.
+static void *BpDynAlloc(struct BpDynLoader *ld, size_t n) {
+    size_t used = (ld->used + 7) & ~(size_t)7;
+    if (ld->failed || used > ld->cap || n > ld->cap - used) {
+        ld->failed = true;
+        return NULL;
+    }
+    ld->used = used + n;
+    return ld->arena + used;
+}
+
+// BpDynRead reads an integer of n bytes in little-endian at the pth byte of the
+// schema, and advances p.
+static uint64_t BpDynRead(struct BpDynLoader *ld, size_t *p, int n) {
+    if (ld->failed || *p > ld->n || (size_t)n > ld->n - *p) {
+        ld->failed = true;
+        return 0;
+    }
+    uint64_t v = BpLogGet(ld->s + *p, n);
+    *p += (size_t)n;
+    return v;
+}
+
+// BpDynSkipStr skips a string at the pth byte of the schema, returns the length
+// of it.
+static int BpDynSkipStr(struct BpDynLoader *ld, size_t *p) {
+    int len = (int)BpDynRead(ld, p, 1);
+    if (ld->failed || (size_t)len > ld->n - *p) {
+        ld->failed = true;
+        return 0;
+    }
+    *p += (size_t)len;
+    return len;
+}
+
+static int BpDynMessageNbits(struct BpDynLoader *ld, int k, int depth);
+
+// BpDynTypeNbits returns the number of bits of the type at the pth byte of the
+// schema, and skips it.
+static int BpDynTypeNbits(struct BpDynLoader *ld, size_t *p, int depth) {
+    if (depth > BP_DYN_MAX_DEPTH) ld->failed = true;
+    if (ld->failed) return 0;
+    int flag = (int)BpDynRead(ld, p, 1);
+    switch (flag) {
+        case BP_TYPE_BOOL:
+            return 1;
+        case BP_TYPE_BYTE:
+            return 8;
+        case BP_TYPE_INT:
+        case BP_TYPE_UINT:
+        case BP_TYPE_ENUM: {
+            int nbits = (int)BpDynRead(ld, p, 1);
+            if (nbits < 1 || nbits > 64) ld->failed = true;
+            return nbits;
+        }
+        case BP_TYPE_ARRAY: {
+            bool extensible = BpDynRead(ld, p, 1) != 0;
+            int cap = (int)BpDynRead(ld, p, 2);
+            int64_t nbits = BpDynTypeNbits(ld, p, depth + 1);
+            nbits = nbits * cap + (extensible ? 16 : 0);
+            if (nbits > BP_DYN_MAX_NBITS) ld->failed = true;
+            return ld->failed ? 0 : (int)nbits;
+        }
+        case BP_TYPE_MESSAGE:
+            return BpDynMessageNbits(ld, (int)BpDynRead(ld, p, 2), depth + 1);
+    }
+    ld->failed = true;
+    return 0;
+}
+
+// BpDynMessageNbits returns the number of bits of the kth message, computed
+// once and kept in it.
+static int BpDynMessageNbits(struct BpDynLoader *ld, int k, int depth) {
+    if (k >= ld->nmessages) ld->failed = true;
+    if (ld->failed) return 0;
+    struct BpDynMessage *m = &ld->messages[k];
+    if (m->nbits >= 0) return m->nbits;
+    size_t p = ld->bodies[k];
+    int64_t nbits = BpDynRead(ld, &p, 1) ? 16 : 0;
+    int nfields = (int)BpDynRead(ld, &p, 2);
+    for (int f = 0; f < nfields && !ld->failed; f++) {
+        BpDynSkipStr(ld, &p);
+        nbits += BpDynTypeNbits(ld, &p, depth + 1);
+        if (nbits > BP_DYN_MAX_NBITS) ld->failed = true;
+    }
+    if (ld->failed) return 0;
+    m->nbits = (int)nbits;
+    return m->nbits;
+}
+
+// BpDynEmitOp appends an op to the plan of the message being compiled, for
+// count elements of given kind and nbits, at current bit and the next slots.
+static void BpDynEmitOp(struct BpDynLoader *ld, int kind, int nbits, int count,
+                        int slot) {
+    if (ld->ops != NULL) {
+        struct BpDynOp *op = &ld->ops[ld->nops];
+        op->i = (uint32_t)ld->i;
+        op->slot = (uint16_t)slot;
+        op->count = (uint16_t)count;
+        op->nbits = (uint8_t)nbits;
+        op->kind = (uint8_t)kind;
+    }
+    ld->nops++;
+    ld->i += nbits * count;
+}
+
+// BpDynEmitField appends a field of current path to the message being
+// compiled, of count elements of given flag and nbits, at the next slots.
+static void BpDynEmitField(struct BpDynLoader *ld, int flag, int nbits,
+                           int count) {
+    if (ld->fields != NULL) {
+        struct BpDynField *field = &ld->fields[ld->nfields];
+        char *name = ld->names + ld->nnames;
+        for (int k = 0; k < ld->pathlen; k++) name[k] = ld->path[k];
+        name[ld->pathlen] = '\0';
+        field->name = name;
+        field->slot = (uint16_t)ld->nslots;
+        field->count = (uint16_t)count;
+        field->flag = (uint8_t)flag;
+        field->nbits = (uint8_t)nbits;
+    }
+    int kind = (flag == BP_TYPE_INT) ? BP_DYN_OP_INT : BP_DYN_OP_UINT;
+    BpDynEmitOp(ld, kind, nbits, count, ld->nslots);
+    ld->nfields++;
+    ld->nnames += ld->pathlen + 1;
+    ld->nslots += count;
+    if (ld->nslots > 0xFFFF) ld->failed = true;
+}
+
+// BpDynPushPath appends n bytes of str to current path, prefixed with the
+// separator sep if the path is not empty, returns the length to pop back to.
+static int BpDynPushPath(struct BpDynLoader *ld, char sep, const char *str,
+                         int n) {
+    int len = ld->pathlen;
+    if (len + n + 2 > (int)sizeof(ld->path)) {
+        ld->failed = true;
+        return len;
+    }
+    if (len > 0 && sep != '\0') ld->path[ld->pathlen++] = sep;
+    for (int k = 0; k < n; k++) ld->path[ld->pathlen++] = str[k];
+    return len;
+}
+
+static void BpDynCompileMessage(struct BpDynLoader *ld, int k, int depth);
+
+// BpDynCompileType compiles the type at the pth byte of the schema into ops and
+// fields of current path, and skips it.
+static void BpDynCompileType(struct BpDynLoader *ld, size_t *p, int depth) {
+    if (depth > BP_DYN_MAX_DEPTH || ++ld->nsteps > BP_DYN_MAX_STEPS)
+        ld->failed = true;
+    if (ld->failed) return;
+    size_t q = *p;
+    int nbits = BpDynTypeNbits(ld, p, depth);
+    if (ld->failed) return;
+    int flag = ld->s[q];
+    switch (flag) {
+        case BP_TYPE_BOOL:
+        case BP_TYPE_BYTE:
+        case BP_TYPE_INT:
+        case BP_TYPE_UINT:
+        case BP_TYPE_ENUM:
+            BpDynEmitField(ld, flag, nbits, 1);
+            return;
+        case BP_TYPE_MESSAGE:
+            BpDynCompileMessage(ld, (int)BpLogGet(ld->s + q + 1, 2), depth + 1);
+            return;
+    }
+
+    // Arrays: u8 extensible, u16 cap, and the element type at q.
+    bool extensible = ld->s[q + 1] != 0;
+    int cap = (int)BpLogGet(ld->s + q + 2, 2);
+    q += 4;
+    if (extensible) BpDynEmitOp(ld, BP_DYN_OP_AHEAD, 16, 1, cap);
+    int element_flag = ld->s[q];
+    if (element_flag != BP_TYPE_ARRAY && element_flag != BP_TYPE_MESSAGE) {
+        // An array of single types is a single field, of cap slots.
+        size_t r = q;
+        int element_nbits = BpDynTypeNbits(ld, &r, depth + 1);
+        BpDynEmitField(ld, element_flag, element_nbits, cap);
+        return;
+    }
+    for (int e = 0; e < cap && !ld->failed; e++) {
+        char index[8];
+        int n = 0;
+        index[n++] = '[';
+        if (e >= 10000) index[n++] = (char)('0' + e / 10000 % 10);
+        if (e >= 1000) index[n++] = (char)('0' + e / 1000 % 10);
+        if (e >= 100) index[n++] = (char)('0' + e / 100 % 10);
+        if (e >= 10) index[n++] = (char)('0' + e / 10 % 10);
+        index[n++] = (char)('0' + e % 10);
+        index[n++] = ']';
+        int len = BpDynPushPath(ld, '\0', index, n);
+        size_t r = q;
+        BpDynCompileType(ld, &r, depth + 1);
+        ld->pathlen = len;
+    }
+}
+
+// BpDynCompileMessage compiles the kth message into ops and fields, the paths
+// of its fields are prefixed with current path.
+static void BpDynCompileMessage(struct BpDynLoader *ld, int k, int depth) {
+    int nbits = BpDynMessageNbits(ld, k, depth);
+    if (ld->failed) return;
+    size_t p = ld->bodies[k];
+    bool extensible = BpDynRead(ld, &p, 1) != 0;
+    int nfields = (int)BpDynRead(ld, &p, 2);
+    if (extensible) BpDynEmitOp(ld, BP_DYN_OP_AHEAD, 16, 1, nbits);
+    for (int f = 0; f < nfields && !ld->failed; f++) {
+        int n = BpDynSkipStr(ld, &p);
+        int len = BpDynPushPath(ld, '.', (const char *)ld->s + p - n, n);
+        BpDynCompileType(ld, &p, depth + 1);
+        ld->pathlen = len;
+    }
+}
+
+// BpDynCompile compiles the kth message of the schema, by a pass counting the
+// ops, fields and bytes of names, and a pass writing them to the arena.
+static void BpDynCompile(struct BpDynLoader *ld, int k) {
+    struct BpDynMessage *m = &ld->messages[k];
+    for (int pass = 0; pass < 2 && !ld->failed; pass++) {
+        if (pass == 1) {
+            ld->ops = (struct BpDynOp *)BpDynAlloc(
+                ld, sizeof(struct BpDynOp) * (size_t)ld->nops);
+            ld->fields = (struct BpDynField *)BpDynAlloc(
+                ld, sizeof(struct BpDynField) * (size_t)ld->nfields);
+            ld->names = (char *)BpDynAlloc(ld, (size_t)ld->nnames);
+            if (ld->failed) return;
+        }
+        ld->nops = ld->nfields = ld->nnames = ld->nslots = 0;
+        ld->i = ld->pathlen = ld->nsteps = 0;
+        BpDynCompileMessage(ld, k, 0);
+    }
+    m->nbytes = (m->nbits + 7) >> 3;
+    m->nslots = ld->nslots;
+    m->ops = ld->ops;
+    m->nops = ld->nops;
+    m->fields = ld->fields;
+    m->nfields = ld->nfields;
+    ld->ops = NULL;
+    ld->fields = NULL;
+}
+
+// BpDynLoad loads the binary schema of n bytes at s into given schema, the
+// messages are compiled into flat copy plans. The schema keeps pointers into
+// the arena of cap bytes, which should outlive it, but not to s. Returns 0 on
+// success, or BP_ERR_SCHEMA if the schema is malformed, or the arena is too
+// small.
+BP_API int BpDynLoad(struct BpDynSchema *schema, const unsigned char *s,
+                     size_t n, void *arena, size_t cap) {
+    struct BpDynLoader ld;
+    ld.s = s;
+    ld.n = n;
+    ld.arena = (unsigned char *)arena;
+    ld.cap = cap;
+    ld.used = 0;
+    ld.ops = NULL;
+    ld.fields = NULL;
+    ld.failed = false;
+
+    if (n < 8 || s[0] != 'B' || s[1] != 'P' || s[2] != 'S' || s[3] != 'C' ||
+        s[4] != 1)
+        return BP_ERR_SCHEMA;
+    size_t p = 6;
+    ld.nmessages = (int)BpDynRead(&ld, &p, 2);
+    ld.messages = (struct BpDynMessage *)BpDynAlloc(
+        &ld, sizeof(struct BpDynMessage) * (size_t)ld.nmessages);
+    ld.bodies =
+        (size_t *)BpDynAlloc(&ld, sizeof(size_t) * (size_t)ld.nmessages);
+
+    // Finds the messages, and copies their names.
+    for (int k = 0; k < ld.nmessages && !ld.failed; k++) {
+        struct BpDynMessage *m = &ld.messages[k];
+        int len = BpDynSkipStr(&ld, &p);
+        char *name = (char *)BpDynAlloc(&ld, (size_t)len + 1);
+        if (ld.failed) break;
+        for (int c = 0; c < len; c++) name[c] = (char)s[p - len + c];
+        name[len] = '\0';
+        m->name = name;
+        m->fingerprint = BpDynRead(&ld, &p, 8);
+        m->nbits = -1;
+        ld.bodies[k] = p;
+        BpDynRead(&ld, &p, 1);
+        int nfields = (int)BpDynRead(&ld, &p, 2);
+        for (int f = 0; f < nfields && !ld.failed; f++) {
+            BpDynSkipStr(&ld, &p);
+            BpDynTypeNbits(&ld, &p, 0);
+        }
+    }
+
+    for (int k = 0; k < ld.nmessages && !ld.failed; k++) BpDynCompile(&ld, k);
+    if (ld.failed) return BP_ERR_SCHEMA;
+    schema->messages = ld.messages;
+    schema->nmessages = ld.nmessages;
+    return 0;
+}
+
+// BpDynNameIs returns true if given null terminated names are the same.
+static bool BpDynNameIs(const char *a, const char *b) {
+    while (*a != '\0' && *a == *b) a++, b++;
+    return *a == *b;
+}
+
+// BpDynFindMessage returns the message of given qualified name in given schema,
+// or NULL if not found.
+BP_API const struct BpDynMessage *BpDynFindMessage(
+    const struct BpDynSchema *schema, const char *name) {
+    for (int k = 0; k < schema->nmessages; k++)
+        if (BpDynNameIs(schema->messages[k].name, name))
+            return &schema->messages[k];
+    return NULL;
+}
+
+// BpDynFindMessageByFingerprint returns the message of given fingerprint in
+// given schema, or NULL if not found.
+BP_API const struct BpDynMessage *BpDynFindMessageByFingerprint(
+    const struct BpDynSchema *schema, uint64_t fingerprint) {
+    for (int k = 0; k < schema->nmessages; k++)
+        if (schema->messages[k].fingerprint == fingerprint)
+            return &schema->messages[k];
+    return NULL;
+}
+
+// BpDynFindField returns the field of given path in message m, or NULL if not
+// found.
+BP_API const struct BpDynField *BpDynFindField(const struct BpDynMessage *m,
+                                               const char *name) {
+    for (int k = 0; k < m->nfields; k++)
+        if (BpDynNameIs(m->fields[k].name, name)) return &m->fields[k];
+    return NULL;
+}
+
+// BpDynEncode encodes the field table values of message m into buffer s, which
+// is not required to be zeroed. Bits of the values above the number of bits of
+// the fields are ignored. Returns the number of bytes encoded.
+BP_API int BpDynEncode(const struct BpDynMessage *m, const uint64_t *values,
+                       unsigned char *s) {
+    for (int k = 0; k < m->nops; k++) {
+        const struct BpDynOp *op = &m->ops[k];
+        uint64_t w;
+        if (op->kind == BP_DYN_OP_AHEAD) {
+            uint16_t ahead = op->slot;
+            unsigned char *p = BpEncodeSource((unsigned char *)&ahead, 2, &w);
+            BpCopyBufferBits(16, s, p, (int)op->i, 0);
+            continue;
+        }
+        const uint64_t *v = values + op->slot;
+        int i = (int)op->i;
+        for (int e = 0; e < op->count; e++, i += op->nbits)
+            BpCopyBufferBits(op->nbits, s,
+                             BpEncodeSource((unsigned char *)&v[e], 8, &w), i,
+                             0);
+    }
+    int r = m->nbits & 7;
+    if (r) s[m->nbits >> 3] &= (unsigned char)((1 << r) - 1);
+    return m->nbytes;
+}
+
+// BpDynGet reads nbits at the ith bit of buffer s of n bytes, by a word load if
+// the 8 bytes are in the buffer. Bits above nbits are garbage.
+static inline uint64_t BpDynGet(const unsigned char *s, int n, int i,
+                                int nbits) {
+    unsigned char *p = (unsigned char *)s + (i >> 3);
+    if ((i >> 3) + 8 <= n && (i & 7) + nbits <= 64)
+        return BpLoadUint64(p) >> (i & 7);
+    uint64_t v = 0;
+    BpCopyBufferBits(nbits, (unsigned char *)&v, s, 0, i);
+#if BP_BIG_ENDIAN
+    v = BpBswap64(v);
+#endif
+    return v;
+}
+
+// BpDynDecode decodes message m from the n bytes at s into the field table
+// values, every slot is written. Signed integers are sign-extended to 64 bits.
+// Returns 0 on success, BP_ERR_SHORT_INPUT if s is too short, or BP_ERR_SCHEMA
+// if an ahead flag of extensible types mismatches the schema, that's s is
+// encoded by another version of the schema.
+BP_API int BpDynDecode(const struct BpDynMessage *m, uint64_t *values,
+                       const unsigned char *s, int n) {
+    if (n < m->nbytes) return BP_ERR_SHORT_INPUT;
+    for (int k = 0; k < m->nops; k++) {
+        const struct BpDynOp *op = &m->ops[k];
+        int nbits = op->nbits, i = (int)op->i;
+        uint64_t mask =
+            (nbits == 64) ? ~(uint64_t)0 : ((uint64_t)1 << nbits) - 1;
+        if (op->kind == BP_DYN_OP_AHEAD) {
+            uint64_t ahead = BpDynGet(s, n, i, 16) & mask;
+            if (ahead != op->slot) return BP_ERR_SCHEMA;
+            continue;
+        }
+        uint64_t sign =
+            (op->kind == BP_DYN_OP_INT) ? (uint64_t)1 << (nbits - 1) : 0;
+        uint64_t *v = values + op->slot;
+        for (int e = 0; e < op->count; e++, i += nbits)
+            v[e] = ((BpDynGet(s, n, i, nbits) & mask) ^ sign) - sign;
+    }
+    return 0;
+}
+
+// BpEncodeArrayExtensibleAhead encode the array capacity as the ahead flag
+// to current bit encoding stream.
+BP_API void BpEncodeArrayExtensibleAhead(
+    const struct BpArrayDescriptor *descriptor,
+    struct BpProcessorContext *ctx) {
+    // Safe to cast to uint16_t:
+    // the capacity of an array always <= 65535.
+    BpEncodeAhead((uint16_t)(descriptor->cap), ctx);
+}
+
+// BpDecodeArrayExtensibleAhead decode the ahead flag as the array capacity
+// from current bit decoding buffer.
+BP_API uint16_t BpDecodeArrayExtensibleAhead(
+    const struct BpArrayDescriptor *descriptor,
+    struct BpProcessorContext *ctx) {
+    (void)descriptor;
+    return BpDecodeAhead(ctx);
+}
+
+// BpEncodeMessageExtensibleAhead encode the message number of bits as the
+// ahead flag to current bit encoding stream.
+BP_API void BpEncodeMessageExtensibleAhead(
+    const struct BpMessageDescriptor *descriptor,
+    struct BpProcessorContext *ctx) {
+    // Safe to cast to uint16_t:
+    // The bitproto compiler constraints message size up to 65535 bits.
+    BpEncodeAhead((uint16_t)(descriptor->nbits), ctx);
+}
+
+// BpDecodeMessageExtensibleAhead decode the ahead flag as message's number
+// of bits from current decoding buffer.
+BP_API uint16_t BpDecodeMessageExtensibleAhead(
+    const struct BpMessageDescriptor *descriptor,
+    struct BpProcessorContext *ctx) {
+    (void)descriptor;
+    return BpDecodeAhead(ctx);
+}
+
+#ifndef BP_NO_JSON
+
+// BpJsonFormatWritable returns true if there's room for one more character
+// in the buffer given by ctx, keeping a byte for the trailing null byte.
+// A negative cap turns to a huge unsigned number, which disables the checking.
+static inline bool BpJsonFormatWritable(struct BpJsonFormatContext *ctx) {
+    return (unsigned int)ctx->n + 1 < (unsigned int)ctx->cap;
+}
+
+// BpJsonFormatFlush flushes the bytes not flushed yet through the sink of ctx.
+static void BpJsonFormatFlush(struct BpJsonFormatContext *ctx) {
+    if (ctx->w > 0) ctx->sink((const unsigned char *)ctx->s, ctx->w, ctx->arg);
+    ctx->w = 0;
+}
+
+// BpJsonFormatChar appends a single character to the buffer given by ctx.
+BP_API void BpJsonFormatChar(struct BpJsonFormatContext *ctx, char c) {
+    if (ctx->sink != NULL) {
+        ctx->s[ctx->w++] = c;
+        if (ctx->w == ctx->cap) BpJsonFormatFlush(ctx);
+    } else if (BpJsonFormatWritable(ctx)) {
+        ctx->s[ctx->n] = c;
+    }
+    ctx->n++;
+}
+
+// BpJsonFormatBytes appends n bytes of string str to the buffer given by ctx.
+BP_API void BpJsonFormatBytes(struct BpJsonFormatContext *ctx, const char *str,
+                              int n) {
+    for (int k = 0; k < n; k++) BpJsonFormatChar(ctx, str[k]);
+}
+
+// BpJsonFormatUint appends the decimal representation of unsigned integer v
+// to the buffer given by ctx.
+BP_API void BpJsonFormatUint(struct BpJsonFormatContext *ctx, uint64_t v) {
+    // Digits are generated in reverse order, 20 is enough for UINT64_MAX.
+    char digits[20];
+    int k = 0;
+    do {
+        digits[k++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v);
+    while (k) BpJsonFormatChar(ctx, digits[--k]);
+}
+
+// BpJsonFormatInt appends the decimal representation of signed integer v to
+// the buffer given by ctx.
+BP_API void BpJsonFormatInt(struct BpJsonFormatContext *ctx, int64_t v) {
+    if (v < 0) {
+        BpJsonFormatChar(ctx, '-');
+        // Negates in unsigned arithmetic, which is well-defined for INT64_MIN.
+        BpJsonFormatUint(ctx, (uint64_t)0 - (uint64_t)v);
+    } else {
+        BpJsonFormatUint(ctx, (uint64_t)v);
+    }
+}
+
+// BpJsonFormatReal appends the shortest representation of floating point value
+// v that reads back to the same value in given digits of precision, 9 for a
+// float and 17 for a double. Json has no infinities and NaN, they are null.
+static void BpJsonFormatReal(struct BpJsonFormatContext *ctx, double v,
+                             int digits) {
+    if (v - v != 0) {
+        BpJsonFormatBytes(ctx, "null", 4);
+        return;
+    }
+    char s[32];
+    int n = snprintf(s, sizeof(s), "%.*g", digits, v);
+    BpJsonFormatBytes(ctx, s, n);
+}
+
+// BpJsonFormatEnd terminates the formatted string with a null byte, which is
+// not counted into ctx->n. The string is terminated at the end of the buffer if
+// it's truncated, and nothing is written if the buffer is empty. With a sink,
+// the bytes not flushed yet are flushed instead.
+BP_API void BpJsonFormatEnd(struct BpJsonFormatContext *ctx) {
+    if (ctx->sink != NULL) {
+        BpJsonFormatFlush(ctx);
+    } else if ((unsigned int)ctx->n < (unsigned int)ctx->cap) {
+        ctx->s[ctx->n] = '\0';
+    } else if (ctx->cap > 0) {
+        ctx->s[ctx->cap - 1] = '\0';
+    }
+}
+
+// BpJsonFormatMessage formats the message with given descriptor to json
+// format string and writes the formatted string into buffer given by ctx.
+BP_API void BpJsonFormatMessage(const struct BpMessageDescriptor *descriptor,
+                                struct BpJsonFormatContext *ctx, void *data) {
+    // Formats left brace.
+    BpJsonFormatChar(ctx, '{');
+
+    // Format key values.
+    for (int k = 0; k < descriptor->nfields; k++) {
+        const struct BpMessageFieldDescriptor *field_descriptor =
+            &(descriptor->field_descriptors[k]);
+        void *field_data = (unsigned char *)data + field_descriptor->offset;
+
+        BpJsonFormatMessageField(field_descriptor, ctx, field_data);
+
+        if (k + 1 < descriptor->nfields) {
+            BpJsonFormatChar(ctx, ',');
+        }
+    }
+
+    // Formats right brace.
+    BpJsonFormatChar(ctx, '}');
+}
+
+// BpJsonFormatMessageField formats a message field with given descriptor to
+// json format into target buffer in given ctx. The argument data is the address
+// of this field's data.
+BP_API void BpJsonFormatMessageField(
+    const struct BpMessageFieldDescriptor *descriptor,
+    struct BpJsonFormatContext *ctx, void *data) {
+    // Format key, which is quoted and suffixed with a colon at compile time.
+    BpJsonFormatBytes(ctx, descriptor->key, descriptor->key_len);
+
+    int flag = descriptor->type.flag;
     int nbits = descriptor->type.nbits;
 
     // Format value.
@@ -443,68 +3051,89 @@ void BpJsonFormatMessageField(struct BpMessageFieldDescriptor *descriptor,
         case BP_TYPE_UINT:
         case BP_TYPE_BYTE:
         case BP_TYPE_ENUM:
-            BpJsonFormatBaseType(flag, nbits, ctx, descriptor->data);
+        case BP_TYPE_FLOAT:
+        case BP_TYPE_FIXED:
+            BpJsonFormatBaseType(flag, nbits, ctx, data);
             break;
         case BP_TYPE_ARRAY:
         case BP_TYPE_ALIAS:
         case BP_TYPE_MESSAGE:
-            descriptor->type.json_formatter(descriptor->data, ctx);
+            descriptor->type.json_formatter(data, ctx);
+            break;
+        case BP_TYPE_RANGE:
+            // Formatted as the integer declared, of size bytes.
+            BpJsonFormatBaseType(descriptor->type.to_flag,
+                                 descriptor->type.size << 3, ctx, data);
             break;
     }
 }
 
 // BpJsonFormatBaseType formats a data in base type to json format.
-void BpJsonFormatBaseType(int flag, int nbits, struct BpJsonFormatContext *ctx,
-                          void *data) {
+BP_API void BpJsonFormatBaseType(int flag, int nbits,
+                                 struct BpJsonFormatContext *ctx, void *data) {
     switch (flag) {
         case BP_TYPE_BOOL:
             // Bool
-            BpJsonFormatString(ctx, "%s",
-                               (*((bool *)(data))) ? "true" : "false");
+            if (*((bool *)(data))) {
+                BpJsonFormatBytes(ctx, "true", 4);
+            } else {
+                BpJsonFormatBytes(ctx, "false", 5);
+            }
             break;
         case BP_TYPE_INT:
             // Int
-            // FIXME 32bit differs with 64bit
             if (nbits <= 8) {
-                BpJsonFormatString(ctx, "%d", (*((int8_t *)data)));
+                BpJsonFormatInt(ctx, (*((int8_t *)data)));
             } else if (nbits <= 16) {
-                BpJsonFormatString(ctx, "%d", (*((int16_t *)data)));
+                BpJsonFormatInt(ctx, (*((int16_t *)data)));
             } else if (nbits <= 32) {
-                BpJsonFormatString(ctx, "%d", (*((int32_t *)data)));
+                BpJsonFormatInt(ctx, (*((int32_t *)data)));
             } else {
-                BpJsonFormatString(ctx, "%ld", (*((int64_t *)data)));
+                BpJsonFormatInt(ctx, (*((int64_t *)data)));
             }
             break;
         case BP_TYPE_UINT:
         case BP_TYPE_ENUM:
             // Uint
-            // FIXME 32bit differs with 64bit
             if (nbits <= 8) {
-                BpJsonFormatString(ctx, "%u", (*((uint8_t *)data)));
+                BpJsonFormatUint(ctx, (*((uint8_t *)data)));
             } else if (nbits <= 16) {
-                BpJsonFormatString(ctx, "%u", (*((uint16_t *)data)));
+                BpJsonFormatUint(ctx, (*((uint16_t *)data)));
             } else if (nbits <= 32) {
-                BpJsonFormatString(ctx, "%lu", (*((uint32_t *)data)));
+                BpJsonFormatUint(ctx, (*((uint32_t *)data)));
             } else {
-                BpJsonFormatString(ctx, "%llu", (*((uint64_t *)data)));
+                BpJsonFormatUint(ctx, (*((uint64_t *)data)));
             }
             break;
         case BP_TYPE_BYTE:
             // Byte
-            BpJsonFormatString(ctx, "%u", (*((unsigned char *)data)));
+            BpJsonFormatUint(ctx, (*((unsigned char *)data)));
+            break;
+        case BP_TYPE_FLOAT:
+            BpJsonFormatReal(ctx, *((float *)data), 9);
+            break;
+        case BP_TYPE_FIXED:
+            // A fixed-point number of more than 24 bits is a double.
+            if (nbits <= 24) {
+                BpJsonFormatReal(ctx, *((float *)data), 9);
+            } else {
+                BpJsonFormatReal(ctx, *((double *)data), 17);
+            }
             break;
     }
 }
 
 // BpJsonFormatAlias formats an alias with given descriptor to json format.
-void BpJsonFormatAlias(struct BpAliasDescriptor *descriptor,
-                       struct BpJsonFormatContext *ctx, void *data) {
+BP_API void BpJsonFormatAlias(const struct BpAliasDescriptor *descriptor,
+                              struct BpJsonFormatContext *ctx, void *data) {
     int flag = descriptor->to.flag;
     switch (flag) {
         case BP_TYPE_BOOL:
         case BP_TYPE_INT:
         case BP_TYPE_UINT:
         case BP_TYPE_BYTE:
+        case BP_TYPE_FLOAT:
+        case BP_TYPE_FIXED:
             BpJsonFormatBaseType(flag, descriptor->to.nbits, ctx, data);
             break;
         case BP_TYPE_ARRAY:
@@ -514,17 +3143,24 @@ void BpJsonFormatAlias(struct BpAliasDescriptor *descriptor,
 }
 
 // BpJsonFormatArray formats an array with given descriptor to json format.
-void BpJsonFormatArray(struct BpArrayDescriptor *descriptor,
-                       struct BpJsonFormatContext *ctx, void *data) {
-    BpJsonFormatString(ctx, "[");
+BP_API void BpJsonFormatArray(const struct BpArrayDescriptor *descriptor,
+                              struct BpJsonFormatContext *ctx, void *data) {
+    BpJsonFormatChar(ctx, '[');
 
+    int cap = descriptor->cap;
     int element_size = descriptor->element_type.size;
     int element_flag = descriptor->element_type.flag;
     int element_nbits = descriptor->element_type.nbits;
     unsigned char *data_ptr = (unsigned char *)data;
 
+    if (descriptor->count_nbits > 0) {
+        // Elements in use only if bounded.
+        if (*(const uint16_t *)data < cap) cap = *(const uint16_t *)data;
+        data_ptr += descriptor->offset;
+    }
+
     // Format array elements.
-    for (int k = 0; k < descriptor->cap; k++) {
+    for (int k = 0; k < cap; k++) {
         // Lookup the address of this element's data.
         void *element_data = (void *)(data_ptr + k * element_size);
         switch (element_flag) {
@@ -533,6 +3169,8 @@ void BpJsonFormatArray(struct BpArrayDescriptor *descriptor,
             case BP_TYPE_UINT:
             case BP_TYPE_BYTE:
             case BP_TYPE_ENUM:
+            case BP_TYPE_FLOAT:
+            case BP_TYPE_FIXED:
                 BpJsonFormatBaseType(element_flag, element_nbits, ctx,
                                      element_data);
                 break;
@@ -542,10 +3180,392 @@ void BpJsonFormatArray(struct BpArrayDescriptor *descriptor,
                 break;
         }
 
-        if (k + 1 < descriptor->cap) {
-            BpJsonFormatString(ctx, ",");
+        if (k + 1 < cap) {
+            BpJsonFormatChar(ctx, ',');
+        }
+    }
+
+    BpJsonFormatChar(ctx, ']');
+}
+
+// Alphabets of the hex and base64 (RFC 4648, with padding) json strings of
+// byte arrays, see option json_bytes.
+static const char BpJsonHexDigits[] = "0123456789abcdef";
+static const char BpJsonBase64Digits[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// BpJsonFormatHex formats n bytes at data as a quoted string of lowercase hex
+// digits, for byte arrays with option json_bytes = "hex".
+BP_API void BpJsonFormatHex(struct BpJsonFormatContext *ctx,
+                            const unsigned char *data, int n) {
+    BpJsonFormatChar(ctx, '"');
+    for (int k = 0; k < n; k++) {
+        BpJsonFormatChar(ctx, BpJsonHexDigits[data[k] >> 4]);
+        BpJsonFormatChar(ctx, BpJsonHexDigits[data[k] & 15]);
+    }
+    BpJsonFormatChar(ctx, '"');
+}
+
+// BpJsonFormatBase64 formats n bytes at data as a quoted base64 string, for
+// byte arrays with option json_bytes = "base64".
+BP_API void BpJsonFormatBase64(struct BpJsonFormatContext *ctx,
+                               const unsigned char *data, int n) {
+    BpJsonFormatChar(ctx, '"');
+    for (int k = 0; k < n; k += 3) {
+        int m = n - k < 3 ? n - k : 3;
+        uint32_t v = (uint32_t)data[k] << 16;
+        if (m > 1) v |= (uint32_t)data[k + 1] << 8;
+        if (m > 2) v |= (uint32_t)data[k + 2];
+        BpJsonFormatChar(ctx, BpJsonBase64Digits[(v >> 18) & 63]);
+        BpJsonFormatChar(ctx, BpJsonBase64Digits[(v >> 12) & 63]);
+        BpJsonFormatChar(ctx, m > 1 ? BpJsonBase64Digits[(v >> 6) & 63] : '=');
+        BpJsonFormatChar(ctx, m > 2 ? BpJsonBase64Digits[v & 63] : '=');
+    }
+    BpJsonFormatChar(ctx, '"');
+}
+
+// BpJsonParseFail marks the parsing in given ctx failed.
+static inline void BpJsonParseFail(struct BpJsonParseContext *ctx) {
+    ctx->err = BP_ERR_JSON;
+}
+
+// BpJsonParsePeek skips whitespaces and returns the next character without
+// consuming it, or a null byte at the end of the json string.
+static char BpJsonParsePeek(struct BpJsonParseContext *ctx) {
+    while (ctx->i < ctx->n) {
+        char c = ctx->s[ctx->i];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return c;
+        ctx->i++;
+    }
+    return '\0';
+}
+
+// BpJsonParseExpect consumes the character c after whitespaces, or fails.
+static bool BpJsonParseExpect(struct BpJsonParseContext *ctx, char c) {
+    if (BpJsonParsePeek(ctx) != c) {
+        BpJsonParseFail(ctx);
+        return false;
+    }
+    ctx->i++;
+    return true;
+}
+
+// BpJsonParseString consumes a quoted string, and sets the bytes between the
+// quotes to str and n, with escapes left as they are.
+static bool BpJsonParseString(struct BpJsonParseContext *ctx, const char **str,
+                              int *n) {
+    if (!BpJsonParseExpect(ctx, '"')) return false;
+    int start = ctx->i;
+    while (ctx->i < ctx->n) {
+        char c = ctx->s[ctx->i++];
+        if (c == '"') {
+            *str = ctx->s + start;
+            *n = ctx->i - 1 - start;
+            return true;
+        }
+        if (c == '\\') ctx->i++;
+    }
+    BpJsonParseFail(ctx);
+    return false;
+}
+
+// BpJsonParseNextKey parses the kth key of a json object and the colon after
+// it. The left brace is consumed if k is 0. Returns false at the right brace
+// or on an error. A key with escapes is kept escaped, and won't match any
+// field name.
+BP_API bool BpJsonParseNextKey(struct BpJsonParseContext *ctx, int k,
+                               const char **key, int *n) {
+    if (ctx->err) return false;
+    if (k == 0 && !BpJsonParseExpect(ctx, '{')) return false;
+    if (BpJsonParsePeek(ctx) == '}') {
+        ctx->i++;
+        return false;
+    }
+    if (k > 0 && !BpJsonParseExpect(ctx, ',')) return false;
+    return BpJsonParseString(ctx, key, n) && BpJsonParseExpect(ctx, ':');
+}
+
+// BpJsonParseNextElement prepares to parse the kth element of a json array of
+// at most cap elements. The left bracket is consumed if k is 0. Returns false
+// at the right bracket or on an error, more than cap elements is an error.
+BP_API bool BpJsonParseNextElement(struct BpJsonParseContext *ctx, int k,
+                                   int cap) {
+    if (ctx->err) return false;
+    if (k == 0 && !BpJsonParseExpect(ctx, '[')) return false;
+    if (BpJsonParsePeek(ctx) == ']') {
+        ctx->i++;
+        return false;
+    }
+    if (k > 0 && !BpJsonParseExpect(ctx, ',')) return false;
+    if (k >= cap) {
+        BpJsonParseFail(ctx);
+        return false;
+    }
+    return true;
+}
+
+// BpJsonParseLiteral consumes the n bytes of literal str, e.g. true, or fails.
+static bool BpJsonParseLiteral(struct BpJsonParseContext *ctx, const char *str,
+                               int n) {
+    for (int k = 0; k < n; k++) {
+        if (ctx->i >= ctx->n || ctx->s[ctx->i] != str[k]) {
+            BpJsonParseFail(ctx);
+            return false;
+        }
+        ctx->i++;
+    }
+    return true;
+}
+
+// BpJsonParseInteger consumes a json integer, and sets its magnitude to v and
+// whether it's negative to negative. Fractions, exponents and magnitudes
+// overflowing 64 bits fail.
+static bool BpJsonParseInteger(struct BpJsonParseContext *ctx, uint64_t *v,
+                               bool *negative) {
+    char c = BpJsonParsePeek(ctx);
+    *negative = (c == '-');
+    if (*negative) ctx->i++;
+    int start = ctx->i;
+    uint64_t x = 0;
+    while (ctx->i < ctx->n && ctx->s[ctx->i] >= '0' && ctx->s[ctx->i] <= '9') {
+        uint64_t d = (uint64_t)(ctx->s[ctx->i++] - '0');
+        if (x > (UINT64_MAX - d) / 10) {
+            BpJsonParseFail(ctx);
+            return false;
+        }
+        x = x * 10 + d;
+    }
+    if (ctx->i == start || (ctx->i < ctx->n && (ctx->s[ctx->i] == '.' ||
+                                                ctx->s[ctx->i] == 'e' ||
+                                                ctx->s[ctx->i] == 'E'))) {
+        BpJsonParseFail(ctx);
+        return false;
+    }
+    *v = x;
+    return true;
+}
+
+// BpJsonParseReal consumes a json number or null, and sets its value to v,
+// null is NAN. Numbers longer than 63 characters fail.
+static bool BpJsonParseReal(struct BpJsonParseContext *ctx, double *v) {
+    if (BpJsonParsePeek(ctx) == 'n') {
+        if (!BpJsonParseLiteral(ctx, "null", 4)) return false;
+        *v = NAN;
+        return true;
+    }
+    // strtod needs a null terminated string, the json string is not.
+    char s[64];
+    int n = 0;
+    while (ctx->i < ctx->n && n < (int)sizeof(s) - 1) {
+        char c = ctx->s[ctx->i];
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+              c == 'e' || c == 'E'))
+            break;
+        s[n++] = c;
+        ctx->i++;
+    }
+    s[n] = '\0';
+    char *end;
+    *v = strtod(s, &end);
+    if (n == 0 || end != s + n) {
+        BpJsonParseFail(ctx);
+        return false;
+    }
+    return true;
+}
+
+// BpJsonParseBaseType parses a json value of base type into data, the same
+// representations BpJsonFormatBaseType formats. Integers out of the range of
+// nbits fail.
+BP_API void BpJsonParseBaseType(int flag, int nbits,
+                                struct BpJsonParseContext *ctx, void *data) {
+    if (ctx->err) return;
+    if (flag == BP_TYPE_FLOAT || flag == BP_TYPE_FIXED) {
+        double x;
+        if (!BpJsonParseReal(ctx, &x)) return;
+        if (flag == BP_TYPE_FLOAT || nbits <= 24) {
+            *((float *)data) = (float)x;
+        } else {
+            *((double *)data) = x;
+        }
+        return;
+    }
+    if (flag == BP_TYPE_BOOL) {
+        if (BpJsonParsePeek(ctx) == 't') {
+            if (BpJsonParseLiteral(ctx, "true", 4)) *((bool *)data) = true;
+        } else if (BpJsonParseLiteral(ctx, "false", 5)) {
+            *((bool *)data) = false;
+        }
+        return;
+    }
+
+    uint64_t v;
+    bool negative;
+    if (!BpJsonParseInteger(ctx, &v, &negative)) return;
+
+    if (flag == BP_TYPE_INT) {
+        // Ranges in [-2^(nbits-1), 2^(nbits-1)-1].
+        uint64_t max = ((uint64_t)1 << (nbits - 1)) - 1;
+        if (v > max + (negative ? 1 : 0)) {
+            BpJsonParseFail(ctx);
+            return;
+        }
+        // Negates in unsigned arithmetic, which is well-defined for INT64_MIN.
+        int64_t x = negative ? (int64_t)((uint64_t)0 - v) : (int64_t)v;
+        if (nbits <= 8) {
+            *((int8_t *)data) = (int8_t)x;
+        } else if (nbits <= 16) {
+            *((int16_t *)data) = (int16_t)x;
+        } else if (nbits <= 32) {
+            *((int32_t *)data) = (int32_t)x;
+        } else {
+            *((int64_t *)data) = x;
+        }
+        return;
+    }
+
+    // Uint, byte and enum.
+    if ((negative && v != 0) || (nbits < 64 && (v >> nbits) != 0)) {
+        BpJsonParseFail(ctx);
+        return;
+    }
+    if (nbits <= 8) {
+        *((uint8_t *)data) = (uint8_t)v;
+    } else if (nbits <= 16) {
+        *((uint16_t *)data) = (uint16_t)v;
+    } else if (nbits <= 32) {
+        *((uint32_t *)data) = (uint32_t)v;
+    } else {
+        *((uint64_t *)data) = v;
+    }
+}
+
+// BpJsonParseHexDigit returns the value of hex digit c, or -1.
+static inline int BpJsonParseHexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// BpJsonParseBase64Digit returns the value of base64 digit c, or -1.
+static inline int BpJsonParseBase64Digit(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+// BpJsonParseHex parses a quoted string of hex digits into a byte array of cap
+// bytes at data, the reverse of BpJsonFormatHex. Bytes missing are left
+// untouched, more than cap bytes is an error. Returns the number of bytes
+// parsed, e.g. the count of a bounded array.
+BP_API int BpJsonParseHex(struct BpJsonParseContext *ctx, unsigned char *data,
+                          int cap) {
+    const char *str;
+    int n;
+    if (ctx->err || !BpJsonParseString(ctx, &str, &n)) return 0;
+    if (n % 2 != 0 || n / 2 > cap) {
+        BpJsonParseFail(ctx);
+        return 0;
+    }
+    for (int k = 0; k < n; k += 2) {
+        int hi = BpJsonParseHexDigit(str[k]);
+        int lo = BpJsonParseHexDigit(str[k + 1]);
+        if (hi < 0 || lo < 0) {
+            BpJsonParseFail(ctx);
+            return 0;
+        }
+        data[k / 2] = (unsigned char)((hi << 4) | lo);
+    }
+    return n / 2;
+}
+
+// BpJsonParseBase64 parses a quoted base64 string into a byte array of cap
+// bytes at data, the reverse of BpJsonFormatBase64. The padding is required.
+// Bytes missing are left untouched, more than cap bytes is an error. Returns
+// the number of bytes parsed.
+BP_API int BpJsonParseBase64(struct BpJsonParseContext *ctx,
+                             unsigned char *data, int cap) {
+    const char *str;
+    int n;
+    if (ctx->err || !BpJsonParseString(ctx, &str, &n)) return 0;
+    if (n % 4 != 0) {
+        BpJsonParseFail(ctx);
+        return 0;
+    }
+    int j = 0;  // Number of bytes parsed.
+    for (int k = 0; k < n; k += 4) {
+        // Number of bytes in this group, by the padding at the last group.
+        int m = 3;
+        if (k + 4 == n && str[k + 3] == '=') m = (str[k + 2] == '=') ? 1 : 2;
+        if (j + m > cap) {
+            BpJsonParseFail(ctx);
+            return 0;
+        }
+        uint32_t v = 0;
+        for (int t = 0; t < 4; t++) {
+            // The m + 1 digits in front carry the m bytes.
+            int d = (t <= m) ? BpJsonParseBase64Digit(str[k + t]) : 0;
+            if (d < 0) {
+                BpJsonParseFail(ctx);
+                return 0;
+            }
+            v = (v << 6) | (uint32_t)d;
         }
+        for (int t = 0; t < m; t++)
+            data[j++] = (unsigned char)(v >> (16 - 8 * t));
     }
+    return j;
+}
+
+// BpJsonParseIsLiteral returns true if c could be part of a json number, true,
+// false or null.
+static inline bool BpJsonParseIsLiteral(char c) {
+    return c == '-' || c == '+' || c == '.' || (c >= '0' && c <= '9') ||
+           (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
 
-    BpJsonFormatString(ctx, "]");
+// BpJsonParseSkip skips a json value, e.g. of an unknown key. Nested objects
+// and arrays are skipped by counting the brackets, without validating inside.
+BP_API void BpJsonParseSkip(struct BpJsonParseContext *ctx) {
+    if (ctx->err) return;
+    const char *str;
+    int n, depth = 0;
+    do {
+        char c = BpJsonParsePeek(ctx);
+        int start = ctx->i;
+        if (c == '"') {
+            if (!BpJsonParseString(ctx, &str, &n)) return;
+        } else if (c == '{' || c == '[') {
+            depth++;
+            ctx->i++;
+        } else if ((c == '}' || c == ']') && depth > 0) {
+            depth--;
+            ctx->i++;
+        } else if ((c == ',' || c == ':') && depth > 0) {
+            ctx->i++;
+        } else {
+            while (ctx->i < ctx->n && BpJsonParseIsLiteral(ctx->s[ctx->i]))
+                ctx->i++;
+        }
+        if (ctx->i == start) {
+            BpJsonParseFail(ctx);
+            return;
+        }
+    } while (depth > 0);
 }
+
+// BpJsonParseEnd checks that nothing but whitespaces is left after the parsed
+// value, a null byte ends the json string as well. Returns the error code of
+// the parsing, 0 for success.
+BP_API int BpJsonParseEnd(struct BpJsonParseContext *ctx) {
+    if (ctx->err == 0 && BpJsonParsePeek(ctx) != '\0') BpJsonParseFail(ctx);
+    return ctx->err;
+}
+
+#endif  // BP_NO_JSON
+
+#endif  // __BITPROTO_LIB_C__
@@ -8,8 +8,14 @@
 #ifndef __BITPROTO_LIB_H__
 #define __BITPROTO_LIB_H__ 1
 
+// recvmmsg and sendmmsg are GNU extensions of the C library, see BpRecvFrames.
+// Defined ahead of the system headers, for BITPROTO_INLINE includes bitproto.c
+// at the end of this header, too late to define it there.
+#if defined(BP_MMSG) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE 1
+#endif
+
 #include <inttypes.h>
-#include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -28,6 +34,44 @@ extern "C" {
 // Macros
 ////////////////////
 
+// BP_BIG_ENDIAN is 1 on big-endian hosts, e.g. PowerPC and MIPS, where the
+// integers in structs are byte-swapped to and from the little-endian encoding.
+// Define it to 0 or 1 to override the detection.
+#ifndef BP_BIG_ENDIAN
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__) || \
+    defined(__BIG_ENDIAN__)
+#define BP_BIG_ENDIAN 1
+#else
+#define BP_BIG_ENDIAN 0
+#endif
+#endif
+
+// BITPROTO_INLINE builds the library header-only, if defined before including
+// this header (or by -DBITPROTO_INLINE). The functions are static inline then,
+// and bitproto.c is included at the end of this header instead of compiled on
+// its own, so that the compiler specializes them for the constant widths the
+// generated code passes, e.g. BpEncodeBaseType(3, ...), without LTO. For C
+// only, the declarations are kept external in C++.
+#if defined(BITPROTO_INLINE) && !defined(__cplusplus)
+#define BP_API static inline
+#else
+#define BP_API
+#endif
+
+// BP_RESTRICT qualifies the pointers of a function that never alias each other,
+// e.g. the struct and the buffer of an encoder, so the compiler keeps the bytes
+// loaded from one in registers across the stores to the other. Define it empty
+// (-DBP_RESTRICT=) to compare, or for compilers without restrict.
+#ifndef BP_RESTRICT
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define BP_RESTRICT restrict
+#elif defined(__GNUC__) || defined(_MSC_VER)
+#define BP_RESTRICT __restrict
+#else
+#define BP_RESTRICT
+#endif
+#endif
+
 // BpType Flags.
 
 #define BP_TYPE_BOOL 1
@@ -38,43 +82,254 @@ extern "C" {
 #define BP_TYPE_ALIAS 6
 #define BP_TYPE_ARRAY 7
 #define BP_TYPE_MESSAGE 8
+#define BP_TYPE_RANGE 9
+#define BP_TYPE_FLOAT 10
+#define BP_TYPE_FIXED 11
+
+// Error codes.
+
+// The input buffer is shorter than the message to decode.
+#define BP_ERR_SHORT_INPUT -1
+// The checksum of the input buffer mismatches, see option c.checksum.
+#define BP_ERR_CHECKSUM -2
+
+// The input frame is malformed, see option c.framing.
+#define BP_ERR_FRAMING -3
+
+// The log container is malformed, or not indexed to seek.
+#define BP_ERR_LOG -4
+
+// The binary schema is malformed, or the arena to load it is too small, or the
+// input buffer is not laid out as the schema, see BpDynLoad.
+#define BP_ERR_SCHEMA -5
+
+// The json string to parse is malformed, or a value is out of the range of its
+// field, see ParseJsonXXX.
+#define BP_ERR_JSON -6
+
+// A decoded enum holds a value not declared, see option c.validate_enums.
+#define BP_ERR_ENUM -7
+
+// The frame ring is full to encode into, or empty to decode from, or its number
+// of slots is not a power of 2, see BpRingInit.
+#define BP_ERR_RING -8
+
+// The tag of a oneof selects no variant declared, see EncodeXXX and DecodeXXX of
+// oneofs.
+#define BP_ERR_TAG -9
+
+// The decoded count of a bounded array exceeds its capacity.
+#define BP_ERR_COUNT -10
+
+// A recvmmsg or sendmmsg of a batch of datagrams fails, see errno and
+// BpRecvFrames.
+#define BP_ERR_MMSG -11
+
+// An encoder or decoder disagrees with a test vector, see BpSelfTestXXX of option
+// self_test.
+#define BP_ERR_SELF_TEST -12
+
+// Number of bytes of the header of a log container, and of each frame in it.
+#define BP_LOG_HEADER_LENGTH 16
+#define BP_LOG_FRAME_HEADER_LENGTH 4
+
+// Number of bytes to reserve before n bytes to frame in place by COBS and SLIP,
+// the encoded frame starts at the beginning of the reserved bytes.
+#define BP_COBS_OVERHEAD(n) (1 + (n) / 254)
+#define BP_SLIP_OVERHEAD(n) (n)
+
+// BP_HASH_MIX mixes the 64 bits word w into the hash h, by the generated HashXXX
+// functions, starting from BP_HASH_INIT. BP_FIXED_WORD rounds a scaled
+// fixed-point value r half away from zero, the same as it's encoded. The same
+// to the optimization mode's.
+#ifndef BP_HASH_MIX
+#define BP_HASH_MIX(h, w) \
+    ((h) = ((h) ^ (uint64_t)(w)) * 0x9e3779b97f4a7c15ULL, (h) ^= (h) >> 32)
+#define BP_HASH_INIT 0xcbf29ce484222325ULL
+#define BP_FIXED_WORD(r)                \
+    ((r) >= 0  ? (uint64_t)((r) + 0.5) \
+     : (r) < 0 ? (uint64_t)(int64_t)((r) - 0.5) \
+               : 0)
+#endif
+
+// Initial values of the checksums.
+#define BP_CRC8_INIT 0x00
+#define BP_CRC16_INIT 0xffff
+#define BP_CRC32_INIT 0x00000000
 
 // Context Constructors.
+// The buffer s may be const on decoding, it's only read then.
 #define BpProcessorContext(is_encode, s) \
-    ((struct BpProcessorContext){(is_encode), 0, (s)})
+    ((struct BpProcessorContext){(is_encode), 0, (unsigned char *)(s), -1, 0})
+#define BpProcessorContextN(is_encode, s, n) \
+    ((struct BpProcessorContext){(is_encode), 0, (unsigned char *)(s), (n), 0})
 #define BpJsonFormatContext(s) \
-    (struct BpJsonFormatContext) { 0, (s) }
+    ((struct BpJsonFormatContext){0, (s), -1, NULL, NULL, 0})
+#define BpJsonFormatContextN(s, cap) \
+    ((struct BpJsonFormatContext){0, (s), (cap), NULL, NULL, 0})
+#define BpJsonFormatContextSink(s, cap, sink, arg) \
+    ((struct BpJsonFormatContext){0, (s), (cap), (sink), (arg), 0})
+#define BpJsonParseContext(s, n) ((struct BpJsonParseContext){(s), (n), 0, 0})
+
+// Json formatting is compiled out if BP_NO_JSON is defined, e.g. -DBP_NO_JSON,
+// together with the json formatters and field names in descriptors, to save
+// flash on targets not formatting json. Generated code respects it as well.
+#ifndef BP_NO_JSON
+#define BP_JSON_FORMATTER(formatter) (formatter),
+#else
+#define BP_JSON_FORMATTER(formatter)
+#endif
+
+// Instrumentation hooks called by the generated EncodeXXX and DecodeXXX
+// functions at the beginning and the end, with the message name as a string
+// literal, the direction BP_TRACE_ENCODE or BP_TRACE_DECODE, and the number of
+// bytes of the message. They expand to nothing by default. To bind them, e.g.
+// to cycle counters, perf events or tracing spans, define them in a header
+// named by BP_TRACE_HEADER, e.g. -DBP_TRACE_HEADER='"mytrace.h"'. Variables
+// declared by BP_TRACE_BEGIN are visible to BP_TRACE_END.
+#define BP_TRACE_ENCODE 0
+#define BP_TRACE_DECODE 1
+
+#ifdef BP_TRACE_HEADER
+#include BP_TRACE_HEADER
+#endif
+
+// BP_TRACE_STATS binds the hooks to the reference implementation, which
+// aggregates the number of calls, bytes and clock ticks by message name and
+// direction into BpTraceStats, a table of BP_TRACE_STATS entries, e.g.
+// -DBP_TRACE_STATS=32. The clock is BP_TRACE_CLOCK(), the time stamp counter on
+// x86 by default, and no ticks on other architectures, for example, define it
+// to DWT->CYCCNT on Cortex-M. Not thread safe. With BITPROTO_INLINE, bitproto.c
+// is still to compile for the table.
+#if defined(BP_TRACE_STATS) && !defined(BP_TRACE_BEGIN)
+#ifndef BP_TRACE_CLOCK
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BP_TRACE_CLOCK() __builtin_ia32_rdtsc()
+#else
+#define BP_TRACE_CLOCK() 0
+#endif
+#endif
+#define BP_TRACE_BEGIN(name, dir, nbytes) \
+    uint64_t bp_trace_start = (uint64_t)BP_TRACE_CLOCK()
+#define BP_TRACE_END(name, dir, nbytes) \
+    BpTraceRecord((name), (dir), (nbytes), BP_TRACE_CLOCK() - bp_trace_start)
+#endif
+
+#ifndef BP_TRACE_BEGIN
+#define BP_TRACE_BEGIN(name, dir, nbytes)
+#endif
+#ifndef BP_TRACE_END
+#define BP_TRACE_END(name, dir, nbytes)
+#endif
+
+// Bound of the stack in bytes the generated EncodeXXX, DecodeXXX and DecodeXXXN
+// functions take with option c.bounded_stack, which run copy plans by flat loops
+// without recursion, at any depth of nesting, see BP_STACK_USAGE_XXX. The default
+// covers the largest call chain measured by gcc -fcallgraph-info=su on x86-64
+// from -O0 to -O3, 408 bytes, and 32-bit targets take less. Define it to the
+// number reported for the target, e.g. by stacksize.py of the STM32 benchmark.
+// Bound trace hooks are not counted.
+#ifndef BP_STACK_USAGE_BOUND
+#define BP_STACK_USAGE_BOUND 512
+#endif
+
+// Parallel batches are compiled in if BP_PARALLEL is defined, e.g.
+// -DBP_PARALLEL -pthread, together with the generated XXXBatchParallel
+// functions. Shards are run by POSIX threads, or by OpenMP if built with it,
+// e.g. -fopenmp. Each thread takes at least BP_PARALLEL_MIN_RECORDS records.
+#ifdef BP_PARALLEL
+#ifndef BP_PARALLEL_MIN_RECORDS
+#define BP_PARALLEL_MIN_RECORDS 1024
+#endif
+#ifndef BP_PARALLEL_MAX_THREADS
+#define BP_PARALLEL_MAX_THREADS 64
+#endif
+#endif
+
+// Frame rings are compiled in if BP_RING is defined, for C11 with atomics,
+// together with the generated EncodeXXXInto and DecodeXXXFrom functions. The
+// producer's and the consumer's positions sit on cache lines of their own, of
+// BP_CACHE_LINE bytes, e.g. define it to 128 on Apple M1.
+#if defined(BP_RING) && !defined(__cplusplus)
+#include <stdatomic.h>
+#ifndef BP_CACHE_LINE
+#define BP_CACHE_LINE 64
+#endif
+#endif
+
+// Batches of datagrams are compiled in if BP_MMSG is defined, on Linux, together
+// with the generated RecvXXXBatch and SendXXXBatch functions. A recvmmsg or
+// sendmmsg takes at most BP_MMSG_MAX datagrams at a time, of which the headers
+// are on the stack. With BITPROTO_INLINE, include this header (or the generated
+// one) ahead of any system header, which then see _GNU_SOURCE defined above.
+#if defined(BP_MMSG) && !defined(BP_MMSG_MAX)
+#define BP_MMSG_MAX 64
+#endif
 
 // BpType Constructors.
-#define BpBool() ((struct BpType){BP_TYPE_BOOL, 1, sizeof(bool), NULL, NULL, 0})
+// Types and descriptors are constructed as static const initializers, so that
+// generated descriptors are built at compile time and could live in flash.
+#define BpBool() \
+    {BP_TYPE_BOOL, 1, sizeof(bool), NULL, BP_JSON_FORMATTER(NULL) 0}
 #define BpUint(nbits, size) \
-    ((struct BpType){BP_TYPE_UINT, (nbits), (size), NULL, NULL, 0})
+    {BP_TYPE_UINT, (nbits), (size), NULL, BP_JSON_FORMATTER(NULL) 0}
 #define BpInt(nbits, size) \
-    ((struct BpType){BP_TYPE_INT, (nbits), (size), NULL, NULL, 0})
+    {BP_TYPE_INT, (nbits), (size), NULL, BP_JSON_FORMATTER(NULL) 0}
 #define BpByte() \
-    ((struct BpType){BP_TYPE_BYTE, 8, sizeof(unsigned char), NULL, NULL, 0})
-#define BpMessage(nbits, size, processor, formatter)                \
-    ((struct BpType){BP_TYPE_MESSAGE, (nbits), (size), (processor), \
-                     (formatter), 0})
+    {BP_TYPE_BYTE, 8, sizeof(unsigned char), NULL, BP_JSON_FORMATTER(NULL) 0}
+#define BpMessage(nbits, size, processor, formatter) \
+    {BP_TYPE_MESSAGE, (nbits), (size), (processor), \
+     BP_JSON_FORMATTER(formatter) 0}
 #define BpEnum(nbits, size) \
-    ((struct BpType){BP_TYPE_ENUM, (nbits), (size), NULL, NULL, 0})
-#define BpArray(nbits, size, processor, formatter)                             \
-    ((struct BpType){BP_TYPE_ARRAY, (nbits), (size), (processor), (formatter), \
-                     0})
-#define BpAlias(nbits, size, processor, formatter, to_flag)                    \
-    ((struct BpType){BP_TYPE_ALIAS, (nbits), (size), (processor), (formatter), \
-                     (to_flag)})
+    {BP_TYPE_ENUM, (nbits), (size), NULL, BP_JSON_FORMATTER(NULL) 0}
+// An enum of which the values decoded are checked by given validator, see
+// option c.validate_enums.
+#define BpValidatedEnum(nbits, size, validator) \
+    {BP_TYPE_ENUM, (nbits), (size), (validator), BP_JSON_FORMATTER(NULL) 0}
+#define BpArray(nbits, size, processor, formatter) \
+    {BP_TYPE_ARRAY, (nbits), (size), (processor), \
+     BP_JSON_FORMATTER(formatter) 0}
+#define BpAlias(nbits, size, processor, formatter, to_flag) \
+    {BP_TYPE_ALIAS, (nbits), (size), (processor), \
+     BP_JSON_FORMATTER(formatter) (to_flag)}
+// A message field of option range, an integer of size bytes in C, encoded as
+// its value minus the lower bound in nbits by given processor. The to_flag is
+// BP_TYPE_UINT or BP_TYPE_INT, the type declared.
+#define BpRange(nbits, size, processor, to_flag) \
+    {BP_TYPE_RANGE, (nbits), (size), (processor), \
+     BP_JSON_FORMATTER(NULL) (to_flag)}
+// A float32, encoded as its 32 bits the same as an uint32.
+#define BpFloat() \
+    {BP_TYPE_FLOAT, 32, sizeof(float), NULL, BP_JSON_FORMATTER(NULL) 0}
+// A fixed-point number, a float or a double of size bytes in C, encoded in
+// nbits by given processor, see BpEndecodeFixed.
+#define BpFixed(nbits, size, processor) \
+    {BP_TYPE_FIXED, (nbits), (size), (processor), BP_JSON_FORMATTER(NULL) 0}
 
 // Descriptors
 
 #define BpMessageDescriptor(extensible, nfields, nbits, field_descriptors) \
-    ((struct BpMessageDescriptor){(extensible), (nfields), (nbits),        \
-                                  (field_descriptors)})
-#define BpMessageFieldDescriptor(data, type, name) \
-    ((struct BpMessageFieldDescriptor){(data), (type), (name)})
+    {(extensible), (nfields), (nbits), (field_descriptors)}
+// The field name must be a string literal, the json key is quoted and
+// suffixed with a colon via literal concatenation at compile time.
+#ifndef BP_NO_JSON
+#define BpMessageFieldDescriptor(offset, type, name) \
+    {(offset), type, "\"" name "\":", (int)sizeof("\"" name "\":") - 1}
+#else
+#define BpMessageFieldDescriptor(offset, type, name) {(offset), type}
+#endif
 #define BpArrayDescriptor(extensible, cap, element_type) \
-    ((struct BpArrayDescriptor){(extensible), (cap), (element_type)})
-#define BpAliasDescriptor(to) ((struct BpAliasDescriptor){(to)})
+    {(extensible), (cap), element_type, 0, 0}
+// A bounded array, of which the data is a struct of the count of elements in
+// use in an uint16_t, and the elements at offset.
+#define BpBoundedArrayDescriptor(cap, element_type, count_nbits, offset) \
+    {false, (cap), element_type, (count_nbits), (offset)}
+#define BpAliasDescriptor(to) {to}
+#define BpPlanOp(offset, i, nbits, count, size, sign) \
+    {(offset), (i), (nbits), (count), (size), (sign)}
+#define BpAheadCheck(i, value) {(i), (value)}
+#define BpPlanDecoder(ops, n, nbits, data) \
+    ((struct BpPlanDecoder){(ops), (n), (nbits), (data), 0, 0, 0, 0})
 
 ////////////////////
 // Data Abstractions
@@ -91,18 +346,78 @@ struct BpProcessorContext {
     // Bytes buffer processing. It's the destination buffer under encoding
     // context, and source buffer under decoding context.
     unsigned char *s;
+    // Number of bytes in buffer s, for bounds checking on decoding.
+    // Bits out of the buffer won't be read, but still counted by i.
+    // Sets to -1 to disable the checking.
+    int n;
+    // Error code, BP_ERR_ENUM once a decoded enum holds a value not declared,
+    // BP_ERR_COUNT once a decoded count of a bounded array exceeds its
+    // capacity, 0 otherwise. Decoding continues after an error.
+    int err;
 };
 
+// BpSink function consumes the n bytes at s produced by the encoders and json
+// formatters in chunks, e.g. writes them to an UART FIFO. The arg is passed
+// through from the context.
+typedef void (*BpSink)(const unsigned char *s, int n, void *arg);
+
+// BpTxStart starts an asynchronous transmission of the n bytes at s, e.g. by
+// HAL_UART_Transmit_DMA, and BpTxComplete is then called on its completion.
+typedef void (*BpTxStart)(const unsigned char *s, int n, void *arg);
+
+// BpBatchFunction encodes or decodes count records at ms to or from buffer s,
+// e.g. generated EncodeXXXBatch and DecodeXXXBatch, adapted to void pointers.
+typedef int (*BpBatchFunction)(void *ms, size_t count, unsigned char *s);
+
 // BpJsonFormatContext is the context to format bitproto messages.
 struct BpJsonFormatContext {
     // Number of bytes formatted.
+    // Bytes out of the buffer won't be written, but still counted by n.
     int n;
     // Target buffer to format into.
     char *s;
+    // Number of bytes in buffer s, including the trailing null byte.
+    // Sets to -1 to disable the checking.
+    int cap;
+    // Optional sink to flush the formatted bytes through, every time buffer s
+    // of cap bytes is full, and at the end. No trailing null byte is written.
+    BpSink sink;
+    // The argument passed to the sink.
+    void *arg;
+    // Number of bytes in buffer s not flushed yet, if sink is set.
+    int w;
 };
 
-// BpProcessor function first constructs its own descriptor, and then continues
-// the encoding and decoding processing with given context.
+// BpJsonParseContext is the context to parse json into bitproto messages.
+struct BpJsonParseContext {
+    // Json string to parse, not required to be null-terminated.
+    const char *s;
+    // Number of bytes in s.
+    int n;
+    // Index of the next byte to parse.
+    int i;
+    // Error code, BP_ERR_JSON once the parsing fails, 0 otherwise. Parsing
+    // functions do nothing after an error.
+    int err;
+};
+
+// BpFieldLayout locates a field in the encoded buffer of a message, generated
+// tables BP_FIELDS_XXX initialize arrays of it, for parsers reading fields in
+// place. Also defined by headers generated in optimization mode.
+#ifndef BP_FIELD_LAYOUT
+#define BP_FIELD_LAYOUT 1
+struct BpFieldLayout {
+    // Field path from the message, names joined by dots, e.g. "pose.yaw".
+    const char *name;
+    // Bit offset of the field in the encoded buffer.
+    int offset;
+    // Number of bits the field occupies.
+    int nbits;
+};
+#endif
+
+// BpProcessor function continues the encoding and decoding processing with its
+// own static descriptor and given context.
 // BpProcessor functions will be generated by bitproto compiler.
 typedef void (*BpProcessor)(void *data, struct BpProcessorContext *ctx);
 
@@ -119,15 +434,19 @@ struct BpType {
     int size;
 
     // Processor function for this type.
-    // Sets if this type is message, enum, alias or array, otherwise NULL.
+    // Sets if this type is message, alias, array, range or fixed-point,
+    // otherwise NULL. For an enum, it's the validator called after decoding,
+    // or NULL.
     BpProcessor processor;
 
+#ifndef BP_NO_JSON
     // JsonFormatter function for this type.
     // Sets if this type is message, enum, alias or array, otherwise NULL.
     BpJsonFormatter json_formatter;
+#endif
 
-    // The type flag behind if this type is an alias, a lookahead for
-    // performance purpose. For non-alias bp type it's zero.
+    // The type flag behind if this type is an alias or a range, a lookahead
+    // for performance purpose. For other bp types it's zero.
     int to_flag;
 };
 
@@ -145,17 +464,27 @@ struct BpArrayDescriptor {
     int cap;
     // The array element's type.
     struct BpType element_type;
+    // Number of bits of the count ahead of the elements in use if this array is
+    // bounded, 0 otherwise.
+    int count_nbits;
+    // Offset of the elements if this array is bounded, in the struct holding
+    // the count and the elements, 0 otherwise.
+    size_t offset;
 };
 
 // BpMessageFieldDescriptor describes a message field.
 struct BpMessageFieldDescriptor {
-    // The address of this field's data.
-    void *data;
+    // The offset of this field's data in the message struct, aka offsetof.
+    size_t offset;
     // Type of this field.
     struct BpType type;
-    // Name of this field.
+#ifndef BP_NO_JSON
+    // Json key of this field, the quoted name followed by a colon.
     // Required for json formatter.
-    char *name;
+    const char *key;
+    // Length of the key, excluding the trailing null byte.
+    int key_len;
+#endif
 };
 
 // BpMessageDescriptor describes a message.
@@ -167,60 +496,469 @@ struct BpMessageDescriptor {
     // Number of bits this message occupy.
     int nbits;
     // List of descriptors of the message fields.
-    struct BpMessageFieldDescriptor *field_descriptors;
+    const struct BpMessageFieldDescriptor *field_descriptors;
 };
 
+// BpPlanOp is an op of a copy plan, generated with option c.copy_plans for
+// messages, in the layout of current version for ones not in fixed size. It
+// copies count elements, one after another, between the struct members at
+// offset and the buffer at the ith bit.
+struct BpPlanOp {
+    // The offset of the first element in the message struct, aka offsetof.
+    uint16_t offset;
+    // The index of the bit where the first element starts in the buffer.
+    uint16_t i;
+    // Number of bits each element occupies in the buffer.
+    uint16_t nbits;
+    // Number of elements, 1 for a member not in an array.
+    uint16_t count;
+    // Number of bytes each element occupies in the struct.
+    uint8_t size;
+    // Whether the elements are signed integers to extend the sign bit after
+    // decoding.
+    uint8_t sign;
+};
+
+// BpAheadCheck is an ahead flag in the layout of current version of a message
+// not in fixed size, generated with option c.copy_plans. The copy plan of such
+// a message decodes a buffer only if all ahead flags in it match.
+struct BpAheadCheck {
+    // The index of the bit where the ahead flag starts in the buffer.
+    uint16_t i;
+    // The ahead flag of current version.
+    uint16_t value;
+};
+
+// BpPlanDecoder is the context to decode a message incrementally by its copy
+// plan, from chunks of the buffer fed one after another, e.g. as they arrive from
+// a serial link. Fields are decoded as soon as their bits are fed, no buffer is
+// required to reassemble the chunks.
+struct BpPlanDecoder {
+    // The ops of the copy plan, and the number of them.
+    const struct BpPlanOp *ops;
+    int n;
+    // Number of bits the message occupies in the buffer.
+    int nbits;
+    // The message struct to decode into.
+    void *data;
+    // The index of current op, and the index of current element in the op.
+    int k;
+    int e;
+    // Number of bits of current element decoded.
+    int d;
+    // Number of bits fed.
+    int i;
+};
+
+// BpLogFrame is a frame of a log container, pointing into the container without
+// copying.
+struct BpLogFrame {
+    // The message type tag given by the writer.
+    uint16_t tag;
+    // Number of bytes of the encoded message.
+    uint16_t n;
+    // The encoded message.
+    const unsigned char *s;
+    // The offset of the frame in the container.
+    size_t offset;
+};
+
+// BpLogReader is the context to iterate or seek the frames of a log container
+// in memory, e.g. a memory-mapped log file. A log container is laid out as:
+// * A header: "BPLG", version 1, flags, 2 reserved bytes, and a 64 bits schema
+//   fingerprint given by the writer.
+// * Frames: a 16 bits tag, a 16 bits length, and then the encoded message.
+// * An optional index: the 64 bits offsets of the frames, followed by the 64
+//   bits number of them, and "BPIX".
+// All integers are in little-endian.
+struct BpLogReader {
+    // The container and the number of bytes of it.
+    const unsigned char *s;
+    size_t n;
+    // The schema fingerprint given by the writer.
+    uint64_t fingerprint;
+    // Where the frames end, the index starts.
+    size_t end;
+    // Number of frames indexed, 0 if not indexed.
+    size_t count;
+    // The offset of the next frame to iterate.
+    size_t i;
+};
+
+// BpTxBuffers double-buffers encoded frames for an asynchronous transmitter,
+// e.g. an UART with DMA, so that the next frame is encoded into one buffer
+// while the other is transmitting. Frames are sent in the order committed. It's
+// safe without locks between one producer, e.g. the main loop, and the
+// completion interrupt calling BpTxComplete, on a single core.
+struct BpTxBuffers {
+    // The two buffers, each holds a frame.
+    unsigned char *s[2];
+    // Number of bytes of the frame in each buffer, 0 if the buffer is free.
+    volatile int n[2];
+    // The buffer being transmitted, -1 if the transmitter is idle.
+    volatile int sending;
+    // The buffer to encode the next frame into.
+    int next;
+    // The function to start a transmission, and its argument.
+    BpTxStart start;
+    void *arg;
+};
+
+#if defined(BP_RING) && !defined(__cplusplus)
+// BpRing is a lock-free ring of fixed-size slots passing encoded frames from
+// one producer thread to one consumer thread, e.g. a decoding thread and a
+// publishing thread, without copying: the producer encodes straight into a slot
+// and the consumer decodes or sends from it in place. Positions count the slots
+// ever committed and released, each written by one side only, and the other
+// side's one is cached to touch the shared cache line only when the ring looks
+// full or empty.
+struct BpRing {
+    // Position of the next slot to commit, written by the producer.
+    _Alignas(BP_CACHE_LINE) atomic_size_t head;
+    // The consumer's position last seen by the producer.
+    size_t tail_cached;
+    // Position of the next slot to release, written by the consumer.
+    _Alignas(BP_CACHE_LINE) atomic_size_t tail;
+    // The producer's position last seen by the consumer.
+    size_t head_cached;
+    // The slots, of size bytes each, and the number of them minus 1.
+    _Alignas(BP_CACHE_LINE) unsigned char *s;
+    size_t size;
+    size_t mask;
+};
+#endif
+
+// BpDynOp is an op of the flat copy plan of a message loaded from a binary
+// schema. It copies count elements, one after another, between the slots of a
+// field table and the buffer at the ith bit.
+struct BpDynOp {
+    // The index of the bit where the first element starts in the buffer.
+    uint32_t i;
+    // The slot of the first element in the field table, or the value of the
+    // ahead flag for an op of BP_DYN_OP_AHEAD.
+    uint16_t slot;
+    // Number of elements, 1 for a field not in an array.
+    uint16_t count;
+    // Number of bits each element occupies in the buffer.
+    uint8_t nbits;
+    // One of BP_DYN_OP_UINT, BP_DYN_OP_INT and BP_DYN_OP_AHEAD.
+    uint8_t kind;
+};
+
+#define BP_DYN_OP_UINT 0
+#define BP_DYN_OP_INT 1
+#define BP_DYN_OP_AHEAD 2
+
+// BpDynField is a field of a message loaded from a binary schema, flattened by
+// its path, e.g. "position.latitude" or "propellers[1].id". An array of single
+// types is a field of cap slots.
+struct BpDynField {
+    // The path of this field, null terminated.
+    const char *name;
+    // The slot of the first element in the field table, and number of them.
+    uint16_t slot;
+    uint16_t count;
+    // The BP_TYPE_XXX flag and the number of bits of the elements.
+    uint8_t flag;
+    uint8_t nbits;
+};
+
+// BpDynMessage is a message loaded from a binary schema. Values of its fields
+// are held in a field table of nslots uint64_t slots, a signed integer is in
+// two's complement, e.g. (int64_t)values[slot].
+struct BpDynMessage {
+    // The qualified name, null terminated, e.g. "Drone" or "Drone.Network".
+    const char *name;
+    // The fingerprint of the layout, see FINGERPRINT_XXX of generated headers.
+    uint64_t fingerprint;
+    // Number of bits and bytes this message occupies in the buffer.
+    int nbits;
+    int nbytes;
+    // Number of slots of the field table.
+    int nslots;
+    // The flat copy plan, compiled at loading.
+    const struct BpDynOp *ops;
+    int nops;
+    // The fields flattened.
+    const struct BpDynField *fields;
+    int nfields;
+};
+
+// BpDynSchema is a binary schema loaded by BpDynLoad, of which messages could
+// be encoded and decoded without generated code.
+struct BpDynSchema {
+    const struct BpDynMessage *messages;
+    int nmessages;
+};
+
+#ifdef BP_TRACE_STATS
+// BpTraceStat is an entry of BpTraceStats, of which the arrays are indexed by
+// direction BP_TRACE_ENCODE and BP_TRACE_DECODE.
+struct BpTraceStat {
+    // The message name, NULL if the entry is not used yet.
+    const char *name;
+    uint32_t count[2];
+    uint64_t bytes[2];
+    uint64_t ticks[2];
+};
+
+extern struct BpTraceStat BpTraceStats[BP_TRACE_STATS];
+#endif
+
 ////////////////
 // Declarations
 ////////////////
 
 // Encoding & Decoding
 
-void BpCopyBufferBits(int nbits, unsigned char *dst, unsigned char *src,
-                      int dst_bit_index, int src_bit_index);
-void BpHandleIntSignAfterEndecode(int size, int nbits,
-                                  struct BpProcessorContext *ctx, void *data);
-void BpEndecodeBaseType(int nbits, struct BpProcessorContext *ctx, void *data);
-void BpEndecodeInt(int nbits, int size, struct BpProcessorContext *ctx,
-                   void *data);
-void BpEndecodeMessageField(struct BpMessageFieldDescriptor *descriptor,
+BP_API void BpCopyBufferBits(int nbits, unsigned char *BP_RESTRICT dst,
+                             const unsigned char *BP_RESTRICT src,
+                             int dst_bit_index, int src_bit_index);
+BP_API void BpHandleIntSignAfterEndecode(int size, int nbits,
+                                         struct BpProcessorContext *ctx,
+                                         void *data);
+BP_API void BpHandleIntArraySignAfterEndecode(int size, int nbits, int cap,
+                                              struct BpProcessorContext *ctx,
+                                              void *data);
+BP_API void BpEndecodeBaseType(int nbits, struct BpProcessorContext *ctx,
+                               void *data);
+BP_API void BpEncodePadding(struct BpProcessorContext *ctx);
+BP_API void BpEndecodeInt(int nbits, int size, struct BpProcessorContext *ctx,
+                          void *data);
+BP_API void BpEndecodeUint(int size, int nbits, struct BpProcessorContext *ctx,
+                           void *data);
+BP_API void BpEndecodeRange(int size, int nbits, uint64_t lo,
+                            struct BpProcessorContext *ctx, void *data);
+BP_API void BpEndecodeFixed(int size, int nbits, bool is_signed, double unit,
+                            struct BpProcessorContext *ctx, void *data);
+BP_API void BpEndecodeMessageField(
+    const struct BpMessageFieldDescriptor *descriptor,
+    struct BpProcessorContext *ctx, void *data);
+BP_API void BpEndecodeMessage(const struct BpMessageDescriptor *descriptor,
+                              struct BpProcessorContext *ctx, void *data);
+BP_API void BpEndecodeAlias(const struct BpAliasDescriptor *descriptor,
                             struct BpProcessorContext *ctx, void *data);
-void BpEndecodeMessage(struct BpMessageDescriptor *descriptor,
-                       struct BpProcessorContext *ctx, void *data);
-void BpEndecodeAlias(struct BpAliasDescriptor *descriptor,
-                     struct BpProcessorContext *ctx, void *data);
-void BpEndecodeArray(struct BpArrayDescriptor *descriptor,
-                     struct BpProcessorContext *ctx, void *data);
+BP_API void BpEndecodeArray(const struct BpArrayDescriptor *descriptor,
+                            struct BpProcessorContext *ctx, void *data);
+BP_API void BpEndecodeMessageArray(const struct BpMessageDescriptor *descriptor,
+                                   int cap, int size,
+                                   struct BpProcessorContext *ctx, void *data);
+
+// Encoding & Decoding in a single direction, called by the processors generated
+// with option c.split_processors, free of the branch on ctx->is_encode.
+
+BP_API void BpEncodeBaseType(int nbits, struct BpProcessorContext *ctx,
+                             void *data);
+BP_API void BpEncodeIntegers(int size, int nbits, int cap,
+                             struct BpProcessorContext *ctx, void *data);
+BP_API void BpDecodeBaseType(int nbits, struct BpProcessorContext *ctx,
+                             void *data);
+BP_API void BpDecodeInt(int size, int nbits, struct BpProcessorContext *ctx,
+                        void *data);
+BP_API void BpDecodeUint(int size, int nbits, struct BpProcessorContext *ctx,
+                         void *data);
+BP_API void BpEncodeRange(int size, int nbits, uint64_t lo,
+                          struct BpProcessorContext *ctx, void *data);
+BP_API void BpDecodeRange(int size, int nbits, uint64_t lo,
+                          struct BpProcessorContext *ctx, void *data);
+BP_API void BpEncodeFixed(int size, int nbits, bool is_signed, double unit,
+                          struct BpProcessorContext *ctx, void *data);
+BP_API void BpDecodeFixed(int size, int nbits, bool is_signed, double unit,
+                          struct BpProcessorContext *ctx, void *data);
+BP_API void BpDecodeUintArray(int size, int nbits, int cap,
+                              struct BpProcessorContext *ctx, void *data);
+BP_API void BpDecodeIntArray(int size, int nbits, int cap,
+                             struct BpProcessorContext *ctx, void *data);
+BP_API void BpHandleIntArraySignAfterDecode(int size, int nbits, int cap,
+                                            void *data);
+BP_API void BpClearArrayHighBitsAfterDecode(int size, int nbits, int cap,
+                                            void *data);
+BP_API void BpEncodeAhead(uint16_t ahead, struct BpProcessorContext *ctx);
+BP_API uint16_t BpDecodeAhead(struct BpProcessorContext *ctx);
+BP_API int BpEncodeArrayCount(int cap, int nbits,
+                              struct BpProcessorContext *ctx,
+                              const void *data);
+BP_API int BpDecodeArrayCount(int cap, int nbits,
+                              struct BpProcessorContext *ctx, void *data);
+
+// Delta Encoding, called by the functions generated with option c.delta.
+
+BP_API int BpEncodeMessageDelta(const struct BpMessageDescriptor *descriptor,
+                                void *prev, void *cur, unsigned char *s);
+BP_API int BpDecodeMessageDelta(const struct BpMessageDescriptor *descriptor,
+                                void *data, unsigned char *s, int n);
+
+// Copy Plans, interpreted without the processors and descriptors.
+
+BP_API void BpEncodePlan(const struct BpPlanOp *ops, int n, int nbits,
+                         void *data, unsigned char *s);
+BP_API void BpDecodePlan(const struct BpPlanOp *ops, int n, void *data,
+                         const unsigned char *s);
+BP_API void BpDecodePlanBatch(const struct BpPlanOp *ops, int n, void *data,
+                              size_t size, const unsigned char *s, int nbytes,
+                              size_t count);
+BP_API void BpEncodePlanSink(const struct BpPlanOp *ops, int n, int nbits,
+                             void *data, unsigned char *s, int cap, BpSink sink,
+                             void *arg);
+BP_API int BpDecodePlanChunk(struct BpPlanDecoder *ctx, const unsigned char *s,
+                             int n);
+BP_API bool BpPlanDecoderDone(const struct BpPlanDecoder *ctx);
+BP_API bool BpMatchAheads(const struct BpAheadCheck *checks, int n,
+                          const unsigned char *s);
+
+// Parallel Batches, called by the functions generated if BP_PARALLEL is
+// defined.
+
+#ifdef BP_PARALLEL
+BP_API int BpParallelBatch(BpBatchFunction f, void *ms, size_t size,
+                           unsigned char *s, size_t nbytes, size_t count,
+                           int nthreads);
+#endif
+
+// Checksums, called by the functions generated with option c.checksum.
+
+BP_API uint8_t BpCrc8(uint8_t crc, const unsigned char *s, size_t n);
+BP_API uint16_t BpCrc16(uint16_t crc, const unsigned char *s, size_t n);
+BP_API uint32_t BpCrc32(uint32_t crc, const unsigned char *s, size_t n);
+BP_API void BpEncodeCrc8(unsigned char *s, size_t n);
+BP_API void BpEncodeCrc16(unsigned char *s, size_t n);
+BP_API void BpEncodeCrc32(unsigned char *s, size_t n);
+BP_API bool BpVerifyCrc8(const unsigned char *s, size_t n);
+BP_API bool BpVerifyCrc16(const unsigned char *s, size_t n);
+BP_API bool BpVerifyCrc32(const unsigned char *s, size_t n);
+
+// Framing, called by the functions generated with option c.framing.
+
+BP_API int BpCobsEncode(unsigned char *s, int n);
+BP_API int BpCobsDecode(unsigned char *s, int n);
+BP_API int BpSlipEncode(unsigned char *s, int n);
+BP_API int BpSlipDecode(unsigned char *s, int n);
+
+// Log Containers.
+
+BP_API size_t BpLogWriteHeader(unsigned char *s, uint64_t fingerprint);
+BP_API size_t BpLogWriteFrameHeader(unsigned char *s, uint16_t tag, uint16_t n);
+BP_API size_t BpLogWriteIndex(unsigned char *s, const uint64_t *offsets,
+                              size_t count);
+BP_API int BpLogOpen(struct BpLogReader *r, const unsigned char *s, size_t n);
+BP_API int BpLogNext(struct BpLogReader *r, struct BpLogFrame *frame);
+BP_API int BpLogSeek(struct BpLogReader *r, size_t k, struct BpLogFrame *frame);
+
+// Double-Buffered Transmission.
+
+BP_API void BpTxInit(struct BpTxBuffers *tx, unsigned char *a, unsigned char *b,
+                     BpTxStart start, void *arg);
+BP_API unsigned char *BpTxAcquire(struct BpTxBuffers *tx);
+BP_API void BpTxCommit(struct BpTxBuffers *tx, int n);
+BP_API void BpTxComplete(struct BpTxBuffers *tx);
+BP_API bool BpTxIdle(const struct BpTxBuffers *tx);
+
+// Frame Rings, between one producer thread and one consumer thread, compiled in
+// if BP_RING is defined.
+
+#if defined(BP_RING) && !defined(__cplusplus)
+BP_API int BpRingInit(struct BpRing *r, unsigned char *s, size_t size,
+                      size_t n);
+BP_API unsigned char *BpRingAcquire(struct BpRing *r);
+BP_API void BpRingCommit(struct BpRing *r);
+BP_API const unsigned char *BpRingPeek(struct BpRing *r);
+BP_API void BpRingRelease(struct BpRing *r);
+#endif
+
+// Batches of Datagrams, by a single recvmmsg or sendmmsg each, compiled in if
+// BP_MMSG is defined.
+
+#ifdef BP_MMSG
+BP_API int BpRecvFrames(int fd, unsigned char *s, size_t size, size_t n,
+                        int flags);
+BP_API int BpSendFrames(int fd, const unsigned char *s, size_t size, size_t n,
+                        int flags);
+#endif
+
+// Dynamic Codec, driven by a binary schema written by `bitproto -S`.
+
+BP_API int BpDynLoad(struct BpDynSchema *schema, const unsigned char *s,
+                     size_t n, void *arena, size_t cap);
+BP_API const struct BpDynMessage *BpDynFindMessage(
+    const struct BpDynSchema *schema, const char *name);
+BP_API const struct BpDynMessage *BpDynFindMessageByFingerprint(
+    const struct BpDynSchema *schema, uint64_t fingerprint);
+BP_API const struct BpDynField *BpDynFindField(const struct BpDynMessage *m,
+                                               const char *name);
+BP_API int BpDynEncode(const struct BpDynMessage *m, const uint64_t *values,
+                       unsigned char *s);
+BP_API int BpDynDecode(const struct BpDynMessage *m, uint64_t *values,
+                       const unsigned char *s, int n);
+
+#ifdef BP_TRACE_STATS
+// Instrumentation.
+
+void BpTraceRecord(const char *name, int dir, int nbytes, uint64_t ticks);
+#endif
 
 // Extensible Processor.
 
-void BpEncodeArrayExtensibleAhead(struct BpArrayDescriptor *descriptor,
-                                  struct BpProcessorContext *ctx);
-uint16_t BpDecodeArrayExtensibleAhead(struct BpArrayDescriptor *descriptor,
-                                      struct BpProcessorContext *ctx);
+BP_API void BpEncodeArrayExtensibleAhead(
+    const struct BpArrayDescriptor *descriptor, struct BpProcessorContext *ctx);
+BP_API uint16_t BpDecodeArrayExtensibleAhead(
+    const struct BpArrayDescriptor *descriptor, struct BpProcessorContext *ctx);
 
-void BpEncodeMessageExtensibleAhead(struct BpMessageDescriptor *descriptor,
-                                    struct BpProcessorContext *ctx);
-uint16_t BpDecodeMessageExtensibleAhead(struct BpMessageDescriptor *descriptor,
-                                        struct BpProcessorContext *ctx);
+BP_API void BpEncodeMessageExtensibleAhead(
+    const struct BpMessageDescriptor *descriptor,
+    struct BpProcessorContext *ctx);
+BP_API uint16_t BpDecodeMessageExtensibleAhead(
+    const struct BpMessageDescriptor *descriptor,
+    struct BpProcessorContext *ctx);
 
 // Json Formatting
 
-void BpJsonFormatString(struct BpJsonFormatContext *ctx, const char *format,
-                        ...);
-void BpJsonFormatMessage(struct BpMessageDescriptor *descriptor,
-                         struct BpJsonFormatContext *ctx, void *data);
-void BpJsonFormatBaseType(int flag, int nbits, struct BpJsonFormatContext *ctx,
-                          void *data);
-void BpJsonFormatAlias(struct BpAliasDescriptor *descriptor,
-                       struct BpJsonFormatContext *ctx, void *data);
-void BpJsonFormatMessageField(struct BpMessageFieldDescriptor *descriptor,
-                              struct BpJsonFormatContext *ctx);
-void BpJsonFormatArray(struct BpArrayDescriptor *descriptor,
-                       struct BpJsonFormatContext *ctx, void *data);
+#ifndef BP_NO_JSON
+BP_API void BpJsonFormatChar(struct BpJsonFormatContext *ctx, char c);
+BP_API void BpJsonFormatBytes(struct BpJsonFormatContext *ctx, const char *str,
+                              int n);
+BP_API void BpJsonFormatUint(struct BpJsonFormatContext *ctx, uint64_t v);
+BP_API void BpJsonFormatInt(struct BpJsonFormatContext *ctx, int64_t v);
+BP_API void BpJsonFormatEnd(struct BpJsonFormatContext *ctx);
+BP_API void BpJsonFormatMessage(const struct BpMessageDescriptor *descriptor,
+                                struct BpJsonFormatContext *ctx, void *data);
+BP_API void BpJsonFormatBaseType(int flag, int nbits,
+                                 struct BpJsonFormatContext *ctx, void *data);
+BP_API void BpJsonFormatAlias(const struct BpAliasDescriptor *descriptor,
+                              struct BpJsonFormatContext *ctx, void *data);
+BP_API void BpJsonFormatMessageField(
+    const struct BpMessageFieldDescriptor *descriptor,
+    struct BpJsonFormatContext *ctx, void *data);
+BP_API void BpJsonFormatArray(const struct BpArrayDescriptor *descriptor,
+                              struct BpJsonFormatContext *ctx, void *data);
+BP_API void BpJsonFormatHex(struct BpJsonFormatContext *ctx,
+                            const unsigned char *data, int n);
+BP_API void BpJsonFormatBase64(struct BpJsonFormatContext *ctx,
+                               const unsigned char *data, int n);
+#endif
+
+// Json Parsing
+
+#ifndef BP_NO_JSON
+BP_API bool BpJsonParseNextKey(struct BpJsonParseContext *ctx, int k,
+                               const char **key, int *n);
+BP_API bool BpJsonParseNextElement(struct BpJsonParseContext *ctx, int k,
+                                   int cap);
+BP_API void BpJsonParseBaseType(int flag, int nbits,
+                                struct BpJsonParseContext *ctx, void *data);
+BP_API int BpJsonParseHex(struct BpJsonParseContext *ctx, unsigned char *data,
+                          int cap);
+BP_API int BpJsonParseBase64(struct BpJsonParseContext *ctx,
+                             unsigned char *data, int cap);
+BP_API void BpJsonParseSkip(struct BpJsonParseContext *ctx);
+BP_API int BpJsonParseEnd(struct BpJsonParseContext *ctx);
+#endif
 
 #if defined(__cplusplus)
 }
 #endif
 
+#if defined(BITPROTO_INLINE) && !defined(__cplusplus)
+#include "bitproto.c"
+#endif
+
 #endif
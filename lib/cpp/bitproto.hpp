@@ -0,0 +1,269 @@
+// Copyright (c) 2021~2023, hit9. https://github.com/hit9/bitproto
+// Header-only encoding library for bitproto in C++17.
+//
+// Keep it simple:
+// * Header only, no dynamic memory allocation, no virtual calls.
+// * Layouts are known at compile time, encoding and decoding are expanded by
+//   templates into straight-line shifts, interoperable with the C library.
+// * Works on the structs generated for C, generated Codec specializations are
+//   in the file *_bp.hpp.
+
+#ifndef __BITPROTO_LIB_HPP__
+#define __BITPROTO_LIB_HPP__ 1
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace bitproto {
+
+// The input buffer is shorter than the message to decode.
+// The same to the C library's BP_ERR_SHORT_INPUT.
+constexpr int kErrShortInput = -1;
+
+// Codec is specialized by generated code for each message in fixed size, with:
+// * kNbits, kNbytes: The number of bits and bytes the message occupies.
+// * EncodeAt<I>(m, s): Encodes message m into buffer s at the Ith bit.
+// * DecodeAt<I>(m, s): Decodes message m from buffer s at the Ith bit.
+template <typename T>
+struct Codec;
+
+// Bits returns the number of bits a value of type T occupies, where N is the
+// number of bits of the single type inside, if T is an array of it or itself.
+template <typename T, int N>
+constexpr int Bits() {
+    if constexpr (std::is_array_v<T>) {
+        return static_cast<int>(std::extent_v<T>) *
+               Bits<std::remove_extent_t<T>, N>();
+    } else if constexpr (std::is_class_v<T>) {
+        return Codec<T>::kNbits;
+    } else {
+        return N;
+    }
+}
+
+// EncodeBits encodes the lower N bits of v into buffer s at the Ith bit.
+// The bits are or-ed into s, which should be zeroed.
+template <int I, int N, typename T>
+inline void EncodeBits(unsigned char *s, T v) {
+    static_assert(N > 0 && N <= 64, "bitproto: nbits out of range");
+    constexpr int b = I / 8, o = I % 8, nb = (o + N + 7) / 8;
+    uint64_t u = static_cast<uint64_t>(v);
+    if constexpr (N < 64) u &= (static_cast<uint64_t>(1) << N) - 1;
+    s[b] |= static_cast<unsigned char>(u << o);
+    for (int k = 1; k < nb; k++)
+        s[b + k] |= static_cast<unsigned char>(u >> (8 * k - o));
+}
+
+// DecodeBits decodes N bits from buffer s at the Ith bit as a value of type T.
+// Signed integers are sign extended.
+template <int I, int N, typename T>
+inline T DecodeBits(const unsigned char *s) {
+    static_assert(N > 0 && N <= 64, "bitproto: nbits out of range");
+    constexpr int b = I / 8, o = I % 8, nb = (o + N + 7) / 8;
+    uint64_t u = static_cast<uint64_t>(s[b]) >> o;
+    for (int k = 1; k < nb; k++)
+        u |= static_cast<uint64_t>(s[b + k]) << (8 * k - o);
+    if constexpr (N < 64) u &= (static_cast<uint64_t>(1) << N) - 1;
+
+    if constexpr (std::is_same_v<T, bool>) {
+        return u != 0;
+    } else if constexpr (std::is_signed_v<T>) {
+        if constexpr (N < 64) {
+            constexpr uint64_t m = static_cast<uint64_t>(1) << (N - 1);
+            u = (u ^ m) - m;
+        }
+        return static_cast<T>(static_cast<int64_t>(u));
+    } else {
+        return static_cast<T>(u);
+    }
+}
+
+template <int I, int N, typename T>
+inline void EncodeValue(unsigned char *s, const T &v);
+
+template <int I, int N, typename T>
+inline void DecodeValue(const unsigned char *s, T &v);
+
+// EncodeArray encodes the elements of array a one after another.
+template <int I, int N, typename T, std::size_t... K>
+inline void EncodeArray(unsigned char *s, const T &a,
+                        std::index_sequence<K...>) {
+    constexpr int stride = Bits<std::remove_extent_t<T>, N>();
+    (EncodeValue<I + static_cast<int>(K) * stride, N>(s, a[K]), ...);
+}
+
+// DecodeArray decodes the elements of array a one after another.
+template <int I, int N, typename T, std::size_t... K>
+inline void DecodeArray(const unsigned char *s, T &a,
+                        std::index_sequence<K...>) {
+    constexpr int stride = Bits<std::remove_extent_t<T>, N>();
+    (DecodeValue<I + static_cast<int>(K) * stride, N>(s, a[K]), ...);
+}
+
+// EncodeValue encodes v into buffer s at the Ith bit, dispatching by its type:
+// an array, a message, or a single type in N bits.
+template <int I, int N, typename T>
+inline void EncodeValue(unsigned char *s, const T &v) {
+    if constexpr (std::is_array_v<T>) {
+        EncodeArray<I, N>(s, v, std::make_index_sequence<std::extent_v<T>>{});
+    } else if constexpr (std::is_class_v<T>) {
+        Codec<T>::template EncodeAt<I>(v, s);
+    } else {
+        EncodeBits<I, N>(s, v);
+    }
+}
+
+// DecodeValue decodes v from buffer s at the Ith bit, dispatching by its type:
+// an array, a message, or a single type in N bits.
+template <int I, int N, typename T>
+inline void DecodeValue(const unsigned char *s, T &v) {
+    if constexpr (std::is_array_v<T>) {
+        DecodeArray<I, N>(s, v, std::make_index_sequence<std::extent_v<T>>{});
+    } else if constexpr (std::is_class_v<T>) {
+        Codec<T>::template DecodeAt<I>(v, s);
+    } else {
+        v = DecodeBits<I, N, T>(s);
+    }
+}
+
+// EncodeRange encodes v of a field of option range into buffer s at the Ith
+// bit, as the offset of N bits from the lower bound Lo of the range.
+template <int I, int N, uint64_t Lo, typename T>
+inline void EncodeRange(unsigned char *s, const T &v) {
+    EncodeBits<I, N>(s, static_cast<uint64_t>(v) - Lo);
+}
+
+// DecodeRange decodes v of a field of option range from buffer s at the Ith
+// bit, by adding the lower bound Lo to the offset of N bits.
+template <int I, int N, uint64_t Lo, typename T>
+inline void DecodeRange(const unsigned char *s, T &v) {
+    v = static_cast<T>(DecodeBits<I, N, uint64_t>(s) + Lo);
+}
+
+// Float32Real describes the bits of type float32, its IEEE 754 bits.
+struct Float32Real {
+    static constexpr int kNbits = 32;
+
+    static uint64_t Bits(double v) {
+        float f = static_cast<float>(v);
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    static double Value(uint64_t u) {
+        uint32_t w = static_cast<uint32_t>(u);
+        float f;
+        std::memcpy(&f, &w, sizeof(f));
+        return f;
+    }
+};
+
+// FixedReal describes the bits of a fixed-point type of N bits with F fractional
+// bits, the value multiplied by 2^F, rounded half away from zero.
+template <int N, int F, bool Signed>
+struct FixedReal {
+    static constexpr int kNbits = N;
+
+    static constexpr double Scale() {
+        double x = 1.0;
+        for (int k = 0; k < F; k++) x *= 2.0;
+        return x;
+    }
+
+    static uint64_t Bits(double v) {
+        double r = v * Scale();
+        if (r >= 0) return static_cast<uint64_t>(r + 0.5);
+        if (r < 0) return static_cast<uint64_t>(static_cast<int64_t>(r - 0.5));
+        return 0;  // NaN
+    }
+
+    static double Value(uint64_t u) {
+        if constexpr (Signed && N < 64) {
+            constexpr uint64_t m = static_cast<uint64_t>(1) << (N - 1);
+            return static_cast<double>(static_cast<int64_t>((u ^ m) - m)) /
+                   Scale();
+        } else if constexpr (Signed) {
+            return static_cast<double>(static_cast<int64_t>(u)) / Scale();
+        } else {
+            return static_cast<double>(u) / Scale();
+        }
+    }
+};
+
+template <int I, typename R, typename T>
+inline void EncodeReal(unsigned char *s, const T &v);
+
+template <int I, typename R, typename T>
+inline void DecodeReal(const unsigned char *s, T &v);
+
+// EncodeRealArray encodes the elements of array a of reals one after another.
+template <int I, typename R, typename T, std::size_t... K>
+inline void EncodeRealArray(unsigned char *s, const T &a,
+                            std::index_sequence<K...>) {
+    constexpr int stride = Bits<std::remove_extent_t<T>, R::kNbits>();
+    (EncodeReal<I + static_cast<int>(K) * stride, R>(s, a[K]), ...);
+}
+
+// DecodeRealArray decodes the elements of array a of reals one after another.
+template <int I, typename R, typename T, std::size_t... K>
+inline void DecodeRealArray(const unsigned char *s, T &a,
+                            std::index_sequence<K...>) {
+    constexpr int stride = Bits<std::remove_extent_t<T>, R::kNbits>();
+    (DecodeReal<I + static_cast<int>(K) * stride, R>(s, a[K]), ...);
+}
+
+// EncodeReal encodes v of type float32 or fixed-point, or an array of them, into
+// buffer s at the Ith bit, where R is Float32Real or a FixedReal.
+template <int I, typename R, typename T>
+inline void EncodeReal(unsigned char *s, const T &v) {
+    if constexpr (std::is_array_v<T>) {
+        EncodeRealArray<I, R>(s, v,
+                              std::make_index_sequence<std::extent_v<T>>{});
+    } else {
+        EncodeBits<I, R::kNbits>(s, R::Bits(static_cast<double>(v)));
+    }
+}
+
+// DecodeReal decodes v of type float32 or fixed-point, or an array of them, from
+// buffer s at the Ith bit, where R is Float32Real or a FixedReal.
+template <int I, typename R, typename T>
+inline void DecodeReal(const unsigned char *s, T &v) {
+    if constexpr (std::is_array_v<T>) {
+        DecodeRealArray<I, R>(s, v,
+                              std::make_index_sequence<std::extent_v<T>>{});
+    } else {
+        v = static_cast<T>(R::Value(DecodeBits<I, R::kNbits, uint64_t>(s)));
+    }
+}
+
+// Encode encodes message m into buffer s, which should be at least
+// Codec<T>::kNbytes long.
+template <typename T>
+inline void Encode(const T &m, unsigned char *s) {
+    std::memset(s, 0, Codec<T>::kNbytes);
+    Codec<T>::template EncodeAt<0>(m, s);
+}
+
+// Decode decodes message m from buffer s, which should be at least
+// Codec<T>::kNbytes long.
+template <typename T>
+inline void Decode(T &m, const unsigned char *s) {
+    Codec<T>::template DecodeAt<0>(m, s);
+}
+
+// Decode decodes message m from buffer s of n bytes. Returns 0 on success, or
+// kErrShortInput if n is less than Codec<T>::kNbytes, m is left untouched.
+template <typename T>
+inline int Decode(T &m, const unsigned char *s, std::size_t n) {
+    if (n < static_cast<std::size_t>(Codec<T>::kNbytes)) return kErrShortInput;
+    Codec<T>::template DecodeAt<0>(m, s);
+    return 0;
+}
+
+}  // namespace bitproto
+
+#endif  // __BITPROTO_LIB_HPP__
@@ -5,13 +5,128 @@
 // Keep it simple:
 //   - Pure golang.
 //   - No reflection.
-//   - No type assertion.
+//   - No type assertion in encoding and decoding.
 //   - No dynamic function construction.
 package bitproto
 
+import (
+	"encoding/binary"
+	"errors"
+	"io"
+	"math"
+	"runtime"
+	"strconv"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
 // Exported for generated go files to reference to avoid bp imported but not used error.
 var Useless = false
 
+// ErrShortInput is returned if the buffer to decode is shorter than the message.
+var ErrShortInput = errors.New("bitproto: short input")
+
+// ErrBadLog is returned if a log container is malformed, or not indexed to seek.
+var ErrBadLog = errors.New("bitproto: bad log")
+
+// ErrRingFull and ErrRingEmpty are returned if a FrameRing has no slot to encode
+// into, or no frame to decode from.
+var (
+	ErrRingFull  = errors.New("bitproto: ring full")
+	ErrRingEmpty = errors.New("bitproto: ring empty")
+)
+
+// ErrUnknownTag is returned if the tag of a oneof selects no variant declared.
+var ErrUnknownTag = errors.New("bitproto: unknown tag")
+
+// ErrCount is returned if the count decoded of a bounded array exceeds its
+// capacity, the elements decoded are capped at the capacity.
+var ErrCount = errors.New("bitproto: count exceeds capacity")
+
+// ErrSelfTest is returned by the generated BpSelfTestXXX functions if an encoder
+// or decoder disagrees with a test vector, see option self_test.
+var ErrSelfTest = errors.New("bitproto: self test failed")
+
+// Tracer is the optional instrumentation hook called by generated Encode,
+// Decode, EncodeTo and DecodeFrom methods in standard mode, set by SetTracer.
+type Tracer interface {
+	// Begin is called before a message of nbytes bytes is encoded or decoded,
+	// the returned span is passed to End after.
+	Begin(name string, isEncode bool, nbytes int) TraceSpan
+	End(span TraceSpan)
+}
+
+// TraceSpan is an encoding or decoding span, started by Tracer.Begin.
+type TraceSpan struct {
+	Name     string
+	IsEncode bool
+	Nbytes   int
+	// Set by the tracer, e.g. a timestamp.
+	Start int64
+}
+
+var tracer Tracer
+
+// SetTracer sets the tracer of encoding and decoding, nil to disable. It's not
+// synchronized with encoding and decoding, set it before, e.g. in init.
+func SetTracer(t Tracer) { tracer = t }
+
+// GetTracer returns the tracer set, or nil.
+func GetTracer() Tracer { return tracer }
+
+// TraceStat is the aggregated calls, bytes and nanoseconds of encoding or
+// decoding a message.
+type TraceStat struct {
+	Count int64
+	Bytes int64
+	Nanos int64
+}
+
+// TraceStats is a reference Tracer, aggregating TraceStat by message name and
+// direction. Safe for concurrent use.
+type TraceStats struct {
+	mu    sync.Mutex
+	stats map[traceKey]*TraceStat
+}
+
+type traceKey struct {
+	name     string
+	isEncode bool
+}
+
+// NewTraceStats returns an empty TraceStats.
+func NewTraceStats() *TraceStats { return &TraceStats{stats: map[traceKey]*TraceStat{}} }
+
+func (ts *TraceStats) Begin(name string, isEncode bool, nbytes int) TraceSpan {
+	return TraceSpan{name, isEncode, nbytes, time.Now().UnixNano()}
+}
+
+func (ts *TraceStats) End(span TraceSpan) {
+	d := time.Now().UnixNano() - span.Start
+	ts.mu.Lock()
+	k := traceKey{span.Name, span.IsEncode}
+	st, ok := ts.stats[k]
+	if !ok {
+		st = &TraceStat{}
+		ts.stats[k] = st
+	}
+	st.Count++
+	st.Bytes += int64(span.Nbytes)
+	st.Nanos += d
+	ts.mu.Unlock()
+}
+
+// Get returns the aggregated stat of encoding or decoding given message.
+func (ts *TraceStats) Get(name string, isEncode bool) TraceStat {
+	ts.mu.Lock()
+	defer ts.mu.Unlock()
+	if st, ok := ts.stats[traceKey{name, isEncode}]; ok {
+		return *st
+	}
+	return TraceStat{}
+}
+
 // Flag
 type Flag = int
 
@@ -25,6 +140,9 @@ const (
 	FlagArray             = 7
 	FlagMessage           = 8
 	FlagMessageField      = 9
+	FlagRange             = 10
+	FlagFloat             = 11
+	FlagFixed             = 12
 )
 
 // ProcessContext is the context accross all processor functions in a encoding
@@ -38,20 +156,75 @@ type ProcessContext struct {
 	// When encoding, s is the destination buffer to write.
 	// When decoding, s is the source buffer to read.
 	s []byte
+	// Data indexers of the messages being processed, by nesting depth.
+	// Kept across resets, so that a reused context allocates nothing.
+	dis []*DataIndexer
+	// Nesting depth of the message being processed.
+	depth int
+	// The first error met on decoding, e.g. ErrCount.
+	err error
 }
 
 // NewEncodeContext returns a ProcessContext for encoding to given buffer s.
 func NewEncodeContext(nbytes int) *ProcessContext {
-	return &ProcessContext{true, 0, make([]byte, nbytes)}
+	return &ProcessContext{isEncode: true, s: make([]byte, nbytes)}
 }
 
 // NewDecodeContext returns a ProcessContext for decoding from given buffer s.
 func NewDecodeContext(s []byte) *ProcessContext {
-	return &ProcessContext{false, 0, s}
+	return &ProcessContext{isEncode: false, s: s}
 }
 
 func (ctx *ProcessContext) Buffer() []byte { return ctx.s }
 
+// NumBytes returns the number of bytes processed so far, the last one may be
+// partial.
+func (ctx *ProcessContext) NumBytes() int { return (ctx.i + 7) >> 3 }
+
+// Err returns the first error met on decoding, nil if there's none.
+func (ctx *ProcessContext) Err() error { return ctx.err }
+
+// Reset rewinds the context for a new encoding or decoding process on given
+// buffer s. The buffer is zeroed on encoding, since bits are or-ed into it.
+func (ctx *ProcessContext) Reset(isEncode bool, s []byte) {
+	ctx.isEncode = isEncode
+	ctx.i = 0
+	ctx.s = s
+	ctx.depth = 0
+	ctx.err = nil
+	if isEncode {
+		for k := range s {
+			s[k] = 0
+		}
+	}
+}
+
+// indexer returns the data indexer for the fields of the message at current
+// depth, it's created at the first time and reused after.
+func (ctx *ProcessContext) indexer() *DataIndexer {
+	if ctx.depth == len(ctx.dis) {
+		ctx.dis = append(ctx.dis, NewDataIndexer(0))
+	}
+	return ctx.dis[ctx.depth]
+}
+
+var contextPool = sync.Pool{New: func() interface{} { return &ProcessContext{} }}
+
+// AcquireProcessContext returns a reset ProcessContext from a pool, for
+// encoding or decoding on given buffer s. Release it after use.
+func AcquireProcessContext(isEncode bool, s []byte) *ProcessContext {
+	ctx := contextPool.Get().(*ProcessContext)
+	ctx.Reset(isEncode, s)
+	return ctx
+}
+
+// ReleaseProcessContext puts given ctx back to the pool.
+// The buffer is dropped, the context must not be used after.
+func ReleaseProcessContext(ctx *ProcessContext) {
+	ctx.s = nil
+	contextPool.Put(ctx)
+}
+
 // Processor is the abstraction type that able to process encoding and
 // decoding.
 type Processor interface {
@@ -85,8 +258,15 @@ type Accessor interface {
 	// This function works only if target data is a message.
 	BpGetAccessor(di *DataIndexer) Accessor
 
-	// BpProcessInt processes the signed integers right after bite coping is done.
+	// BpProcessInt processes the signed integers right after bite coping is done,
+	// and adds the lower bound to integers of option range.
 	BpProcessInt(di *DataIndexer)
+
+	// BpProcessArray processes the array of byte or standard-width integers
+	// indexed by di in a batch, by passing its backing slice to one of the
+	// ProcessBytes, ProcessUint16s, ProcessInt32s, etc.
+	// Returns false if the indexed data is not such an array.
+	BpProcessArray(ctx *ProcessContext, di *DataIndexer) bool
 }
 
 // Uint8Accessor implements Accessor for uint8 value encoding and decoding.
@@ -108,6 +288,9 @@ func (m *Uint8Accessor) BpGetByte(di *DataIndexer, rshift int) byte {
 }
 func (m *Uint8Accessor) BpGetAccessor(di *DataIndexer) Accessor { return nil }
 func (m *Uint8Accessor) BpProcessInt(di *DataIndexer)           { return }
+func (m *Uint8Accessor) BpProcessArray(ctx *ProcessContext, di *DataIndexer) bool {
+	return false
+}
 
 // Uint16Accessor implements Accessor for uint16 value encoding and decoding.
 type Uint16Accessor struct{ data uint16 }
@@ -128,6 +311,9 @@ func (m *Uint16Accessor) BpGetByte(di *DataIndexer, rshift int) byte {
 }
 func (m *Uint16Accessor) BpGetAccessor(di *DataIndexer) Accessor { return nil }
 func (m *Uint16Accessor) BpProcessInt(di *DataIndexer)           { return }
+func (m *Uint16Accessor) BpProcessArray(ctx *ProcessContext, di *DataIndexer) bool {
+	return false
+}
 
 // DataIndexer contains the argument to index data from current accessor.
 type DataIndexer struct {
@@ -143,6 +329,13 @@ func (di *DataIndexer) IndexStackUp()         { di.aistack = append(di.aistack,
 func (di *DataIndexer) IndexStackDown()       { di.aistack = di.aistack[0 : len(di.aistack)-1] }
 func (di *DataIndexer) IndexReplace(k int)    { di.aistack[len(di.aistack)-1] = k }
 
+// Reset rewrites the field number and empties the array index stack, keeping
+// its capacity for reuse.
+func (di *DataIndexer) Reset(fnumber int) {
+	di.fnumber = fnumber
+	di.aistack = di.aistack[:0]
+}
+
 // Bool implements Processor for bool type.
 type Bool struct{}
 
@@ -177,6 +370,77 @@ func (t *Uint) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor)
 	processBaseType(t.nbits, ctx, di, accessor)
 }
 
+// Range implements Processor for integer fields of option range, which are
+// encoded as the offset from the lower bound of the range in nbits.
+// The generated accessor subtracts the lower bound in BpGetByte, and adds it
+// back in BpProcessInt after decoding.
+type Range struct{ nbits int }
+
+func NewRange(nbits int) *Range { return &Range{nbits} }
+func (t *Range) Flag() Flag     { return FlagRange }
+func (t *Range) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor) {
+	processBaseType(t.nbits, ctx, di, accessor)
+
+	// Add the lower bound back.
+	if ctx.isEncode {
+		return
+	}
+	accessor.BpProcessInt(di)
+}
+
+// Float32 implements Processor for float32 type, which is encoded as its IEEE
+// 754 bits. The generated accessor gets and sets the bytes of the bits.
+type Float32 struct{}
+
+func NewFloat32() *Float32    { return &Float32{} }
+func (t *Float32) Flag() Flag { return FlagFloat }
+func (t *Float32) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor) {
+	processBaseType(32, ctx, di, accessor)
+}
+
+// Fixed implements Processor for fixed-point types, which are encoded as the
+// value multiplied by 2^frac in nbits, see FixedBits.
+// The generated accessor gets the bytes of FixedBits in BpGetByte, collects the
+// decoded bits in the bits of the value, and converts them by FixedValue in
+// BpProcessInt after decoding.
+type Fixed struct{ nbits int }
+
+func NewFixed(nbits int) *Fixed { return &Fixed{nbits} }
+func (t *Fixed) Flag() Flag     { return FlagFixed }
+func (t *Fixed) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor) {
+	processBaseType(t.nbits, ctx, di, accessor)
+
+	// Convert the bits to the value.
+	if ctx.isEncode {
+		return
+	}
+	accessor.BpProcessInt(di)
+}
+
+// FixedBits returns the bits of fixed-point value v, that's v multiplied by
+// scale 2^frac, rounded half away from zero. NaN is encoded as 0.
+func FixedBits(v, scale float64) uint64 {
+	r := v * scale
+	if r >= 0 {
+		return uint64(r + 0.5)
+	}
+	if r < 0 {
+		return uint64(int64(r - 0.5))
+	}
+	return 0
+}
+
+// FixedValue returns the fixed-point value of the lower nbits of w, multiplied
+// by unit 2^-frac, sign-extended if signed.
+func FixedValue(w uint64, nbits int, signed bool, unit float64) float64 {
+	w &= ^uint64(0) >> (64 - nbits)
+	if signed {
+		m := uint64(1) << (nbits - 1)
+		return float64(int64((w^m)-m)) * unit
+	}
+	return float64(w) * unit
+}
+
 // Byte implements Processor for byte type.
 type Byte struct{}
 
@@ -191,11 +455,14 @@ type Array struct {
 	extensible       bool
 	capacity         int
 	elementProcessor Processor
+	// Indicates whether the elements are byte or standard-width integers,
+	// which are processed in a batch by the accessor's BpProcessArray.
+	bulk bool
 }
 
 func NewArray(extensible bool, capacity int, elementProcessor Processor) *Array {
 	return &Array{
-		extensible, capacity, elementProcessor,
+		extensible, capacity, elementProcessor, isBulkElement(elementProcessor),
 	}
 }
 func (t *Array) Flag() Flag { return FlagArray }
@@ -219,11 +486,13 @@ func (t *Array) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor)
 		}
 	}
 
-	// Process array elements.
-	for k := 0; k < t.capacity; k++ {
-		// Rewrite indexer's array index tracker.
-		di.IndexReplace(k)
-		t.elementProcessor.Process(ctx, di, accessor)
+	// Process array elements, in a batch if possible.
+	if !(t.bulk && accessor.BpProcessArray(ctx, di)) {
+		for k := 0; k < t.capacity; k++ {
+			// Rewrite indexer's array index tracker.
+			di.IndexReplace(k)
+			t.elementProcessor.Process(ctx, di, accessor)
+		}
 	}
 
 	// Skip redundant bits post decoding.
@@ -241,19 +510,108 @@ func (t *Array) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor)
 func (t *Array) EncodeExtensibleAhead(ctx *ProcessContext) {
 	// Safe to cast:
 	// the capacity of an array always <= 65535.
-	data := uint16(t.capacity)
-	accessor := &Uint16Accessor{data}
-	di := NewDataIndexer(1)
-	processBaseType(16, ctx, di, accessor)
+	encodeUint16(ctx, uint16(t.capacity))
 }
 
 // DecodeExtensibleAhead decode the ahead flag as the array capacity from
 // current decoding stream.
 func (t *Array) DecodeExtensibleAhead(ctx *ProcessContext) uint16 {
-	accessor := &Uint16Accessor{}
-	di := NewDataIndexer(1)
-	processBaseType(16, ctx, di, accessor)
-	return accessor.data
+	return decodeUint16(ctx)
+}
+
+// BoundedAccessor is implemented by the accessors of messages with bounded
+// arrays, the elements of which are held in slices.
+type BoundedAccessor interface {
+	// BpGetLen returns the length of the slice of the bounded array indexed by
+	// di, called on encoding.
+	BpGetLen(di *DataIndexer) int
+
+	// BpSetLen resizes the slice of the bounded array indexed by di to n zero
+	// elements, called on decoding.
+	BpSetLen(di *DataIndexer, n int)
+}
+
+// BoundedArray implements Processor for bounded arrays, encoded as a count of
+// countNbits bits followed by the elements in use only.
+type BoundedArray struct {
+	capacity         int
+	countNbits       int
+	elementProcessor Processor
+	bulk             bool
+}
+
+func NewBoundedArray(capacity, countNbits int, elementProcessor Processor) *BoundedArray {
+	return &BoundedArray{
+		capacity, countNbits, elementProcessor, isBulkElement(elementProcessor),
+	}
+}
+func (t *BoundedArray) Flag() Flag { return FlagArray }
+
+func (t *BoundedArray) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor) {
+	b := accessor.(BoundedAccessor)
+	n := 0
+	if ctx.isEncode {
+		n = b.BpGetLen(di)
+	}
+	n = ProcessCount(ctx, n, t.capacity, t.countNbits)
+	if !ctx.isEncode {
+		b.BpSetLen(di, n)
+	}
+
+	di.IndexStackUp()
+	defer di.IndexStackDown()
+
+	// The accessor's BpProcessArray works on the elements in use, by the length of
+	// the slice.
+	if !(t.bulk && accessor.BpProcessArray(ctx, di)) {
+		for k := 0; k < n; k++ {
+			di.IndexReplace(k)
+			t.elementProcessor.Process(ctx, di, accessor)
+		}
+	}
+}
+
+// ProcessCount encodes or decodes the count of a bounded array of given capacity
+// in nbits, and returns the number of elements to process. On encoding, n is the
+// length of the slice, and it's capped at the capacity. On decoding, a count
+// exceeding the capacity is capped, and ErrCount is recorded to ctx.
+func ProcessCount(ctx *ProcessContext, n, capacity, nbits int) int {
+	if ctx.isEncode {
+		n = BoundedLen(n, capacity)
+		encodeBits(ctx, uint64(n), nbits)
+		return n
+	}
+	n = int(decodeBits(ctx, nbits) & (1<<uint(nbits) - 1))
+	if n > capacity {
+		n = capacity
+		if ctx.err == nil {
+			ctx.err = ErrCount
+		}
+	}
+	return n
+}
+
+// BoundedLen returns the number of elements of a bounded array of given capacity
+// held in a slice of length n to encode, the elements beyond the capacity are
+// dropped.
+func BoundedLen(n, capacity int) int {
+	if n > capacity {
+		return capacity
+	}
+	return n
+}
+
+// RecoverShortInput recovers from the out of range panic of decoding a message
+// with bounded arrays from a buffer ending before the elements in use, and sets
+// *err to ErrShortInput. It's deferred by the generated DecodeFrom methods, since
+// the size of such messages isn't known ahead.
+func RecoverShortInput(err *error) {
+	if r := recover(); r != nil {
+		if _, ok := r.(runtime.Error); !ok {
+			panic(r)
+		}
+		*err = ErrShortInput
+	}
 }
 
 // EnumProcessor implements Processor for enum.
@@ -297,10 +655,14 @@ func NewMessageFieldProcessor(fieldNumber int, typeProcessor Processor) *Message
 
 func (t *MessageFieldProcessor) Flag() Flag { return FlagMessageField }
 
-func (t *MessageFieldProcessor) Process(ctx *ProcessContext, _ *DataIndexer, accessor Accessor) {
-	// Ignore data indexer passed in, because accessor is rewrite.
-	// Rewrite data indexer's fieldNumber.
-	di := NewDataIndexer(t.fieldNumber)
+func (t *MessageFieldProcessor) Process(ctx *ProcessContext, di *DataIndexer, accessor Accessor) {
+	// The data indexer passed in is owned by the message, rewrite its
+	// fieldNumber, because accessor is rewrite.
+	if di == nil {
+		di = NewDataIndexer(t.fieldNumber)
+	} else {
+		di.Reset(t.fieldNumber)
+	}
 	t.typeProcessor.Process(ctx, di, accessor)
 }
 
@@ -310,10 +672,16 @@ type MessageProcessor struct {
 	extensible       bool
 	nbits            int
 	fieldDescriptors []*MessageFieldProcessor
+	// Number of bits of each field, -1 if it's not in fixed size, for DecodeMasked.
+	fieldNbits []int
 }
 
 func NewMessageProcessor(extensible bool, nbits int, fieldDescriptors []*MessageFieldProcessor) *MessageProcessor {
-	return &MessageProcessor{extensible, nbits, fieldDescriptors}
+	fieldNbits := make([]int, len(fieldDescriptors))
+	for k, fieldDescriptor := range fieldDescriptors {
+		fieldNbits[k] = fixedNbits(fieldDescriptor.typeProcessor)
+	}
+	return &MessageProcessor{extensible, nbits, fieldDescriptors, fieldNbits}
 }
 
 func (t *MessageProcessor) Flag() Flag { return FlagMessage }
@@ -340,10 +708,13 @@ func (t *MessageProcessor) Process(ctx *ProcessContext, di *DataIndexer, accesso
 		}
 	}
 
-	// Process fields.
+	// Process fields, with a data indexer reused across fields.
+	fdi := ctx.indexer()
+	ctx.depth++
 	for _, fieldDescriptor := range t.fieldDescriptors {
-		fieldDescriptor.Process(ctx, di, accessor)
+		fieldDescriptor.Process(ctx, fdi, accessor)
 	}
+	ctx.depth--
 
 	// Skip redundant bits post decoding.
 	if t.extensible && !ctx.isEncode {
@@ -355,24 +726,111 @@ func (t *MessageProcessor) Process(ctx *ProcessContext, di *DataIndexer, accesso
 	}
 }
 
+// DecodeMasked decodes the fields of the message selected by mask into given
+// accessor, the kth bit for the kth field, as the top-level message. Others are
+// skipped by their number of bits, without touching the accessor, except the
+// fields not in fixed size, which are decoded always, since where the next field
+// begins is known only then.
+func (t *MessageProcessor) DecodeMasked(ctx *ProcessContext, accessor Accessor, mask uint64) {
+	if t.extensible {
+		// Fields are decoded in the layout of current version, the same as
+		// Process, no bits after are read.
+		ctx.i += 16
+	}
+	fdi := ctx.indexer()
+	ctx.depth++
+	for k, fieldDescriptor := range t.fieldDescriptors {
+		if n := t.fieldNbits[k]; n >= 0 && mask&(1<<uint(k)) == 0 {
+			ctx.i += n
+			continue
+		}
+		fieldDescriptor.Process(ctx, fdi, accessor)
+	}
+	ctx.depth--
+}
+
+// fixedNbits returns the number of bits of the type given processor processes,
+// or -1 if it's not in fixed size, that's with extensible types inside.
+func fixedNbits(p Processor) int {
+	switch t := p.(type) {
+	case *Bool:
+		return 1
+	case *Byte:
+		return 8
+	case *Float32:
+		return 32
+	case *Int:
+		return t.nbits
+	case *Uint:
+		return t.nbits
+	case *Range:
+		return t.nbits
+	case *Fixed:
+		return t.nbits
+	case *EnumProcessor:
+		return t.ut.nbits
+	case *AliasProcessor:
+		return fixedNbits(t.to)
+	case *Array:
+		n := fixedNbits(t.elementProcessor)
+		if t.extensible || n < 0 {
+			return -1
+		}
+		return n * t.capacity
+	case *MessageProcessor:
+		if t.extensible {
+			return -1
+		}
+		for _, n := range t.fieldNbits {
+			if n < 0 {
+				return -1
+			}
+		}
+		return t.nbits
+	}
+	return -1
+}
+
 // EncodeExtensibleAhead encode the message number of bits as the ahead flag to
 // current bit encoding stream.
 func (t *MessageProcessor) EncodeExtensibleAhead(ctx *ProcessContext) {
 	// Safe to cast:
 	// the nbits of a message always <= 65535.
-	data := uint16(t.nbits)
-	accessor := &Uint16Accessor{data}
-	di := NewDataIndexer(1)
-	processBaseType(16, ctx, di, accessor)
+	encodeUint16(ctx, uint16(t.nbits))
 }
 
 // DecodeExtensibleAhead decode the ahead flag as the nbits of this message from
 // current decoding stream.
 func (t *MessageProcessor) DecodeExtensibleAhead(ctx *ProcessContext) uint16 {
-	accessor := &Uint16Accessor{}
-	di := NewDataIndexer(1)
-	processBaseType(16, ctx, di, accessor)
-	return accessor.data
+	return decodeUint16(ctx)
+}
+
+// encodeUint16 encodes given uint16 data to current bit encoding stream,
+// without going through an accessor.
+func encodeUint16(ctx *ProcessContext, data uint16) {
+	for j := 0; j < 16; {
+		c := getNbitsToCopy(ctx.i, j, 16)
+		b := byte(data >> (int(j/8) * 8))
+		mask := byte(getMask(ctx.i%8, c))
+		ctx.s[int(ctx.i/8)] |= smartShift(b, (j%8)-(ctx.i%8)) & mask
+		ctx.i += c
+		j += c
+	}
+}
+
+// decodeUint16 decodes an uint16 data from current decoding stream, without
+// going through an accessor.
+func decodeUint16(ctx *ProcessContext) uint16 {
+	data := uint16(0)
+	for j := 0; j < 16; {
+		c := getNbitsToCopy(ctx.i, j, 16)
+		b := ctx.s[int(ctx.i/8)]
+		mask := byte(getMask(j%8, c))
+		data |= uint16(smartShift(b, (ctx.i%8)-(j%8))&mask) << (int(j/8) * 8)
+		ctx.i += c
+		j += c
+	}
+	return data
 }
 
 // processBaseType process encoding and decoding on a base type.
@@ -434,6 +892,304 @@ func decodeSingleByte(ctx *ProcessContext, di *DataIndexer, accessor Accessor, j
 	accessor.BpSetByte(di, lshift, d)
 }
 
+// ProcessBytes processes an array of bytes in a batch.
+// Bytes on byte boundary are copied directly, others are copied 8 bytes a time.
+func ProcessBytes(ctx *ProcessContext, s []byte) {
+	if ctx.i&7 == 0 {
+		if ctx.isEncode {
+			copy(ctx.s[ctx.i>>3:], s)
+		} else {
+			copy(s, ctx.s[ctx.i>>3:])
+		}
+		ctx.i += len(s) * 8
+		return
+	}
+	k := 0
+	for ; k+8 <= len(s); k += 8 {
+		if ctx.isEncode {
+			encodeBits(ctx, binary.LittleEndian.Uint64(s[k:]), 64)
+		} else {
+			binary.LittleEndian.PutUint64(s[k:], decodeBits(ctx, 64))
+		}
+	}
+	for ; k < len(s); k++ {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(s[k]), 8)
+		} else {
+			s[k] = byte(decodeBits(ctx, 8))
+		}
+	}
+}
+
+// ProcessByteSlice processes a byte array of capacity n held in a slice, for
+// fields generated with option go.zero_copy_bytes.
+// On decoding, the slice aliases buffer s if the array starts on a byte boundary,
+// without any copy, otherwise it's a new copy. On encoding, a slice shorter than
+// n is padded with zeros, and a longer one is truncated.
+func ProcessByteSlice(ctx *ProcessContext, p *[]byte, n int) {
+	if ctx.isEncode {
+		s := *p
+		if len(s) > n {
+			s = s[:n]
+		}
+		ProcessBytes(ctx, s)
+		ctx.i += (n - len(s)) * 8
+		return
+	}
+	if ctx.i&7 == 0 {
+		k := ctx.i >> 3
+		*p = ctx.s[k : k+n : k+n]
+		ctx.i += n * 8
+		return
+	}
+	*p = make([]byte, n)
+	ProcessBytes(ctx, *p)
+}
+
+// HashByteSlice mixes a byte array of capacity n held in a slice into the hash h,
+// for fields generated with option go.zero_copy_bytes. Missing bytes are hashed
+// as zeros, the same as they are encoded.
+func HashByteSlice(h uint64, s []byte, n int) uint64 {
+	for k := 0; k < n; k += 8 {
+		var w uint64
+		for j := k; j < k+8 && j < n && j < len(s); j++ {
+			w |= uint64(s[j]) << (8 * uint(j-k))
+		}
+		h = (h ^ w) * 0x9e3779b97f4a7c15
+		h ^= h >> 32
+	}
+	return h
+}
+
+// EqualByteSlice reports whether the byte arrays of capacity n held in slices a
+// and b are equal, for fields generated with option go.zero_copy_bytes. Missing
+// bytes are compared as zeros, the same as they are encoded.
+func EqualByteSlice(a, b []byte, n int) bool {
+	for k := 0; k < n; k++ {
+		var x, y byte
+		if k < len(a) {
+			x = a[k]
+		}
+		if k < len(b) {
+			y = b[k]
+		}
+		if x != y {
+			return false
+		}
+	}
+	return true
+}
+
+// AppendJSONBytes appends the json format of a byte array of capacity n held in a
+// slice to b, for fields generated with option go.zero_copy_bytes. Missing bytes
+// are formatted as zeros, the same as they are encoded.
+func AppendJSONBytes(b []byte, s []byte, n int) []byte {
+	b = append(b, '[')
+	for k := 0; k < n; k++ {
+		if k > 0 {
+			b = append(b, ',')
+		}
+		if k < len(s) {
+			b = strconv.AppendUint(b, uint64(s[k]), 10)
+		} else {
+			b = append(b, '0')
+		}
+	}
+	return append(b, ']')
+}
+
+// Alphabets of the hex and base64 (RFC 4648, with padding) json strings of byte
+// arrays, see option json_bytes.
+const (
+	jsonHexDigits    = "0123456789abcdef"
+	jsonBase64Digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+)
+
+// AppendJSONHex appends a byte array of capacity n held in a slice to b, as a json
+// string of lowercase hex digits, for byte arrays with option json_bytes = "hex".
+// Missing bytes are formatted as zeros, the same as they are encoded.
+func AppendJSONHex(b []byte, s []byte, n int) []byte {
+	b = append(b, '"')
+	for k := 0; k < n; k++ {
+		var c byte
+		if k < len(s) {
+			c = s[k]
+		}
+		b = append(b, jsonHexDigits[c>>4], jsonHexDigits[c&15])
+	}
+	return append(b, '"')
+}
+
+// AppendJSONBase64 appends a byte array of capacity n held in a slice to b, as a
+// json base64 string, for byte arrays with option json_bytes = "base64".
+// Missing bytes are formatted as zeros, the same as they are encoded.
+func AppendJSONBase64(b []byte, s []byte, n int) []byte {
+	at := func(k int) uint32 {
+		if k < len(s) {
+			return uint32(s[k])
+		}
+		return 0
+	}
+	b = append(b, '"')
+	for k := 0; k < n; k += 3 {
+		m := n - k
+		v := at(k) << 16
+		if m > 1 {
+			v |= at(k+1) << 8
+		}
+		if m > 2 {
+			v |= at(k + 2)
+		}
+		b = append(b, jsonBase64Digits[v>>18&63], jsonBase64Digits[v>>12&63])
+		if m > 1 {
+			b = append(b, jsonBase64Digits[v>>6&63])
+		} else {
+			b = append(b, '=')
+		}
+		if m > 2 {
+			b = append(b, jsonBase64Digits[v&63])
+		} else {
+			b = append(b, '=')
+		}
+	}
+	return append(b, '"')
+}
+
+// ProcessInt8s processes an array of int8 in a batch.
+func ProcessInt8s(ctx *ProcessContext, s []int8) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(uint8(s[k])), 8)
+		} else {
+			s[k] = int8(decodeBits(ctx, 8))
+		}
+	}
+}
+
+// ProcessUint16s processes an array of uint16 in a batch.
+func ProcessUint16s(ctx *ProcessContext, s []uint16) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(s[k]), 16)
+		} else {
+			s[k] = uint16(decodeBits(ctx, 16))
+		}
+	}
+}
+
+// ProcessInt16s processes an array of int16 in a batch.
+func ProcessInt16s(ctx *ProcessContext, s []int16) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(uint16(s[k])), 16)
+		} else {
+			s[k] = int16(decodeBits(ctx, 16))
+		}
+	}
+}
+
+// ProcessUint32s processes an array of uint32 in a batch.
+func ProcessUint32s(ctx *ProcessContext, s []uint32) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(s[k]), 32)
+		} else {
+			s[k] = uint32(decodeBits(ctx, 32))
+		}
+	}
+}
+
+// ProcessInt32s processes an array of int32 in a batch.
+func ProcessInt32s(ctx *ProcessContext, s []int32) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(uint32(s[k])), 32)
+		} else {
+			s[k] = int32(decodeBits(ctx, 32))
+		}
+	}
+}
+
+// ProcessUint64s processes an array of uint64 in a batch.
+func ProcessUint64s(ctx *ProcessContext, s []uint64) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, s[k], 64)
+		} else {
+			s[k] = decodeBits(ctx, 64)
+		}
+	}
+}
+
+// ProcessInt64s processes an array of int64 in a batch.
+func ProcessInt64s(ctx *ProcessContext, s []int64) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(s[k]), 64)
+		} else {
+			s[k] = int64(decodeBits(ctx, 64))
+		}
+	}
+}
+
+// ProcessFloat32s processes an array of float32 in a batch.
+func ProcessFloat32s(ctx *ProcessContext, s []float32) {
+	for k := range s {
+		if ctx.isEncode {
+			encodeBits(ctx, uint64(math.Float32bits(s[k])), 32)
+		} else {
+			s[k] = math.Float32frombits(uint32(decodeBits(ctx, 32)))
+		}
+	}
+}
+
+// encodeBits encodes the lower n bits of v to the buffer at ctx.i, where n is
+// positive. Bits of v higher than n must be zero.
+func encodeBits(ctx *ProcessContext, v uint64, n int) {
+	j, o := ctx.i>>3, ctx.i&7
+	ctx.s[j] |= byte(v << o)
+	for k := 8 - o; k < n; k += 8 {
+		j++
+		ctx.s[j] |= byte(v >> k)
+	}
+	ctx.i += n
+}
+
+// decodeBits decodes n bits from the buffer at ctx.i, where n is positive.
+// Bits of the returned value higher than n are garbage, to be truncated by
+// the caller.
+func decodeBits(ctx *ProcessContext, n int) uint64 {
+	j, o := ctx.i>>3, ctx.i&7
+	v := uint64(ctx.s[j]) >> o
+	for k := 8 - o; k < n; k += 8 {
+		j++
+		v |= uint64(ctx.s[j]) << k
+	}
+	ctx.i += n
+	return v
+}
+
+// isBulkElement returns true if given array element processor is of byte,
+// standard-width integers or float32.
+func isBulkElement(p Processor) bool {
+	switch t := p.(type) {
+	case *Byte:
+		return true
+	case *Uint:
+		return isNbitsStandard(t.nbits)
+	case *Int:
+		return isNbitsStandard(t.nbits)
+	case *Float32:
+		return true
+	}
+	return false
+}
+
+// isNbitsStandard returns true if given nbits is one of 8/16/32/64.
+func isNbitsStandard(nbits int) bool {
+	return nbits == 8 || nbits == 16 || nbits == 32 || nbits == 64
+}
+
 // Returns the number of bits to copy during a single byte process.
 // Argument i, j, n:
 //
@@ -500,3 +1256,343 @@ func Byte2bool(b byte) bool {
 	}
 	return false
 }
+
+// Log containers, the same layout to the C library's BpLogReader:
+//   - A header: "BPLG", version 1, flags, 2 reserved bytes, and a 64 bits
+//     schema fingerprint.
+//   - Frames: a 16 bits tag, a 16 bits length, and then the encoded message.
+//   - An optional index: the 64 bits offsets of the frames, followed by the 64
+//     bits number of them, and "BPIX".
+//
+// All integers are in little-endian.
+const (
+	LogHeaderLength      = 16
+	LogFrameHeaderLength = 4
+)
+
+// LogWriter writes encoded messages as frames of a log container to w.
+type LogWriter struct {
+	w       io.Writer
+	indexed bool
+	offset  uint64
+	offsets []uint64
+	b       [LogHeaderLength]byte
+}
+
+// NewLogWriter writes the header of a log container with given schema
+// fingerprint to w. The index is written on Close if indexed.
+func NewLogWriter(w io.Writer, fingerprint uint64, indexed bool) (*LogWriter, error) {
+	lw := &LogWriter{w: w, indexed: indexed, offset: LogHeaderLength}
+	copy(lw.b[:], "BPLG")
+	lw.b[4] = 1
+	binary.LittleEndian.PutUint64(lw.b[8:], fingerprint)
+	if _, err := w.Write(lw.b[:]); err != nil {
+		return nil, err
+	}
+	return lw, nil
+}
+
+// WriteFrame writes an encoded message with given tag as a frame.
+func (lw *LogWriter) WriteFrame(tag uint16, s []byte) error {
+	if len(s) > 0xffff {
+		return ErrBadLog
+	}
+	binary.LittleEndian.PutUint16(lw.b[0:], tag)
+	binary.LittleEndian.PutUint16(lw.b[2:], uint16(len(s)))
+	if _, err := lw.w.Write(lw.b[:LogFrameHeaderLength]); err != nil {
+		return err
+	}
+	if _, err := lw.w.Write(s); err != nil {
+		return err
+	}
+	if lw.indexed {
+		lw.offsets = append(lw.offsets, lw.offset)
+	}
+	lw.offset += uint64(LogFrameHeaderLength + len(s))
+	return nil
+}
+
+// Close writes the index if indexed. The underlying writer is not closed.
+func (lw *LogWriter) Close() error {
+	if !lw.indexed {
+		return nil
+	}
+	s := make([]byte, 8*len(lw.offsets)+12)
+	for k, offset := range lw.offsets {
+		binary.LittleEndian.PutUint64(s[8*k:], offset)
+	}
+	binary.LittleEndian.PutUint64(s[8*len(lw.offsets):], uint64(len(lw.offsets)))
+	copy(s[len(s)-4:], "BPIX")
+	_, err := lw.w.Write(s)
+	return err
+}
+
+// LogFrame is a frame of a log container, S points into the container without
+// copying.
+type LogFrame struct {
+	Tag    uint16
+	S      []byte
+	Offset int
+}
+
+// LogReader iterates or seeks the frames of a log container in memory, e.g. a
+// memory-mapped log file by syscall.Mmap.
+type LogReader struct {
+	s           []byte
+	fingerprint uint64
+	end         int
+	count       int
+	i           int
+}
+
+// NewLogReader opens the log container s, and detects the index at the end.
+func NewLogReader(s []byte) (*LogReader, error) {
+	if len(s) < LogHeaderLength || string(s[:4]) != "BPLG" || s[4] != 1 {
+		return nil, ErrBadLog
+	}
+	r := &LogReader{s: s, end: len(s), i: LogHeaderLength}
+	r.fingerprint = binary.LittleEndian.Uint64(s[8:])
+
+	// An index is trusted if its size fits, the frames end where it starts.
+	n := len(s)
+	if n >= LogHeaderLength+12 && string(s[n-4:]) == "BPIX" {
+		count := binary.LittleEndian.Uint64(s[n-12:])
+		if count <= uint64((n-LogHeaderLength-12)/8) {
+			end := n - 12 - int(count)*8
+			last := end
+			if count > 0 {
+				last = int(binary.LittleEndian.Uint64(s[n-20:]))
+			}
+			if last >= 0 && last+LogFrameHeaderLength <= end &&
+				last+LogFrameHeaderLength+int(binary.LittleEndian.Uint16(s[last+2:])) == end {
+				r.end = end
+				r.count = int(count)
+			}
+		}
+	}
+	return r, nil
+}
+
+// Fingerprint returns the schema fingerprint given by the writer.
+func (r *LogReader) Fingerprint() uint64 { return r.fingerprint }
+
+// Len returns the number of frames indexed, 0 if not indexed.
+func (r *LogReader) Len() int { return r.count }
+
+// Next reads the next frame. Returns io.EOF at the end, or ErrBadLog if the
+// frame is truncated.
+func (r *LogReader) Next() (LogFrame, error) {
+	if r.i >= r.end {
+		return LogFrame{}, io.EOF
+	}
+	if r.end-r.i < LogFrameHeaderLength {
+		return LogFrame{}, ErrBadLog
+	}
+	p := r.s[r.i:r.end]
+	n := int(binary.LittleEndian.Uint16(p[2:]))
+	if len(p)-LogFrameHeaderLength < n {
+		return LogFrame{}, ErrBadLog
+	}
+	f := LogFrame{
+		Tag:    binary.LittleEndian.Uint16(p),
+		S:      p[LogFrameHeaderLength : LogFrameHeaderLength+n],
+		Offset: r.i,
+	}
+	r.i += LogFrameHeaderLength + n
+	return f, nil
+}
+
+// Seek reads the kth frame by the index, the iteration continues after it.
+// Returns ErrBadLog if not indexed, or k is out of range.
+func (r *LogReader) Seek(k int) (LogFrame, error) {
+	if k < 0 || k >= r.count {
+		return LogFrame{}, ErrBadLog
+	}
+	offset := binary.LittleEndian.Uint64(r.s[r.end+8*k:])
+	if offset < LogHeaderLength || offset >= uint64(r.end) {
+		return LogFrame{}, ErrBadLog
+	}
+	r.i = int(offset)
+	f, err := r.Next()
+	if err == io.EOF {
+		err = ErrBadLog
+	}
+	return f, err
+}
+
+// ParallelMinRecords is the least number of records a worker of ParallelBatch
+// takes at a time, the same to the C library's BP_PARALLEL_MIN_RECORDS.
+const ParallelMinRecords = 1024
+
+// ParallelBatch calls f on ranges [lo, hi) covering the records [0, n), by a
+// pool of given number of worker goroutines, or runtime.GOMAXPROCS(0) if
+// workers <= 0. The ranges are contiguous, at least ParallelMinRecords long,
+// and about 4 of them for each worker, taken by the idle workers one after
+// another. Records in fixed size sit at known offsets in a buffer, so that f
+// encodes or decodes a range without any state shared with the others, e.g.:
+//
+//	bp.ParallelBatch(len(ms), 0, func(lo, hi int) error {
+//		for k := lo; k < hi; k++ {
+//			if err := ms[k].DecodeFrom(s[k*n:]); err != nil {
+//				return err
+//			}
+//		}
+//		return nil
+//	})
+//
+// Returns the error of the first range failed, in the order of records.
+func ParallelBatch(n, workers int, f func(lo, hi int) error) error {
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	chunk := (n + 4*workers - 1) / (4 * workers)
+	if chunk < ParallelMinRecords {
+		chunk = ParallelMinRecords
+	}
+	nchunks := (n + chunk - 1) / chunk
+	if workers > nchunks {
+		workers = nchunks
+	}
+	if workers <= 1 {
+		for lo := 0; lo < n; lo += chunk {
+			if err := f(lo, min(lo+chunk, n)); err != nil {
+				return err
+			}
+		}
+		return nil
+	}
+
+	var (
+		next  int64 = -1
+		mu    sync.Mutex
+		first = n
+		err   error
+		wg    sync.WaitGroup
+	)
+	wg.Add(workers)
+	for w := 0; w < workers; w++ {
+		go func() {
+			defer wg.Done()
+			for {
+				c := int(atomic.AddInt64(&next, 1))
+				if c >= nchunks {
+					return
+				}
+				lo := c * chunk
+				if e := f(lo, min(lo+chunk, n)); e != nil {
+					mu.Lock()
+					if lo < first {
+						first, err = lo, e
+					}
+					mu.Unlock()
+				}
+			}
+		}()
+	}
+	wg.Wait()
+	return err
+}
+
+// cacheLine is the size of the padding keeping the positions of a FrameRing
+// on cache lines of their own, 128 for the adjacent line prefetcher on x86 and
+// the lines of Apple M1.
+const cacheLine = 128
+
+// FrameRing is a lock-free ring of fixed-size slots passing encoded frames
+// from one producer goroutine to one consumer goroutine without copying, the
+// same to the C library's struct BpRing. The producer encodes straight into a
+// slot and the consumer decodes from it in place:
+//
+//	r := bitproto.NewFrameRing(int(bp.BYTES_LENGTH_PEN), 64)
+//	err := r.EncodeInto(pen)  // On the producer.
+//	err := r.DecodeFrom(pen)  // On the consumer.
+//
+// Positions count the slots ever committed and released, each written by one
+// side only, and the other side's one is cached to touch the shared cache line
+// only when the ring looks full or empty.
+type FrameRing struct {
+	_ [cacheLine]byte
+	// Position of the next slot to commit, and the consumer's position last
+	// seen, of the producer.
+	head       uint64
+	tailCached uint64
+	_          [cacheLine - 16]byte
+	// Position of the next slot to release, and the producer's position last
+	// seen, of the consumer.
+	tail       uint64
+	headCached uint64
+	_          [cacheLine - 16]byte
+	s          []byte
+	size       int
+	mask       uint64
+}
+
+// NewFrameRing returns a ring of n slots of size bytes each, n rounded up to a
+// power of 2.
+func NewFrameRing(size, n int) *FrameRing {
+	k := 1
+	for k < n {
+		k <<= 1
+	}
+	return &FrameRing{s: make([]byte, k*size), size: size, mask: uint64(k - 1)}
+}
+
+// Acquire returns the slot to encode the next frame into, or nil if the ring is
+// full. Called by the producer only.
+func (r *FrameRing) Acquire() []byte {
+	head := r.head
+	if head-r.tailCached > r.mask {
+		r.tailCached = atomic.LoadUint64(&r.tail)
+		if head-r.tailCached > r.mask {
+			return nil
+		}
+	}
+	i := int(head&r.mask) * r.size
+	return r.s[i : i+r.size : i+r.size]
+}
+
+// Commit publishes the frame encoded into the slot acquired to the consumer.
+// Called by the producer only.
+func (r *FrameRing) Commit() { atomic.StoreUint64(&r.head, r.head+1) }
+
+// Peek returns the slot of the oldest frame committed, or nil if the ring is
+// empty. Called by the consumer only.
+func (r *FrameRing) Peek() []byte {
+	tail := r.tail
+	if tail == r.headCached {
+		r.headCached = atomic.LoadUint64(&r.head)
+		if tail == r.headCached {
+			return nil
+		}
+	}
+	i := int(tail&r.mask) * r.size
+	return r.s[i : i+r.size : i+r.size]
+}
+
+// Release frees the slot peeked for the producer to reuse. Called by the
+// consumer only.
+func (r *FrameRing) Release() { atomic.StoreUint64(&r.tail, r.tail+1) }
+
+// EncodeInto encodes m into the next slot and commits it, or returns
+// ErrRingFull.
+func (r *FrameRing) EncodeInto(m interface{ EncodeTo(s []byte) int }) error {
+	s := r.Acquire()
+	if s == nil {
+		return ErrRingFull
+	}
+	m.EncodeTo(s)
+	r.Commit()
+	return nil
+}
+
+// DecodeFrom decodes m from the oldest slot and releases it, or returns
+// ErrRingEmpty.
+func (r *FrameRing) DecodeFrom(m interface{ DecodeFrom(s []byte) error }) error {
+	s := r.Peek()
+	if s == nil {
+		return ErrRingEmpty
+	}
+	err := m.DecodeFrom(s)
+	r.Release()
+	return err
+}
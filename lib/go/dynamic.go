@@ -0,0 +1,419 @@
+// Dynamic codec driven by a binary schema written by `bitproto -S`, to encode
+// and decode messages without generated code, e.g. in a gateway handling
+// schemas changing faster than it's rebuilt. LoadSchema compiles each message
+// into a flat copy plan once, with nested messages and arrays flattened, and
+// encoding and decoding run the plan over a field table of uint64 slots then,
+// without walking the schema. See bitproto/schema.py for the format.
+
+package bitproto
+
+import (
+	"encoding/binary"
+	"errors"
+	"strconv"
+)
+
+// ErrBadSchema is returned if a binary schema is malformed, or the buffer to
+// decode is not laid out as the schema, that's it's encoded by another version
+// of the schema.
+var ErrBadSchema = errors.New("bitproto: bad schema")
+
+// Kinds of the ops of dynamic copy plans.
+const (
+	dynOpUint = iota
+	dynOpInt
+	dynOpAhead
+)
+
+// dynMaxDepth limits the nesting of types in a schema, to reject the malformed
+// ones referencing messages in a cycle.
+const dynMaxDepth = 32
+
+// dynMaxNbits limits the number of bits of a type in a schema, the same to
+// BP_DYN_MAX_NBITS of the C library.
+const dynMaxNbits = 1 << 24
+
+// dynMaxSteps limits the number of types compiled for a message, to reject the
+// schemas of nested arrays flattened into too many elements, e.g. of empty
+// messages, taking no bits and slots.
+const dynMaxSteps = 1 << 20
+
+// dynOp is an op of the flat copy plan of a DynamicMessage, it copies count
+// elements, one after another, between the slots of a field table and the
+// buffer at the ith bit.
+type dynOp struct {
+	i     int
+	slot  int // Or the value of the ahead flag for a dynOpAhead.
+	count int
+	nbits int
+	kind  int
+}
+
+// DynamicField is a field of a DynamicMessage, flattened by its path, e.g.
+// "position.latitude" or "propellers[1].id". An array of single types is a
+// field of Count slots.
+type DynamicField struct {
+	Name  string
+	Slot  int
+	Count int
+	Flag  Flag
+	Nbits int
+}
+
+// DynamicMessage is a message loaded from a binary schema. Values of its fields
+// are held in a field table of NSlots uint64 slots, a signed integer is in two's
+// complement, e.g. int64(values[slot]).
+type DynamicMessage struct {
+	// The qualified name, e.g. "Drone" or "Drone.Network".
+	Name string
+	// The fingerprint of the layout, see FINGERPRINT_XXX of generated files.
+	Fingerprint uint64
+	NBits       int
+	NBytes      int
+	NSlots      int
+	Fields      []DynamicField
+	ops         []dynOp
+	index       map[string]int
+}
+
+// Schema is a binary schema loaded by LoadSchema.
+type Schema struct {
+	Messages []*DynamicMessage
+	index    map[string]*DynamicMessage
+}
+
+// schemaLoader is the context of LoadSchema.
+type schemaLoader struct {
+	s        []byte
+	messages []*DynamicMessage
+	bodies   []int // Where the fields of each message start in the schema.
+	m        *DynamicMessage
+	i        int // The bit of the buffer current type starts.
+	nsteps   int // The number of types compiled for the message.
+	failed   bool
+}
+
+func (ld *schemaLoader) read(p *int, n int) uint64 {
+	if ld.failed || *p+n > len(ld.s) {
+		ld.failed = true
+		return 0
+	}
+	v := uint64(0)
+	for k := 0; k < n; k++ {
+		v |= uint64(ld.s[*p+k]) << (8 * k)
+	}
+	*p += n
+	return v
+}
+
+func (ld *schemaLoader) readStr(p *int) string {
+	n := int(ld.read(p, 1))
+	if ld.failed || *p+n > len(ld.s) {
+		ld.failed = true
+		return ""
+	}
+	*p += n
+	return string(ld.s[*p-n : *p])
+}
+
+// typeNbits returns the number of bits of the type at the pth byte of the
+// schema, and skips it.
+func (ld *schemaLoader) typeNbits(p *int, depth int) int {
+	if depth > dynMaxDepth {
+		ld.failed = true
+	}
+	if ld.failed {
+		return 0
+	}
+	switch Flag(ld.read(p, 1)) {
+	case FlagBool:
+		return 1
+	case FlagByte:
+		return 8
+	case FlagInt, FlagUint, FlagEnum:
+		nbits := int(ld.read(p, 1))
+		if nbits < 1 || nbits > 64 {
+			ld.failed = true
+		}
+		return nbits
+	case FlagArray:
+		extensible := ld.read(p, 1) != 0
+		capacity := int(ld.read(p, 2))
+		nbits := ld.typeNbits(p, depth+1) * capacity
+		if extensible {
+			nbits += 16
+		}
+		if nbits > dynMaxNbits {
+			ld.failed = true
+			return 0
+		}
+		return nbits
+	case FlagMessage:
+		return ld.messageNbits(int(ld.read(p, 2)), depth+1)
+	}
+	ld.failed = true
+	return 0
+}
+
+// messageNbits returns the number of bits of the kth message, computed once.
+func (ld *schemaLoader) messageNbits(k int, depth int) int {
+	if k >= len(ld.messages) {
+		ld.failed = true
+	}
+	if ld.failed {
+		return 0
+	}
+	m := ld.messages[k]
+	if m.NBits >= 0 {
+		return m.NBits
+	}
+	p := ld.bodies[k]
+	nbits := 0
+	if ld.read(&p, 1) != 0 {
+		nbits = 16
+	}
+	nfields := int(ld.read(&p, 2))
+	for f := 0; f < nfields && !ld.failed; f++ {
+		ld.readStr(&p)
+		nbits += ld.typeNbits(&p, depth+1)
+		if nbits > dynMaxNbits {
+			ld.failed = true
+		}
+	}
+	if ld.failed {
+		return 0
+	}
+	m.NBits = nbits
+	return nbits
+}
+
+func (ld *schemaLoader) emitOp(kind, nbits, count, slot int) {
+	ld.m.ops = append(ld.m.ops, dynOp{ld.i, slot, count, nbits, kind})
+	ld.i += nbits * count
+}
+
+func (ld *schemaLoader) emitField(path string, flag Flag, nbits, count int) {
+	slot := ld.m.NSlots
+	ld.m.index[path] = len(ld.m.Fields)
+	ld.m.Fields = append(ld.m.Fields, DynamicField{path, slot, count, flag, nbits})
+	kind := dynOpUint
+	if flag == FlagInt {
+		kind = dynOpInt
+	}
+	ld.emitOp(kind, nbits, count, slot)
+	ld.m.NSlots += count
+}
+
+// compileType compiles the type at the pth byte of the schema into ops and
+// fields of given path, and skips it.
+func (ld *schemaLoader) compileType(p *int, path string, depth int) {
+	ld.nsteps++
+	if ld.nsteps > dynMaxSteps {
+		ld.failed = true
+		return
+	}
+	q := *p
+	nbits := ld.typeNbits(p, depth)
+	if ld.failed {
+		return
+	}
+	flag := Flag(ld.s[q])
+	switch flag {
+	case FlagBool, FlagByte, FlagInt, FlagUint, FlagEnum:
+		ld.emitField(path, flag, nbits, 1)
+		return
+	case FlagMessage:
+		ld.compileMessage(int(binary.LittleEndian.Uint16(ld.s[q+1:])), path, depth+1)
+		return
+	}
+
+	// Arrays: u8 extensible, u16 cap, and the element type at q.
+	extensible := ld.s[q+1] != 0
+	capacity := int(binary.LittleEndian.Uint16(ld.s[q+2:]))
+	q += 4
+	if extensible {
+		ld.emitOp(dynOpAhead, 16, 1, capacity)
+	}
+	elementFlag := Flag(ld.s[q])
+	if elementFlag != FlagArray && elementFlag != FlagMessage {
+		// An array of single types is a single field, of cap slots.
+		r := q
+		ld.emitField(path, elementFlag, ld.typeNbits(&r, depth+1), capacity)
+		return
+	}
+	for e := 0; e < capacity && !ld.failed; e++ {
+		r := q
+		ld.compileType(&r, path+"["+strconv.Itoa(e)+"]", depth+1)
+	}
+}
+
+// compileMessage compiles the kth message into ops and fields, the paths of
+// its fields are prefixed with given path.
+func (ld *schemaLoader) compileMessage(k int, path string, depth int) {
+	nbits := ld.messageNbits(k, depth)
+	if ld.failed {
+		return
+	}
+	p := ld.bodies[k]
+	extensible := ld.read(&p, 1) != 0
+	nfields := int(ld.read(&p, 2))
+	if extensible {
+		ld.emitOp(dynOpAhead, 16, 1, nbits)
+	}
+	for f := 0; f < nfields && !ld.failed; f++ {
+		name := ld.readStr(&p)
+		if path != "" {
+			name = path + "." + name
+		}
+		ld.compileType(&p, name, depth+1)
+	}
+}
+
+// LoadSchema loads the binary schema s, the messages are compiled into flat
+// copy plans.
+func LoadSchema(s []byte) (*Schema, error) {
+	if len(s) < 8 || string(s[:4]) != "BPSC" || s[4] != 1 {
+		return nil, ErrBadSchema
+	}
+	ld := &schemaLoader{s: s}
+	p := 6
+	n := int(ld.read(&p, 2))
+
+	// Finds the messages.
+	for k := 0; k < n && !ld.failed; k++ {
+		m := &DynamicMessage{NBits: -1, index: map[string]int{}}
+		m.Name = ld.readStr(&p)
+		m.Fingerprint = ld.read(&p, 8)
+		ld.messages = append(ld.messages, m)
+		ld.bodies = append(ld.bodies, p)
+		ld.read(&p, 1)
+		nfields := int(ld.read(&p, 2))
+		for f := 0; f < nfields && !ld.failed; f++ {
+			ld.readStr(&p)
+			ld.typeNbits(&p, 0)
+		}
+	}
+
+	schema := &Schema{index: map[string]*DynamicMessage{}}
+	for k := 0; k < len(ld.messages) && !ld.failed; k++ {
+		ld.m, ld.i, ld.nsteps = ld.messages[k], 0, 0
+		ld.compileMessage(k, "", 0)
+		ld.m.NBytes = (ld.m.NBits + 7) / 8
+		schema.index[ld.m.Name] = ld.m
+	}
+	if ld.failed {
+		return nil, ErrBadSchema
+	}
+	schema.Messages = ld.messages
+	return schema, nil
+}
+
+// Message returns the message of given qualified name, or nil if not found.
+func (s *Schema) Message(name string) *DynamicMessage { return s.index[name] }
+
+// MessageByFingerprint returns the message of given fingerprint, or nil if not
+// found.
+func (s *Schema) MessageByFingerprint(fingerprint uint64) *DynamicMessage {
+	for _, m := range s.Messages {
+		if m.Fingerprint == fingerprint {
+			return m
+		}
+	}
+	return nil
+}
+
+// Field returns the field of given path, and whether it's found.
+func (m *DynamicMessage) Field(name string) (DynamicField, bool) {
+	k, ok := m.index[name]
+	if !ok {
+		return DynamicField{}, false
+	}
+	return m.Fields[k], true
+}
+
+// NewValues returns a field table of this message, all zeros.
+func (m *DynamicMessage) NewValues() []uint64 { return make([]uint64, m.NSlots) }
+
+// dynPut writes the lower nbits of v at the ith bit of s.
+func dynPut(s []byte, i int, v uint64, nbits int) {
+	for nbits > 0 {
+		j, o := i>>3, i&7
+		c := 8 - o
+		if c > nbits {
+			c = nbits
+		}
+		mask := byte((1<<c)-1) << o
+		s[j] = s[j]&^mask | byte(v<<o)&mask
+		v >>= c
+		i += c
+		nbits -= c
+	}
+}
+
+// dynGet reads nbits at the ith bit of s, by a word load if the 8 bytes are in
+// s. Bits above nbits are garbage.
+func dynGet(s []byte, i int, nbits int) uint64 {
+	j, o := i>>3, i&7
+	if j+8 <= len(s) && o+nbits <= 64 {
+		return binary.LittleEndian.Uint64(s[j:]) >> o
+	}
+	v := uint64(s[j]) >> o
+	for k := 8 - o; k < nbits; k += 8 {
+		j++
+		v |= uint64(s[j]) << k
+	}
+	return v
+}
+
+// Encode encodes the field table values into a new buffer.
+func (m *DynamicMessage) Encode(values []uint64) []byte {
+	s := make([]byte, m.NBytes)
+	m.EncodeTo(values, s)
+	return s
+}
+
+// EncodeTo encodes the field table values into s, which is at least NBytes
+// long, and not required to be zeroed. Bits of the values above the number of
+// bits of the fields are ignored.
+func (m *DynamicMessage) EncodeTo(values []uint64, s []byte) {
+	for _, op := range m.ops {
+		if op.kind == dynOpAhead {
+			dynPut(s, op.i, uint64(op.slot), 16)
+			continue
+		}
+		for e, i := 0, op.i; e < op.count; e, i = e+1, i+op.nbits {
+			dynPut(s, i, values[op.slot+e], op.nbits)
+		}
+	}
+	if r := m.NBits & 7; r != 0 {
+		s[m.NBits>>3] &= byte(1<<r) - 1
+	}
+}
+
+// Decode decodes s into the field table values, every slot is written. Signed
+// integers are sign-extended to 64 bits. Returns ErrShortInput if s is shorter
+// than the message, or ErrBadSchema if an ahead flag of extensible types
+// mismatches the schema.
+func (m *DynamicMessage) Decode(values []uint64, s []byte) error {
+	if len(s) < m.NBytes {
+		return ErrShortInput
+	}
+	for _, op := range m.ops {
+		mask := ^uint64(0) >> (64 - op.nbits)
+		if op.kind == dynOpAhead {
+			if dynGet(s, op.i, 16)&mask != uint64(op.slot) {
+				return ErrBadSchema
+			}
+			continue
+		}
+		sign := uint64(0)
+		if op.kind == dynOpInt {
+			sign = 1 << (op.nbits - 1)
+		}
+		v := values[op.slot : op.slot+op.count]
+		for e, i := 0, op.i; e < op.count; e, i = e+1, i+op.nbits {
+			v[e] = ((dynGet(s, i, op.nbits) & mask) ^ sign) - sign
+		}
+	}
+	return nil
+}
@@ -0,0 +1,114 @@
+//go:build go1.18
+
+// Generic processing of message fields through typed pointers, for structs
+// generated with option go.generics. Each integer width and signedness gets a
+// specialized copy of the codec by type parameter, instead of going through the
+// Accessor interface and a switch on field numbers.
+
+package bitproto
+
+import "math"
+
+// Integer is the constraint of integer, byte and enum fields.
+type Integer interface {
+	~int8 | ~int16 | ~int32 | ~int64 | ~uint8 | ~uint16 | ~uint32 | ~uint64
+}
+
+// ProcessInteger encodes or decodes an integer of nbits at the current bit of
+// ctx, from or into *p. Signed integers are sign-extended on decoding.
+func ProcessInteger[T Integer](ctx *ProcessContext, p *T, nbits int) {
+	mask := ^uint64(0) >> (64 - nbits)
+	if ctx.isEncode {
+		encodeBits(ctx, uint64(*p)&mask, nbits)
+		return
+	}
+	v := decodeBits(ctx, nbits) & mask
+	if ^T(0) < 0 && v>>(nbits-1) != 0 {
+		v |= ^mask
+	}
+	*p = T(v)
+}
+
+// ProcessIntegers processes an array of integers of nbits each.
+func ProcessIntegers[T Integer](ctx *ProcessContext, s []T, nbits int) {
+	for k := range s {
+		ProcessInteger(ctx, &s[k], nbits)
+	}
+}
+
+// ProcessRange encodes or decodes an integer of option range at the current bit
+// of ctx, as the offset of nbits from the lower bound lo, from or into *p.
+func ProcessRange[T Integer](ctx *ProcessContext, p *T, nbits int, lo uint64) {
+	mask := ^uint64(0) >> (64 - nbits)
+	if ctx.isEncode {
+		encodeBits(ctx, (uint64(*p)-lo)&mask, nbits)
+		return
+	}
+	*p = T((decodeBits(ctx, nbits) & mask) + lo)
+}
+
+// ProcessFloat32 encodes or decodes a float32 at the current bit of ctx, as its
+// IEEE 754 bits, from or into *p.
+func ProcessFloat32[T ~float32](ctx *ProcessContext, p *T) {
+	if ctx.isEncode {
+		encodeBits(ctx, uint64(math.Float32bits(float32(*p))), 32)
+		return
+	}
+	*p = T(math.Float32frombits(uint32(decodeBits(ctx, 32))))
+}
+
+// ProcessFixed encodes or decodes a fixed-point value of nbits at the current bit
+// of ctx, multiplied by scale 2^frac, from or into *p. See FixedBits.
+func ProcessFixed[T ~float32 | ~float64](ctx *ProcessContext, p *T, nbits int, signed bool, scale float64) {
+	if ctx.isEncode {
+		mask := ^uint64(0) >> (64 - nbits)
+		encodeBits(ctx, FixedBits(float64(*p), scale)&mask, nbits)
+		return
+	}
+	*p = T(FixedValue(decodeBits(ctx, nbits), nbits, signed, 1/scale))
+}
+
+// ProcessBool encodes or decodes a bool at the current bit of ctx.
+func ProcessBool[T ~bool](ctx *ProcessContext, p *T) {
+	if ctx.isEncode {
+		if *p {
+			encodeBits(ctx, 1, 1)
+		} else {
+			ctx.i++
+		}
+		return
+	}
+	*p = decodeBits(ctx, 1)&1 != 0
+}
+
+// BeginExtensible processes the ahead flag of an extensible message or array,
+// that's the number of bits of the message or the capacity of the array.
+// Returns the bit ctx was at, and the ahead flag, to pass to EndExtensible.
+func BeginExtensible(ctx *ProcessContext, ahead int) (int, int) {
+	i := ctx.i
+	if ctx.isEncode {
+		encodeUint16(ctx, uint16(ahead))
+		return i, ahead
+	}
+	return i, int(decodeUint16(ctx))
+}
+
+// EndExtensible skips the bits of an extensible message or array post decoding,
+// that the encoder has but the decoder doesn't know. The unit is 1 for messages,
+// and the capacity for arrays, the same as the processors.
+func EndExtensible(ctx *ProcessContext, i, ahead, unit int) {
+	if ito := i + ahead*unit; !ctx.isEncode && ito >= ctx.i {
+		ctx.i = ito
+	}
+}
+
+// ProcessBounded processes the count of a bounded array of given capacity in
+// nbits, held in slice *p, and returns the elements in use to process. The slice
+// is resized to the count on decoding, reusing its backing array if possible.
+func ProcessBounded[T any](ctx *ProcessContext, p *[]T, capacity, nbits int) []T {
+	n := ProcessCount(ctx, len(*p), capacity, nbits)
+	if !ctx.isEncode {
+		*p = append((*p)[:0], make([]T, n)...)
+	}
+	return (*p)[:n]
+}
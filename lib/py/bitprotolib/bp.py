@@ -7,11 +7,33 @@ Encoding support for generated python files.
 Keep it simple:  No magic.
 """
 
+import asyncio
+import base64
 import json
+import mmap
+import struct
 from abc import abstractmethod
+from array import array
 from contextlib import contextmanager
-from dataclasses import asdict, dataclass, field as dataclass_field
-from typing import Any, Dict, Iterator, List, Optional, Tuple
+from dataclasses import asdict, dataclass, field as dataclass_field, fields
+from typing import (
+    IO,
+    Any,
+    Callable,
+    ClassVar,
+    Dict,
+    Iterator,
+    List,
+    NamedTuple,
+    Optional,
+    Tuple,
+    Union,
+)
+
+try:
+    import numpy  # type: ignore
+except ImportError:  # pragma: no cover
+    numpy = None
 
 # Flags
 FLAG_BOOL: int = 1
@@ -23,6 +45,9 @@ FLAG_ALIAS: int = 6
 FLAG_ARRAY: int = 7
 FLAG_MESSAGE: int = 8
 FLAG_MESSAGE_FIELD: int = 9
+FLAG_RANGE: int = 10
+FLAG_FLOAT: int = 11
+FLAG_FIXED: int = 12
 
 # Python dosen't have a byte type, using int instead.
 byte = int
@@ -44,6 +69,40 @@ def int64(i: int) -> int:
     return i if i < 9223372036854775808 else i - 18446744073709551616
 
 
+def float32_to_bits(v: float) -> int:
+    """Returns the IEEE 754 bits of v as a single precision floating point number,
+    values out of range are infinities, the same as a cast to float in C."""
+    try:
+        return struct.unpack("<I", struct.pack("<f", v))[0]
+    except OverflowError:
+        return 0xFF800000 if v < 0 else 0x7F800000
+
+
+def float32_from_bits(w: int) -> float:
+    """Returns the single precision floating point number of IEEE 754 bits w."""
+    return struct.unpack("<f", struct.pack("<I", w))[0]
+
+
+def fixed_to_bits(v: float, scale: float) -> int:
+    """Returns the bits of fixed-point value v, that's v multiplied by scale 2^frac,
+    rounded half away from zero. NaN is encoded as 0. The caller masks the bits."""
+    r = v * scale
+    if r >= 0:
+        return int(r + 0.5)
+    if r < 0:
+        return int(r - 0.5)
+    return 0
+
+
+def fixed_from_bits(w: int, nbits: int, signed: bool, unit: float) -> float:
+    """Returns the fixed-point value of bits w of nbits, multiplied by unit 2^-frac,
+    sign-extended if signed."""
+    if signed:
+        m = 1 << (nbits - 1)
+        w = (w ^ m) - m
+    return w * unit
+
+
 class Error(Exception):
     """Error occurred during bitproto encoding or decoding."""
 
@@ -52,6 +111,14 @@ class NotEnoughBytes(Error):
     """Given bytearray is not enough to process."""
 
 
+class CountExceedsCapacity(Error):
+    """The count decoded of a bounded array exceeds its capacity."""
+
+
+class BadLog(Error):
+    """The log container is malformed, or not indexed to seek."""
+
+
 @dataclass
 class ProcessContext:
     """ProcessContext is the context across all processor functions in a encoding or
@@ -114,6 +181,8 @@ class Accessor:
     Assuming compiler generates these methods for messages.
     """
 
+    __slots__ = ()
+
     @abstractmethod
     def bp_set_byte(self, di: DataIndexer, lshift: int, b: byte) -> None:
         """Sets given byte to target data, where the data will be lookedup by given
@@ -145,6 +214,18 @@ class Accessor:
         """Process signed integer's sign bit."""
         raise NotImplementedError
 
+    def bp_get_len(self, di: DataIndexer) -> int:
+        """Returns the number of elements of the bounded array lookedup by given indexer
+        di. This method is generated only for messages with bounded arrays.
+        """
+        raise NotImplementedError
+
+    def bp_set_len(self, di: DataIndexer, n: int) -> None:
+        """Resizes the bounded array lookedup by given indexer di to n zero elements.
+        This method is generated only for messages with bounded arrays.
+        """
+        raise NotImplementedError
+
 
 class NilAccessor(Accessor):
     """NilAccessor is a special accessor implementation, represents that this accessor is
@@ -189,6 +270,12 @@ class IntAccessor(Accessor):
 class MessageBase(Accessor):
     """MessageBase is the base class for all bitproto message classes."""
 
+    __slots__ = ()
+
+    # Json formats of byte arrays by field name, generated for messages with option
+    # json_bytes in effect inside, see _format_json_bytes.
+    JSON_BYTES: ClassVar[Dict[str, str]] = {}
+
     def to_dict(self) -> Dict[str, Any]:
         """Converts this message to a dict."""
         return asdict(
@@ -199,7 +286,107 @@ class MessageBase(Accessor):
         self, indent: Optional[int] = None, separators: Optional[Tuple[str, str]] = None
     ) -> str:
         """Dumps this message to a json string."""
-        return json.dumps(self.to_dict(), indent=indent, separators=separators)
+        d = self.to_dict()
+        if self.JSON_BYTES:
+            _format_json_bytes(self, d)
+        return json.dumps(
+            d, indent=indent, separators=separators, default=_json_default
+        )
+
+
+def _format_json_bytes(m: MessageBase, d: Dict[str, Any]) -> None:
+    """Formats byte arrays of message m in its dict d as strings in place, by the
+    formats in m.JSON_BYTES, recursively."""
+    for name, format in m.JSON_BYTES.items():
+        d[name] = _format_json_bytes_value(getattr(m, name), d[name], format)
+
+
+def _format_json_bytes_value(v: Any, dv: Any, format: str) -> Any:
+    if isinstance(v, MessageBase):
+        _format_json_bytes(v, dv)
+        return dv
+    if isinstance(v, list):
+        return [_format_json_bytes_value(x, y, format) for x, y in zip(v, dv)]
+    if format == "hex":
+        return bytes(v).hex()
+    return base64.b64encode(bytes(v)).decode()
+
+
+def _json_default(o: Any) -> Any:
+    """Dumps byte arrays, and arrays of integers generated with option py.slots as
+    lists."""
+    if isinstance(o, (bytearray, bytes)):
+        return list(o)
+    if isinstance(o, array):
+        return o.tolist()
+    raise TypeError(f"Object of type {type(o).__name__} is not JSON serializable")
+
+
+def slots(cls: Any) -> Any:
+    """Class decorator to recreate given dataclass with __slots__ of its fields, like
+    dataclass(slots=True) on Python 3.10+. Assuming compiler generates it for message
+    classes with option py.slots.
+    """
+    d = dict(cls.__dict__)
+    names = tuple(f.name for f in fields(cls))
+    d["__slots__"] = names
+    for name in names:
+        # Default values are kept by the generated __init__.
+        d.pop(name, None)
+    d.pop("__dict__", None)
+    d.pop("__weakref__", None)
+    qualname = getattr(cls, "__qualname__", None)
+    cls = type(cls)(cls.__name__, cls.__bases__, d)
+    if qualname is not None:
+        cls.__qualname__ = qualname
+    return cls
+
+
+class MessageView:
+    """MessageView is the base class for generated read-only views of messages in
+    fixed size, of which the properties extract fields from the encoded buffer on
+    access, by the bit offsets known at compile time.
+
+    :param s: The buffer holding an encoded message, e.g. a bytes or an mmap.
+    :param offset: Index of the byte the message starts at in s.
+    """
+
+    __slots__ = ("bp_s", "bp_i")
+
+    # Number of bytes of the message, assuming compiler generates it.
+    BYTES_LENGTH: int = 0
+
+    def __init__(self, s: Union[bytes, bytearray, memoryview], offset: int = 0) -> None:
+        self.bp_s = memoryview(s)
+        self.bp_i = offset * 8
+        assert len(self.bp_s) - offset >= self.BYTES_LENGTH, NotEnoughBytes()
+
+    @classmethod
+    def bp_at(cls, s: memoryview, i: int) -> Any:
+        """Returns a view of the message starting at the ith bit of s, e.g. a message
+        nested in another message's view, which is not always byte aligned."""
+        view = cls.__new__(cls)
+        view.bp_s, view.bp_i = s, i
+        return view
+
+    def bp_uint(self, i: int, nbits: int) -> int:
+        """Extracts the unsigned integer of nbits at the ith bit of the message, only
+        the bytes spanned are converted."""
+        i += self.bp_i
+        b = self.bp_s[i >> 3 : (i + nbits + 7) >> 3]
+        return (int.from_bytes(b, "little") >> (i & 7)) & ((1 << nbits) - 1)
+
+    def bp_int(self, i: int, nbits: int) -> int:
+        """Extracts the signed integer of nbits at the ith bit of the message."""
+        m = 1 << (nbits - 1)
+        return (self.bp_uint(i, nbits) ^ m) - m
+
+    def bp_bytes(self, i: int, n: int) -> bytes:
+        """Extracts the n bytes at the ith bit of the message."""
+        i += self.bp_i
+        if i & 7 == 0:
+            return bytes(self.bp_s[i >> 3 : (i >> 3) + n])
+        return self.bp_uint(i - self.bp_i, n * 8).to_bytes(n, "little")
 
 
 class Processor:
@@ -264,6 +451,76 @@ class Uint(Processor):
         process_base_type(self.nbits, ctx, di, accessor)
 
 
+@dataclass
+class Range(Processor):
+    """Range implements Processor for integer fields of option range, which are
+    encoded as the offsets from the lower bounds of the ranges.
+    The generated accessor subtracts the lower bound in bp_get_byte, and adds it
+    back in bp_process_int after decoding.
+
+    :param nbits: Number of bits the offset occupy.
+    """
+
+    nbits: int
+
+    def flag(self) -> int:
+        return FLAG_RANGE
+
+    def process(self, ctx: ProcessContext, di: DataIndexer, accessor: Accessor) -> None:
+        process_base_type(self.nbits, ctx, di, accessor)
+
+        # Add the lower bound back
+        if ctx.is_encode:
+            return
+
+        accessor.bp_process_int(di)
+
+
+@dataclass
+class Float32(Processor):
+    """Float32 implements Processor for float32 type, which is encoded as its IEEE
+    754 bits. The generated accessor gets the bytes of the bits in bp_get_byte,
+    collects the decoded bits in place of the value, and converts them to the value
+    in bp_process_int after decoding.
+    """
+
+    def flag(self) -> int:
+        return FLAG_FLOAT
+
+    def process(self, ctx: ProcessContext, di: DataIndexer, accessor: Accessor) -> None:
+        process_base_type(32, ctx, di, accessor)
+
+        # Convert the bits to the value
+        if ctx.is_encode:
+            return
+
+        accessor.bp_process_int(di)
+
+
+@dataclass
+class Fixed(Processor):
+    """Fixed implements Processor for fixed-point types, which are encoded as the
+    values multiplied by 2^frac, see fixed_to_bits. The generated accessor works the
+    same way as for Float32.
+
+    :param nbits: Number of bits the fixed-point type occupy.
+    """
+
+    nbits: int
+
+    def flag(self) -> int:
+        return FLAG_FIXED
+
+    def process(self, ctx: ProcessContext, di: DataIndexer, accessor: Accessor) -> None:
+        process_base_type(self.nbits, ctx, di, accessor)
+
+        # Convert the bits to the value
+        if ctx.is_encode:
+            return
+
+        accessor.bp_process_int(di)
+
+
 @dataclass
 class Byte(Processor):
     """Byte implements Processor for byte type."""
@@ -331,6 +588,40 @@ class Array(Processor):
         return accessor.data
 
 
+@dataclass
+class BoundedArray(Processor):
+    """BoundedArray implements Processor for bounded array type, encoded as a count
+    followed by the elements in use only.
+
+    :param capacity: Capacity of this array.
+    :param count_nbits: The number of bits the count occupies.
+    :param element_processor: Processor of the array's element.
+    """
+
+    capacity: int
+    count_nbits: int
+    element_processor: Processor
+
+    def flag(self) -> int:
+        return FLAG_ARRAY
+
+    def process(self, ctx: ProcessContext, di: DataIndexer, accessor: Accessor) -> None:
+        count = IntAccessor()
+        if ctx.is_encode:
+            count.data = min(accessor.bp_get_len(di), self.capacity)
+        process_base_type(self.count_nbits, ctx, DataIndexer(field_number=1), count)
+        n = count.data
+        if not ctx.is_encode:
+            if n > self.capacity:
+                raise CountExceedsCapacity()
+            accessor.bp_set_len(di, n)
+
+        with di.index_stack_maintain():
+            for k in range(n):
+                di.index_stack_replace(k)
+                self.element_processor.process(ctx, di, accessor)
+
+
 @dataclass
 class EnumProcessor(Processor):
     """Enum implements Processor for enum type.
@@ -543,3 +834,307 @@ def process_base_type(
         process_single_byte(ctx, di, accessor, j, c)
         ctx.i += c
         j += c
+
+
+# Column describes a field to decode by decode_columns, in tuple (name, i, nbits,
+# kind), where i is the index of the bit the field starts at in a frame, and kind is
+# one of "bool", "int" and "uint".
+Column = Tuple[str, int, int, str]
+
+
+def decode_columns(
+    s: Union[bytes, bytearray, memoryview],
+    frame_size: int,
+    columns: List[Column],
+    use_numpy: Optional[bool] = None,
+) -> Dict[str, Any]:
+    """Decodes the concatenated frames of a fixed size message in buffer s into columns,
+    returns a dict mapping column name to a contiguous array of the field's values of
+    all frames, in order. Trailing bytes less than a frame are ignored.
+    Assuming compiler generates the columns for messages in fixed size.
+
+    :param frame_size: The number of bytes of a single frame.
+    :param use_numpy: Returns numpy arrays if True, array.array if False.
+       Defaults to whether numpy is installed.
+    """
+    if use_numpy is None:
+        use_numpy = numpy is not None
+    if use_numpy:
+        return _decode_columns_numpy(s, frame_size, columns)
+    return _decode_columns_array(s, frame_size, columns)
+
+
+def _column_typecode(nbits: int, kind: str) -> str:
+    """Returns the smallest array typecode to hold a column value in nbits."""
+    typecodes = "bhiq" if kind == "int" else "BHIQ"
+    for typecode in typecodes:
+        if array(typecode).itemsize * 8 >= nbits:
+            return typecode
+    raise Error(f"bitproto: no array type to hold {nbits} bits")
+
+
+def _decode_columns_array(
+    s: Union[bytes, bytearray, memoryview], frame_size: int, columns: List[Column]
+) -> Dict[str, Any]:
+    mv = memoryview(s)
+    n = len(mv) // frame_size if frame_size else 0
+    specs = [
+        (i, (1 << nbits) - 1, (1 << (nbits - 1)) if kind == "int" else 0)
+        for _, i, nbits, kind in columns
+    ]
+    arrays = [array(_column_typecode(nbits, kind)) for _, _, nbits, kind in columns]
+    appends = [a.append for a in arrays]
+
+    for k in range(n):
+        v = int.from_bytes(mv[k * frame_size : (k + 1) * frame_size], "little")
+        for (i, mask, sign), append in zip(specs, appends):
+            x = (v >> i) & mask
+            append((x ^ sign) - sign if sign else x)
+
+    return {column[0]: a for column, a in zip(columns, arrays)}
+
+
+def _decode_columns_numpy(
+    s: Union[bytes, bytearray, memoryview], frame_size: int, columns: List[Column]
+) -> Dict[str, Any]:
+    n = len(s) // frame_size if frame_size else 0
+    frames = numpy.frombuffer(s, dtype=numpy.uint8, count=n * frame_size)
+    frames = frames.reshape(n, frame_size)
+    d: Dict[str, Any] = {}
+
+    for name, i, nbits, kind in columns:
+        # Bytes the field spans in a frame are or-ed into an uint64 for all frames at
+        # once. A field of more than 57 bits may span 9 bytes, the last one is shifted
+        # in after.
+        b, r = i >> 3, i & 7
+        nb = (r + nbits + 7) >> 3
+        w = numpy.zeros(n, dtype=numpy.uint64)
+        for j in range(min(nb, 8)):
+            w |= frames[:, b + j].astype(numpy.uint64) << numpy.uint64(8 * j)
+        w >>= numpy.uint64(r)
+        if nb > 8:
+            w |= frames[:, b + 8].astype(numpy.uint64) << numpy.uint64(64 - r)
+        if nbits < 64:
+            w &= numpy.uint64((1 << nbits) - 1)
+
+        if kind == "bool":
+            d[name] = w.astype(numpy.bool_)
+            continue
+
+        typecode = _column_typecode(nbits, kind)
+        dtype = numpy.dtype(
+            ("i" if kind == "int" else "u") + str(array(typecode).itemsize)
+        )
+        if kind == "int":
+            if nbits < 64:
+                sign = numpy.uint64(1 << (nbits - 1))
+                w = (w ^ sign) - sign
+            d[name] = w.view(numpy.int64).astype(dtype)
+        else:
+            d[name] = w.astype(dtype)
+
+    return d
+
+
+# Log containers, the same layout to the C library's BpLogReader:
+# * A header: "BPLG", version 1, flags, 2 reserved bytes, and a 64 bits schema
+#   fingerprint.
+# * Frames: a 16 bits tag, a 16 bits length, and then the encoded message.
+# * An optional index: the 64 bits offsets of the frames, followed by the 64 bits
+#   number of them, and "BPIX".
+# All integers are in little-endian.
+LOG_HEADER_LENGTH: int = 16
+LOG_FRAME_HEADER_LENGTH: int = 4
+
+
+class LogFrame(NamedTuple):
+    """A frame of a log container, s is a view into the container without copying."""
+
+    tag: int
+    s: memoryview
+    offset: int
+
+
+class LogWriter:
+    """Writes encoded messages as frames of a log container to file f.
+
+    :param indexed: Writes the index on close if True.
+    """
+
+    def __init__(self, f: IO[bytes], fingerprint: int, indexed: bool = True) -> None:
+        self.f = f
+        self.indexed = indexed
+        self.offset = LOG_HEADER_LENGTH
+        self.offsets: List[int] = []
+        f.write(struct.pack("<4sBB2xQ", b"BPLG", 1, 0, fingerprint))
+
+    def write_frame(self, tag: int, s: Union[bytes, bytearray, memoryview]) -> None:
+        if len(s) > 0xFFFF:
+            raise BadLog("bitproto: frame too large")
+        self.f.write(struct.pack("<HH", tag, len(s)))
+        self.f.write(s)
+        if self.indexed:
+            self.offsets.append(self.offset)
+        self.offset += LOG_FRAME_HEADER_LENGTH + len(s)
+
+    def close(self) -> None:
+        """Writes the index if indexed. The underlying file is not closed."""
+        if self.indexed:
+            n = len(self.offsets)
+            self.f.write(struct.pack(f"<{n}QQ4s", *self.offsets, n, b"BPIX"))
+
+
+class LogReader:
+    """Iterates or seeks the frames of a log container in buffer s, e.g. a
+    memory-mapped log file by LogReader.open.
+    """
+
+    def __init__(self, s: Union[bytes, bytearray, memoryview, mmap.mmap]) -> None:
+        mv = memoryview(s)
+        n = len(mv)
+        if n < LOG_HEADER_LENGTH or bytes(mv[:4]) != b"BPLG" or mv[4] != 1:
+            raise BadLog("bitproto: not a log container")
+        self.s = mv
+        self.fingerprint: int = struct.unpack_from("<Q", mv, 8)[0]
+        self.end = n
+        self.count = 0
+
+        # An index is trusted if its size fits, the frames end where it starts.
+        if n >= LOG_HEADER_LENGTH + 12 and bytes(mv[n - 4 :]) == b"BPIX":
+            count = struct.unpack_from("<Q", mv, n - 12)[0]
+            if count <= (n - LOG_HEADER_LENGTH - 12) // 8:
+                end = n - 12 - count * 8
+                last = struct.unpack_from("<Q", mv, n - 20)[0] if count else end
+                if last + LOG_FRAME_HEADER_LENGTH <= end:
+                    length = struct.unpack_from("<H", mv, last + 2)[0]
+                    if last + LOG_FRAME_HEADER_LENGTH + length == end:
+                        self.end, self.count = end, count
+
+    @classmethod
+    def open(cls, path: str) -> "LogReader":
+        """Opens the log file at given path by a read-only memory map."""
+        with open(path, "rb") as f:
+            return cls(mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ))
+
+    def __len__(self) -> int:
+        """Returns the number of frames indexed, 0 if not indexed."""
+        return self.count
+
+    def read_frame(self, offset: int) -> Tuple[LogFrame, int]:
+        """Reads the frame at given offset, returns it and the offset of the next."""
+        if self.end - offset < LOG_FRAME_HEADER_LENGTH:
+            raise BadLog("bitproto: truncated frame")
+        tag, n = struct.unpack_from("<HH", self.s, offset)
+        i = offset + LOG_FRAME_HEADER_LENGTH
+        if self.end - i < n:
+            raise BadLog("bitproto: truncated frame")
+        return LogFrame(tag, self.s[i : i + n], offset), i + n
+
+    def __iter__(self) -> Iterator[LogFrame]:
+        i = LOG_HEADER_LENGTH
+        while i < self.end:
+            frame, i = self.read_frame(i)
+            yield frame
+
+    def seek(self, k: int) -> LogFrame:
+        """Reads the kth frame by the index."""
+        if not 0 <= k < self.count:
+            raise BadLog("bitproto: frame not indexed")
+        offset = struct.unpack_from("<Q", self.s, self.end + 8 * k)[0]
+        if not LOG_HEADER_LENGTH <= offset < self.end:
+            raise BadLog("bitproto: bad index")
+        return self.read_frame(offset)[0]
+
+
+class FrameProtocol(asyncio.BufferedProtocol):
+    """Receives the frames of a stream, e.g. a TCP connection or a serial port, into a
+    reusable buffer, and decodes the messages straight from it without copying.
+
+    Frames are the encodings of message_type, of its ``BYTES_LENGTH`` bytes each, or
+    the frames of a log container (without its header and index), of which the tags
+    are mapped to message types by message_types. Frames of other tags are skipped,
+    and frames shorter than their message type are decoded as zero-padded.
+
+    The messages decoded from the bytes of each read are passed to on_messages as a
+    list, in order. Only a frame split across reads is moved to the buffer's front.
+
+    :param buffer_size: Initial number of bytes of the buffer, doubled if a single frame
+       doesn't fit.
+    """
+
+    def __init__(
+        self,
+        on_messages: Callable[[List[Any]], None],
+        message_type: Optional[Any] = None,
+        message_types: Optional[Dict[int, Any]] = None,
+        buffer_size: int = 65536,
+    ) -> None:
+        if (message_type is None) == (message_types is None):
+            raise ValueError("bitproto: either message_type or message_types")
+        self.on_messages = on_messages
+        self.message_type = message_type
+        self.message_types = message_types
+        self.buf = bytearray(buffer_size)
+        # The bytes received and not decoded yet are buf[start:end].
+        self.start = 0
+        self.end = 0
+
+    def get_buffer(self, sizehint: int) -> memoryview:
+        if self.end == len(self.buf):
+            n = self.end - self.start
+            if n == len(self.buf):
+                buf = bytearray(2 * n)
+                buf[:n] = self.buf
+                self.buf = buf
+            else:
+                self.buf[:n] = self.buf[self.start : self.end]
+            self.start, self.end = 0, n
+        return memoryview(self.buf)[self.end :]
+
+    def buffer_updated(self, nbytes: int) -> None:
+        self.end += nbytes
+        if self.message_types is None:
+            messages = self.decode_fixed_frames()
+        else:
+            messages = self.decode_log_frames()
+        if self.start == self.end:
+            self.start = self.end = 0
+        if messages:
+            self.on_messages(messages)
+
+    def decode_fixed_frames(self) -> List[Any]:
+        messages: List[Any] = []
+        t = self.message_type
+        n = t.BYTES_LENGTH
+        i = self.start
+        while self.end - i >= n:
+            m = t()
+            m.decode_from(self.buf, i)
+            messages.append(m)
+            i += n
+        self.start = i
+        return messages
+
+    def decode_log_frames(self) -> List[Any]:
+        messages: List[Any] = []
+        types = self.message_types
+        assert types is not None
+        i = self.start
+        while self.end - i >= LOG_FRAME_HEADER_LENGTH:
+            tag, n = struct.unpack_from("<HH", self.buf, i)
+            j = i + LOG_FRAME_HEADER_LENGTH
+            if self.end - j < n:
+                break
+            t = types.get(tag)
+            if t is not None:
+                m = t()
+                if n >= t.BYTES_LENGTH:
+                    m.decode_from(self.buf, j)
+                else:
+                    s = bytearray(t.BYTES_LENGTH)
+                    s[:n] = memoryview(self.buf)[j : j + n]
+                    m.decode_from(s)
+                messages.append(m)
+            i = j + n
+        self.start = i
+        return messages
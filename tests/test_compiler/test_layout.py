@@ -0,0 +1,141 @@
+import os
+
+from bitproto._ast import Array, Byte, Enum, Message
+from bitproto.layout import (
+    c_field_type,
+    c_struct_layout,
+    count_unaligned,
+    fingerprint,
+    format_signature,
+    has_validated_enums,
+    is_memcpy_type,
+    is_validated_enum,
+    layout_fields,
+    memcpy_runs,
+    report,
+    suggest_order,
+)
+from bitproto.parser import parse
+from bitproto.utils import cast_or_raise
+
+
+def bitproto_filepath(filename: str) -> str:
+    return os.path.join(os.path.dirname(__file__), "parser-cases", filename)
+
+
+def test_layout_drone() -> None:
+    proto = parse(bitproto_filepath("drone.bitproto"))
+    drone = cast_or_raise(Message, proto.get_member("Drone"))
+    layouts = layout_fields(drone, drone.sorted_fields())
+
+    offset = 0
+    for layout, field in zip(layouts, drone.sorted_fields()):
+        assert layout.field is field
+        assert layout.offset == offset
+        offset += field.type.nbits()
+    assert offset == drone.nbits()
+
+    order = suggest_order(drone)
+    if order is not None:
+        assert count_unaligned(layout_fields(drone, order)) < count_unaligned(layouts)
+        assert sorted(f.number for f in order) == sorted(f.number for f in drone.fields())
+
+    assert "message Drone" in report(proto)
+
+
+def test_layout_c_struct() -> None:
+    proto = parse(bitproto_filepath("drone.bitproto"))
+    network = cast_or_raise(Message, proto.get_member("Network"))
+    size, alignment, padding = c_struct_layout(network)
+    # uint4 signal, Timestamp(int64) heartbeat_at
+    assert (size, alignment, padding) == (16, 8, 7)
+
+    proto = parse(bitproto_filepath("option_.bitproto"))
+    a = cast_or_raise(Message, proto.get_member("A"))
+    assert c_struct_layout(a) == (1, 1, 0)
+
+
+def test_layout_memcpy() -> None:
+    proto = parse(bitproto_filepath("drone.bitproto"))
+    position = cast_or_raise(Message, proto.get_member("Position"))
+    flight = cast_or_raise(Message, proto.get_member("Flight"))
+    drone = cast_or_raise(Message, proto.get_member("Drone"))
+    network = cast_or_raise(Message, proto.get_member("Network"))
+
+    # uint32 latitude, longitude, altitude
+    assert is_memcpy_type(position)
+    assert [[f.name for f in run] for run in memcpy_runs(position)] == [
+        ["latitude", "longitude", "altitude"]
+    ]
+    # Pose pose, TernaryInt32(int32[3]) velocity, acceleration
+    assert is_memcpy_type(flight)
+    # DroneStatus(uint3) status comes first.
+    assert not is_memcpy_type(drone)
+    assert memcpy_runs(drone) == []
+    # uint4 signal
+    assert not is_memcpy_type(network)
+
+    assert "same as the encoding (memcpy)" in report(proto)
+
+
+def test_layout_fingerprint() -> None:
+    proto = parse(bitproto_filepath("drone.bitproto"))
+    position = cast_or_raise(Message, proto.get_member("Position"))
+    network = cast_or_raise(Message, proto.get_member("Network"))
+    drone = cast_or_raise(Message, proto.get_member("Drone"))
+
+    assert format_signature(position) == "{uint32;uint32;uint32}"
+    # Aliases are resolved: Timestamp is int64.
+    assert format_signature(network) == "{uint4;int64}"
+    # FNV-1a of the signature, pinned: generated code of any version agrees.
+    assert fingerprint(network) == 0x374CD8E548884F05
+    assert fingerprint(position) != fingerprint(network)
+    assert f"fingerprint: 0x{fingerprint(drone):016x}" in report(proto)
+
+    proto_again = parse(bitproto_filepath("drone.bitproto"))
+    drone_again = cast_or_raise(Message, proto_again.get_member("Drone"))
+    assert fingerprint(drone_again) == fingerprint(drone)
+
+
+def test_layout_c_bool_bitset() -> None:
+    proto = parse(bitproto_filepath("bool_bitset.bitproto"))
+    status = cast_or_raise(Message, proto.get_member("Status"))
+    faults, leds, modes, flags = status.sorted_fields()
+
+    # bool[128] faults is a bitset of 16 bytes, the same 128 bits on the wire.
+    t = cast_or_raise(Array, c_field_type(faults))
+    assert isinstance(t.element_type, Byte) and t.cap == 16
+    assert t.nbits() == faults.type.nbits()
+    assert c_field_type(faults) is t
+    assert [[f.name for f in run] for run in memcpy_runs(status)] == [["faults"]]
+    # Not a multiple of 8 elements, extensible, or declared by an alias.
+    assert c_field_type(leds) is leds.type
+    assert c_field_type(modes) is modes.type
+    assert c_field_type(flags) is flags.type
+    # 16 + 12 + 8 + 16 bytes.
+    assert c_struct_layout(status) == (52, 1, 0)
+
+
+def test_layout_validate_enums() -> None:
+    proto = parse(bitproto_filepath("validate_enums.bitproto"))
+    status = cast_or_raise(Enum, proto.get_member("Status"))
+    switch = cast_or_raise(Enum, proto.get_member("Switch"))
+    code = cast_or_raise(Enum, proto.get_member("Code"))
+    reading = cast_or_raise(Message, proto.get_member("Reading"))
+    report = cast_or_raise(Message, proto.get_member("Report"))
+    plain = cast_or_raise(Message, proto.get_member("Plain"))
+
+    # Value 3 of uint2 is not declared.
+    assert is_validated_enum(status)
+    # Every value of uint1 is declared.
+    assert not is_validated_enum(switch)
+    assert is_validated_enum(code)
+    assert not is_memcpy_type(code)
+
+    assert has_validated_enums(reading)
+    # Code[4] inside an alias.
+    assert has_validated_enums(report)
+    assert not has_validated_enums(plain)
+
+    drone = parse(bitproto_filepath("drone.bitproto"))
+    assert not has_validated_enums(drone.get_member("Drone"))
@@ -0,0 +1,282 @@
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import pytest
+
+from bitproto._main import compile_file, main_batch, split_outdir
+
+
+def bitproto_filepath(filename: str) -> str:
+    return os.path.join(os.path.dirname(__file__), "parser-cases", filename)
+
+
+def test_split_outdir() -> None:
+    assert split_outdir(["a.bitproto"], None) == (["a.bitproto"], None)
+    assert split_outdir(["a.bitproto", "out"], None) == (["a.bitproto"], "out")
+    assert split_outdir(["a.bitproto", "b.bitproto"], None) == (
+        ["a.bitproto", "b.bitproto"],
+        None,
+    )
+    assert split_outdir(["a.bitproto", "b.bitproto", "out"], None) == (
+        ["a.bitproto", "b.bitproto"],
+        "out",
+    )
+    assert split_outdir(["a.proto", "b.proto"], "out") == (
+        ["a.proto", "b.proto"],
+        "out",
+    )
+    with pytest.raises(ValueError):
+        split_outdir(["a.bitproto", "b.proto", "out"], None)
+
+
+def run_bitproto_cli(*args: str) -> "subprocess.CompletedProcess[str]":
+    code = "from bitproto._main import run_bitproto; run_bitproto()"
+    return subprocess.run(
+        [sys.executable, "-c", code, *args], capture_output=True, text=True
+    )
+
+
+def test_cli_outdir() -> None:
+    with tempfile.TemporaryDirectory() as tmpdir:
+        # An input file with another extension is not taken as the output directory.
+        other = os.path.join(tmpdir, "drone.proto")
+        shutil.copy(bitproto_filepath("drone.bitproto"), other)
+        p = run_bitproto_cli("c", bitproto_filepath("drone.bitproto"), other, "-q")
+        assert p.returncode == 2
+        assert "is a file, not an output directory" in p.stderr
+
+        # Neither are mixed extensions of multiple files.
+        p = run_bitproto_cli("c", bitproto_filepath("drone.bitproto"), other, tmpdir)
+        assert p.returncode == 2
+        assert "doesn't end with '.bitproto'" in p.stderr
+        assert os.listdir(tmpdir) == ["drone.proto"]
+
+        p = run_bitproto_cli("c", other, "-o", tmpdir, "-q")
+        assert p.returncode == 0, p.stderr
+        assert os.path.isfile(os.path.join(tmpdir, "drone_bp.c"))
+
+
+def test_compile_file_error() -> None:
+    assert compile_file(bitproto_filepath("not_exist.bitproto"), lang="c")
+
+
+def test_main_batch() -> None:
+    filepaths = [
+        bitproto_filepath("drone.bitproto"),
+        bitproto_filepath("nested_import.bitproto"),
+        bitproto_filepath("drone.bitproto"),
+    ]
+    with tempfile.TemporaryDirectory() as outdir:
+        main_batch(filepaths, jobs=2, lang="c", outdir=outdir, disable_linter=True)
+        assert sorted(os.listdir(outdir)) == [
+            "drone_bp.c",
+            "drone_bp.h",
+            "nested_import_bp.c",
+            "nested_import_bp.h",
+        ]
+
+
+def test_depfile_and_skip_unchanged() -> None:
+    filepath = bitproto_filepath("nested_import.bitproto")
+    with tempfile.TemporaryDirectory() as outdir:
+        assert compile_file(filepath, lang="c", outdir=outdir, depfile=True) is None
+
+        with open(os.path.join(outdir, "nested_import_bp.d")) as f:
+            depfile = f.read()
+        assert depfile.startswith(os.path.join(outdir, "nested_import_bp.c"))
+        assert bitproto_filepath("shared_3.bitproto") + ":" in depfile
+
+        # Unchanged outputs are not rewritten.
+        out = os.path.join(outdir, "nested_import_bp.h")
+        os.utime(out, (0, 0))
+        assert compile_file(filepath, lang="c", outdir=outdir, depfile=True) is None
+        assert os.stat(out).st_mtime == 0
+
+
+def test_amalgamate() -> None:
+    filepath = bitproto_filepath("nested_import.bitproto")
+    assert compile_file(filepath, lang="go", amalgamate=True)
+    assert compile_file(filepath, lang="c", enable_optimize=True, amalgamate=True)
+
+    with tempfile.TemporaryDirectory() as outdir:
+        for name in ["shared_3", "shared_4", "nested_import"]:
+            filepath = bitproto_filepath(f"{name}.bitproto")
+            assert compile_file(filepath, lang="c", outdir=outdir) is None
+        assert compile_file(filepath, lang="c", outdir=outdir, amalgamate=True) is None
+
+        out = os.path.join(outdir, "nested_import_bp_amalgamation.c")
+        with open(out) as f:
+            amalgamation = f.read()
+        # Each proto is amalgamated once, though shared_4 is imported twice.
+        assert amalgamation.count("void BpXXXProcessTimestamp(void *data") == 2
+        assert "static void BpXXXProcessRecord(" in amalgamation
+
+        cc = shutil.which("cc")
+        if cc is None:
+            pytest.skip("no c compiler")
+        lib = os.path.join(os.path.dirname(__file__), "..", "..", "lib", "c")
+        obj = os.path.join(outdir, "nested_import.o")
+        subprocess.check_call(
+            [cc, "-c", "-Wall", "-Werror", out, "-I", outdir, "-I", lib, "-o", obj]
+        )
+
+
+def test_filter_messages_in_standard_mode() -> None:
+    filepath = bitproto_filepath("shared_3.bitproto")
+    assert compile_file(filepath, lang="go", filter_messages=["Record"])
+
+    with tempfile.TemporaryDirectory() as outdir:
+        error = compile_file(filepath, lang="c", outdir=outdir, filter_messages=["Record"])
+        assert error is None
+        for name in ["shared_3_bp.c", "shared_3_bp.h"]:
+            with open(os.path.join(outdir, name)) as f:
+                content = f.read()
+            assert "EncodeRecord(" in content
+            # Message B and B.C are unreachable from Record.
+            assert "EncodeB(" not in content
+            assert "BpXXXProcessBC(" not in content
+
+
+def test_bounded_array_in_optimization_mode() -> None:
+    filepath = bitproto_filepath("bounded_array.bitproto")
+    with tempfile.TemporaryDirectory() as outdir:
+        error = compile_file(filepath, lang="c", outdir=outdir, enable_optimize=True)
+        assert error and "Bounded arrays" in error
+        # Message Sample is fine, Frame is unreachable from it.
+        error = compile_file(
+            filepath,
+            lang="go",
+            outdir=outdir,
+            enable_optimize=True,
+            filter_messages=["Sample"],
+        )
+        assert error is None
+
+
+def test_bounded_stack() -> None:
+    filepath = bitproto_filepath("bounded_stack.bitproto")
+    with tempfile.TemporaryDirectory() as outdir:
+        # Message Command is extensible, not in fixed size.
+        error = compile_file(filepath, lang="c", outdir=outdir)
+        assert error and "Command" in error
+        error = compile_file(filepath, lang="c", outdir=outdir, filter_messages=["Pose"])
+        assert error is None
+        with open(os.path.join(outdir, "bounded_stack_bp.h")) as f:
+            header = f.read()
+        assert "#define BP_STACK_USAGE_POSE BP_STACK_USAGE_BOUND" in header
+        with open(os.path.join(outdir, "bounded_stack_bp.c")) as f:
+            source = f.read()
+        assert "BpEncodePlan(" in source
+        # No stack bounds in optimization mode, where nothing recurses.
+        error = compile_file(filepath, lang="c", outdir=outdir, enable_optimize=True)
+        assert error is None
+
+
+def test_self_test() -> None:
+    filepath = bitproto_filepath("self_test.bitproto")
+    with tempfile.TemporaryDirectory() as outdir:
+        assert compile_file(filepath, lang="c", outdir=outdir) is None
+        with open(os.path.join(outdir, "self_test_bp.h")) as f:
+            header = f.read()
+        assert "int BpSelfTestBatch(void);" in header
+        # Messages encoding to no bytes are not tested.
+        assert "BpSelfTestEmpty" not in header
+        with open(os.path.join(outdir, "self_test_bp.c")) as f:
+            source = f.read()
+        assert "static const struct Reading BpSelfTestReadingStructs[3] = {" in source
+        assert "static const int BpSelfTestBatchLengths[3] = {" in source
+
+        assert compile_file(filepath, lang="go", outdir=outdir) is None
+        with open(os.path.join(outdir, "self_test_bp.go")) as f:
+            assert "func BpSelfTestBatch() error {" in f.read()
+
+        # The same vectors on every run.
+        assert compile_file(filepath, lang="c", outdir=outdir) is None
+        with open(os.path.join(outdir, "self_test_bp.c")) as f:
+            assert f.read() == source
+
+        cc = shutil.which("cc")
+        if cc is None:
+            pytest.skip("no c compiler")
+        lib = os.path.join(os.path.dirname(__file__), "..", "..", "lib", "c")
+        main = os.path.join(outdir, "main.c")
+        with open(main, "w") as f:
+            f.write('#include "self_test_bp.h"\n')
+            f.write("int main(void) {\n")
+            f.write("    return BpSelfTestReading() || BpSelfTestBatch() ||\n")
+            f.write("           BpSelfTestSamples();\n")
+            f.write("}\n")
+        srcs = [main, os.path.join(outdir, "self_test_bp.c")]
+        srcs.append(os.path.join(lib, "bitproto.c"))
+        exe = os.path.join(outdir, "main")
+        # With and without the BMI2 kernels packing arrays of odd widths, which are
+        # compiled in on x86-64 only.
+        flags = ["-DBP_PACK_BMI2=0"]
+        if platform.machine().lower() in ("x86_64", "amd64"):
+            flags.append("-DBP_PACK_BMI2=1")
+        for flag in flags:
+            cmd = [cc, "-Wall", "-Werror", flag, *srcs, "-I", outdir, "-I", lib]
+            subprocess.check_call([*cmd, "-o", exe])
+            subprocess.check_call([exe])
+
+
+def test_packed_structs_without_unaligned_access() -> None:
+    """Runs the self test of packed structs, whose members are not aligned, with
+    misaligned accesses trapped by the undefined behavior sanitizer."""
+    cc = shutil.which("cc")
+    if cc is None:
+        pytest.skip("no c compiler")
+    filepath = bitproto_filepath("packed.bitproto")
+    lib = os.path.join(os.path.dirname(__file__), "..", "..", "lib", "c")
+    with tempfile.TemporaryDirectory() as outdir:
+        assert compile_file(filepath, lang="c", outdir=outdir) is None
+        main = os.path.join(outdir, "main.c")
+        with open(main, "w") as f:
+            f.write('#include "packed_bp.h"\n')
+            f.write("int main(void) { return BpSelfTestReading(); }\n")
+        srcs = [main, os.path.join(outdir, "packed_bp.c")]
+        srcs.append(os.path.join(lib, "bitproto.c"))
+        exe = os.path.join(outdir, "main")
+        flags = ["-fsanitize=alignment", "-fno-sanitize-recover=alignment"]
+        probe = os.path.join(outdir, "probe.c")
+        with open(probe, "w") as f:
+            f.write("int main(void) { return 0; }\n")
+        if subprocess.call([cc, *flags, probe, "-o", exe]) != 0:
+            pytest.skip("no undefined behavior sanitizer")
+        cmd = [cc, "-Wall", "-Werror", *flags, *srcs, "-I", outdir, "-I", lib]
+        subprocess.check_call([*cmd, "-o", exe])
+        subprocess.check_call([exe])
+        # The byte swaps of big-endian hosts, forced on this host: the self
+        # test mismatches then, but must not access members misaligned.
+        subprocess.check_call([*cmd, "-DBP_BIG_ENDIAN=1", "-o", exe])
+        process = subprocess.run([exe], stderr=subprocess.PIPE, text=True)
+        assert "runtime error" not in process.stderr
+
+
+def test_c_library_compiles_as_cpp() -> None:
+    cxx = shutil.which("c++")
+    if cxx is None:
+        pytest.skip("no c++ compiler")
+    lib = os.path.join(os.path.dirname(__file__), "..", "..", "lib", "c")
+    source = os.path.join(lib, "bitproto.c")
+    cmd = [cxx, "-x", "c++", "-Wall", "-Werror", "-fsyntax-only", "-I", lib, source]
+    subprocess.check_call(cmd)
+
+
+def test_self_test_without_bitprotolib() -> None:
+    filepath = bitproto_filepath("self_test.bitproto")
+    saved = sys.modules.get("bitprotolib")
+    sys.modules["bitprotolib"] = None  # type: ignore  # Import fails.
+    try:
+        with tempfile.TemporaryDirectory() as outdir:
+            error = compile_file(filepath, lang="c", outdir=outdir)
+            assert error and "bitprotolib" in error
+    finally:
+        if saved is None:
+            del sys.modules["bitprotolib"]
+        else:
+            sys.modules["bitprotolib"] = saved
@@ -1,4 +1,5 @@
 import os
+import tempfile
 from typing import Union as Fixture
 
 import pytest
@@ -9,16 +10,21 @@ from bitproto._ast import (
     BooleanConstant,
     Constant,
     Enum,
+    Fixed,
+    Float,
     Int,
     IntegerConstant,
     Message,
     MessageField,
+    Oneof,
     Option,
     Proto,
+    Range,
     StringConstant,
+    Uint,
 )
-from bitproto.errors import GrammarError
-from bitproto.parser import parse
+from bitproto.errors import GrammarError, InvalidFixedCap
+from bitproto.parser import Parser, parse, parse_table_cache_path, yacc_cached
 from bitproto.utils import cast_or_raise
 
 
@@ -249,6 +255,13 @@ def test_parse_extensible() -> None:
     assert message_m.nbits() == message_e.nbits() + 16
     assert array_h.nbits() == 3 * 8 + 16
 
+    assert not message_a.is_fixed_size()
+    assert message_b.is_fixed_size()
+    assert message_d.is_fixed_size()
+    assert not message_e.is_fixed_size()
+    assert not alias_h.is_fixed_size()
+    assert not message_m.is_fixed_size()
+
 
 def test_parse_extensible_traditional_mode() -> None:
     with pytest.raises(GrammarError):
@@ -270,6 +283,138 @@ def test_parse_message_size_constraint_by_option() -> None:
         parse(bitproto_filepath("message_size_constraint_by_option.bitproto"))
 
 
+def test_parse_large_message() -> None:
+    proto = parse(bitproto_filepath("large_message.bitproto"))
+
+    message_a = cast_or_raise(Message, proto.get_member("A"))
+    assert message_a.get_option_as_bool_or_raise("large")
+    assert message_a.nbits() == 160000
+
+
+def test_parse_large_message_extensible() -> None:
+    with pytest.raises(GrammarError):
+        parse(bitproto_filepath("large_message_extensible.bitproto"))
+
+
+def test_parse_range() -> None:
+    proto = parse(bitproto_filepath("range.bitproto"))
+
+    message = cast_or_raise(Message, proto.get_member("Telemetry"))
+    altitude, battery, temperature, fixed, armed = message.sorted_fields()
+
+    altitude_type = cast_or_raise(Range, altitude.type)
+    assert isinstance(altitude_type.type, Uint)
+    assert altitude_type.lo == 1000
+    assert altitude_type.hi == 21000
+    assert altitude_type.nbits() == 15
+    assert battery.type.nbits() == 7
+    temperature_type = cast_or_raise(Range, temperature.type)
+    assert isinstance(temperature_type.type, Int)
+    assert temperature_type.lo == -40
+    assert temperature_type.nbits() == 7
+    assert fixed.type.nbits() == 1
+    assert isinstance(armed.type, Bool)
+    assert message.nbits() == 15 + 7 + 7 + 1 + 1
+
+
+def test_parse_range_invalid() -> None:
+    for filename in (
+        "range_out_of_type.bitproto",
+        "range_reversed.bitproto",
+        "range_not_integer.bitproto",
+        "range_option_not_supported.bitproto",
+    ):
+        with pytest.raises(GrammarError):
+            parse(bitproto_filepath(filename))
+
+
+def test_parse_oneof() -> None:
+    proto = parse(bitproto_filepath("oneof_.bitproto"))
+
+    oneof = cast_or_raise(Oneof, proto.get_member("Command"))
+    ping, move = oneof.sorted_variants()
+    assert ping.tag == 1
+    assert ping.type is proto.get_member("Ping")
+    assert move.tag == 5
+    assert move.oneof is oneof
+    assert move.comment_block[0].content() == "Move to."
+    assert oneof.tag_nbits() == 3
+    assert oneof.nbits() == 3 + 33
+    assert oneof.nbytes() == 5
+    assert oneof.variant_nbytes(ping) == 5
+    assert oneof.comment_block[0].content() == "Command sent to the drone."
+
+
+def test_parse_oneof_invalid() -> None:
+    for filename in (
+        "oneof_variant_not_message.bitproto",
+        "oneof_variant_not_fixed_size.bitproto",
+        "oneof_variant_tag_constraint.bitproto",
+        "duplicate_oneof_variant_tag.bitproto",
+        "empty_oneof.bitproto",
+        "oneof_as_type.bitproto",
+    ):
+        with pytest.raises(GrammarError):
+            parse(bitproto_filepath(filename))
+
+
+def test_parse_bounded_array() -> None:
+    proto = parse(bitproto_filepath("bounded_array.bitproto"))
+
+    message = cast_or_raise(Message, proto.get_member("Frame"))
+    seq, samples, payload = message.sorted_fields()
+    samples_type = cast_or_raise(Array, samples.type)
+    assert samples_type.bounded
+    assert samples_type.cap == 5
+    assert samples_type.count_nbits() == 3
+    assert samples_type.nbits() == 3 + 5 * 12
+    payload_type = cast_or_raise(Array, payload.type)
+    assert payload_type.count_nbits() == 4
+    assert not payload_type.is_fixed_size()
+    assert not message.is_fixed_size()
+    assert message.has_bounded_array()
+    assert message.nbits() == 8 + 63 + 68
+
+
+def test_parse_bounded_array_invalid() -> None:
+    for filename in (
+        "bounded_array_aliased.bitproto",
+        "bounded_array_in_extensible_message.bitproto",
+        "bounded_array_in_extensible_array.bitproto",
+        "bounded_array_direct_codec.bitproto",
+        "bounded_array_zero_cap.bitproto",
+    ):
+        with pytest.raises(GrammarError):
+            parse(bitproto_filepath(filename))
+
+
+def test_parse_float_fixed() -> None:
+    proto = parse(bitproto_filepath("float_fixed.bitproto"))
+
+    message = cast_or_raise(Message, proto.get_member("Reading"))
+    value, heading, speed, temperature, latitude, samples = message.sorted_fields()
+
+    assert isinstance(value.type, Float)
+    assert value.type.nbits() == 32
+    heading_type = cast_or_raise(Fixed, heading.type)
+    assert (heading_type.cap, heading_type.frac, heading_type.signed) == (16, 8, True)
+    assert not heading_type.is_double()
+    speed_type = cast_or_raise(Fixed, speed.type)
+    assert (speed_type.cap, speed_type.frac, speed_type.signed) == (10, 6, False)
+    assert speed_type.unit() == 2.0 ** -6
+    assert temperature.type.nbits() == 12
+    latitude_type = cast_or_raise(Fixed, latitude.type)
+    assert latitude_type.is_double()
+    assert latitude_type.scale() == float(1 << 20)
+    assert samples.type.nbits() == 3 * 32
+    assert message.nbits() == 32 + 16 + 10 + 12 + 40 + 96
+
+
+def test_parse_fixed_cap_invalid() -> None:
+    with pytest.raises(InvalidFixedCap):
+        parse(bitproto_filepath("fixed_cap.bitproto"))
+
+
 def test_parse_2d_array() -> None:
     proto = parse(bitproto_filepath("_2d_array.bitproto"))
 
@@ -528,3 +673,24 @@ def test_constants() -> None:
 
 def test_parse_signed_int() -> None:
     parse(bitproto_filepath("signed_int.bitproto"))
+
+
+def test_parse_table_cache() -> None:
+    with tempfile.TemporaryDirectory() as cache_dir:
+        environ = os.environ.copy()
+        os.environ["BITPROTO_CACHE_DIR"] = cache_dir
+        try:
+            path = parse_table_cache_path()
+            assert not os.path.exists(path)
+
+            parser = Parser()
+            yacc_cached(parser)  # Generates and writes the cache.
+            assert os.path.exists(path)
+            yacc_cached(parser)  # Reads the cache.
+        finally:
+            os.environ.clear()
+            os.environ.update(environ)
+
+    # Parsers share tables in process, each binds its own grammar functions.
+    assert parse(bitproto_filepath("drone.bitproto")).name == "drone"
+    assert parse(bitproto_filepath("nested_import.bitproto")).name == "nested_import"
@@ -0,0 +1,38 @@
+import os
+import struct
+
+from bitproto._ast import Message
+from bitproto.layout import fingerprint
+from bitproto.parser import parse
+from bitproto.schema import FLAG_ENUM, FLAG_INT, MAGIC, dump
+from bitproto.utils import cast_or_raise
+
+
+def bitproto_filepath(filename: str) -> str:
+    return os.path.join(os.path.dirname(__file__), "parser-cases", filename)
+
+
+def test_schema_drone() -> None:
+    proto = parse(bitproto_filepath("drone.bitproto"))
+    network = cast_or_raise(Message, proto.get_member("Network"))
+    b = dump(proto)
+
+    assert b[:4] == MAGIC
+    version, reserved, nmessages = struct.unpack("<BBH", b[4:8])
+    assert (version, reserved) == (1, 0)
+    assert nmessages == len(list(proto.messages(recursive=True, bound=proto)))
+
+    # Message Network: uint4 signal, Timestamp (alias of int64) heartbeat_at.
+    name = b"\x07Network"
+    i = b.index(name) + len(name)
+    assert struct.unpack("<QBH", b[i : i + 11]) == (fingerprint(network), 0, 2)
+    i += 11
+    assert b[i : i + 9] == b"\x06signal" + bytes([3, 4])
+    i += 9
+    assert b[i : i + 15] == b"\x0cheartbeat_at" + bytes([FLAG_INT, 64])
+
+    drone_status = b"\x06status" + bytes([FLAG_ENUM, 3])
+    assert drone_status in b
+
+    # Stable across runs.
+    assert dump(parse(bitproto_filepath("drone.bitproto"))) == b
@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "arrays_bp.h"
 
@@ -19,6 +20,19 @@ int main(void) {
     m.x[0] = -13;
     m.x[1] = -89;
     m.x[2] = 13;
+    m.h = 5;
+    for (int i = 0; i < 11; i++) m.y[i] = (unsigned char)(i * 23 + 1);
+    m.z[0] = -300;
+    m.z[1] = 7;
+    m.z[2] = 32767;
+    m.w[0] = 0x0123456789abcdefULL;
+    m.w[1] = 0xfedcba9876543210ULL;
+    for (int i = 0; i < 33; i++) m.p[i] = (unsigned char)(i * 7 + 3);
+    for (int i = 0; i < 40; i++) m.q[i] = (uint8_t)((i * 3) & 31);
+    for (int i = 0; i < 20; i++) m.r[i] = (int16_t)(i * 211 - 2000);
+    for (int i = 0; i < 17; i++) m.u[i] = (i % 3) == 0;
+    for (int i = 0; i < 18; i++)
+        m.v[i] = (struct Note){i & 7, (i % 3) == 0, {i & 7, 6, 5, 4, 3, 2, 1}};
     unsigned char s[BYTES_LENGTH_M] = {0};
     EncodeM(&m, s);
 
@@ -47,6 +61,47 @@ int main(void) {
     assert(m1.x[0] == m.x[0]);
     assert(m1.x[1] == m.x[1]);
     assert(m1.x[2] == m.x[2]);
+    assert(m1.h == m.h);
+    for (int i = 0; i < 11; i++) assert(m1.y[i] == m.y[i]);
+    for (int i = 0; i < 3; i++) assert(m1.z[i] == m.z[i]);
+    for (int i = 0; i < 2; i++) assert(m1.w[i] == m.w[i]);
+    for (int i = 0; i < 33; i++) assert(m1.p[i] == m.p[i]);
+    for (int i = 0; i < 40; i++) assert(m1.q[i] == m.q[i]);
+    for (int i = 0; i < 20; i++) assert(m1.r[i] == m.r[i]);
+    for (int i = 0; i < 17; i++) assert(m1.u[i] == m.u[i]);
+    for (int i = 0; i < 18; i++) {
+        for (int j = 0; j < 7; j++) assert(m1.v[i].arr[j] == m.v[i].arr[j]);
+        assert(m1.v[i].number == m.v[i].number);
+        assert(m1.v[i].ok == m.v[i].ok);
+    }
+
+#ifndef BITPROTO_OPTIMIZATION_MODE
+    // Packing and unpacking uint12[256] at an odd bit, compared to the bits
+    // encoded element by element, and the bits around are kept.
+    static uint16_t adc[256], adc1[256];
+    static unsigned char sa[387], sa1[387];
+    for (int i = 0; i < 256; i++) adc[i] = (uint16_t)((i * 2857) & 4095);
+    memset(sa, 0xff, sizeof(sa));
+    memset(sa1, 0xff, sizeof(sa1));
+    struct BpProcessorContext ca = BpProcessorContext(true, sa);
+    ca.i = 3;
+    BpEncodeIntegers(2, 12, 256, &ca, adc);
+    assert(ca.i == 3 + 12 * 256);
+    struct BpProcessorContext cb = BpProcessorContext(true, sa1);
+    cb.i = 3;
+    for (int i = 0; i < 256; i++) BpEncodeIntegers(2, 12, 1, &cb, &adc[i]);
+    assert(memcmp(sa, sa1, sizeof(sa)) == 0);
+    struct BpProcessorContext da = BpProcessorContextN(false, sa, sizeof(sa));
+    da.i = 3;
+    BpDecodeUintArray(2, 12, 256, &da, adc1);
+    for (int i = 0; i < 256; i++) assert(adc1[i] == adc[i]);
+    // Elements out of the bounds of the buffer are skipped.
+    memset(adc1, 0, sizeof(adc1));
+    struct BpProcessorContext db = BpProcessorContextN(false, sa, 20);
+    db.i = 3;
+    BpDecodeUintArray(2, 12, 256, &db, adc1);
+    for (int i = 0; i < 256; i++) assert(adc1[i] == ((i < 13) ? adc[i] : 0));
+#endif
 
     return 0;
 }
@@ -0,0 +1,88 @@
+#include <cassert>
+#include <cstdio>
+
+#include "arrays_bp.hpp"
+
+int main(void) {
+    // Encode.
+    struct M m = {};
+    for (int i = 0; i < 7; i++) m.a[i] = (unsigned char)(i);
+    for (int i = 0; i < 7; i++) m.b[i] = (int32_t)(i);
+    for (int i = 0; i < 7; i++) m.c[i] = (int8_t)(i);
+    for (int i = 0; i < 7; i++) m.d[i] = (uint8_t)(i & 7);
+    for (int i = 0; i < 7; i++) m.e[i] = (uint32_t)(i + 118);
+    for (int i = 0; i < 7; i++) {
+        m.f[i].number = (uint8_t)(i);
+        m.f[i].ok = false;
+        for (int j = 0; j < 7; j++) m.f[i].arr[j] = (uint8_t)(j + 1);
+    }
+    m.g.number = 2;
+    m.g.ok = false;
+    for (int j = 0; j < 7; j++) m.g.arr[j] = (uint8_t)(j + 1);
+    m.g.arr[0] = 7;
+    for (int i = 0; i < 7; i++)
+        for (int j = 0; j < 7; j++) m.t[i][j] = (int32_t)(i + j + 129);
+    m.x[0] = -13;
+    m.x[1] = -89;
+    m.x[2] = 13;
+    m.h = 5;
+    for (int i = 0; i < 11; i++) m.y[i] = (unsigned char)(i * 23 + 1);
+    m.z[0] = -300;
+    m.z[1] = 7;
+    m.z[2] = 32767;
+    m.w[0] = 0x0123456789abcdefULL;
+    m.w[1] = 0xfedcba9876543210ULL;
+    for (int i = 0; i < 33; i++) m.p[i] = (unsigned char)(i * 7 + 3);
+    for (int i = 0; i < 40; i++) m.q[i] = (uint8_t)((i * 3) & 31);
+    for (int i = 0; i < 20; i++) m.r[i] = (int16_t)(i * 211 - 2000);
+    for (int i = 0; i < 17; i++) m.u[i] = (i % 3) == 0;
+    for (int i = 0; i < 18; i++) {
+        m.v[i].number = (uint8_t)(i & 7);
+        m.v[i].ok = (i % 3) == 0;
+        m.v[i].arr[0] = (uint8_t)(i & 7);
+        for (int j = 1; j < 7; j++) m.v[i].arr[j] = (uint8_t)(7 - j);
+    }
+    unsigned char s[BYTES_LENGTH_M] = {0};
+    bitproto::Encode(m, s);
+
+    // Output
+    for (int i = 0; i < BYTES_LENGTH_M; i++) printf("%u ", s[i]);
+
+    // Decode.
+    struct M m1 = {};
+    bitproto::Decode(m1, s);
+
+    for (int i = 0; i < 7; i++) assert(m1.a[i] == m.a[i]);
+    for (int i = 0; i < 7; i++) assert(m1.b[i] == m.b[i]);
+    for (int i = 0; i < 7; i++) assert(m1.c[i] == m.c[i]);
+    for (int i = 0; i < 7; i++) assert(m1.d[i] == m.d[i]);
+    for (int i = 0; i < 7; i++) assert(m1.e[i] == m.e[i]);
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 7; j++) assert(m1.f[i].arr[j] == m.f[i].arr[j]);
+        assert(m1.f[i].number == m.f[i].number);
+        assert(m1.f[i].ok == m.f[i].ok);
+    }
+    for (int j = 0; j < 7; j++) assert(m1.g.arr[j] == m.g.arr[j]);
+    assert(m1.g.number == m.g.number);
+    assert(m1.g.ok == m.g.ok);
+    for (int i = 0; i < 7; i++)
+        for (int j = 0; j < 7; j++) assert(m1.t[i][j] == m.t[i][j]);
+    assert(m1.x[0] == m.x[0]);
+    assert(m1.x[1] == m.x[1]);
+    assert(m1.x[2] == m.x[2]);
+    assert(m1.h == m.h);
+    for (int i = 0; i < 11; i++) assert(m1.y[i] == m.y[i]);
+    for (int i = 0; i < 3; i++) assert(m1.z[i] == m.z[i]);
+    for (int i = 0; i < 2; i++) assert(m1.w[i] == m.w[i]);
+    for (int i = 0; i < 33; i++) assert(m1.p[i] == m.p[i]);
+    for (int i = 0; i < 40; i++) assert(m1.q[i] == m.q[i]);
+    for (int i = 0; i < 20; i++) assert(m1.r[i] == m.r[i]);
+    for (int i = 0; i < 17; i++) assert(m1.u[i] == m.u[i]);
+    for (int i = 0; i < 18; i++) {
+        for (int j = 0; j < 7; j++) assert(m1.v[i].arr[j] == m.v[i].arr[j]);
+        assert(m1.v[i].number == m.v[i].number);
+        assert(m1.v[i].ok == m.v[i].ok);
+    }
+
+    return 0;
+}
@@ -41,6 +41,27 @@ func main() {
 	m.X[0] = -13
 	m.X[1] = -89
 	m.X[2] = 13
+	m.H = 5
+	for i := 0; i < 11; i++ {
+		m.Y[i] = byte(i*23 + 1)
+	}
+	m.Z = [3]int16{-300, 7, 32767}
+	m.W = [2]uint64{0x0123456789abcdef, 0xfedcba9876543210}
+	for i := 0; i < 33; i++ {
+		m.P[i] = byte(i*7 + 3)
+	}
+	for i := 0; i < 40; i++ {
+		m.Q[i] = uint8((i * 3) & 31)
+	}
+	for i := 0; i < 20; i++ {
+		m.R[i] = int16(i*211 - 2000)
+	}
+	for i := 0; i < 17; i++ {
+		m.U[i] = (i % 3) == 0
+	}
+	for i := 0; i < 18; i++ {
+		m.V[i] = bp.Note{uint8(i & 7), (i % 3) == 0, bp.Uint3s{uint8(i & 7), 6, 5, 4, 3, 2, 1}}
+	}
 
 	s := m.Encode()
 	for _, x := range s {
@@ -85,4 +106,13 @@ func main() {
 	assert(m1.X[0] == m.X[0])
 	assert(m1.X[1] == m.X[1])
 	assert(m1.X[2] == m.X[2])
+	assert(m1.H == m.H)
+	assert(m1.Y == m.Y)
+	assert(m1.Z == m.Z)
+	assert(m1.W == m.W)
+	assert(m1.P == m.P)
+	assert(m1.Q == m.Q)
+	assert(m1.R == m.R)
+	assert(m1.U == m.U)
+	assert(m1.V == m.V)
 }
@@ -22,6 +22,18 @@ def main() -> None:
     m.x[1] = -89
     m.x[2] = 13
     m.g = bp.Note(2, False, [7, 2, 3, 4, 5, 6, 7])
+    m.h = 5
+    for i in range(11):
+        m.y[i] = i * 23 + 1
+    m.z = [-300, 7, 32767]
+    m.w = [0x0123456789ABCDEF, 0xFEDCBA9876543210]
+    for i in range(33):
+        m.p[i] = i * 7 + 3
+    m.q = [(i * 3) & 31 for i in range(40)]
+    m.r = [i * 211 - 2000 for i in range(20)]
+    m.u = [(i % 3) == 0 for i in range(17)]
+    for i in range(18):
+        m.v[i] = bp.Note(i & 7, (i % 3) == 0, [i & 7, 6, 5, 4, 3, 2, 1])
     s = m.encode()
 
     for x in s:
@@ -55,6 +67,18 @@ def main() -> None:
     assert m1.x[0] == m.x[0]
     assert m1.x[1] == m.x[1]
     assert m1.x[2] == m.x[2]
+    assert m1.h == m.h
+    assert list(m1.y) == list(m.y)
+    assert list(m1.z) == list(m.z)
+    assert list(m1.w) == list(m.w)
+    assert list(m1.p) == list(m.p)
+    assert list(m1.q) == list(m.q)
+    assert list(m1.r) == list(m.r)
+    assert m1.u == m.u
+    for i in range(18):
+        assert list(m1.v[i].arr) == list(m.v[i].arr)
+        assert m1.v[i].number == m.v[i].number
+        assert m1.v[i].ok == m.v[i].ok
 
 
 if __name__ == "__main__":
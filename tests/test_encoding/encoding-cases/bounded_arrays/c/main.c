@@ -0,0 +1,87 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bounded_arrays_bp.h"
+
+int main(void) {
+    struct Frame frame = {0};
+    frame.seq = 7;
+    frame.samples.len = 3;
+    for (int i = 0; i < 3; i++) {
+        frame.samples.data[i] = (struct Sample){(int16_t)(i * 700 - 900), KIND_GYRO};
+        frame.samples.data[i].tag[0] = (unsigned char)(0x10 + i);
+        frame.samples.data[i].tag[1] = 0xc0;
+        frame.samples.data[i].axes[0] = (uint8_t)(i + 1);
+        frame.samples.data[i].axes[1] = (uint8_t)(15 - i);
+    }
+    frame.samples.data[1].kind = KIND_ACCEL;
+    frame.payload.len = 2;
+    frame.payload.data[0] = 0xab;
+    frame.payload.data[1] = 0xcd;
+    frame.payload.data[2] = 0xef;  // Not in use.
+    frame.readings.len = 0;
+    frame.flags.len = 7;
+    for (int i = 0; i < 7; i++) frame.flags.data[i] = (uint8_t)i;
+    frame.last = true;
+    frame.blob.data.len = 1;
+    frame.blob.data.data[0] = 0x5a;
+
+    // Encode, only the elements in use take bits.
+    unsigned char s[BYTES_LENGTH_FRAME] = {0};
+    int n = EncodeFrame(&frame, s);
+    assert(n > 0 && n < BYTES_LENGTH_FRAME);
+    for (int i = 0; i < n; i++) printf("%u ", s[i]);
+    printf("\n");
+
+    // Decode.
+    struct Frame frame_new;
+    memset(&frame_new, 0xff, sizeof(frame_new));
+    assert(DecodeFrameN(&frame_new, s, n) == 0);
+    assert(frame_new.samples.len == 3);
+    assert(frame_new.samples.data[0].value == -900);
+    assert(frame_new.samples.data[1].kind == KIND_ACCEL);
+    assert(frame_new.samples.data[2].value == 500);
+    assert(frame_new.samples.data[2].tag[0] == 0x12 && frame_new.samples.data[2].tag[1] == 0xc0);
+    assert(frame_new.samples.data[2].axes[0] == 3 && frame_new.samples.data[2].axes[1] == 13);
+    assert(frame_new.payload.len == 2);
+    assert(frame_new.payload.data[1] == 0xcd);
+    assert(frame_new.readings.len == 0);
+    assert(frame_new.flags.len == 7 && frame_new.flags.data[6] == 6);
+    assert(frame_new.last);
+    assert(frame_new.blob.data.len == 1 && frame_new.blob.data.data[0] == 0x5a);
+    assert(EqualFrame(&frame, &frame_new));
+    assert(HashFrame(&frame) == HashFrame(&frame_new));
+
+    // Elements not in use are not compared.
+    frame_new.payload.data[2] = 0;
+    assert(EqualFrame(&frame, &frame_new));
+    frame_new.payload.len = 3;
+    assert(!EqualFrame(&frame, &frame_new));
+
+    // Decoding a buffer shorter than the elements in use fails.
+    assert(DecodeFrameN(&frame_new, s, n - 1) == BP_ERR_SHORT_INPUT);
+
+    // A count exceeding the capacity, the samples' count is in the 3 bits
+    // after the seq.
+    unsigned char t[BYTES_LENGTH_FRAME] = {0};
+    memcpy(t, s, (size_t)n);
+    t[1] |= 7;
+    assert(DecodeFrame(&frame_new, t) == BP_ERR_COUNT);
+    assert(frame_new.samples.len == 5);
+
+    // Json.
+    char js[JSON_MAX_LENGTH_FRAME + 1];
+    int m = JsonFrameN(&frame, js, sizeof(js));
+    assert(m < (int)sizeof(js));
+    printf("%s", js);
+
+    // Json parsing round trip, the counts are the elements parsed.
+    struct Frame frame_json;
+    memset(&frame_json, 0, sizeof(frame_json));
+    assert(ParseJsonFrame(&frame_json, js, m) == 0);
+    assert(EqualFrame(&frame, &frame_json));
+    const char *bad = "{\"readings\": [1, 2, 3, 4, 5]}";
+    assert(ParseJsonFrame(&frame_json, bad, (int)strlen(bad)) == BP_ERR_JSON);
+    return 0;
+}
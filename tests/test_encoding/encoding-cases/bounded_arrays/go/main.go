@@ -0,0 +1,95 @@
+package main
+
+import (
+	"fmt"
+	"testing"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/bounded_arrays/go/bp"
+	bitproto "github.com/hit9/bitproto/lib/go"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+func main() {
+	frame := &bp.Frame{}
+	frame.Seq = 7
+	for i := 0; i < 3; i++ {
+		frame.Samples = append(frame.Samples, bp.Sample{
+			Value: int16(i*700 - 900),
+			Kind:  bp.KIND_GYRO,
+			Tag:   [2]byte{byte(0x10 + i), 0xc0},
+			Axes:  [2]uint8{uint8(i + 1), uint8(15 - i)},
+		})
+	}
+	frame.Samples[1].Kind = bp.KIND_ACCEL
+	frame.Payload = []byte{0xab, 0xcd}
+	for i := 0; i < 7; i++ {
+		frame.Flags = append(frame.Flags, uint8(i))
+	}
+	frame.Last = true
+	frame.Blob.Data = []byte{0x5a}
+
+	// Encode, only the elements in use take bits.
+	s := frame.Encode()
+	assert(len(s) > 0 && len(s) < int(bp.BYTES_LENGTH_FRAME))
+	for _, b := range s {
+		fmt.Printf("%d ", b)
+	}
+	fmt.Printf("\n")
+	t := make([]byte, bp.BYTES_LENGTH_FRAME)
+	assert(frame.EncodeTo(t) == len(s))
+	assert(string(frame.AppendEncode([]byte{1})[1:]) == string(s))
+
+	// Decode.
+	frameNew := &bp.Frame{}
+	assert(frameNew.DecodeFrom(s) == nil)
+	assert(len(frameNew.Samples) == 3)
+	assert(frameNew.Samples[0].Value == -900)
+	assert(frameNew.Samples[1].Kind == bp.KIND_ACCEL)
+	assert(frameNew.Samples[2].Value == 500)
+	assert(frameNew.Samples[2].Tag == [2]byte{0x12, 0xc0})
+	assert(frameNew.Samples[2].Axes == [2]uint8{3, 13})
+	assert(len(frameNew.Payload) == 2 && frameNew.Payload[1] == 0xcd)
+	assert(len(frameNew.Readings) == 0)
+	assert(len(frameNew.Flags) == 7 && frameNew.Flags[6] == 6)
+	assert(frameNew.Last)
+	assert(len(frameNew.Blob.Data) == 1 && frameNew.Blob.Data[0] == 0x5a)
+	assert(frame.Equal(frameNew))
+	assert(frame.Hash() == frameNew.Hash())
+
+	// Elements beyond the capacity are dropped.
+	frameNew.Readings = []int32{1, 2, 3, 4, 5}
+	frameNew.Decode(frameNew.Encode())
+	assert(len(frameNew.Readings) == 4 && frameNew.Readings[3] == 4)
+	frameNew.Readings = frameNew.Readings[:0]
+	assert(frame.Equal(frameNew))
+
+	// Decoding a buffer shorter than the elements in use fails.
+	assert(frameNew.DecodeFrom(s[:len(s)-1]) == bitproto.ErrShortInput)
+
+	// A count exceeding the capacity, the samples' count is in the 3 bits after
+	// the seq.
+	copy(t, s)
+	t[1] |= 7
+	assert(frameNew.DecodeFrom(t) == bitproto.ErrCount)
+	assert(len(frameNew.Samples) == 5)
+
+	// Decoding into a reused struct truncates the bounded arrays, keeping their
+	// capacity, so that it doesn't allocate.
+	assert(frameNew.DecodeFrom(s) == nil)
+	frameNew.Readings = append(frameNew.Readings, 9)
+	frameNew.Decode(s)
+	assert(len(frameNew.Readings) == 0 && cap(frameNew.Readings) > 0)
+	assert(frame.Equal(frameNew))
+	assert(testing.AllocsPerRun(100, func() { frameNew.Decode(s) }) == 0)
+	frameNew.Reset()
+	assert(len(frameNew.Samples) == 0 && cap(frameNew.Samples) > 0)
+	assert(!frameNew.Last && len(frameNew.Blob.Data) == 0)
+
+	// Json.
+	fmt.Printf("%s", frame.String())
+}
@@ -0,0 +1,66 @@
+import bounded_arrays_bp as bp
+from bitprotolib.bp import CountExceedsCapacity, NotEnoughBytes
+
+
+def main() -> None:
+    frame = bp.Frame()
+    frame.seq = 7
+    frame.samples = [bp.Sample(value=i * 700 - 900, kind=bp.KIND_GYRO) for i in range(3)]
+    for i, sample in enumerate(frame.samples):
+        sample.tag = bytearray([0x10 + i, 0xC0])
+        sample.axes = [i + 1, 15 - i]
+    frame.samples[1].kind = bp.KIND_ACCEL
+    frame.payload = bytearray([0xAB, 0xCD])
+    frame.flags = list(range(7))
+    frame.last = True
+    frame.blob.data = bytearray([0x5A])
+
+    # Encode, only the elements in use take bits.
+    s = frame.encode()
+    assert 0 < len(s) < bp.Frame.BYTES_LENGTH
+    print("".join(f"{b} " for b in s))
+
+    # Decode.
+    frame_new = bp.Frame()
+    frame_new.decode(s)
+    assert len(frame_new.samples) == 3
+    assert frame_new.samples[0].value == -900
+    assert frame_new.samples[1].kind == bp.KIND_ACCEL
+    assert frame_new.samples[2].value == 500
+    assert frame_new.samples[2].tag == bytearray([0x12, 0xC0])
+    assert list(frame_new.samples[2].axes) == [3, 13]
+    assert frame_new.payload == bytearray([0xAB, 0xCD])
+    assert list(frame_new.readings) == []
+    assert list(frame_new.flags) == list(range(7))
+    assert frame_new.last
+    assert frame_new.blob.data == bytearray([0x5A])
+    assert frame_new.encode() == s
+
+    # Elements beyond the capacity are dropped.
+    frame_new.readings = [1, 2, 3, 4, 5]
+    frame_new.decode(frame_new.encode())
+    assert list(frame_new.readings) == [1, 2, 3, 4]
+
+    # Decoding a buffer shorter than the elements in use fails.
+    try:
+        frame_new.decode(s[:-1])
+        assert False, "unreachable"
+    except AssertionError as e:
+        assert isinstance(e.args[0], NotEnoughBytes)
+
+    # A count exceeding the capacity, the samples' count is in the 3 bits after the
+    # seq.
+    t = bytearray(s)
+    t[1] |= 7
+    try:
+        frame_new.decode(t)
+        assert False, "unreachable"
+    except CountExceedsCapacity:
+        pass
+
+    # Json.
+    print(frame.to_json(indent=None, separators=(",", ":")))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,7 +1,42 @@
+// The generated header goes first, for bitproto.h defines _GNU_SOURCE ahead of
+// the system headers with BP_MMSG.
+#include "drone_bp.h"
+
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
-#include "drone_bp.h"
+#ifndef BITPROTO_OPTIMIZATION_MODE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// A producer thread encoding drones of altitudes 0..NRING-1 into a ring.
+enum { NRING = 10000 };
+static struct BpRing ring;
+
+static void *RingProduce(void *arg) {
+    struct Drone d = *(struct Drone *)arg;
+    for (int k = 0; k < NRING; k++) {
+        d.position.altitude = (uint32_t)k;
+        while (EncodeDroneInto(&ring, &d) == BP_ERR_RING) sched_yield();
+    }
+    return NULL;
+}
+
+// A fake transmitter recording the frames started, completed by hand.
+static const unsigned char *tx_started[4];
+static int tx_nstarted = 0;
+
+static void TxStart(const unsigned char *s, int n, void *arg) {
+    assert(n == BYTES_LENGTH_DRONE && arg == &tx_nstarted);
+    tx_started[tx_nstarted++] = s;
+}
+#endif
 
 int main(void) {
     // Encode.
@@ -54,5 +89,264 @@ int main(void) {
     assert(drone_new.network.signal == drone.network.signal);
     assert(drone_new.network.heartbeat_at == drone.network.heartbeat_at);
     assert(drone_new.landing_gear.status == drone.landing_gear.status);
+
+    // Decode with bounds checking.
+    struct Drone drone_n = {0};
+    assert(DecodeDroneN(&drone_n, s, BYTES_LENGTH_DRONE - 1) ==
+           BP_ERR_SHORT_INPUT);
+    assert(DecodeDroneN(&drone_n, s, BYTES_LENGTH_DRONE) == 0);
+    assert(drone_n.network.heartbeat_at == drone.network.heartbeat_at);
+
+    // Batch encoding and decoding.
+    struct Drone drones[3] = {drone, drone, drone};
+    drones[1].position.altitude = 1081;
+    drones[2].flight.acceleration[0] = -1003;
+    unsigned char sb[3 * BYTES_LENGTH_DRONE] = {0};
+    EncodeDroneBatch(drones, 3, sb);
+
+    for (int k = 0; k < 3; k++) {
+        unsigned char s1[BYTES_LENGTH_DRONE] = {0};
+        EncodeDrone(&drones[k], s1);
+        assert(memcmp(sb + k * BYTES_LENGTH_DRONE, s1, BYTES_LENGTH_DRONE) ==
+               0);
+    }
+
+    struct Drone drones_new[3] = {{0}};
+    DecodeDroneBatch(drones_new, 3, sb);
+    assert(drones_new[0].position.altitude == 1080);
+    assert(drones_new[1].position.altitude == 1081);
+    assert(drones_new[2].flight.acceleration[0] == -1003);
+    assert(drones_new[2].network.heartbeat_at == drone.network.heartbeat_at);
+
+#ifndef BITPROTO_OPTIMIZATION_MODE
+    // Parallel batch encoding and decoding, on 4 threads of 1024 records.
+    enum { NPARALLEL = 4 * BP_PARALLEL_MIN_RECORDS + 3 };
+    static struct Drone drones_p[NPARALLEL];
+    static struct Drone drones_p1[NPARALLEL];
+    static unsigned char sb_p[NPARALLEL * BYTES_LENGTH_DRONE];
+    static unsigned char sb_p1[NPARALLEL * BYTES_LENGTH_DRONE];
+    for (int k = 0; k < NPARALLEL; k++) {
+        drones_p[k] = drone;
+        drones_p[k].position.altitude = (uint32_t)k;
+        drones_p[k].flight.acceleration[0] = -k;
+    }
+    assert(EncodeDroneBatchParallel(drones_p, NPARALLEL, sb_p, 4) == 0);
+    EncodeDroneBatch(drones_p, NPARALLEL, sb_p1);
+    assert(memcmp(sb_p, sb_p1, sizeof(sb_p)) == 0);
+    assert(DecodeDroneBatchParallel(drones_p1, NPARALLEL, sb_p, 0) == 0);
+    for (int k = 0; k < NPARALLEL; k++) {
+        assert(drones_p1[k].position.altitude == (uint32_t)k);
+        assert(drones_p1[k].flight.acceleration[0] == -k);
+        assert(drones_p1[k].network.heartbeat_at == drone.network.heartbeat_at);
+    }
+
+    // Frame ring between a producer thread and the consumer, in order.
+    static unsigned char rs[8 * 128];
+    assert(BpRingInit(&ring, rs, 128, 6) == BP_ERR_RING);
+    assert(BpRingInit(&ring, rs, 128, 8) == 0);
+    struct Drone drone_r = {0};
+    assert(DecodeDroneFrom(&ring, &drone_r) == BP_ERR_RING);
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, RingProduce, &drone) == 0);
+    for (int k = 0; k < NRING; k++) {
+        int ret;
+        while ((ret = DecodeDroneFrom(&ring, &drone_r)) == BP_ERR_RING)
+            sched_yield();
+        assert(ret == 0 && drone_r.position.altitude == (uint32_t)k);
+        assert(drone_r.network.heartbeat_at == drone.network.heartbeat_at);
+    }
+    pthread_join(producer, NULL);
+    assert(BpRingPeek(&ring) == NULL);
+    for (int k = 0; k < 8; k++) {
+        assert(BpRingAcquire(&ring) != NULL);
+        BpRingCommit(&ring);
+    }
+    assert(BpRingAcquire(&ring) == NULL);
+    assert(memcmp(BpRingPeek(&ring), rs, BYTES_LENGTH_DRONE) == 0);
+
+    // Batches of datagrams over UDP loopback, more than BP_MMSG_MAX of them.
+    enum { NMMSG = 2 * BP_MMSG_MAX + 5 };
+    int rfd = socket(AF_INET, SOCK_DGRAM, 0);
+    int wfd = socket(AF_INET, SOCK_DGRAM, 0);
+    assert(rfd >= 0 && wfd >= 0);
+    struct sockaddr_in addr = {0};
+    socklen_t addrlen = sizeof(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    assert(bind(rfd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(getsockname(rfd, (struct sockaddr *)&addr, &addrlen) == 0);
+    assert(connect(wfd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+
+    static struct Drone drones_m[NMMSG];
+    static unsigned char sm[NMMSG * BYTES_LENGTH_DRONE];
+    for (int k = 0; k < NMMSG; k++) {
+        drones_m[k] = drone;
+        drones_m[k].position.altitude = (uint32_t)k;
+    }
+    assert(RecvDroneBatch(rfd, drones_m, NMMSG, sm, MSG_DONTWAIT) ==
+           BP_ERR_MMSG);
+    assert(errno == EAGAIN || errno == EWOULDBLOCK);
+    assert(SendDroneBatch(wfd, drones_m, NMMSG, sm, 0) == NMMSG);
+    memset(drones_m, 0, sizeof(drones_m));
+    int nm = 0;
+    while (nm < NMMSG) {
+        int ret = RecvDroneBatch(rfd, drones_m + nm, NMMSG - nm, sm,
+                                 MSG_WAITFORONE);
+        assert(ret > 0 && ret <= BP_MMSG_MAX);
+        nm += ret;
+    }
+    for (int k = 0; k < NMMSG; k++) {
+        assert(drones_m[k].position.altitude == (uint32_t)k);
+        assert(drones_m[k].network.heartbeat_at == drone.network.heartbeat_at);
+    }
+
+    // The bytes after a short datagram are zeroed.
+    assert(send(wfd, s, 2, 0) == 2);
+    assert(RecvDroneBatch(rfd, drones_m, NMMSG, sm, MSG_WAITFORONE) == 1);
+    assert(drones_m[0].status == drone.status);
+    assert(drones_m[0].network.heartbeat_at == 0);
+    close(rfd);
+    close(wfd);
+#endif
+
+    // Checked encoding and decoding.
+    unsigned char sc[BYTES_LENGTH_DRONE_CHECKED] = {0};
+    EncodeDroneChecked(&drone, sc);
+    assert(memcmp(sc, s, BYTES_LENGTH_DRONE) == 0);
+    struct Drone drone_c = {0};
+    assert(DecodeDroneChecked(&drone_c, sc, BYTES_LENGTH_DRONE) ==
+           BP_ERR_SHORT_INPUT);
+    assert(DecodeDroneChecked(&drone_c, sc, BYTES_LENGTH_DRONE_CHECKED) == 0);
+    assert(drone_c.network.heartbeat_at == drone.network.heartbeat_at);
+    sc[3] ^= 1;
+    assert(DecodeDroneChecked(&drone_c, sc, BYTES_LENGTH_DRONE_CHECKED) ==
+           BP_ERR_CHECKSUM);
+
+#ifndef BITPROTO_OPTIMIZATION_MODE
+    // Framed encoding and decoding, the payload is checked.
+    unsigned char sf[BYTES_LENGTH_DRONE_FRAMED];
+    int nf = EncodeDroneFramed(&drone, sf);
+    assert(nf <= BYTES_LENGTH_DRONE_FRAMED);
+    assert(sf[nf - 1] == 0);
+    for (int k = 0; k < nf - 1; k++) assert(sf[k] != 0);
+    struct Drone drone_f = {0};
+    assert(DecodeDroneFramed(&drone_f, sf, nf) == 0);
+    assert(memcmp(sf, s, BYTES_LENGTH_DRONE) == 0);
+    assert(drone_f.network.heartbeat_at == drone.network.heartbeat_at);
+    sf[0] = 0;
+    assert(DecodeDroneFramed(&drone_f, sf, nf) == BP_ERR_FRAMING);
+
+    // Delta encoding and decoding against the previous drone.
+    struct Drone drone_d = drone;
+    drone_d.network.signal = 3;
+    drone_d.status = DRONE_STATUS_LANDING;
+    unsigned char sd[BYTES_LENGTH_DRONE_DELTA];
+    int nd = EncodeDroneDelta(&drone, &drone_d, sd);
+    assert(nd < BYTES_LENGTH_DRONE / 2);
+    struct Drone drone_dn = {0};
+    assert(DecodeDroneDelta(&drone, sd, nd, &drone_dn) == nd);
+    assert(memcmp(&drone_dn, &drone_d, sizeof(struct Drone)) == 0);
+    assert(DecodeDroneDelta(&drone, sd, nd - 1, &drone_dn) == BP_ERR_SHORT_INPUT);
+    assert(EncodeDroneDelta(&drone, &drone, sd) == 1);
+
+    // Log container of two drones, indexed.
+    unsigned char sl[BP_LOG_HEADER_LENGTH +
+                     2 * (BP_LOG_FRAME_HEADER_LENGTH + BYTES_LENGTH_DRONE) +
+                     2 * 8 + 12] = {0};
+    uint64_t offsets[2];
+    size_t nl = BpLogWriteHeader(sl, FINGERPRINT_DRONE);
+    for (int k = 0; k < 2; k++) {
+        offsets[k] = nl;
+        nl += BpLogWriteFrameHeader(sl + nl, 7 + k, BYTES_LENGTH_DRONE);
+        EncodeDrone(k == 0 ? &drone : &drone_d, sl + nl);
+        nl += BYTES_LENGTH_DRONE;
+    }
+    nl += BpLogWriteIndex(sl + nl, offsets, 2);
+    assert(nl == sizeof(sl));
+
+    struct BpLogReader lr;
+    struct BpLogFrame lf;
+    assert(BpLogOpen(&lr, sl, nl) == 0);
+    assert(lr.fingerprint == FINGERPRINT_DRONE && lr.count == 2);
+    assert(BpLogSeek(&lr, 1, &lf) == 0);
+    assert(lf.tag == 8 && lf.n == BYTES_LENGTH_DRONE && lf.offset == offsets[1]);
+    assert(BpLogNext(&lr, &lf) == 0);
+    assert(BpLogSeek(&lr, 2, &lf) == BP_ERR_LOG);
+    lr.i = BP_LOG_HEADER_LENGTH;
+    assert(BpLogNext(&lr, &lf) == 1);
+    assert(lf.tag == 7 && memcmp(lf.s, s, BYTES_LENGTH_DRONE) == 0);
+
+    // Without an index, frames are iterated by scanning.
+    assert(BpLogOpen(&lr, sl, offsets[1] + lf.n + 4) == 0);
+    assert(lr.count == 0);
+    assert(BpLogNext(&lr, &lf) == 1 && BpLogNext(&lr, &lf) == 1);
+    assert(BpLogNext(&lr, &lf) == 0);
+    assert(BpLogOpen(&lr, sl, 8) == BP_ERR_LOG);
+
+    // Double-buffered transmission, frames are sent in the order committed.
+    unsigned char ta[BYTES_LENGTH_DRONE], tb[BYTES_LENGTH_DRONE];
+    struct BpTxBuffers tx;
+    BpTxInit(&tx, ta, tb, TxStart, &tx_nstarted);
+    assert(BpTxIdle(&tx));
+    EncodeDrone(&drone, BpTxAcquire(&tx));
+    BpTxCommit(&tx, BYTES_LENGTH_DRONE);
+    assert(tx_nstarted == 1 && tx_started[0] == ta);
+    EncodeDrone(&drone_d, BpTxAcquire(&tx));
+    BpTxCommit(&tx, BYTES_LENGTH_DRONE);
+    assert(tx_nstarted == 1 && BpTxAcquire(&tx) == NULL);
+    BpTxComplete(&tx);
+    assert(tx_nstarted == 2 && tx_started[1] == tb);
+    assert(BpTxAcquire(&tx) == ta && !BpTxIdle(&tx));
+    BpTxComplete(&tx);
+    assert(BpTxIdle(&tx) && tx_nstarted == 2);
+    assert(memcmp(ta, s, BYTES_LENGTH_DRONE) == 0);
+    assert(memcmp(tb, sl + offsets[1] + BP_LOG_FRAME_HEADER_LENGTH,
+                  BYTES_LENGTH_DRONE) == 0);
+#endif
+
+    // Masked decoding, fields not selected are left untouched.
+    struct Drone drone_m = {0};
+    drone_m.status = DRONE_STATUS_LANDING;
+    drone_m.flight.pose.yaw = 7;
+    assert(DecodeDroneMasked(&drone_m, s,
+                             FIELD_MASK_DRONE_POSITION |
+                                 FIELD_MASK_DRONE_NETWORK) == 0);
+    assert(drone_m.status == DRONE_STATUS_LANDING);
+    assert(drone_m.flight.pose.yaw == 7);
+    assert(drone_m.position.altitude == drone.position.altitude);
+    assert(drone_m.network.heartbeat_at == drone.network.heartbeat_at);
+    assert(drone_m.power.battery == 0);
+    DecodeDroneMasked(&drone_m, s, ~0ULL);
+    assert(memcmp(&drone_m, &drone_new, sizeof(struct Drone)) == 0);
+
+    // Hash and equality, bits above the fields' widths are ignored.
+    struct Drone drone_h = drone_new;
+    drone_h.network.signal |= 0xf0;
+    assert(EqualDrone(&drone_h, &drone));
+    assert(HashDrone(&drone_h) == HashDrone(&drone));
+    drone_h.position.altitude++;
+    assert(!EqualDrone(&drone_h, &drone));
+    assert(HashDrone(&drone_h) != HashDrone(&drone));
+
+    // Single field accessors.
+    assert(BpGetDrone_status(s) == drone.status);
+    assert(BpGetDrone_network_signal(s) == drone.network.signal);
+    assert(BpGetDrone_network_heartbeat_at(s) == drone.network.heartbeat_at);
+    assert(BpGetDrone_power_is_charging(s) == drone.power.is_charging);
+
+    unsigned char sp[BYTES_LENGTH_DRONE];
+    memcpy(sp, s, BYTES_LENGTH_DRONE);
+    BpSetDrone_network_signal(sp, 3);
+    BpSetDrone_power_is_charging(sp, true);
+    struct Drone drone_p = {0};
+    DecodeDrone(&drone_p, sp);
+    assert(drone_p.network.signal == 3);
+    assert(drone_p.power.is_charging == true);
+    assert(drone_p.network.heartbeat_at == drone.network.heartbeat_at);
+    assert(drone_p.power.battery == drone.power.battery);
+    assert(drone_p.landing_gear.status == drone.landing_gear.status);
+
+    // Encoders and decoders against the test vectors of option self_test.
+    assert(BpSelfTestDrone() == 0);
     return 0;
 }
@@ -1,8 +1,15 @@
 package main
 
 import (
+	"bytes"
+	"encoding"
 	"fmt"
+	"io"
+	"runtime"
+	"sync"
+	"testing"
 
+	bitproto "github.com/hit9/bitproto/lib/go"
 	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/drone/go/bp"
 )
 
@@ -62,4 +69,201 @@ func main() {
 	assert(droneNew.Network.Signal == drone.Network.Signal)
 	assert(droneNew.Network.HeartbeatAt == drone.Network.HeartbeatAt)
 	assert(droneNew.LandingGear.Status == drone.LandingGear.Status)
+
+	// Single field accessors
+	assert(bp.BpGetDrone_Status(s) == drone.Status)
+	assert(bp.BpGetDrone_Network_Signal(s) == drone.Network.Signal)
+	assert(bp.BpGetDrone_Network_HeartbeatAt(s) == drone.Network.HeartbeatAt)
+	assert(bp.BpGetDrone_Power_IsCharging(s) == drone.Power.IsCharging)
+
+	sp := append([]byte{}, s...)
+	bp.BpSetDrone_Network_Signal(sp, 3)
+	bp.BpSetDrone_Power_IsCharging(sp, true)
+	droneP := &bp.Drone{}
+	droneP.Decode(sp)
+	assert(droneP.Network.Signal == 3)
+	assert(droneP.Power.IsCharging == true)
+	assert(droneP.Network.HeartbeatAt == drone.Network.HeartbeatAt)
+	assert(droneP.Power.Battery == drone.Power.Battery)
+	assert(droneP.LandingGear.Status == drone.LandingGear.Status)
+
+	// Masked decoding, fields not selected are left untouched.
+	droneM := &bp.Drone{}
+	droneM.Status = bp.DRONE_STATUS_LANDING
+	droneM.Flight.Pose.Yaw = 7
+	droneM.Network.Signal = 1
+	droneM.DecodeMasked(s, bp.FIELD_MASK_DRONE_POSITION|bp.FIELD_MASK_DRONE_NETWORK)
+	assert(droneM.Status == bp.DRONE_STATUS_LANDING)
+	assert(droneM.Flight.Pose.Yaw == 7)
+	assert(droneM.Position == drone.Position)
+	assert(droneM.Network == drone.Network)
+	assert(droneM.Power.Battery == 0)
+	droneM.DecodeMasked(s, ^uint64(0))
+	assert(*droneM == *droneNew)
+
+	// Hash and equality, bits above the fields' widths are ignored.
+	droneH := *droneNew
+	droneH.Network.Signal |= 0xf0
+	assert(droneH.Equal(drone))
+	assert(droneH.Hash() == drone.Hash())
+	droneH.Position.Altitude++
+	assert(!droneH.Equal(drone))
+	assert(droneH.Hash() != drone.Hash())
+
+	// Encode into and decode from caller-supplied buffers.
+	dst := make([]byte, bp.BYTES_LENGTH_DRONE+1)
+	for k := range dst {
+		dst[k] = 0xff
+	}
+	assert(drone.EncodeTo(dst) == int(bp.BYTES_LENGTH_DRONE))
+	assert(bytes.Equal(dst[:bp.BYTES_LENGTH_DRONE], s))
+	assert(dst[bp.BYTES_LENGTH_DRONE] == 0xff)
+
+	droneR := &bp.Drone{}
+	droneR.Network.Signal = 7
+	assert(droneR.DecodeFrom(s) == nil)
+	assert(*droneR == *droneNew)
+	assert(droneR.DecodeFrom(s[:len(s)-1]) != nil)
+
+	// Decoding into a reused struct overwrites every field, nested ones included.
+	droneD := &bp.Drone{}
+	droneD.Decode(bytes.Repeat([]byte{0xff}, int(bp.BYTES_LENGTH_DRONE)))
+	assert(droneD.Propellers[0].Id == 0xff && droneD.Flight.Pose.Yaw == -1)
+	droneD.Decode(s)
+	assert(*droneD == *droneNew)
+	droneD.Reset()
+	assert(*droneD == bp.Drone{})
+
+	// Appending to and marshaling into caller's buffers.
+	pkt := append(make([]byte, 0, 64), 0xaa)
+	pkt = drone.AppendEncode(pkt)
+	assert(pkt[0] == 0xaa && bytes.Equal(pkt[1:], s))
+	pkt, err := drone.AppendBinary(pkt[:1])
+	assert(err == nil && bytes.Equal(pkt[1:], s))
+	assert(testing.AllocsPerRun(100, func() { drone.AppendEncode(pkt[:0]) }) == 0)
+
+	var marshaler encoding.BinaryMarshaler = drone
+	sm, err := marshaler.MarshalBinary()
+	assert(err == nil && bytes.Equal(sm, s))
+	var unmarshaler encoding.BinaryUnmarshaler = &bp.Drone{}
+	assert(unmarshaler.UnmarshalBinary(sm) == nil)
+	assert(*(unmarshaler.(*bp.Drone)) == *droneNew)
+	assert(unmarshaler.UnmarshalBinary(sm[:1]) != nil)
+
+	// Log container of two drones, indexed.
+	var buf bytes.Buffer
+	lw, err := bitproto.NewLogWriter(&buf, bp.FINGERPRINT_DRONE, true)
+	assert(err == nil)
+	assert(lw.WriteFrame(7, s) == nil)
+	assert(lw.WriteFrame(8, sp) == nil)
+	assert(lw.Close() == nil)
+
+	lr, err := bitproto.NewLogReader(buf.Bytes())
+	assert(err == nil)
+	assert(lr.Fingerprint() == bp.FINGERPRINT_DRONE && lr.Len() == 2)
+	f, err := lr.Seek(1)
+	assert(err == nil && f.Tag == 8 && bytes.Equal(f.S, sp))
+	_, err = lr.Next()
+	assert(err == io.EOF)
+	_, err = lr.Seek(2)
+	assert(err == bitproto.ErrBadLog)
+
+	// Without an index, frames are iterated by scanning.
+	lr, err = bitproto.NewLogReader(buf.Bytes()[:f.Offset+4+len(f.S)])
+	assert(err == nil && lr.Len() == 0)
+	f, err = lr.Next()
+	assert(err == nil && f.Tag == 7 && bytes.Equal(f.S, s))
+	_, err = lr.Next()
+	assert(err == nil)
+	_, err = lr.Next()
+	assert(err == io.EOF)
+
+	// Parallel batch decoding, on 4 workers.
+	n := int(bp.BYTES_LENGTH_DRONE)
+	ms := make([]bp.Drone, 4*bitproto.ParallelMinRecords+3)
+	sb := make([]byte, len(ms)*n)
+	for k := range ms {
+		ms[k] = *drone
+		ms[k].Position.Altitude = uint32(k)
+		ms[k].EncodeTo(sb[k*n:])
+	}
+	ms1 := make([]bp.Drone, len(ms))
+	err = bitproto.ParallelBatch(len(ms), 4, func(lo, hi int) error {
+		for k := lo; k < hi; k++ {
+			if err := ms1[k].DecodeFrom(sb[k*n:]); err != nil {
+				return err
+			}
+		}
+		return nil
+	})
+	assert(err == nil)
+	for k := range ms {
+		assert(ms1[k] == ms[k])
+	}
+	err = bitproto.ParallelBatch(len(ms), 0, func(lo, hi int) error {
+		return ms1[lo].DecodeFrom(sb[lo*n : lo*n+1])
+	})
+	assert(err != nil)
+
+	// Frame ring between a producer goroutine and the consumer, in order.
+	ring := bitproto.NewFrameRing(n, 6)
+	assert(ring.DecodeFrom(droneR) == bitproto.ErrRingEmpty)
+	go func() {
+		d := *drone
+		for k := 0; k < 10000; k++ {
+			d.Position.Altitude = uint32(k)
+			for ring.EncodeInto(&d) == bitproto.ErrRingFull {
+				runtime.Gosched()
+			}
+		}
+	}()
+	for k := 0; k < 10000; k++ {
+		for {
+			if err = ring.DecodeFrom(droneR); err != bitproto.ErrRingEmpty {
+				break
+			}
+			runtime.Gosched()
+		}
+		assert(err == nil && droneR.Position.Altitude == uint32(k))
+	}
+	for k := 0; k < 8; k++ {
+		assert(ring.Acquire() != nil)
+		ring.Commit()
+	}
+	assert(ring.Acquire() == nil && ring.EncodeInto(drone) == bitproto.ErrRingFull)
+	for ring.Peek() != nil {
+		ring.Release()
+	}
+
+	// Tracing, only in standard mode, where messages have library processors.
+	stats := bitproto.NewTraceStats()
+	bitproto.SetTracer(stats)
+	drone.EncodeTo(dst)
+	droneR.DecodeFrom(s)
+	droneR.Decode(s)
+	bitproto.SetTracer(nil)
+	if _, ok := interface{}(drone).(interface{ BpProcessor() bitproto.Processor }); ok {
+		assert(stats.Get("Drone", true).Count == 1)
+		assert(stats.Get("Drone", false).Count == 2)
+		assert(stats.Get("Drone", false).Bytes == 2*int64(bp.BYTES_LENGTH_DRONE))
+	}
+
+	// Steady state encoding and decoding allocates nothing.
+	assert(testing.AllocsPerRun(100, func() { drone.EncodeTo(dst) }) == 0)
+	assert(testing.AllocsPerRun(100, func() { droneR.DecodeFrom(s) }) == 0)
+	// Encode allocates the returned buffer only, processors are built once.
+	assert(testing.AllocsPerRun(100, func() { drone.Encode() }) <= 1)
+	assert(testing.AllocsPerRun(100, func() { droneR.Decode(s) }) == 0)
+	// So does decoding into structs from a sync.Pool.
+	pool := sync.Pool{New: func() interface{} { return &bp.Drone{} }}
+	pool.Put(droneD)
+	assert(testing.AllocsPerRun(100, func() {
+		m := pool.Get().(*bp.Drone)
+		m.Decode(s)
+		assert(*m == *droneNew)
+		pool.Put(m)
+	}) == 0)
+
+	// Encoders and decoders against the test vectors of option self_test.
+	assert(bp.BpSelfTestDrone() == nil)
 }
@@ -1,4 +1,37 @@
+import asyncio
+import io
+import socket
+from typing import Any, List
+
 import drone_bp as bp
+from bitprotolib import bp as bplib
+
+
+def feed(protocol: bplib.FrameProtocol, s: bytes, chunk: int) -> None:
+    """Feeds the bytes of a stream to given protocol, chunk bytes a read at most."""
+    i = 0
+    while i < len(s):
+        b = protocol.get_buffer(-1)
+        n = min(chunk, len(s) - i, len(b))
+        b[:n] = s[i : i + n]
+        protocol.buffer_updated(n)
+        i += n
+
+
+async def receive(s: bytes, message_type: Any) -> List[Any]:
+    """Receives the frames of stream s over a socket pair by asyncio."""
+    loop = asyncio.get_running_loop()
+    messages: List[Any] = []
+    rsock, wsock = socket.socketpair()
+    transport, _ = await loop.connect_accepted_socket(
+        lambda: bplib.FrameProtocol(messages.extend, message_type), rsock
+    )
+    wsock.sendall(s)
+    wsock.close()
+    while len(messages) * message_type.BYTES_LENGTH < len(s):
+        await asyncio.sleep(0.001)
+    transport.close()
+    return messages
 
 
 def main() -> None:
@@ -52,6 +85,100 @@ def main() -> None:
     assert drone_new.network.heartbeat_at == drone.network.heartbeat_at
     assert drone_new.landing_gear.status == drone.landing_gear.status
 
+    # Encode into and decode from a shared buffer, at offsets.
+    buf = bytearray(1 + 2 * len(s))
+    assert drone.encode_into(buf, 1) == len(s)
+    assert drone.encode_into(memoryview(buf), 1 + len(s)) == len(s)
+    assert buf == b"\x00" + s + s
+    drone_new = bp.Drone()
+    drone_new.decode_from(memoryview(buf), 1 + len(s))
+    assert drone_new.encode() == s
+    drone_new.decode_from(bytes(buf)[1:])
+    assert drone_new.encode() == s
+
+    # Decode concatenated frames into columns.
+    drone.flight.acceleration[0] = -7
+    drone.power.is_charging = True
+    frames = bytes(s + drone.encode() + s)
+    modes = [False, True] if bplib.numpy is not None else [False]
+    for use_numpy in modes:
+        columns = bp.Drone.decode_columns(frames, use_numpy=use_numpy)
+        assert list(columns["status"]) == [drone.status] * 3
+        assert list(columns["flight.acceleration[0]"]) == [-1001, -7, -1001]
+        assert list(columns["flight.acceleration[2]"]) == [1003] * 3
+        assert list(columns["power.is_charging"]) == [False, True, False]
+        assert list(columns["propellers[0].direction"]) == [
+            drone.propellers[0].direction
+        ] * 3
+        assert list(columns["network.heartbeat_at"]) == [drone.network.heartbeat_at] * 3
+
+    # Views extract fields from the buffer on access.
+    view = bp.DroneView(frames, len(s))
+    assert view.status == drone.status
+    assert view.flight.acceleration[0] == -7
+    assert view.flight.acceleration == list(drone.flight.acceleration)
+    assert view.flight.pose.roll == drone.flight.pose.roll
+    assert view.power.is_charging is True
+    assert view.propellers[0].direction == drone.propellers[0].direction
+    assert view.network.heartbeat_at == drone.network.heartbeat_at
+    assert view.to_message() == drone
+    assert bp.DroneView(frames).to_message() == drone_new
+
+    # Log container of two drones, indexed.
+    f = io.BytesIO()
+    writer = bplib.LogWriter(f, bp.Drone.FINGERPRINT)
+    writer.write_frame(7, s)
+    writer.write_frame(8, frames[len(s) : 2 * len(s)])
+    writer.close()
+
+    reader = bplib.LogReader(f.getvalue())
+    assert reader.fingerprint == bp.Drone.FINGERPRINT and len(reader) == 2
+    frame = reader.seek(1)
+    assert frame.tag == 8 and bytes(frame.s) == frames[len(s) : 2 * len(s)]
+    assert [frame.tag for frame in reader] == [7, 8]
+
+    # Without an index, frames are iterated by scanning.
+    reader = bplib.LogReader(f.getvalue()[: frame.offset + 4 + len(frame.s)])
+    assert len(reader) == 0
+    assert [bytes(frame.s) for frame in reader][0] == s
+
+    # Frames of a stream, split across reads anywhere, decoded in batches.
+    batches: List[List[Any]] = []
+    protocol = bplib.FrameProtocol(batches.append, bp.Drone, buffer_size=100)
+    feed(protocol, frames * 10, 7)
+    drones = [m for batch in batches for m in batch]
+    assert len(drones) == 30 and drones[29] == drone_new
+    assert [m.flight.acceleration[0] for m in drones[:3]] == [-1001, -7, -1001]
+    batches.clear()
+    protocol = bplib.FrameProtocol(batches.append, bp.Drone)
+    feed(protocol, frames * 10, len(frames) * 10)
+    assert len(batches) == 1 and len(batches[0]) == 30
+
+    # Frames of a log container, with tags, short and unknown ones.
+    f = io.BytesIO()
+    writer = bplib.LogWriter(f, bp.Drone.FINGERPRINT, indexed=False)
+    writer.write_frame(7, s)
+    writer.write_frame(9, b"skipped")
+    writer.write_frame(8, s[:3])
+    writer.write_frame(7, frames[len(s) : 2 * len(s)])
+    batches = []
+    protocol = bplib.FrameProtocol(
+        batches.append, message_types={7: bp.Drone, 8: bp.Position}, buffer_size=4
+    )
+    feed(protocol, f.getvalue()[bplib.LOG_HEADER_LENGTH :], 5)
+    messages = [m for batch in batches for m in batch]
+    assert len(protocol.buf) >= bp.Drone.BYTES_LENGTH
+    assert [type(m) for m in messages] == [bp.Drone, bp.Position, bp.Drone]
+    assert messages[0] == drone_new
+    position = bp.Position()
+    position.decode(s[:3] + bytes(bp.Position.BYTES_LENGTH - 3))
+    assert messages[1] == position
+    assert messages[2].flight.acceleration[0] == -7
+
+    # Over a socket by asyncio.
+    drones = asyncio.run(receive(frames * 100, bp.Drone))
+    assert len(drones) == 300 and drones[1].flight.acceleration[0] == -7
+
 
 if __name__ == "__main__":
     main()
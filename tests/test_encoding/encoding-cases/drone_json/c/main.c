@@ -1,8 +1,21 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "drone_json_bp.h"
 
+// Sink appending the chunks to the buffer at arg.
+struct Out {
+    char s[1024];
+    int n;
+};
+
+static void Collect(const unsigned char *s, int n, void *arg) {
+    struct Out *out = (struct Out *)arg;
+    memcpy(out->s + out->n, s, n);
+    out->n += n;
+}
+
 int main(void) {
     struct Drone drone = {0};
 
@@ -29,5 +42,60 @@ int main(void) {
     JsonDrone(&drone, s);
     printf("%s", s);
 
+    // Bounded json formatting into an exactly sized buffer.
+    char t[JSON_MAX_LENGTH_DRONE + 1];
+    int n = JsonDroneN(&drone, t, sizeof(t));
+    assert(n == (int)strlen(s));
+    assert(strcmp(s, t) == 0);
+
+    // Truncated output still reports the full length.
+    char u[8];
+    assert(JsonDroneN(&drone, u, sizeof(u)) == n);
+    assert(strlen(u) == sizeof(u) - 1);
+    assert(strncmp(s, u, sizeof(u) - 1) == 0);
+
+    // Json formatting through a sink, with a buffer of 16 bytes.
+    struct Out out = {{0}, 0};
+    char w[16];
+    assert(JsonDroneSink(&drone, w, sizeof(w), Collect, &out) == n);
+    assert(out.n == n);
+    assert(memcmp(out.s, s, n) == 0);
+
+    // Json parsing round trip.
+    struct Drone drone_new;
+    memset(&drone_new, 0xff, sizeof(drone_new));
+    assert(ParseJsonDrone(&drone_new, s, n) == 0);
+    char v[1024] = {0};
+    assert(JsonDrone(&drone_new, v) == n);
+    assert(strcmp(s, v) == 0);
+
+    // Whitespaces, unknown keys skipped, and fields missing left untouched.
+    const char *p =
+        " { \"network\" : {\"signal\": 3, \"extra\": [1, {\"a\": \"}\"}]},\n"
+        "\"flight\": {\"acceleration\": [7, -8]}, \"unknown\": null } ";
+    assert(ParseJsonDrone(&drone_new, p, (int)strlen(p)) == 0);
+    assert(drone_new.network.signal == 3);
+    assert(drone_new.network.heartbeat_at == 1611280511628);
+    assert(drone_new.flight.acceleration[0] == 7);
+    assert(drone_new.flight.acceleration[1] == -8);
+    assert(drone_new.flight.acceleration[2] == 1003);
+
+    // Malformed json, and values out of range.
+    const char *bad[] = {
+        "",
+        "{",
+        "{\"status\": 2,}",
+        "{\"status\": 8}",
+        "{\"status\": -1}",
+        "{\"status\": 1.5}",
+        "{\"power\": {\"is_charging\": 1}}",
+        "{\"flight\": {\"acceleration\": [1, 2, 3, 4]}}",
+        "{\"network\": {\"heartbeat_at\": 99999999999999999999}}",
+        "{} {}",
+    };
+    for (size_t k = 0; k < sizeof(bad) / sizeof(bad[0]); k++)
+        assert(ParseJsonDrone(&drone_new, bad[k], (int)strlen(bad[k])) ==
+               BP_ERR_JSON);
+
     return 0;
 }
@@ -1,7 +1,9 @@
 package main
 
 import (
+	"encoding/json"
 	"fmt"
+	"testing"
 
 	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/drone_json/go/bp"
 )
@@ -34,4 +36,11 @@ func main() {
 	drone.LandingGear.Status = bp.LANDING_GEAR_STATUS_FOLDED
 
 	fmt.Printf("%s", drone.String())
+
+	// AppendJSON allocates nothing with enough capacity, and json.Marshal goes
+	// through MarshalJSON.
+	b := make([]byte, 0, 1024)
+	assert(testing.AllocsPerRun(100, func() { b = drone.AppendJSON(b[:0]) }) == 0)
+	v, err := json.Marshal(drone)
+	assert(err == nil && string(v) == drone.String())
 }
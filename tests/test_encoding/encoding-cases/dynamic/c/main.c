@@ -0,0 +1,125 @@
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitproto.h"
+
+static unsigned char arena[8192];
+
+// A schema of message A { uint64[65535][65535] a }, of bits overflowing.
+static const unsigned char oversized[] = {
+    'B', 'P', 'S', 'C', 1, 0, 1, 0,              // Header, 1 message.
+    1, 'A', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,     // A, 1 field.
+    1, 'a', 7, 0, 0xff, 0xff, 7, 0, 0xff, 0xff,  // a, of arrays of arrays.
+    3, 64,                                       // uint64.
+};
+
+// A schema of message E {}, and messages M1 to M4, of which each is of a field
+// E[65535], M1[65535], M2[65535] and M3[65535], flattened into 65535^4 empty
+// messages.
+static const unsigned char nested[] = {
+    'B', 'P', 'S', 'C', 1, 0, 5, 0,                // Header, 5 messages.
+    1, 'E', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,       // E, no fields.
+    2, 'M', '1', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,  // M1, 1 field.
+    1, 'a', 7, 0, 0xff, 0xff, 8, 0, 0,             // E[65535].
+    2, 'M', '2', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,  // M2, 1 field.
+    1, 'a', 7, 0, 0xff, 0xff, 8, 1, 0,             // M1[65535].
+    2, 'M', '3', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,  // M3, 1 field.
+    1, 'a', 7, 0, 0xff, 0xff, 8, 2, 0,             // M2[65535].
+    2, 'M', '4', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,  // M4, 1 field.
+    1, 'a', 7, 0, 0xff, 0xff, 8, 3, 0,             // M3[65535].
+};
+
+// Sets the kth element of the field of given path in the field table.
+static void Set(const struct BpDynMessage *m, uint64_t *values,
+                const char *name, int k, int64_t v) {
+    const struct BpDynField *field = BpDynFindField(m, name);
+    assert(field != NULL && k < field->count);
+    values[field->slot + k] = (uint64_t)v;
+}
+
+// Gets the kth element of the field of given path in the field table.
+static int64_t Get(const struct BpDynMessage *m, uint64_t *values,
+                   const char *name, int k) {
+    const struct BpDynField *field = BpDynFindField(m, name);
+    assert(field != NULL && k < field->count);
+    return (int64_t)values[field->slot + k];
+}
+
+int main(void) {
+    // Load the schema.
+    unsigned char schema_buf[4096];
+    FILE *f = fopen("dynamic.bpschema", "rb");
+    assert(f != NULL);
+    size_t n = fread(schema_buf, 1, sizeof(schema_buf), f);
+    fclose(f);
+
+    struct BpDynSchema schema;
+    assert(BpDynLoad(&schema, schema_buf, n, arena, sizeof(arena)) == 0);
+    assert(BpDynLoad(&schema, schema_buf, n - 1, arena, sizeof(arena)) ==
+           BP_ERR_SCHEMA);
+    assert(BpDynLoad(&schema, schema_buf, n, arena, 64) == BP_ERR_SCHEMA);
+    assert(BpDynLoad(&schema, schema_buf, n, arena, sizeof(arena)) == 0);
+    // Malformed schemas are rejected, without overflows or walking all the
+    // elements.
+    assert(BpDynLoad(&schema, oversized, sizeof(oversized), arena,
+                     sizeof(arena)) == BP_ERR_SCHEMA);
+    assert(BpDynLoad(&schema, nested, sizeof(nested), arena, sizeof(arena)) ==
+           BP_ERR_SCHEMA);
+    assert(BpDynLoad(&schema, schema_buf, n, arena, sizeof(arena)) == 0);
+    // The schema buffer is not referenced after loading.
+    memset(schema_buf, 0, sizeof(schema_buf));
+
+    const struct BpDynMessage *m = BpDynFindMessage(&schema, "Gateway");
+    assert(m != NULL);
+    assert(BpDynFindMessageByFingerprint(&schema, m->fingerprint) == m);
+    assert(BpDynFindMessage(&schema, "Gateway.Config") != NULL);
+    assert(BpDynFindField(m, "sensors[1].online") != NULL);
+    assert(BpDynFindField(m, "sensors") == NULL);
+
+    // Encode.
+    uint64_t values[64] = {0};
+    assert(m->nslots <= 64);
+    Set(m, values, "status", 0, 6);
+    Set(m, values, "sensors[0].id", 0, 100);
+    Set(m, values, "sensors[0].value", 0, -1234567);
+    Set(m, values, "sensors[0].online", 0, 1);
+    Set(m, values, "sensors[1].id", 0, 5);
+    Set(m, values, "sensors[1].value", 0, 8000000);
+    Set(m, values, "grid[0]", 0, -16);
+    Set(m, values, "grid[0]", 1, 15);
+    Set(m, values, "grid[0]", 2, -1);
+    Set(m, values, "grid[1]", 0, 3);
+    Set(m, values, "grid[1]", 1, -4);
+    Set(m, values, "tag", 0, 0xab);
+    Set(m, values, "tag", 2, 0xff);
+    Set(m, values, "timestamp", 0, -1611280511628);
+    Set(m, values, "counters", 0, (1LL << 39) + 5);
+    Set(m, values, "counters", 1, 1234567890);
+    Set(m, values, "config.period", 0, 4000);
+    Set(m, values, "config.offset", 0, -255);
+
+    unsigned char s[64];
+    memset(s, 0xff, sizeof(s));  // Not required to be zeroed.
+    assert(BpDynEncode(m, values, s) == m->nbytes);
+
+    // Output
+    for (int i = 0; i < m->nbytes; i++) printf("%u ", s[i]);
+    printf("%" PRIu64, m->fingerprint);
+
+    // Decode.
+    uint64_t values_new[64];
+    memset(values_new, 0xff, sizeof(values_new));
+    assert(BpDynDecode(m, values_new, s, m->nbytes - 1) == BP_ERR_SHORT_INPUT);
+    assert(BpDynDecode(m, values_new, s, m->nbytes) == 0);
+    assert(memcmp(values, values_new, sizeof(uint64_t) * m->nslots) == 0);
+    assert(Get(m, values_new, "config.offset", 0) == -255);
+
+    // The ahead flag of Config mismatches, the last op of it.
+    const struct BpDynOp *op = &m->ops[m->nops - 3];
+    assert(op->kind == BP_DYN_OP_AHEAD);
+    s[op->i >> 3] ^= (unsigned char)(1 << (op->i & 7));
+    assert(BpDynDecode(m, values_new, s, m->nbytes) == BP_ERR_SCHEMA);
+    return 0;
+}
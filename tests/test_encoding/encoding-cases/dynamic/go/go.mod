@@ -0,0 +1,7 @@
+module github.com/hit9/bitproto/tests/test_encoding/encoding-cases/dynamic
+
+replace github.com/hit9/bitproto/lib/go => ../../../../../lib/go
+
+go 1.15
+
+require github.com/hit9/bitproto/lib/go v0.0.0-00010101000000-000000000000
@@ -0,0 +1,110 @@
+package main
+
+import (
+	"fmt"
+	"io/ioutil"
+
+	bitproto "github.com/hit9/bitproto/lib/go"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+// A schema of message A { uint64[65535][65535] a }, of bits overflowing.
+var oversized = []byte{
+	'B', 'P', 'S', 'C', 1, 0, 1, 0, // Header, 1 message.
+	1, 'A', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, // A, 1 field.
+	1, 'a', 7, 0, 0xff, 0xff, 7, 0, 0xff, 0xff, // a, of arrays of arrays.
+	3, 64, // uint64.
+}
+
+// A schema of message E {}, and messages M1 to M4, of which each is of a field
+// E[65535], M1[65535], M2[65535] and M3[65535], flattened into 65535^4 empty
+// messages.
+var nested = []byte{
+	'B', 'P', 'S', 'C', 1, 0, 5, 0, // Header, 5 messages.
+	1, 'E', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // E, no fields.
+	2, 'M', '1', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, // M1, 1 field.
+	1, 'a', 7, 0, 0xff, 0xff, 8, 0, 0, // E[65535].
+	2, 'M', '2', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, // M2, 1 field.
+	1, 'a', 7, 0, 0xff, 0xff, 8, 1, 0, // M1[65535].
+	2, 'M', '3', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, // M3, 1 field.
+	1, 'a', 7, 0, 0xff, 0xff, 8, 2, 0, // M2[65535].
+	2, 'M', '4', 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, // M4, 1 field.
+	1, 'a', 7, 0, 0xff, 0xff, 8, 3, 0, // M3[65535].
+}
+
+func main() {
+	// Load the schema.
+	b, err := ioutil.ReadFile("dynamic.bpschema")
+	assert(err == nil)
+	_, err = bitproto.LoadSchema(b[:len(b)-1])
+	assert(err == bitproto.ErrBadSchema)
+	// Malformed schemas are rejected, without overflows or walking all the
+	// elements, see the C main.
+	_, err = bitproto.LoadSchema(oversized)
+	assert(err == bitproto.ErrBadSchema)
+	_, err = bitproto.LoadSchema(nested)
+	assert(err == bitproto.ErrBadSchema)
+	schema, err := bitproto.LoadSchema(b)
+	assert(err == nil)
+
+	m := schema.Message("Gateway")
+	assert(m != nil)
+	assert(schema.MessageByFingerprint(m.Fingerprint) == m)
+	assert(schema.Message("Gateway.Config") != nil)
+	_, ok := m.Field("sensors")
+	assert(!ok)
+
+	// Encode.
+	values := m.NewValues()
+	set := func(name string, k int, v int64) {
+		field, ok := m.Field(name)
+		assert(ok && k < field.Count)
+		values[field.Slot+k] = uint64(v)
+	}
+	set("status", 0, 6)
+	set("sensors[0].id", 0, 100)
+	set("sensors[0].value", 0, -1234567)
+	set("sensors[0].online", 0, 1)
+	set("sensors[1].id", 0, 5)
+	set("sensors[1].value", 0, 8000000)
+	set("grid[0]", 0, -16)
+	set("grid[0]", 1, 15)
+	set("grid[0]", 2, -1)
+	set("grid[1]", 0, 3)
+	set("grid[1]", 1, -4)
+	set("tag", 0, 0xab)
+	set("tag", 2, 0xff)
+	set("timestamp", 0, -1611280511628)
+	set("counters", 0, (1<<39)+5)
+	set("counters", 1, 1234567890)
+	set("config.period", 0, 4000)
+	set("config.offset", 0, -255)
+
+	s := make([]byte, m.NBytes)
+	for k := range s {
+		s[k] = 0xff // Not required to be zeroed.
+	}
+	m.EncodeTo(values, s)
+	assert(string(m.Encode(values)) == string(s))
+
+	// Output
+	for _, b := range s {
+		fmt.Printf("%d ", b)
+	}
+	fmt.Printf("%d", m.Fingerprint)
+
+	// Decode.
+	valuesNew := m.NewValues()
+	assert(m.Decode(valuesNew, s[:len(s)-1]) == bitproto.ErrShortInput)
+	assert(m.Decode(valuesNew, s) == nil)
+	for k := range values {
+		assert(values[k] == valuesNew[k])
+	}
+	field, _ := m.Field("config.offset")
+	assert(int64(valuesNew[field.Slot]) == -255)
+}
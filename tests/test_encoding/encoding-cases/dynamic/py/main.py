@@ -0,0 +1,37 @@
+import dynamic_bp as bp
+
+
+def main() -> None:
+    # Encode.
+    gateway = bp.Gateway()
+
+    gateway.status = bp.STATUS_FAULT
+    gateway.sensors[0].id = 100
+    gateway.sensors[0].value = -1234567
+    gateway.sensors[0].online = True
+    gateway.sensors[1].id = 5
+    gateway.sensors[1].value = 8000000
+    gateway.grid[0] = [-16, 15, -1]
+    gateway.grid[1] = [3, -4, 0]
+    gateway.tag = [0xAB, 0, 0xFF]
+    gateway.timestamp = -1611280511628
+    gateway.counters = [(1 << 39) + 5, 1234567890]
+    gateway.config.period = 4000
+    gateway.config.offset = -255
+
+    s = gateway.encode()
+
+    # Output
+    for b in s:
+        print(int(b), end=" ")
+    print(bp.Gateway.FINGERPRINT, end="")
+
+    # Decode.
+    gateway_new = bp.Gateway()
+    gateway_new.decode(s)
+    assert gateway_new.encode() == s
+    assert gateway_new.config.offset == -255
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "enums_bp.h"
 
@@ -20,5 +21,49 @@ int main(void) {
     DecodeEnumContainer(&enum_container_new, s);
 
     assert(enum_container_new.my_enum == enum_container.my_enum);
+
+    // Enums holding values not declared are reported on decoding.
+    struct Checked checked = {0};
+    checked.ok = true;
+    checked.status = STATUS_FAULT;
+    checked.level = LEVEL_HIGH;
+    checked.code = CODE_FATAL;
+    checked.wide = WIDE_FAR;
+    for (int i = 0; i < 20; i++) checked.statuses[i] = (i & 1) ? STATUS_ON : 4;
+    for (int i = 0; i < 4; i++) checked.codes[i] = CODE_RETRY;
+    checked.sensors[1] = (struct Sensor){STATUS_IDLE, LEVEL_LOW};
+    checked.sensor = (struct Sensor){STATUS_ON, LEVEL_MIDDLE};
+
+    unsigned char sc[BYTES_LENGTH_CHECKED] = {0};
+    EncodeChecked(&checked, sc);
+    struct Checked checked_new = {0};
+    assert(DecodeChecked(&checked_new, sc) == 0);
+    assert(DecodeCheckedN(&checked_new, sc, BYTES_LENGTH_CHECKED) == 0);
+    assert(DecodeCheckedBatch(&checked_new, 1, sc) == 0);
+    assert(checked_new.status == checked.status);
+    assert(checked_new.wide == checked.wide);
+    for (int i = 0; i < 20; i++)
+        assert(checked_new.statuses[i] == checked.statuses[i]);
+    assert(checked_new.sensor.level == checked.sensor.level);
+
+    struct Checked bad[9];
+    for (int k = 0; k < 9; k++) bad[k] = checked;
+    bad[0].status = 3;
+    bad[1].level = 4;
+    bad[2].code = 2;
+    bad[3].wide = 39999;
+    bad[4].statuses[19] = 7;
+    bad[5].codes[3] = 201;
+    bad[6].sensors[1].status = 5;
+    bad[7].sensor.level = 15;
+    bad[8].statuses[0] = 6;
+    for (int k = 0; k < 9; k++) {
+        memset(sc, 0, sizeof(sc));
+        EncodeChecked(&bad[k], sc);
+        assert(DecodeChecked(&checked_new, sc) == BP_ERR_ENUM);
+        assert(DecodeCheckedN(&checked_new, sc, BYTES_LENGTH_CHECKED) ==
+               BP_ERR_ENUM);
+        assert(DecodeCheckedBatch(&checked_new, 1, sc) == BP_ERR_ENUM);
+    }
     return 0;
 }
@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "drone_extended_bp.h"
 #include "drone_origin_bp.h"
@@ -28,6 +29,12 @@ int main(void) {
     unsigned char s[BYTES_LENGTH_EXTENDED_DRONE] = {0};
     EncodeExtendedDrone(&drone, s);
 
+    // Encode into a dirty buffer, it's not required to be zeroed.
+    unsigned char s_dirty[BYTES_LENGTH_EXTENDED_DRONE];
+    memset(s_dirty, 0xff, sizeof(s_dirty));
+    EncodeExtendedDrone(&drone, s_dirty);
+    assert(memcmp(s, s_dirty, sizeof(s_dirty)) == 0);
+
     // Output
     for (int i = 0; i < BYTES_LENGTH_EXTENDED_DRONE; i++) printf("%u ", s[i]);
 
@@ -49,5 +56,42 @@ int main(void) {
     assert(drone_old.network.heartbeat_at == drone.network.heartbeat_at);
     assert(drone_old.network.signal == drone.network.signal);
 
+    // Decode with the same message.
+    struct ExtendedDrone drone_new = {0};
+    DecodeExtendedDrone(&drone_new, s);
+
+    assert(drone_new.flight.pose.roll == drone.flight.pose.roll);
+    assert(drone_new.flight.field_new == drone.flight.field_new);
+    assert(drone_new.propellers[1].id == drone.propellers[1].id);
+    assert(drone_new.propellers[1].field_new == drone.propellers[1].field_new);
+    assert(drone_new.network.heartbeat_at == drone.network.heartbeat_at);
+    assert(drone_new.network.signal == drone.network.signal);
+
+    // Decode with the same message with bounds checking.
+    struct ExtendedDrone drone_new_n = {0};
+    assert(DecodeExtendedDroneN(&drone_new_n, s, BYTES_LENGTH_EXTENDED_DRONE) ==
+           0);
+    assert(drone_new_n.flight.pose.yaw == drone.flight.pose.yaw);
+    assert(drone_new_n.flight.field_new == drone.flight.field_new);
+    assert(drone_new_n.propellers[0].field_new == drone.propellers[0].field_new);
+    assert(drone_new_n.network.heartbeat_at == drone.network.heartbeat_at);
+
+    // Decode with old message with bounds checking.
+    // The extended fields are skipped, the whole extended buffer is required.
+    struct Drone drone_old_n = {0};
+    assert(DecodeDroneN(&drone_old_n, s, BYTES_LENGTH_DRONE) ==
+           BP_ERR_SHORT_INPUT);
+    assert(DecodeDroneN(&drone_old_n, s, BYTES_LENGTH_EXTENDED_DRONE) == 0);
+    assert(drone_old_n.network.heartbeat_at == drone.network.heartbeat_at);
+    assert(drone_old_n.network.signal == drone.network.signal);
+
+    // Masked decoding with old message, the extended fields are skipped still.
+    struct Drone drone_old_m = {0};
+    assert(DecodeDroneMasked(&drone_old_m, s, FIELD_MASK_DRONE_NETWORK) == 0);
+    assert(drone_old_m.status == 0);
+    assert(drone_old_m.position.altitude == 0);
+    assert(drone_old_m.network.heartbeat_at == drone.network.heartbeat_at);
+    assert(drone_old_m.network.signal == drone.network.signal);
+
     return 0;
 }
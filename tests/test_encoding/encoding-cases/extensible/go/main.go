@@ -54,4 +54,23 @@ func main() {
 	assert(droneOld.Propellers[1].Direction == bpOrigin.RotatingDirection(drone.Propellers[1].Direction))
 	assert(droneOld.Network.HeartbeatAt == bpOrigin.Timestamp(drone.Network.HeartbeatAt))
 	assert(droneOld.Network.Signal == drone.Network.Signal)
+
+	// Decode with the same message
+	droneNew := &bpExtended.Drone{}
+	droneNew.Decode(s)
+
+	assert(droneNew.Flight.Pose.Roll == drone.Flight.Pose.Roll)
+	assert(droneNew.Flight.FieldNew == drone.Flight.FieldNew)
+	assert(droneNew.Propellers[1].Id == drone.Propellers[1].Id)
+	assert(droneNew.Propellers[1].FieldNew == drone.Propellers[1].FieldNew)
+	assert(droneNew.Network.HeartbeatAt == drone.Network.HeartbeatAt)
+	assert(droneNew.Network.Signal == drone.Network.Signal)
+
+	// Masked decoding with old message, the extended fields are skipped still.
+	droneOldM := &bpOrigin.Drone{}
+	droneOldM.DecodeMasked(s, bpOrigin.FIELD_MASK_DRONE_NETWORK)
+	assert(droneOldM.Status == 0)
+	assert(droneOldM.Position.Altitude == 0)
+	assert(droneOldM.Network.HeartbeatAt == bpOrigin.Timestamp(drone.Network.HeartbeatAt))
+	assert(droneOldM.Network.Signal == drone.Network.Signal)
 }
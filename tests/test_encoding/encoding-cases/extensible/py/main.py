@@ -45,6 +45,12 @@ def main() -> None:
     assert drone_old.network.heartbeat_at == drone.network.heartbeat_at
     assert drone_old.network.signal == drone.network.signal
 
+    # Decode from a shared buffer at an offset, the same to decode.
+    buf = bytearray(3) + s
+    drone_old_from = origin_bp.Drone()
+    drone_old_from.decode_from(memoryview(buf), 3)
+    assert drone_old_from == drone_old
+
 
 if __name__ == "__main__":
     main()
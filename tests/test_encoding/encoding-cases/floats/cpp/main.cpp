@@ -0,0 +1,54 @@
+#include <cassert>
+#include <cstdio>
+
+#include "floats_bp.hpp"
+
+int main(void) {
+    // Encode.
+    struct Track m = {};
+    for (int i = 0; i < 2; i++) {
+        m.poses[i].armed = i == 0;
+        m.poses[i].x = 1.5f + (float)i;
+        m.poses[i].y = -0.15625f * (float)(i + 1);
+        m.poses[i].heading = -12.5f + (float)i * 3.25f;
+        m.poses[i].speed = 3.140625f * (float)(i + 1);
+        m.poses[i].temperature = -40.0625f + (float)i;
+        m.poses[i].q[0] = 1.0f;
+        m.poses[i].q[1] = 0.0f;
+        m.poses[i].q[2] = -0.5f;
+        m.poses[i].q[3] = 0.25f * (float)i;
+        m.poses[i].latitude = 52.37500095367431640625 + (double)i;
+    }
+    for (int i = 0; i < 5; i++) m.samples[i] = 1e-3f * (float)(1 << (i * 4));
+    // Rounded half away from zero, to 1.0, 2.125 and -2.125.
+    m.offsets[0] = 1.0625f - 0.0625f;
+    m.offsets[1] = 2.0625f;
+    m.offsets[2] = -2.0625f;
+    m.flags = 5;
+    unsigned char s[BYTES_LENGTH_TRACK] = {0};
+    bitproto::Encode(m, s);
+
+    // Output
+    for (int i = 0; i < BYTES_LENGTH_TRACK; i++) printf("%u ", s[i]);
+
+    // Decode.
+    struct Track m1 = {};
+    bitproto::Decode(m1, s);
+
+    for (int i = 0; i < 2; i++) {
+        assert(m1.poses[i].armed == m.poses[i].armed);
+        assert(m1.poses[i].x == m.poses[i].x);
+        assert(m1.poses[i].y == m.poses[i].y);
+        assert(m1.poses[i].heading == m.poses[i].heading);
+        assert(m1.poses[i].speed == m.poses[i].speed);
+        assert(m1.poses[i].temperature == m.poses[i].temperature);
+        for (int k = 0; k < 4; k++) assert(m1.poses[i].q[k] == m.poses[i].q[k]);
+        assert(m1.poses[i].latitude == m.poses[i].latitude);
+    }
+    for (int i = 0; i < 5; i++) assert(m1.samples[i] == m.samples[i]);
+    assert(m1.offsets[0] == 1.0f);
+    assert(m1.offsets[1] == 2.125f);
+    assert(m1.offsets[2] == -2.125f);
+    assert(m1.flags == m.flags);
+    return 0;
+}
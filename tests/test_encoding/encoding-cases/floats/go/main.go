@@ -0,0 +1,49 @@
+package main
+
+import (
+	"fmt"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/floats/go/bp"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+func main() {
+	// Encode
+	m := &bp.Track{}
+	for i := 0; i < 2; i++ {
+		m.Poses[i].Armed = i == 0
+		m.Poses[i].X = float32(1.5) + float32(i)
+		m.Poses[i].Y = float32(-0.15625) * float32(i+1)
+		m.Poses[i].Heading = float32(-12.5) + float32(i)*float32(3.25)
+		m.Poses[i].Speed = float32(3.140625) * float32(i+1)
+		m.Poses[i].Temperature = bp.Celsius(float32(-40.0625) + float32(i))
+		m.Poses[i].Q = bp.Quaternion{1, 0, -0.5, float32(0.25) * float32(i)}
+		m.Poses[i].Latitude = 52.37500095367431640625 + float64(i)
+	}
+	for i := 0; i < 5; i++ {
+		m.Samples[i] = float32(1e-3) * float32(int(1)<<(i*4))
+	}
+	// Rounded half away from zero, to 1.0, 2.125 and -2.125.
+	m.Offsets = [3]float32{1.0625 - 0.0625, 2.0625, -2.0625}
+	m.Flags = 5
+
+	s := m.Encode()
+
+	for _, b := range s {
+		fmt.Printf("%d ", b)
+	}
+
+	// Decode
+	m1 := &bp.Track{}
+	m1.Decode(s)
+
+	assert(m1.Poses == m.Poses)
+	assert(m1.Samples == m.Samples)
+	assert(m1.Offsets == [3]float32{1, 2.125, -2.125})
+	assert(m1.Flags == m.Flags)
+}
@@ -0,0 +1,50 @@
+import struct
+
+import floats_bp as bp
+
+
+def float32(v: float) -> float:
+    """Rounds v to single precision, as float32 values are on the wire."""
+    return struct.unpack("<f", struct.pack("<f", v))[0]
+
+
+def main() -> None:
+    # Encode
+    m = bp.Track()
+    for i in range(2):
+        m.poses[i].armed = i == 0
+        m.poses[i].x = 1.5 + i
+        m.poses[i].y = -0.15625 * (i + 1)
+        m.poses[i].heading = -12.5 + i * 3.25
+        m.poses[i].speed = 3.140625 * (i + 1)
+        m.poses[i].temperature = -40.0625 + i
+        m.poses[i].q = [1.0, 0.0, -0.5, 0.25 * i]
+        m.poses[i].latitude = 52.37500095367431640625 + i
+    for i in range(5):
+        m.samples[i] = float32(1e-3) * (1 << (i * 4))
+    # Rounded half away from zero, to 1.0, 2.125 and -2.125.
+    m.offsets = [1.0625 - 0.0625, 2.0625, -2.0625]
+    m.flags = 5
+
+    s = m.encode()  # bytearray
+
+    for b in s:
+        print(int(b), end=" ")
+
+    # Decode
+    m1 = bp.Track()
+    m1.decode(s)
+
+    assert m1.poses == m.poses
+    assert m1.samples == m.samples
+    assert m1.offsets == [1.0, 2.125, -2.125]
+    assert m1.flags == m.flags
+
+    # Decode through the view.
+    v = bp.TrackView(s)
+    assert v.to_message() == m1
+    assert v.poses[1].latitude == m.poses[1].latitude
+
+
+if __name__ == "__main__":
+    main()
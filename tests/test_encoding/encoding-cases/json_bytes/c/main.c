@@ -0,0 +1,56 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "json_bytes_bp.h"
+
+int main(void) {
+    struct Packet packet = {0};
+
+    unsigned char key[3] = {0x00, 0x7f, 0xff};
+    unsigned char digest[5] = {0xde, 0xad, 0xbe, 0xef, 0x01};
+    unsigned char data[4] = {'b', 'i', 't', 's'};
+    unsigned char tail[5] = {0xfb, 0xff, 0x00, 0x10, 0x83};
+    memcpy(packet.key, key, sizeof(key));
+    memcpy(packet.digest, digest, sizeof(digest));
+    packet.chunks[0].seq = 1;
+    memcpy(packet.chunks[0].data, data, sizeof(data));
+    memcpy(packet.chunks[0].tail, tail, sizeof(tail));
+    packet.chunks[1].seq = 2;
+    packet.ports[0] = 80;
+    packet.ports[1] = 443;
+    packet.one[0] = 0xa5;
+    packet.raw.plain[0] = 1;
+    packet.raw.plain[2] = 255;
+
+    char s[JSON_MAX_LENGTH_PACKET + 1];
+    int n = JsonPacketN(&packet, s, sizeof(s));
+    assert(n < (int)sizeof(s));
+    printf("%s", s);
+
+    // Json parsing round trip.
+    struct Packet packet_new;
+    memset(&packet_new, 0xff, sizeof(packet_new));
+    assert(ParseJsonPacket(&packet_new, s, n) == 0);
+    assert(memcmp(packet_new.key, key, sizeof(key)) == 0);
+    assert(memcmp(packet_new.digest, digest, sizeof(digest)) == 0);
+    assert(memcmp(packet_new.chunks[0].tail, tail, sizeof(tail)) == 0);
+    char t[JSON_MAX_LENGTH_PACKET + 1];
+    assert(JsonPacketN(&packet_new, t, sizeof(t)) == n);
+    assert(strcmp(s, t) == 0);
+
+    // Malformed strings.
+    const char *bad[] = {
+        "{\"key\": \"00112\"}",
+        "{\"key\": \"0011223344\"}",
+        "{\"key\": \"00zz11\"}",
+        "{\"chunks\": [{\"data\": \"Yml0c===\"}]}",
+        "{\"chunks\": [{\"data\": \"Yml0cw\"}]}",
+        "{\"chunks\": [{\"data\": \"Yml0cxxx\"}]}",
+        "{\"raw\": {\"plain\": \"010203\"}}",
+    };
+    for (size_t k = 0; k < sizeof(bad) / sizeof(bad[0]); k++)
+        assert(ParseJsonPacket(&packet_new, bad[k], (int)strlen(bad[k])) ==
+               BP_ERR_JSON);
+    return 0;
+}
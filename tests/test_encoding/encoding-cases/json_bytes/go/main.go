@@ -0,0 +1,33 @@
+package main
+
+import (
+	"encoding/json"
+	"fmt"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/json_bytes/go/bp"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+func main() {
+	packet := &bp.Packet{}
+	packet.Key = [3]byte{0x00, 0x7f, 0xff}
+	packet.Digest = bp.Digest{0xde, 0xad, 0xbe, 0xef, 0x01}
+	packet.Chunks[0].Seq = 1
+	packet.Chunks[0].Data = [4]byte{'b', 'i', 't', 's'}
+	packet.Chunks[0].Tail = [5]byte{0xfb, 0xff, 0x00, 0x10, 0x83}
+	packet.Chunks[1].Seq = 2
+	packet.Ports = [2]uint16{80, 443}
+	packet.One[0] = 0xa5
+	packet.Raw.Plain[0] = 1
+	packet.Raw.Plain[2] = 255
+
+	fmt.Printf("%s", packet.String())
+
+	v, err := json.Marshal(packet)
+	assert(err == nil && string(v) == packet.String())
+}
@@ -0,0 +1,21 @@
+import json_bytes_bp as bp
+
+
+def main() -> None:
+    packet = bp.Packet()
+    packet.key = bytearray([0x00, 0x7F, 0xFF])
+    packet.digest = bytearray([0xDE, 0xAD, 0xBE, 0xEF, 0x01])
+    packet.chunks[0].seq = 1
+    packet.chunks[0].data = bytearray(b"bits")
+    packet.chunks[0].tail = bytearray([0xFB, 0xFF, 0x00, 0x10, 0x83])
+    packet.chunks[1].seq = 2
+    packet.ports = [80, 443]
+    packet.one[0] = 0xA5
+    packet.raw.plain[0] = 1
+    packet.raw.plain[2] = 255
+
+    print(packet.to_json(indent=None, separators=(",", ":")))
+
+
+if __name__ == "__main__":
+    main()
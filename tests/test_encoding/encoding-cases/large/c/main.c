@@ -0,0 +1,35 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "large_bp.h"
+
+int main(void) {
+    // Encode.
+    static struct Payload m = {};
+    m.head.flags = 5;
+    m.head.seq = 60001;
+    for (int i = 0; i < 9000; i++) m.data[i] = (unsigned char)(i * 7 + 1);
+    for (int i = 0; i < 300; i++) m.samples[i] = (uint16_t)((i * 2857) & 4095);
+    for (int i = 0; i < 20; i++) m.heads[i] = (struct Head){i & 7, i * 3001};
+    m.ok = true;
+    static unsigned char s[BYTES_LENGTH_PAYLOAD] = {0};
+    EncodePayload(&m, s);
+
+    // Output
+    for (int i = 0; i < BYTES_LENGTH_PAYLOAD; i++) printf("%u ", s[i]);
+
+    // Decode.
+    static struct Payload m1 = {};
+    DecodePayload(&m1, s);
+
+    assert(m1.head.flags == m.head.flags);
+    assert(m1.head.seq == m.head.seq);
+    for (int i = 0; i < 9000; i++) assert(m1.data[i] == m.data[i]);
+    for (int i = 0; i < 300; i++) assert(m1.samples[i] == m.samples[i]);
+    for (int i = 0; i < 20; i++) {
+        assert(m1.heads[i].flags == m.heads[i].flags);
+        assert(m1.heads[i].seq == m.heads[i].seq);
+    }
+    assert(m1.ok == m.ok);
+    return 0;
+}
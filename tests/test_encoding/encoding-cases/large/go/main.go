@@ -0,0 +1,47 @@
+package main
+
+import (
+	"fmt"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/large/go/bp"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+func main() {
+	// Encode
+	m := &bp.Payload{}
+	m.Head.Flags = 5
+	m.Head.Seq = 60001
+	for i := 0; i < 9000; i++ {
+		m.Data[i] = byte(i*7 + 1)
+	}
+	for i := 0; i < 300; i++ {
+		m.Samples[i] = uint16((i * 2857) & 4095)
+	}
+	for i := 0; i < 20; i++ {
+		m.Heads[i].Flags = uint8(i & 7)
+		m.Heads[i].Seq = uint16(i * 3001)
+	}
+	m.Ok = true
+
+	s := m.Encode()
+
+	for _, b := range s {
+		fmt.Printf("%d ", b)
+	}
+
+	// Decode
+	m1 := &bp.Payload{}
+	m1.Decode(s)
+
+	assert(m1.Head == m.Head)
+	assert(m1.Data == m.Data)
+	assert(m1.Samples == m.Samples)
+	assert(m1.Heads == m.Heads)
+	assert(m1.Ok == m.Ok)
+}
@@ -0,0 +1,37 @@
+import large_bp as bp
+
+
+def main() -> None:
+    # Encode
+    m = bp.Payload()
+    m.head.flags = 5
+    m.head.seq = 60001
+    for i in range(9000):
+        m.data[i] = (i * 7 + 1) & 255
+    for i in range(300):
+        m.samples[i] = (i * 2857) & 4095
+    for i in range(20):
+        m.heads[i] = bp.Head(i & 7, i * 3001)
+    m.ok = True
+
+    s = m.encode()  # bytearray
+
+    for b in s:
+        print(int(b), end=" ")
+
+    # Decode
+    m1 = bp.Payload()
+    m1.decode(s)
+
+    assert m1.head.flags == m.head.flags
+    assert m1.head.seq == m.head.seq
+    assert m1.data == m.data
+    assert m1.samples == m.samples
+    for i in range(20):
+        assert m1.heads[i].flags == m.heads[i].flags
+        assert m1.heads[i].seq == m.heads[i].seq
+    assert m1.ok == m.ok
+
+
+if __name__ == "__main__":
+    main()
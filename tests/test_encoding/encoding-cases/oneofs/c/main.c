@@ -0,0 +1,84 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "oneofs_bp.h"
+
+static void print(const unsigned char *s, int n) {
+    printf("%d: ", n);
+    for (int i = 0; i < n; i++) printf("%u ", s[i]);
+    printf("\n");
+}
+
+int main(void) {
+    unsigned char s[BYTES_LENGTH_COMMAND] = {0};
+    int n;
+
+    // Ping.
+    struct Command c = {0};
+    c.tag = TAG_COMMAND_PING;
+    c.u.ping.seq = 4000000001U;
+    n = EncodeCommand(&c, s);
+    print(s, n);
+    struct Command c1 = {0};
+    assert(DecodeCommand(&c1, s, n) == 0);
+    assert(c1.tag == TAG_COMMAND_PING);
+    assert(c1.u.ping.seq == c.u.ping.seq);
+
+    // Move.
+    c.tag = TAG_COMMAND_MOVE;
+    c.u.move.x = -300;
+    c.u.move.y = 32000;
+    c.u.move.fast = true;
+    c.u.move.mode = MODE_LAND;
+    n = EncodeCommand(&c, s);
+    print(s, n);
+    assert(DecodeCommand(&c1, s, n) == 0);
+    assert(c1.tag == TAG_COMMAND_MOVE);
+    assert(c1.u.move.x == c.u.move.x);
+    assert(c1.u.move.y == c.u.move.y);
+    assert(c1.u.move.fast == c.u.move.fast);
+    assert(c1.u.move.mode == c.u.move.mode);
+
+    // Lights, the largest variant.
+    c.tag = TAG_COMMAND_LIGHTS;
+    for (int i = 0; i < 64; i++) c.u.lights.on[i] = (i % 3) == 0;
+    c.u.lights.brightness = 200;
+    n = EncodeCommand(&c, s);
+    assert(n == BYTES_LENGTH_COMMAND);
+    print(s, n);
+    assert(DecodeCommand(&c1, s, n) == 0);
+    assert(c1.tag == TAG_COMMAND_LIGHTS);
+    assert(memcmp(c1.u.lights.on, c.u.lights.on, sizeof(c.u.lights.on)) == 0);
+    assert(c1.u.lights.brightness == c.u.lights.brightness);
+
+    // Errors.
+    assert(DecodeCommand(&c1, s, n - 1) == BP_ERR_SHORT_INPUT);
+    assert(DecodeCommand(&c1, s, 0) == BP_ERR_SHORT_INPUT);
+    s[0] &= ~3;
+    assert(DecodeCommand(&c1, s, n) == BP_ERR_TAG);
+    c.tag = 0;
+    assert(EncodeCommand(&c, s) == BP_ERR_TAG);
+    c.tag = 4;
+    assert(EncodeCommand(&c, s) == BP_ERR_TAG);
+
+    // Byte-aligned variants.
+    unsigned char t[BYTES_LENGTH_REPORT] = {0};
+    struct Report r = {0};
+    r.tag = TAG_REPORT_MOVE;
+    r.u.move.x = 1234;
+    r.u.move.y = -5678;
+    r.u.move.mode = MODE_HOVER;
+    n = EncodeReport(&r, t);
+    print(t, n);
+    struct Report r1 = {0};
+    assert(DecodeReport(&r1, t, n) == 0);
+    assert(r1.tag == TAG_REPORT_MOVE);
+    assert(r1.u.move.x == r.u.move.x);
+    assert(r1.u.move.y == r.u.move.y);
+    assert(r1.u.move.fast == r.u.move.fast);
+    assert(r1.u.move.mode == r.u.move.mode);
+    r.tag = 2;
+    assert(EncodeReport(&r, t) == BP_ERR_TAG);
+    return 0;
+}
@@ -0,0 +1,83 @@
+package main
+
+import (
+	"fmt"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/oneofs/go/bp"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+func print(s []byte) {
+	fmt.Printf("%d: ", len(s))
+	for _, b := range s {
+		fmt.Printf("%d ", b)
+	}
+	fmt.Printf("\n")
+}
+
+func main() {
+	// Ping.
+	c := &bp.Command{Tag: bp.TAG_COMMAND_PING}
+	c.Ping.Seq = 4000000001
+	s := c.Encode()
+	print(s)
+	c1 := &bp.Command{}
+	assert(c1.Decode(s) == nil)
+	assert(c1.Tag == bp.TAG_COMMAND_PING)
+	assert(c1.Ping == c.Ping)
+
+	// Move.
+	c.Tag = bp.TAG_COMMAND_MOVE
+	c.Move.X = -300
+	c.Move.Y = 32000
+	c.Move.Fast = true
+	c.Move.Mode = bp.MODE_LAND
+	s = c.Encode()
+	print(s)
+	assert(c1.Decode(s) == nil)
+	assert(c1.Tag == bp.TAG_COMMAND_MOVE)
+	assert(c1.Move == c.Move)
+
+	// Lights, the largest variant.
+	c.Tag = bp.TAG_COMMAND_LIGHTS
+	for i := 0; i < 64; i++ {
+		c.Lights.On[i] = i%3 == 0
+	}
+	c.Lights.Brightness = 200
+	s = c.Encode()
+	assert(len(s) == int(bp.BYTES_LENGTH_COMMAND))
+	print(s)
+	assert(c1.Decode(s) == nil)
+	assert(c1.Tag == bp.TAG_COMMAND_LIGHTS)
+	assert(c1.Lights == c.Lights)
+
+	// Errors.
+	assert(c1.Decode(s[:len(s)-1]) != nil)
+	assert(c1.Decode(nil) != nil)
+	s[0] &^= 3
+	assert(c1.Decode(s) != nil)
+	c.Tag = 0
+	assert(c.Encode() == nil)
+	c.Tag = 4
+	_, err := c.EncodeTo(s)
+	assert(err != nil)
+
+	// Byte-aligned variants.
+	r := &bp.Report{Tag: bp.TAG_REPORT_MOVE}
+	r.Move.X = 1234
+	r.Move.Y = -5678
+	r.Move.Mode = bp.MODE_HOVER
+	t := r.Encode()
+	print(t)
+	r1 := &bp.Report{}
+	assert(r1.Decode(t) == nil)
+	assert(r1.Tag == bp.TAG_REPORT_MOVE)
+	assert(r1.Move == r.Move)
+	r.Tag = 2
+	assert(r.Encode() == nil)
+}
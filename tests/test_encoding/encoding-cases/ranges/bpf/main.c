@@ -0,0 +1,42 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ranges_bp_bpf.h"
+
+// The frame encoded by the other languages, decoded as an XDP program would,
+// bounded by the end of the packet.
+static const unsigned char s[] = {0,   0,   0,   32,  0,   0,   60,
+                                  156, 100, 61,  244, 81,  230, 225,
+                                  36,  235, 163, 143, 114, 128, 12};
+
+int main(void) {
+    const void *data = s, *data_end = s + sizeof(s);
+
+    // Decode.
+    struct Log m = {0};
+    assert(DecodeLogBpf(&m, data, data_end) == 0);
+    for (int i = 0; i < 3; i++) {
+        assert(m.records[i].altitude == 1000 + i * 9999);
+        assert(m.records[i].battery == i * 50);
+        assert(m.records[i].temperature == -40 + i * 61);
+        assert(m.records[i].armed == ((i % 2) == 0));
+        assert(m.records[i].timestamp == 4000000000U + i * 500);
+        assert(m.records[i].base == INT64_MIN + i * 404);
+    }
+    assert(m.delta == -99);
+    assert(m.seq == 100);
+
+    // Single fields, and frames cut short.
+    int8_t delta = 0;
+    uint8_t seq = 0;
+    assert(BpBpfGetLog_delta(data, data_end, &delta) == 0 && delta == -99);
+    assert(BpBpfGetLog_seq(data, data_end, &seq) == 0 && seq == 100);
+    assert(BpBpfGetLog_delta(data, s + 20, &delta) == 0);
+    assert(BpBpfGetLog_seq(data, s + 20, &seq) == BP_ERR_SHORT_INPUT);
+    assert(DecodeLogBpf(&m, data, s + 20) == BP_ERR_SHORT_INPUT);
+
+    // Output
+    for (size_t i = 0; i < sizeof(s); i++) printf("%u ", s[i]);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "ranges_bp.h"
+
+int main(void) {
+    // Encode.
+    struct Log m = {};
+    for (int i = 0; i < 3; i++) {
+        m.records[i].altitude = (uint16_t)(1000 + i * 9999);
+        m.records[i].battery = (uint8_t)(i * 50);
+        m.records[i].temperature = (int32_t)(-40 + i * 61);
+        m.records[i].armed = (i % 2) == 0;
+        m.records[i].timestamp = (uint32_t)(4000000000U + i * 500);
+        m.records[i].base = INT64_MIN + i * 404;
+    }
+    m.delta = -99;
+    m.seq = 100;
+    unsigned char s[BYTES_LENGTH_LOG] = {0};
+    EncodeLog(&m, s);
+
+    // Output
+    for (int i = 0; i < BYTES_LENGTH_LOG; i++) printf("%u ", s[i]);
+
+    // Decode.
+    struct Log m1 = {};
+    DecodeLog(&m1, s);
+
+    for (int i = 0; i < 3; i++) {
+        assert(m1.records[i].altitude == m.records[i].altitude);
+        assert(m1.records[i].battery == m.records[i].battery);
+        assert(m1.records[i].temperature == m.records[i].temperature);
+        assert(m1.records[i].armed == m.records[i].armed);
+        assert(m1.records[i].timestamp == m.records[i].timestamp);
+        assert(m1.records[i].base == m.records[i].base);
+    }
+    assert(m1.delta == m.delta);
+    assert(m1.seq == m.seq);
+
+    // Read fields in place by the generated field layouts.
+    static const struct BpFieldLayout layouts[] = BP_FIELDS_LOG;
+    assert(sizeof(layouts) / sizeof(layouts[0]) == BP_NFIELDS_LOG);
+    assert(layouts[2].offset == BP_OFFSET_BITS_LOG_SEQ);
+    assert(layouts[2].nbits == BP_NBITS_LOG_SEQ);
+    unsigned int seq = 0;
+    for (int k = 0; k < BP_NBITS_LOG_SEQ; k++) {
+        int i = BP_OFFSET_BITS_LOG_SEQ + k;
+        seq |= (unsigned int)((s[i / 8] >> (i % 8)) & 1) << k;
+    }
+    assert(seq == m.seq);
+    return 0;
+}
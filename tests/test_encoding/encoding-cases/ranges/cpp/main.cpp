@@ -0,0 +1,40 @@
+#include <cassert>
+#include <cstdio>
+
+#include "ranges_bp.hpp"
+
+int main(void) {
+    // Encode.
+    struct Log m = {};
+    for (int i = 0; i < 3; i++) {
+        m.records[i].altitude = (uint16_t)(1000 + i * 9999);
+        m.records[i].battery = (uint8_t)(i * 50);
+        m.records[i].temperature = (int32_t)(-40 + i * 61);
+        m.records[i].armed = (i % 2) == 0;
+        m.records[i].timestamp = (uint32_t)(4000000000U + i * 500);
+        m.records[i].base = INT64_MIN + i * 404;
+    }
+    m.delta = -99;
+    m.seq = 100;
+    unsigned char s[BYTES_LENGTH_LOG] = {0};
+    bitproto::Encode(m, s);
+
+    // Output
+    for (int i = 0; i < BYTES_LENGTH_LOG; i++) printf("%u ", s[i]);
+
+    // Decode.
+    struct Log m1 = {};
+    bitproto::Decode(m1, s);
+
+    for (int i = 0; i < 3; i++) {
+        assert(m1.records[i].altitude == m.records[i].altitude);
+        assert(m1.records[i].battery == m.records[i].battery);
+        assert(m1.records[i].temperature == m.records[i].temperature);
+        assert(m1.records[i].armed == m.records[i].armed);
+        assert(m1.records[i].timestamp == m.records[i].timestamp);
+        assert(m1.records[i].base == m.records[i].base);
+    }
+    assert(m1.delta == m.delta);
+    assert(m1.seq == m.seq);
+    return 0;
+}
@@ -0,0 +1,43 @@
+package main
+
+import (
+	"fmt"
+	"math"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/ranges/go/bp"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+func main() {
+	// Encode
+	m := &bp.Log{}
+	for i := 0; i < 3; i++ {
+		m.Records[i].Altitude = uint16(1000 + i*9999)
+		m.Records[i].Battery = uint8(i * 50)
+		m.Records[i].Temperature = int32(-40 + i*61)
+		m.Records[i].Armed = i%2 == 0
+		m.Records[i].Timestamp = uint32(4000000000 + i*500)
+		m.Records[i].Base = math.MinInt64 + int64(i*404)
+	}
+	m.Delta = -99
+	m.Seq = 100
+
+	s := m.Encode()
+
+	for _, b := range s {
+		fmt.Printf("%d ", b)
+	}
+
+	// Decode
+	m1 := &bp.Log{}
+	m1.Decode(s)
+
+	assert(m1.Records == m.Records)
+	assert(m1.Delta == m.Delta)
+	assert(m1.Seq == m.Seq)
+}
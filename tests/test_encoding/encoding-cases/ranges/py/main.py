@@ -0,0 +1,35 @@
+import ranges_bp as bp
+
+
+def main() -> None:
+    # Encode
+    m = bp.Log()
+    for i in range(3):
+        m.records[i].altitude = 1000 + i * 9999
+        m.records[i].battery = i * 50
+        m.records[i].temperature = -40 + i * 61
+        m.records[i].armed = i % 2 == 0
+        m.records[i].timestamp = 4000000000 + i * 500
+        m.records[i].base = -(1 << 63) + i * 404
+    m.delta = -99
+    m.seq = 100
+
+    s = m.encode()  # bytearray
+
+    for b in s:
+        print(int(b), end=" ")
+
+    # Decode
+    m1 = bp.Log()
+    m1.decode(s)
+
+    assert m1 == m
+
+    # Decode through the view.
+    v = bp.LogView(s)
+    assert v.to_message() == m
+    assert v.records[2].temperature == m.records[2].temperature
+
+
+if __name__ == "__main__":
+    main()
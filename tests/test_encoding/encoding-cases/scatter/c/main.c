@@ -1,8 +1,33 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "scatter_bp.h"
 
+static void AssertEqualB(struct B *b, struct B *b1) {
+    assert(b->a.a == b1->a.a);
+    assert(b->a.b == b1->a.b);
+    assert(b->a.c == b1->a.c);
+    assert(b->a.d == b1->a.d);
+    assert(b->a.e == b1->a.e);
+    assert(b->a.f == b1->a.f);
+    assert(b->a.g == b1->a.g);
+    assert(b->a.h == b1->a.h);
+    assert(b->a.i == b1->a.i);
+    assert(b->a.j == b1->a.j);
+    assert(b->a.k == b1->a.k);
+    assert(b->a.l == b1->a.l);
+    assert(b->a.m == b1->a.m);
+    assert(b->a.n == b1->a.n);
+    assert(b->a.p == b1->a.p);
+    assert(b->a.q == b1->a.q);
+    assert(b->a.r == b1->a.r);
+    assert(b->a.s == b1->a.s);
+    assert(b->a.t == b1->a.t);
+    assert(b->b == b1->b);
+    assert(b->c == b1->c);
+}
+
 int main(void) {
     // Encode.
     struct B b = {0};
@@ -32,6 +57,12 @@ int main(void) {
     unsigned char s[BYTES_LENGTH_B] = {0};
     EncodeB(&b, s);
 
+    // Encode into a dirty buffer, it's not required to be zeroed.
+    unsigned char s_dirty[BYTES_LENGTH_B];
+    memset(s_dirty, 0xff, sizeof(s_dirty));
+    EncodeB(&b, s_dirty);
+    assert(memcmp(s, s_dirty, sizeof(s_dirty)) == 0);
+
     // Output
     for (int i = 0; i < BYTES_LENGTH_B; i++) printf("%u ", s[i]);
 
@@ -39,26 +70,12 @@ int main(void) {
     struct B b1 = {0};
     DecodeB(&b1, s);
 
-    assert(b.a.a == b1.a.a);
-    assert(b.a.b == b1.a.b);
-    assert(b.a.c == b1.a.c);
-    assert(b.a.d == b1.a.d);
-    assert(b.a.e == b1.a.e);
-    assert(b.a.f == b1.a.f);
-    assert(b.a.g == b1.a.g);
-    assert(b.a.h == b1.a.h);
-    assert(b.a.i == b1.a.i);
-    assert(b.a.j == b1.a.j);
-    assert(b.a.k == b1.a.k);
-    assert(b.a.l == b1.a.l);
-    assert(b.a.m == b1.a.m);
-    assert(b.a.n == b1.a.n);
-    assert(b.a.p == b1.a.p);
-    assert(b.a.q == b1.a.q);
-    assert(b.a.r == b1.a.r);
-    assert(b.a.s == b1.a.s);
-    assert(b.a.t == b1.a.t);
-    assert(b.b == b1.b);
-    assert(b.c == b1.c);
+    AssertEqualB(&b, &b1);
+
+    // Decode into a struct of stale bits, it's not required to be zeroed.
+    struct B b_dirty;
+    memset(&b_dirty, 0xff, sizeof(b_dirty));
+    DecodeB(&b_dirty, s);
+    AssertEqualB(&b, &b_dirty);
     return 0;
 }
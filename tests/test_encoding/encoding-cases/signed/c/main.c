@@ -1,8 +1,24 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "signed_bp.h"
 
+// COPY_PLANS is defined by the build of the copy plan variant, c.copy_plans.
+#if !defined(BITPROTO_OPTIMIZATION_MODE) && defined(COPY_PLANS)
+// Sink appending the chunks to the buffer at arg.
+struct Out {
+    unsigned char s[2048];
+    int n;
+};
+
+static void Collect(const unsigned char *s, int n, void *arg) {
+    struct Out *out = (struct Out *)arg;
+    memcpy(out->s + out->n, s, n);
+    out->n += n;
+}
+#endif
+
 int main(void) {
     // Encode
     struct Y y = {0};
@@ -16,6 +32,11 @@ int main(void) {
     y.xs[1].a = -2008;
     y.p = 0;
     y.q = -1;
+    for (int k = 0; k < 10; k++) y.samples[k] = (k % 2) ? -2048 + k : 2047 - k;
+    for (int k = 0; k < 5; k++) y.pressures[k] = (k % 2) ? -8388608 + k : 8388607 - k;
+    y.w = -4611686018427387903LL - 1;
+    y.ws[0] = 2305843009213693951LL;
+    y.ws[1] = -2305843009213693951LL - 1;
 
     unsigned char s[BYTES_LENGTH_Y] = {0};
     EncodeY(&y, s);
@@ -36,6 +57,96 @@ int main(void) {
     assert(y1.xs[1].a == y.xs[1].a);
     assert(y1.p == y.p);
     assert(y1.q == y.q);
+    for (int k = 0; k < 10; k++) assert(y1.samples[k] == y.samples[k]);
+    for (int k = 0; k < 5; k++) assert(y1.pressures[k] == y.pressures[k]);
+    assert(y1.w == y.w);
+    assert(y1.ws[0] == y.ws[0]);
+    assert(y1.ws[1] == y.ws[1]);
+
+#if !defined(BITPROTO_OPTIMIZATION_MODE) && defined(COPY_PLANS)
+    // Incremental decoding, from chunks of 3 bytes.
+    struct Y y3 = {0};
+    struct BpPlanDecoder ctx;
+    DecodeYStart(&ctx, &y3);
+    for (int k = 0; k < BYTES_LENGTH_Y; k += 3) {
+        int n = BYTES_LENGTH_Y - k < 3 ? BYTES_LENGTH_Y - k : 3;
+        assert(!BpPlanDecoderDone(&ctx));
+        assert(BpDecodePlanChunk(&ctx, s + k, n) == n);
+    }
+    assert(BpPlanDecoderDone(&ctx));
+    assert(memcmp(&y3, &y1, sizeof(struct Y)) == 0);
+
+    // Encoding through a sink, with a buffer of 5 bytes.
+    struct Out out = {{0}, 0};
+    unsigned char w[5];
+    memset(w, 0xff, sizeof(w));
+    EncodeYSink(&y, w, sizeof(w), Collect, &out);
+    assert(out.n == BYTES_LENGTH_Y);
+    assert(memcmp(out.s, s, BYTES_LENGTH_Y) == 0);
+#endif
+
+#ifndef BITPROTO_OPTIMIZATION_MODE
+    // Framed encoding and decoding.
+    unsigned char sf[BYTES_LENGTH_Y_FRAMED];
+    int nf = EncodeYFramed(&y, sf);
+    assert(sf[nf - 1] == 0xc0);
+    struct Y y4 = {0};
+    assert(DecodeYFramed(&y4, sf, nf) == 0);
+    assert(memcmp(&y4, &y1, sizeof(struct Y)) == 0);
+#endif
+
+    // Batch decoding, agrees with decoding the records one by one.
+    enum { NBATCH = 37 };
+    static struct Y ys[NBATCH];
+    static struct Y ys1[NBATCH];
+    static unsigned char sb[NBATCH * BYTES_LENGTH_Y];
+    for (int k = 0; k < NBATCH; k++) {
+        struct Y yk = y;
+        yk.x.a = -11 * k;
+        yk.x.b[k % 3] = (int8_t)(k - 64);
+        yk.xs[k % 2].c = 8388607 - 4099 * k;
+        yk.p = (int8_t)(-(k % 2));
+        yk.q = (int8_t)(k % 4 - 2);
+        yk.samples[k % 10] = (int16_t)(-2048 + 97 * k);
+        yk.pressures[k % 5] = -8388608 + 104729 * k;
+        EncodeY(&yk, sb + k * BYTES_LENGTH_Y);
+        DecodeY(&ys[k], sb + k * BYTES_LENGTH_Y);
+    }
+    DecodeYBatch(ys1, NBATCH, sb);
+    assert(memcmp(ys1, ys, sizeof(ys)) == 0);
+
+    // Single field accessors.
+    assert(BpGetY_x_a(s) == y.x.a);
+    assert(BpGetY_x_c(s) == y.x.c);
+    assert(BpGetY_p(s) == y.p);
+    assert(BpGetY_q(s) == y.q);
+
+    unsigned char s2[BYTES_LENGTH_Y];
+    memcpy(s2, s, BYTES_LENGTH_Y);
+    BpSetY_x_a(s2, -8388608);
+    BpSetY_q(s2, 1);
+    assert(BpGetY_x_a(s2) == -8388608);
+    assert(BpGetY_q(s2) == 1);
+
+    struct Y y2 = {0};
+    DecodeY(&y2, s2);
+    assert(y2.x.a == -8388608);
+    assert(y2.x.b[0] == y.x.b[0]);
+    assert(y2.q == 1);
+    assert(y2.p == y.p);
+    assert(y2.samples[0] == y.samples[0]);
+
+#ifndef BITPROTO_OPTIMIZATION_MODE
+    // Instrumentation, built with -DBP_TRACE_STATS.
+    struct BpTraceStat *stat = NULL;
+    for (int k = 0; k < BP_TRACE_STATS; k++)
+        if (BpTraceStats[k].name && strcmp(BpTraceStats[k].name, "Y") == 0)
+            stat = &BpTraceStats[k];
+    assert(stat != NULL);
+    assert(stat->count[BP_TRACE_ENCODE] > 0 && stat->count[BP_TRACE_DECODE] > 0);
+    assert(stat->bytes[BP_TRACE_DECODE] ==
+           (uint64_t)stat->count[BP_TRACE_DECODE] * BYTES_LENGTH_Y);
+#endif
 
     return 0;
 }
@@ -25,6 +25,23 @@ func main() {
 	y.Xs[1].A = -2008
 	y.P = 0
 	y.Q = -1
+	for k := 0; k < 10; k++ {
+		if k%2 == 1 {
+			y.Samples[k] = int16(-2048 + k)
+		} else {
+			y.Samples[k] = int16(2047 - k)
+		}
+	}
+	for k := 0; k < 5; k++ {
+		if k%2 == 1 {
+			y.Pressures[k] = int32(-8388608 + k)
+		} else {
+			y.Pressures[k] = int32(8388607 - k)
+		}
+	}
+	y.W = -4611686018427387904
+	y.Ws[0] = 2305843009213693951
+	y.Ws[1] = -2305843009213693952
 
 	s := y.Encode()
 
@@ -45,4 +62,32 @@ func main() {
 	assert(y1.Xs[1].A == y.Xs[1].A)
 	assert(y1.P == y.P)
 	assert(y1.Q == y.Q)
+	for k := 0; k < 10; k++ {
+		assert(y1.Samples[k] == y.Samples[k])
+	}
+	for k := 0; k < 5; k++ {
+		assert(y1.Pressures[k] == y.Pressures[k])
+	}
+	assert(y1.W == y.W)
+	assert(y1.Ws == y.Ws)
+
+	// Single field accessors.
+	assert(bp.BpGetY_X_A(s) == y.X.A)
+	assert(bp.BpGetY_X_C(s) == y.X.C)
+	assert(bp.BpGetY_P(s) == y.P)
+	assert(bp.BpGetY_Q(s) == y.Q)
+
+	s2 := append([]byte{}, s...)
+	bp.BpSetY_X_A(s2, -8388608)
+	bp.BpSetY_Q(s2, 1)
+	assert(bp.BpGetY_X_A(s2) == -8388608)
+	assert(bp.BpGetY_Q(s2) == 1)
+
+	y2 := &bp.Y{}
+	y2.Decode(s2)
+	assert(y2.X.A == -8388608)
+	assert(y2.X.B[0] == y.X.B[0])
+	assert(y2.Q == 1)
+	assert(y2.P == y.P)
+	assert(y2.Samples[0] == y.Samples[0])
 }
@@ -14,6 +14,12 @@ def main() -> None:
     y.xs[1].a = -2008
     y.p = 0
     y.q = -1
+    for k in range(10):
+        y.samples[k] = -2048 + k if k % 2 else 2047 - k
+    for k in range(5):
+        y.pressures[k] = -8388608 + k if k % 2 else 8388607 - k
+    y.w = -4611686018427387904
+    y.ws = [2305843009213693951, -2305843009213693952]
 
     s = y.encode()  # bytearray
 
@@ -32,6 +38,10 @@ def main() -> None:
     assert y1.xs[1].a == y.xs[1].a
     assert y1.p == y.p
     assert y1.q == y.q
+    assert y1.samples == y.samples
+    assert y1.pressures == y.pressures
+    assert y1.w == y.w
+    assert y1.ws == y.ws
 
 
 if __name__ == "__main__":
@@ -0,0 +1,30 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zerocopy_bp.h"
+
+int main(void) {
+    // Encode.
+    struct Packet m = {0};
+    m.id = 0x1234;
+    for (int i = 0; i < 8; i++) m.key[i] = (unsigned char)(i * 17 + 1);
+    m.header.kind = 5;
+    for (int i = 0; i < 5; i++) m.header.tag[i] = (unsigned char)(i * 3 + 7);
+    m.flags = 19;
+    for (int i = 0; i < 64; i++) m.payload[i] = (unsigned char)(i * 5 + 2);
+    m.trailer[0] = 9;
+    m.trailer[1] = 8;
+    m.trailer[2] = 7;
+    unsigned char s[BYTES_LENGTH_PACKET] = {0};
+    EncodePacket(&m, s);
+
+    // Output
+    for (int i = 0; i < BYTES_LENGTH_PACKET; i++) printf("%u ", s[i]);
+
+    // Decode.
+    struct Packet m1 = {0};
+    DecodePacket(&m1, s);
+    assert(memcmp(&m1, &m, sizeof(m)) == 0);
+    return 0;
+}
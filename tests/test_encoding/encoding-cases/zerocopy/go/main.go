@@ -0,0 +1,86 @@
+package main
+
+import (
+	"bytes"
+	"fmt"
+	"strings"
+
+	bp "github.com/hit9/bitproto/tests/test_encoding/encoding-cases/zerocopy/go/bp"
+)
+
+func assert(condition bool) {
+	if !condition {
+		panic("assertion failed")
+	}
+}
+
+// aliases reports whether slice b points into buffer s.
+func aliases(b, s []byte) bool {
+	for k := range s {
+		if &b[0] == &s[k] {
+			return true
+		}
+	}
+	return false
+}
+
+func main() {
+	m := bp.Packet{Id: 0x1234, Flags: 19}
+	m.Key = make([]byte, 8)
+	for i := range m.Key {
+		m.Key[i] = byte(i*17 + 1)
+	}
+	m.Header.Kind = 5
+	m.Header.Tag = make([]byte, 5)
+	for i := range m.Header.Tag {
+		m.Header.Tag[i] = byte(i*3 + 7)
+	}
+	m.Payload = make([]byte, 64)
+	for i := range m.Payload {
+		m.Payload[i] = byte(i*5 + 2)
+	}
+	m.Trailer = []byte{9, 8, 7}
+
+	s := m.Encode()
+	for _, x := range s {
+		fmt.Printf("%d ", x)
+	}
+
+	// Byte-aligned arrays alias the buffer, the others are copies.
+	m1 := bp.Packet{}
+	assert(m1.DecodeFrom(s) == nil)
+	assert(m1.Id == m.Id && m1.Flags == m.Flags && m1.Header.Kind == m.Header.Kind)
+	assert(bytes.Equal(m1.Key, m.Key) && aliases(m1.Key, s))
+	assert(bytes.Equal(m1.Payload, m.Payload) && aliases(m1.Payload, s))
+	assert(bytes.Equal(m1.Trailer, m.Trailer) && aliases(m1.Trailer, s))
+	assert(bytes.Equal(m1.Header.Tag, m.Header.Tag) && !aliases(m1.Header.Tag, s))
+	assert(len(m1.Payload) == 64 && cap(m1.Payload) == 64)
+
+	// The aliases see later writes to the buffer.
+	s[2] ^= 0xff
+	assert(m1.Key[0] == m.Key[0]^0xff)
+	s[2] ^= 0xff
+
+	// Re-encoding the decoded struct gives the same bytes.
+	assert(bytes.Equal(m1.Encode(), s))
+
+	// Short slices are padded with zeros, long slices are truncated.
+	m2 := m
+	m2.Payload = m.Payload[:10]
+	m2.Key = append(append([]byte{}, m.Key...), 1, 2, 3)
+	s2 := m2.Encode()
+	m3 := bp.Packet{}
+	m3.Decode(s2)
+	assert(bytes.Equal(m3.Payload[:10], m.Payload[:10]))
+	assert(bytes.Equal(m3.Payload[10:], make([]byte, 54)))
+	assert(bytes.Equal(m3.Key, m.Key))
+
+	// Missing bytes are formatted as zeros in json.
+	j := (&bp.Packet{Key: []byte{1}}).String()
+	assert(strings.HasPrefix(j, `{"id":0,"key":[1,0,0,0,0,0,0,0],"header":{"kind":0,"tag":[0,0,0,0,0]},`))
+
+	// Nil slices encode as zeros.
+	z := bp.Packet{Key: make([]byte, 8), Payload: make([]byte, 64), Trailer: make([]byte, 3)}
+	z.Header.Tag = make([]byte, 5)
+	assert(bytes.Equal((&bp.Packet{}).Encode(), z.Encode()))
+}
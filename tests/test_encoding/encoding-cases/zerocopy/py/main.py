@@ -0,0 +1,24 @@
+import zerocopy_bp as bp
+
+
+def main() -> None:
+    m = bp.Packet()
+    m.id = 0x1234
+    m.key = bytearray(i * 17 + 1 for i in range(8))
+    m.header.kind = 5
+    m.header.tag = bytearray(i * 3 + 7 for i in range(5))
+    m.flags = 19
+    m.payload = bytearray((i * 5 + 2) & 255 for i in range(64))
+    m.trailer = bytearray([9, 8, 7])
+    s = m.encode()
+
+    for x in s:
+        print(x, end=" ")
+
+    m1 = bp.Packet()
+    m1.decode(s)
+    assert m1 == m
+
+
+if __name__ == "__main__":
+    main()
@@ -1,6 +1,8 @@
 import json
 import os
+import shlex
 import subprocess
+import tempfile
 from dataclasses import dataclass, field
 from typing import ClassVar, Dict, List, Optional
 
@@ -47,8 +49,8 @@ class _TestCase:
         """
         sub_cmd = self.cmd_run_fmt.format(lang=lang)
         cmd = f"make -s  --no-print-directory {sub_cmd}"
-        if lang == "c" and self.cc_optimization_arg != "":
-            cmd += " CC_OPTIMIZATION_ARG=" + self.cc_optimization_arg
+        if lang in ("c", "cpp") and self.cc_optimization_arg != "":
+            cmd += " CC_OPTIMIZATION_ARG=" + shlex.quote(self.cc_optimization_arg)
         if self.optimization_mode_arg:
             cmd += " OPTIMIZATION_MODE_ARGS=" + self.optimization_mode_arg
         return subprocess.check_output(cmd, shell=True)
@@ -92,17 +94,15 @@ class _TestCase:
 
 
 def test_encoding_drone() -> None:
-    _TestCase("drone").run()
+    _TestCase("drone", langs=["c", "cpp", "go", "py", "py-slots"]).run()
 
 
 def test_encoding_drone_json() -> None:
-    _TestCase(
-        "drone_json", compare_output_as_json=True, support_optimization_mode=False
-    ).run()
+    _TestCase("drone_json", support_optimization_mode=False).run()
 
 
 def test_encoding_extensible() -> None:
-    _TestCase("extensible", support_optimization_mode=False).run()
+    _TestCase("extensible").run()
 
 
 def test_encoding_empty() -> None:
@@ -114,15 +114,18 @@ def test_encoding_consts() -> None:
 
 
 def test_encoding_nested() -> None:
-    _TestCase("nested").run()
+    _TestCase("nested", langs=["c", "c-plans", "go", "py"]).run()
 
 
 def test_encoding_arrays() -> None:
-    _TestCase("arrays").run()
+    _TestCase(
+        "arrays",
+        langs=["c", "c-plans", "cpp", "go", "go-generics", "py", "py-slots"],
+    ).run()
 
 
 def test_encoding_scatter() -> None:
-    _TestCase("scatter").run()
+    _TestCase("scatter", langs=["c", "c-plans", "go", "py"]).run()
 
 
 def test_encoding_enums() -> None:
@@ -130,11 +133,35 @@ def test_encoding_enums() -> None:
 
 
 def test_encoding_signed() -> None:
-    _TestCase("signed").run()
+    _TestCase("signed", langs=["c", "c-plans", "go", "py"]).run()
+
+
+def test_encoding_large() -> None:
+    _TestCase("large").run()
 
 
 def test_encoding_complexx() -> None:
-    _TestCase("complexx", support_optimization_mode=False).run()
+    _TestCase(
+        "complexx",
+        langs=[
+            "c",
+            "c-hybrid",
+            "go",
+            "go-direct",
+            "go-hybrid",
+            "go-generics",
+            "py",
+            "py-slots",
+        ],
+    ).run()
+
+
+def test_encoding_zerocopy() -> None:
+    _TestCase(
+        "zerocopy",
+        langs=["c", "go", "go-generics", "py"],
+        support_optimization_mode=False,
+    ).run()
 
 
 def test_encoding_issue52() -> None:
@@ -145,3 +172,68 @@ def test_encoding_issue52() -> None:
         compare_output_as_json=False,
         support_optimization_mode=False,
     )
+
+
+def test_encoding_dynamic() -> None:
+    _TestCase("dynamic").run()
+
+
+def test_encoding_json_bytes() -> None:
+    _TestCase("json_bytes", support_optimization_mode=False).run()
+
+
+def test_encoding_ranges() -> None:
+    _TestCase(
+        "ranges", langs=["c", "bpf", "cpp", "go", "go-generics", "py", "py-slots"]
+    ).run()
+
+
+def test_encoding_floats() -> None:
+    _TestCase(
+        "floats", langs=["c", "cpp", "go", "go-generics", "py", "py-slots"]
+    ).run()
+
+
+def test_encoding_oneofs() -> None:
+    _TestCase("oneofs", langs=["c", "go"]).run()
+
+
+def test_encoding_bounded_arrays() -> None:
+    _TestCase(
+        "bounded_arrays",
+        langs=["c", "c-split", "go", "go-generics", "py", "py-slots"],
+        support_optimization_mode=False,
+    ).run()
+
+
+def _compile_c_case(casedir: str, args: List[str], cflags: List[str]) -> bool:
+    """Compiles the C files generated for the protos of given case, with all warnings
+    as errors. Returns False if bitproto fails to generate them."""
+    lib = os.path.join(os.path.dirname(__file__), "..", "..", "lib", "c")
+    protos = sorted(f for f in os.listdir(casedir) if f.endswith(".bitproto"))
+    with tempfile.TemporaryDirectory() as outdir:
+        # Protos importing others are generated to the same directory.
+        for proto in protos:
+            cmd = ["bitproto", *args, "c", os.path.join(casedir, proto), outdir]
+            if subprocess.call(cmd, stderr=subprocess.DEVNULL) != 0:
+                return False
+        for f in sorted(os.listdir(outdir)):
+            if f.endswith(".c"):
+                cmd = ["cc", "-Wall", "-Werror", *cflags, "-I", outdir, "-I", lib]
+                cmd += ["-c", os.path.join(outdir, f), "-o", os.devnull]
+                subprocess.check_call(cmd)
+    return True
+
+
+def test_encoding_c_without_warnings() -> None:
+    """Compiles the C files generated for each case, in the optimization mode too,
+    with and without the json functions."""
+    rootdir = os.path.join(os.path.dirname(__file__), "encoding-cases")
+    for name in sorted(os.listdir(rootdir)):
+        casedir = os.path.join(rootdir, name)
+        if not os.path.isdir(casedir):
+            continue
+        for cflags in ([], ["-DBP_NO_JSON"]):
+            assert _compile_c_case(casedir, [], cflags)
+            # Cases of types not supported in the optimization mode are skipped.
+            _compile_c_case(casedir, ["-O"], cflags)